@@ -3,18 +3,31 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "esp_err.h"
+#include "led_matrix_blit.h"
 
 // 闪光动画参数
 #define FLASH_WIDTH 2
 #define ANIMATION_SPEED 1
 
+// 画面在外部改变（切换动画、暂停恢复等）前保持静止
+#define LED_ANIMATION_IDLE_FOREVER UINT32_MAX
+
 // 初始化动画系统
 void led_animation_init(void);
 
 // 更新并渲染当前动画
 void led_animation_update(void);
 
+/**
+ * @brief 把当前动画的下一帧绘制到显示网格，不刷新显示
+ * 
+ * 与led_animation_update()相同地推进闪光，供需要在刷新前继续处理画面
+ * （例如切换过渡混合）的调用者使用，之后由调用者调用led_matrix_refresh()
+ */
+void led_animation_render(void);
+
 // 设置动画点位置和颜色
 void led_animation_set_point(int x, int y, uint8_t r, uint8_t g, uint8_t b);
 
@@ -34,6 +47,23 @@ bool led_animation_is_running(void);
 void led_animation_set_speed(uint8_t speed);
 uint8_t led_animation_get_speed(void);
 
+/**
+ * @brief 获取当前帧之后画面保持不变的更新次数
+ * 
+ * 闪光移出矩阵后到下一轮闪光开始前，每次更新渲染的画面完全相同，
+ * 调用者可据此跳过这些帧而不是按固定间隔重复刷新。
+ * 
+ * @return uint32_t 可跳过的更新次数，LED_ANIMATION_IDLE_FOREVER表示画面静止
+ */
+uint32_t led_animation_get_idle_frames(void);
+
+/**
+ * @brief 快进动画状态，跳过指定次数不改变画面的更新
+ * 
+ * @param frames 跳过的更新次数，通常为led_animation_get_idle_frames()的返回值
+ */
+void led_animation_skip_frames(uint32_t frames);
+
 // ========== 多动画管理接口 ==========
 
 /**
@@ -70,9 +100,20 @@ int led_animation_get_count(void);
  * @brief 获取指定动画的名称
  * 
  * @param animation_index 动画索引
- * @return const char* 动画名称，NULL表示无效索引
+ * @param name_buffer 名称缓冲区
+ * @param buffer_size 缓冲区大小
+ * @return esp_err_t ESP_OK成功，ESP_ERR_NOT_FOUND表示无效索引
  */
-const char* led_animation_get_name(int animation_index);
+esp_err_t led_animation_get_name(int animation_index, char* name_buffer, size_t buffer_size);
+
+/**
+ * @brief 设置指定动画的名称
+ * 
+ * @param animation_index 动画索引
+ * @param name 动画名称
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_set_name(int animation_index, const char* name);
 
 /**
  * @brief 切换到下一个动画
@@ -98,7 +139,146 @@ esp_err_t led_animation_delete(int animation_index);
 
 /**
  * @brief 清除所有动画
+ * 
+ * 发布一个空动画库，正在渲染的帧不受影响
  */
 void led_animation_clear_all(void);
 
+// ========== 动画库接口 ==========
+//
+// 动画库是一组完整的动画。重新加载时在新动画库中构建全部动画，完成后用
+// led_animation_bank_publish()整体替换当前动画库；渲染期间持有的旧动画库
+// 在渲染结束后才回收，显示不会出现写到一半的动画。
+// 上面的多动画管理接口都作用于当前发布的动画库，名称复制到调用者的缓冲区。
+// 需要写入像素时先用led_animation_bank_acquire()持有动画库，再通过下面的
+// led_animation_bank_*接口获取绘制表面，写完后释放。
+
+typedef struct led_animation_bank led_animation_bank_t;
+
+/**
+ * @brief 创建空动画库（堆上分配，约1KB；每个动画的像素数据约4KB，创建槽位时分配）
+ * 
+ * @return led_animation_bank_t* 动画库，NULL表示内存不足
+ */
+led_animation_bank_t* led_animation_bank_create(void);
+
+/**
+ * @brief 销毁尚未发布的动画库
+ * 
+ * @param bank 动画库
+ */
+void led_animation_bank_destroy(led_animation_bank_t* bank);
+
+/**
+ * @brief 在动画库中创建新动画槽位
+ * 
+ * @param bank 动画库
+ * @param name 动画名称，NULL时使用默认名称
+ * @return int 动画索引，-1表示失败
+ */
+int led_animation_bank_add(led_animation_bank_t* bank, const char* name);
+
+/**
+ * @brief 在动画库中添加内置动画
+ * 
+ * 槽位直接引用flash中的内置动画帧，不复制、不分配内存；该槽位只读，
+ * 无法获取绘制表面
+ * 
+ * @param bank 动画库
+ * @param builtin_index 内置动画索引（见led_animation_builtin.h）
+ * @return int 动画索引，-1表示失败
+ */
+int led_animation_bank_add_builtin(led_animation_bank_t* bank, int builtin_index);
+
+/**
+ * @brief 获取动画库中指定动画的绘制表面
+ * 
+ * @param bank 动画库
+ * @param animation_index 动画索引
+ * @param surface 绘制表面输出
+ * @return bool true成功，false表示索引无效或为只读的内置动画
+ */
+bool led_animation_bank_get_surface(led_animation_bank_t* bank, int animation_index, led_blit_surface_t *surface);
+
+/**
+ * @brief 获取动画库中指定动画的只读帧数据（内置动画同样可用）
+ * 
+ * @param bank 动画库
+ * @param animation_index 动画索引
+ * @param name 名称输出，可为NULL
+ * @param mask 掩码输出（HEIGHT x WIDTH，1表示点亮）
+ * @param colors 原始颜色输出（HEIGHT x WIDTH x 3）
+ * @return bool true成功，false表示索引无效
+ */
+bool led_animation_bank_get_frame(const led_animation_bank_t* bank, int animation_index, const char **name,
+                                  const uint8_t **mask, const uint8_t **colors);
+
+/**
+ * @brief 选择动画库中播放的动画
+ * 
+ * 动画库为当前发布的动画库时立即生效
+ * 
+ * @param bank 动画库
+ * @param animation_index 动画索引
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_bank_select(led_animation_bank_t* bank, int animation_index);
+
+/**
+ * @brief 设置动画库中指定动画的名称
+ * 
+ * @param bank 动画库
+ * @param animation_index 动画索引
+ * @param name 动画名称
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_bank_set_name(led_animation_bank_t* bank, int animation_index, const char* name);
+
+/**
+ * @brief 获取动画库中的动画数量
+ * 
+ * @param bank 动画库
+ * @return int 动画数量
+ */
+int led_animation_bank_get_count(const led_animation_bank_t* bank);
+
+/**
+ * @brief 发布动画库，原子替换当前动画库
+ * 
+ * 发布后动画库归动画系统所有，调用者不能再修改或销毁；
+ * 旧动画库在最后一个读者释放后回收
+ * 
+ * @param bank 动画库
+ * @param select_index 发布后播放的动画索引
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_bank_publish(led_animation_bank_t* bank, int select_index);
+
+/**
+ * @brief 获取当前发布的动画库并持有
+ * 
+ * 持有期间动画库不会被回收（即使已被替换）；写入时只能添加新槽位，
+ * 不能修改正在播放的动画。使用完毕后必须调用led_animation_bank_release()
+ * 
+ * @return led_animation_bank_t* 当前发布的动画库
+ */
+led_animation_bank_t* led_animation_bank_acquire(void);
+
+/**
+ * @brief 为动画库增加一个引用
+ * 
+ * 动画库必须尚未发布或已被调用者持有；用于在发布前后长期持有动画库，
+ * 被替换后直到对应的led_animation_bank_release()才回收
+ * 
+ * @param bank 动画库
+ */
+void led_animation_bank_retain(led_animation_bank_t* bank);
+
+/**
+ * @brief 释放led_animation_bank_acquire()或led_animation_bank_retain()持有的动画库
+ * 
+ * @param bank 动画库
+ */
+void led_animation_bank_release(led_animation_bank_t* bank);
+
 #endif // LED_ANIMATION_H
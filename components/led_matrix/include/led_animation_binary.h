@@ -0,0 +1,133 @@
+/**
+ * @file led_animation_binary.h
+ * @brief 预编译二进制动画格式（.anim）
+ *
+ * matrix.json仍是编辑格式，由tools/compile_animation.py离线编译为.anim：
+ * 动画已光栅化为32x32位图加调色板索引，固件一次fread读入并校验CRC后
+ * 直接写入动画存储，无需文本解析。所有多字节字段均为小端序。
+ *
+ * 文件布局：
+ *   led_anim_bin_header_t                      文件头（32字节）
+ *   palette[palette_count][3]                  调色板（RGB）
+ *   led_anim_bin_entry_t[animation_count]      动画偏移表
+ *   每个动画：name[name_len] + bitmap[128] + index[pixel_count]
+ *     bitmap按行优先、高位在前标记点亮的像素
+ *     index为调色板索引（LED_ANIM_BIN_FLAG_WIDE_INDEX时为uint16_t）
+ */
+
+#ifndef LED_ANIMATION_BINARY_H
+#define LED_ANIMATION_BINARY_H
+
+#include "esp_err.h"
+#include "led_animation.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 格式定义 ==========
+
+#define LED_ANIM_BIN_MAGIC              "RMAN"
+#define LED_ANIM_BIN_VERSION            1
+#define LED_ANIM_BIN_EXTENSION          ".anim"
+#define LED_ANIM_BIN_FLAG_WIDE_INDEX    0x01    // 调色板索引为uint16_t
+
+// 文件头
+typedef struct __attribute__((packed)) {
+    char magic[4];                  // "RMAN"
+    uint16_t version;               // 格式版本
+    uint16_t header_size;           // 文件头大小
+    uint16_t animation_count;       // 动画数量
+    uint16_t palette_count;         // 调色板颜色数
+    uint8_t width;                  // 矩阵宽度
+    uint8_t height;                 // 矩阵高度
+    uint8_t flags;                  // LED_ANIM_BIN_FLAG_*
+    uint8_t reserved;
+    uint32_t source_size;           // 编译时源JSON文件大小
+    uint32_t source_mtime;          // 编译时源JSON修改时间
+    uint32_t payload_size;          // 文件头之后的字节数
+    uint32_t crc32;                 // 文件头之后全部字节的CRC32
+} led_anim_bin_header_t;
+
+// 动画偏移表项
+typedef struct __attribute__((packed)) {
+    uint32_t offset;                // 动画数据在文件中的偏移
+    uint16_t pixel_count;           // 点亮的像素数
+    uint8_t name_len;               // 名称长度（不含结束符）
+    uint8_t reserved;
+} led_anim_bin_entry_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 根据JSON文件路径得到对应的.anim文件路径
+ *
+ * @param json_filename JSON文件路径
+ * @param bin_filename 输出缓冲区
+ * @param size 缓冲区大小
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_binary_path(const char *json_filename, char *bin_filename, size_t size);
+
+/**
+ * @brief 检查.anim文件是否可以代替JSON文件使用
+ *
+ * .anim存在，且JSON不存在或.anim不比JSON旧、记录的源文件大小与JSON一致时可用
+ *
+ * @param json_filename JSON文件路径
+ * @param bin_filename .anim文件路径
+ * @return true 可以使用.anim
+ * @return false 需要解析JSON
+ */
+bool led_animation_binary_is_fresh(const char *json_filename, const char *bin_filename);
+
+/**
+ * @brief 从.anim文件加载全部动画（成功后整体替换当前动画库）
+ *
+ * @param filename .anim文件路径
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t load_animation_from_binary(const char *filename);
+
+/**
+ * @brief 从.anim文件构建新的动画库（不替换当前动画）
+ *
+ * @param filename .anim文件路径
+ * @param bank_out 输出新的动画库，由调用者发布或销毁
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t load_animation_bank_from_binary(const char *filename, led_animation_bank_t **bank_out);
+
+/**
+ * @brief 校验内存中的.anim映像并解码为新的动画库
+ *
+ * @param data 映像数据（完整文件内容）
+ * @param size 映像大小
+ * @param bank_out 输出新的动画库，由调用者发布或销毁
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_binary_decode(const uint8_t *data, size_t size, led_animation_bank_t **bank_out);
+
+/**
+ * @brief 把动画库中的动画编码为.anim映像（格式与tools/compile_animation.py的输出相同）
+ *
+ * 源文件大小和修改时间字段为0
+ *
+ * @param bank 动画库（调用者持有，编码期间不能修改）
+ * @param order 按顺序写入的动画索引，NULL表示0到count-1
+ * @param count 动画数量
+ * @param data_out 输出映像，由调用者free()
+ * @param size_out 输出映像大小
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_binary_encode(const led_animation_bank_t *bank, const int32_t *order, int count,
+                                      uint8_t **data_out, size_t *size_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_ANIMATION_BINARY_H
@@ -0,0 +1,61 @@
+/**
+ * @file led_animation_builtin.h
+ * @brief 内置动画（构建时生成，位于flash）
+ *
+ * 数据由tools/gen_builtin_animations.py在构建时根据examples/example_animation.json
+ * 生成。掩码和颜色帧为const数组，渲染时直接读取，不复制到RAM；元素表保留源定义，
+ * 用于导出matrix.json。
+ */
+
+#ifndef LED_ANIMATION_BUILTIN_H
+#define LED_ANIMATION_BUILTIN_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 内置动画元素类型
+typedef enum {
+    LED_ANIMATION_BUILTIN_POINT = 0,    // coords: x, y
+    LED_ANIMATION_BUILTIN_LINE,         // coords: x1, y1, x2, y2
+} led_animation_builtin_type_t;
+
+// 源定义中的一个元素
+typedef struct {
+    uint8_t type;                       // led_animation_builtin_type_t
+    int16_t coords[4];
+    uint8_t rgb[3];
+} led_animation_builtin_element_t;
+
+// 内置动画
+typedef struct {
+    const char *name;
+    const led_animation_builtin_element_t *elements;
+    uint16_t element_count;
+    const uint8_t *mask;                // LED_MATRIX_HEIGHT x LED_MATRIX_WIDTH，1表示点亮
+    const uint8_t *colors;              // LED_MATRIX_HEIGHT x LED_MATRIX_WIDTH x 3，原始颜色
+} led_animation_builtin_t;
+
+/**
+ * @brief 获取内置动画数量
+ *
+ * @return int 内置动画数量
+ */
+int led_animation_builtin_count(void);
+
+/**
+ * @brief 获取内置动画
+ *
+ * @param index 动画索引（0开始）
+ * @return const led_animation_builtin_t* 内置动画，索引无效时返回NULL
+ */
+const led_animation_builtin_t* led_animation_builtin_get(int index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_ANIMATION_BUILTIN_H
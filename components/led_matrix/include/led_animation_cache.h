@@ -0,0 +1,127 @@
+/**
+ * @file led_animation_cache.h
+ * @brief 解码后动画的启动缓存
+ *
+ * 解析JSON得到的动画库以.anim映像保存在JSON旁边的.cache文件中，
+ * 以源JSON内容的CRC32和大小为键。缓存头同时记录JSON的修改时间：
+ * 大小和修改时间都未变时直接沿用缓存头中的CRC，不读取JSON；否则按块
+ * 计算CRC。键一致即直接解码缓存，跳过JSON解析；JSON内容变化后缓存自动失效。
+ *
+ * 替换缓存时依次重命名：旧缓存 -> .bak，临时文件 -> .cache，再删除.bak。
+ * 断电后.cache缺失时加载依次尝试.bak和.tmp，任何时刻至少有一个完整的缓存。
+ *
+ * 文件布局：
+ *   led_animation_cache_header_t               缓存头（28字节）
+ *   .anim映像[image_size]                      见led_animation_binary.h
+ */
+
+#ifndef LED_ANIMATION_CACHE_H
+#define LED_ANIMATION_CACHE_H
+
+#include "esp_err.h"
+#include "led_animation.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 格式定义 ==========
+
+#define LED_ANIMATION_CACHE_MAGIC       "RMAC"
+#define LED_ANIMATION_CACHE_VERSION     2
+#define LED_ANIMATION_CACHE_EXTENSION   ".cache"
+
+// 缓存头
+typedef struct __attribute__((packed)) {
+    char magic[4];                  // "RMAC"
+    uint16_t version;               // 格式版本
+    uint16_t header_size;           // 缓存头大小
+    uint32_t source_crc32;          // 源JSON内容的CRC32（缓存键）
+    uint32_t source_size;           // 源JSON大小（缓存键）
+    uint32_t source_mtime;          // 源JSON修改时间，与大小一致时跳过计算CRC
+    uint32_t parse_us;              // 生成缓存时解码JSON的耗时，用于估算命中时节省的时间
+    uint32_t image_size;            // 之后.anim映像的字节数
+} led_animation_cache_header_t;
+
+// 缓存键
+typedef struct {
+    uint32_t crc32;                 // 源JSON内容的CRC32
+    uint32_t size;                  // 源JSON大小
+    uint32_t mtime;                 // 源JSON修改时间（不参与比较）
+} led_animation_cache_key_t;
+
+// 缓存统计（本次启动以来）
+typedef struct {
+    uint32_t lookups;               // 查找次数
+    uint32_t hits;                  // 命中次数
+    uint32_t stores;                // 写入次数
+    uint32_t crc_skips;             // 大小和修改时间未变、沿用缓存头CRC的次数
+    int64_t hash_us;                // 最近一次计算键的耗时（微秒）
+    int64_t load_us;                // 最近一次命中时加载缓存的耗时（微秒）
+    int64_t saved_us;               // 命中累计节省的时间（记录的解码耗时减去计算键和加载耗时）
+} led_animation_cache_stats_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 根据JSON文件路径得到对应的缓存文件路径
+ *
+ * @param json_filename JSON文件路径
+ * @param cache_filename 输出缓冲区
+ * @param size 缓冲区大小
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_cache_path(const char *json_filename, char *cache_filename, size_t size);
+
+/**
+ * @brief 计算JSON文件的缓存键
+ *
+ * 先比较文件大小和修改时间与缓存头中的记录，一致时直接沿用记录的CRC；
+ * 不一致或没有缓存时读取整个文件计算CRC
+ *
+ * @param json_filename JSON文件路径
+ * @param key 缓存键输出
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_cache_compute_key(const char *json_filename, led_animation_cache_key_t *key);
+
+/**
+ * @brief 键一致时从缓存构建新的动画库
+ *
+ * @param json_filename JSON文件路径
+ * @param key 当前JSON的缓存键
+ * @param bank_out 输出新的动画库，由调用者发布或销毁
+ * @return esp_err_t ESP_OK命中，ESP_ERR_NOT_FOUND表示没有缓存或键不一致，其他值表示缓存损坏
+ */
+esp_err_t led_animation_cache_load(const char *json_filename, const led_animation_cache_key_t *key,
+                                   led_animation_bank_t **bank_out);
+
+/**
+ * @brief 把动画库写入缓存（先写临时文件，完成后依次重命名替换旧缓存）
+ *
+ * @param json_filename JSON文件路径
+ * @param key 解码时JSON的缓存键
+ * @param bank 动画库（调用者持有，写入期间不能修改）
+ * @param order 按JSON中的顺序排列的动画索引，NULL表示0到count-1
+ * @param count 动画数量
+ * @param parse_us 解码这些动画所用的时间（微秒）
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_cache_store(const char *json_filename, const led_animation_cache_key_t *key,
+                                    const led_animation_bank_t *bank, const int32_t *order, int count,
+                                    int64_t parse_us);
+
+/**
+ * @brief 获取缓存统计
+ *
+ * @param stats 统计输出
+ */
+void led_animation_cache_get_stats(led_animation_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_ANIMATION_CACHE_H
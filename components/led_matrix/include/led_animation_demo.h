@@ -1,7 +1,7 @@
 #ifndef LED_ANIMATION_DEMO_H
 #define LED_ANIMATION_DEMO_H
 
-// 初始化示例动画（设置动画点和颜色）
+// 初始化示例动画（发布flash中的全部内置动画，播放第一个）
 void initialize_animation_demo(void);
 
 #endif // LED_ANIMATION_DEMO_H
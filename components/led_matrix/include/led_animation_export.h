@@ -10,8 +10,8 @@ extern "C" {
 /**
  * @brief 导出所有动画为JSON文件
  * 
- * 该函数将所有内置的示例动画（示例动画、启动中、链接错误）
- * 导出为JSON格式文件，与example_animation.json保持同步
+ * 该函数将所有内置动画导出为JSON格式文件，内置动画在构建时
+ * 由example_animation.json生成，两者内容一致
  * 
  * @param filename JSON文件路径
  * @return esp_err_t ESP_OK成功，其他值表示失败
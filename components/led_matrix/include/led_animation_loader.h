@@ -2,7 +2,10 @@
 #define LED_ANIMATION_LOADER_H
 
 #include "esp_err.h"
+#include "led_animation.h"
+#include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -11,14 +14,54 @@ extern "C" {
 // 动画文件路径
 #define ANIMATION_FILE_PATH "/sdcard/matrix.json"
 
+// 单个文件最多加载的动画数量
+#define ANIMATION_FILE_MAX_ANIMATIONS 10
+
+// 动画偏移索引项
+typedef struct {
+    char name[64];                  // 动画名称
+    uint32_t offset;                // 动画对象在文件中的起始偏移
+    uint32_t length;                // 动画对象长度（字节），清单中为0表示该元素不是动画对象
+} animation_index_entry_t;
+
+// 动画文件清单：按animations数组序号记录前ANIMATION_FILE_MAX_ANIMATIONS个元素
+typedef struct {
+    uint32_t source_size;           // 源文件大小（指纹）
+    uint32_t source_mtime;          // 源文件修改时间（指纹）
+    int animation_count;            // animations数组元素总数
+    int entry_count;                // 已记录的元素数量
+    animation_index_entry_t entries[ANIMATION_FILE_MAX_ANIMATIONS];
+} animation_manifest_t;
+
+// 动画文件偏移索引
+typedef struct {
+    animation_index_entry_t entries[ANIMATION_FILE_MAX_ANIMATIONS];
+    int count;                      // 索引项数量
+} animation_file_index_t;
+
 /**
  * @brief 从JSON文件加载动画
  * 
+ * 在新动画库中解码全部动画，成功后整体替换当前动画库；
+ * 失败时当前动画保持不变
+ * 
  * @param filename JSON文件路径
  * @return esp_err_t ESP_OK成功，其他值表示失败
  */
 esp_err_t load_animation_from_json(const char *filename);
 
+/**
+ * @brief 从JSON文件构建新的动画库（不替换当前动画）
+ * 
+ * 优先使用预编译的.anim文件。构建完成后由调用者发布或销毁，
+ * 失败时不分配动画库
+ * 
+ * @param filename JSON文件路径
+ * @param bank_out 输出新的动画库
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t load_animation_bank_from_json(const char *filename, led_animation_bank_t **bank_out);
+
 /**
  * @brief 检查动画文件是否存在
  * 
@@ -57,6 +100,53 @@ int get_animation_count_from_json(const char *filename);
 esp_err_t get_animation_name_from_json(const char *filename, int animation_index, 
                                       char *name_buffer, size_t buffer_size);
 
+/**
+ * @brief 获取JSON文件的动画清单
+ * 
+ * 清单在第一次使用时扫描生成，缓存在内存中并保存为同名.idx文件；
+ * 只有源文件大小或修改时间变化时才重新扫描
+ * 
+ * @param filename JSON文件路径
+ * @param manifest 清单输出
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t get_animation_manifest_from_json(const char *filename, animation_manifest_t *manifest);
+
+/**
+ * @brief 使动画清单缓存失效（内存和TF卡上的.idx文件）
+ * 
+ * 用于源文件内容变化但大小和修改时间都未变化的情况
+ * 
+ * @param filename JSON文件路径
+ */
+void invalidate_animation_manifest(const char *filename);
+
+/**
+ * @brief 扫描JSON文件，记录每个动画对象的偏移、长度和名称
+ * 
+ * 由动画清单生成，不解码点数据
+ * 
+ * @param filename JSON文件路径
+ * @param index 索引输出
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t build_animation_index_from_json(const char *filename, animation_file_index_t *index);
+
+/**
+ * @brief 按索引项解码单个动画到动画库的新槽位
+ * 
+ * 只读取该动画对象所在的字节范围，不改变当前播放的动画。
+ * 动画库为尚未发布的新动画库，或调用者通过led_animation_bank_acquire()持有的当前动画库
+ * 
+ * @param filename JSON文件路径
+ * @param entry 索引项
+ * @param bank 解码目标动画库
+ * @param animation_index 输出新动画的槽位索引
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t load_indexed_animation_from_json(const char *filename, const animation_index_entry_t *entry,
+                                           led_animation_bank_t *bank, int *animation_index);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,92 @@
+/**
+ * @file led_animation_reload.h
+ * @brief 后台动画重新加载
+ *
+ * 在低优先级任务中解码动画文件到新的动画库，完成后原子替换当前动画库。
+ * 重新加载期间继续播放旧动画，显示不会停顿。需要与发布同步更新自身状态的
+ * 调用者可以提供发布钩子，在重新加载任务中自行发布。
+ */
+
+#ifndef LED_ANIMATION_RELOAD_H
+#define LED_ANIMATION_RELOAD_H
+
+#include "esp_err.h"
+#include "led_animation.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 重新加载完成回调（在重新加载任务中调用）
+ *
+ * @param result 加载结果，ESP_OK表示新动画库已发布
+ * @param user_ctx 用户上下文
+ */
+typedef void (*led_animation_reload_cb_t)(esp_err_t result, void *user_ctx);
+
+/**
+ * @brief 发布新动画库的钩子（在重新加载任务中调用）
+ *
+ * 取得bank的所有权：成功时发布，失败时销毁
+ *
+ * @param bank 构建完成的新动画库
+ * @param user_ctx 用户上下文
+ * @return esp_err_t ESP_OK表示已发布，其他值表示失败
+ */
+typedef esp_err_t (*led_animation_reload_publish_cb_t)(led_animation_bank_t *bank, void *user_ctx);
+
+// 重新加载统计
+typedef struct {
+    uint32_t requests;              // 请求次数
+    uint32_t completed;             // 成功发布次数
+    uint32_t failed;                // 失败次数
+    uint32_t coalesced;             // 被后续请求合并的次数
+    int64_t last_duration_us;       // 最近一次加载耗时
+    esp_err_t last_result;          // 最近一次加载结果
+} led_animation_reload_stats_t;
+
+/**
+ * @brief 初始化重新加载任务（重复调用无副作用）
+ *
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_reload_init(void);
+
+/**
+ * @brief 请求在后台重新加载动画文件
+ *
+ * 立即返回。尚未开始的请求会被新请求替换，只加载最新的一次
+ *
+ * @param filename JSON文件路径
+ * @param publish 发布钩子，NULL时直接发布并播放第一个动画
+ * @param callback 完成回调，可为NULL
+ * @param user_ctx 用户上下文（传给publish和callback）
+ * @return esp_err_t ESP_OK已提交，其他值表示失败
+ */
+esp_err_t led_animation_reload_request(const char *filename, led_animation_reload_publish_cb_t publish,
+                                       led_animation_reload_cb_t callback, void *user_ctx);
+
+/**
+ * @brief 是否有正在进行或等待中的重新加载
+ *
+ * @return true 忙
+ * @return false 空闲
+ */
+bool led_animation_reload_is_busy(void);
+
+/**
+ * @brief 获取重新加载统计
+ *
+ * @param stats 统计输出
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_reload_get_stats(led_animation_reload_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_ANIMATION_RELOAD_H
@@ -0,0 +1,86 @@
+/**
+ * @file led_animation_watcher.h
+ * @brief TF卡动画文件变化检测
+ *
+ * 低优先级任务按固定间隔检查matrix.json及其.anim文件的大小和修改时间，
+ * 每次轮询只有stat()，不读取文件内容。变化在防抖时间内保持不变后才计算CRC，
+ * 内容确实变化时调用回调（通常触发后台重新加载）；复制到一半的文件大小仍在
+ * 变化，不会触发重新加载。判定逻辑见led_file_watch.h。
+ */
+
+#ifndef LED_ANIMATION_WATCHER_H
+#define LED_ANIMATION_WATCHER_H
+
+#include "esp_err.h"
+#include "led_file_watch.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 文件内容变化回调（在检测任务中调用）
+ *
+ * @param json_file_path 被监视的JSON文件路径
+ * @param user_ctx 用户上下文
+ */
+typedef void (*led_animation_watcher_cb_t)(const char *json_file_path, void *user_ctx);
+
+// 检测配置
+typedef struct {
+    const char *json_file_path;             // JSON文件路径（同名.anim一并监视）
+    uint32_t poll_interval_ms;              // 轮询间隔
+    uint32_t debounce_ms;                   // 变化后需保持不变的时间
+    led_animation_watcher_cb_t callback;    // 内容变化回调
+    void *user_ctx;                         // 用户上下文
+} led_animation_watcher_config_t;
+
+// 检测统计
+typedef led_file_watch_stats_t led_animation_watcher_stats_t;
+
+/**
+ * @brief 获取默认检测配置
+ *
+ * @return led_animation_watcher_config_t 默认配置
+ */
+led_animation_watcher_config_t led_animation_watcher_get_default_config(void);
+
+/**
+ * @brief 启动文件变化检测
+ *
+ * @param config 检测配置
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_watcher_start(const led_animation_watcher_config_t *config);
+
+/**
+ * @brief 停止文件变化检测
+ *
+ * 唤醒检测任务并等待它退出（有超时），返回后可以立即重新启动。
+ * 不能在检测回调中调用。
+ */
+void led_animation_watcher_stop(void);
+
+/**
+ * @brief 检测是否运行中
+ *
+ * @return true 运行中
+ * @return false 未运行
+ */
+bool led_animation_watcher_is_running(void);
+
+/**
+ * @brief 获取检测统计
+ *
+ * @param stats 统计输出
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_animation_watcher_get_stats(led_animation_watcher_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_ANIMATION_WATCHER_H
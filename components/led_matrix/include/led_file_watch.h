@@ -0,0 +1,181 @@
+/**
+ * @file led_file_watch.h
+ * @brief 动画文件变化检测的判定逻辑（不依赖任务和文件系统）
+ *
+ * 每个文件保存两份指纹：已确认的（附带内容校验和）和最近一次轮询看到的。
+ * 轮询发现指纹变化时只记录时间；指纹连续保持到防抖时间后，再对变化的文件
+ * 计算校验和并与已确认的比较，内容确实变化时才报告。文件系统访问通过
+ * 钩子完成，目标板上为stat()/fopen()，主机测试中为模拟文件系统。
+ *
+ * 检测任务的启动和停止也在这里（led_file_watch_runner_*），任务创建、唤醒和
+ * 退出握手通过钩子完成：目标板上为FreeRTOS任务和信号量，主机测试中为线程。
+ * 停止时等待任务确认退出，停止后可以立即重新启动。
+ */
+
+#ifndef LED_FILE_WATCH_H
+#define LED_FILE_WATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+#define LED_FILE_WATCH_MAX_FILES        2       // JSON和.anim
+#define LED_FILE_WATCH_PATH_MAX         128
+
+// 文件系统钩子
+typedef struct {
+    bool (*is_mounted)(void *ctx);                                          // 存储是否可用
+    bool (*stat)(void *ctx, const char *path, uint32_t *size, uint32_t *mtime); // 文件不存在时返回false
+    bool (*checksum)(void *ctx, const char *path, uint32_t *crc, uint32_t *bytes_read); // 读取失败时返回false
+    void *ctx;
+} led_file_watch_fs_t;
+
+// 一次轮询的结果
+typedef enum {
+    LED_FILE_WATCH_IDLE = 0,            // 没有未确认的变化
+    LED_FILE_WATCH_SETTLING,            // 指纹变化，防抖中
+    LED_FILE_WATCH_UNCHANGED,           // 指纹已稳定，内容未变（例如只修改了时间）
+    LED_FILE_WATCH_CHANGED              // 指纹已稳定，内容已变化
+} led_file_watch_result_t;
+
+// 检测统计
+typedef struct {
+    uint32_t polls;                     // 轮询次数
+    uint32_t changes_detected;          // 检测到大小/时间变化的次数
+    uint32_t debounced;                 // 防抖期间再次变化的次数
+    uint32_t crc_checks;                // 计算CRC的次数
+    uint32_t unchanged_content;         // 时间变化但内容未变的次数
+    uint32_t reloads_triggered;         // 报告内容变化的次数
+    uint32_t bytes_read;                // 计算CRC读取的字节数
+} led_file_watch_stats_t;
+
+// 文件指纹
+typedef struct {
+    bool exists;
+    uint32_t size;
+    uint32_t mtime;
+} led_file_fingerprint_t;
+
+// 被监视的文件
+typedef struct {
+    char path[LED_FILE_WATCH_PATH_MAX];
+    led_file_fingerprint_t committed;   // 已确认的指纹
+    uint32_t crc;                       // 已确认内容的校验和
+    bool crc_valid;
+    led_file_fingerprint_t pending;     // 最近一次轮询看到的指纹
+} led_watched_file_t;
+
+// 检测状态
+typedef struct {
+    led_watched_file_t files[LED_FILE_WATCH_MAX_FILES];
+    int file_count;
+    int64_t debounce_us;                // 变化后需保持不变的时间
+    bool change_pending;                // 有未确认的变化
+    int64_t pending_since_us;           // 指纹最后一次变化的时间
+    led_file_watch_fs_t fs;
+    led_file_watch_stats_t stats;
+} led_file_watch_t;
+
+// 检测任务钩子
+typedef struct {
+    bool (*spawn)(void *ctx, void (*entry)(void *arg), void *arg);  // 创建检测任务运行entry(arg)
+    bool (*wait)(void *ctx, uint32_t timeout_ms);   // 检测任务中等待唤醒，超时返回false
+    void (*wake)(void *ctx);                        // 唤醒检测任务
+    void (*exited)(void *ctx);                      // 检测任务最后调用，之后不再访问运行器
+    bool (*join)(void *ctx, uint32_t timeout_ms);   // 等待exited，超时返回false
+    int64_t (*now_us)(void *ctx);                   // 当前时间（微秒）
+    void *ctx;
+} led_file_watch_task_ops_t;
+
+// 每次轮询后在检测任务中调用（建立基准后以LED_FILE_WATCH_IDLE调用一次）
+typedef void (*led_file_watch_poll_cb_t)(led_file_watch_result_t result, void *user_ctx);
+
+// 检测任务运行器
+typedef struct {
+    led_file_watch_t watch;             // 判定状态，任务运行期间只在检测任务中访问
+    led_file_watch_task_ops_t ops;
+    uint32_t poll_interval_ms;
+    led_file_watch_poll_cb_t on_poll;
+    void *user_ctx;
+    volatile bool running;              // 未请求停止
+    bool alive;                         // 任务已创建且尚未确认退出
+} led_file_watch_runner_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 初始化检测状态
+ *
+ * @param watch 检测状态
+ * @param paths 被监视的文件路径
+ * @param count 文件数量（不超过LED_FILE_WATCH_MAX_FILES）
+ * @param debounce_ms 防抖时间
+ * @param fs 文件系统钩子
+ * @return true 成功
+ * @return false 参数无效或路径过长
+ */
+bool led_file_watch_init(led_file_watch_t *watch, const char *const *paths, int count,
+                         uint32_t debounce_ms, const led_file_watch_fs_t *fs);
+
+/**
+ * @brief 记录当前文件状态作为基准，之后只有相对于它的内容变化才报告
+ *
+ * 存储不可用时不记录（第一次轮询看到的文件视为变化）
+ *
+ * @param watch 检测状态
+ */
+void led_file_watch_baseline(led_file_watch_t *watch);
+
+/**
+ * @brief 轮询一次文件状态
+ *
+ * 每次只stat()；指纹在防抖时间内保持不变后才读取变化的文件计算校验和。
+ * 存储不可用期间不比较，不会把“文件消失”当作变化
+ *
+ * @param watch 检测状态
+ * @param now_us 当前时间（微秒）
+ * @return led_file_watch_result_t 轮询结果
+ */
+led_file_watch_result_t led_file_watch_poll(led_file_watch_t *watch, int64_t now_us);
+
+// ========== 检测任务接口 ==========
+
+/**
+ * @brief 创建检测任务
+ *
+ * runner->watch需已由led_file_watch_init()初始化。任务先记录基准，之后每隔
+ * poll_interval_ms轮询一次，停止请求会立即唤醒任务。
+ *
+ * @param runner 运行器
+ * @param ops 任务钩子
+ * @param poll_interval_ms 轮询间隔
+ * @param on_poll 轮询结果回调
+ * @param user_ctx 回调上下文
+ * @return true 成功
+ * @return false 参数无效、上一个任务尚未确认退出或创建任务失败
+ */
+bool led_file_watch_runner_start(led_file_watch_runner_t *runner, const led_file_watch_task_ops_t *ops,
+                                 uint32_t poll_interval_ms, led_file_watch_poll_cb_t on_poll, void *user_ctx);
+
+/**
+ * @brief 停止检测任务并等待它确认退出
+ *
+ * 超时后任务仍视为存活，再次停止时继续等待；没有任务时直接返回true
+ *
+ * @param runner 运行器
+ * @param timeout_ms 最长等待时间
+ * @return true 任务已退出，可以立即重新启动
+ * @return false 等待超时
+ */
+bool led_file_watch_runner_stop(led_file_watch_runner_t *runner, uint32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_FILE_WATCH_H
@@ -0,0 +1,157 @@
+/**
+ * @file led_json_stream.h
+ * @brief 流式JSON事件解析器
+ *
+ * 按块输入JSON文本，每识别出一个语法元素就回调一次（对象/数组开始结束、
+ * 键、字符串、数字、布尔、null），不构建语法树。解析器状态为固定大小，
+ * 内存占用与文件大小无关；超过LED_JSON_STREAM_TOKEN_MAX的字符串会被截断。
+ */
+
+#ifndef LED_JSON_STREAM_H
+#define LED_JSON_STREAM_H
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+#define LED_JSON_STREAM_TOKEN_MAX       96      // 单个字符串/数字缓冲区大小（含结束符）
+#define LED_JSON_STREAM_MAX_DEPTH       32      // 最大嵌套深度
+#define LED_JSON_STREAM_CHUNK_SIZE      1024    // 从文件读取的块大小
+
+// 事件类型
+typedef enum {
+    LED_JSON_EVENT_OBJECT_START = 0,
+    LED_JSON_EVENT_OBJECT_END,
+    LED_JSON_EVENT_ARRAY_START,
+    LED_JSON_EVENT_ARRAY_END,
+    LED_JSON_EVENT_KEY,
+    LED_JSON_EVENT_STRING,
+    LED_JSON_EVENT_NUMBER,
+    LED_JSON_EVENT_BOOL,
+    LED_JSON_EVENT_NULL
+} led_json_event_type_t;
+
+// 解析事件
+typedef struct {
+    led_json_event_type_t type;
+    int depth;              // 嵌套深度：根值为0，根对象的成员为1，依此类推
+    size_t offset;          // 产生该事件的字符在输入中的字节偏移（容器开始/结束为括号位置）
+    const char *str;        // KEY/STRING：已解码的UTF-8文本（以'\0'结尾，仅在回调内有效）
+    size_t len;             // KEY/STRING：文本长度
+    bool truncated;         // KEY/STRING：文本是否被截断
+    double number;          // NUMBER：数值
+    bool boolean;           // BOOL：布尔值
+} led_json_event_t;
+
+/**
+ * @brief 事件回调
+ *
+ * @param event 解析事件
+ * @param user_ctx 用户上下文
+ * @return bool true继续解析，false提前结束（解析结果为ESP_OK，stopped置位）
+ */
+typedef bool (*led_json_event_cb_t)(const led_json_event_t *event, void *user_ctx);
+
+// 解析器状态（调用者分配，无动态内存）
+typedef struct {
+    led_json_event_cb_t callback;
+    void *user_ctx;
+    uint8_t state;                  // 语法状态
+    uint8_t lex;                    // 词法状态
+    uint8_t depth;                  // 当前嵌套深度
+    uint32_t stack;                 // 容器栈位图：1为对象，0为数组
+    bool string_is_key;             // 当前字符串是否为对象键
+    char token[LED_JSON_STREAM_TOKEN_MAX];
+    size_t token_len;
+    bool token_truncated;
+    uint32_t unicode;               // \uXXXX累积值
+    uint8_t unicode_digits;
+    uint32_t high_surrogate;        // 待配对的UTF-16高位代理
+    const char *literal;            // 正在匹配的字面量（true/false/null）
+    uint8_t literal_pos;
+    size_t offset;                  // 已处理字节数（用于错误定位）
+    bool stopped;                   // 回调请求提前结束
+    esp_err_t error;                // 解析错误
+} led_json_stream_t;
+
+// 文件解析统计
+typedef struct {
+    size_t bytes_read;              // 读取的字节数
+    uint32_t chunks;                // 读取的块数
+    int64_t elapsed_us;             // 解析耗时（微秒）
+    uint32_t speed_kbps;            // 解析速度（KB/s）
+    size_t working_memory;          // 解析器工作内存（状态+读缓冲区）
+    size_t peak_heap_used;          // 解析期间堆内存峰值占用
+    bool stopped;                   // 是否被回调提前结束
+} led_json_stream_stats_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 初始化解析器
+ *
+ * @param parser 解析器
+ * @param callback 事件回调
+ * @param user_ctx 用户上下文
+ */
+void led_json_stream_init(led_json_stream_t *parser, led_json_event_cb_t callback, void *user_ctx);
+
+/**
+ * @brief 输入一块JSON文本
+ *
+ * @param parser 解析器
+ * @param data 数据
+ * @param len 数据长度
+ * @return esp_err_t ESP_OK成功（含提前结束），ESP_ERR_INVALID_RESPONSE表示语法错误
+ */
+esp_err_t led_json_stream_feed(led_json_stream_t *parser, const char *data, size_t len);
+
+/**
+ * @brief 结束输入并检查文档是否完整
+ *
+ * @param parser 解析器
+ * @return esp_err_t ESP_OK成功，ESP_ERR_INVALID_RESPONSE表示文档不完整或有语法错误
+ */
+esp_err_t led_json_stream_finish(led_json_stream_t *parser);
+
+/**
+ * @brief 按块读取并解析JSON文件
+ *
+ * @param filename 文件路径
+ * @param callback 事件回调
+ * @param user_ctx 用户上下文
+ * @param stats 解析统计输出，可为NULL
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_json_stream_parse_file(const char *filename, led_json_event_cb_t callback,
+                                     void *user_ctx, led_json_stream_stats_t *stats);
+
+/**
+ * @brief 解析JSON文件中的一段（该段本身必须是一个完整的JSON值）
+ *
+ * 事件中的offset相对于该段起点
+ *
+ * @param filename 文件路径
+ * @param offset 段起始偏移
+ * @param length 段长度（字节）
+ * @param callback 事件回调
+ * @param user_ctx 用户上下文
+ * @param stats 解析统计输出，可为NULL
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_json_stream_parse_file_range(const char *filename, size_t offset, size_t length,
+                                           led_json_event_cb_t callback, void *user_ctx,
+                                           led_json_stream_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_JSON_STREAM_H
@@ -0,0 +1,118 @@
+/**
+ * @file led_json_writer.h
+ * @brief 流式JSON写入器
+ *
+ * 边生成边写入文件，不构建语法树，内存占用为固定大小的写缓冲区。
+ * 输出格式与cJSON_Print()完全一致（对象成员换行并以制表符缩进，
+ * 数组元素以", "分隔），便于与原有导出结果逐字节比较。
+ */
+
+#ifndef LED_JSON_WRITER_H
+#define LED_JSON_WRITER_H
+
+#include "esp_err.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+#define LED_JSON_WRITER_BUFFER_SIZE     1024    // 写缓冲区大小
+#define LED_JSON_WRITER_MAX_DEPTH       32      // 最大嵌套深度
+
+// 写入器状态（调用者分配，写缓冲区在打开时分配）
+typedef struct {
+    FILE *file;
+    char *buffer;
+    size_t used;                    // 缓冲区中待写入的字节数
+    uint8_t depth;                  // 当前嵌套深度
+    uint32_t stack;                 // 容器栈位图：1为对象，0为数组
+    uint32_t has_items;             // 各层容器是否已有元素
+    size_t bytes_written;           // 已生成的字节数
+    uint32_t flushes;               // 写入文件的次数
+    int64_t start_us;
+    esp_err_t error;                // 第一个错误，之后的写入全部忽略
+} led_json_writer_t;
+
+// 写入统计
+typedef struct {
+    size_t bytes_written;           // 文件大小
+    uint32_t flushes;               // 写入文件的次数
+    int64_t elapsed_us;             // 从打开到关闭的耗时（微秒）
+    size_t working_memory;          // 写入器工作内存（状态+写缓冲区）
+} led_json_writer_stats_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 创建文件并初始化写入器
+ *
+ * @param writer 写入器
+ * @param filename 文件路径
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_json_writer_open(led_json_writer_t *writer, const char *filename);
+
+/**
+ * @brief 开始一个对象（作为数组元素、对象成员值或根值）
+ */
+void led_json_writer_begin_object(led_json_writer_t *writer);
+
+/**
+ * @brief 结束当前对象
+ */
+void led_json_writer_end_object(led_json_writer_t *writer);
+
+/**
+ * @brief 开始一个数组
+ */
+void led_json_writer_begin_array(led_json_writer_t *writer);
+
+/**
+ * @brief 结束当前数组
+ */
+void led_json_writer_end_array(led_json_writer_t *writer);
+
+/**
+ * @brief 写入对象成员的键，之后必须写入一个值
+ *
+ * @param writer 写入器
+ * @param key 键（UTF-8）
+ */
+void led_json_writer_key(led_json_writer_t *writer, const char *key);
+
+/**
+ * @brief 写入字符串值
+ *
+ * @param writer 写入器
+ * @param value 字符串（UTF-8）
+ */
+void led_json_writer_string(led_json_writer_t *writer, const char *value);
+
+/**
+ * @brief 写入整数值
+ *
+ * @param writer 写入器
+ * @param value 整数
+ */
+void led_json_writer_int(led_json_writer_t *writer, int value);
+
+/**
+ * @brief 写出剩余数据并关闭文件
+ *
+ * @param writer 写入器
+ * @param stats 写入统计输出，可为NULL
+ * @return esp_err_t ESP_OK成功，其他值表示写入过程中出现的第一个错误
+ */
+esp_err_t led_json_writer_close(led_json_writer_t *writer, led_json_writer_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_JSON_WRITER_H
@@ -3,7 +3,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "esp_err.h"
 #include "led_color.h"
+#include "led_matrix_blit.h"
 
 // 矩阵尺寸定义
 #define LED_MATRIX_WIDTH 32
@@ -17,9 +19,12 @@
 #define MOUNT_POINT "/sdcard"
 #define ANIMATION_FILE_PATH "/sdcard/matrix.json"
 
-// 初始化函数
+// 初始化函数（硬件初始化，并从TF卡加载动画或使用内置示例动画）
 void led_matrix_init(void);
 
+// 只初始化LED矩阵硬件，不加载动画（注册到LED设备注册中心后立即返回，输出故障由后台恢复）
+esp_err_t led_matrix_init_hardware(void);
+
 // 清除所有LED
 void led_matrix_clear(void);
 
@@ -35,6 +40,9 @@ void led_matrix_refresh(void);
 // 填充全部
 void led_matrix_fill(uint8_t r, uint8_t g, uint8_t b);
 
+// 获取显示网格的绘制表面（供块传输引擎直接绘制）
+void led_matrix_get_surface(led_blit_surface_t *surface);
+
 // 动画更新（将在动画模块中实现）
 void led_matrix_update_animation(void);
 
@@ -47,4 +55,7 @@ bool led_matrix_is_enabled(void);
 // 简单测试模式
 void led_matrix_test(void);
 
+// 块传输引擎性能测试（对比逐像素绘制，结果输出到日志，不改变当前显示）
+void led_matrix_blit_benchmark(void);
+
 #endif // LED_MATRIX_H
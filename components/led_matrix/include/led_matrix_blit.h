@@ -0,0 +1,100 @@
+/**
+ * @file led_matrix_blit.h
+ * @brief LED Matrix 矩形/扫描线/精灵块传输引擎
+ *
+ * 在RGB888帧缓冲区上提供裁剪后的矩形填充、水平扫描线、1-bpp掩码精灵
+ * 和RGB精灵拷贝，按行使用memcpy/memset，避免逐像素调用和逐像素边界检查。
+ * 目标表面可以是LED Matrix显示网格，也可以是动画存储（带掩码平面）。
+ */
+
+#ifndef LED_MATRIX_BLIT_H
+#define LED_MATRIX_BLIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "led_color.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 绘制目标表面
+typedef struct {
+    uint8_t *pixels;    // RGB888像素缓冲区，行优先，每行width*3字节
+    uint8_t *mask;      // 可选掩码平面（每像素1字节，绘制时置1），NULL表示无掩码
+    int width;          // 表面宽度（像素）
+    int height;         // 表面高度（像素）
+} led_blit_surface_t;
+
+/**
+ * @brief 设置单个像素（带裁剪）
+ */
+void led_blit_pixel(const led_blit_surface_t *dst, int x, int y, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief 填充矩形区域（自动裁剪到表面范围）
+ *
+ * @param dst 目标表面
+ * @param x 左上角X
+ * @param y 左上角Y
+ * @param w 宽度
+ * @param h 高度
+ */
+void led_blit_fill_rect(const led_blit_surface_t *dst, int x, int y, int w, int h,
+                        uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief 绘制水平扫描线（自动裁剪）
+ *
+ * @param dst 目标表面
+ * @param x 起点X
+ * @param y 行号
+ * @param len 长度（像素）
+ */
+void led_blit_hspan(const led_blit_surface_t *dst, int x, int y, int len,
+                    uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief 拷贝一行RGB像素（自动裁剪）
+ *
+ * @param dst 目标表面
+ * @param x 起点X
+ * @param y 行号
+ * @param rgb 源像素（RGB888，len*3字节）
+ * @param len 像素个数
+ */
+void led_blit_rgb_span(const led_blit_surface_t *dst, int x, int y, const uint8_t *rgb, int len);
+
+/**
+ * @brief 绘制1-bpp掩码精灵，置位的像素使用指定颜色
+ *
+ * @param dst 目标表面
+ * @param x 精灵左上角X
+ * @param y 精灵左上角Y
+ * @param bits 位图数据，每行(w+7)/8字节，高位在前
+ * @param w 精灵宽度
+ * @param h 精灵高度
+ */
+void led_blit_mask_sprite(const led_blit_surface_t *dst, int x, int y,
+                          const uint8_t *bits, int w, int h,
+                          uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief 绘制RGB精灵
+ *
+ * @param dst 目标表面
+ * @param x 精灵左上角X
+ * @param y 精灵左上角Y
+ * @param rgb 源像素（RGB888，w*h*3字节，行优先）
+ * @param w 精灵宽度
+ * @param h 精灵高度
+ * @param color_key 透明色，等于该颜色的像素不绘制；NULL表示整行直接拷贝
+ */
+void led_blit_rgb_sprite(const led_blit_surface_t *dst, int x, int y,
+                         const uint8_t *rgb, int w, int h, const rgb_t *color_key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_MATRIX_BLIT_H
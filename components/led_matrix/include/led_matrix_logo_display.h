@@ -10,6 +10,8 @@
 #define LED_MATRIX_LOGO_DISPLAY_H
 
 #include "esp_err.h"
+#include "led_transition.h"
+#include "led_playlist.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -31,12 +33,17 @@ typedef enum {
 // Logo显示配置
 typedef struct {
     logo_display_mode_t mode;           // 显示模式
-    uint32_t switch_interval_ms;        // 切换间隔（毫秒）
+    uint32_t switch_interval_ms;        // 切换间隔（毫秒），Logo未设置显示时长时使用
     uint32_t animation_speed_ms;        // 动画更新间隔（毫秒）
     bool auto_start;                    // 是否自动启动
     bool enable_effects;                // 是否启用动画效果
     uint8_t brightness;                 // 亮度 (0-255)
     const char* json_file_path;         // JSON文件路径
+    bool prefetch_next;                 // 切换后预先解码下一个Logo
+    bool auto_reload;                   // 检测到TF卡上的动画文件变化时自动热更新
+    led_transition_type_t transition;   // 切换Logo时的过渡效果
+    uint32_t transition_ms;             // 过渡时长（毫秒），0表示直接切换
+    const char* placeholder_name;       // 后台加载期间显示的内置动画名称，NULL或找不到时显示第一个
 } logo_display_config_t;
 
 // Logo显示状态
@@ -49,6 +56,9 @@ typedef struct {
     uint32_t next_switch_time;          // 下次切换时间
     logo_display_mode_t current_mode;   // 当前显示模式
     char current_logo_name[64];         // 当前Logo名称
+    uint32_t decoded_logos;             // 已解码的Logo数量
+    bool is_loading;                    // 正在后台初始化硬件和加载动画（显示占位画面）
+    uint32_t boot_load_ms;              // 首次启动时后台初始化和加载的耗时（毫秒）
 } logo_display_status_t;
 
 // ========== 核心接口 ==========
@@ -64,7 +74,10 @@ esp_err_t led_matrix_logo_display_init(const logo_display_config_t* config);
 /**
  * @brief 启动Logo显示
  * 
- * @return esp_err_t ESP_OK成功，其他值表示失败
+ * 首次启动时立即返回：LED矩阵硬件初始化、TF卡挂载和动画加载在后台任务中进行，
+ * 期间显示内置的占位动画，加载完成后自动开始显示Logo
+ * 
+ * @return esp_err_t ESP_OK成功（或已提交后台启动），其他值表示失败
  */
 esp_err_t led_matrix_logo_display_start(void);
 
@@ -76,6 +89,9 @@ void led_matrix_logo_display_stop(void);
 /**
  * @brief 重新加载Logo动画
  * 
+ * 显示运行中时在后台任务加载并整体替换动画，期间继续显示当前Logo，
+ * 函数在提交请求后立即返回；未运行时同步加载
+ * 
  * @param json_file_path JSON文件路径，NULL使用当前配置的路径
  * @return esp_err_t ESP_OK成功，其他值表示失败
  */
@@ -134,6 +150,29 @@ void led_matrix_logo_display_set_animation_speed(uint32_t speed_ms);
  */
 void led_matrix_logo_display_set_brightness(uint8_t brightness);
 
+/**
+ * @brief 设置切换Logo时的过渡效果
+ * 
+ * 过渡期间把切换前的最后一帧与新Logo的画面按时间混合，需要启用动画效果
+ * 
+ * @param type 过渡效果类型
+ * @param duration_ms 过渡时长（毫秒），0表示直接切换
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_matrix_logo_display_set_transition(led_transition_type_t type, uint32_t duration_ms);
+
+/**
+ * @brief 设置Logo的播放参数（权重、显示时长、每日时间窗口）
+ * 
+ * 随机模式按权重从洗牌袋中选择；顺序模式跳过权重为0或不在时间窗口内的Logo。
+ * 系统时间尚未设置时忽略时间窗口。设置在重新加载后按索引保留。
+ * 
+ * @param logo_index Logo索引
+ * @param entry 播放参数
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t led_matrix_logo_display_set_playlist_entry(uint32_t logo_index, const led_playlist_entry_t* entry);
+
 /**
  * @brief 启用/禁用动画效果
  * 
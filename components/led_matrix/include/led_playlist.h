@@ -0,0 +1,128 @@
+/**
+ * @file led_playlist.h
+ * @brief Logo播放列表调度器
+ *
+ * 每个条目有权重、显示时长和每日时间窗口。随机播放使用洗牌袋：
+ * 袋中每个条目按权重放入若干次，洗牌后依次取出，取完再重新装袋，
+ * 因此每个条目在一袋内必定出现，两次出现之间的间隔不超过两袋的长度。
+ * 选择只做一次取出和至多一次交换，不使用重试循环。
+ */
+
+#ifndef LED_PLAYLIST_H
+#define LED_PLAYLIST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+#define LED_PLAYLIST_MAX_ENTRIES        10      // 最大条目数量（与Logo数量上限一致）
+#define LED_PLAYLIST_MAX_WEIGHT         8       // 单个条目的最大权重
+#define LED_PLAYLIST_BAG_SIZE           (LED_PLAYLIST_MAX_ENTRIES * LED_PLAYLIST_MAX_WEIGHT)
+#define LED_PLAYLIST_MINUTES_PER_DAY    1440
+#define LED_PLAYLIST_ANY_TIME           (-1)    // 当前时间未知，忽略时间窗口
+
+// 播放列表条目
+typedef struct {
+    uint8_t weight;                     // 权重（0表示不播放）
+    uint32_t duration_ms;               // 显示时长（毫秒），0表示使用默认切换间隔
+    uint16_t window_start;              // 时间窗口开始（当天第几分钟）
+    uint16_t window_end;                // 时间窗口结束（不含），与开始相同表示全天；可跨越午夜
+} led_playlist_entry_t;
+
+// 播放列表状态（调用者分配）
+typedef struct {
+    led_playlist_entry_t entries[LED_PLAYLIST_MAX_ENTRIES];
+    uint8_t count;                      // 条目数量
+    uint8_t bag[LED_PLAYLIST_BAG_SIZE]; // 洗牌袋
+    uint8_t bag_size;                   // 袋中条目总数
+    uint8_t bag_pos;                    // 下一个取出的位置
+    uint16_t bag_mask;                  // 装袋时可播放的条目位图
+    int last;                           // 上一次选择的条目，-1表示没有
+    uint32_t rng_state;                 // xorshift32随机数状态
+} led_playlist_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 获取默认条目（权重1，使用默认时长，全天播放）
+ *
+ * @return led_playlist_entry_t 默认条目
+ */
+led_playlist_entry_t led_playlist_get_default_entry(void);
+
+/**
+ * @brief 初始化播放列表，所有条目使用默认设置
+ *
+ * @param playlist 播放列表
+ * @param count 条目数量
+ * @param seed 随机数种子（0时使用固定种子）
+ */
+void led_playlist_init(led_playlist_t *playlist, uint8_t count, uint32_t seed);
+
+/**
+ * @brief 修改条目数量，保留已有条目的设置并清空洗牌袋
+ *
+ * @param playlist 播放列表
+ * @param count 条目数量
+ */
+void led_playlist_set_count(led_playlist_t *playlist, uint8_t count);
+
+/**
+ * @brief 设置条目
+ *
+ * @param playlist 播放列表
+ * @param index 条目索引
+ * @param entry 条目设置
+ * @return bool true成功，false表示索引或设置无效
+ */
+bool led_playlist_set_entry(led_playlist_t *playlist, uint8_t index, const led_playlist_entry_t *entry);
+
+/**
+ * @brief 检查条目在指定时间是否可以播放
+ *
+ * @param playlist 播放列表
+ * @param index 条目索引
+ * @param minute_of_day 当天第几分钟，LED_PLAYLIST_ANY_TIME表示忽略时间窗口
+ * @return bool true可以播放
+ */
+bool led_playlist_is_eligible(const led_playlist_t *playlist, uint8_t index, int minute_of_day);
+
+/**
+ * @brief 按权重随机选择下一个条目（洗牌袋）
+ *
+ * @param playlist 播放列表
+ * @param minute_of_day 当天第几分钟，LED_PLAYLIST_ANY_TIME表示忽略时间窗口
+ * @return int 条目索引，-1表示当前没有可播放的条目
+ */
+int led_playlist_next_shuffled(led_playlist_t *playlist, int minute_of_day);
+
+/**
+ * @brief 按顺序选择下一个可播放的条目
+ *
+ * @param playlist 播放列表
+ * @param current 当前条目索引
+ * @param minute_of_day 当天第几分钟，LED_PLAYLIST_ANY_TIME表示忽略时间窗口
+ * @return int 条目索引，-1表示当前没有可播放的条目
+ */
+int led_playlist_next_in_order(const led_playlist_t *playlist, uint8_t current, int minute_of_day);
+
+/**
+ * @brief 获取条目的显示时长
+ *
+ * @param playlist 播放列表
+ * @param index 条目索引
+ * @param default_ms 条目未设置时长时使用的默认值
+ * @return uint32_t 显示时长（毫秒）
+ */
+uint32_t led_playlist_get_duration(const led_playlist_t *playlist, uint8_t index, uint32_t default_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_PLAYLIST_H
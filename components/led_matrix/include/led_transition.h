@@ -0,0 +1,65 @@
+/**
+ * @file led_transition.h
+ * @brief Logo切换过渡效果（淡入淡出、擦除、溶解）
+ *
+ * 把切换前最后一帧与新动画的当前帧按透明度混合。透明度为0-256的整数，
+ * 混合只使用整数乘法和移位，不使用浮点，每帧开销为一次逐像素遍历。
+ */
+
+#ifndef LED_TRANSITION_H
+#define LED_TRANSITION_H
+
+#include <stdint.h>
+#include "led_matrix_blit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+#define LED_TRANSITION_ALPHA_MAX        256     // 透明度上限（完全显示新画面）
+
+// 过渡效果类型
+typedef enum {
+    LED_TRANSITION_NONE = 0,            // 直接切换
+    LED_TRANSITION_FADE,                // 淡入淡出
+    LED_TRANSITION_WIPE,                // 从左到右擦除（边缘一列按亚像素位置混合）
+    LED_TRANSITION_DISSOLVE             // 溶解（像素按固定的伪随机顺序切换）
+} led_transition_type_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 根据已经过的时间计算过渡透明度
+ *
+ * @param elapsed_us 过渡开始后经过的时间（微秒）
+ * @param duration_ms 过渡总时长（毫秒）
+ * @return uint16_t 透明度，0为旧画面，LED_TRANSITION_ALPHA_MAX为新画面
+ */
+uint16_t led_transition_alpha(int64_t elapsed_us, uint32_t duration_ms);
+
+/**
+ * @brief 把旧画面按透明度混合到新画面上
+ *
+ * @param type 过渡效果类型
+ * @param from 旧画面（RGB888，与dst尺寸相同，行优先）
+ * @param dst 新画面，混合结果原地写回
+ * @param alpha 透明度（0-LED_TRANSITION_ALPHA_MAX）
+ */
+void led_transition_blend(led_transition_type_t type, const uint8_t *from,
+                          const led_blit_surface_t *dst, uint16_t alpha);
+
+/**
+ * @brief 获取过渡效果名称
+ *
+ * @param type 过渡效果类型
+ * @return const char* 名称
+ */
+const char* led_transition_get_name(led_transition_type_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LED_TRANSITION_H
@@ -1,8 +1,11 @@
 #include "led_animation.h"
+#include "led_animation_builtin.h"
 #include "led_matrix.h"
 #include "led_color.h"
 #include "esp_log.h"
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
@@ -11,32 +14,53 @@ static const char *TAG = "LED_ANIMATION";
 // 动画配置常量
 #define MAX_ANIMATIONS_STORAGE 10
 
-// 单个动画数据结构
+// 可写的动画数据平面（堆上分配，槽位复用时保留）
 typedef struct {
-    char name[64];  // 动画名称
     uint8_t mask[LED_MATRIX_HEIGHT][LED_MATRIX_WIDTH]; // 掩码，标记哪些像素应该被照亮
     uint8_t original_colors[LED_MATRIX_HEIGHT][LED_MATRIX_WIDTH][3]; // 每个点的原始颜色
+} animation_planes_t;
+
+// 单个动画数据结构：渲染数据指向槽位自己的平面，或直接指向flash中的内置动画帧
+typedef struct {
+    char name[64];  // 动画名称
+    const uint8_t *mask;            // 掩码（HEIGHT x WIDTH）
+    const uint8_t *colors;          // 原始颜色（HEIGHT x WIDTH x 3）
+    animation_planes_t *planes;     // 槽位的可写平面，未分配时为NULL
+    bool read_only; // 内置动画，数据位于flash，不可修改
     bool is_valid; // 动画是否有效
 } animation_data_t;
 
+// 动画库：一组动画及其当前选择。重新加载时在新动画库中构建，完成后整体替换
+struct led_animation_bank {
+    animation_data_t animations[MAX_ANIMATIONS_STORAGE]; // 动画槽位（不含像素数据）
+    int count;              // 已加载的动画数量
+    int current_index;      // 当前播放的动画索引
+    uint32_t refs;          // 正在使用该动画库的读者数量
+    bool retired;           // 已被替换，最后一个读者释放后回收
+    bool dynamic;           // 堆上分配（初始动画库为静态存储，回收时只释放平面）
+};
+
 // 动画系统数据
-static animation_data_t animations[MAX_ANIMATIONS_STORAGE]; // 存储的动画数组
-static int current_animation_index = 0; // 当前播放的动画索引
-static int loaded_animations_count = 0; // 已加载的动画数量
+static led_animation_bank_t s_initial_bank;                 // 启动时使用的动画库
+static led_animation_bank_t *s_active_bank = &s_initial_bank; // 当前发布的动画库
+static portMUX_TYPE s_bank_lock = portMUX_INITIALIZER_UNLOCKED;
 static int flash_position = 0; // 闪光位置（从 0,0 开始）
 static bool animation_running = true; // 动画是否正在运行
 static uint8_t animation_speed = ANIMATION_SPEED; // 动画速度
 
+// 静态函数声明
+static led_animation_bank_t* bank_acquire(void);
+static void bank_release(led_animation_bank_t *bank);
+static void bank_free(led_animation_bank_t *bank);
+
 // 初始化动画系统
 void led_animation_init(void) {
-    // 清空所有动画数据
-    memset(animations, 0, sizeof(animations));
-    for (int i = 0; i < MAX_ANIMATIONS_STORAGE; i++) {
-        animations[i].is_valid = false;
-    }
+    // 清空所有动画（已分配的平面保留给之后创建的槽位复用）
+    led_animation_bank_t *bank = bank_acquire();
+    bank->current_index = 0;
+    bank->count = 0;
+    bank_release(bank);
     
-    current_animation_index = 0;
-    loaded_animations_count = 0;
     flash_position = 0;
     animation_running = true;
     animation_speed = ANIMATION_SPEED;
@@ -44,30 +68,123 @@ void led_animation_init(void) {
     ESP_LOGI(TAG, "动画系统初始化完成");
 }
 
-// 获取当前动画的数据指针
-static animation_data_t* get_current_animation(void) {
-    if (loaded_animations_count == 0 || current_animation_index >= loaded_animations_count) {
+// 获取当前发布的动画库并登记为读者
+static led_animation_bank_t* bank_acquire(void) {
+    portENTER_CRITICAL(&s_bank_lock);
+    led_animation_bank_t *bank = s_active_bank;
+    bank->refs++;
+    portEXIT_CRITICAL(&s_bank_lock);
+    return bank;
+}
+
+// 释放动画库，已被替换且没有其他读者时回收
+static void bank_release(led_animation_bank_t *bank) {
+    portENTER_CRITICAL(&s_bank_lock);
+    bank->refs--;
+    bool reclaim = bank->retired && bank->refs == 0;
+    portEXIT_CRITICAL(&s_bank_lock);
+
+    if (reclaim) {
+        bank_free(bank);
+    }
+}
+
+// 回收动画库的平面；初始动画库为静态存储，只回收平面
+static void bank_free(led_animation_bank_t *bank) {
+    for (int i = 0; i < MAX_ANIMATIONS_STORAGE; i++) {
+        free(bank->animations[i].planes);
+        bank->animations[i].planes = NULL;
+    }
+    if (bank->dynamic) {
+        free(bank);
+    }
+}
+
+// 获取动画库中当前动画的数据指针
+static animation_data_t* get_current_animation(led_animation_bank_t *bank) {
+    if (bank->count == 0 || bank->current_index >= bank->count) {
         return NULL;
     }
-    return &animations[current_animation_index];
+    return &bank->animations[bank->current_index];
 }
 
-// 获取当前动画的掩码
-__attribute__((unused)) static uint8_t (*get_current_mask(void))[LED_MATRIX_WIDTH] {
-    animation_data_t* current = get_current_animation();
-    if (current == NULL) {
+// 获取可写的当前动画，内置动画返回NULL
+static animation_planes_t* get_current_planes(led_animation_bank_t *bank) {
+    animation_data_t *current = get_current_animation(bank);
+    if (current == NULL || current->read_only) {
         return NULL;
     }
-    return current->mask;
+    return current->planes;
 }
 
-// 获取当前动画的颜色数组
-__attribute__((unused)) static uint8_t (*get_current_colors(void))[LED_MATRIX_WIDTH][3] {
-    animation_data_t* current = get_current_animation();
-    if (current == NULL) {
+// 填充动画槽位的绘制表面
+static void fill_surface(animation_planes_t *planes, led_blit_surface_t *surface) {
+    surface->pixels = &planes->original_colors[0][0][0];
+    surface->mask = &planes->mask[0][0];
+    surface->width = LED_MATRIX_WIDTH;
+    surface->height = LED_MATRIX_HEIGHT;
+}
+
+// 占用下一个槽位并设置名称（不设置像素数据）
+static animation_data_t* bank_claim_slot(led_animation_bank_t *bank, const char *name) {
+    if (bank->count >= MAX_ANIMATIONS_STORAGE) {
+        ESP_LOGE(TAG, "动画存储已满，无法创建新动画");
         return NULL;
     }
-    return current->original_colors;
+    
+    int index = bank->count;
+    animation_data_t* new_anim = &bank->animations[index];
+    
+    // 清空槽位，保留之前分配的平面
+    animation_planes_t *planes = new_anim->planes;
+    memset(new_anim, 0, sizeof(animation_data_t));
+    new_anim->planes = planes;
+    
+    // 设置动画名称
+    if (name != NULL) {
+        strncpy(new_anim->name, name, sizeof(new_anim->name) - 1);
+        new_anim->name[sizeof(new_anim->name) - 1] = '\0';
+    } else {
+        snprintf(new_anim->name, sizeof(new_anim->name), "动画%d", index);
+    }
+    return new_anim;
+}
+
+// 在动画库中创建新动画槽位
+static int bank_add(led_animation_bank_t *bank, const char *name) {
+    animation_data_t *new_anim = bank_claim_slot(bank, name);
+    if (new_anim == NULL) {
+        return -1;
+    }
+    
+    // 平面按需分配（启用PSRAM时由malloc放入PSRAM）
+    if (new_anim->planes == NULL) {
+        new_anim->planes = malloc(sizeof(animation_planes_t));
+        if (new_anim->planes == NULL) {
+            ESP_LOGE(TAG, "无法分配动画数据 (%u 字节)", (unsigned)sizeof(animation_planes_t));
+            return -1;
+        }
+    }
+    memset(new_anim->planes, 0, sizeof(animation_planes_t));
+    
+    new_anim->mask = &new_anim->planes->mask[0][0];
+    new_anim->colors = &new_anim->planes->original_colors[0][0][0];
+    new_anim->is_valid = true;
+    int index = bank->count++;
+    
+    ESP_LOGI(TAG, "创建新动画: %s (索引: %d)", new_anim->name, index);
+    return index;
+}
+
+static esp_err_t bank_set_name(led_animation_bank_t *bank, int animation_index, const char *name) {
+    if (animation_index < 0 || animation_index >= bank->count || name == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    animation_data_t *anim = &bank->animations[animation_index];
+    strncpy(anim->name, name, sizeof(anim->name) - 1);
+    anim->name[sizeof(anim->name) - 1] = '\0';
+    return ESP_OK;
 }
 
 // 设置动画点位置和颜色
@@ -77,16 +194,16 @@ void led_animation_set_point(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
         return;
     }
     
-    animation_data_t* current = get_current_animation();
-    if (current == NULL) {
-        return;
+    led_animation_bank_t *bank = bank_acquire();
+    animation_planes_t* current = get_current_planes(bank);
+    if (current != NULL) {
+        // 设置掩码和原始颜色
+        current->mask[y][x] = 1;
+        current->original_colors[y][x][0] = r;
+        current->original_colors[y][x][1] = g;
+        current->original_colors[y][x][2] = b;
     }
-    
-    // 设置掩码和原始颜色
-    current->mask[y][x] = 1;
-    current->original_colors[y][x][0] = r;
-    current->original_colors[y][x][1] = g;
-    current->original_colors[y][x][2] = b;
+    bank_release(bank);
 }
 
 // 更新动画点的颜色
@@ -96,26 +213,26 @@ void led_animation_update_point(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
         return;
     }
     
-    animation_data_t* current = get_current_animation();
-    if (current == NULL) {
-        return;
+    led_animation_bank_t *bank = bank_acquire();
+    animation_planes_t* current = get_current_planes(bank);
+    if (current != NULL) {
+        // 仅更新颜色，不改变掩码
+        current->original_colors[y][x][0] = r;
+        current->original_colors[y][x][1] = g;
+        current->original_colors[y][x][2] = b;
     }
-    
-    // 仅更新颜色，不改变掩码
-    current->original_colors[y][x][0] = r;
-    current->original_colors[y][x][1] = g;
-    current->original_colors[y][x][2] = b;
+    bank_release(bank);
 }
 
 // 清除所有动画点
 void led_animation_clear_points(void) {
-    animation_data_t* current = get_current_animation();
-    if (current == NULL) {
-        return;
+    led_animation_bank_t *bank = bank_acquire();
+    animation_planes_t* current = get_current_planes(bank);
+    if (current != NULL) {
+        memset(current->mask, 0, sizeof(current->mask));
+        memset(current->original_colors, 0, sizeof(current->original_colors));
     }
-    
-    memset(current->mask, 0, sizeof(current->mask));
-    memset(current->original_colors, 0, sizeof(current->original_colors));
+    bank_release(bank);
 }
 
 // 计算闪光亮度（基于到闪光中心线的距离）
@@ -135,6 +252,16 @@ static float calculate_flash_brightness(int y, int x, int flash_pos) {
     return 0.0f; // 闪光宽度外无亮度
 }
 
+// 判断闪光是否完全位于矩阵之外（此时渲染结果与无闪光时相同）
+static bool is_flash_outside(int flash_pos) {
+    // 点(x,y)到闪光线的距离为|y - x + flash_pos| / sqrt(2)，其中y - x最小为-(WIDTH - 1)
+    int nearest = flash_pos - (LED_MATRIX_WIDTH - 1);
+    if (nearest <= 0) {
+        return false;
+    }
+    return ((float)nearest / 1.414f) >= FLASH_WIDTH;
+}
+
 // 更新并渲染当前动画
 void led_animation_update(void) {
     // 如果动画没有运行，不更新
@@ -142,31 +269,49 @@ void led_animation_update(void) {
         return;
     }
     
-    animation_data_t* current = get_current_animation();
+    led_animation_render();
+    
+    // 刷新矩阵显示
+    led_matrix_refresh();
+}
+
+// 把当前动画的下一帧绘制到显示网格（不刷新）
+void led_animation_render(void) {
+    if (!animation_running) {
+        return;
+    }
+    
+    // 直接在显示网格上绘制，先整屏清空
+    led_blit_surface_t frame;
+    led_matrix_get_surface(&frame);
+    led_blit_fill_rect(&frame, 0, 0, LED_MATRIX_WIDTH, LED_MATRIX_HEIGHT, 0, 0, 0);
+    
+    // 渲染期间持有动画库，重新加载替换动画库后旧数据在本帧结束前保持有效
+    led_animation_bank_t *bank = bank_acquire();
+    animation_data_t* current = get_current_animation(bank);
     if (current == NULL) {
-        // 没有可用动画，清空显示
-        for (int y = 0; y < LED_MATRIX_HEIGHT; y++) {
-            for (int x = 0; x < LED_MATRIX_WIDTH; x++) {
-                led_matrix_set_pixel(x, y, 0, 0, 0);
-            }
-        }
-        led_matrix_refresh();
+        // 没有可用动画，显示黑屏
+        bank_release(bank);
         return;
     }
     
-    // 清空网格
+    // 掩码中的像素应用原始颜色（经过亮度和饱和度调整），内置动画直接读取flash中的帧
+    const uint8_t *mask = current->mask;
+    const uint8_t *colors = current->colors;
     for (int y = 0; y < LED_MATRIX_HEIGHT; y++) {
+        uint8_t *row = frame.pixels + y * LED_MATRIX_WIDTH * 3;
+        const uint8_t *mask_row = mask + y * LED_MATRIX_WIDTH;
+        const uint8_t *color_row = colors + y * LED_MATRIX_WIDTH * 3;
         for (int x = 0; x < LED_MATRIX_WIDTH; x++) {
-            if (current->mask[y][x]) {
-                // 应用原始颜色（经过亮度和饱和度调整）
+            if (mask_row[x]) {
                 rgb_t adjusted = adjust_brightness_saturation(
-                    current->original_colors[y][x][0], 
-                    current->original_colors[y][x][1], 
-                    current->original_colors[y][x][2]
+                    color_row[x * 3 + 0], 
+                    color_row[x * 3 + 1], 
+                    color_row[x * 3 + 2]
                 );
-                led_matrix_set_pixel(x, y, adjusted.r, adjusted.g, adjusted.b);
-            } else {
-                led_matrix_set_pixel(x, y, 0, 0, 0);
+                row[x * 3 + 0] = adjusted.r;
+                row[x * 3 + 1] = adjusted.g;
+                row[x * 3 + 2] = adjusted.b;
             }
         }
     }
@@ -179,43 +324,66 @@ void led_animation_update(void) {
         flash_position = 0; // 从(0,0)开始
     }
     
-    // 应用闪光效果到掩码中的所有像素
+    // 闪光只影响闪光线x = y + flash_position附近的窄带，逐行只遍历该区段
+    const int band = (int)(FLASH_WIDTH * 1.414f) + 1;
     for (int y = 0; y < LED_MATRIX_HEIGHT; y++) {
-        for (int x = 0; x < LED_MATRIX_WIDTH; x++) {
-            if (current->mask[y][x]) {
-                // 根据到闪光线的距离计算亮度
-                float brightness = calculate_flash_brightness(y, x, flash_position);
-                
-                if (brightness > 0.0f) {
-                    // 增强原始颜色的亮度
-                    float brighten_factor = 1.0f + brightness * 1.5f; // 最大2.5倍亮度
-                    
-                    // 获取原始调整后的颜色
-                    rgb_t adjusted = adjust_brightness_saturation(
-                        current->original_colors[y][x][0], 
-                        current->original_colors[y][x][1], 
-                        current->original_colors[y][x][2]
-                    );
-                    
-                    // 增加亮度
-                    uint16_t r = (uint16_t)(adjusted.r * brighten_factor);
-                    uint16_t g = (uint16_t)(adjusted.g * brighten_factor);
-                    uint16_t b = (uint16_t)(adjusted.b * brighten_factor);
-                    
-                    // 限制到有效范围
-                    r = (r > 255) ? 255 : r;
-                    g = (g > 255) ? 255 : g;
-                    b = (b > 255) ? 255 : b;
-                    
-                    // 设置像素
-                    led_matrix_set_pixel(x, y, (uint8_t)r, (uint8_t)g, (uint8_t)b);
-                }
+        int center = y + flash_position;
+        int x_start = (center - band < 0) ? 0 : center - band;
+        int x_end = (center + band >= LED_MATRIX_WIDTH) ? LED_MATRIX_WIDTH - 1 : center + band;
+        uint8_t *row = frame.pixels + y * LED_MATRIX_WIDTH * 3;
+        
+        for (int x = x_start; x <= x_end; x++) {
+            if (!mask[y * LED_MATRIX_WIDTH + x]) {
+                continue;
+            }
+            
+            // 根据到闪光线的距离计算亮度
+            float brightness = calculate_flash_brightness(y, x, flash_position);
+            if (brightness <= 0.0f) {
+                continue;
+            }
+            
+            // 在已调整的底色上增强亮度（最大2.5倍）
+            float brighten_factor = 1.0f + brightness * 1.5f;
+            for (int c = 0; c < 3; c++) {
+                uint16_t v = (uint16_t)(row[x * 3 + c] * brighten_factor);
+                row[x * 3 + c] = (v > 255) ? 255 : (uint8_t)v;
             }
         }
     }
     
-    // 刷新矩阵显示
-    led_matrix_refresh();
+    bank_release(bank);
+}
+
+// 获取当前帧之后画面保持不变的更新次数
+uint32_t led_animation_get_idle_frames(void) {
+    led_animation_bank_t *bank = bank_acquire();
+    bool has_animation = get_current_animation(bank) != NULL;
+    bank_release(bank);
+    
+    if (!animation_running || animation_speed == 0 || !has_animation) {
+        return LED_ANIMATION_IDLE_FOREVER;
+    }
+    
+    // 闪光仍在矩阵内，下一帧画面会变化
+    if (!is_flash_outside(flash_position)) {
+        return 0;
+    }
+    
+    // 闪光位置单调增加直到复位，复位前的所有位置都在矩阵外
+    int limit = LED_MATRIX_WIDTH + LED_MATRIX_HEIGHT + FLASH_WIDTH;
+    if (flash_position >= limit) {
+        return 0;
+    }
+    return (uint32_t)((limit - flash_position) / animation_speed);
+}
+
+// 快进动画状态
+void led_animation_skip_frames(uint32_t frames) {
+    if (frames == 0 || frames == LED_ANIMATION_IDLE_FOREVER) {
+        return;
+    }
+    flash_position += (int)(frames * animation_speed);
 }
 
 // 暂停/继续动画
@@ -242,113 +410,117 @@ uint8_t led_animation_get_speed(void) {
 
 // 创建新动画槽位
 int led_animation_create_new(const char* name) {
-    if (loaded_animations_count >= MAX_ANIMATIONS_STORAGE) {
-        ESP_LOGE(TAG, "动画存储已满，无法创建新动画");
-        return -1;
-    }
-    
-    int index = loaded_animations_count;
-    animation_data_t* new_anim = &animations[index];
-    
-    // 清空动画数据
-    memset(new_anim, 0, sizeof(animation_data_t));
-    
-    // 设置动画名称
-    if (name != NULL) {
-        strncpy(new_anim->name, name, sizeof(new_anim->name) - 1);
-        new_anim->name[sizeof(new_anim->name) - 1] = '\0';
-    } else {
-        snprintf(new_anim->name, sizeof(new_anim->name), "动画%d", index);
-    }
-    
-    new_anim->is_valid = true;
-    loaded_animations_count++;
-    
-    ESP_LOGI(TAG, "创建新动画: %s (索引: %d)", new_anim->name, index);
+    led_animation_bank_t *bank = bank_acquire();
+    int index = bank_add(bank, name);
+    bank_release(bank);
     return index;
 }
 
 // 选择当前播放的动画
 esp_err_t led_animation_select(int animation_index) {
-    if (animation_index < 0 || animation_index >= loaded_animations_count) {
-        ESP_LOGE(TAG, "动画索引无效: %d (范围: 0-%d)", animation_index, loaded_animations_count - 1);
-        return ESP_ERR_INVALID_ARG;
-    }
+    led_animation_bank_t *bank = bank_acquire();
+    esp_err_t ret = ESP_OK;
     
-    if (!animations[animation_index].is_valid) {
+    if (animation_index < 0 || animation_index >= bank->count) {
+        ESP_LOGE(TAG, "动画索引无效: %d (范围: 0-%d)", animation_index, bank->count - 1);
+        ret = ESP_ERR_INVALID_ARG;
+    } else if (!bank->animations[animation_index].is_valid) {
         ESP_LOGE(TAG, "动画无效: 索引 %d", animation_index);
-        return ESP_ERR_INVALID_STATE;
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        bank->current_index = animation_index;
+        flash_position = 0; // 重置闪光位置
+        ESP_LOGI(TAG, "切换到动画: %s (索引: %d)", bank->animations[animation_index].name, animation_index);
     }
     
-    current_animation_index = animation_index;
-    flash_position = 0; // 重置闪光位置
-    
-    ESP_LOGI(TAG, "切换到动画: %s (索引: %d)", animations[animation_index].name, animation_index);
-    return ESP_OK;
+    bank_release(bank);
+    return ret;
 }
 
 // 获取当前动画索引
 int led_animation_get_current_index(void) {
-    return current_animation_index;
+    led_animation_bank_t *bank = bank_acquire();
+    int index = bank->current_index;
+    bank_release(bank);
+    return index;
 }
 
 // 获取已加载的动画数量
 int led_animation_get_count(void) {
-    return loaded_animations_count;
+    led_animation_bank_t *bank = bank_acquire();
+    int count = bank->count;
+    bank_release(bank);
+    return count;
 }
 
-// 获取指定动画的名称
-const char* led_animation_get_name(int animation_index) {
-    if (animation_index < 0 || animation_index >= loaded_animations_count) {
-        return NULL;
+// 获取指定动画的名称（持有动画库期间复制，动画库随后被替换也不影响调用者）
+esp_err_t led_animation_get_name(int animation_index, char* name_buffer, size_t buffer_size) {
+    if (name_buffer == NULL || buffer_size == 0) {
+        return ESP_ERR_INVALID_ARG;
     }
     
-    if (!animations[animation_index].is_valid) {
-        return NULL;
+    led_animation_bank_t *bank = bank_acquire();
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    if (animation_index >= 0 && animation_index < bank->count && bank->animations[animation_index].is_valid) {
+        strncpy(name_buffer, bank->animations[animation_index].name, buffer_size - 1);
+        name_buffer[buffer_size - 1] = '\0';
+        ret = ESP_OK;
     }
-    
-    return animations[animation_index].name;
+    bank_release(bank);
+    return ret;
+}
+
+// 设置指定动画的名称
+esp_err_t led_animation_set_name(int animation_index, const char* name) {
+    led_animation_bank_t *bank = bank_acquire();
+    esp_err_t ret = bank_set_name(bank, animation_index, name);
+    bank_release(bank);
+    return ret;
 }
 
 // 切换到下一个动画
 esp_err_t led_animation_next(void) {
-    if (loaded_animations_count == 0) {
+    int count = led_animation_get_count();
+    if (count == 0) {
         ESP_LOGW(TAG, "没有可用的动画");
         return ESP_ERR_INVALID_STATE;
     }
     
-    int next_index = (current_animation_index + 1) % loaded_animations_count;
+    int next_index = (led_animation_get_current_index() + 1) % count;
     return led_animation_select(next_index);
 }
 
 // 切换到上一个动画
 esp_err_t led_animation_previous(void) {
-    if (loaded_animations_count == 0) {
+    int count = led_animation_get_count();
+    if (count == 0) {
         ESP_LOGW(TAG, "没有可用的动画");
         return ESP_ERR_INVALID_STATE;
     }
     
-    int prev_index = (current_animation_index - 1 + loaded_animations_count) % loaded_animations_count;
+    int prev_index = (led_animation_get_current_index() - 1 + count) % count;
     return led_animation_select(prev_index);
 }
 
 // 删除指定动画
 esp_err_t led_animation_delete(int animation_index) {
-    if (animation_index < 0 || animation_index >= loaded_animations_count) {
+    led_animation_bank_t *bank = bank_acquire();
+    if (animation_index < 0 || animation_index >= bank->count) {
         ESP_LOGE(TAG, "动画索引无效: %d", animation_index);
+        bank_release(bank);
         return ESP_ERR_INVALID_ARG;
     }
     
     // 标记动画为无效
-    animations[animation_index].is_valid = false;
+    bank->animations[animation_index].is_valid = false;
     
     // 如果删除的是当前动画，切换到下一个有效动画
-    if (animation_index == current_animation_index) {
+    if (animation_index == bank->current_index) {
         // 寻找下一个有效动画
         bool found = false;
-        for (int i = 0; i < loaded_animations_count; i++) {
-            if (animations[i].is_valid) {
-                current_animation_index = i;
+        for (int i = 0; i < bank->count; i++) {
+            if (bank->animations[i].is_valid) {
+                bank->current_index = i;
                 found = true;
                 break;
             }
@@ -356,10 +528,11 @@ esp_err_t led_animation_delete(int animation_index) {
         
         if (!found) {
             // 没有有效动画了
-            current_animation_index = 0;
+            bank->current_index = 0;
             ESP_LOGW(TAG, "删除最后一个动画，切换到空状态");
         }
     }
+    bank_release(bank);
     
     ESP_LOGI(TAG, "删除动画索引: %d", animation_index);
     return ESP_OK;
@@ -367,14 +540,172 @@ esp_err_t led_animation_delete(int animation_index) {
 
 // 清除所有动画
 void led_animation_clear_all(void) {
-    memset(animations, 0, sizeof(animations));
-    for (int i = 0; i < MAX_ANIMATIONS_STORAGE; i++) {
-        animations[i].is_valid = false;
+    // 发布空动画库，正在渲染的帧仍使用旧动画库
+    led_animation_bank_t *empty = led_animation_bank_create();
+    if (empty != NULL) {
+        led_animation_bank_publish(empty, 0);
+    } else {
+        led_animation_bank_t *bank = bank_acquire();
+        bank->current_index = 0;
+        bank->count = 0;
+        bank_release(bank);
+        flash_position = 0;
     }
     
-    current_animation_index = 0;
-    loaded_animations_count = 0;
+    ESP_LOGI(TAG, "清除所有动画");
+}
+
+// ========== 动画库接口 ==========
+
+// 创建空动画库
+led_animation_bank_t* led_animation_bank_create(void) {
+    led_animation_bank_t *bank = calloc(1, sizeof(led_animation_bank_t));
+    if (bank == NULL) {
+        ESP_LOGE(TAG, "无法分配动画库 (%u 字节)", (unsigned)sizeof(led_animation_bank_t));
+        return NULL;
+    }
+    bank->dynamic = true;
+    return bank;
+}
+
+// 销毁未发布的动画库
+void led_animation_bank_destroy(led_animation_bank_t* bank) {
+    if (bank != NULL && bank->dynamic && bank != s_active_bank) {
+        bank_free(bank);
+    }
+}
+
+// 在动画库中创建新动画槽位
+int led_animation_bank_add(led_animation_bank_t* bank, const char* name) {
+    if (bank == NULL) {
+        return -1;
+    }
+    return bank_add(bank, name);
+}
+
+// 在动画库中添加内置动画
+int led_animation_bank_add_builtin(led_animation_bank_t* bank, int builtin_index) {
+    const led_animation_builtin_t *builtin = led_animation_builtin_get(builtin_index);
+    if (bank == NULL || builtin == NULL) {
+        return -1;
+    }
+    
+    animation_data_t *new_anim = bank_claim_slot(bank, builtin->name);
+    if (new_anim == NULL) {
+        return -1;
+    }
+    
+    // 直接引用flash中的帧，不复制
+    new_anim->mask = builtin->mask;
+    new_anim->colors = builtin->colors;
+    new_anim->read_only = true;
+    new_anim->is_valid = true;
+    return bank->count++;
+}
+
+// 获取动画库中指定动画的绘制表面
+bool led_animation_bank_get_surface(led_animation_bank_t* bank, int animation_index, led_blit_surface_t *surface) {
+    if (bank == NULL || surface == NULL || animation_index < 0 || animation_index >= bank->count) {
+        return false;
+    }
+    animation_data_t *anim = &bank->animations[animation_index];
+    if (anim->read_only) {
+        return false;
+    }
+    fill_surface(anim->planes, surface);
+    return true;
+}
+
+// 获取动画库中指定动画的只读帧数据
+bool led_animation_bank_get_frame(const led_animation_bank_t* bank, int animation_index, const char **name,
+                                  const uint8_t **mask, const uint8_t **colors) {
+    if (bank == NULL || mask == NULL || colors == NULL || animation_index < 0 || animation_index >= bank->count) {
+        return false;
+    }
+    const animation_data_t *anim = &bank->animations[animation_index];
+    if (!anim->is_valid) {
+        return false;
+    }
+    if (name != NULL) {
+        *name = anim->name;
+    }
+    *mask = anim->mask;
+    *colors = anim->colors;
+    return true;
+}
+
+// 选择动画库中播放的动画
+esp_err_t led_animation_bank_select(led_animation_bank_t* bank, int animation_index) {
+    if (bank == NULL || animation_index < 0 || animation_index >= bank->count ||
+        !bank->animations[animation_index].is_valid) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    portENTER_CRITICAL(&s_bank_lock);
+    bank->current_index = animation_index;
+    if (bank == s_active_bank) {
+        flash_position = 0;
+    }
+    portEXIT_CRITICAL(&s_bank_lock);
+    return ESP_OK;
+}
+
+// 设置动画库中指定动画的名称
+esp_err_t led_animation_bank_set_name(led_animation_bank_t* bank, int animation_index, const char* name) {
+    if (bank == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return bank_set_name(bank, animation_index, name);
+}
+
+// 获取动画库中的动画数量
+int led_animation_bank_get_count(const led_animation_bank_t* bank) {
+    return bank != NULL ? bank->count : 0;
+}
+
+// 发布动画库
+esp_err_t led_animation_bank_publish(led_animation_bank_t* bank, int select_index) {
+    if (bank == NULL || !bank->dynamic) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    bank->current_index = (select_index >= 0 && select_index < bank->count) ? select_index : 0;
+    
+    // 指针替换在临界区内完成，读者要么看到完整的旧动画库，要么看到完整的新动画库
+    portENTER_CRITICAL(&s_bank_lock);
+    led_animation_bank_t *old = s_active_bank;
+    s_active_bank = bank;
     flash_position = 0;
+    old->retired = true;
+    bool reclaim = old->refs == 0;
+    portEXIT_CRITICAL(&s_bank_lock);
     
-    ESP_LOGI(TAG, "清除所有动画");
+    if (reclaim) {
+        bank_free(old);
+    }
+    
+    ESP_LOGI(TAG, "发布动画库: %d 个动画%s", bank->count, reclaim ? "" : "（旧动画库待读者释放后回收）");
+    return ESP_OK;
+}
+
+// 获取并持有当前发布的动画库
+led_animation_bank_t* led_animation_bank_acquire(void) {
+    return bank_acquire();
+}
+
+// 为已持有的动画库增加引用
+void led_animation_bank_retain(led_animation_bank_t* bank) {
+    if (bank == NULL) {
+        return;
+    }
+    portENTER_CRITICAL(&s_bank_lock);
+    bank->refs++;
+    portEXIT_CRITICAL(&s_bank_lock);
+}
+
+// 释放持有的动画库
+void led_animation_bank_release(led_animation_bank_t* bank) {
+    if (bank != NULL) {
+        bank_release(bank);
+    }
 }
@@ -0,0 +1,507 @@
+/**
+ * @file led_animation_binary.c
+ * @brief 预编译二进制动画格式加载实现
+ *
+ * 整个文件一次读入内存，先校验文件头、CRC和偏移表，全部通过后才解码到
+ * 新的动画库，损坏的文件不会破坏已加载的动画。
+ */
+
+#include "led_animation_binary.h"
+#include "led_animation.h"
+#include "led_matrix.h"
+#include "bsp_storage.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_rom_crc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static const char *TAG = "LED_ANIM_BIN";
+
+#define BITMAP_SIZE ((LED_MATRIX_WIDTH * LED_MATRIX_HEIGHT + 7) / 8)
+#define FRAME_PIXELS (LED_MATRIX_WIDTH * LED_MATRIX_HEIGHT)
+#define MAX_NAME_LEN 63
+#define PALETTE_MAX_COLORS 65535
+#define PALETTE_EMPTY 0xFFFF
+
+// 编码时的调色板（开放寻址散列表，颜色 -> 调色板索引）
+typedef struct {
+    uint8_t *colors;                // 调色板（RGB）
+    uint16_t *slots;                // 散列表，PALETTE_EMPTY表示空
+    uint32_t capacity;              // 散列表大小（2的幂）
+    uint32_t count;                 // 调色板颜色数
+} palette_builder_t;
+
+// ========== 静态函数声明 ==========
+static esp_err_t validate_image(const uint8_t *data, size_t size);
+static esp_err_t decode_animation(led_animation_bank_t *bank, const uint8_t *data,
+                                  const led_anim_bin_header_t *header, const led_anim_bin_entry_t *entry);
+static int count_bits(const uint8_t *bitmap);
+static esp_err_t palette_init(palette_builder_t *palette, uint32_t max_colors);
+static int palette_lookup(palette_builder_t *palette, const uint8_t *rgb, bool add);
+static void palette_free(palette_builder_t *palette);
+
+// ========== 核心接口实现 ==========
+
+esp_err_t led_animation_binary_path(const char *json_filename, char *bin_filename, size_t size) {
+    if (!json_filename || !bin_filename || size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 替换扩展名（没有扩展名时直接追加）
+    const char *slash = strrchr(json_filename, '/');
+    const char *dot = strrchr(json_filename, '.');
+    size_t stem_len = (dot && (!slash || dot > slash)) ? (size_t)(dot - json_filename) : strlen(json_filename);
+
+    int written = snprintf(bin_filename, size, "%.*s%s", (int)stem_len, json_filename, LED_ANIM_BIN_EXTENSION);
+    if (written < 0 || (size_t)written >= size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
+
+bool led_animation_binary_is_fresh(const char *json_filename, const char *bin_filename) {
+    if (!bin_filename || !bsp_storage_sdcard_is_mounted()) {
+        return false;
+    }
+
+    struct stat bin_stat;
+    if (stat(bin_filename, &bin_stat) != 0 || bin_stat.st_size < (off_t)sizeof(led_anim_bin_header_t)) {
+        return false;
+    }
+
+    // 只有二进制文件时直接使用
+    struct stat json_stat;
+    if (!json_filename || stat(json_filename, &json_stat) != 0) {
+        return true;
+    }
+
+    if (bin_stat.st_mtime < json_stat.st_mtime) {
+        ESP_LOGI(TAG, "%s 比JSON旧，需要重新编译", bin_filename);
+        return false;
+    }
+
+    // 时间戳不可靠时（例如拷贝未保留时间），再核对源文件大小
+    FILE *file = fopen(bin_filename, "rb");
+    if (!file) {
+        return false;
+    }
+    led_anim_bin_header_t header;
+    size_t n = fread(&header, 1, sizeof(header), file);
+    fclose(file);
+
+    if (n != sizeof(header) || header.source_size != (uint32_t)json_stat.st_size) {
+        ESP_LOGI(TAG, "%s 与当前JSON不匹配，需要重新编译", bin_filename);
+        return false;
+    }
+    return true;
+}
+
+esp_err_t load_animation_from_binary(const char *filename) {
+    led_animation_bank_t *bank = NULL;
+    esp_err_t ret = load_animation_bank_from_binary(filename, &bank);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return led_animation_bank_publish(bank, 0);
+}
+
+esp_err_t load_animation_bank_from_binary(const char *filename, led_animation_bank_t **bank_out) {
+    ESP_LOGI(TAG, "从二进制文件加载动画: %s", filename);
+
+    if (!bank_out) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *bank_out = NULL;
+
+    if (!bsp_storage_sdcard_is_mounted()) {
+        ESP_LOGE(TAG, "SD卡未挂载，无法加载动画");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+
+    struct stat file_stat;
+    if (stat(filename, &file_stat) != 0) {
+        ESP_LOGE(TAG, "文件不存在: %s", filename);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    size_t size = (size_t)file_stat.st_size;
+    if (size < sizeof(led_anim_bin_header_t)) {
+        ESP_LOGE(TAG, "文件太小: %u 字节", (unsigned)size);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        ESP_LOGE(TAG, "无法打开文件: %s", filename);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t *data = malloc(size);
+    if (!data) {
+        ESP_LOGE(TAG, "无法分配内存 (%u 字节)", (unsigned)size);
+        fclose(file);
+        return ESP_ERR_NO_MEM;
+    }
+
+    // 整个文件一次读入
+    size_t read_size = fread(data, 1, size, file);
+    fclose(file);
+    if (read_size != size) {
+        ESP_LOGE(TAG, "读取文件失败，期望 %u 字节，实际读取 %u 字节", (unsigned)size, (unsigned)read_size);
+        free(data);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    int64_t read_us = esp_timer_get_time() - start_us;
+
+    esp_err_t ret = led_animation_binary_decode(data, size, bank_out);
+    free(data);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "读取 %u 字节 %lld us, 总耗时 %lld us",
+             (unsigned)size, read_us, esp_timer_get_time() - start_us);
+    return ESP_OK;
+}
+
+esp_err_t led_animation_binary_decode(const uint8_t *data, size_t size, led_animation_bank_t **bank_out) {
+    if (!data || !bank_out) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *bank_out = NULL;
+
+    if (size < sizeof(led_anim_bin_header_t)) {
+        ESP_LOGE(TAG, "映像太小: %u 字节", (unsigned)size);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    esp_err_t ret = validate_image(data, size);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    led_anim_bin_header_t header;
+    memcpy(&header, data, sizeof(header));
+    const uint8_t *table = data + header.header_size + (size_t)header.palette_count * 3;
+
+    led_animation_bank_t *bank = led_animation_bank_create();
+    if (!bank) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    int loaded_count = 0;
+    for (int i = 0; i < header.animation_count; i++) {
+        led_anim_bin_entry_t entry;
+        memcpy(&entry, table + (size_t)i * sizeof(entry), sizeof(entry));
+        if (decode_animation(bank, data, &header, &entry) == ESP_OK) {
+            loaded_count++;
+        } else {
+            ESP_LOGE(TAG, "加载动画 %d 失败", i);
+        }
+    }
+
+    if (loaded_count == 0) {
+        ESP_LOGE(TAG, "没有成功加载任何动画");
+        led_animation_bank_destroy(bank);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    *bank_out = bank;
+    ESP_LOGI(TAG, "成功加载 %d 个动画: 调色板 %u 色", loaded_count, header.palette_count);
+    return ESP_OK;
+}
+
+esp_err_t led_animation_binary_encode(const led_animation_bank_t *bank, const int32_t *order, int count,
+                                      uint8_t **data_out, size_t *size_out) {
+    if (!bank || !data_out || !size_out || count <= 0 || count > led_animation_bank_get_count(bank)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *data_out = NULL;
+    *size_out = 0;
+
+    // 第一遍：收集调色板并计算映像大小
+    uint32_t total_pixels = 0;
+    size_t body_size = 0;
+    for (int i = 0; i < count; i++) {
+        const char *name;
+        const uint8_t *mask;
+        const uint8_t *colors;
+        int index = order ? (int)order[i] : i;
+        if (!led_animation_bank_get_frame(bank, index, &name, &mask, &colors)) {
+            ESP_LOGE(TAG, "动画 %d 无效，无法编码", index);
+            return ESP_ERR_INVALID_STATE;
+        }
+        for (int pos = 0; pos < FRAME_PIXELS; pos++) {
+            total_pixels += mask[pos] ? 1 : 0;
+        }
+        size_t name_len = strlen(name);
+        body_size += (name_len > MAX_NAME_LEN ? MAX_NAME_LEN : name_len) + BITMAP_SIZE;
+    }
+
+    palette_builder_t palette;
+    esp_err_t ret = palette_init(&palette, total_pixels);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    for (int i = 0; i < count; i++) {
+        const uint8_t *mask;
+        const uint8_t *colors;
+        led_animation_bank_get_frame(bank, order ? (int)order[i] : i, NULL, &mask, &colors);
+        for (int pos = 0; pos < FRAME_PIXELS; pos++) {
+            if (mask[pos] && palette_lookup(&palette, colors + pos * 3, true) < 0) {
+                ESP_LOGE(TAG, "调色板颜色超过 %d 种", PALETTE_MAX_COLORS);
+                palette_free(&palette);
+                return ESP_ERR_INVALID_SIZE;
+            }
+        }
+    }
+
+    bool wide = palette.count > 256;
+    size_t index_size = wide ? 2 : 1;
+    size_t table_offset = sizeof(led_anim_bin_header_t) + (size_t)palette.count * 3;
+    size_t data_offset = table_offset + (size_t)count * sizeof(led_anim_bin_entry_t);
+    size_t size = data_offset + body_size + (size_t)total_pixels * index_size;
+
+    uint8_t *data = malloc(size);
+    if (!data) {
+        ESP_LOGE(TAG, "无法分配映像内存 (%u 字节)", (unsigned)size);
+        palette_free(&palette);
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(data + sizeof(led_anim_bin_header_t), palette.colors, (size_t)palette.count * 3);
+
+    // 第二遍：写入偏移表和每个动画的名称、位图、调色板索引
+    uint8_t *p = data + data_offset;
+    for (int i = 0; i < count; i++) {
+        const char *name;
+        const uint8_t *mask;
+        const uint8_t *colors;
+        led_animation_bank_get_frame(bank, order ? (int)order[i] : i, &name, &mask, &colors);
+
+        led_anim_bin_entry_t entry = {0};
+        size_t name_len = strlen(name);
+        entry.offset = (uint32_t)(p - data);
+        entry.name_len = (uint8_t)(name_len > MAX_NAME_LEN ? MAX_NAME_LEN : name_len);
+        memcpy(p, name, entry.name_len);
+        p += entry.name_len;
+
+        uint8_t *bitmap = p;
+        uint8_t *indices = p + BITMAP_SIZE;
+        memset(bitmap, 0, BITMAP_SIZE);
+        for (int pos = 0; pos < FRAME_PIXELS; pos++) {
+            if (!mask[pos]) {
+                continue;
+            }
+            bitmap[pos / 8] |= (uint8_t)(0x80 >> (pos % 8));
+            int color = palette_lookup(&palette, colors + pos * 3, false);
+            if (wide) {
+                indices[entry.pixel_count * 2] = (uint8_t)(color & 0xFF);
+                indices[entry.pixel_count * 2 + 1] = (uint8_t)(color >> 8);
+            } else {
+                indices[entry.pixel_count] = (uint8_t)color;
+            }
+            entry.pixel_count++;
+        }
+        p = indices + (size_t)entry.pixel_count * index_size;
+        memcpy(data + table_offset + (size_t)i * sizeof(entry), &entry, sizeof(entry));
+    }
+
+    led_anim_bin_header_t header = {0};
+    memcpy(header.magic, LED_ANIM_BIN_MAGIC, sizeof(header.magic));
+    header.version = LED_ANIM_BIN_VERSION;
+    header.header_size = sizeof(led_anim_bin_header_t);
+    header.animation_count = (uint16_t)count;
+    header.palette_count = (uint16_t)palette.count;
+    header.width = LED_MATRIX_WIDTH;
+    header.height = LED_MATRIX_HEIGHT;
+    header.flags = wide ? LED_ANIM_BIN_FLAG_WIDE_INDEX : 0;
+    header.payload_size = (uint32_t)(size - sizeof(header));
+    header.crc32 = esp_rom_crc32_le(0, data + sizeof(header), header.payload_size);
+    memcpy(data, &header, sizeof(header));
+    palette_free(&palette);
+
+    *data_out = data;
+    *size_out = size;
+    return ESP_OK;
+}
+
+// ========== 静态函数实现 ==========
+
+// 校验文件头、CRC和每个动画的数据范围
+static esp_err_t validate_image(const uint8_t *data, size_t size) {
+    led_anim_bin_header_t header;
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, LED_ANIM_BIN_MAGIC, sizeof(header.magic)) != 0) {
+        ESP_LOGE(TAG, "文件标识无效");
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (header.version != LED_ANIM_BIN_VERSION || header.header_size != sizeof(led_anim_bin_header_t)) {
+        ESP_LOGE(TAG, "不支持的格式版本: %u (文件头 %u 字节)", header.version, header.header_size);
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (header.width != LED_MATRIX_WIDTH || header.height != LED_MATRIX_HEIGHT) {
+        ESP_LOGE(TAG, "矩阵尺寸不匹配: %ux%u", header.width, header.height);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (header.payload_size != size - header.header_size) {
+        ESP_LOGE(TAG, "数据长度不匹配: 记录 %lu 字节, 实际 %u 字节",
+                 (unsigned long)header.payload_size, (unsigned)(size - header.header_size));
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint32_t crc = esp_rom_crc32_le(0, data + header.header_size, header.payload_size);
+    if (crc != header.crc32) {
+        ESP_LOGE(TAG, "CRC校验失败: 记录 0x%08lx, 计算 0x%08lx",
+                 (unsigned long)header.crc32, (unsigned long)crc);
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    size_t index_size = (header.flags & LED_ANIM_BIN_FLAG_WIDE_INDEX) ? 2 : 1;
+    size_t table_offset = header.header_size + (size_t)header.palette_count * 3;
+    size_t table_end = table_offset + (size_t)header.animation_count * sizeof(led_anim_bin_entry_t);
+    if (table_end > size) {
+        ESP_LOGE(TAG, "偏移表超出文件范围");
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    for (int i = 0; i < header.animation_count; i++) {
+        led_anim_bin_entry_t entry;
+        memcpy(&entry, data + table_offset + (size_t)i * sizeof(entry), sizeof(entry));
+
+        size_t end = (size_t)entry.offset + entry.name_len + BITMAP_SIZE + (size_t)entry.pixel_count * index_size;
+        if (entry.offset < table_end || end > size) {
+            ESP_LOGE(TAG, "动画 %d 数据超出文件范围", i);
+            return ESP_ERR_INVALID_SIZE;
+        }
+        if (count_bits(data + entry.offset + entry.name_len) != entry.pixel_count) {
+            ESP_LOGE(TAG, "动画 %d 像素数与位图不一致", i);
+            return ESP_ERR_INVALID_SIZE;
+        }
+
+        const uint8_t *indices = data + entry.offset + entry.name_len + BITMAP_SIZE;
+        for (int n = 0; n < entry.pixel_count; n++) {
+            uint16_t color = (index_size == 2) ? (uint16_t)(indices[n * 2] | (indices[n * 2 + 1] << 8)) : indices[n];
+            if (color >= header.palette_count) {
+                ESP_LOGE(TAG, "动画 %d 调色板索引越界: %u", i, color);
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+    }
+
+    return ESP_OK;
+}
+
+// 将一个动画写入动画库
+static esp_err_t decode_animation(led_animation_bank_t *bank, const uint8_t *data,
+                                  const led_anim_bin_header_t *header, const led_anim_bin_entry_t *entry) {
+    const uint8_t *p = data + entry->offset;
+
+    char name[64];
+    size_t name_len = entry->name_len < sizeof(name) - 1 ? entry->name_len : sizeof(name) - 1;
+    memcpy(name, p, name_len);
+    name[name_len] = '\0';
+    p += entry->name_len;
+
+    int created_index = led_animation_bank_add(bank, name);
+    if (created_index < 0) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    led_blit_surface_t surface;
+    if (!led_animation_bank_get_surface(bank, created_index, &surface)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const uint8_t *bitmap = p;
+    const uint8_t *indices = p + BITMAP_SIZE;
+    const uint8_t *palette = data + header->header_size;
+    bool wide = (header->flags & LED_ANIM_BIN_FLAG_WIDE_INDEX) != 0;
+
+    int n = 0;
+    for (int byte = 0; byte < BITMAP_SIZE; byte++) {
+        uint8_t bits = bitmap[byte];
+        if (bits == 0) {
+            continue;
+        }
+        for (int bit = 0; bit < 8; bit++) {
+            if (!(bits & (0x80 >> bit))) {
+                continue;
+            }
+
+            // 索引范围已在validate_image()中校验
+            uint16_t color = wide ? (uint16_t)(indices[n * 2] | (indices[n * 2 + 1] << 8)) : indices[n];
+            n++;
+
+            int pos = byte * 8 + bit;
+            surface.mask[pos] = 1;
+            memcpy(surface.pixels + pos * 3, palette + color * 3, 3);
+        }
+    }
+
+    return ESP_OK;
+}
+
+static int count_bits(const uint8_t *bitmap) {
+    int count = 0;
+    for (int i = 0; i < BITMAP_SIZE; i++) {
+        count += __builtin_popcount(bitmap[i]);
+    }
+    return count;
+}
+
+static esp_err_t palette_init(palette_builder_t *palette, uint32_t max_colors) {
+    memset(palette, 0, sizeof(*palette));
+    if (max_colors > PALETTE_MAX_COLORS) {
+        max_colors = PALETTE_MAX_COLORS;
+    }
+
+    // 装载率不超过1/2
+    palette->capacity = 64;
+    while (palette->capacity < max_colors * 2) {
+        palette->capacity <<= 1;
+    }
+
+    palette->colors = malloc((size_t)(max_colors ? max_colors : 1) * 3);
+    palette->slots = malloc(palette->capacity * sizeof(uint16_t));
+    if (!palette->colors || !palette->slots) {
+        ESP_LOGE(TAG, "无法分配调色板内存");
+        palette_free(palette);
+        return ESP_ERR_NO_MEM;
+    }
+    memset(palette->slots, 0xFF, palette->capacity * sizeof(uint16_t));
+    return ESP_OK;
+}
+
+// 查找颜色的调色板索引，add为true时不存在则加入；返回-1表示调色板已满或颜色不存在
+static int palette_lookup(palette_builder_t *palette, const uint8_t *rgb, bool add) {
+    uint32_t key = ((uint32_t)rgb[0] << 16) | ((uint32_t)rgb[1] << 8) | rgb[2];
+    uint32_t slot = (key * 2654435761u) & (palette->capacity - 1);
+
+    while (palette->slots[slot] != PALETTE_EMPTY) {
+        const uint8_t *color = palette->colors + palette->slots[slot] * 3;
+        if (color[0] == rgb[0] && color[1] == rgb[1] && color[2] == rgb[2]) {
+            return palette->slots[slot];
+        }
+        slot = (slot + 1) & (palette->capacity - 1);
+    }
+
+    if (!add || palette->count >= PALETTE_MAX_COLORS) {
+        return -1;
+    }
+    memcpy(palette->colors + palette->count * 3, rgb, 3);
+    palette->slots[slot] = (uint16_t)palette->count;
+    return (int)palette->count++;
+}
+
+static void palette_free(palette_builder_t *palette) {
+    free(palette->colors);
+    free(palette->slots);
+    palette->colors = NULL;
+    palette->slots = NULL;
+}
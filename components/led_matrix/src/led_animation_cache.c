@@ -0,0 +1,367 @@
+/**
+ * @file led_animation_cache.c
+ * @brief 解码后动画的启动缓存实现
+ *
+ * 命中时JSON只需stat：大小和修改时间与缓存头一致则沿用记录的CRC，
+ * 否则按块计算CRC（不解析）。缓存整体读入后由led_animation_binary
+ * 校验并解码。任何校验失败都按未命中处理，调用者回退到JSON解析并
+ * 重新生成缓存。
+ */
+
+#include "led_animation_cache.h"
+#include "led_animation_binary.h"
+#include "bsp_storage.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_rom_crc.h"
+#include "freertos/FreeRTOS.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static const char *TAG = "LED_ANIM_CACHE";
+
+#define HASH_CHUNK_SIZE         4096    // 计算CRC时每次读取的字节数
+#define MAX_IMAGE_SIZE          (256 * 1024)    // 缓存映像大小上限（10个满屏动画约12KB）
+#define TEMP_SUFFIX             ".tmp"
+#define BACKUP_SUFFIX           ".bak"
+
+static led_animation_cache_stats_t s_stats;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// ========== 静态函数声明 ==========
+static esp_err_t read_cache_header(FILE *file, const char *path, led_animation_cache_header_t *header);
+static esp_err_t read_cache_file(const char *path, const led_animation_cache_key_t *key,
+                                 led_animation_cache_header_t *header, uint8_t **image_out);
+static esp_err_t write_cache_file(const char *path, const led_animation_cache_header_t *header,
+                                  const uint8_t *image);
+
+// ========== 核心接口实现 ==========
+
+esp_err_t led_animation_cache_path(const char *json_filename, char *cache_filename, size_t size) {
+    if (!json_filename || !cache_filename || size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 替换扩展名（没有扩展名时直接追加）
+    const char *slash = strrchr(json_filename, '/');
+    const char *dot = strrchr(json_filename, '.');
+    size_t stem_len = (dot && (!slash || dot > slash)) ? (size_t)(dot - json_filename) : strlen(json_filename);
+
+    int written = snprintf(cache_filename, size, "%.*s%s", (int)stem_len, json_filename,
+                           LED_ANIMATION_CACHE_EXTENSION);
+    if (written < 0 || (size_t)written >= size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
+
+esp_err_t led_animation_cache_compute_key(const char *json_filename, led_animation_cache_key_t *key) {
+    if (!json_filename || !key) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!bsp_storage_sdcard_is_mounted()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+
+    struct stat file_stat;
+    if (stat(json_filename, &file_stat) != 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    key->size = (uint32_t)file_stat.st_size;
+    key->mtime = (uint32_t)file_stat.st_mtime;
+
+    // 大小和修改时间与缓存记录一致时沿用记录的CRC，不读取JSON
+    char path[128];
+    FILE *cache = led_animation_cache_path(json_filename, path, sizeof(path)) == ESP_OK ? fopen(path, "rb") : NULL;
+    if (cache) {
+        led_animation_cache_header_t header;
+        bool unchanged = read_cache_header(cache, path, &header) == ESP_OK &&
+                         header.source_size == key->size && header.source_mtime == key->mtime;
+        fclose(cache);
+        if (unchanged) {
+            key->crc32 = header.source_crc32;
+
+            int64_t hash_us = esp_timer_get_time() - start_us;
+            portENTER_CRITICAL(&s_stats_lock);
+            s_stats.hash_us = hash_us;
+            s_stats.crc_skips++;
+            portEXIT_CRITICAL(&s_stats_lock);
+
+            ESP_LOGD(TAG, "缓存键: 文件未修改，沿用CRC 0x%08lx, 耗时 %lld us",
+                     (unsigned long)key->crc32, hash_us);
+            return ESP_OK;
+        }
+    }
+
+    FILE *file = fopen(json_filename, "rb");
+    if (!file) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    uint8_t *chunk = malloc(HASH_CHUNK_SIZE);
+    if (!chunk) {
+        fclose(file);
+        return ESP_ERR_NO_MEM;
+    }
+
+    uint32_t crc = 0;
+    uint32_t size = 0;
+    size_t n;
+    while ((n = fread(chunk, 1, HASH_CHUNK_SIZE, file)) > 0) {
+        crc = esp_rom_crc32_le(crc, chunk, n);
+        size += (uint32_t)n;
+    }
+    bool read_error = ferror(file) != 0;
+    free(chunk);
+    fclose(file);
+
+    if (read_error) {
+        ESP_LOGW(TAG, "读取文件失败: %s", json_filename);
+        return ESP_FAIL;
+    }
+
+    key->crc32 = crc;
+    key->size = size;
+
+    int64_t hash_us = esp_timer_get_time() - start_us;
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.hash_us = hash_us;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    ESP_LOGD(TAG, "缓存键: CRC 0x%08lx, %lu 字节, 耗时 %lld us",
+             (unsigned long)crc, (unsigned long)size, hash_us);
+    return ESP_OK;
+}
+
+esp_err_t led_animation_cache_load(const char *json_filename, const led_animation_cache_key_t *key,
+                                   led_animation_bank_t **bank_out) {
+    if (!key || !bank_out) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *bank_out = NULL;
+
+    char path[128];
+    esp_err_t ret = led_animation_cache_path(json_filename, path, sizeof(path));
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+
+    led_animation_cache_header_t header;
+    uint8_t *image = NULL;
+    ret = read_cache_file(path, key, &header, &image);
+
+    // 替换缓存期间断电时.cache可能缺失或仍是旧缓存，依次尝试.bak和已写完的.tmp
+    static const char *const fallback_suffixes[] = { BACKUP_SUFFIX, TEMP_SUFFIX };
+    for (size_t i = 0; ret != ESP_OK && i < sizeof(fallback_suffixes) / sizeof(fallback_suffixes[0]); i++) {
+        char fallback_path[136];
+        snprintf(fallback_path, sizeof(fallback_path), "%s%s", path, fallback_suffixes[i]);
+        if (read_cache_file(fallback_path, key, &header, &image) == ESP_OK) {
+            ESP_LOGI(TAG, "使用替换未完成的缓存文件: %s", fallback_path);
+            ret = ESP_OK;
+        }
+    }
+    if (ret == ESP_OK) {
+        ret = led_animation_binary_decode(image, header.image_size, bank_out);
+        free(image);
+    }
+    int64_t load_us = esp_timer_get_time() - start_us;
+
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.lookups++;
+    if (ret == ESP_OK) {
+        s_stats.hits++;
+        s_stats.load_us = load_us;
+        s_stats.saved_us += (int64_t)header.parse_us - load_us - s_stats.hash_us;
+    }
+    led_animation_cache_stats_t stats = s_stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "启动缓存命中: %d 个动画, 计算键 %lld us + 加载 %lld us (解码JSON需 %lu us), "
+                 "节省 %lld us, 命中率 %lu/%lu",
+                 led_animation_bank_get_count(*bank_out), stats.hash_us, load_us,
+                 (unsigned long)header.parse_us, (int64_t)header.parse_us - load_us - stats.hash_us,
+                 (unsigned long)stats.hits, (unsigned long)stats.lookups);
+    } else {
+        ESP_LOGI(TAG, "启动缓存未命中 (%s), 命中率 %lu/%lu",
+                 esp_err_to_name(ret), (unsigned long)stats.hits, (unsigned long)stats.lookups);
+    }
+    return ret;
+}
+
+esp_err_t led_animation_cache_store(const char *json_filename, const led_animation_cache_key_t *key,
+                                    const led_animation_bank_t *bank, const int32_t *order, int count,
+                                    int64_t parse_us) {
+    if (!key || !bank) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!bsp_storage_sdcard_is_mounted()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    char path[128];
+    esp_err_t ret = led_animation_cache_path(json_filename, path, sizeof(path));
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+
+    uint8_t *image = NULL;
+    size_t image_size = 0;
+    ret = led_animation_binary_encode(bank, order, count, &image, &image_size);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "编码缓存失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    led_animation_cache_header_t header = {0};
+    memcpy(header.magic, LED_ANIMATION_CACHE_MAGIC, sizeof(header.magic));
+    header.version = LED_ANIMATION_CACHE_VERSION;
+    header.header_size = sizeof(header);
+    header.source_crc32 = key->crc32;
+    header.source_size = key->size;
+    header.source_mtime = key->mtime;
+    header.parse_us = (parse_us > 0 && parse_us < UINT32_MAX) ? (uint32_t)parse_us : 0;
+    header.image_size = (uint32_t)image_size;
+
+    ret = write_cache_file(path, &header, image);
+    free(image);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.stores++;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    ESP_LOGI(TAG, "已写入启动缓存: %s, %d 个动画, %u 字节, 耗时 %lld us",
+             path, count, (unsigned)(sizeof(header) + image_size), esp_timer_get_time() - start_us);
+    return ESP_OK;
+}
+
+void led_animation_cache_get_stats(led_animation_cache_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+// ========== 静态函数实现 ==========
+
+// 读取并校验缓存头
+static esp_err_t read_cache_header(FILE *file, const char *path, led_animation_cache_header_t *header) {
+    if (fread(header, 1, sizeof(*header), file) != sizeof(*header) ||
+        memcmp(header->magic, LED_ANIMATION_CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != LED_ANIMATION_CACHE_VERSION || header->header_size != sizeof(*header)) {
+        ESP_LOGW(TAG, "缓存文件格式无效: %s", path);
+        return ESP_ERR_INVALID_VERSION;
+    }
+    return ESP_OK;
+}
+
+// 读取缓存头，键一致时读入映像
+static esp_err_t read_cache_file(const char *path, const led_animation_cache_key_t *key,
+                                 led_animation_cache_header_t *header, uint8_t **image_out) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_err_t ret = read_cache_header(file, path, header);
+    if (ret != ESP_OK) {
+        fclose(file);
+        return ret;
+    }
+
+    if (header->source_crc32 != key->crc32 || header->source_size != key->size) {
+        fclose(file);
+        ESP_LOGI(TAG, "动画文件已变化 (CRC 0x%08lx -> 0x%08lx)",
+                 (unsigned long)header->source_crc32, (unsigned long)key->crc32);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if (header->image_size == 0 || header->image_size > MAX_IMAGE_SIZE) {
+        fclose(file);
+        ESP_LOGW(TAG, "缓存映像大小无效: %lu 字节", (unsigned long)header->image_size);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t *image = malloc(header->image_size);
+    if (!image) {
+        fclose(file);
+        return ESP_ERR_NO_MEM;
+    }
+
+    size_t n = fread(image, 1, header->image_size, file);
+    fclose(file);
+    if (n != header->image_size) {
+        free(image);
+        ESP_LOGW(TAG, "缓存文件不完整: 期望 %lu 字节, 实际 %u 字节",
+                 (unsigned long)header->image_size, (unsigned)n);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    *image_out = image;
+    return ESP_OK;
+}
+
+// 先写临时文件，完整写入后依次重命名：旧缓存 -> .bak，临时文件 -> .cache，再删除.bak。
+// 任何时刻断电，.cache、.bak、.tmp中至少有一个完整，加载时依次尝试
+static esp_err_t write_cache_file(const char *path, const led_animation_cache_header_t *header,
+                                  const uint8_t *image) {
+    char temp_path[136];
+    char backup_path[136];
+    int written = snprintf(temp_path, sizeof(temp_path), "%s%s", path, TEMP_SUFFIX);
+    if (written < 0 || (size_t)written >= sizeof(temp_path)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    snprintf(backup_path, sizeof(backup_path), "%s%s", path, BACKUP_SUFFIX);
+
+    FILE *file = fopen(temp_path, "wb");
+    if (!file) {
+        ESP_LOGW(TAG, "无法创建缓存文件: %s", temp_path);
+        return ESP_FAIL;
+    }
+
+    bool ok = fwrite(header, 1, sizeof(*header), file) == sizeof(*header) &&
+              fwrite(image, 1, header->image_size, file) == header->image_size;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        ESP_LOGW(TAG, "写入缓存文件失败: %s", temp_path);
+        remove(temp_path);
+        return ESP_FAIL;
+    }
+
+    // FAT不支持覆盖式重命名：旧缓存先改名为.bak（上次残留的.bak已无用）
+    remove(backup_path);
+    struct stat file_stat;
+    bool has_old = stat(path, &file_stat) == 0;
+    if (has_old && rename(path, backup_path) != 0) {
+        ESP_LOGW(TAG, "备份旧缓存文件失败: %s", path);
+        remove(temp_path);
+        return ESP_FAIL;
+    }
+
+    if (rename(temp_path, path) != 0) {
+        // 恢复旧缓存；临时文件完整，保留给下次加载
+        ESP_LOGW(TAG, "替换缓存文件失败: %s", path);
+        if (has_old) {
+            rename(backup_path, path);
+        }
+        return ESP_FAIL;
+    }
+
+    if (has_old) {
+        remove(backup_path);
+    }
+    return ESP_OK;
+}
@@ -1,261 +1,54 @@
 #include "led_animation_export.h"
-#include "led_animation_demo.h"
+#include "led_animation_builtin.h"
 #include "esp_log.h"
+#include "led_json_writer.h"
 #include "bsp_storage.h"
-#include "cJSON.h"
 #include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 
 static const char *TAG = "LED_ANIM_EXPORT";
 
-// 动画点数据结构
-typedef struct {
-    int x;
-    int y;
-    uint8_t r;
-    uint8_t g;
-    uint8_t b;
-} animation_point_t;
-
-// 动画定义结构
-typedef struct {
-    const char *name;
-    const animation_point_t *points;
-    int point_count;
-} animation_definition_t;
-
-// 示例动画数据
-static const animation_point_t demo_animation_points[] = {
-    // 第8行
-    {11, 8, 151, 189, 246}, {22, 8, 220, 156, 208}, {23, 8, 223, 157, 205}, {24, 8, 232, 160, 199},
-
-    // 第9行
-    {9, 9, 146, 202, 247}, {10, 9, 149, 192, 246}, {11, 9, 153, 184, 246}, {12, 9, 159, 172, 246}, {13, 9, 166, 161, 245}, {20, 9, 204, 150, 220}, {21, 9, 211, 153, 215}, {22, 9, 220, 157, 208},
-    {23, 9, 228, 159, 201}, {24, 9, 236, 162, 200}, {25, 9, 240, 162, 195},
-
-    // 第10行
-    {8, 10, 145, 210, 247}, {9, 10, 147, 203, 248}, {10, 10, 148, 198, 247}, {11, 10, 154, 184, 246}, {12, 10, 159, 172, 246}, {13, 10, 166, 162, 245}, {14, 10, 172, 154, 243}, {15, 10, 178, 147, 243},
-    {18, 10, 191, 144, 235}, {19, 10, 196, 148, 229}, {20, 10, 203, 150, 222}, {21, 10, 212, 153, 214}, {22, 10, 219, 156, 208}, {23, 10, 226, 158, 202},
-
-    // 第11行
-    {8, 11, 145, 209, 247}, {9, 11, 146, 203, 247}, {10, 11, 148, 194, 246}, {11, 11, 153, 184, 246}, {12, 11, 159, 172, 245}, {13, 11, 165, 162, 245}, {14, 11, 172, 154, 243}, {15, 11, 179, 147, 243},
-    {16, 11, 182, 142, 242}, {17, 11, 186, 141, 239}, {18, 11, 191, 144, 235}, {19, 11, 196, 147, 228}, {20, 11, 203, 149, 220}, {21, 11, 212, 153, 215}, {22, 11, 220, 157, 208},
-
-    // 第12行
-    {8, 12, 145, 209, 247}, {9, 12, 146, 202, 247}, {10, 12, 149, 194, 246}, {14, 12, 172, 153, 243}, {15, 12, 178, 147, 242}, {16, 12, 183, 142, 243}, {17, 12, 185, 142, 240}, {18, 12, 191, 144, 234},
-    {19, 12, 197, 147, 229}, {23, 12, 226, 158, 203},
-
-    // 第13行
-    {8, 13, 146, 211, 247}, {9, 13, 146, 204, 247}, {10, 13, 149, 195, 247}, {15, 13, 178, 148, 242}, {16, 13, 184, 142, 242}, {17, 13, 185, 142, 240}, {18, 13, 190, 144, 235}, {23, 13, 228, 158, 204},
-    {24, 13, 235, 161, 198},
-
-    // 第14行
-    {8, 14, 145, 209, 247}, {9, 14, 147, 203, 247}, {10, 14, 149, 194, 246}, {15, 14, 178, 147, 243}, {16, 14, 183, 142, 242}, {17, 14, 186, 142, 241}, {18, 14, 190, 144, 235}, {23, 14, 227, 159, 203},
-    {24, 14, 234, 161, 197}, {25, 14, 241, 163, 195},
-
-    // 第15行
-    {8, 15, 145, 209, 247}, {9, 15, 147, 203, 247}, {10, 15, 149, 194, 246}, {15, 15, 178, 147, 243}, {16, 15, 183, 142, 242}, {17, 15, 186, 142, 241}, {18, 15, 190, 144, 235}, {23, 15, 227, 159, 203},
-    {24, 15, 234, 161, 197}, {25, 15, 241, 163, 195},
-
-    // 第16行
-    {8, 16, 145, 209, 247}, {9, 16, 147, 203, 247}, {10, 16, 149, 194, 246}, {15, 16, 178, 147, 243}, {16, 16, 183, 142, 242}, {17, 16, 186, 142, 241}, {18, 16, 190, 144, 235}, {23, 16, 227, 159, 203},
-    {24, 16, 234, 161, 197}, {25, 16, 241, 163, 195},
-
-    // 第17行
-    {8, 17, 145, 209, 247}, {9, 17, 147, 203, 247}, {10, 17, 149, 194, 246}, {15, 17, 178, 147, 243}, {16, 17, 183, 142, 242}, {17, 17, 186, 142, 241}, {18, 17, 190, 144, 235}, {23, 17, 227, 159, 203},
-    {24, 17, 234, 161, 197}, {25, 17, 241, 163, 195},
-
-    // 第18行
-    {9, 18, 146, 202, 247}, {10, 18, 149, 194, 245}, {15, 18, 178, 147, 242}, {16, 18, 183, 142, 242}, {17, 18, 185, 142, 240}, {18, 18, 191, 144, 235}, {23, 18, 227, 159, 203}, {24, 18, 234, 161, 197},
-    {25, 18, 241, 163, 195},
-
-    // 第19行
-    {10, 19, 150, 193, 247}, {13, 19, 165, 162, 245}, {14, 19, 172, 154, 243}, {15, 19, 179, 147, 243}, {16, 19, 182, 142, 242}, {17, 19, 186, 141, 239}, {18, 19, 191, 144, 235}, {19, 19, 196, 147, 228},
-    {20, 19, 203, 149, 220}, {23, 19, 227, 159, 203}, {24, 19, 234, 161, 197}, {25, 19, 241, 163, 195},
-
-    // 第20行
-    {11, 20, 153, 184, 246}, {12, 20, 159, 172, 245}, {13, 20, 165, 162, 245}, {14, 20, 172, 154, 243}, {15, 20, 179, 147, 243}, {16, 20, 182, 142, 242}, {17, 20, 186, 141, 239}, {18, 20, 191, 144, 235},
-    {19, 20, 196, 147, 228}, {20, 20, 203, 149, 220}, {21, 20, 212, 153, 215}, {22, 20, 220, 157, 208}, {23, 20, 227, 159, 203}, {24, 20, 234, 161, 197}, {25, 20, 241, 163, 195},
-
-    // 第21行
-    {10, 21, 149, 194, 246}, {11, 21, 153, 183, 246}, {12, 21, 158, 172, 245}, {13, 21, 165, 163, 245}, {14, 21, 173, 155, 244}, {15, 21, 178, 147, 242}, {18, 21, 191, 144, 235}, {19, 21, 196, 147, 228},
-    {20, 21, 203, 149, 220}, {21, 21, 212, 153, 215}, {22, 21, 220, 157, 208}, {23, 21, 227, 159, 203}, {24, 21, 234, 161, 197}, {25, 21, 241, 163, 195},
-
-    // 第22行
-    {8, 22, 145, 209, 247}, {9, 22, 146, 202, 247}, {10, 22, 149, 194, 246}, {11, 22, 153, 183, 246}, {12, 22, 158, 172, 245}, {13, 22, 165, 163, 245}, {20, 22, 203, 149, 220}, {21, 22, 212, 153, 215},
-    {22, 22, 220, 157, 208}, {23, 22, 227, 159, 203}, {24, 22, 234, 161, 197},
-
-    // 第23行
-    {9, 23, 147, 202, 247}, {10, 23, 149, 193, 245}, {11, 23, 153, 183, 245}, {21, 23, 212, 153, 215}, {22, 23, 218, 156, 209}, {23, 23, 227, 159, 203}
-};
-
-// 启动中数据
-static const animation_point_t startup_animation_points[] = {
-    // 第6行
-    {12, 6, 255, 255, 0}, {13, 6, 255, 255, 0}, {14, 6, 255, 255, 0}, {15, 6, 255, 255, 0}, {16, 6, 255, 255, 0}, {17, 6, 255, 255, 0}, {18, 6, 255, 255, 0}, {19, 6, 255, 255, 0},
-    {20, 6, 255, 255, 0}, {21, 6, 255, 255, 0},
-
-    // 第7行
-    {12, 7, 255, 200, 0}, {21, 7, 255, 200, 0},
-
-    // 第8行
-    {12, 8, 255, 150, 0}, {21, 8, 255, 150, 0},
-
-    // 第9行
-    {12, 9, 255, 100, 0}, {21, 9, 255, 100, 0},
-
-    // 第10行
-    {12, 10, 255, 50, 0}, {21, 10, 255, 50, 0},
-
-    // 第11行
-    {12, 11, 255, 255, 0}, {13, 11, 255, 255, 0}, {14, 11, 255, 255, 0}, {15, 11, 255, 255, 0}, {16, 11, 255, 255, 0}, {17, 11, 255, 255, 0}, {18, 11, 255, 255, 0}, {19, 11, 255, 255, 0},
-    {20, 11, 255, 255, 0}, {21, 11, 255, 255, 0}
-};
-
-// 链接错误数据
-static const animation_point_t error_animation_points[] = {
-    // 第6行
-    {10, 6, 255, 0, 0}, {11, 6, 255, 0, 0}, {12, 6, 255, 0, 0}, {13, 6, 255, 0, 0}, {14, 6, 255, 0, 0}, {15, 6, 255, 0, 0}, {16, 6, 255, 0, 0}, {17, 6, 255, 0, 0},
-    {18, 6, 255, 0, 0}, {19, 6, 255, 0, 0}, {20, 6, 255, 0, 0}, {21, 6, 255, 0, 0}, {22, 6, 255, 0, 0}, {23, 6, 255, 0, 0},
-
-    // 第7行
-    {10, 7, 255, 0, 0}, {16, 7, 255, 0, 0}, {17, 7, 255, 0, 0}, {23, 7, 255, 0, 0},
-
-    // 第8行
-    {10, 8, 255, 0, 0}, {15, 8, 255, 0, 0}, {18, 8, 255, 0, 0}, {23, 8, 255, 0, 0},
-
-    // 第9行
-    {10, 9, 255, 0, 0}, {14, 9, 255, 0, 0}, {19, 9, 255, 0, 0}, {23, 9, 255, 0, 0},
-
-    // 第10行
-    {10, 10, 255, 0, 0}, {13, 10, 255, 0, 0}, {20, 10, 255, 0, 0}, {23, 10, 255, 0, 0},
-
-    // 第11行
-    {10, 11, 255, 0, 0}, {12, 11, 255, 0, 0}, {21, 11, 255, 0, 0}, {23, 11, 255, 0, 0},
-
-    // 第12行
-    {10, 12, 255, 0, 0}, {11, 12, 255, 0, 0}, {12, 12, 255, 0, 0}, {13, 12, 255, 0, 0}, {14, 12, 255, 0, 0}, {15, 12, 255, 0, 0}, {16, 12, 255, 0, 0}, {17, 12, 255, 0, 0},
-    {18, 12, 255, 0, 0}, {19, 12, 255, 0, 0}, {20, 12, 255, 0, 0}, {21, 12, 255, 0, 0}, {22, 12, 255, 0, 0}, {23, 12, 255, 0, 0}
-};
-
-// 高温警告数据
-static const animation_point_t high_temp_warning_animation_points[] = {
-    // 第8行
-    {15, 8, 255, 100, 0}, {16, 8, 255, 120, 0}, {17, 8, 255, 100, 0},
-
-    // 第9行
-    {14, 9, 255, 80, 0}, {15, 9, 255, 150, 20}, {16, 9, 255, 180, 40}, {17, 9, 255, 150, 20}, {18, 9, 255, 80, 0},
-
-    // 第10行
-    {13, 10, 255, 60, 0}, {14, 10, 255, 120, 10}, {15, 10, 255, 200, 60}, {16, 10, 255, 220, 80}, {17, 10, 255, 200, 60}, {18, 10, 255, 120, 10}, {19, 10, 255, 60, 0},
-
-    // 第11行
-    {12, 11, 255, 40, 0}, {13, 11, 255, 100, 5}, {14, 11, 255, 180, 40}, {15, 11, 255, 240, 100}, {16, 11, 255, 255, 120}, {17, 11, 255, 240, 100}, {18, 11, 255, 180, 40}, {19, 11, 255, 100, 5},
-    {20, 11, 255, 40, 0},
-
-    // 第12行
-    {11, 12, 255, 20, 0}, {12, 12, 255, 80, 0}, {13, 12, 255, 160, 20}, {14, 12, 255, 220, 80}, {15, 12, 255, 255, 140}, {16, 12, 255, 255, 160}, {17, 12, 255, 255, 140}, {18, 12, 255, 220, 80},
-    {19, 12, 255, 160, 20}, {20, 12, 255, 80, 0}, {21, 12, 255, 20, 0},
-
-    // 第13行
-    {10, 13, 255, 10, 0}, {11, 13, 255, 60, 0}, {12, 13, 255, 140, 10}, {13, 13, 255, 200, 60}, {14, 13, 255, 240, 120}, {15, 13, 255, 255, 180}, {16, 13, 255, 255, 200}, {17, 13, 255, 255, 180},
-    {18, 13, 255, 240, 120}, {19, 13, 255, 200, 60}, {20, 13, 255, 140, 10}, {21, 13, 255, 60, 0}, {22, 13, 255, 10, 0},
-
-    // 第14行
-    {9, 14, 200, 5, 0}, {10, 14, 255, 40, 0}, {11, 14, 255, 120, 5}, {12, 14, 255, 180, 40}, {13, 14, 255, 220, 100}, {14, 14, 255, 250, 160}, {15, 14, 255, 255, 220}, {16, 14, 255, 255, 240},
-    {17, 14, 255, 255, 220}, {18, 14, 255, 250, 160}, {19, 14, 255, 220, 100}, {20, 14, 255, 180, 40}, {21, 14, 255, 120, 5}, {22, 14, 255, 40, 0}, {23, 14, 200, 5, 0},
-
-    // 第15行
-    {8, 15, 150, 0, 0}, {9, 15, 255, 20, 0}, {10, 15, 255, 100, 0}, {11, 15, 255, 160, 20}, {12, 15, 255, 200, 80}, {13, 15, 255, 240, 140}, {14, 15, 255, 255, 200}, {15, 15, 255, 255, 255},
-    {16, 15, 255, 255, 255}, {17, 15, 255, 255, 200}, {18, 15, 255, 240, 140}, {19, 15, 255, 200, 80}, {20, 15, 255, 160, 20}, {21, 15, 255, 100, 0}, {22, 15, 255, 20, 0}, {23, 15, 150, 0, 0},
-
-    // 第16行
-    {8, 16, 150, 0, 0}, {9, 16, 255, 20, 0}, {10, 16, 255, 100, 0}, {11, 16, 255, 160, 20}, {12, 16, 255, 200, 80}, {13, 16, 255, 240, 140}, {14, 16, 255, 255, 200}, {15, 16, 255, 255, 255},
-    {16, 16, 255, 255, 255}, {17, 16, 255, 255, 200}, {18, 16, 255, 240, 140}, {19, 16, 255, 200, 80}, {20, 16, 255, 160, 20}, {21, 16, 255, 100, 0}, {22, 16, 255, 20, 0}, {23, 16, 150, 0, 0},
-
-    // 第17行
-    {9, 17, 200, 5, 0}, {10, 17, 255, 40, 0}, {11, 17, 255, 120, 5}, {12, 17, 255, 180, 40}, {13, 17, 255, 220, 100}, {14, 17, 255, 250, 160}, {15, 17, 255, 255, 220}, {16, 17, 255, 255, 240},
-    {17, 17, 255, 255, 220}, {18, 17, 255, 250, 160}, {19, 17, 255, 220, 100}, {20, 17, 255, 180, 40}, {21, 17, 255, 120, 5}, {22, 17, 255, 40, 0}, {23, 17, 200, 5, 0},
-
-    // 第18行
-    {10, 18, 255, 10, 0}, {11, 18, 255, 60, 0}, {12, 18, 255, 140, 10}, {13, 18, 255, 200, 60}, {14, 18, 255, 240, 120}, {15, 18, 255, 255, 180}, {16, 18, 255, 255, 200}, {17, 18, 255, 255, 180},
-    {18, 18, 255, 240, 120}, {19, 18, 255, 200, 60}, {20, 18, 255, 140, 10}, {21, 18, 255, 60, 0}, {22, 18, 255, 10, 0},
-
-    // 第19行
-    {11, 19, 255, 20, 0}, {12, 19, 255, 80, 0}, {13, 19, 255, 160, 20}, {14, 19, 255, 220, 80}, {15, 19, 255, 255, 140}, {16, 19, 255, 255, 160}, {17, 19, 255, 255, 140}, {18, 19, 255, 220, 80},
-    {19, 19, 255, 160, 20}, {20, 19, 255, 80, 0}, {21, 19, 255, 20, 0},
-
-    // 第20行
-    {12, 20, 255, 40, 0}, {13, 20, 255, 100, 5}, {14, 20, 255, 180, 40}, {15, 20, 255, 240, 100}, {16, 20, 255, 255, 120}, {17, 20, 255, 240, 100}, {18, 20, 255, 180, 40}, {19, 20, 255, 100, 5},
-    {20, 20, 255, 40, 0},
-
-    // 第21行
-    {13, 21, 255, 60, 0}, {14, 21, 255, 120, 10}, {15, 21, 255, 200, 60}, {16, 21, 255, 220, 80}, {17, 21, 255, 200, 60}, {18, 21, 255, 120, 10}, {19, 21, 255, 60, 0},
-
-    // 第22行
-    {14, 22, 255, 80, 0}, {15, 22, 255, 150, 20}, {16, 22, 255, 180, 40}, {17, 22, 255, 150, 20}, {18, 22, 255, 80, 0},
-
-    // 第23行
-    {15, 23, 255, 100, 0}, {16, 23, 255, 120, 0}, {17, 23, 255, 100, 0}
-};
-
-// 计算中数据
-static const animation_point_t computing_animation_points[] = {
-    // 第6行
-    {10, 6, 0, 200, 255}, {11, 6, 0, 220, 255}, {12, 6, 0, 255, 255}, {13, 6, 0, 255, 255}, {14, 6, 0, 255, 255}, {15, 6, 20, 255, 255}, {16, 6, 40, 255, 255}, {17, 6, 20, 255, 255},
-    {18, 6, 0, 255, 255}, {19, 6, 0, 255, 255}, {20, 6, 0, 255, 255}, {21, 6, 0, 220, 255}, {22, 6, 0, 200, 255},
-
-    // 第7行
-    {9, 7, 0, 180, 255}, {10, 7, 0, 240, 255}, {11, 7, 20, 255, 255}, {12, 7, 60, 255, 255}, {13, 7, 100, 255, 255}, {14, 7, 140, 255, 255}, {15, 7, 180, 255, 255}, {16, 7, 200, 255, 255},
-    {17, 7, 180, 255, 255}, {18, 7, 140, 255, 255}, {19, 7, 100, 255, 255}, {20, 7, 60, 255, 255}, {21, 7, 20, 255, 255}, {22, 7, 0, 240, 255}, {23, 7, 0, 180, 255},
-
-    // 第8行
-    {8, 8, 0, 160, 240}, {9, 8, 0, 220, 255}, {10, 8, 40, 255, 255}, {11, 8, 100, 255, 255}, {12, 8, 160, 255, 255}, {13, 8, 220, 255, 255}, {14, 8, 255, 255, 255}, {15, 8, 255, 255, 255},
-    {16, 8, 255, 255, 255}, {17, 8, 255, 255, 255}, {18, 8, 220, 255, 255}, {19, 8, 160, 255, 255}, {20, 8, 100, 255, 255}, {21, 8, 40, 255, 255}, {22, 8, 0, 220, 255}, {23, 8, 0, 160, 240},
-
-    // 第24行
-    {8, 24, 0, 160, 240}, {9, 24, 0, 220, 255}, {10, 24, 40, 255, 255}, {11, 24, 100, 255, 255}, {12, 24, 160, 255, 255}, {13, 24, 220, 255, 255}, {14, 24, 255, 255, 255}, {15, 24, 255, 255, 255},
-    {16, 24, 255, 255, 255}, {17, 24, 255, 255, 255}, {18, 24, 220, 255, 255}, {19, 24, 160, 255, 255}, {20, 24, 100, 255, 255}, {21, 24, 40, 255, 255}, {22, 24, 0, 220, 255}, {23, 24, 0, 160, 240},
-
-    // 第25行
-    {9, 25, 0, 180, 255}, {10, 25, 0, 240, 255}, {11, 25, 20, 255, 255}, {12, 25, 60, 255, 255}, {13, 25, 100, 255, 255}, {14, 25, 140, 255, 255}, {15, 25, 180, 255, 255}, {16, 25, 200, 255, 255},
-    {17, 25, 180, 255, 255}, {18, 25, 140, 255, 255}, {19, 25, 100, 255, 255}, {20, 25, 60, 255, 255}, {21, 25, 20, 255, 255}, {22, 25, 0, 240, 255}, {23, 25, 0, 180, 255},
-
-    // 第26行
-    {10, 26, 0, 200, 255}, {11, 26, 0, 220, 255}, {12, 26, 0, 255, 255}, {13, 26, 0, 255, 255}, {14, 26, 0, 255, 255}, {15, 26, 20, 255, 255}, {16, 26, 40, 255, 255}, {17, 26, 20, 255, 255},
-    {18, 26, 0, 255, 255}, {19, 26, 0, 255, 255}, {20, 26, 0, 255, 255}, {21, 26, 0, 220, 255}, {22, 26, 0, 200, 255}
-};
-
-// 动画定义列表
-static const animation_definition_t animation_definitions[] = {
-    {"示例动画", demo_animation_points, sizeof(demo_animation_points) / sizeof(demo_animation_points[0])},
-    {"启动中", startup_animation_points, sizeof(startup_animation_points) / sizeof(startup_animation_points[0])},
-    {"链接错误", error_animation_points, sizeof(error_animation_points) / sizeof(error_animation_points[0])},
-    {"高温警告", high_temp_warning_animation_points, sizeof(high_temp_warning_animation_points) / sizeof(high_temp_warning_animation_points[0])},
-    {"计算中", computing_animation_points, sizeof(computing_animation_points) / sizeof(computing_animation_points[0])}
-};
-
 // 获取内置动画数量
 int get_builtin_animation_count(void) {
-    return sizeof(animation_definitions) / sizeof(animation_definitions[0]);
+    return led_animation_builtin_count();
 }
 
 // 获取指定动画的名称
 const char* get_builtin_animation_name(int index) {
-    int count = get_builtin_animation_count();
-    if (index < 0 || index >= count) {
-        return NULL;
-    }
-    return animation_definitions[index].name;
+    const led_animation_builtin_t *builtin = led_animation_builtin_get(index);
+    return builtin != NULL ? builtin->name : NULL;
 }
 
 // 获取指定动画的点数量
 int get_builtin_animation_point_count(int index) {
-    int count = get_builtin_animation_count();
-    if (index < 0 || index >= count) {
-        return -1;
+    const led_animation_builtin_t *builtin = led_animation_builtin_get(index);
+    return builtin != NULL ? builtin->element_count : -1;
+}
+
+// 写入一个元素对象，键的顺序与example_animation.json一致
+static void write_element(led_json_writer_t *writer, const led_animation_builtin_element_t *element) {
+    static const char *const POINT_KEYS[] = {"x", "y"};
+    static const char *const LINE_KEYS[] = {"x1", "y1", "x2", "y2"};
+    
+    bool is_line = element->type == LED_ANIMATION_BUILTIN_LINE;
+    const char *const *keys = is_line ? LINE_KEYS : POINT_KEYS;
+    int key_count = is_line ? 4 : 2;
+    
+    led_json_writer_begin_object(writer);
+    led_json_writer_key(writer, "type");
+    led_json_writer_string(writer, is_line ? "line" : "point");
+    for (int i = 0; i < key_count; i++) {
+        led_json_writer_key(writer, keys[i]);
+        led_json_writer_int(writer, element->coords[i]);
     }
-    return animation_definitions[index].point_count;
+    led_json_writer_key(writer, "r");
+    led_json_writer_int(writer, element->rgb[0]);
+    led_json_writer_key(writer, "g");
+    led_json_writer_int(writer, element->rgb[1]);
+    led_json_writer_key(writer, "b");
+    led_json_writer_int(writer, element->rgb[2]);
+    led_json_writer_end_object(writer);
 }
 
 // 导出所有动画为JSON文件
@@ -268,112 +61,58 @@ esp_err_t export_animation_to_json(const char *filename) {
         return ESP_ERR_INVALID_STATE;
     }
     
-    // 创建JSON对象
-    cJSON *root = cJSON_CreateObject();
-    if (!root) {
-        ESP_LOGE(TAG, "无法创建JSON根对象");
-        return ESP_ERR_NO_MEM;
+    // 边生成边写入，输出与cJSON_Print()的结果逐字节一致
+    led_json_writer_t writer;
+    esp_err_t ret = led_json_writer_open(&writer, filename);
+    if (ret != ESP_OK) {
+        return ret;
     }
     
-    // 创建动画数组
-    cJSON *animations = cJSON_CreateArray();
-    if (!animations) {
-        ESP_LOGE(TAG, "无法创建动画数组");
-        cJSON_Delete(root);
-        return ESP_ERR_NO_MEM;
-    }
-    
-    // 遍历所有动画定义
-    int total_animations = sizeof(animation_definitions) / sizeof(animation_definitions[0]);
+    int total_animations = led_animation_builtin_count();
     int total_points = 0;
     
+    led_json_writer_begin_object(&writer);
+    led_json_writer_key(&writer, "animations");
+    led_json_writer_begin_array(&writer);
+    
+    // 遍历所有内置动画
     for (int anim_idx = 0; anim_idx < total_animations; anim_idx++) {
-        const animation_definition_t *anim_def = &animation_definitions[anim_idx];
-        
-        // 创建动画对象
-        cJSON *animation = cJSON_CreateObject();
-        if (!animation) {
-            ESP_LOGE(TAG, "无法创建动画对象 %d", anim_idx);
-            continue;
-        }
+        const led_animation_builtin_t *builtin = led_animation_builtin_get(anim_idx);
         
-        // 设置动画名称
-        cJSON_AddStringToObject(animation, "name", anim_def->name);
+        led_json_writer_begin_object(&writer);
+        led_json_writer_key(&writer, "name");
+        led_json_writer_string(&writer, builtin->name);
+        led_json_writer_key(&writer, "points");
+        led_json_writer_begin_array(&writer);
         
-        // 创建点数组
-        cJSON *points = cJSON_CreateArray();
-        if (!points) {
-            ESP_LOGE(TAG, "无法创建点数组");
-            cJSON_Delete(animation);
-            continue;
+        // 添加所有元素
+        for (int i = 0; i < builtin->element_count; i++) {
+            write_element(&writer, &builtin->elements[i]);
         }
         
-        // 添加所有点
-        for (int i = 0; i < anim_def->point_count; i++) {
-            cJSON *point = cJSON_CreateObject();
-            if (!point) {
-                ESP_LOGE(TAG, "无法创建点对象 %d:%d", anim_idx, i);
-                continue;
-            }
-            
-            cJSON_AddStringToObject(point, "type", "point");
-            cJSON_AddNumberToObject(point, "x", anim_def->points[i].x);
-            cJSON_AddNumberToObject(point, "y", anim_def->points[i].y);
-            cJSON_AddNumberToObject(point, "r", anim_def->points[i].r);
-            cJSON_AddNumberToObject(point, "g", anim_def->points[i].g);
-            cJSON_AddNumberToObject(point, "b", anim_def->points[i].b);
-            
-            cJSON_AddItemToArray(points, point);
-        }
-        
-        // 添加点数组到动画
-        cJSON_AddItemToObject(animation, "points", points);
-        
-        // 添加动画到动画数组
-        cJSON_AddItemToArray(animations, animation);
+        led_json_writer_end_array(&writer);
+        led_json_writer_end_object(&writer);
         
-        total_points += anim_def->point_count;
-        ESP_LOGI(TAG, "添加动画 '%s'，包含 %d 个点", anim_def->name, anim_def->point_count);
+        total_points += builtin->element_count;
+        ESP_LOGI(TAG, "添加动画 '%s'，包含 %d 个点", builtin->name, builtin->element_count);
     }
     
-    // 添加动画数组到根对象
-    cJSON_AddItemToObject(root, "animations", animations);
-    
-    // 生成JSON字符串
-    char *json_string = cJSON_Print(root);
-    if (!json_string) {
-        ESP_LOGE(TAG, "无法生成JSON字符串");
-        cJSON_Delete(root);
-        return ESP_ERR_NO_MEM;
-    }
+    led_json_writer_end_array(&writer);
+    led_json_writer_end_object(&writer);
     
-    // 写入文件
-    FILE *file = fopen(filename, "w");
-    if (!file) {
-        ESP_LOGE(TAG, "无法创建文件: %s", filename);
-        free(json_string);
-        cJSON_Delete(root);
-        return ESP_ERR_INVALID_ARG;
-    }
-    
-    size_t written = fwrite(json_string, 1, strlen(json_string), file);
-    fclose(file);
-    
-    if (written != strlen(json_string)) {
-        ESP_LOGE(TAG, "写入文件失败，期望 %d 字节，实际写入 %d 字节", 
-                strlen(json_string), written);
-        free(json_string);
-        cJSON_Delete(root);
-        return ESP_ERR_INVALID_SIZE;
+    led_json_writer_stats_t stats;
+    ret = led_json_writer_close(&writer, &stats);
+    if (ret != ESP_OK) {
+        // 不完整的文件会被当作用户动画加载，直接删除
+        ESP_LOGE(TAG, "写入文件失败: %s (%s)", filename, esp_err_to_name(ret));
+        remove(filename);
+        return ret;
     }
     
     ESP_LOGI(TAG, "成功导出 %d 个动画（共 %d 个点）到文件: %s", 
              total_animations, total_points, filename);
-    ESP_LOGI(TAG, "JSON文件大小: %d 字节", strlen(json_string));
-    
-    // 清理内存
-    free(json_string);
-    cJSON_Delete(root);
+    ESP_LOGI(TAG, "JSON文件大小: %u 字节, 耗时 %lld us, 写入 %" PRIu32 " 次, 工作内存 %u 字节",
+             (unsigned)stats.bytes_written, stats.elapsed_us, stats.flushes, (unsigned)stats.working_memory);
     
     return ESP_OK;
 }
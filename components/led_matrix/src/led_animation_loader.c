@@ -1,21 +1,191 @@
 #include "led_animation_loader.h"
 #include "led_animation.h"
+#include "led_matrix_blit.h"
 #include "bsp_storage.h"
 #include "esp_log.h"
-#include "cJSON.h"
+#include "led_json_stream.h"
+#include "led_animation_binary.h"
+#include "led_animation_cache.h"
+#include "esp_timer.h"
+#include "esp_rom_crc.h"
+#include "freertos/FreeRTOS.h"
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <inttypes.h>
 #include <sys/stat.h>
 
 static const char *TAG = "LED_ANIM_LOADER";
 
 // 动画配置参数
-#define MAX_ANIMATIONS 10
-#define MAX_POINTS_PER_ANIMATION 200
-#define MAX_FILE_SIZE (64 * 1024) // 64KB最大文件大小
+#define MAX_ANIMATIONS ANIMATION_FILE_MAX_ANIMATIONS
+#define DEFAULT_ANIMATION_NAME "未命名动画"
+#define MAX_ARRAY_VALUES 4096       // 单个图元points/runs数组最多保留的数值个数
+#define COORD_LIMIT 1024            // 矩形、圆、行图元的坐标和尺寸范围（防止整数溢出）
 
-// Bresenham直线算法
-static void draw_line(int x1, int y1, int x2, int y2, uint8_t r, uint8_t g, uint8_t b) {
+// TF卡上的清单文件
+#define MANIFEST_EXTENSION ".idx"
+#define MANIFEST_MAGIC "RMMF"
+#define MANIFEST_VERSION 1
+
+// 流式解析中各层级的嵌套深度
+#define DEPTH_ROOT_MEMBER   1   // 根对象成员（animations）
+#define DEPTH_ANIMATION     2   // animations数组元素
+#define DEPTH_ANIM_MEMBER   3   // 动画对象成员（name/points）
+#define DEPTH_POINT         4   // points数组元素
+#define DEPTH_POINT_MEMBER  5   // 点对象成员
+#define DEPTH_POINT_ARRAY   6   // 点对象成员数组元素（points/runs），更深的层级为嵌套坐标
+
+// 清单文件头
+typedef struct __attribute__((packed)) {
+    char magic[4];                      // "RMMF"
+    uint16_t version;                   // 格式版本
+    uint16_t manifest_size;             // 清单结构大小
+    uint32_t crc32;                     // 清单内容CRC32
+} manifest_file_header_t;
+
+// 内存中的清单缓存（只缓存最近使用的一个文件）
+static struct {
+    bool valid;
+    char filename[128];
+    animation_manifest_t manifest;
+} s_manifest_cache;
+static portMUX_TYPE s_manifest_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// 点对象字段
+typedef enum {
+    POINT_FIELD_X = 0,
+    POINT_FIELD_Y,
+    POINT_FIELD_X1,
+    POINT_FIELD_Y1,
+    POINT_FIELD_X2,
+    POINT_FIELD_Y2,
+    POINT_FIELD_R,
+    POINT_FIELD_G,
+    POINT_FIELD_B,
+    POINT_FIELD_TYPE,
+    POINT_FIELD_W,
+    POINT_FIELD_H,
+    POINT_FIELD_RADIUS,
+    POINT_FIELD_FILL,
+    POINT_FIELD_CLOSED,
+    POINT_FIELD_POINTS,
+    POINT_FIELD_RUNS,
+    POINT_FIELD_COUNT,
+    POINT_FIELD_NONE = POINT_FIELD_COUNT
+} point_field_t;
+
+static const char *POINT_FIELD_NAMES[POINT_FIELD_COUNT] = {
+    "x", "y", "x1", "y1", "x2", "y2", "r", "g", "b", "type",
+    "w", "h", "radius", "fill", "closed", "points", "runs"
+};
+
+// 图元类型（用于统计）
+typedef enum {
+    PRIMITIVE_POINT = 0,
+    PRIMITIVE_LINE,
+    PRIMITIVE_RECT,
+    PRIMITIVE_CIRCLE,
+    PRIMITIVE_POLYLINE,
+    PRIMITIVE_ROW,
+    PRIMITIVE_COUNT
+} primitive_type_t;
+
+static const char *PRIMITIVE_NAMES[PRIMITIVE_COUNT] = {
+    "point", "line", "rect", "circle", "polyline", "row"
+};
+
+// 可增长的整数数组（折线顶点、行程长度）
+typedef struct {
+    int *values;
+    int count;
+    int capacity;
+    bool truncated;
+} value_buffer_t;
+
+// 动画对象中关心的键
+typedef enum {
+    ANIM_KEY_NONE = 0,
+    ANIM_KEY_NAME,
+    ANIM_KEY_POINTS
+} anim_key_t;
+
+// 流式加载上下文
+typedef struct {
+    // 加载目标
+    bool decode_points;                 // 是否把点解码进动画存储
+    led_animation_bank_t *bank;         // 解码到该动画库（新建或调用者持有的动画库）
+    const char *target_name;            // 只加载该名称的动画，NULL表示不按名称过滤
+    int target_index;                   // 只处理该序号的动画，-1表示不按序号过滤
+    char *name_out;                     // 按序号查询名称时的输出缓冲区
+    size_t name_out_size;
+    animation_manifest_t *manifest_out; // 生成动画清单时的输出
+    int depth_bias;                     // 只解析单个动画对象时补偿的嵌套深度
+
+    // 解析位置
+    bool animations_key;                // 当前根成员是animations
+    bool animations_seen;               // 已遇到animations
+    bool animations_is_array;
+    bool in_animations;
+    bool in_animation;
+    bool in_points;
+    anim_key_t anim_key;
+    point_field_t point_key;
+
+    // 当前动画
+    int anim_index;                     // 在animations数组中的序号
+    size_t anim_start;                  // 动画对象起始偏移
+    int slot;                           // 动画存储槽位，-1表示尚未创建
+    led_blit_surface_t surface;         // 当前动画槽位的绘制表面
+    char name[64];
+    bool name_seen;                     // 已遇到name键（以第一次出现为准）
+    bool points_seen;                   // 已遇到points键
+    bool points_is_array;
+    bool points_skipped;                // 名称出现在points之后，点数据被跳过
+    int points_count;
+    int parsed_points;
+
+    // 当前点
+    bool point_active;
+    uint32_t point_seen;                // 已出现的字段（以第一次出现为准）
+    uint32_t point_numeric;             // 数值有效的字段
+    int point_values[POINT_FIELD_COUNT];
+    char point_type[12];
+    bool point_fill;                    // 矩形/圆是否实心，默认true
+    bool point_closed;                  // 折线是否闭合，默认false
+    point_field_t array_field;          // 正在收集的数组字段，POINT_FIELD_NONE表示没有
+    value_buffer_t path;                // points数组中的坐标
+    value_buffer_t runs;                // runs数组中的行程长度
+    int primitive_counts[PRIMITIVE_COUNT];
+
+    // 结果
+    int animations_total;
+    int loaded_count;
+    bool found;
+    int found_index;                    // 匹配到但点数据被跳过的动画序号
+    esp_err_t result;
+} load_ctx_t;
+
+// 输出一行上的连续像素区段
+static void draw_run(const led_blit_surface_t *surface, int xa, int xb, int y, uint8_t r, uint8_t g, uint8_t b) {
+    int x = (xa < xb) ? xa : xb;
+    led_blit_hspan(surface, x, y, abs(xb - xa) + 1, r, g, b);
+}
+
+// Bresenham直线算法，同一行上的连续像素合并为扫描线写入
+static void draw_line(const led_blit_surface_t *surface, int x1, int y1, int x2, int y2, uint8_t r, uint8_t g, uint8_t b) {
+    // 水平线和垂直线直接块填充
+    if (y1 == y2) {
+        draw_run(surface, x1, x2, y1, r, g, b);
+        return;
+    }
+    if (x1 == x2) {
+        int y = (y1 < y2) ? y1 : y2;
+        led_blit_fill_rect(surface, x1, y, 1, abs(y2 - y1) + 1, r, g, b);
+        return;
+    }
+    
     int dx = abs(x2 - x1);
     int dy = abs(y2 - y1);
     int sx = (x1 < x2) ? 1 : -1;
@@ -23,498 +193,1177 @@ static void draw_line(int x1, int y1, int x2, int y2, uint8_t r, uint8_t g, uint
     int err = dx - dy;
     
     int x = x1, y = y1;
+    int run_start = x;
     
     while (true) {
-        led_animation_set_point(x, y, r, g, b);
-        
         if (x == x2 && y == y2) break;
         
         int e2 = 2 * err;
+        int prev_x = x;
         if (e2 > -dy) {
             err -= dy;
             x += sx;
         }
         if (e2 < dx) {
             err += dx;
+            // 换行前输出当前行的区段
+            draw_run(surface, run_start, prev_x, y, r, g, b);
             y += sy;
+            run_start = x;
         }
     }
+    draw_run(surface, run_start, x, y, r, g, b);
 }
 
-// 解析单个点
-static esp_err_t parse_point(cJSON *point_json) {
-    if (!cJSON_IsObject(point_json)) {
-        ESP_LOGE(TAG, "点不是有效的JSON对象");
-        return ESP_ERR_INVALID_ARG;
+// ========== 静态函数 ==========
+
+// 与cJSON的valueint一致：超出范围时饱和
+static int number_to_int(double value) {
+    if (value >= INT_MAX) {
+        return INT_MAX;
     }
-    
-    // 获取点类型，默认为"point"
-    cJSON *type_json = cJSON_GetObjectItem(point_json, "type");
-    const char *type = "point"; // 默认类型
-    if (cJSON_IsString(type_json)) {
-        type = type_json->valuestring;
+    if (value <= (double)INT_MIN) {
+        return INT_MIN;
     }
-    
-    // 获取颜色
-    cJSON *r_json = cJSON_GetObjectItem(point_json, "r");
-    cJSON *g_json = cJSON_GetObjectItem(point_json, "g");
-    cJSON *b_json = cJSON_GetObjectItem(point_json, "b");
-    
-    if (!cJSON_IsNumber(r_json) || !cJSON_IsNumber(g_json) || !cJSON_IsNumber(b_json)) {
+    return (int)value;
+}
+
+// 限制到图元坐标范围
+static int clamp_coord(int value) {
+    if (value > COORD_LIMIT) {
+        return COORD_LIMIT;
+    }
+    if (value < -COORD_LIMIT) {
+        return -COORD_LIMIT;
+    }
+    return value;
+}
+
+// 追加一个数值，容量不足时倍增
+static void value_buffer_push(value_buffer_t *buffer, int value) {
+    if (buffer->count >= MAX_ARRAY_VALUES) {
+        buffer->truncated = true;
+        return;
+    }
+    if (buffer->count == buffer->capacity) {
+        int capacity = buffer->capacity ? buffer->capacity * 2 : 32;
+        int *values = realloc(buffer->values, (size_t)capacity * sizeof(int));
+        if (!values) {
+            buffer->truncated = true;
+            return;
+        }
+        buffer->values = values;
+        buffer->capacity = capacity;
+    }
+    buffer->values[buffer->count++] = value;
+}
+
+static void load_ctx_release(load_ctx_t *ctx) {
+    free(ctx->path.values);
+    free(ctx->runs.values);
+    memset(&ctx->path, 0, sizeof(ctx->path));
+    memset(&ctx->runs, 0, sizeof(ctx->runs));
+}
+
+static void load_ctx_init(load_ctx_t *ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->target_index = -1;
+    ctx->anim_index = -1;
+    ctx->slot = -1;
+    ctx->found_index = -1;
+    ctx->result = ESP_OK;
+}
+
+// 当前动画是否为加载目标
+static bool is_target_animation(const load_ctx_t *ctx) {
+    if (ctx->target_index >= 0 && ctx->anim_index != ctx->target_index) {
+        return false;
+    }
+    if (ctx->target_name && (!ctx->name_seen || strcmp(ctx->name, ctx->target_name) != 0)) {
+        return false;
+    }
+    return true;
+}
+
+// 为当前动画创建存储槽位
+static esp_err_t ensure_animation_slot(load_ctx_t *ctx) {
+    if (ctx->slot >= 0) {
+        return ESP_OK;
+    }
+
+    const char *name = ctx->name_seen ? ctx->name : DEFAULT_ANIMATION_NAME;
+    ESP_LOGI(TAG, "解析动画: %s (索引: %d)", name, ctx->anim_index);
+
+    int created_index = led_animation_bank_add(ctx->bank, name);
+    if (created_index < 0) {
+        ESP_LOGE(TAG, "无法创建动画槽位");
+        return ESP_ERR_NO_MEM;
+    }
+
+    // 直接写入新槽位，不改变正在播放的动画
+    if (!led_animation_bank_get_surface(ctx->bank, created_index, &ctx->surface)) {
+        ESP_LOGE(TAG, "无法获取动画槽位: %d", created_index);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    ctx->slot = created_index;
+    return ESP_OK;
+}
+
+// 矩形：实心直接块填充，空心为上下两条扫描线和左右两列
+static void draw_rect(const led_blit_surface_t *surface, int x, int y, int w, int h, bool fill,
+                      uint8_t r, uint8_t g, uint8_t b) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    if (fill || w <= 2 || h <= 2) {
+        led_blit_fill_rect(surface, x, y, w, h, r, g, b);
+        return;
+    }
+    led_blit_hspan(surface, x, y, w, r, g, b);
+    led_blit_hspan(surface, x, y + h - 1, w, r, g, b);
+    led_blit_fill_rect(surface, x, y + 1, 1, h - 2, r, g, b);
+    led_blit_fill_rect(surface, x + w - 1, y + 1, 1, h - 2, r, g, b);
+}
+
+// 中点画圆算法，实心圆按对称的扫描线填充
+static void draw_circle(const led_blit_surface_t *surface, int cx, int cy, int radius, bool fill,
+                        uint8_t r, uint8_t g, uint8_t b) {
+    if (radius < 0) {
+        return;
+    }
+
+    int x = radius;
+    int y = 0;
+    int err = 1 - radius;
+    while (x >= y) {
+        if (fill) {
+            led_blit_hspan(surface, cx - x, cy + y, 2 * x + 1, r, g, b);
+            led_blit_hspan(surface, cx - x, cy - y, 2 * x + 1, r, g, b);
+            led_blit_hspan(surface, cx - y, cy + x, 2 * y + 1, r, g, b);
+            led_blit_hspan(surface, cx - y, cy - x, 2 * y + 1, r, g, b);
+        } else {
+            led_blit_pixel(surface, cx + x, cy + y, r, g, b);
+            led_blit_pixel(surface, cx - x, cy + y, r, g, b);
+            led_blit_pixel(surface, cx + x, cy - y, r, g, b);
+            led_blit_pixel(surface, cx - x, cy - y, r, g, b);
+            led_blit_pixel(surface, cx + y, cy + x, r, g, b);
+            led_blit_pixel(surface, cx - y, cy + x, r, g, b);
+            led_blit_pixel(surface, cx + y, cy - x, r, g, b);
+            led_blit_pixel(surface, cx - y, cy - x, r, g, b);
+        }
+
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+// 折线：依次连接顶点，closed时首尾相连
+static void draw_polyline(const led_blit_surface_t *surface, const int *coords, int vertex_count, bool closed,
+                          uint8_t r, uint8_t g, uint8_t b) {
+    if (vertex_count == 1) {
+        led_blit_pixel(surface, coords[0], coords[1], r, g, b);
+        return;
+    }
+    for (int i = 1; i < vertex_count; i++) {
+        draw_line(surface, coords[2 * i - 2], coords[2 * i - 1], coords[2 * i], coords[2 * i + 1], r, g, b);
+    }
+    if (closed && vertex_count >= 3) {
+        int last = 2 * (vertex_count - 1);
+        draw_line(surface, coords[last], coords[last + 1], coords[0], coords[1], r, g, b);
+    }
+}
+
+// 行程编码的一行：从x开始，长度依次为点亮、跳过、点亮……
+static void draw_row(const led_blit_surface_t *surface, int x, int y, const int *runs, int run_count,
+                     uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < run_count && x < surface->width; i++) {
+        int len = runs[i] < 0 ? 0 : runs[i];
+        if (i % 2 == 0) {
+            led_blit_hspan(surface, x, y, len, r, g, b);
+        }
+        x += len;
+    }
+}
+
+// 把一个完整的点对象写入当前动画
+static esp_err_t apply_point(load_ctx_t *ctx) {
+    const uint32_t rgb_mask = (1u << POINT_FIELD_R) | (1u << POINT_FIELD_G) | (1u << POINT_FIELD_B);
+    if ((ctx->point_numeric & rgb_mask) != rgb_mask) {
         ESP_LOGE(TAG, "颜色值无效");
         return ESP_ERR_INVALID_ARG;
     }
-    
-    uint8_t r = (uint8_t)r_json->valueint;
-    uint8_t g = (uint8_t)g_json->valueint;
-    uint8_t b = (uint8_t)b_json->valueint;
-    
+
+    const int *v = ctx->point_values;
+    uint8_t r = (uint8_t)v[POINT_FIELD_R];
+    uint8_t g = (uint8_t)v[POINT_FIELD_G];
+    uint8_t b = (uint8_t)v[POINT_FIELD_B];
+
+    // 获取点类型，默认为"point"
+    const char *type = ctx->point_type[0] ? ctx->point_type : "point";
+    const uint32_t xy_mask = (1u << POINT_FIELD_X) | (1u << POINT_FIELD_Y);
+
     if (strcmp(type, "point") == 0) {
-        // 单点
-        cJSON *x_json = cJSON_GetObjectItem(point_json, "x");
-        cJSON *y_json = cJSON_GetObjectItem(point_json, "y");
-        
-        if (!cJSON_IsNumber(x_json) || !cJSON_IsNumber(y_json)) {
+        if ((ctx->point_numeric & xy_mask) != xy_mask) {
             ESP_LOGE(TAG, "点坐标无效");
             return ESP_ERR_INVALID_ARG;
         }
-        
-        int x = x_json->valueint;
-        int y = y_json->valueint;
-        
-        led_animation_set_point(x, y, r, g, b);
-        
+        ctx->primitive_counts[PRIMITIVE_POINT]++;
+        led_blit_pixel(&ctx->surface, v[POINT_FIELD_X], v[POINT_FIELD_Y], r, g, b);
+
     } else if (strcmp(type, "line") == 0) {
-        // 直线
-        cJSON *x1_json = cJSON_GetObjectItem(point_json, "x1");
-        cJSON *y1_json = cJSON_GetObjectItem(point_json, "y1");
-        cJSON *x2_json = cJSON_GetObjectItem(point_json, "x2");
-        cJSON *y2_json = cJSON_GetObjectItem(point_json, "y2");
-        
-        if (!cJSON_IsNumber(x1_json) || !cJSON_IsNumber(y1_json) ||
-            !cJSON_IsNumber(x2_json) || !cJSON_IsNumber(y2_json)) {
+        const uint32_t line_mask = (1u << POINT_FIELD_X1) | (1u << POINT_FIELD_Y1) |
+                                   (1u << POINT_FIELD_X2) | (1u << POINT_FIELD_Y2);
+        if ((ctx->point_numeric & line_mask) != line_mask) {
             ESP_LOGE(TAG, "直线坐标无效");
             return ESP_ERR_INVALID_ARG;
         }
-        
-        int x1 = x1_json->valueint;
-        int y1 = y1_json->valueint;
-        int x2 = x2_json->valueint;
-        int y2 = y2_json->valueint;
-        
-        draw_line(x1, y1, x2, y2, r, g, b);
-        
+        ctx->primitive_counts[PRIMITIVE_LINE]++;
+        draw_line(&ctx->surface, v[POINT_FIELD_X1], v[POINT_FIELD_Y1], v[POINT_FIELD_X2], v[POINT_FIELD_Y2], r, g, b);
+
+    } else if (strcmp(type, "rect") == 0) {
+        const uint32_t rect_mask = xy_mask | (1u << POINT_FIELD_W) | (1u << POINT_FIELD_H);
+        if ((ctx->point_numeric & rect_mask) != rect_mask) {
+            ESP_LOGE(TAG, "矩形参数无效");
+            return ESP_ERR_INVALID_ARG;
+        }
+        ctx->primitive_counts[PRIMITIVE_RECT]++;
+        draw_rect(&ctx->surface, clamp_coord(v[POINT_FIELD_X]), clamp_coord(v[POINT_FIELD_Y]),
+                  clamp_coord(v[POINT_FIELD_W]), clamp_coord(v[POINT_FIELD_H]), ctx->point_fill, r, g, b);
+
+    } else if (strcmp(type, "circle") == 0) {
+        const uint32_t circle_mask = xy_mask | (1u << POINT_FIELD_RADIUS);
+        if ((ctx->point_numeric & circle_mask) != circle_mask) {
+            ESP_LOGE(TAG, "圆参数无效");
+            return ESP_ERR_INVALID_ARG;
+        }
+        ctx->primitive_counts[PRIMITIVE_CIRCLE]++;
+        draw_circle(&ctx->surface, clamp_coord(v[POINT_FIELD_X]), clamp_coord(v[POINT_FIELD_Y]),
+                    clamp_coord(v[POINT_FIELD_RADIUS]), ctx->point_fill, r, g, b);
+
+    } else if (strcmp(type, "polyline") == 0) {
+        if (!(ctx->point_seen & (1u << POINT_FIELD_POINTS)) || ctx->path.count < 2) {
+            ESP_LOGE(TAG, "折线顶点无效");
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (ctx->path.truncated) {
+            ESP_LOGW(TAG, "折线顶点过多，只绘制前 %d 个", ctx->path.count / 2);
+        }
+        ctx->primitive_counts[PRIMITIVE_POLYLINE]++;
+        draw_polyline(&ctx->surface, ctx->path.values, ctx->path.count / 2, ctx->point_closed, r, g, b);
+
+    } else if (strcmp(type, "row") == 0) {
+        if ((ctx->point_numeric & xy_mask) != xy_mask || !(ctx->point_seen & (1u << POINT_FIELD_RUNS))) {
+            ESP_LOGE(TAG, "行参数无效");
+            return ESP_ERR_INVALID_ARG;
+        }
+        ctx->primitive_counts[PRIMITIVE_ROW]++;
+        draw_row(&ctx->surface, clamp_coord(v[POINT_FIELD_X]), v[POINT_FIELD_Y], ctx->runs.values, ctx->runs.count, r, g, b);
+
     } else {
         ESP_LOGW(TAG, "未知的点类型: %s", type);
         return ESP_ERR_NOT_SUPPORTED;
     }
-    
+
     return ESP_OK;
 }
 
-// 解析单个动画
-static esp_err_t parse_animation(cJSON *animation_json, int animation_index) {
-    if (!cJSON_IsObject(animation_json)) {
-        ESP_LOGE(TAG, "动画不是有效的JSON对象");
-        return ESP_ERR_INVALID_ARG;
-    }
-    
-    // 获取动画名称
-    cJSON *name_json = cJSON_GetObjectItem(animation_json, "name");
-    const char *name = "未命名动画";
-    if (cJSON_IsString(name_json)) {
-        name = name_json->valuestring;
+// 点对象成员
+static void handle_point_member(load_ctx_t *ctx, const led_json_event_t *event) {
+    if (event->type == LED_JSON_EVENT_KEY) {
+        ctx->point_key = POINT_FIELD_NONE;
+        for (int i = 0; i < POINT_FIELD_COUNT; i++) {
+            if (strcmp(event->str, POINT_FIELD_NAMES[i]) == 0) {
+                ctx->point_key = (point_field_t)i;
+                break;
+            }
+        }
+        return;
     }
-    
-    ESP_LOGI(TAG, "解析动画: %s (索引: %d)", name, animation_index);
-    
-    // 创建新动画槽位
-    int created_index = led_animation_create_new(name);
-    if (created_index < 0) {
-        ESP_LOGE(TAG, "无法创建动画槽位");
-        return ESP_ERR_NO_MEM;
+
+    // 容器结束事件不对应新的成员值
+    if (event->type == LED_JSON_EVENT_OBJECT_END || event->type == LED_JSON_EVENT_ARRAY_END) {
+        ctx->array_field = POINT_FIELD_NONE;
+        return;
     }
-    
-    // 选择新创建的动画为当前动画
-    esp_err_t select_result = led_animation_select(created_index);
-    if (select_result != ESP_OK) {
-        ESP_LOGE(TAG, "无法选择动画: %d", created_index);
-        return select_result;
+
+    point_field_t field = ctx->point_key;
+    ctx->point_key = POINT_FIELD_NONE;
+    if (field == POINT_FIELD_NONE || (ctx->point_seen & (1u << field))) {
+        return;
     }
-    
-    // 获取点数组
-    cJSON *points_json = cJSON_GetObjectItem(animation_json, "points");
-    if (!cJSON_IsArray(points_json)) {
-        ESP_LOGE(TAG, "动画点不是有效的数组");
-        return ESP_ERR_INVALID_ARG;
+
+    if (field == POINT_FIELD_POINTS || field == POINT_FIELD_RUNS) {
+        // 只接受数组，元素由handle_point_array()收集
+        if (event->type == LED_JSON_EVENT_ARRAY_START) {
+            ctx->point_seen |= (1u << field);
+            ctx->array_field = field;
+        }
+        return;
     }
-    
-    int points_count = cJSON_GetArraySize(points_json);
-    ESP_LOGI(TAG, "动画包含 %d 个点", points_count);
-    
-    // 限制点数量
-    if (points_count > MAX_POINTS_PER_ANIMATION) {
-        ESP_LOGW(TAG, "动画点数量 (%d) 超过限制 (%d)，将忽略多余的点", 
-                points_count, MAX_POINTS_PER_ANIMATION);
-        points_count = MAX_POINTS_PER_ANIMATION;
+    ctx->point_seen |= (1u << field);
+
+    if (field == POINT_FIELD_FILL || field == POINT_FIELD_CLOSED) {
+        bool value;
+        if (event->type == LED_JSON_EVENT_BOOL) {
+            value = event->boolean;
+        } else if (event->type == LED_JSON_EVENT_NUMBER) {
+            value = event->number != 0;
+        } else {
+            return;
+        }
+        if (field == POINT_FIELD_FILL) {
+            ctx->point_fill = value;
+        } else {
+            ctx->point_closed = value;
+        }
+        return;
     }
-    
-    // 清除之前的动画点
-    led_animation_clear_points();
-    
-    // 解析每个点
-    int parsed_points = 0;
-    for (int i = 0; i < points_count; i++) {
-        cJSON *point_json = cJSON_GetArrayItem(points_json, i);
-        if (parse_point(point_json) == ESP_OK) {
-            parsed_points++;
+
+    if (field == POINT_FIELD_TYPE) {
+        if (event->type == LED_JSON_EVENT_STRING && !event->truncated &&
+            event->len < sizeof(ctx->point_type)) {
+            memcpy(ctx->point_type, event->str, event->len + 1);
+        } else if (event->type == LED_JSON_EVENT_STRING) {
+            // 过长的类型名必然未知，保留前缀用于告警
+            strncpy(ctx->point_type, event->str, sizeof(ctx->point_type) - 1);
+            ctx->point_type[sizeof(ctx->point_type) - 1] = '\0';
         }
+    } else if (event->type == LED_JSON_EVENT_NUMBER) {
+        ctx->point_values[field] = number_to_int(event->number);
+        ctx->point_numeric |= (1u << field);
     }
-    
-    ESP_LOGI(TAG, "成功解析 %d 个点", parsed_points);
-    return ESP_OK;
 }
 
-// 从JSON文件加载动画
-esp_err_t load_animation_from_json(const char *filename) {
-    ESP_LOGI(TAG, "从JSON文件加载动画: %s", filename);
-    
-    // 检查SD卡是否挂载
-    if (!bsp_storage_sdcard_is_mounted()) {
-        ESP_LOGE(TAG, "SD卡未挂载，无法加载动画");
-        return ESP_ERR_INVALID_STATE;
+// 点对象中points/runs数组的元素，嵌套的[x, y]坐标对按顺序展开
+static void handle_point_array(load_ctx_t *ctx, const led_json_event_t *event) {
+    if (event->type != LED_JSON_EVENT_NUMBER) {
+        return;
     }
-    
-    // 检查文件是否存在
-    struct stat file_stat;
-    if (stat(filename, &file_stat) != 0) {
-        ESP_LOGE(TAG, "文件不存在: %s", filename);
-        return ESP_ERR_NOT_FOUND;
+    value_buffer_t *buffer = (ctx->array_field == POINT_FIELD_POINTS) ? &ctx->path : &ctx->runs;
+    value_buffer_push(buffer, clamp_coord(number_to_int(event->number)));
+}
+
+// points数组元素
+static void handle_point_element(load_ctx_t *ctx, const led_json_event_t *event) {
+    if (event->type == LED_JSON_EVENT_OBJECT_END) {
+        if (ctx->point_active) {
+            if (apply_point(ctx) == ESP_OK) {
+                ctx->parsed_points++;
+            }
+            ctx->point_active = false;
+        }
+        return;
     }
-    
-    // 检查文件大小
-    if (file_stat.st_size > MAX_FILE_SIZE) {
-        ESP_LOGE(TAG, "文件太大: %ld 字节 (最大 %d 字节)", file_stat.st_size, MAX_FILE_SIZE);
-        return ESP_ERR_INVALID_SIZE;
+    if (event->type == LED_JSON_EVENT_ARRAY_END) {
+        return;
     }
-    
-    // 打开文件
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        ESP_LOGE(TAG, "无法打开文件: %s", filename);
-        return ESP_ERR_INVALID_ARG;
+
+    ctx->points_count++;
+    if (event->type != LED_JSON_EVENT_OBJECT_START) {
+        ESP_LOGE(TAG, "点不是有效的JSON对象");
+        return;
     }
-    
-    // 分配内存读取文件
-    char *json_buffer = malloc(file_stat.st_size + 1);
-    if (!json_buffer) {
-        ESP_LOGE(TAG, "无法分配内存 (%ld 字节)", file_stat.st_size + 1);
-        fclose(file);
-        return ESP_ERR_NO_MEM;
+
+    ctx->point_active = true;
+    ctx->point_seen = 0;
+    ctx->point_numeric = 0;
+    ctx->point_type[0] = '\0';
+    ctx->point_key = POINT_FIELD_NONE;
+    ctx->point_fill = true;
+    ctx->point_closed = false;
+    ctx->array_field = POINT_FIELD_NONE;
+    // 复用已分配的缓冲区
+    ctx->path.count = 0;
+    ctx->path.truncated = false;
+    ctx->runs.count = 0;
+    ctx->runs.truncated = false;
+}
+
+// 动画对象中的points数组开始
+static void begin_points(load_ctx_t *ctx) {
+    ctx->points_is_array = true;
+    if (!ctx->decode_points) {
+        return;
     }
-    
-    // 读取文件内容
-    size_t read_size = fread(json_buffer, 1, file_stat.st_size, file);
-    fclose(file);
-    
-    if (read_size != file_stat.st_size) {
-        ESP_LOGE(TAG, "读取文件失败，期望 %ld 字节，实际读取 %d 字节", 
-                file_stat.st_size, read_size);
-        free(json_buffer);
-        return ESP_ERR_INVALID_SIZE;
+
+    if (is_target_animation(ctx)) {
+        esp_err_t ret = ensure_animation_slot(ctx);
+        if (ret != ESP_OK) {
+            ctx->result = ret;
+            return;
+        }
+        ctx->in_points = true;
+    } else if (ctx->target_name && !ctx->name_seen) {
+        // 名称在points之后才出现，暂时无法判断是否为目标动画
+        ctx->points_skipped = true;
     }
-    
-    json_buffer[file_stat.st_size] = '\0'; // 确保字符串结束
-    
-    ESP_LOGI(TAG, "成功读取文件 %ld 字节", file_stat.st_size);
-    
-    // 解析JSON
-    cJSON *root = cJSON_Parse(json_buffer);
-    free(json_buffer);
-    
-    if (!root) {
-        const char *error_ptr = cJSON_GetErrorPtr();
-        ESP_LOGE(TAG, "JSON解析失败: %s", error_ptr ? error_ptr : "未知错误");
-        return ESP_ERR_INVALID_ARG;
+}
+
+// 动画对象成员
+static void handle_animation_member(load_ctx_t *ctx, const led_json_event_t *event) {
+    if (event->type == LED_JSON_EVENT_KEY) {
+        if (strcmp(event->str, "name") == 0) {
+            ctx->anim_key = ANIM_KEY_NAME;
+        } else if (strcmp(event->str, "points") == 0) {
+            ctx->anim_key = ANIM_KEY_POINTS;
+        } else {
+            ctx->anim_key = ANIM_KEY_NONE;
+        }
+        return;
     }
-    
-    // 获取动画数组
-    cJSON *animations = cJSON_GetObjectItem(root, "animations");
-    if (!cJSON_IsArray(animations)) {
-        ESP_LOGE(TAG, "根对象中没有animations数组");
-        cJSON_Delete(root);
-        return ESP_ERR_INVALID_ARG;
+
+    if (event->type == LED_JSON_EVENT_ARRAY_END) {
+        ctx->in_points = false;
+        return;
     }
-    
-    int animations_count = cJSON_GetArraySize(animations);
-    ESP_LOGI(TAG, "文件包含 %d 个动画", animations_count);
-    
-    if (animations_count == 0) {
-        ESP_LOGW(TAG, "文件中没有动画");
-        cJSON_Delete(root);
-        return ESP_ERR_NOT_FOUND;
+    if (event->type == LED_JSON_EVENT_OBJECT_END) {
+        return;
     }
-      // 限制动画数量
-    if (animations_count > MAX_ANIMATIONS) {
-        ESP_LOGW(TAG, "动画数量 (%d) 超过限制 (%d)，将只加载前 %d 个动画", 
-                animations_count, MAX_ANIMATIONS, MAX_ANIMATIONS);
-        animations_count = MAX_ANIMATIONS;
+
+    anim_key_t key = ctx->anim_key;
+    ctx->anim_key = ANIM_KEY_NONE;
+
+    if (key == ANIM_KEY_NAME && !ctx->name_seen) {
+        ctx->name_seen = true;
+        const char *name = (event->type == LED_JSON_EVENT_STRING) ? event->str : DEFAULT_ANIMATION_NAME;
+        strncpy(ctx->name, name, sizeof(ctx->name) - 1);
+        ctx->name[sizeof(ctx->name) - 1] = '\0';
+
+        // 点数据先于名称出现时，槽位以默认名称创建
+        if (ctx->slot >= 0) {
+            led_animation_bank_set_name(ctx->bank, ctx->slot, ctx->name);
+        }
+    } else if (key == ANIM_KEY_POINTS && !ctx->points_seen) {
+        ctx->points_seen = true;
+        if (event->type == LED_JSON_EVENT_ARRAY_START) {
+            begin_points(ctx);
+        }
     }
-    
-    // 清除现有动画
-    led_animation_clear_all();
-    
-    // 加载所有动画
-    int loaded_count = 0;
-    for (int i = 0; i < animations_count; i++) {
-        cJSON *animation = cJSON_GetArrayItem(animations, i);
-        esp_err_t result = parse_animation(animation, i);
-        
-        if (result == ESP_OK) {
-            loaded_count++;
-        } else {
-            ESP_LOGE(TAG, "加载动画 %d 失败", i);
+}
+
+// 按类型输出已绘制的图元数量
+static void log_primitive_counts(const load_ctx_t *ctx) {
+    char summary[96];
+    size_t used = 0;
+    summary[0] = '\0';
+    for (int i = 0; i < PRIMITIVE_COUNT && used < sizeof(summary); i++) {
+        if (ctx->primitive_counts[i] > 0) {
+            int n = snprintf(summary + used, sizeof(summary) - used, " %s=%d",
+                             PRIMITIVE_NAMES[i], ctx->primitive_counts[i]);
+            if (n < 0) {
+                break;
+            }
+            used += (size_t)n;
         }
     }
-    
-    cJSON_Delete(root);
-    
-    if (loaded_count > 0) {
-        // 选择第一个动画作为当前动画
-        led_animation_select(0);
-        ESP_LOGI(TAG, "成功加载 %d 个动画", loaded_count);
-        return ESP_OK;
+    if (used > 0) {
+        ESP_LOGI(TAG, "图元:%s", summary);
+    }
+}
+
+// 动画对象结束，返回false表示结束解析
+static bool end_animation(load_ctx_t *ctx, const led_json_event_t *event) {
+    ctx->in_animation = false;
+    ctx->in_points = false;
+
+    if (ctx->manifest_out) {
+        animation_index_entry_t *entry = &ctx->manifest_out->entries[ctx->anim_index];
+        strncpy(entry->name, ctx->name_seen ? ctx->name : DEFAULT_ANIMATION_NAME, sizeof(entry->name) - 1);
+        entry->name[sizeof(entry->name) - 1] = '\0';
+        entry->offset = (uint32_t)ctx->anim_start;
+        entry->length = (uint32_t)(event->offset - ctx->anim_start + 1);
+        return true;
+    }
+
+    if (ctx->name_out) {
+        if (ctx->anim_index == ctx->target_index) {
+            ctx->found = true;
+            return false;
+        }
+        return true;
+    }
+
+    if (!ctx->decode_points || !is_target_animation(ctx)) {
+        return true;
+    }
+
+    if (ctx->target_name && ctx->points_skipped) {
+        // 名称匹配但点数据已跳过，记录序号后按序号重新加载
+        ctx->found_index = ctx->anim_index;
+        ctx->found = true;
+        return false;
+    }
+
+    esp_err_t ret = ensure_animation_slot(ctx);
+    if (ret != ESP_OK) {
+        ctx->result = ret;
+        return false;
+    }
+
+    if (!ctx->points_is_array) {
+        ESP_LOGE(TAG, "动画点不是有效的数组");
+        ret = ESP_ERR_INVALID_ARG;
     } else {
-        ESP_LOGE(TAG, "没有成功加载任何动画");
-        return ESP_ERR_INVALID_STATE;
+        ESP_LOGI(TAG, "动画包含 %d 个图元，成功解析 %d 个", ctx->points_count, ctx->parsed_points);
+        log_primitive_counts(ctx);
+        ctx->loaded_count++;
+    }
+
+    if (ctx->target_name || ctx->target_index >= 0) {
+        ctx->found = true;
+        ctx->result = ret;
+        return false;
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "加载动画 %d 失败", ctx->anim_index);
     }
+    return true;
 }
 
-// 检查动画文件是否存在
-bool animation_file_exists(const char *filename) {
-    if (!bsp_storage_sdcard_is_mounted()) {
+// animations数组元素开始
+static bool begin_animation(load_ctx_t *ctx, const led_json_event_t *event) {
+    ctx->anim_index++;
+    ctx->animations_total++;
+
+    if (event->type == LED_JSON_EVENT_OBJECT_START) {
+        ctx->in_animation = true;
+        ctx->anim_start = event->offset;
+        ctx->anim_key = ANIM_KEY_NONE;
+        ctx->slot = -1;
+        ctx->name[0] = '\0';
+        ctx->name_seen = false;
+        ctx->points_seen = false;
+        ctx->points_is_array = false;
+        ctx->points_skipped = false;
+        ctx->points_count = 0;
+        ctx->parsed_points = 0;
+        ctx->point_active = false;
+        memset(ctx->primitive_counts, 0, sizeof(ctx->primitive_counts));
+
+        // 限制动画数量
+        if (!ctx->target_name && ctx->target_index < 0 && ctx->anim_index >= MAX_ANIMATIONS) {
+            if (ctx->anim_index == MAX_ANIMATIONS && !ctx->manifest_out) {
+                ESP_LOGW(TAG, "动画数量超过限制 (%d)，将只加载前 %d 个动画", MAX_ANIMATIONS, MAX_ANIMATIONS);
+            }
+            ctx->in_animation = false;
+        }
+        return true;
+    }
+
+    // 非对象元素
+    if (ctx->manifest_out && ctx->anim_index < MAX_ANIMATIONS) {
+        animation_index_entry_t *entry = &ctx->manifest_out->entries[ctx->anim_index];
+        strncpy(entry->name, DEFAULT_ANIMATION_NAME, sizeof(entry->name) - 1);
+        entry->name[sizeof(entry->name) - 1] = '\0';
+        entry->offset = (uint32_t)event->offset;
+        entry->length = 0;
+        return true;
+    }
+    if (ctx->name_out && ctx->anim_index == ctx->target_index) {
+        strncpy(ctx->name_out, DEFAULT_ANIMATION_NAME, ctx->name_out_size - 1);
+        ctx->name_out[ctx->name_out_size - 1] = '\0';
+        ctx->found = true;
         return false;
     }
-    
-    struct stat file_stat;
-    return (stat(filename, &file_stat) == 0);
+    if (ctx->decode_points && !ctx->target_name && ctx->anim_index < MAX_ANIMATIONS &&
+        (ctx->target_index < 0 || ctx->anim_index == ctx->target_index)) {
+        ESP_LOGE(TAG, "动画不是有效的JSON对象");
+        if (ctx->target_index >= 0) {
+            ctx->found = true;
+            ctx->result = ESP_ERR_INVALID_ARG;
+            return false;
+        }
+    }
+    return true;
 }
 
-// 从JSON文件加载单个指定动画
-esp_err_t load_specific_animation_from_json(const char *filename, const char *animation_name) {
-    ESP_LOGI(TAG, "从JSON文件加载指定动画: %s -> %s", filename, animation_name);
-    
-    // 检查SD卡是否挂载
+// 流式解析事件回调
+static bool load_event_handler(const led_json_event_t *event, void *user_ctx) {
+    load_ctx_t *ctx = (load_ctx_t *)user_ctx;
+    if (ctx->result != ESP_OK) {
+        return false;
+    }
+
+    switch (event->depth + ctx->depth_bias) {
+        case DEPTH_ROOT_MEMBER:
+            if (event->type == LED_JSON_EVENT_KEY) {
+                ctx->animations_key = !ctx->animations_seen && strcmp(event->str, "animations") == 0;
+            } else if (event->type == LED_JSON_EVENT_ARRAY_END && ctx->in_animations) {
+                // animations数组结束，后续内容不再需要
+                ctx->in_animations = false;
+                return false;
+            } else if (ctx->animations_key &&
+                       event->type != LED_JSON_EVENT_OBJECT_END && event->type != LED_JSON_EVENT_ARRAY_END) {
+                ctx->animations_key = false;
+                ctx->animations_seen = true;
+                ctx->animations_is_array = (event->type == LED_JSON_EVENT_ARRAY_START);
+                ctx->in_animations = ctx->animations_is_array;
+            }
+            break;
+
+        case DEPTH_ANIMATION:
+            if (!ctx->in_animations) {
+                break;
+            }
+            if (event->type == LED_JSON_EVENT_OBJECT_END) {
+                if (ctx->in_animation) {
+                    return end_animation(ctx, event);
+                }
+            } else if (event->type != LED_JSON_EVENT_ARRAY_END) {
+                return begin_animation(ctx, event);
+            }
+            break;
+
+        case DEPTH_ANIM_MEMBER:
+            if (ctx->in_animation) {
+                handle_animation_member(ctx, event);
+                // 按序号查询名称时拿到名称即可结束
+                if (ctx->name_out && ctx->name_seen && ctx->anim_index == ctx->target_index) {
+                    strncpy(ctx->name_out, ctx->name, ctx->name_out_size - 1);
+                    ctx->name_out[ctx->name_out_size - 1] = '\0';
+                    ctx->found = true;
+                    return false;
+                }
+            }
+            break;
+
+        case DEPTH_POINT:
+            if (ctx->in_points) {
+                handle_point_element(ctx, event);
+            }
+            break;
+
+        case DEPTH_POINT_MEMBER:
+            if (ctx->in_points && ctx->point_active) {
+                handle_point_member(ctx, event);
+            }
+            break;
+
+        default:
+            // points/runs数组元素及嵌套坐标
+            if (event->depth + ctx->depth_bias >= DEPTH_POINT_ARRAY &&
+                ctx->in_points && ctx->point_active && ctx->array_field != POINT_FIELD_NONE) {
+                handle_point_array(ctx, event);
+            }
+            break;
+    }
+
+    return ctx->result == ESP_OK;
+}
+
+// 流式解析文件并输出统计
+static esp_err_t stream_animation_file(const char *filename, load_ctx_t *ctx) {
+    led_json_stream_stats_t stats;
+    esp_err_t ret = led_json_stream_parse_file(filename, load_event_handler, ctx, &stats);
+    load_ctx_release(ctx);
+
+    ESP_LOGI(TAG, "流式解析: %u 字节, %" PRIu32 " 块, 耗时 %lld us, %" PRIu32 " KB/s, 工作内存 %u 字节, 堆峰值 %u 字节%s",
+             (unsigned)stats.bytes_read, stats.chunks, stats.elapsed_us, stats.speed_kbps,
+             (unsigned)stats.working_memory, (unsigned)stats.peak_heap_used,
+             stats.stopped ? " (提前结束)" : "");
+
+    if (ret == ESP_ERR_INVALID_RESPONSE) {
+        ESP_LOGE(TAG, "JSON解析失败");
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ret;
+}
+
+// 检查SD卡与文件
+static esp_err_t check_animation_file(const char *filename, bool verbose) {
     if (!bsp_storage_sdcard_is_mounted()) {
-        ESP_LOGE(TAG, "SD卡未挂载，无法加载动画");
+        if (verbose) {
+            ESP_LOGE(TAG, "SD卡未挂载，无法加载动画");
+        }
         return ESP_ERR_INVALID_STATE;
     }
-    
-    // 检查文件是否存在
+
     struct stat file_stat;
     if (stat(filename, &file_stat) != 0) {
-        ESP_LOGE(TAG, "文件不存在: %s", filename);
+        if (verbose) {
+            ESP_LOGE(TAG, "文件不存在: %s", filename);
+        }
         return ESP_ERR_NOT_FOUND;
     }
-    
-    // 检查文件大小
-    if (file_stat.st_size > MAX_FILE_SIZE) {
-        ESP_LOGE(TAG, "文件太大: %ld 字节 (最大 %d 字节)", file_stat.st_size, MAX_FILE_SIZE);
+
+    if (verbose) {
+        ESP_LOGI(TAG, "动画文件大小: %ld 字节", file_stat.st_size);
+    }
+    return ESP_OK;
+}
+
+// 按序号扫描动画名称
+static esp_err_t scan_animation_name(const char *filename, int animation_index, char *name_buffer, size_t buffer_size) {
+    load_ctx_t ctx;
+    load_ctx_init(&ctx);
+    ctx.target_index = animation_index;
+    ctx.name_out = name_buffer;
+    ctx.name_out_size = buffer_size;
+
+    esp_err_t ret = stream_animation_file(filename, &ctx);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    if (!ctx.animations_seen || !ctx.animations_is_array || !ctx.found) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+// 扫描JSON文件生成动画清单
+static esp_err_t scan_manifest(const char *filename, const struct stat *file_stat, animation_manifest_t *manifest) {
+    // 只扫描结构，记录每个元素的位置和名称
+    load_ctx_t ctx;
+    load_ctx_init(&ctx);
+    memset(manifest, 0, sizeof(*manifest));
+    ctx.manifest_out = manifest;
+
+    esp_err_t ret = stream_animation_file(filename, &ctx);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    if (!ctx.animations_is_array) {
+        ESP_LOGE(TAG, "根对象中没有animations数组");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    manifest->source_size = (uint32_t)file_stat->st_size;
+    manifest->source_mtime = (uint32_t)file_stat->st_mtime;
+    manifest->animation_count = ctx.animations_total;
+    manifest->entry_count = ctx.animations_total < MAX_ANIMATIONS ? ctx.animations_total : MAX_ANIMATIONS;
+
+    ESP_LOGI(TAG, "生成动画清单: %d 个动画", manifest->animation_count);
+    return ESP_OK;
+}
+
+// 清单与源文件是否一致
+static bool manifest_matches(const animation_manifest_t *manifest, const struct stat *file_stat) {
+    return manifest->source_size == (uint32_t)file_stat->st_size &&
+           manifest->source_mtime == (uint32_t)file_stat->st_mtime;
+}
+
+static bool manifest_cache_get(const char *filename, const struct stat *file_stat, animation_manifest_t *manifest) {
+    bool hit = false;
+    portENTER_CRITICAL(&s_manifest_lock);
+    if (s_manifest_cache.valid && strcmp(s_manifest_cache.filename, filename) == 0 &&
+        manifest_matches(&s_manifest_cache.manifest, file_stat)) {
+        *manifest = s_manifest_cache.manifest;
+        hit = true;
+    }
+    portEXIT_CRITICAL(&s_manifest_lock);
+    return hit;
+}
+
+static void manifest_cache_put(const char *filename, const animation_manifest_t *manifest) {
+    if (strlen(filename) >= sizeof(s_manifest_cache.filename)) {
+        return;
+    }
+    portENTER_CRITICAL(&s_manifest_lock);
+    strcpy(s_manifest_cache.filename, filename);
+    s_manifest_cache.manifest = *manifest;
+    s_manifest_cache.valid = true;
+    portEXIT_CRITICAL(&s_manifest_lock);
+}
+
+// 清单文件路径：替换扩展名为.idx
+static esp_err_t manifest_path(const char *filename, char *path, size_t size) {
+    const char *slash = strrchr(filename, '/');
+    const char *dot = strrchr(filename, '.');
+    size_t stem_len = (dot && (!slash || dot > slash)) ? (size_t)(dot - filename) : strlen(filename);
+
+    int written = snprintf(path, size, "%.*s%s", (int)stem_len, filename, MANIFEST_EXTENSION);
+    if (written < 0 || (size_t)written >= size) {
         return ESP_ERR_INVALID_SIZE;
     }
-    
-    // 打开文件
-    FILE *file = fopen(filename, "r");
+    return ESP_OK;
+}
+
+// 读取TF卡上的清单，校验失败或已过期时返回false
+static bool manifest_read_file(const char *filename, const struct stat *file_stat, animation_manifest_t *manifest) {
+    char path[128];
+    if (manifest_path(filename, path, sizeof(path)) != ESP_OK) {
+        return false;
+    }
+
+    FILE *file = fopen(path, "rb");
     if (!file) {
-        ESP_LOGE(TAG, "无法打开文件: %s", filename);
-        return ESP_ERR_INVALID_ARG;
+        return false;
     }
-    
-    // 分配内存读取文件
-    char *json_buffer = malloc(file_stat.st_size + 1);
-    if (!json_buffer) {
-        ESP_LOGE(TAG, "无法分配内存 (%ld 字节)", file_stat.st_size + 1);
-        fclose(file);
-        return ESP_ERR_NO_MEM;
+
+    manifest_file_header_t header;
+    bool ok = fread(&header, 1, sizeof(header), file) == sizeof(header) &&
+              memcmp(header.magic, MANIFEST_MAGIC, sizeof(header.magic)) == 0 &&
+              header.version == MANIFEST_VERSION &&
+              header.manifest_size == sizeof(*manifest) &&
+              fread(manifest, 1, sizeof(*manifest), file) == sizeof(*manifest);
+    fclose(file);
+
+    if (!ok || esp_rom_crc32_le(0, (const uint8_t *)manifest, sizeof(*manifest)) != header.crc32) {
+        ESP_LOGW(TAG, "动画清单文件无效: %s", path);
+        return false;
     }
-    
-    // 读取文件内容
-    size_t read_size = fread(json_buffer, 1, file_stat.st_size, file);
+    if (!manifest_matches(manifest, file_stat)) {
+        ESP_LOGI(TAG, "动画清单已过期，重新扫描");
+        return false;
+    }
+    if (manifest->entry_count < 0 || manifest->entry_count > MAX_ANIMATIONS ||
+        manifest->animation_count < manifest->entry_count) {
+        return false;
+    }
+    return true;
+}
+
+// 保存清单到TF卡，失败时只影响下次启动的速度
+static void manifest_write_file(const char *filename, const animation_manifest_t *manifest) {
+    char path[128];
+    if (manifest_path(filename, path, sizeof(path)) != ESP_OK) {
+        return;
+    }
+
+    manifest_file_header_t header = {
+        .magic = {'R', 'M', 'M', 'F'},
+        .version = MANIFEST_VERSION,
+        .manifest_size = sizeof(*manifest),
+        .crc32 = esp_rom_crc32_le(0, (const uint8_t *)manifest, sizeof(*manifest)),
+    };
+
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        ESP_LOGW(TAG, "无法写入动画清单: %s", path);
+        return;
+    }
+    bool ok = fwrite(&header, 1, sizeof(header), file) == sizeof(header) &&
+              fwrite(manifest, 1, sizeof(*manifest), file) == sizeof(*manifest);
     fclose(file);
-    
-    if (read_size != file_stat.st_size) {
-        ESP_LOGE(TAG, "读取文件失败，期望 %ld 字节，实际读取 %d 字节", 
-                file_stat.st_size, read_size);
-        free(json_buffer);
-        return ESP_ERR_INVALID_SIZE;
+
+    if (!ok) {
+        ESP_LOGW(TAG, "写入动画清单失败: %s", path);
+        remove(path);
     }
-    
-    json_buffer[file_stat.st_size] = '\0';
-    
-    // 解析JSON
-    cJSON *root = cJSON_Parse(json_buffer);
-    free(json_buffer);
-    
-    if (!root) {
-        const char *error_ptr = cJSON_GetErrorPtr();
-        ESP_LOGE(TAG, "JSON解析失败: %s", error_ptr ? error_ptr : "未知错误");
+}
+
+// ========== 核心接口实现 ==========
+
+// 从JSON文件加载动画
+esp_err_t load_animation_from_json(const char *filename) {
+    led_animation_bank_t *bank = NULL;
+    esp_err_t ret = load_animation_bank_from_json(filename, &bank);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // 整体替换当前动画库，选择第一个动画作为当前动画
+    return led_animation_bank_publish(bank, 0);
+}
+
+// 从JSON文件构建新的动画库
+esp_err_t load_animation_bank_from_json(const char *filename, led_animation_bank_t **bank_out) {
+    ESP_LOGI(TAG, "从JSON文件加载动画: %s", filename);
+
+    if (!bank_out) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-    // 获取动画数组
-    cJSON *animations = cJSON_GetObjectItem(root, "animations");
-    if (!cJSON_IsArray(animations)) {
+    *bank_out = NULL;
+
+    // 优先使用预编译的二进制动画
+    char bin_path[128];
+    if (bsp_storage_sdcard_is_mounted() &&
+        led_animation_binary_path(filename, bin_path, sizeof(bin_path)) == ESP_OK &&
+        led_animation_binary_is_fresh(filename, bin_path)) {
+        if (load_animation_bank_from_binary(bin_path, bank_out) == ESP_OK) {
+            return ESP_OK;
+        }
+        ESP_LOGW(TAG, "二进制动画加载失败，回退到JSON解析");
+    }
+
+    esp_err_t ret = check_animation_file(filename, true);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // 其次使用上次解码留下的启动缓存，JSON内容未变时跳过解析
+    led_animation_cache_key_t cache_key;
+    bool has_cache_key = led_animation_cache_compute_key(filename, &cache_key) == ESP_OK;
+    if (has_cache_key && led_animation_cache_load(filename, &cache_key, bank_out) == ESP_OK) {
+        return ESP_OK;
+    }
+
+    led_animation_bank_t *bank = led_animation_bank_create();
+    if (!bank) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    int64_t parse_start_us = esp_timer_get_time();
+
+    load_ctx_t ctx;
+    load_ctx_init(&ctx);
+    ctx.decode_points = true;
+    ctx.bank = bank;
+
+    ret = stream_animation_file(filename, &ctx);
+    if (ret == ESP_OK && ctx.result != ESP_OK) {
+        ret = ctx.result;
+    }
+    if (ret == ESP_OK && !ctx.animations_is_array) {
         ESP_LOGE(TAG, "根对象中没有animations数组");
-        cJSON_Delete(root);
-        return ESP_ERR_INVALID_ARG;
+        ret = ESP_ERR_INVALID_ARG;
     }
-    
-    int animations_count = cJSON_GetArraySize(animations);
-    
-    // 搜索指定名称的动画
-    for (int i = 0; i < animations_count; i++) {
-        cJSON *animation = cJSON_GetArrayItem(animations, i);
-        cJSON *name_json = cJSON_GetObjectItem(animation, "name");
-        
-        if (cJSON_IsString(name_json) && strcmp(name_json->valuestring, animation_name) == 0) {
-            ESP_LOGI(TAG, "找到动画: %s", animation_name);
-            esp_err_t result = parse_animation(animation, i);
-            cJSON_Delete(root);
-            return result;
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "文件包含 %d 个动画", ctx.animations_total);
+        if (ctx.animations_total == 0) {
+            ESP_LOGW(TAG, "文件中没有动画");
+            ret = ESP_ERR_NOT_FOUND;
+        } else if (ctx.loaded_count == 0) {
+            ESP_LOGE(TAG, "没有成功加载任何动画");
+            ret = ESP_ERR_INVALID_STATE;
         }
     }
-    
-    cJSON_Delete(root);
-    ESP_LOGE(TAG, "未找到动画: %s", animation_name);
-    return ESP_ERR_NOT_FOUND;
+
+    if (ret != ESP_OK) {
+        // 解码失败的动画库直接丢弃，当前动画不受影响
+        led_animation_bank_destroy(bank);
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "成功加载 %d 个动画", ctx.loaded_count);
+    if (has_cache_key) {
+        led_animation_cache_store(filename, &cache_key, bank, NULL, ctx.loaded_count,
+                                  esp_timer_get_time() - parse_start_us);
+    }
+    *bank_out = bank;
+    return ESP_OK;
 }
 
-// 获取JSON文件中的动画数量
-int get_animation_count_from_json(const char *filename) {
+// 检查动画文件是否存在
+bool animation_file_exists(const char *filename) {
     if (!bsp_storage_sdcard_is_mounted()) {
-        return -1;
+        return false;
     }
     
     struct stat file_stat;
-    if (stat(filename, &file_stat) != 0) {
-        return -1;
+    if (stat(filename, &file_stat) == 0) {
+        return true;
     }
-    
-    if (file_stat.st_size > MAX_FILE_SIZE) {
-        return -1;
-    }
-    
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        return -1;
+
+    // 只有预编译二进制文件时同样可以加载
+    char bin_path[128];
+    return led_animation_binary_path(filename, bin_path, sizeof(bin_path)) == ESP_OK &&
+           stat(bin_path, &file_stat) == 0;
+}
+
+// 从JSON文件加载单个指定动画
+esp_err_t load_specific_animation_from_json(const char *filename, const char *animation_name) {
+    ESP_LOGI(TAG, "从JSON文件加载指定动画: %s -> %s", filename, animation_name);
+
+    if (!animation_name) {
+        return ESP_ERR_INVALID_ARG;
     }
-    
-    char *json_buffer = malloc(file_stat.st_size + 1);
-    if (!json_buffer) {
-        fclose(file);
-        return -1;
+
+    esp_err_t ret = check_animation_file(filename, true);
+    if (ret != ESP_OK) {
+        return ret;
     }
-    
-    size_t read_size = fread(json_buffer, 1, file_stat.st_size, file);
-    fclose(file);
-    
-    if (read_size != file_stat.st_size) {
-        free(json_buffer);
-        return -1;
+
+    // 解码期间持有当前动画库，期间被替换也不会释放
+    led_animation_bank_t *bank = led_animation_bank_acquire();
+
+    load_ctx_t ctx;
+    load_ctx_init(&ctx);
+    ctx.decode_points = true;
+    ctx.target_name = animation_name;
+    ctx.bank = bank;
+
+    ret = stream_animation_file(filename, &ctx);
+    if (ret == ESP_OK && ctx.found && ctx.found_index >= 0) {
+        // 该动画的name位于points之后，第二遍按序号解码
+        int index = ctx.found_index;
+        load_ctx_init(&ctx);
+        ctx.decode_points = true;
+        ctx.target_index = index;
+        ctx.bank = bank;
+
+        ret = stream_animation_file(filename, &ctx);
     }
-    
-    json_buffer[file_stat.st_size] = '\0';
-    
-    cJSON *root = cJSON_Parse(json_buffer);
-    free(json_buffer);
-    
-    if (!root) {
-        return -1;
+
+    if (ret == ESP_OK && !ctx.animations_seen) {
+        ESP_LOGE(TAG, "根对象中没有animations数组");
+        ret = ESP_ERR_INVALID_ARG;
+    } else if (ret == ESP_OK && ctx.found) {
+        ESP_LOGI(TAG, "找到动画: %s", animation_name);
+        if (ctx.slot >= 0) {
+            led_animation_bank_select(bank, ctx.slot);
+        }
+        ret = ctx.result;
+    } else if (ret == ESP_OK) {
+        ESP_LOGE(TAG, "未找到动画: %s", animation_name);
+        ret = ESP_ERR_NOT_FOUND;
     }
-    
-    cJSON *animations = cJSON_GetObjectItem(root, "animations");
-    if (!cJSON_IsArray(animations)) {
-        cJSON_Delete(root);
+
+    led_animation_bank_release(bank);
+    return ret;
+}
+
+// 获取JSON文件中的动画数量
+int get_animation_count_from_json(const char *filename) {
+    animation_manifest_t manifest;
+    if (get_animation_manifest_from_json(filename, &manifest) != ESP_OK) {
         return -1;
     }
-    
-    int count = cJSON_GetArraySize(animations);
-    cJSON_Delete(root);
-    
-    return count;
+    return manifest.animation_count;
 }
 
 // 获取JSON文件中指定索引的动画名称
 esp_err_t get_animation_name_from_json(const char *filename, int animation_index, 
                                       char *name_buffer, size_t buffer_size) {
-    if (!name_buffer || buffer_size == 0) {
+    if (!name_buffer || buffer_size == 0 || animation_index < 0) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-    if (!bsp_storage_sdcard_is_mounted()) {
-        return ESP_ERR_INVALID_STATE;
+
+    animation_manifest_t manifest;
+    esp_err_t ret = get_animation_manifest_from_json(filename, &manifest);
+    if (ret != ESP_OK) {
+        return ret;
     }
-    
+
+    if (animation_index >= manifest.animation_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (animation_index < manifest.entry_count) {
+        strncpy(name_buffer, manifest.entries[animation_index].name, buffer_size - 1);
+        name_buffer[buffer_size - 1] = '\0';
+        return ESP_OK;
+    }
+
+    // 超出清单记录范围的元素，扫描文件查找
+    return scan_animation_name(filename, animation_index, name_buffer, buffer_size);
+}
+
+// 获取JSON文件的动画清单
+esp_err_t get_animation_manifest_from_json(const char *filename, animation_manifest_t *manifest) {
+    if (!filename || !manifest) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = check_animation_file(filename, false);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
     struct stat file_stat;
     if (stat(filename, &file_stat) != 0) {
         return ESP_ERR_NOT_FOUND;
     }
-    
-    if (file_stat.st_size > MAX_FILE_SIZE) {
-        return ESP_ERR_INVALID_SIZE;
+
+    if (manifest_cache_get(filename, &file_stat, manifest)) {
+        return ESP_OK;
     }
-    
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        return ESP_ERR_INVALID_ARG;
+
+    if (manifest_read_file(filename, &file_stat, manifest)) {
+        ESP_LOGI(TAG, "使用TF卡上的动画清单: %d 个动画", manifest->animation_count);
+        manifest_cache_put(filename, manifest);
+        return ESP_OK;
     }
-    
-    char *json_buffer = malloc(file_stat.st_size + 1);
-    if (!json_buffer) {
-        fclose(file);
-        return ESP_ERR_NO_MEM;
+
+    ret = scan_manifest(filename, &file_stat, manifest);
+    if (ret != ESP_OK) {
+        return ret;
     }
-    
-    size_t read_size = fread(json_buffer, 1, file_stat.st_size, file);
-    fclose(file);
-    
-    if (read_size != file_stat.st_size) {
-        free(json_buffer);
-        return ESP_ERR_INVALID_SIZE;
+
+    manifest_cache_put(filename, manifest);
+    manifest_write_file(filename, manifest);
+    return ESP_OK;
+}
+
+// 使动画清单缓存失效
+void invalidate_animation_manifest(const char *filename) {
+    portENTER_CRITICAL(&s_manifest_lock);
+    if (!filename || strcmp(s_manifest_cache.filename, filename) == 0) {
+        s_manifest_cache.valid = false;
     }
-    
-    json_buffer[file_stat.st_size] = '\0';
-    
-    cJSON *root = cJSON_Parse(json_buffer);
-    free(json_buffer);
-    
-    if (!root) {
+    portEXIT_CRITICAL(&s_manifest_lock);
+
+    char path[128];
+    if (filename && manifest_path(filename, path, sizeof(path)) == ESP_OK) {
+        remove(path);
+    }
+}
+
+// 由动画清单建立动画偏移索引
+esp_err_t build_animation_index_from_json(const char *filename, animation_file_index_t *index) {
+    if (!index) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-    cJSON *animations = cJSON_GetObjectItem(root, "animations");
-    if (!cJSON_IsArray(animations)) {
-        cJSON_Delete(root);
+
+    animation_manifest_t manifest;
+    esp_err_t ret = get_animation_manifest_from_json(filename, &manifest);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "获取动画清单失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    // 只保留动画对象
+    memset(index, 0, sizeof(*index));
+    for (int i = 0; i < manifest.entry_count; i++) {
+        if (manifest.entries[i].length > 0) {
+            index->entries[index->count++] = manifest.entries[i];
+        }
+    }
+
+    if (index->count == 0) {
+        ESP_LOGW(TAG, "文件中没有动画");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    ESP_LOGI(TAG, "建立动画索引: %d 个动画", index->count);
+    return ESP_OK;
+}
+
+// 按索引项解码单个动画
+esp_err_t load_indexed_animation_from_json(const char *filename, const animation_index_entry_t *entry,
+                                           led_animation_bank_t *bank, int *animation_index) {
+    if (!entry || !bank || !animation_index) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-    int animations_count = cJSON_GetArraySize(animations);
-    if (animation_index < 0 || animation_index >= animations_count) {
-        cJSON_Delete(root);
+
+    esp_err_t ret = check_animation_file(filename, false);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // 该段只包含一个动画对象，按animations数组元素的深度解析
+    load_ctx_t ctx;
+    load_ctx_init(&ctx);
+    ctx.decode_points = true;
+    ctx.depth_bias = DEPTH_ANIMATION;
+    ctx.animations_seen = true;
+    ctx.animations_is_array = true;
+    ctx.in_animations = true;
+    ctx.bank = bank;
+
+    led_json_stream_stats_t stats;
+    ret = led_json_stream_parse_file_range(filename, entry->offset, entry->length,
+                                           load_event_handler, &ctx, &stats);
+    load_ctx_release(&ctx);
+    if (ret == ESP_ERR_INVALID_RESPONSE) {
+        ESP_LOGE(TAG, "动画 %s 的索引已失效", entry->name);
         return ESP_ERR_INVALID_ARG;
     }
-    
-    cJSON *animation = cJSON_GetArrayItem(animations, animation_index);
-    cJSON *name_json = cJSON_GetObjectItem(animation, "name");
-    
-    const char *name = "未命名动画";
-    if (cJSON_IsString(name_json)) {
-        name = name_json->valuestring;
+    if (ret != ESP_OK) {
+        return ret;
     }
-    
-    strncpy(name_buffer, name, buffer_size - 1);
-    name_buffer[buffer_size - 1] = '\0';
-    
-    cJSON_Delete(root);
-    return ESP_OK;
+    if (ctx.slot < 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    *animation_index = ctx.slot;
+    ESP_LOGI(TAG, "按需解码动画: %s -> 槽位 %d (%u 字节, %lld us)",
+             entry->name, ctx.slot, (unsigned)stats.bytes_read, stats.elapsed_us);
+    return ctx.result;
 }
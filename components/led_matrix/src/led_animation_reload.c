@@ -0,0 +1,171 @@
+/**
+ * @file led_animation_reload.c
+ * @brief 后台动画重新加载实现
+ *
+ * 请求队列深度为1，未开始的请求被新请求覆盖；load_animation_bank_from_json()
+ * 在新动画库中完成加载，再由发布钩子（默认直接发布）替换当前动画库，
+ * 失败时当前动画保持不变。
+ */
+
+#include "led_animation_reload.h"
+#include "led_animation_loader.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include <string.h>
+
+static const char *TAG = "LED_ANIM_RELOAD";
+
+#define RELOAD_TASK_STACK_SIZE      4096
+#define RELOAD_TASK_PRIORITY        2       // 低于显示和网络任务
+#define RELOAD_PATH_MAX             128
+
+// 重新加载请求
+typedef struct {
+    char filename[RELOAD_PATH_MAX];
+    led_animation_reload_publish_cb_t publish;
+    led_animation_reload_cb_t callback;
+    void *user_ctx;
+} reload_request_t;
+
+// 重新加载控制器状态
+typedef struct {
+    bool is_initialized;
+    volatile bool is_loading;
+    QueueHandle_t queue;
+    TaskHandle_t task_handle;
+    portMUX_TYPE stats_lock;
+    led_animation_reload_stats_t stats;
+} reload_controller_t;
+
+static reload_controller_t s_controller = {
+    .stats_lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+// ========== 静态函数声明 ==========
+static void reload_task(void *arg);
+
+// ========== 核心接口实现 ==========
+
+esp_err_t led_animation_reload_init(void) {
+    if (s_controller.is_initialized) {
+        return ESP_OK;
+    }
+
+    s_controller.queue = xQueueCreate(1, sizeof(reload_request_t));
+    if (!s_controller.queue) {
+        ESP_LOGE(TAG, "创建请求队列失败");
+        return ESP_ERR_NO_MEM;
+    }
+
+    BaseType_t ret = xTaskCreate(reload_task, "anim_reload", RELOAD_TASK_STACK_SIZE, NULL,
+                                 RELOAD_TASK_PRIORITY, &s_controller.task_handle);
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "创建重新加载任务失败");
+        vQueueDelete(s_controller.queue);
+        s_controller.queue = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    s_controller.is_initialized = true;
+    ESP_LOGI(TAG, "动画重新加载任务已启动");
+    return ESP_OK;
+}
+
+esp_err_t led_animation_reload_request(const char *filename, led_animation_reload_publish_cb_t publish,
+                                       led_animation_reload_cb_t callback, void *user_ctx) {
+    if (!filename || strlen(filename) >= RELOAD_PATH_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = led_animation_reload_init();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    reload_request_t request = {
+        .publish = publish,
+        .callback = callback,
+        .user_ctx = user_ctx,
+    };
+    strcpy(request.filename, filename);
+
+    bool replaced = uxQueueMessagesWaiting(s_controller.queue) > 0;
+    xQueueOverwrite(s_controller.queue, &request);
+
+    portENTER_CRITICAL(&s_controller.stats_lock);
+    s_controller.stats.requests++;
+    if (replaced) {
+        s_controller.stats.coalesced++;
+    }
+    portEXIT_CRITICAL(&s_controller.stats_lock);
+
+    ESP_LOGI(TAG, "请求后台重新加载: %s%s", filename, replaced ? "（替换未开始的请求）" : "");
+    return ESP_OK;
+}
+
+bool led_animation_reload_is_busy(void) {
+    if (!s_controller.is_initialized) {
+        return false;
+    }
+    return s_controller.is_loading || uxQueueMessagesWaiting(s_controller.queue) > 0;
+}
+
+esp_err_t led_animation_reload_get_stats(led_animation_reload_stats_t *stats) {
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&s_controller.stats_lock);
+    *stats = s_controller.stats;
+    portEXIT_CRITICAL(&s_controller.stats_lock);
+    return ESP_OK;
+}
+
+// ========== 静态函数实现 ==========
+
+static void reload_task(void *arg) {
+    reload_request_t request;
+
+    while (1) {
+        if (xQueueReceive(s_controller.queue, &request, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        s_controller.is_loading = true;
+        int64_t start_us = esp_timer_get_time();
+
+        // 在新动画库中解码，完成后原子替换；渲染继续使用旧动画库
+        led_animation_bank_t *bank = NULL;
+        esp_err_t ret = load_animation_bank_from_json(request.filename, &bank);
+        if (ret == ESP_OK) {
+            ret = request.publish ? request.publish(bank, request.user_ctx) : led_animation_bank_publish(bank, 0);
+        }
+
+        int64_t duration_us = esp_timer_get_time() - start_us;
+        s_controller.is_loading = false;
+
+        portENTER_CRITICAL(&s_controller.stats_lock);
+        s_controller.stats.last_duration_us = duration_us;
+        s_controller.stats.last_result = ret;
+        if (ret == ESP_OK) {
+            s_controller.stats.completed++;
+        } else {
+            s_controller.stats.failed++;
+        }
+        portEXIT_CRITICAL(&s_controller.stats_lock);
+
+        if (ret == ESP_OK) {
+            ESP_LOGI(TAG, "后台重新加载完成: %s, 耗时 %lld us", request.filename, duration_us);
+        } else {
+            ESP_LOGW(TAG, "后台重新加载失败: %s (%s)，继续使用当前动画",
+                     request.filename, esp_err_to_name(ret));
+        }
+
+        if (request.callback) {
+            request.callback(ret, request.user_ctx);
+        }
+    }
+}
@@ -0,0 +1,284 @@
+/**
+ * @file led_animation_watcher.c
+ * @brief TF卡动画文件变化检测实现
+ *
+ * 判定逻辑和任务启停在led_file_watch中（可在主机上测试），这里提供钩子：
+ * 文件系统钩子用stat()取指纹、fopen()按块计算CRC；任务钩子用FreeRTOS任务、
+ * 任务通知和退出信号量。检测任务退出后挂起，由停止者确认退出后删除，
+ * 停止返回时任务已不再运行，可以立即重新启动。
+ */
+
+#include "led_animation_watcher.h"
+#include "led_animation_binary.h"
+#include "led_animation_loader.h"
+#include "led_file_watch.h"
+#include "bsp_storage.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_rom_crc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static const char *TAG = "LED_ANIM_WATCHER";
+
+#define WATCHER_TASK_STACK_SIZE     3072
+#define WATCHER_TASK_PRIORITY       1       // 最低的应用优先级
+#define WATCHER_PATH_MAX            LED_FILE_WATCH_PATH_MAX
+#define WATCHER_MIN_INTERVAL_MS     100
+#define DEFAULT_POLL_INTERVAL_MS    2000
+#define DEFAULT_DEBOUNCE_MS         3000
+#define CRC_CHUNK_SIZE              1024
+#define WATCHER_STOP_TIMEOUT_MS     3000    // 停止时等待任务退出（可能正在计算CRC）
+
+// 检测控制器状态
+typedef struct {
+    TaskHandle_t task_handle;
+    SemaphoreHandle_t task_exit_sem;        // 检测任务退出时释放
+    led_animation_watcher_config_t config;
+    char json_file_path[WATCHER_PATH_MAX];
+    led_file_watch_runner_t runner;         // 判定状态和任务启停
+    portMUX_TYPE stats_lock;
+    led_animation_watcher_stats_t stats;    // 每次轮询后从判定状态复制
+    uint8_t crc_buffer[CRC_CHUNK_SIZE];
+} watcher_controller_t;
+
+static watcher_controller_t s_controller = {
+    .stats_lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+// ========== 静态函数声明 ==========
+static void on_poll(led_file_watch_result_t result, void *user_ctx);
+static void publish_stats(void);
+static bool task_spawn(void *ctx, void (*entry)(void *arg), void *arg);
+static bool task_wait(void *ctx, uint32_t timeout_ms);
+static void task_wake(void *ctx);
+static void task_exited(void *ctx);
+static bool task_join(void *ctx, uint32_t timeout_ms);
+static int64_t task_now_us(void *ctx);
+static bool fs_is_mounted(void *ctx);
+static bool fs_stat(void *ctx, const char *path, uint32_t *size, uint32_t *mtime);
+static bool fs_checksum(void *ctx, const char *path, uint32_t *crc, uint32_t *bytes_read);
+
+// TF卡文件系统钩子
+static const led_file_watch_fs_t SDCARD_FS = {
+    .is_mounted = fs_is_mounted,
+    .stat = fs_stat,
+    .checksum = fs_checksum,
+    .ctx = NULL,
+};
+
+// FreeRTOS任务钩子
+static const led_file_watch_task_ops_t WATCHER_TASK_OPS = {
+    .spawn = task_spawn,
+    .wait = task_wait,
+    .wake = task_wake,
+    .exited = task_exited,
+    .join = task_join,
+    .now_us = task_now_us,
+    .ctx = NULL,
+};
+
+// ========== 核心接口实现 ==========
+
+led_animation_watcher_config_t led_animation_watcher_get_default_config(void) {
+    led_animation_watcher_config_t config = {
+        .json_file_path = ANIMATION_FILE_PATH,
+        .poll_interval_ms = DEFAULT_POLL_INTERVAL_MS,
+        .debounce_ms = DEFAULT_DEBOUNCE_MS,
+        .callback = NULL,
+        .user_ctx = NULL
+    };
+    return config;
+}
+
+esp_err_t led_animation_watcher_start(const led_animation_watcher_config_t *config) {
+    if (!config || !config->json_file_path || !config->callback ||
+        strlen(config->json_file_path) >= WATCHER_PATH_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (s_controller.runner.running) {
+        ESP_LOGW(TAG, "文件变化检测已在运行");
+        return ESP_OK;
+    }
+    // 上一次停止等待超时的任务需先确认退出
+    if (!led_file_watch_runner_stop(&s_controller.runner, WATCHER_STOP_TIMEOUT_MS)) {
+        ESP_LOGE(TAG, "上一个检测任务仍未退出");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!s_controller.task_exit_sem) {
+        s_controller.task_exit_sem = xSemaphoreCreateBinary();
+        if (!s_controller.task_exit_sem) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    s_controller.config = *config;
+    strcpy(s_controller.json_file_path, config->json_file_path);
+    s_controller.config.json_file_path = s_controller.json_file_path;
+    if (s_controller.config.poll_interval_ms < WATCHER_MIN_INTERVAL_MS) {
+        s_controller.config.poll_interval_ms = WATCHER_MIN_INTERVAL_MS;
+    }
+
+    // 监视JSON及其同名.anim
+    char bin_path[WATCHER_PATH_MAX];
+    if (led_animation_binary_path(s_controller.json_file_path, bin_path, sizeof(bin_path)) != ESP_OK) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const char *paths[] = { s_controller.json_file_path, bin_path };
+    if (!led_file_watch_init(&s_controller.runner.watch, paths, sizeof(paths) / sizeof(paths[0]),
+                             s_controller.config.debounce_ms, &SDCARD_FS)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!led_file_watch_runner_start(&s_controller.runner, &WATCHER_TASK_OPS,
+                                     s_controller.config.poll_interval_ms, on_poll, NULL)) {
+        ESP_LOGE(TAG, "创建文件变化检测任务失败");
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "开始检测文件变化: %s (间隔 %lu ms, 防抖 %lu ms)", s_controller.json_file_path,
+             s_controller.config.poll_interval_ms, s_controller.config.debounce_ms);
+    return ESP_OK;
+}
+
+void led_animation_watcher_stop(void) {
+    if (!s_controller.runner.alive) {
+        return;
+    }
+
+    // 唤醒任务并等待它确认退出；超时时下一次启动前继续等待
+    if (!led_file_watch_runner_stop(&s_controller.runner, WATCHER_STOP_TIMEOUT_MS)) {
+        ESP_LOGW(TAG, "等待检测任务退出超时");
+        return;
+    }
+    ESP_LOGI(TAG, "停止检测文件变化");
+}
+
+bool led_animation_watcher_is_running(void) {
+    return s_controller.runner.running;
+}
+
+esp_err_t led_animation_watcher_get_stats(led_animation_watcher_stats_t *stats) {
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&s_controller.stats_lock);
+    *stats = s_controller.stats;
+    portEXIT_CRITICAL(&s_controller.stats_lock);
+    return ESP_OK;
+}
+
+// ========== 静态函数实现 ==========
+
+// 检测任务中调用
+static void on_poll(led_file_watch_result_t result, void *user_ctx) {
+    (void)user_ctx;
+    publish_stats();
+
+    if (result == LED_FILE_WATCH_UNCHANGED) {
+        ESP_LOGI(TAG, "文件时间戳变化但内容未变，不重新加载");
+    } else if (result == LED_FILE_WATCH_CHANGED) {
+        ESP_LOGI(TAG, "动画文件内容已变化: %s", s_controller.json_file_path);
+        s_controller.config.callback(s_controller.json_file_path, s_controller.config.user_ctx);
+    }
+}
+
+// 统计由其他任务读取，复制到受锁保护的副本
+static void publish_stats(void) {
+    portENTER_CRITICAL(&s_controller.stats_lock);
+    s_controller.stats = s_controller.runner.watch.stats;
+    portEXIT_CRITICAL(&s_controller.stats_lock);
+}
+
+static bool task_spawn(void *ctx, void (*entry)(void *arg), void *arg) {
+    (void)ctx;
+    BaseType_t ret = xTaskCreate(entry, "anim_watcher", WATCHER_TASK_STACK_SIZE, arg,
+                                 WATCHER_TASK_PRIORITY, &s_controller.task_handle);
+    if (ret != pdPASS) {
+        s_controller.task_handle = NULL;
+        return false;
+    }
+    return true;
+}
+
+// 以任务通知代替延时，停止时可立即唤醒
+static bool task_wait(void *ctx, uint32_t timeout_ms) {
+    (void)ctx;
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) > 0;
+}
+
+static void task_wake(void *ctx) {
+    (void)ctx;
+    xTaskNotifyGive(s_controller.task_handle);
+}
+
+// 发出退出信号后挂起，句柄在停止者删除任务前始终有效
+static void task_exited(void *ctx) {
+    (void)ctx;
+    xSemaphoreGive(s_controller.task_exit_sem);
+    while (true) {
+        vTaskSuspend(NULL);
+    }
+}
+
+static bool task_join(void *ctx, uint32_t timeout_ms) {
+    (void)ctx;
+    if (xSemaphoreTake(s_controller.task_exit_sem, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        return false;
+    }
+    vTaskDelete(s_controller.task_handle);
+    s_controller.task_handle = NULL;
+    return true;
+}
+
+static int64_t task_now_us(void *ctx) {
+    (void)ctx;
+    return esp_timer_get_time();
+}
+
+static bool fs_is_mounted(void *ctx) {
+    (void)ctx;
+    return bsp_storage_sdcard_is_mounted();
+}
+
+static bool fs_stat(void *ctx, const char *path, uint32_t *size, uint32_t *mtime) {
+    (void)ctx;
+    struct stat file_stat;
+    if (stat(path, &file_stat) != 0) {
+        return false;
+    }
+    *size = (uint32_t)file_stat.st_size;
+    *mtime = (uint32_t)file_stat.st_mtime;
+    return true;
+}
+
+static bool fs_checksum(void *ctx, const char *path, uint32_t *crc, uint32_t *bytes_read) {
+    (void)ctx;
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    uint32_t value = 0;
+    uint32_t total = 0;
+    size_t n;
+    while ((n = fread(s_controller.crc_buffer, 1, sizeof(s_controller.crc_buffer), file)) > 0) {
+        value = esp_rom_crc32_le(value, s_controller.crc_buffer, n);
+        total += n;
+    }
+    bool failed = ferror(file);
+    fclose(file);
+
+    *bytes_read = total;
+    if (failed) {
+        return false;
+    }
+    *crc = value;
+    return true;
+}
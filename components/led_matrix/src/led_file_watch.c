@@ -0,0 +1,215 @@
+/**
+ * @file led_file_watch.c
+ * @brief 动画文件变化检测的判定逻辑实现
+ */
+
+#include "led_file_watch.h"
+#include <stddef.h>
+#include <string.h>
+
+// ========== 静态函数声明 ==========
+static led_file_fingerprint_t take_fingerprint(const led_file_watch_t *watch, const char *path);
+static bool fingerprint_equal(const led_file_fingerprint_t *a, const led_file_fingerprint_t *b);
+static bool compute_checksum(led_file_watch_t *watch, const char *path, uint32_t *crc);
+static void runner_task(void *arg);
+
+// ========== 核心接口实现 ==========
+
+bool led_file_watch_init(led_file_watch_t *watch, const char *const *paths, int count,
+                         uint32_t debounce_ms, const led_file_watch_fs_t *fs) {
+    if (!watch || !paths || count <= 0 || count > LED_FILE_WATCH_MAX_FILES ||
+        !fs || !fs->is_mounted || !fs->stat || !fs->checksum) {
+        return false;
+    }
+
+    memset(watch, 0, sizeof(*watch));
+    for (int i = 0; i < count; i++) {
+        if (!paths[i] || strlen(paths[i]) >= LED_FILE_WATCH_PATH_MAX) {
+            return false;
+        }
+        strcpy(watch->files[i].path, paths[i]);
+    }
+    watch->file_count = count;
+    watch->debounce_us = (int64_t)debounce_ms * 1000;
+    watch->fs = *fs;
+    return true;
+}
+
+void led_file_watch_baseline(led_file_watch_t *watch) {
+    if (!watch->fs.is_mounted(watch->fs.ctx)) {
+        return;
+    }
+
+    for (int i = 0; i < watch->file_count; i++) {
+        led_watched_file_t *file = &watch->files[i];
+        file->committed = take_fingerprint(watch, file->path);
+        file->pending = file->committed;
+        file->crc_valid = file->committed.exists && compute_checksum(watch, file->path, &file->crc);
+    }
+}
+
+led_file_watch_result_t led_file_watch_poll(led_file_watch_t *watch, int64_t now_us) {
+    watch->stats.polls++;
+
+    // 存储不可用（TF卡拔出）期间不比较，避免把“文件消失”当作变化
+    if (!watch->fs.is_mounted(watch->fs.ctx)) {
+        return watch->change_pending ? LED_FILE_WATCH_SETTLING : LED_FILE_WATCH_IDLE;
+    }
+
+    bool changed_now = false;
+    bool differs = false;
+    for (int i = 0; i < watch->file_count; i++) {
+        led_watched_file_t *file = &watch->files[i];
+        led_file_fingerprint_t fingerprint = take_fingerprint(watch, file->path);
+        if (!fingerprint_equal(&fingerprint, &file->pending)) {
+            file->pending = fingerprint;
+            changed_now = true;
+        }
+        if (!fingerprint_equal(&file->pending, &file->committed)) {
+            differs = true;
+        }
+    }
+
+    if (changed_now) {
+        // 文件仍在变化（例如正在复制），重新开始防抖计时
+        if (watch->change_pending) {
+            watch->stats.debounced++;
+        } else if (differs) {
+            watch->stats.changes_detected++;
+        }
+
+        watch->change_pending = differs;
+        watch->pending_since_us = now_us;
+        return differs ? LED_FILE_WATCH_SETTLING : LED_FILE_WATCH_IDLE;
+    }
+
+    if (!watch->change_pending) {
+        return LED_FILE_WATCH_IDLE;
+    }
+    if (now_us - watch->pending_since_us < watch->debounce_us) {
+        return LED_FILE_WATCH_SETTLING;
+    }
+
+    // 指纹已稳定，对变化的文件计算校验和确认内容是否变化
+    uint32_t crcs[LED_FILE_WATCH_MAX_FILES] = {0};
+    for (int i = 0; i < watch->file_count; i++) {
+        led_watched_file_t *file = &watch->files[i];
+        if (file->pending.exists && !fingerprint_equal(&file->pending, &file->committed) &&
+            !compute_checksum(watch, file->path, &crcs[i])) {
+            // 读取失败（文件可能又被改动），下次轮询重试
+            watch->pending_since_us = now_us;
+            return LED_FILE_WATCH_SETTLING;
+        }
+    }
+
+    bool content_changed = false;
+    bool any_exists = false;
+    for (int i = 0; i < watch->file_count; i++) {
+        led_watched_file_t *file = &watch->files[i];
+        any_exists |= file->pending.exists;
+        if (fingerprint_equal(&file->pending, &file->committed)) {
+            continue;
+        }
+
+        if (file->pending.exists != file->committed.exists || !file->crc_valid || crcs[i] != file->crc) {
+            content_changed = true;
+        }
+        file->committed = file->pending;
+        file->crc = crcs[i];
+        file->crc_valid = file->pending.exists;
+    }
+    watch->change_pending = false;
+
+    if (!content_changed || !any_exists) {
+        watch->stats.unchanged_content++;
+        return LED_FILE_WATCH_UNCHANGED;
+    }
+
+    watch->stats.reloads_triggered++;
+    return LED_FILE_WATCH_CHANGED;
+}
+
+// ========== 检测任务接口实现 ==========
+
+bool led_file_watch_runner_start(led_file_watch_runner_t *runner, const led_file_watch_task_ops_t *ops,
+                                 uint32_t poll_interval_ms, led_file_watch_poll_cb_t on_poll, void *user_ctx) {
+    if (!runner || !ops || !ops->spawn || !ops->wait || !ops->wake || !ops->exited ||
+        !ops->join || !ops->now_us || !on_poll) {
+        return false;
+    }
+    if (runner->alive) {
+        return false;
+    }
+
+    runner->ops = *ops;
+    runner->poll_interval_ms = poll_interval_ms;
+    runner->on_poll = on_poll;
+    runner->user_ctx = user_ctx;
+    runner->running = true;
+    runner->alive = true;
+    if (!runner->ops.spawn(runner->ops.ctx, runner_task, runner)) {
+        runner->running = false;
+        runner->alive = false;
+        return false;
+    }
+    return true;
+}
+
+bool led_file_watch_runner_stop(led_file_watch_runner_t *runner, uint32_t timeout_ms) {
+    if (!runner || !runner->alive) {
+        return true;
+    }
+
+    // 任务确认退出前不会释放，唤醒总是安全的
+    runner->running = false;
+    runner->ops.wake(runner->ops.ctx);
+    if (!runner->ops.join(runner->ops.ctx, timeout_ms)) {
+        return false;
+    }
+    runner->alive = false;
+    return true;
+}
+
+// ========== 静态函数实现 ==========
+
+static void runner_task(void *arg) {
+    led_file_watch_runner_t *runner = (led_file_watch_runner_t *)arg;
+
+    // 记录启动时的文件状态，之后只有相对于它的内容变化才报告
+    led_file_watch_baseline(&runner->watch);
+    runner->on_poll(LED_FILE_WATCH_IDLE, runner->user_ctx);
+
+    while (runner->running) {
+        runner->ops.wait(runner->ops.ctx, runner->poll_interval_ms);
+        if (!runner->running) {
+            break;
+        }
+
+        led_file_watch_result_t result = led_file_watch_poll(&runner->watch, runner->ops.now_us(runner->ops.ctx));
+        runner->on_poll(result, runner->user_ctx);
+    }
+
+    runner->ops.exited(runner->ops.ctx);
+}
+
+static led_file_fingerprint_t take_fingerprint(const led_file_watch_t *watch, const char *path) {
+    led_file_fingerprint_t fingerprint = {0};
+    fingerprint.exists = watch->fs.stat(watch->fs.ctx, path, &fingerprint.size, &fingerprint.mtime);
+    if (!fingerprint.exists) {
+        fingerprint.size = 0;
+        fingerprint.mtime = 0;
+    }
+    return fingerprint;
+}
+
+static bool fingerprint_equal(const led_file_fingerprint_t *a, const led_file_fingerprint_t *b) {
+    return a->exists == b->exists && a->size == b->size && a->mtime == b->mtime;
+}
+
+static bool compute_checksum(led_file_watch_t *watch, const char *path, uint32_t *crc) {
+    uint32_t bytes_read = 0;
+    bool ok = watch->fs.checksum(watch->fs.ctx, path, crc, &bytes_read);
+    watch->stats.crc_checks++;
+    watch->stats.bytes_read += bytes_read;
+    return ok;
+}
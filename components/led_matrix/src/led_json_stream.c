@@ -0,0 +1,560 @@
+/**
+ * @file led_json_stream.c
+ * @brief 流式JSON事件解析器实现
+ *
+ * 逐字节驱动的状态机：词法状态处理字符串/数字/字面量跨块拼接，
+ * 语法状态跟踪对象/数组嵌套，完整元素识别后立即回调。
+ */
+
+#include "led_json_stream.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+static const char *TAG = "LED_JSON_STREAM";
+
+// 语法状态
+enum {
+    PARSE_VALUE = 0,        // 期望一个值
+    PARSE_ARRAY_FIRST,      // '['之后：值或']'
+    PARSE_OBJECT_FIRST,     // '{'之后：键或'}'
+    PARSE_OBJECT_KEY,       // 对象中','之后：键
+    PARSE_COLON,            // 键之后：':'
+    PARSE_AFTER_VALUE,      // 值之后：','或容器结束
+    PARSE_DONE              // 根值已结束
+};
+
+// 词法状态
+enum {
+    LEX_NONE = 0,
+    LEX_STRING,
+    LEX_STRING_ESCAPE,
+    LEX_STRING_UNICODE,
+    LEX_NUMBER,
+    LEX_LITERAL
+};
+
+// ========== 静态函数声明 ==========
+static esp_err_t process_char(led_json_stream_t *p, char c);
+static esp_err_t begin_value(led_json_stream_t *p, char c);
+static esp_err_t end_value(led_json_stream_t *p);
+static esp_err_t close_container(led_json_stream_t *p, bool is_object);
+static esp_err_t finish_number(led_json_stream_t *p);
+static esp_err_t finish_literal(led_json_stream_t *p);
+static esp_err_t emit(led_json_stream_t *p, led_json_event_t *event);
+static esp_err_t syntax_error(led_json_stream_t *p, const char *reason);
+static void token_reset(led_json_stream_t *p);
+static void token_append(led_json_stream_t *p, char c);
+static void token_append_utf8(led_json_stream_t *p, uint32_t cp);
+static bool is_whitespace(char c);
+static bool top_is_object(const led_json_stream_t *p);
+
+// ========== 核心接口实现 ==========
+
+void led_json_stream_init(led_json_stream_t *parser, led_json_event_cb_t callback, void *user_ctx) {
+    memset(parser, 0, sizeof(*parser));
+    parser->callback = callback;
+    parser->user_ctx = user_ctx;
+    parser->state = PARSE_VALUE;
+    parser->lex = LEX_NONE;
+    parser->error = ESP_OK;
+}
+
+esp_err_t led_json_stream_feed(led_json_stream_t *parser, const char *data, size_t len) {
+    if (!parser || (!data && len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        if (parser->error != ESP_OK) {
+            return parser->error;
+        }
+        if (parser->stopped) {
+            return ESP_OK;
+        }
+        esp_err_t ret = process_char(parser, data[i]);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        parser->offset++;
+    }
+
+    return parser->error;
+}
+
+esp_err_t led_json_stream_finish(led_json_stream_t *parser) {
+    if (!parser) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (parser->error != ESP_OK || parser->stopped) {
+        return parser->error;
+    }
+
+    // 文档末尾的根数字/字面量没有终止字符
+    if (parser->lex == LEX_NUMBER) {
+        esp_err_t ret = finish_number(parser);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    if (parser->lex != LEX_NONE || parser->state != PARSE_DONE) {
+        return syntax_error(parser, "文档不完整");
+    }
+    return ESP_OK;
+}
+
+esp_err_t led_json_stream_parse_file(const char *filename, led_json_event_cb_t callback,
+                                     void *user_ctx, led_json_stream_stats_t *stats) {
+    return led_json_stream_parse_file_range(filename, 0, SIZE_MAX, callback, user_ctx, stats);
+}
+
+esp_err_t led_json_stream_parse_file_range(const char *filename, size_t offset, size_t length,
+                                           led_json_event_cb_t callback, void *user_ctx,
+                                           led_json_stream_stats_t *stats) {
+    if (!filename || !callback) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    led_json_stream_stats_t local_stats = {0};
+    size_t heap_before = esp_get_free_heap_size();
+    size_t heap_min = heap_before;
+    int64_t start_us = esp_timer_get_time();
+
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        ESP_LOGE(TAG, "无法打开文件: %s", filename);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if (offset > 0 && fseek(file, (long)offset, SEEK_SET) != 0) {
+        ESP_LOGE(TAG, "文件定位失败: %s @ %u", filename, (unsigned)offset);
+        fclose(file);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    char *chunk = malloc(LED_JSON_STREAM_CHUNK_SIZE);
+    led_json_stream_t *parser = malloc(sizeof(led_json_stream_t));
+    if (!chunk || !parser) {
+        ESP_LOGE(TAG, "无法分配解析缓冲区");
+        free(chunk);
+        free(parser);
+        fclose(file);
+        return ESP_ERR_NO_MEM;
+    }
+
+    led_json_stream_init(parser, callback, user_ctx);
+    esp_err_t ret = ESP_OK;
+
+    size_t remaining = length;
+    while (ret == ESP_OK && !parser->stopped && remaining > 0) {
+        size_t want = (remaining < LED_JSON_STREAM_CHUNK_SIZE) ? remaining : LED_JSON_STREAM_CHUNK_SIZE;
+        size_t n = fread(chunk, 1, want, file);
+        if (n == 0) {
+            if (ferror(file)) {
+                ESP_LOGE(TAG, "读取文件失败: %s", filename);
+                ret = ESP_FAIL;
+            }
+            break;
+        }
+
+        remaining -= n;
+        local_stats.bytes_read += n;
+        local_stats.chunks++;
+        ret = led_json_stream_feed(parser, chunk, n);
+
+        // 回调中的存储分配也计入峰值
+        size_t heap_now = esp_get_free_heap_size();
+        if (heap_now < heap_min) {
+            heap_min = heap_now;
+        }
+    }
+
+    if (ret == ESP_OK && !parser->stopped) {
+        ret = led_json_stream_finish(parser);
+    }
+
+    local_stats.stopped = parser->stopped;
+    local_stats.elapsed_us = esp_timer_get_time() - start_us;
+    local_stats.working_memory = sizeof(led_json_stream_t) + LED_JSON_STREAM_CHUNK_SIZE;
+    local_stats.peak_heap_used = heap_before - heap_min;
+    if (local_stats.elapsed_us > 0) {
+        local_stats.speed_kbps = (uint32_t)(((uint64_t)local_stats.bytes_read * 1000000ULL) /
+                                            ((uint64_t)local_stats.elapsed_us * 1024ULL));
+    }
+
+    free(parser);
+    free(chunk);
+    fclose(file);
+
+    if (stats) {
+        *stats = local_stats;
+    }
+    return ret;
+}
+
+// ========== 静态函数实现 ==========
+
+static esp_err_t process_char(led_json_stream_t *p, char c) {
+    switch (p->lex) {
+        case LEX_STRING:
+            if (c == '"') {
+                p->lex = LEX_NONE;
+                if (p->high_surrogate) {
+                    // 未配对的高位代理
+                    token_append_utf8(p, 0xFFFD);
+                    p->high_surrogate = 0;
+                }
+                led_json_event_t event = {
+                    .type = p->string_is_key ? LED_JSON_EVENT_KEY : LED_JSON_EVENT_STRING,
+                };
+                esp_err_t ret = emit(p, &event);
+                if (ret != ESP_OK) {
+                    return ret;
+                }
+                if (p->string_is_key) {
+                    p->state = PARSE_COLON;
+                    return ESP_OK;
+                }
+                return end_value(p);
+            }
+            if (c == '\\') {
+                p->lex = LEX_STRING_ESCAPE;
+                return ESP_OK;
+            }
+            if ((unsigned char)c < 0x20) {
+                return syntax_error(p, "字符串中包含控制字符");
+            }
+            token_append(p, c);
+            return ESP_OK;
+
+        case LEX_STRING_ESCAPE: {
+            char out;
+            switch (c) {
+                case '"':  out = '"';  break;
+                case '\\': out = '\\'; break;
+                case '/':  out = '/';  break;
+                case 'b':  out = '\b'; break;
+                case 'f':  out = '\f'; break;
+                case 'n':  out = '\n'; break;
+                case 'r':  out = '\r'; break;
+                case 't':  out = '\t'; break;
+                case 'u':
+                    p->lex = LEX_STRING_UNICODE;
+                    p->unicode = 0;
+                    p->unicode_digits = 0;
+                    return ESP_OK;
+                default:
+                    return syntax_error(p, "无效的转义字符");
+            }
+            token_append(p, out);
+            p->lex = LEX_STRING;
+            return ESP_OK;
+        }
+
+        case LEX_STRING_UNICODE: {
+            uint32_t digit;
+            if (c >= '0' && c <= '9') {
+                digit = c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                digit = c - 'a' + 10;
+            } else if (c >= 'A' && c <= 'F') {
+                digit = c - 'A' + 10;
+            } else {
+                return syntax_error(p, "无效的\\u转义");
+            }
+            p->unicode = (p->unicode << 4) | digit;
+            if (++p->unicode_digits < 4) {
+                return ESP_OK;
+            }
+
+            p->lex = LEX_STRING;
+            uint32_t cp = p->unicode;
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                if (p->high_surrogate) {
+                    token_append_utf8(p, 0xFFFD);
+                }
+                p->high_surrogate = cp;
+                return ESP_OK;
+            }
+            if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                if (p->high_surrogate) {
+                    cp = 0x10000 + ((p->high_surrogate - 0xD800) << 10) + (cp - 0xDC00);
+                    p->high_surrogate = 0;
+                } else {
+                    cp = 0xFFFD;
+                }
+            } else if (p->high_surrogate) {
+                token_append_utf8(p, 0xFFFD);
+                p->high_surrogate = 0;
+            }
+            token_append_utf8(p, cp);
+            return ESP_OK;
+        }
+
+        case LEX_NUMBER:
+            if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+                token_append(p, c);
+                return ESP_OK;
+            }
+            {
+                // 数字以非数字字符结束，该字符继续按语法处理
+                esp_err_t ret = finish_number(p);
+                if (ret != ESP_OK || p->stopped) {
+                    return ret;
+                }
+            }
+            break;
+
+        case LEX_LITERAL:
+            if (p->literal[p->literal_pos] != c) {
+                return syntax_error(p, "无效的字面量");
+            }
+            p->literal_pos++;
+            if (p->literal[p->literal_pos] == '\0') {
+                p->lex = LEX_NONE;
+                return finish_literal(p);
+            }
+            return ESP_OK;
+
+        default:
+            break;
+    }
+
+    if (is_whitespace(c)) {
+        return ESP_OK;
+    }
+
+    switch (p->state) {
+        case PARSE_VALUE:
+            return begin_value(p, c);
+
+        case PARSE_ARRAY_FIRST:
+            if (c == ']') {
+                return close_container(p, false);
+            }
+            return begin_value(p, c);
+
+        case PARSE_OBJECT_FIRST:
+            if (c == '}') {
+                return close_container(p, true);
+            }
+            // fall through
+        case PARSE_OBJECT_KEY:
+            if (c != '"') {
+                return syntax_error(p, "期望对象键");
+            }
+            p->lex = LEX_STRING;
+            p->string_is_key = true;
+            token_reset(p);
+            return ESP_OK;
+
+        case PARSE_COLON:
+            if (c != ':') {
+                return syntax_error(p, "期望':'");
+            }
+            p->state = PARSE_VALUE;
+            return ESP_OK;
+
+        case PARSE_AFTER_VALUE:
+            if (c == ',') {
+                p->state = top_is_object(p) ? PARSE_OBJECT_KEY : PARSE_VALUE;
+                return ESP_OK;
+            }
+            if (c == '}' || c == ']') {
+                bool is_object = (c == '}');
+                if (is_object != top_is_object(p)) {
+                    return syntax_error(p, "括号不匹配");
+                }
+                return close_container(p, is_object);
+            }
+            return syntax_error(p, "期望','或容器结束");
+
+        case PARSE_DONE:
+        default:
+            return syntax_error(p, "根值之后存在多余内容");
+    }
+}
+
+// 识别一个值的首字符
+static esp_err_t begin_value(led_json_stream_t *p, char c) {
+    if (c == '{' || c == '[') {
+        if (p->depth >= LED_JSON_STREAM_MAX_DEPTH) {
+            return syntax_error(p, "嵌套过深");
+        }
+        bool is_object = (c == '{');
+        led_json_event_t event = {
+            .type = is_object ? LED_JSON_EVENT_OBJECT_START : LED_JSON_EVENT_ARRAY_START,
+        };
+        esp_err_t ret = emit(p, &event);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        if (is_object) {
+            p->stack |= (1UL << p->depth);
+        } else {
+            p->stack &= ~(1UL << p->depth);
+        }
+        p->depth++;
+        p->state = is_object ? PARSE_OBJECT_FIRST : PARSE_ARRAY_FIRST;
+        return ESP_OK;
+    }
+
+    token_reset(p);
+
+    if (c == '"') {
+        p->lex = LEX_STRING;
+        p->string_is_key = false;
+        return ESP_OK;
+    }
+    if (c == '-' || (c >= '0' && c <= '9')) {
+        p->lex = LEX_NUMBER;
+        token_append(p, c);
+        return ESP_OK;
+    }
+    if (c == 't' || c == 'f' || c == 'n') {
+        p->lex = LEX_LITERAL;
+        p->literal = (c == 't') ? "true" : (c == 'f') ? "false" : "null";
+        p->literal_pos = 1;
+        return ESP_OK;
+    }
+    return syntax_error(p, "期望一个值");
+}
+
+// 一个值结束后更新语法状态
+static esp_err_t end_value(led_json_stream_t *p) {
+    p->state = (p->depth == 0) ? PARSE_DONE : PARSE_AFTER_VALUE;
+    return ESP_OK;
+}
+
+static esp_err_t close_container(led_json_stream_t *p, bool is_object) {
+    p->depth--;
+    led_json_event_t event = {
+        .type = is_object ? LED_JSON_EVENT_OBJECT_END : LED_JSON_EVENT_ARRAY_END,
+    };
+    esp_err_t ret = emit(p, &event);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return end_value(p);
+}
+
+static esp_err_t finish_number(led_json_stream_t *p) {
+    p->lex = LEX_NONE;
+    if (p->token_truncated) {
+        return syntax_error(p, "数字过长");
+    }
+
+    char *end = NULL;
+    double value = strtod(p->token, &end);
+    if (end == p->token || *end != '\0') {
+        return syntax_error(p, "无效的数字");
+    }
+
+    led_json_event_t event = {
+        .type = LED_JSON_EVENT_NUMBER,
+        .number = value,
+    };
+    esp_err_t ret = emit(p, &event);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return end_value(p);
+}
+
+static esp_err_t finish_literal(led_json_stream_t *p) {
+    led_json_event_t event = {0};
+    if (p->literal[0] == 'n') {
+        event.type = LED_JSON_EVENT_NULL;
+    } else {
+        event.type = LED_JSON_EVENT_BOOL;
+        event.boolean = (p->literal[0] == 't');
+    }
+    esp_err_t ret = emit(p, &event);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return end_value(p);
+}
+
+// 填充公共字段后回调
+static esp_err_t emit(led_json_stream_t *p, led_json_event_t *event) {
+    event->depth = p->depth;
+    event->offset = p->offset;
+    if (event->type == LED_JSON_EVENT_KEY || event->type == LED_JSON_EVENT_STRING) {
+        event->str = p->token;
+        event->len = p->token_len;
+        event->truncated = p->token_truncated;
+    }
+
+    if (!p->callback(event, p->user_ctx)) {
+        p->stopped = true;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t syntax_error(led_json_stream_t *p, const char *reason) {
+    ESP_LOGE(TAG, "JSON语法错误 (偏移 %u): %s", (unsigned)p->offset, reason);
+    p->error = ESP_ERR_INVALID_RESPONSE;
+    return p->error;
+}
+
+static void token_reset(led_json_stream_t *p) {
+    p->token_len = 0;
+    p->token_truncated = false;
+    p->token[0] = '\0';
+}
+
+static void token_append(led_json_stream_t *p, char c) {
+    if (p->token_len + 1 >= LED_JSON_STREAM_TOKEN_MAX) {
+        p->token_truncated = true;
+        return;
+    }
+    p->token[p->token_len++] = c;
+    p->token[p->token_len] = '\0';
+}
+
+static void token_append_utf8(led_json_stream_t *p, uint32_t cp) {
+    char buf[4];
+    int n;
+    if (cp < 0x80) {
+        buf[0] = (char)cp;
+        n = 1;
+    } else if (cp < 0x800) {
+        buf[0] = (char)(0xC0 | (cp >> 6));
+        buf[1] = (char)(0x80 | (cp & 0x3F));
+        n = 2;
+    } else if (cp < 0x10000) {
+        buf[0] = (char)(0xE0 | (cp >> 12));
+        buf[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        buf[2] = (char)(0x80 | (cp & 0x3F));
+        n = 3;
+    } else {
+        buf[0] = (char)(0xF0 | (cp >> 18));
+        buf[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        buf[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        buf[3] = (char)(0x80 | (cp & 0x3F));
+        n = 4;
+    }
+
+    // 多字节字符不拆开截断
+    if (p->token_len + n >= LED_JSON_STREAM_TOKEN_MAX) {
+        p->token_truncated = true;
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        token_append(p, buf[i]);
+    }
+}
+
+static bool is_whitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool top_is_object(const led_json_stream_t *p) {
+    return p->depth > 0 && (p->stack & (1UL << (p->depth - 1)));
+}
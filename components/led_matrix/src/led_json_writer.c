@@ -0,0 +1,263 @@
+/**
+ * @file led_json_writer.c
+ * @brief 流式JSON写入器实现
+ *
+ * 格式规则与cJSON的print_object/print_array相同：
+ * - 对象："{\n"，每个成员独占一行，以深度个制表符缩进，键后为":\t"，
+ *   结束时以深度减一个制表符缩进"}"
+ * - 数组：元素之间为", "，不换行
+ * - 嵌套深度对对象和数组都计数
+ */
+
+#include "led_json_writer.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "LED_JSON_WRITER";
+
+// ========== 静态函数声明 ==========
+static void write_bytes(led_json_writer_t *writer, const char *data, size_t len);
+static void write_str(led_json_writer_t *writer, const char *str);
+static void write_indent(led_json_writer_t *writer, int depth);
+static void write_escaped(led_json_writer_t *writer, const char *str);
+static void flush_buffer(led_json_writer_t *writer);
+static void begin_value(led_json_writer_t *writer);
+static void push_container(led_json_writer_t *writer, bool is_object);
+static bool pop_container(led_json_writer_t *writer, bool is_object);
+
+// ========== 核心接口实现 ==========
+
+esp_err_t led_json_writer_open(led_json_writer_t *writer, const char *filename) {
+    if (!writer || !filename) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(writer, 0, sizeof(*writer));
+    writer->start_us = esp_timer_get_time();
+
+    writer->buffer = malloc(LED_JSON_WRITER_BUFFER_SIZE);
+    if (!writer->buffer) {
+        ESP_LOGE(TAG, "无法分配写缓冲区");
+        return ESP_ERR_NO_MEM;
+    }
+
+    writer->file = fopen(filename, "w");
+    if (!writer->file) {
+        ESP_LOGE(TAG, "无法创建文件: %s", filename);
+        free(writer->buffer);
+        writer->buffer = NULL;
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+void led_json_writer_begin_object(led_json_writer_t *writer) {
+    begin_value(writer);
+    write_bytes(writer, "{\n", 2);
+    push_container(writer, true);
+}
+
+void led_json_writer_end_object(led_json_writer_t *writer) {
+    int depth = writer->depth;
+    bool has_items = depth > 0 && (writer->has_items & (1u << (depth - 1)));
+    if (!pop_container(writer, true)) {
+        return;
+    }
+
+    // 最后一个成员之后的换行
+    if (has_items) {
+        write_bytes(writer, "\n", 1);
+    }
+    write_indent(writer, depth - 1);
+    write_bytes(writer, "}", 1);
+}
+
+void led_json_writer_begin_array(led_json_writer_t *writer) {
+    begin_value(writer);
+    write_bytes(writer, "[", 1);
+    push_container(writer, false);
+}
+
+void led_json_writer_end_array(led_json_writer_t *writer) {
+    if (pop_container(writer, false)) {
+        write_bytes(writer, "]", 1);
+    }
+}
+
+void led_json_writer_key(led_json_writer_t *writer, const char *key) {
+    int depth = writer->depth;
+    if (depth == 0 || !(writer->stack & (1u << (depth - 1)))) {
+        writer->error = writer->error ? writer->error : ESP_ERR_INVALID_STATE;
+        return;
+    }
+
+    uint32_t bit = 1u << (depth - 1);
+    if (writer->has_items & bit) {
+        write_bytes(writer, ",\n", 2);
+    }
+    writer->has_items |= bit;
+
+    write_indent(writer, depth);
+    write_escaped(writer, key);
+    write_bytes(writer, ":\t", 2);
+}
+
+void led_json_writer_string(led_json_writer_t *writer, const char *value) {
+    begin_value(writer);
+    write_escaped(writer, value);
+}
+
+void led_json_writer_int(led_json_writer_t *writer, int value) {
+    char number[12];
+    int len = snprintf(number, sizeof(number), "%d", value);
+
+    begin_value(writer);
+    write_bytes(writer, number, (size_t)len);
+}
+
+esp_err_t led_json_writer_close(led_json_writer_t *writer, led_json_writer_stats_t *stats) {
+    if (!writer->file) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (writer->error == ESP_OK && writer->depth != 0) {
+        ESP_LOGE(TAG, "JSON容器未结束 (深度 %d)", writer->depth);
+        writer->error = ESP_ERR_INVALID_STATE;
+    }
+    flush_buffer(writer);
+    if (fclose(writer->file) != 0 && writer->error == ESP_OK) {
+        writer->error = ESP_FAIL;
+    }
+    writer->file = NULL;
+    free(writer->buffer);
+    writer->buffer = NULL;
+
+    if (stats) {
+        stats->bytes_written = writer->bytes_written;
+        stats->flushes = writer->flushes;
+        stats->elapsed_us = esp_timer_get_time() - writer->start_us;
+        stats->working_memory = sizeof(led_json_writer_t) + LED_JSON_WRITER_BUFFER_SIZE;
+    }
+    return writer->error;
+}
+
+// ========== 静态函数实现 ==========
+
+static void write_bytes(led_json_writer_t *writer, const char *data, size_t len) {
+    while (len > 0 && writer->error == ESP_OK) {
+        if (writer->used == LED_JSON_WRITER_BUFFER_SIZE) {
+            flush_buffer(writer);
+            continue;
+        }
+        size_t space = LED_JSON_WRITER_BUFFER_SIZE - writer->used;
+        size_t n = (len < space) ? len : space;
+        memcpy(writer->buffer + writer->used, data, n);
+        writer->used += n;
+        writer->bytes_written += n;
+        data += n;
+        len -= n;
+    }
+}
+
+static void write_str(led_json_writer_t *writer, const char *str) {
+    write_bytes(writer, str, strlen(str));
+}
+
+static void write_indent(led_json_writer_t *writer, int depth) {
+    static const char tabs[] = "\t\t\t\t\t\t\t\t";
+    while (depth > 0) {
+        int n = (depth < (int)(sizeof(tabs) - 1)) ? depth : (int)(sizeof(tabs) - 1);
+        write_bytes(writer, tabs, (size_t)n);
+        depth -= n;
+    }
+}
+
+// 与cJSON的print_string_ptr相同：只转义引号、反斜杠和控制字符，UTF-8原样输出
+static void write_escaped(led_json_writer_t *writer, const char *str) {
+    write_bytes(writer, "\"", 1);
+    if (!str) {
+        write_bytes(writer, "\"", 1);
+        return;
+    }
+
+    const char *run = str;
+    for (const unsigned char *p = (const unsigned char *)str; *p; p++) {
+        if (*p >= 32 && *p != '\"' && *p != '\\') {
+            continue;
+        }
+
+        // 先写出之前不需要转义的部分
+        write_bytes(writer, run, (size_t)((const char *)p - run));
+        run = (const char *)p + 1;
+
+        char escape[7];
+        switch (*p) {
+            case '\"': write_str(writer, "\\\""); break;
+            case '\\': write_str(writer, "\\\\"); break;
+            case '\b': write_str(writer, "\\b"); break;
+            case '\f': write_str(writer, "\\f"); break;
+            case '\n': write_str(writer, "\\n"); break;
+            case '\r': write_str(writer, "\\r"); break;
+            case '\t': write_str(writer, "\\t"); break;
+            default:
+                snprintf(escape, sizeof(escape), "\\u%04x", *p);
+                write_str(writer, escape);
+                break;
+        }
+    }
+    write_str(writer, run);
+    write_bytes(writer, "\"", 1);
+}
+
+static void flush_buffer(led_json_writer_t *writer) {
+    if (writer->used == 0 || writer->error != ESP_OK) {
+        return;
+    }
+
+    size_t n = fwrite(writer->buffer, 1, writer->used, writer->file);
+    writer->flushes++;
+    if (n != writer->used) {
+        ESP_LOGE(TAG, "写入文件失败，期望 %u 字节，实际写入 %u 字节", (unsigned)writer->used, (unsigned)n);
+        writer->error = ESP_ERR_INVALID_SIZE;
+    }
+    writer->used = 0;
+}
+
+// 数组中的第二个及之后的元素前加分隔符；对象成员的分隔符由键负责
+static void begin_value(led_json_writer_t *writer) {
+    int depth = writer->depth;
+    if (depth == 0 || (writer->stack & (1u << (depth - 1)))) {
+        return;
+    }
+
+    uint32_t bit = 1u << (depth - 1);
+    if (writer->has_items & bit) {
+        write_bytes(writer, ", ", 2);
+    }
+    writer->has_items |= bit;
+}
+
+static void push_container(led_json_writer_t *writer, bool is_object) {
+    if (writer->depth >= LED_JSON_WRITER_MAX_DEPTH) {
+        writer->error = writer->error ? writer->error : ESP_ERR_INVALID_STATE;
+        return;
+    }
+
+    uint32_t bit = 1u << writer->depth;
+    writer->stack = is_object ? (writer->stack | bit) : (writer->stack & ~bit);
+    writer->has_items &= ~bit;
+    writer->depth++;
+}
+
+static bool pop_container(led_json_writer_t *writer, bool is_object) {
+    int depth = writer->depth;
+    if (depth == 0 || (bool)(writer->stack & (1u << (depth - 1))) != is_object) {
+        writer->error = writer->error ? writer->error : ESP_ERR_INVALID_STATE;
+        return false;
+    }
+
+    writer->depth--;
+    return true;
+}
@@ -1,12 +1,12 @@
 #include "led_matrix.h"
 #include "led_animation.h"
 #include "led_color.h"
-#include "led_strip.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include <string.h>
-#include "driver/rmt_tx.h"
+#include <stdlib.h>
 #include "freertos/FreeRTOS.h"
-#include "freertos/semphr.h"
+#include "freertos/task.h"
 
 // 添加TF卡和动画相关头文件
 #include "bsp_storage.h"
@@ -14,154 +14,65 @@
 #include "led_animation_export.h"
 #include "led_animation_loader.h"
 
+// LED设备注册中心
+#include "bsp_led_hub.h"
+#include "bsp_led_rmt.h"
+
 static const char *TAG = "LED_MATRIX";
 
 // 前向声明
 static void init_animation_from_storage(void);
 
+// 矩阵注册参数
+#define MATRIX_LOCK_TIMEOUT_MS      100     // 刷新等待帧缓冲区的超时（较短超时避免动画卡顿）
+
 // 矩阵LED数据
-static led_strip_handle_t led_strip;
 static uint8_t led_grid[LED_MATRIX_HEIGHT][LED_MATRIX_WIDTH][3]; // RGB网格
 static bool matrix_enabled = true;
 
-// 添加互斥锁保护LED strip访问
-static SemaphoreHandle_t led_strip_mutex = NULL;
-
-// 强制重置RMT系统
-static esp_err_t led_matrix_force_reset_rmt(void) {
-    ESP_LOGI(TAG, "强制重置RMT系统...");
-    
-    // 如果已存在句柄，强制删除
-    if (led_strip != NULL) {
-        ESP_LOGI(TAG, "强制删除现有LED strip句柄");
-        // 忽略删除错误，强制设为NULL
-        led_strip_del(led_strip);
-        led_strip = NULL;
-    }
-    
-    // 长延迟确保RMT硬件完全重置
-    vTaskDelay(500 / portTICK_PERIOD_MS);
-    
-    return ESP_OK;
-}
+// RMT后端上下文 - 使用保守的设置：不使用DMA，显式设置内存块大小。
+// 创建后不再等待，通道是否可用由打开时的清除操作验证，失败由LED设备层在后台重建。
+static bsp_led_rmt_ctx_t matrix_rmt_ctx = {
+    .gpio_num = LED_MATRIX_GPIO_PIN,
+    .with_dma = false,
+    .mem_block_symbols = 64,
+};
 
-// 重置RMT系统
-static esp_err_t led_matrix_reset_rmt(void) {
-    ESP_LOGI(TAG, "重置RMT系统...");
-    
-    // 如果已存在句柄，先删除
-    if (led_strip != NULL) {
-        ESP_LOGI(TAG, "删除现有LED strip句柄");
-        esp_err_t del_ret = led_strip_del(led_strip);
-        if (del_ret != ESP_OK) {
-            ESP_LOGW(TAG, "删除LED strip失败: %s", esp_err_to_name(del_ret));
-        }
-        led_strip = NULL;
-        
-        // 延迟确保硬件完全释放
-        vTaskDelay(200 / portTICK_PERIOD_MS);
+// 初始化LED矩阵
+void led_matrix_init(void) {
+    if (led_matrix_init_hardware() != ESP_OK) {
+        return;
     }
     
-    return ESP_OK;
-}
-
-// 强健的LED strip创建函数，支持重试
-static esp_err_t led_matrix_create_strip_robust(void) {
-    const int MAX_RETRIES = 5;
-    esp_err_t ret = ESP_FAIL;
+    // 初始化动画系统
+    led_animation_init();
     
-    for (int attempt = 0; attempt < MAX_RETRIES; attempt++) {
-        ESP_LOGI(TAG, "尝试创建LED strip (第%d次)...", attempt + 1);
-        
-        // 如果不是第一次尝试，执行强制重置
-        if (attempt > 0) {
-            ESP_LOGI(TAG, "执行强制RMT重置...");
-            led_matrix_force_reset_rmt();
-        }
-        
-        // 配置LED带
-        led_strip_config_t strip_config = {
-            .strip_gpio_num = LED_MATRIX_GPIO_PIN,
-            .max_leds = LED_MATRIX_NUM_LEDS,
-            .led_model = LED_MODEL_WS2812,
-        };
-        
-        // 配置RMT - 使用更保守的设置
-        led_strip_rmt_config_t rmt_config = {
-            .clk_src = RMT_CLK_SRC_DEFAULT,
-            .resolution_hz = 10 * 1000 * 1000, // 10MHz
-            .flags.with_dma = false,
-            .mem_block_symbols = 64, // 显式设置内存块大小
-        };
-        
-        // 创建LED带设备
-        ret = led_strip_new_rmt_device(&strip_config, &rmt_config, &led_strip);
-        if (ret == ESP_OK) {
-            ESP_LOGI(TAG, "LED strip创建成功");
-            
-            // 给RMT驱动充足时间来完全初始化
-            vTaskDelay(200 / portTICK_PERIOD_MS);
-            
-            // 简化测试：只尝试一次基本操作
-            esp_err_t test_ret = led_strip_clear(led_strip);
-            if (test_ret == ESP_OK) {
-                ESP_LOGI(TAG, "LED strip基本功能测试通过");
-                return ESP_OK;
-            } else {
-                ESP_LOGW(TAG, "LED strip清除测试失败: %s", esp_err_to_name(test_ret));
-                // 测试失败，删除并重试
-                led_strip_del(led_strip);
-                led_strip = NULL;
-            }
-        } else {
-            ESP_LOGW(TAG, "创建LED strip失败: %s", esp_err_to_name(ret));
-        }
-        
-        // 重试前等待
-        if (attempt < MAX_RETRIES - 1) {
-            int delay_ms = (attempt + 1) * 1000; // 递增延迟
-            ESP_LOGI(TAG, "等待%dms后重试...", delay_ms);
-            vTaskDelay(delay_ms / portTICK_PERIOD_MS);
-        }
-    }
+    // 初始化动画数据（从TF卡加载或使用示例）
+    init_animation_from_storage();
     
-    ESP_LOGE(TAG, "LED strip创建失败，已尝试%d次", MAX_RETRIES);
-    return ret;
+    ESP_LOGI(TAG, "LED矩阵初始化完成");
 }
 
-// 初始化LED矩阵
-void led_matrix_init(void) {
+// 初始化LED矩阵硬件（注册到LED设备注册中心，失败时由后台恢复，不阻塞调用者）
+esp_err_t led_matrix_init_hardware(void) {
     ESP_LOGI(TAG, "初始化LED矩阵 (%dx%d)", LED_MATRIX_WIDTH, LED_MATRIX_HEIGHT);
     
-    // 创建互斥锁
-    if (led_strip_mutex == NULL) {
-        led_strip_mutex = xSemaphoreCreateMutex();
-        if (led_strip_mutex == NULL) {
-            ESP_LOGE(TAG, "创建LED strip互斥锁失败");
-            return;
-        }
-    }
-    
     // 暂时禁用矩阵更新，防止动画任务干扰初始化
     matrix_enabled = false;
     
-    // 确保led_strip句柄为空，避免重复初始化
-    if (led_strip != NULL) {
+    // 已注册时先注销，重新创建灯带
+    if (bsp_led_hub_is_registered(BSP_LED_DEVICE_MATRIX)) {
         ESP_LOGW(TAG, "LED矩阵已经初始化，执行强制重新初始化");
-        led_matrix_force_reset_rmt(); // 使用强制重置
-    } else {
-        // 即使没有现有句柄，也进行强制重置确保RMT干净状态
-        ESP_LOGI(TAG, "执行预防性RMT重置");
-        vTaskDelay(500 / portTICK_PERIOD_MS);
+        bsp_led_hub_unregister(BSP_LED_DEVICE_MATRIX);
     }
     
     ESP_LOGI(TAG, "正在配置GPIO %d 用于LED矩阵...", LED_MATRIX_GPIO_PIN);
     
-    // 强健的LED strip创建
-    esp_err_t ret = led_matrix_create_strip_robust();
+    bsp_led_device_config_t config = bsp_led_device_get_default_config("matrix", LED_MATRIX_NUM_LEDS);
+    esp_err_t ret = bsp_led_hub_register(BSP_LED_DEVICE_MATRIX, &config, &BSP_LED_RMT_BACKEND, &matrix_rmt_ctx);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "LED矩阵初始化失败，无法创建LED strip");
-        return;
+        ESP_LOGE(TAG, "LED矩阵初始化失败，无法注册LED设备: %s", esp_err_to_name(ret));
+        return ret;
     }
     
     // 清空网格数据
@@ -170,70 +81,8 @@ void led_matrix_init(void) {
     // 重新启用矩阵更新
     matrix_enabled = true;
     
-    // 初始化动画系统
-    led_animation_init();
-    
-    // 初始化动画数据（从TF卡加载或使用示例）
-    init_animation_from_storage();
-    
-    ESP_LOGI(TAG, "LED矩阵初始化完成");
-}
-
-// 带重试和互斥锁保护的LED strip操作
-static esp_err_t led_strip_operation_with_retry(const char* operation_name, 
-                                                 esp_err_t (*operation)(led_strip_handle_t), 
-                                                 int max_retries) {
-    if (led_strip == NULL) {
-        ESP_LOGE(TAG, "%s失败: LED strip未初始化", operation_name);
-        return ESP_ERR_INVALID_STATE;
-    }
-    
-    if (led_strip_mutex == NULL) {
-        ESP_LOGE(TAG, "%s失败: 互斥锁未初始化", operation_name);
-        return ESP_ERR_INVALID_STATE;
-    }
-    
-    // 获取互斥锁，超时500ms
-    if (xSemaphoreTake(led_strip_mutex, pdMS_TO_TICKS(500)) != pdTRUE) {
-        ESP_LOGE(TAG, "%s失败: 无法获取互斥锁", operation_name);
-        return ESP_ERR_TIMEOUT;
-    }
-    
-    esp_err_t ret = ESP_FAIL;
-    for (int attempt = 0; attempt < max_retries; attempt++) {
-        ret = operation(led_strip);
-        if (ret == ESP_OK) {
-            if (attempt > 0) {
-                ESP_LOGI(TAG, "%s在第%d次重试后成功", operation_name, attempt + 1);
-            }
-            xSemaphoreGive(led_strip_mutex);
-            return ESP_OK;
-        }
-        
-        ESP_LOGW(TAG, "%s失败 (尝试%d/%d): %s", operation_name, attempt + 1, max_retries, esp_err_to_name(ret));
-        
-        // 如果是RMT通道状态错误，尝试重新初始化
-        if (ret == ESP_ERR_INVALID_STATE && attempt < max_retries - 1) {
-            ESP_LOGW(TAG, "检测到RMT状态错误，尝试重新初始化LED strip...");
-            
-            // 重新初始化（在互斥锁保护下）
-            led_matrix_reset_rmt();
-            esp_err_t reinit_ret = led_matrix_create_strip_robust();
-            if (reinit_ret != ESP_OK) {
-                ESP_LOGE(TAG, "重新初始化LED strip失败");
-                break;
-            }
-            
-            ESP_LOGI(TAG, "LED strip重新初始化成功，继续重试操作");
-        } else if (attempt < max_retries - 1) {
-            // 其他错误，简单延迟后重试
-            vTaskDelay(50 / portTICK_PERIOD_MS);
-        }
-    }
-    
-    ESP_LOGE(TAG, "%s最终失败: %s", operation_name, esp_err_to_name(ret));
-    xSemaphoreGive(led_strip_mutex);
-    return ret;
+    ESP_LOGI(TAG, "LED矩阵硬件初始化完成");
+    return ESP_OK;
 }
 
 // 清除所有LED
@@ -242,16 +91,15 @@ void led_matrix_clear(void) {
     memset(led_grid, 0, sizeof(led_grid));
     
     // 检查LED带是否已初始化
-    if (led_strip == NULL) {
+    if (!bsp_led_hub_is_registered(BSP_LED_DEVICE_MATRIX)) {
         ESP_LOGW(TAG, "LED矩阵未初始化，跳过清除操作");
         return;
     }
     
-    // 带重试的清除操作
-    esp_err_t ret = led_strip_operation_with_retry("LED strip清除", led_strip_clear, 3);
-    if (ret == ESP_OK) {
-        // 只有clear成功才尝试refresh
-        led_strip_operation_with_retry("LED strip刷新", led_strip_refresh, 3);
+    // 输出失败时设备层会重建灯带并重试
+    esp_err_t ret = bsp_led_hub_clear(BSP_LED_DEVICE_MATRIX);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "LED strip清除失败: %s", esp_err_to_name(ret));
     }
 }
 
@@ -289,64 +137,60 @@ void led_matrix_refresh(void) {
         return;
     }
     
-    // 检查LED带是否已初始化
-    if (led_strip == NULL) {
-        ESP_LOGE(TAG, "LED矩阵未初始化，无法刷新");
+    // 获取帧缓冲区
+    bsp_led_rgb_t *pixels = NULL;
+    uint16_t count = 0;
+    esp_err_t ret = bsp_led_hub_lock(BSP_LED_DEVICE_MATRIX, MATRIX_LOCK_TIMEOUT_MS, &pixels, &count);
+    if (ret == ESP_ERR_TIMEOUT) {
+        ESP_LOGW(TAG, "LED矩阵刷新：无法获取帧缓冲区，跳过本次刷新");
         return;
-    }
-    
-    // 检查互斥锁
-    if (led_strip_mutex == NULL) {
-        ESP_LOGE(TAG, "LED strip互斥锁未初始化，无法刷新");
-        return;
-    }
-    
-    // 获取互斥锁，超时100ms（较短超时避免动画卡顿）
-    if (xSemaphoreTake(led_strip_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        ESP_LOGW(TAG, "LED矩阵刷新：无法获取互斥锁，跳过本次刷新");
+    } else if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "LED矩阵未初始化，无法刷新");
         return;
     }
     
-    // 将网格数据映射到LED带上
-    bool pixel_error = false;
-    for (int y = 0; y < LED_MATRIX_HEIGHT && !pixel_error; y++) {
-        for (int x = 0; x < LED_MATRIX_WIDTH && !pixel_error; x++) {
+    // 将网格数据映射到帧缓冲区，画面未变化时设备层跳过输出
+    bool modified = false;
+    for (int y = 0; y < LED_MATRIX_HEIGHT; y++) {
+        for (int x = 0; x < LED_MATRIX_WIDTH; x++) {
             int led_index = y * LED_MATRIX_WIDTH + x; // 简单的行优先布局
             
             // 应用颜色校准
             rgb_t color = color_correct(led_grid[y][x][0], led_grid[y][x][1], led_grid[y][x][2]);
             
-            // 设置LED像素
-            esp_err_t ret = led_strip_set_pixel(led_strip, led_index, color.r, color.g, color.b);
-            if (ret != ESP_OK) {
-                ESP_LOGW(TAG, "设置像素 [%d,%d] (LED %d) 失败: %s", x, y, led_index, esp_err_to_name(ret));
-                pixel_error = true;
+            bsp_led_rgb_t *p = &pixels[led_index];
+            if (p->r != color.r || p->g != color.g || p->b != color.b) {
+                p->r = color.r;
+                p->g = color.g;
+                p->b = color.b;
+                modified = true;
             }
         }
     }
     
-    // 如果像素设置成功，尝试刷新
-    if (!pixel_error) {
-        esp_err_t ret = led_strip_refresh(led_strip);
-        if (ret != ESP_OK) {
-            ESP_LOGW(TAG, "LED矩阵刷新失败: %s", esp_err_to_name(ret));
-        }
+    // 故障期间（ESP_ERR_INVALID_STATE）帧保留在帧缓冲区，恢复后补发，不逐帧告警
+    ret = bsp_led_hub_unlock(BSP_LED_DEVICE_MATRIX, modified);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGW(TAG, "LED矩阵刷新失败: %s", esp_err_to_name(ret));
     }
-    
-    // 释放互斥锁
-    xSemaphoreGive(led_strip_mutex);
 }
 
 // 填充全部
 void led_matrix_fill(uint8_t r, uint8_t g, uint8_t b) {
-    // 填充网格
-    for (int y = 0; y < LED_MATRIX_HEIGHT; y++) {
-        for (int x = 0; x < LED_MATRIX_WIDTH; x++) {
-            led_grid[y][x][0] = r;
-            led_grid[y][x][1] = g;
-            led_grid[y][x][2] = b;
-        }
+    led_blit_surface_t surface;
+    led_matrix_get_surface(&surface);
+    led_blit_fill_rect(&surface, 0, 0, LED_MATRIX_WIDTH, LED_MATRIX_HEIGHT, r, g, b);
+}
+
+// 获取显示网格的绘制表面
+void led_matrix_get_surface(led_blit_surface_t *surface) {
+    if (surface == NULL) {
+        return;
     }
+    surface->pixels = &led_grid[0][0][0];
+    surface->mask = NULL;
+    surface->width = LED_MATRIX_WIDTH;
+    surface->height = LED_MATRIX_HEIGHT;
 }
 
 // 动画更新（将在动画模块中实现的包装器）
@@ -362,8 +206,7 @@ void led_matrix_set_enabled(bool enabled) {
     
     // 如果禁用，立即清空矩阵
     if (!enabled) {
-        led_strip_clear(led_strip);
-        led_strip_refresh(led_strip);
+        bsp_led_hub_clear(BSP_LED_DEVICE_MATRIX);
     }
 }
 
@@ -378,13 +221,12 @@ void led_matrix_test(void) {
     
     // 测试1：依次点亮白色
     for (int i = 0; i < LED_MATRIX_NUM_LEDS; i++) {
-        led_strip_set_pixel(led_strip, i, 64, 64, 64); // 白色
-        led_strip_refresh(led_strip);
+        bsp_led_hub_set_pixel(BSP_LED_DEVICE_MATRIX, i, (bsp_led_rgb_t){64, 64, 64}); // 白色
+        bsp_led_hub_refresh(BSP_LED_DEVICE_MATRIX);
         vTaskDelay(1 / portTICK_PERIOD_MS);
     }
     vTaskDelay(500 / portTICK_PERIOD_MS);
-    led_strip_clear(led_strip);
-    led_strip_refresh(led_strip);
+    bsp_led_hub_clear(BSP_LED_DEVICE_MATRIX);
     
     // 测试2：红绿蓝测试
     led_matrix_fill(64, 0, 0); // 红色
@@ -404,6 +246,71 @@ void led_matrix_test(void) {
     ESP_LOGI(TAG, "LED矩阵测试完成");
 }
 
+// 块传输引擎性能测试
+void led_matrix_blit_benchmark(void) {
+    const int iterations = 100;
+    ESP_LOGI(TAG, "运行块传输引擎性能测试 (%d次迭代)", iterations);
+    
+    // 备份当前网格，测试结束后恢复
+    uint8_t *backup = malloc(sizeof(led_grid));
+    if (backup == NULL) {
+        ESP_LOGE(TAG, "分配测试备份缓冲区失败");
+        return;
+    }
+    memcpy(backup, led_grid, sizeof(led_grid));
+    
+    led_blit_surface_t surface;
+    led_matrix_get_surface(&surface);
+    
+    // 测试1：全屏填充
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < iterations; i++) {
+        for (int y = 0; y < LED_MATRIX_HEIGHT; y++) {
+            for (int x = 0; x < LED_MATRIX_WIDTH; x++) {
+                led_matrix_set_pixel(x, y, (uint8_t)i, 32, 64);
+            }
+        }
+    }
+    int64_t pixel_fill_us = esp_timer_get_time() - start;
+    
+    start = esp_timer_get_time();
+    for (int i = 0; i < iterations; i++) {
+        led_blit_fill_rect(&surface, 0, 0, LED_MATRIX_WIDTH, LED_MATRIX_HEIGHT, (uint8_t)i, 32, 64);
+    }
+    int64_t blit_fill_us = esp_timer_get_time() - start;
+    
+    // 测试2：16x16 RGB精灵绘制
+    static uint8_t sprite[16 * 16 * 3];
+    for (int i = 0; i < (int)sizeof(sprite); i++) {
+        sprite[i] = (uint8_t)i;
+    }
+    
+    start = esp_timer_get_time();
+    for (int i = 0; i < iterations; i++) {
+        for (int y = 0; y < 16; y++) {
+            for (int x = 0; x < 16; x++) {
+                const uint8_t *p = &sprite[(y * 16 + x) * 3];
+                led_matrix_set_pixel(8 + x, 8 + y, p[0], p[1], p[2]);
+            }
+        }
+    }
+    int64_t pixel_sprite_us = esp_timer_get_time() - start;
+    
+    start = esp_timer_get_time();
+    for (int i = 0; i < iterations; i++) {
+        led_blit_rgb_sprite(&surface, 8, 8, sprite, 16, 16, NULL);
+    }
+    int64_t blit_sprite_us = esp_timer_get_time() - start;
+    
+    memcpy(led_grid, backup, sizeof(led_grid));
+    free(backup);
+    
+    ESP_LOGI(TAG, "全屏填充: 逐像素 %lld us, 块传输 %lld us (每次)", 
+             pixel_fill_us / iterations, blit_fill_us / iterations);
+    ESP_LOGI(TAG, "16x16精灵: 逐像素 %lld us, 块传输 %lld us (每次)", 
+             pixel_sprite_us / iterations, blit_sprite_us / iterations);
+}
+
 // 从存储设备初始化动画数据
 static void init_animation_from_storage(void) {
     ESP_LOGI(TAG, "开始初始化动画数据");
@@ -446,9 +353,8 @@ static void init_animation_from_storage(void) {
 
 // 析构LED矩阵
 void led_matrix_deinit(void) {
-    if (led_strip != NULL) {
+    if (bsp_led_hub_is_registered(BSP_LED_DEVICE_MATRIX)) {
         ESP_LOGI(TAG, "清理LED矩阵资源...");
-        led_strip_del(led_strip);
-        led_strip = NULL;
+        bsp_led_hub_unregister(BSP_LED_DEVICE_MATRIX);
     }
 }
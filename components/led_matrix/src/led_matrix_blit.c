@@ -0,0 +1,213 @@
+/**
+ * @file led_matrix_blit.c
+ * @brief LED Matrix 矩形/扫描线/精灵块传输引擎实现
+ *
+ * 所有绘制先裁剪到表面范围，再按行操作：
+ * 灰度颜色直接memset，其余颜色先写入首像素再倍增memcpy填满整行，
+ * 后续行从首行memcpy；掩码平面按行memset。
+ */
+
+#include "led_matrix_blit.h"
+#include <string.h>
+
+// ========== 静态函数声明 ==========
+static bool clip_span(const led_blit_surface_t *dst, int *x, int y, int *len, int *skip);
+static void fill_row(uint8_t *row, int len, uint8_t r, uint8_t g, uint8_t b);
+
+// ========== 核心接口实现 ==========
+
+void led_blit_pixel(const led_blit_surface_t *dst, int x, int y, uint8_t r, uint8_t g, uint8_t b) {
+    if (!dst || x < 0 || x >= dst->width || y < 0 || y >= dst->height) {
+        return;
+    }
+
+    int index = y * dst->width + x;
+    uint8_t *p = dst->pixels + index * 3;
+    p[0] = r;
+    p[1] = g;
+    p[2] = b;
+    if (dst->mask) {
+        dst->mask[index] = 1;
+    }
+}
+
+void led_blit_fill_rect(const led_blit_surface_t *dst, int x, int y, int w, int h,
+                        uint8_t r, uint8_t g, uint8_t b) {
+    if (!dst || w <= 0 || h <= 0) {
+        return;
+    }
+
+    // 裁剪矩形
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > dst->width) { w = dst->width - x; }
+    if (y + h > dst->height) { h = dst->height - y; }
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    size_t row_stride = (size_t)dst->width * 3;
+    size_t row_bytes = (size_t)w * 3;
+    uint8_t *first = dst->pixels + (size_t)y * row_stride + (size_t)x * 3;
+
+    // 首行填充，其余行从首行拷贝
+    fill_row(first, w, r, g, b);
+    uint8_t *p = first + row_stride;
+    for (int row = 1; row < h; row++, p += row_stride) {
+        memcpy(p, first, row_bytes);
+    }
+
+    if (dst->mask) {
+        uint8_t *m = dst->mask + (size_t)y * dst->width + x;
+        if (w == dst->width) {
+            memset(m, 1, (size_t)w * h);
+        } else {
+            for (int row = 0; row < h; row++, m += dst->width) {
+                memset(m, 1, (size_t)w);
+            }
+        }
+    }
+}
+
+void led_blit_hspan(const led_blit_surface_t *dst, int x, int y, int len,
+                    uint8_t r, uint8_t g, uint8_t b) {
+    int skip;
+    if (!clip_span(dst, &x, y, &len, &skip)) {
+        return;
+    }
+
+    size_t index = (size_t)y * dst->width + x;
+    fill_row(dst->pixels + index * 3, len, r, g, b);
+    if (dst->mask) {
+        memset(dst->mask + index, 1, (size_t)len);
+    }
+}
+
+void led_blit_rgb_span(const led_blit_surface_t *dst, int x, int y, const uint8_t *rgb, int len) {
+    int skip;
+    if (!rgb || !clip_span(dst, &x, y, &len, &skip)) {
+        return;
+    }
+
+    size_t index = (size_t)y * dst->width + x;
+    memcpy(dst->pixels + index * 3, rgb + (size_t)skip * 3, (size_t)len * 3);
+    if (dst->mask) {
+        memset(dst->mask + index, 1, (size_t)len);
+    }
+}
+
+void led_blit_mask_sprite(const led_blit_surface_t *dst, int x, int y,
+                          const uint8_t *bits, int w, int h,
+                          uint8_t r, uint8_t g, uint8_t b) {
+    if (!dst || !bits || w <= 0 || h <= 0) {
+        return;
+    }
+
+    int bits_stride = (w + 7) / 8;
+    for (int row = 0; row < h; row++) {
+        int dy = y + row;
+        if (dy < 0 || dy >= dst->height) {
+            continue;
+        }
+
+        const uint8_t *src = bits + (size_t)row * bits_stride;
+        int col = 0;
+        while (col < w) {
+            // 跳过整字节的空白
+            if ((col & 7) == 0 && src[col >> 3] == 0) {
+                col += 8;
+                continue;
+            }
+            if (!(src[col >> 3] & (0x80 >> (col & 7)))) {
+                col++;
+                continue;
+            }
+
+            // 合并连续置位像素为一条扫描线
+            int run_start = col;
+            while (col < w && (src[col >> 3] & (0x80 >> (col & 7)))) {
+                col++;
+            }
+            led_blit_hspan(dst, x + run_start, dy, col - run_start, r, g, b);
+        }
+    }
+}
+
+void led_blit_rgb_sprite(const led_blit_surface_t *dst, int x, int y,
+                         const uint8_t *rgb, int w, int h, const rgb_t *color_key) {
+    if (!dst || !rgb || w <= 0 || h <= 0) {
+        return;
+    }
+
+    size_t src_stride = (size_t)w * 3;
+    for (int row = 0; row < h; row++) {
+        const uint8_t *src = rgb + (size_t)row * src_stride;
+
+        if (!color_key) {
+            led_blit_rgb_span(dst, x, y + row, src, w);
+            continue;
+        }
+
+        // 带透明色：非透明像素的连续区段按段拷贝
+        int col = 0;
+        while (col < w) {
+            const uint8_t *p = src + col * 3;
+            if (p[0] == color_key->r && p[1] == color_key->g && p[2] == color_key->b) {
+                col++;
+                continue;
+            }
+
+            int run_start = col;
+            while (col < w) {
+                p = src + col * 3;
+                if (p[0] == color_key->r && p[1] == color_key->g && p[2] == color_key->b) {
+                    break;
+                }
+                col++;
+            }
+            led_blit_rgb_span(dst, x + run_start, y + row, src + run_start * 3, col - run_start);
+        }
+    }
+}
+
+// ========== 静态函数实现 ==========
+
+// 裁剪水平区段，返回false表示完全不可见；skip为左侧被裁掉的像素数
+static bool clip_span(const led_blit_surface_t *dst, int *x, int y, int *len, int *skip) {
+    *skip = 0;
+    if (!dst || *len <= 0 || y < 0 || y >= dst->height) {
+        return false;
+    }
+
+    if (*x < 0) {
+        *skip = -*x;
+        *len += *x;
+        *x = 0;
+    }
+    if (*x + *len > dst->width) {
+        *len = dst->width - *x;
+    }
+    return *len > 0;
+}
+
+// 用单一颜色填充一行像素
+static void fill_row(uint8_t *row, int len, uint8_t r, uint8_t g, uint8_t b) {
+    size_t total = (size_t)len * 3;
+
+    // 灰度颜色（含黑色）直接memset
+    if (r == g && g == b) {
+        memset(row, r, total);
+        return;
+    }
+
+    // 写入首像素后倍增拷贝
+    row[0] = r;
+    row[1] = g;
+    row[2] = b;
+    size_t filled = 3;
+    while (filled < total) {
+        size_t chunk = (filled < total - filled) ? filled : (total - filled);
+        memcpy(row + filled, row, chunk);
+        filled += chunk;
+    }
+}
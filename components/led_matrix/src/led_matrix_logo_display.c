@@ -10,15 +10,24 @@
 #include "led_matrix.h"
 #include "led_animation.h"
 #include "led_animation_loader.h"
+#include "led_animation_demo.h"
+#include "led_animation_export.h"
+#include "led_animation_binary.h"
+#include "led_animation_cache.h"
+#include "led_animation_reload.h"
+#include "led_animation_watcher.h"
 #include "bsp_storage.h"
+#include "bsp_led_governor.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "esp_random.h"
+#include "led_playlist.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
 
 static const char *TAG = "LED_LOGO_DISPLAY";
 
@@ -28,6 +37,13 @@ static const char *TAG = "LED_LOGO_DISPLAY";
 #define DEFAULT_BRIGHTNESS              128     // 中等亮度
 #define DEFAULT_JSON_FILE_PATH          "/sdcard/matrix.json"
 #define MAX_LOGO_COUNT                  10      // 最大Logo数量
+#define DEFAULT_TRANSITION_MS           400     // 切换过渡时长
+#define MIN_VALID_YEAR                  2024    // 早于该年份说明系统时间尚未设置
+#define DEFAULT_PLACEHOLDER_NAME        "启动中" // 后台加载期间显示的内置动画
+#define BOOT_TASK_STACK_SIZE            4096
+#define BOOT_TASK_PRIORITY              2       // 低于网络任务，不影响其他启动流程
+#define DECODER_TASK_STACK_SIZE         4096
+#define DECODER_TASK_PRIORITY           1       // 按需解码和预取在空闲时进行
 
 // Logo显示控制器状态
 typedef struct {
@@ -35,14 +51,36 @@ typedef struct {
     logo_display_status_t status;              // 状态
     bool is_initialized;                       // 是否已初始化
     bool is_paused;                           // 是否已暂停
+    bool hardware_ready;                      // LED矩阵硬件和TF卡已在后台任务中准备好
+    TaskHandle_t boot_task;                   // 首次启动的后台任务
+    volatile bool boot_cancelled;             // 后台准备期间调用了停止，完成后不再启动显示
     
     esp_timer_handle_t switch_timer;          // 切换定时器
     esp_timer_handle_t animation_timer;       // 动画更新定时器
+    esp_timer_handle_t reload_timer;          // 热更新的Logo映射重建后在定时器上下文中切换到首个Logo
+    volatile bool reload_pending;             // 正在发布新动画库或等待切换到首个Logo
     SemaphoreHandle_t status_mutex;           // 状态互斥锁
+
+    TaskHandle_t decoder_task;                // 按需解码任务（定时器回调中不读取TF卡）
+    SemaphoreHandle_t decode_mutex;           // 串行化按需解码和Logo重新加载
+    led_animation_bank_t *lazy_bank;          // 按需解码写入的动画库（控制器持有引用）
+    volatile int32_t decode_request;          // 请求解码的Logo索引，-1表示无
+    volatile int32_t pending_logo;            // 解码完成后立即切换的Logo索引，-1表示无
     
     char json_file_path[256];                 // JSON文件路径
-    uint32_t logo_animations[MAX_LOGO_COUNT]; // Logo动画索引数组
+    int32_t logo_animations[MAX_LOGO_COUNT];  // Logo对应的动画槽位，-1表示尚未解码
     uint32_t logo_count;                      // 实际Logo数量
+    bool lazy_decode;                         // 按需解码（使用文件偏移索引）
+    animation_file_index_t file_index;        // JSON文件中各动画的偏移索引
+    led_animation_cache_key_t cache_key;      // 按需解码开始时JSON的缓存键
+    bool cache_pending;                       // 全部Logo解码完成后写入启动缓存
+    int64_t decode_us;                        // 建立索引和按需解码累计耗时
+
+    uint8_t *transition_from;                 // 过渡开始时的旧画面（首次过渡时分配）
+    int64_t transition_start_us;              // 过渡开始时间
+    volatile bool transition_active;          // 正在播放切换过渡
+
+    led_playlist_t playlist;                  // 各Logo的权重、时长和时间窗口
 } logo_display_controller_t;
 
 // 全局控制器实例
@@ -51,9 +89,35 @@ static logo_display_controller_t s_controller = {0};
 // ========== 静态函数声明 ==========
 static void switch_timer_callback(void* arg);
 static void animation_timer_callback(void* arg);
+static void reload_timer_callback(void* arg);
+static esp_err_t reload_publish(led_animation_bank_t* bank, void* user_ctx);
+static void reload_done_callback(esp_err_t result, void* user_ctx);
+static void file_changed_callback(const char* json_file_path, void* user_ctx);
+static esp_err_t schedule_animation_frame(uint32_t delay_ms);
+static void boot_task(void* arg);
+static void decoder_task(void* arg);
+static void request_decode(int32_t logo_index);
+static void set_lazy_bank(led_animation_bank_t* bank);
+static void show_placeholder(void);
+static void prepare_storage(void);
+static esp_err_t start_display(void);
+static void render_frame(void);
+static void begin_transition(void);
+static uint32_t get_next_frame_interval(void);
 static esp_err_t load_logos_from_json(void);
+static esp_err_t load_logos_locked(void);
+static void map_all_logos(void);
+static void store_decoded_cache(led_animation_bank_t* bank);
 static esp_err_t switch_to_logo_internal(uint32_t logo_index);
+static esp_err_t decode_and_switch(uint32_t logo_index);
+static esp_err_t ensure_logo_decoded(uint32_t logo_index);
+static void prefetch_next_logo(void);
 static uint32_t get_next_logo_index(void);
+static uint32_t get_first_logo_index(void);
+static bool is_auto_switch_mode(void);
+static esp_err_t start_switch_timer(void);
+static uint32_t get_logo_duration(uint32_t logo_index);
+static int get_minute_of_day(void);
 static uint32_t get_previous_logo_index(void);
 static uint32_t get_time_ms(void);
 static void update_next_switch_time(void);
@@ -67,9 +131,7 @@ esp_err_t led_matrix_logo_display_init(const logo_display_config_t* config) {
         return ESP_OK;
     }
 
-    // 确保LED Matrix基础硬件已经初始化
-    ESP_LOGI(TAG, "确保LED Matrix基础硬件已经初始化");
-    led_matrix_init();  // 确保基础硬件初始化
+    // LED Matrix硬件初始化和TF卡挂载耗时较长，在启动显示时交给后台任务
     led_animation_init();  // 确保动画系统初始化
 
     // 使用默认配置或用户配置
@@ -86,6 +148,15 @@ esp_err_t led_matrix_logo_display_init(const logo_display_config_t* config) {
         return ESP_ERR_NO_MEM;
     }
 
+    s_controller.decode_mutex = xSemaphoreCreateMutex();
+    if (!s_controller.decode_mutex) {
+        ESP_LOGE(TAG, "创建解码互斥锁失败");
+        vSemaphoreDelete(s_controller.status_mutex);
+        return ESP_ERR_NO_MEM;
+    }
+    s_controller.decode_request = -1;
+    s_controller.pending_logo = -1;
+
     // 设置JSON文件路径
     if (s_controller.config.json_file_path) {
         strncpy(s_controller.json_file_path, s_controller.config.json_file_path, 
@@ -101,6 +172,10 @@ esp_err_t led_matrix_logo_display_init(const logo_display_config_t* config) {
     s_controller.status.current_mode = s_controller.config.mode;
     s_controller.is_paused = false;
     s_controller.logo_count = 0;
+    led_playlist_init(&s_controller.playlist, 0, esp_random());
+
+    // 初始化LED渲染调速器
+    bsp_led_governor_init();
 
     // 创建定时器
     esp_timer_create_args_t switch_timer_args = {
@@ -115,9 +190,16 @@ esp_err_t led_matrix_logo_display_init(const logo_display_config_t* config) {
         .name = "logo_animation_timer"
     };
 
+    esp_timer_create_args_t reload_timer_args = {
+        .callback = reload_timer_callback,
+        .arg = NULL,
+        .name = "logo_reload_timer"
+    };
+
     esp_err_t ret = esp_timer_create(&switch_timer_args, &s_controller.switch_timer);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "创建切换定时器失败: %s", esp_err_to_name(ret));
+        vSemaphoreDelete(s_controller.decode_mutex);
         vSemaphoreDelete(s_controller.status_mutex);
         return ret;
     }
@@ -126,10 +208,33 @@ esp_err_t led_matrix_logo_display_init(const logo_display_config_t* config) {
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "创建动画定时器失败: %s", esp_err_to_name(ret));
         esp_timer_delete(s_controller.switch_timer);
+        vSemaphoreDelete(s_controller.decode_mutex);
         vSemaphoreDelete(s_controller.status_mutex);
         return ret;
     }
 
+    ret = esp_timer_create(&reload_timer_args, &s_controller.reload_timer);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "创建重新加载定时器失败: %s", esp_err_to_name(ret));
+        esp_timer_delete(s_controller.animation_timer);
+        esp_timer_delete(s_controller.switch_timer);
+        vSemaphoreDelete(s_controller.decode_mutex);
+        vSemaphoreDelete(s_controller.status_mutex);
+        return ret;
+    }
+
+    // 按需解码和预取读取TF卡，在独立的低优先级任务中进行
+    if (xTaskCreate(decoder_task, "logo_decoder", DECODER_TASK_STACK_SIZE, NULL,
+                    DECODER_TASK_PRIORITY, &s_controller.decoder_task) != pdPASS) {
+        ESP_LOGE(TAG, "创建Logo解码任务失败");
+        esp_timer_delete(s_controller.reload_timer);
+        esp_timer_delete(s_controller.animation_timer);
+        esp_timer_delete(s_controller.switch_timer);
+        vSemaphoreDelete(s_controller.decode_mutex);
+        vSemaphoreDelete(s_controller.status_mutex);
+        return ESP_ERR_NO_MEM;
+    }
+
     s_controller.is_initialized = true;
     
     ESP_LOGI(TAG, "Logo显示控制器初始化完成");
@@ -155,6 +260,35 @@ esp_err_t led_matrix_logo_display_start(void) {
         return ESP_OK;
     }
 
+    s_controller.boot_cancelled = false;
+    if (s_controller.boot_task) {
+        ESP_LOGI(TAG, "Logo显示正在后台启动");
+        return ESP_OK;
+    }
+
+    // 首次启动不阻塞调用者：硬件初始化、挂载TF卡和加载动画在后台任务中完成
+    if (!s_controller.hardware_ready) {
+        if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+            s_controller.status.is_loading = true;
+            xSemaphoreGive(s_controller.status_mutex);
+        }
+        BaseType_t created = xTaskCreate(boot_task, "logo_boot", BOOT_TASK_STACK_SIZE, NULL,
+                                         BOOT_TASK_PRIORITY, &s_controller.boot_task);
+        if (created != pdPASS) {
+            ESP_LOGE(TAG, "创建Logo后台启动任务失败");
+            s_controller.boot_task = NULL;
+            s_controller.status.is_loading = false;
+            return ESP_ERR_NO_MEM;
+        }
+        ESP_LOGI(TAG, "Logo显示在后台启动，加载完成前显示占位画面");
+        return ESP_OK;
+    }
+
+    return start_display();
+}
+
+// 加载Logo并启动定时器（硬件已就绪）
+static esp_err_t start_display(void) {
     // 加载Logo动画
     esp_err_t ret = load_logos_from_json();
     if (ret != ESP_OK) {
@@ -170,9 +304,9 @@ esp_err_t led_matrix_logo_display_start(void) {
         xSemaphoreGive(s_controller.status_mutex);
     }
 
-    // 切换到第一个Logo
+    // 切换到第一个可播放的Logo
     if (s_controller.logo_count > 0) {
-        ret = switch_to_logo_internal(0);
+        ret = decode_and_switch(get_first_logo_index());
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "切换到首个Logo失败: %s", esp_err_to_name(ret));
             s_controller.status.is_running = false;
@@ -180,10 +314,9 @@ esp_err_t led_matrix_logo_display_start(void) {
         }
     }
 
-    // 启动动画更新定时器
+    // 启动动画更新定时器（单次触发，每帧由调速器决定下一帧时间）
     if (s_controller.config.enable_effects) {
-        ret = esp_timer_start_periodic(s_controller.animation_timer, 
-                                      s_controller.config.animation_speed_ms * 1000);
+        ret = schedule_animation_frame(0);
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "启动动画定时器失败: %s", esp_err_to_name(ret));
             s_controller.status.is_running = false;
@@ -192,12 +325,8 @@ esp_err_t led_matrix_logo_display_start(void) {
     }
 
     // 启动切换定时器（根据模式）
-    if (s_controller.config.mode == LOGO_DISPLAY_MODE_SEQUENCE || 
-        s_controller.config.mode == LOGO_DISPLAY_MODE_TIMED_SWITCH ||
-        s_controller.config.mode == LOGO_DISPLAY_MODE_RANDOM) {
-        
-        ret = esp_timer_start_periodic(s_controller.switch_timer, 
-                                      s_controller.config.switch_interval_ms * 1000);
+    if (is_auto_switch_mode()) {
+        ret = start_switch_timer();
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "启动切换定时器失败: %s", esp_err_to_name(ret));
             esp_timer_stop(s_controller.animation_timer);
@@ -206,6 +335,16 @@ esp_err_t led_matrix_logo_display_start(void) {
         }
     }
 
+    // 监视动画文件，内容变化时自动热更新
+    if (s_controller.config.auto_reload) {
+        led_animation_watcher_config_t watcher_config = led_animation_watcher_get_default_config();
+        watcher_config.json_file_path = s_controller.json_file_path;
+        watcher_config.callback = file_changed_callback;
+        if (led_animation_watcher_start(&watcher_config) != ESP_OK) {
+            ESP_LOGW(TAG, "启动动画文件变化检测失败，需要手动重新加载");
+        }
+    }
+
     ESP_LOGI(TAG, "Logo显示启动成功，模式: %s，Logo数量: %lu", 
              get_mode_name(s_controller.config.mode), s_controller.logo_count);
 
@@ -213,6 +352,9 @@ esp_err_t led_matrix_logo_display_start(void) {
 }
 
 void led_matrix_logo_display_stop(void) {
+    if (s_controller.boot_task) {
+        s_controller.boot_cancelled = true;
+    }
     if (!s_controller.is_initialized || !s_controller.status.is_running) {
         return;
     }
@@ -220,6 +362,8 @@ void led_matrix_logo_display_stop(void) {
     // 停止定时器
     esp_timer_stop(s_controller.switch_timer);
     esp_timer_stop(s_controller.animation_timer);
+    led_animation_watcher_stop();
+    s_controller.transition_active = false;
 
     // 更新状态
     if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
@@ -246,10 +390,9 @@ esp_err_t led_matrix_logo_display_reload(const char* json_file_path) {
         s_controller.json_file_path[sizeof(s_controller.json_file_path) - 1] = '\0';
     }
 
-    // 如果正在运行，先停止再重新启动
-    bool was_running = s_controller.status.is_running;
-    if (was_running) {
-        led_matrix_logo_display_stop();
+    // 正在显示时交给后台任务加载，加载期间继续播放当前Logo
+    if (s_controller.status.is_running) {
+        return led_animation_reload_request(s_controller.json_file_path, reload_publish, reload_done_callback, NULL);
     }
 
     esp_err_t ret = load_logos_from_json();
@@ -258,10 +401,6 @@ esp_err_t led_matrix_logo_display_reload(const char* json_file_path) {
         return ret;
     }
 
-    if (was_running) {
-        return led_matrix_logo_display_start();
-    }
-
     return ESP_OK;
 }
 
@@ -308,7 +447,7 @@ esp_err_t led_matrix_logo_display_switch_to(uint32_t logo_index) {
         return ESP_ERR_INVALID_ARG;
     }
 
-    return switch_to_logo_internal(logo_index);
+    return decode_and_switch(logo_index);
 }
 
 esp_err_t led_matrix_logo_display_next(void) {
@@ -317,7 +456,7 @@ esp_err_t led_matrix_logo_display_next(void) {
     }
 
     uint32_t next_index = get_next_logo_index();
-    return switch_to_logo_internal(next_index);
+    return decode_and_switch(next_index);
 }
 
 esp_err_t led_matrix_logo_display_previous(void) {
@@ -326,7 +465,7 @@ esp_err_t led_matrix_logo_display_previous(void) {
     }
 
     uint32_t prev_index = get_previous_logo_index();
-    return switch_to_logo_internal(prev_index);
+    return decode_and_switch(prev_index);
 }
 
 // ========== 配置接口实现 ==========
@@ -335,13 +474,8 @@ void led_matrix_logo_display_set_switch_interval(uint32_t interval_ms) {
     s_controller.config.switch_interval_ms = interval_ms;
     
     // 如果正在运行且使用定时切换，重启定时器
-    if (s_controller.status.is_running && 
-        (s_controller.config.mode == LOGO_DISPLAY_MODE_SEQUENCE ||
-         s_controller.config.mode == LOGO_DISPLAY_MODE_TIMED_SWITCH ||
-         s_controller.config.mode == LOGO_DISPLAY_MODE_RANDOM)) {
-        
-        esp_timer_stop(s_controller.switch_timer);
-        esp_timer_start_periodic(s_controller.switch_timer, interval_ms * 1000);
+    if (s_controller.status.is_running && !s_controller.is_paused && is_auto_switch_mode()) {
+        start_switch_timer();
     }
     
     ESP_LOGI(TAG, "设置切换间隔: %lu ms", interval_ms);
@@ -350,10 +484,9 @@ void led_matrix_logo_display_set_switch_interval(uint32_t interval_ms) {
 void led_matrix_logo_display_set_animation_speed(uint32_t speed_ms) {
     s_controller.config.animation_speed_ms = speed_ms;
     
-    // 如果动画定时器正在运行，重启它
-    if (s_controller.status.is_running && s_controller.config.enable_effects) {
-        esp_timer_stop(s_controller.animation_timer);
-        esp_timer_start_periodic(s_controller.animation_timer, speed_ms * 1000);
+    // 如果动画正在运行，按新速度重新调度下一帧
+    if (s_controller.status.is_running && s_controller.config.enable_effects && !s_controller.is_paused) {
+        schedule_animation_frame(0);
     }
     
     ESP_LOGI(TAG, "设置动画速度: %lu ms", speed_ms);
@@ -365,6 +498,31 @@ void led_matrix_logo_display_set_brightness(uint8_t brightness) {
     ESP_LOGI(TAG, "设置亮度: %d", brightness);
 }
 
+esp_err_t led_matrix_logo_display_set_transition(led_transition_type_t type, uint32_t duration_ms) {
+    if (type < LED_TRANSITION_NONE || type > LED_TRANSITION_DISSOLVE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    s_controller.config.transition = type;
+    s_controller.config.transition_ms = duration_ms;
+
+    ESP_LOGI(TAG, "设置切换过渡: %s, %lu ms", led_transition_get_name(type), duration_ms);
+    return ESP_OK;
+}
+
+esp_err_t led_matrix_logo_display_set_playlist_entry(uint32_t logo_index, const led_playlist_entry_t* entry) {
+    if (logo_index >= MAX_LOGO_COUNT ||
+        !led_playlist_set_entry(&s_controller.playlist, (uint8_t)logo_index, entry)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ESP_LOGI(TAG, "设置Logo %lu 播放参数: 权重 %d, 时长 %lu ms, 时间窗口 %02d:%02d-%02d:%02d",
+             logo_index, entry->weight, entry->duration_ms,
+             entry->window_start / 60, entry->window_start % 60,
+             entry->window_end / 60, entry->window_end % 60);
+    return ESP_OK;
+}
+
 void led_matrix_logo_display_set_effects(bool enable) {
     bool was_enabled = s_controller.config.enable_effects;
     s_controller.config.enable_effects = enable;
@@ -372,11 +530,11 @@ void led_matrix_logo_display_set_effects(bool enable) {
     if (s_controller.status.is_running) {
         if (enable && !was_enabled) {
             // 启用动画效果
-            esp_timer_start_periodic(s_controller.animation_timer, 
-                                    s_controller.config.animation_speed_ms * 1000);
+            schedule_animation_frame(0);
         } else if (!enable && was_enabled) {
             // 禁用动画效果
             esp_timer_stop(s_controller.animation_timer);
+            s_controller.transition_active = false;
         }
     }
     
@@ -403,17 +561,35 @@ void led_matrix_logo_display_print_status(void) {
     logo_display_status_t status;
     if (led_matrix_logo_display_get_status(&status) == ESP_OK) {
         ESP_LOGI(TAG, "=== Logo显示状态 ===");
-        ESP_LOGI(TAG, "运行状态: %s", status.is_running ? "运行中" : "已停止");
+        ESP_LOGI(TAG, "运行状态: %s", status.is_running ? "运行中" : (status.is_loading ? "后台加载中" : "已停止"));
+        if (status.boot_load_ms > 0) {
+            ESP_LOGI(TAG, "后台启动耗时: %lu ms", status.boot_load_ms);
+        }
         ESP_LOGI(TAG, "显示模式: %s", get_mode_name(status.current_mode));
         ESP_LOGI(TAG, "当前Logo: %lu/%lu (%s)", 
                  status.current_logo_index + 1, status.total_logos, status.current_logo_name);
         ESP_LOGI(TAG, "总切换次数: %lu", status.total_switches);
+        ESP_LOGI(TAG, "已解码Logo: %lu/%lu", status.decoded_logos, status.total_logos);
+
+        led_animation_cache_stats_t cache_stats;
+        led_animation_cache_get_stats(&cache_stats);
+        ESP_LOGI(TAG, "启动缓存: 命中 %lu/%lu, 写入 %lu 次, 跳过CRC %lu 次, 累计节省 %lld us",
+                 cache_stats.hits, cache_stats.lookups, cache_stats.stores, cache_stats.crc_skips,
+                 cache_stats.saved_us);
         ESP_LOGI(TAG, "上次切换: %lu ms前", get_time_ms() - status.last_switch_time);
         if (status.next_switch_time > 0) {
             ESP_LOGI(TAG, "下次切换: %lu ms后", 
                      status.next_switch_time > get_time_ms() ? 
                      status.next_switch_time - get_time_ms() : 0);
         }
+
+        bsp_led_governor_stats_t frame_stats;
+        if (bsp_led_governor_get_stats(BSP_LED_RENDERER_MATRIX, &frame_stats) == ESP_OK) {
+            ESP_LOGI(TAG, "帧率: 请求 %lu.%lu fps, 实际 %lu.%lu fps, 平均帧耗时 %lu us",
+                     frame_stats.requested_fps_x10 / 10, frame_stats.requested_fps_x10 % 10,
+                     frame_stats.achieved_fps_x10 / 10, frame_stats.achieved_fps_x10 % 10,
+                     frame_stats.avg_frame_cost_us);
+        }
     }
 }
 
@@ -426,15 +602,14 @@ esp_err_t led_matrix_logo_display_get_logo_name(uint32_t logo_index, char* name_
         return ESP_ERR_INVALID_ARG;
     }
 
-    // 从动画系统获取Logo名称
-    const char* name = led_animation_get_name(s_controller.logo_animations[logo_index]);
-    if (name) {
-        strncpy(name_buffer, name, buffer_size - 1);
+    // 按需解码时名称来自偏移索引，无需解码动画
+    if (s_controller.lazy_decode) {
+        strncpy(name_buffer, s_controller.file_index.entries[logo_index].name, buffer_size - 1);
         name_buffer[buffer_size - 1] = '\0';
         return ESP_OK;
     }
 
-    return ESP_ERR_NOT_FOUND;
+    return led_animation_get_name(s_controller.logo_animations[logo_index], name_buffer, buffer_size);
 }
 
 logo_display_config_t led_matrix_logo_display_get_default_config(void) {
@@ -445,7 +620,12 @@ logo_display_config_t led_matrix_logo_display_get_default_config(void) {
         .auto_start = false,
         .enable_effects = true,
         .brightness = DEFAULT_BRIGHTNESS,
-        .json_file_path = DEFAULT_JSON_FILE_PATH
+        .json_file_path = DEFAULT_JSON_FILE_PATH,
+        .prefetch_next = true,
+        .auto_reload = true,
+        .transition = LED_TRANSITION_FADE,
+        .transition_ms = DEFAULT_TRANSITION_MS,
+        .placeholder_name = DEFAULT_PLACEHOLDER_NAME
     };
     return config;
 }
@@ -479,16 +659,12 @@ void led_matrix_logo_display_pause(bool pause) {
             esp_timer_stop(s_controller.animation_timer);
             ESP_LOGI(TAG, "Logo显示已暂停");
         } else {
-            if (s_controller.config.mode == LOGO_DISPLAY_MODE_SEQUENCE ||
-                s_controller.config.mode == LOGO_DISPLAY_MODE_TIMED_SWITCH ||
-                s_controller.config.mode == LOGO_DISPLAY_MODE_RANDOM) {
-                esp_timer_start_periodic(s_controller.switch_timer, 
-                                        s_controller.config.switch_interval_ms * 1000);
+            if (is_auto_switch_mode()) {
+                start_switch_timer();
             }
             
             if (s_controller.config.enable_effects) {
-                esp_timer_start_periodic(s_controller.animation_timer, 
-                                        s_controller.config.animation_speed_ms * 1000);
+                schedule_animation_frame(0);
             }
             ESP_LOGI(TAG, "Logo显示已恢复");
         }
@@ -505,37 +681,204 @@ uint32_t led_matrix_logo_display_get_max_logos(void) {
 
 // ========== 静态函数实现 ==========
 
+// 首次启动的后台任务：硬件初始化 -> 占位画面 -> 挂载TF卡 -> 加载Logo并开始显示
+static void boot_task(void* arg) {
+    (void)arg;
+    int64_t start_us = esp_timer_get_time();
+
+    esp_err_t ret = led_matrix_init_hardware();
+    if (ret == ESP_OK) {
+        show_placeholder();
+        prepare_storage();
+        s_controller.hardware_ready = true;
+
+        if (!s_controller.boot_cancelled) {
+            ret = start_display();
+            if (ret != ESP_OK) {
+                ESP_LOGW(TAG, "Logo显示启动失败，保持占位画面: %s", esp_err_to_name(ret));
+            }
+        }
+    } else {
+        ESP_LOGE(TAG, "LED矩阵硬件初始化失败: %s", esp_err_to_name(ret));
+    }
+
+    uint32_t elapsed_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+    if (xSemaphoreTake(s_controller.status_mutex, portMAX_DELAY) == pdTRUE) {
+        s_controller.status.is_loading = false;
+        s_controller.status.boot_load_ms = elapsed_ms;
+        xSemaphoreGive(s_controller.status_mutex);
+    }
+    ESP_LOGI(TAG, "Logo后台启动完成，耗时 %lu ms（未阻塞启动流程）", elapsed_ms);
+
+    s_controller.boot_task = NULL;
+    vTaskDelete(NULL);
+}
+
+// 显示内置占位动画（位于flash，发布时不复制数据，也不需要TF卡）
+static void show_placeholder(void) {
+    initialize_animation_demo();
+
+    int count = led_animation_get_count();
+    if (count <= 0) {
+        return;
+    }
+
+    int index = 0;
+    char name[64];
+    for (int i = 0; i < count && s_controller.config.placeholder_name; i++) {
+        if (led_animation_get_name(i, name, sizeof(name)) == ESP_OK &&
+            strcmp(name, s_controller.config.placeholder_name) == 0) {
+            index = i;
+            break;
+        }
+    }
+
+    led_animation_select(index);
+    led_animation_render();
+    led_matrix_refresh();
+}
+
+// 挂载TF卡，没有动画文件时导出内置动画作为模板
+static void prepare_storage(void) {
+    esp_err_t ret = bsp_storage_sdcard_mount(MOUNT_POINT);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "TF卡挂载失败: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    if (!animation_file_exists(s_controller.json_file_path)) {
+        // 当前动画库是占位时发布的内置动画
+        ESP_LOGI(TAG, "未找到动画文件，导出内置动画: %s", s_controller.json_file_path);
+        ret = export_animation_to_json(s_controller.json_file_path);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "导出内置动画失败: %s", esp_err_to_name(ret));
+        }
+    }
+}
+
 static void switch_timer_callback(void* arg) {
     (void)arg;  // 避免未使用警告
 
-    if (s_controller.is_paused || !s_controller.status.is_running) {
+    // 新动画库已发布但Logo映射尚未重建时不切换
+    if (s_controller.is_paused || !s_controller.status.is_running || s_controller.reload_pending) {
         return;
     }
 
-    uint32_t next_index;
-    
-    switch (s_controller.config.mode) {
-        case LOGO_DISPLAY_MODE_SEQUENCE:
-        case LOGO_DISPLAY_MODE_TIMED_SWITCH:
-            next_index = get_next_logo_index();
-            break;
-            
-        case LOGO_DISPLAY_MODE_RANDOM:
-            // 随机选择，但避免连续显示同一个
-            if (s_controller.logo_count > 1) {
-                do {
-                    next_index = esp_random() % s_controller.logo_count;
-                } while (next_index == s_controller.status.current_logo_index);
-            } else {
-                next_index = 0;
-            }
-            break;
-            
-        default:
-            return;
+    // 解码任务完成等待中的Logo后重新触发定时器，直接切换到该Logo
+    int next_index = s_controller.pending_logo;
+    s_controller.pending_logo = -1;
+
+    if (next_index < 0) {
+        switch (s_controller.config.mode) {
+            case LOGO_DISPLAY_MODE_SEQUENCE:
+            case LOGO_DISPLAY_MODE_TIMED_SWITCH:
+                next_index = led_playlist_next_in_order(&s_controller.playlist,
+                                                        (uint8_t)s_controller.status.current_logo_index,
+                                                        get_minute_of_day());
+                break;
+                
+            case LOGO_DISPLAY_MODE_RANDOM:
+                // 按权重从洗牌袋中取出，避免连续显示同一个
+                next_index = led_playlist_next_shuffled(&s_controller.playlist, get_minute_of_day());
+                break;
+                
+            default:
+                return;
+        }
+    }
+
+    // 没有可播放的其他Logo时保持当前Logo，按其时长再次尝试
+    if (next_index < 0 || (uint32_t)next_index == s_controller.status.current_logo_index) {
+        start_switch_timer();
+        return;
+    }
+
+    // 尚未解码的Logo交给解码任务，解码完成后立即切换；期间继续显示当前Logo
+    if (s_controller.logo_animations[next_index] < 0) {
+        s_controller.pending_logo = next_index;
+        request_decode(next_index);
+        return;
     }
 
-    switch_to_logo_internal(next_index);
+    if (switch_to_logo_internal((uint32_t)next_index) != ESP_OK) {
+        start_switch_timer();
+    }
+}
+
+// 发布后台加载的动画库并重建Logo映射（在重新加载任务中调用）
+static esp_err_t reload_publish(led_animation_bank_t* bank, void* user_ctx) {
+    (void)user_ctx;
+
+    // 与按需解码串行：解码任务不会把旧动画库中的槽位写入新的Logo映射
+    xSemaphoreTake(s_controller.decode_mutex, portMAX_DELAY);
+
+    // 重建期间切换定时器不选择新Logo
+    s_controller.reload_pending = true;
+    s_controller.lazy_decode = false;
+    s_controller.cache_pending = false;
+    s_controller.pending_logo = -1;
+    set_lazy_bank(NULL);
+
+    esp_err_t ret = led_animation_bank_publish(bank, 0);
+    if (ret != ESP_OK) {
+        led_animation_bank_destroy(bank);
+        s_controller.reload_pending = false;
+        xSemaphoreGive(s_controller.decode_mutex);
+        return ret;
+    }
+
+    map_all_logos();
+    led_playlist_set_count(&s_controller.playlist, (uint8_t)s_controller.logo_count);
+    if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        s_controller.status.total_logos = s_controller.logo_count;
+        s_controller.status.current_logo_index = 0;
+        s_controller.status.decoded_logos = s_controller.logo_count;
+        xSemaphoreGive(s_controller.status_mutex);
+    }
+
+    xSemaphoreGive(s_controller.decode_mutex);
+    return ESP_OK;
+}
+
+// 后台重新加载完成（在重新加载任务中调用）
+static void reload_done_callback(esp_err_t result, void* user_ctx) {
+    (void)user_ctx;
+
+    if (result != ESP_OK) {
+        ESP_LOGW(TAG, "后台重新加载Logo失败: %s，继续显示当前Logo", esp_err_to_name(result));
+        return;
+    }
+
+    // 切换和渲染都在定时器任务中进行，由定时器切换到首个Logo
+    esp_timer_stop(s_controller.reload_timer);
+    if (esp_timer_start_once(s_controller.reload_timer, 0) != ESP_OK) {
+        ESP_LOGE(TAG, "启动重新加载定时器失败");
+        s_controller.reload_pending = false;
+    }
+}
+
+// 动画文件内容变化（在文件检测任务中调用）
+static void file_changed_callback(const char* json_file_path, void* user_ctx) {
+    (void)json_file_path;
+    (void)user_ctx;
+
+    ESP_LOGI(TAG, "检测到Logo动画文件变化，开始热更新");
+    esp_err_t ret = led_matrix_logo_display_reload(NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "热更新请求失败: %s", esp_err_to_name(ret));
+    }
+}
+
+// Logo映射已在重新加载任务中重建，这里只切换到首个Logo（不加锁、不读取TF卡）
+static void reload_timer_callback(void* arg) {
+    (void)arg;
+
+    s_controller.reload_pending = false;
+
+    ESP_LOGI(TAG, "Logo已热更新: %lu 个Logo", s_controller.logo_count);
+    if (s_controller.logo_count > 0) {
+        switch_to_logo_internal(get_first_logo_index());
+    }
 }
 
 static void animation_timer_callback(void* arg) {
@@ -545,10 +888,95 @@ static void animation_timer_callback(void* arg) {
         return;
     }
 
-    led_animation_update();
+    int64_t frame_begin = bsp_led_governor_frame_begin(BSP_LED_RENDERER_MATRIX);
+    render_frame();
+    uint32_t next_frame_ms = get_next_frame_interval();
+    uint32_t wait_ms = bsp_led_governor_frame_end(BSP_LED_RENDERER_MATRIX, frame_begin, next_frame_ms);
+
+    // 画面静止时不再调度，直到切换Logo或恢复播放
+    if (wait_ms != BSP_LED_DEADLINE_STATIC &&
+        s_controller.status.is_running && !s_controller.is_paused && s_controller.config.enable_effects) {
+        esp_timer_start_once(s_controller.animation_timer, (uint64_t)wait_ms * 1000);
+    }
+}
+
+static esp_err_t schedule_animation_frame(uint32_t delay_ms) {
+    // 单次定时器可能仍在等待上一帧，先停止再重新调度
+    esp_timer_stop(s_controller.animation_timer);
+    uint64_t delay_us = (delay_ms > 0) ? (uint64_t)delay_ms * 1000 : 1000;
+    return esp_timer_start_once(s_controller.animation_timer, delay_us);
+}
+
+// 渲染一帧，过渡期间在刷新前混合切换前的旧画面
+static void render_frame(void) {
+    if (!s_controller.transition_active) {
+        led_animation_update();
+        return;
+    }
+
+    led_animation_render();
+
+    led_blit_surface_t frame;
+    led_matrix_get_surface(&frame);
+    uint16_t alpha = led_transition_alpha(esp_timer_get_time() - s_controller.transition_start_us,
+                                          s_controller.config.transition_ms);
+    led_transition_blend(s_controller.config.transition, s_controller.transition_from, &frame, alpha);
+    led_matrix_refresh();
+
+    if (alpha >= LED_TRANSITION_ALPHA_MAX) {
+        s_controller.transition_active = false;
+    }
+}
+
+// 保存当前显示的画面作为过渡的旧画面（在选择新动画之前调用）
+static void begin_transition(void) {
+    s_controller.transition_active = false;
+    if (s_controller.config.transition == LED_TRANSITION_NONE || s_controller.config.transition_ms == 0 ||
+        !s_controller.status.is_running || s_controller.is_paused || !s_controller.config.enable_effects ||
+        !led_animation_is_running()) {
+        return;
+    }
+
+    if (!s_controller.transition_from) {
+        s_controller.transition_from = malloc(LED_MATRIX_WIDTH * LED_MATRIX_HEIGHT * 3);
+        if (!s_controller.transition_from) {
+            ESP_LOGW(TAG, "无法分配过渡缓冲区，直接切换");
+            return;
+        }
+    }
+
+    led_blit_surface_t frame;
+    led_matrix_get_surface(&frame);
+    memcpy(s_controller.transition_from, frame.pixels, LED_MATRIX_WIDTH * LED_MATRIX_HEIGHT * 3);
+    s_controller.transition_start_us = esp_timer_get_time();
+    s_controller.transition_active = true;
+}
+
+static uint32_t get_next_frame_interval(void) {
+    // 过渡期间每帧画面都在变化
+    if (s_controller.transition_active) {
+        return s_controller.config.animation_speed_ms;
+    }
+
+    uint32_t idle_frames = led_animation_get_idle_frames();
+    if (idle_frames == LED_ANIMATION_IDLE_FOREVER) {
+        return BSP_LED_DEADLINE_STATIC;
+    }
+
+    // 闪光移出矩阵期间画面不变，直接快进到下一次画面变化
+    led_animation_skip_frames(idle_frames);
+    return (idle_frames + 1) * s_controller.config.animation_speed_ms;
 }
 
+// 重新加载期间不进行按需解码，解码任务不会写入即将被替换的Logo映射
 static esp_err_t load_logos_from_json(void) {
+    xSemaphoreTake(s_controller.decode_mutex, portMAX_DELAY);
+    esp_err_t ret = load_logos_locked();
+    xSemaphoreGive(s_controller.decode_mutex);
+    return ret;
+}
+
+static esp_err_t load_logos_locked(void) {
     ESP_LOGI(TAG, "从JSON文件加载Logo: %s", s_controller.json_file_path);
 
     // 检查SD卡是否挂载
@@ -557,56 +985,274 @@ static esp_err_t load_logos_from_json(void) {
         return ESP_ERR_INVALID_STATE;
     }
 
-    // 加载JSON动画文件
-    esp_err_t ret = load_animation_from_json(s_controller.json_file_path);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "加载JSON动画文件失败: %s", esp_err_to_name(ret));
-        return ret;
+    // 有可用的预编译二进制文件时一次加载全部，否则只建立偏移索引、按需解码
+    char bin_path[128];
+    bool use_binary = led_animation_binary_path(s_controller.json_file_path, bin_path, sizeof(bin_path)) == ESP_OK &&
+                      led_animation_binary_is_fresh(s_controller.json_file_path, bin_path);
+
+    uint32_t decoded = 0;
+    s_controller.logo_count = 0;
+    s_controller.lazy_decode = false;
+    s_controller.cache_pending = false;
+    s_controller.pending_logo = -1;
+    set_lazy_bank(NULL);
+
+    // 没有二进制文件时先查启动缓存，JSON内容未变则一次加载全部、无需解析
+    bool has_cache_key = !use_binary &&
+                         led_animation_cache_compute_key(s_controller.json_file_path, &s_controller.cache_key) == ESP_OK;
+    led_animation_bank_t *cached_bank = NULL;
+    int64_t index_start_us = esp_timer_get_time();
+    if (has_cache_key &&
+        led_animation_cache_load(s_controller.json_file_path, &s_controller.cache_key, &cached_bank) == ESP_OK &&
+        led_animation_bank_publish(cached_bank, 0) == ESP_OK) {
+        map_all_logos();
+        decoded = s_controller.logo_count;
+    } else if (!use_binary &&
+               build_animation_index_from_json(s_controller.json_file_path, &s_controller.file_index) == ESP_OK) {
+        for (int i = 0; i < s_controller.file_index.count && s_controller.logo_count < MAX_LOGO_COUNT; i++) {
+            s_controller.logo_animations[s_controller.logo_count] = -1;
+            s_controller.logo_count++;
+        }
+        led_playlist_set_count(&s_controller.playlist, (uint8_t)s_controller.logo_count);
+
+        // 在新动画库中解码首个Logo后再发布，此前继续显示当前动画（启动时为占位画面）
+        uint32_t first_index = get_first_logo_index();
+        int animation_index = -1;
+        led_animation_bank_t *bank = led_animation_bank_create();
+        esp_err_t ret = bank ? load_indexed_animation_from_json(s_controller.json_file_path,
+                                                                &s_controller.file_index.entries[first_index],
+                                                                bank, &animation_index) : ESP_ERR_NO_MEM;
+        if (animation_index < 0) {
+            ESP_LOGE(TAG, "解码首个Logo失败: %s", esp_err_to_name(ret));
+            led_animation_bank_destroy(bank);
+            s_controller.logo_count = 0;
+            return ret != ESP_OK ? ret : ESP_ERR_INVALID_STATE;
+        }
+
+        // 控制器持有按需解码的动画库，之后的Logo都解码到其中
+        led_animation_bank_retain(bank);
+        led_animation_bank_publish(bank, animation_index);
+        set_lazy_bank(bank);
+        led_animation_bank_release(bank);
+
+        s_controller.logo_animations[first_index] = animation_index;
+        s_controller.lazy_decode = true;
+        s_controller.cache_pending = has_cache_key && ret == ESP_OK;
+        s_controller.decode_us = esp_timer_get_time() - index_start_us;
+        decoded = 1;
+        if (s_controller.cache_pending && s_controller.logo_count == 1) {
+            store_decoded_cache(bank);
+        }
+    } else {
+        // 加载全部动画（二进制文件或索引失败时的回退路径）
+        esp_err_t ret = load_animation_from_json(s_controller.json_file_path);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "加载JSON动画文件失败: %s", esp_err_to_name(ret));
+            return ret;
+        }
+
+        map_all_logos();
+        decoded = s_controller.logo_count;
     }
 
-    // 获取加载的动画数量
-    int total_animations = led_animation_get_count();
-    if (total_animations <= 0) {
+    if (s_controller.logo_count == 0) {
         ESP_LOGE(TAG, "没有加载任何动画");
         return ESP_ERR_NOT_FOUND;
     }
-
-    // 构建Logo动画索引数组
-    s_controller.logo_count = 0;
-    for (int i = 0; i < total_animations && s_controller.logo_count < MAX_LOGO_COUNT; i++) {
-        // 假设所有动画都是Logo（也可以根据名称或其他标识过滤）
-        s_controller.logo_animations[s_controller.logo_count] = i;
-        s_controller.logo_count++;
-    }
+    led_playlist_set_count(&s_controller.playlist, (uint8_t)s_controller.logo_count);
 
     // 更新状态
     if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
         s_controller.status.total_logos = s_controller.logo_count;
         s_controller.status.current_logo_index = 0;
+        s_controller.status.decoded_logos = decoded;
         xSemaphoreGive(s_controller.status_mutex);
     }
 
-    ESP_LOGI(TAG, "成功加载 %lu 个Logo动画", s_controller.logo_count);
+    ESP_LOGI(TAG, "成功加载 %lu 个Logo动画%s", s_controller.logo_count,
+             s_controller.lazy_decode ? "（按需解码）" : "");
     return ESP_OK;
 }
 
+// 确保Logo对应的动画已解码到按需解码的动画库（只在任务上下文中调用）
+static esp_err_t ensure_logo_decoded(uint32_t logo_index) {
+    if (logo_index >= s_controller.logo_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_controller.logo_animations[logo_index] >= 0) {
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(s_controller.decode_mutex, portMAX_DELAY);
+
+    // 等待期间可能已被其他任务解码或重新加载
+    led_animation_bank_t *bank = NULL;
+    if (xSemaphoreTake(s_controller.status_mutex, portMAX_DELAY) == pdTRUE) {
+        if (s_controller.lazy_decode && s_controller.lazy_bank && logo_index < s_controller.logo_count &&
+            s_controller.logo_animations[logo_index] < 0) {
+            bank = s_controller.lazy_bank;
+            led_animation_bank_retain(bank);
+        }
+        xSemaphoreGive(s_controller.status_mutex);
+    }
+    if (!bank) {
+        xSemaphoreGive(s_controller.decode_mutex);
+        return (logo_index < s_controller.logo_count && s_controller.logo_animations[logo_index] >= 0) ?
+               ESP_OK : ESP_ERR_INVALID_STATE;
+    }
+
+    int animation_index = -1;
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t ret = load_indexed_animation_from_json(s_controller.json_file_path,
+                                                     &s_controller.file_index.entries[logo_index],
+                                                     bank, &animation_index);
+    s_controller.decode_us += esp_timer_get_time() - start_us;
+
+    // 动画库已被热更新替换时丢弃结果，新的Logo映射由重新加载建立
+    uint32_t decoded = 0;
+    if (xSemaphoreTake(s_controller.status_mutex, portMAX_DELAY) == pdTRUE) {
+        if (animation_index >= 0 && s_controller.lazy_bank == bank) {
+            // 即使点数据有误也保留槽位，避免每次切换都重新解码
+            s_controller.logo_animations[logo_index] = animation_index;
+            decoded = ++s_controller.status.decoded_logos;
+        }
+        xSemaphoreGive(s_controller.status_mutex);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "解码Logo失败: %s (索引: %lu)", esp_err_to_name(ret), logo_index);
+        s_controller.cache_pending = false;
+    }
+
+    if (s_controller.cache_pending && decoded == s_controller.logo_count) {
+        store_decoded_cache(bank);
+    }
+
+    led_animation_bank_release(bank);
+    xSemaphoreGive(s_controller.decode_mutex);
+    return animation_index >= 0 ? ESP_OK : ret;
+}
+
+// 替换控制器持有的按需解码动画库（NULL表示不再按需解码）
+static void set_lazy_bank(led_animation_bank_t* bank) {
+    led_animation_bank_retain(bank);
+
+    led_animation_bank_t *old = NULL;
+    if (xSemaphoreTake(s_controller.status_mutex, portMAX_DELAY) == pdTRUE) {
+        old = s_controller.lazy_bank;
+        s_controller.lazy_bank = bank;
+        xSemaphoreGive(s_controller.status_mutex);
+    }
+    led_animation_bank_release(old);
+}
+
+// 当前动画库中的全部动画都作为Logo（也可以根据名称或其他标识过滤）
+static void map_all_logos(void) {
+    int total_animations = led_animation_get_count();
+    s_controller.logo_count = 0;
+    for (int i = 0; i < total_animations && s_controller.logo_count < MAX_LOGO_COUNT; i++) {
+        s_controller.logo_animations[s_controller.logo_count] = i;
+        s_controller.logo_count++;
+    }
+}
+
+// 全部Logo按需解码完成后，按Logo顺序写入启动缓存，下次启动直接加载
+static void store_decoded_cache(led_animation_bank_t* bank) {
+    s_controller.cache_pending = false;
+
+    esp_err_t ret = led_animation_cache_store(s_controller.json_file_path, &s_controller.cache_key, bank,
+                                              s_controller.logo_animations, (int)s_controller.logo_count,
+                                              s_controller.decode_us);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "写入启动缓存失败: %s", esp_err_to_name(ret));
+    }
+}
+
+// 预先解码下一个Logo，使下一次切换不需要等待解码（在解码任务中调用）
+static void prefetch_next_logo(void) {
+    if (!s_controller.lazy_decode || !s_controller.config.prefetch_next ||
+        s_controller.config.mode == LOGO_DISPLAY_MODE_RANDOM) {
+        return;
+    }
+
+    uint32_t next_index = get_next_logo_index();
+    if (next_index < s_controller.logo_count && s_controller.logo_animations[next_index] < 0) {
+        ensure_logo_decoded(next_index);
+    }
+}
+
+// 请求解码任务解码指定Logo并预取下一个（-1表示只预取）
+static void request_decode(int32_t logo_index) {
+    if (logo_index >= 0) {
+        s_controller.decode_request = logo_index;
+    }
+    if (s_controller.decoder_task) {
+        xTaskNotifyGive(s_controller.decoder_task);
+    }
+}
+
+// 按需解码任务：定时器只切换到已解码的Logo，读取TF卡都在这里完成
+static void decoder_task(void* arg) {
+    (void)arg;
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        int32_t logo_index = s_controller.decode_request;
+        s_controller.decode_request = -1;
+        if (logo_index >= 0) {
+            esp_err_t ret = ensure_logo_decoded((uint32_t)logo_index);
+            if (s_controller.pending_logo == logo_index && s_controller.status.is_running) {
+                if (ret == ESP_OK) {
+                    // 立即触发切换定时器，由定时器切换到刚解码的Logo
+                    esp_timer_stop(s_controller.switch_timer);
+                    esp_timer_start_once(s_controller.switch_timer, 0);
+                } else {
+                    // 解码失败时保持当前Logo，按其时长再次尝试
+                    s_controller.pending_logo = -1;
+                    start_switch_timer();
+                }
+            }
+        }
+
+        prefetch_next_logo();
+    }
+}
+
+// 在任务上下文中切换Logo，尚未解码时先同步解码
+static esp_err_t decode_and_switch(uint32_t logo_index) {
+    esp_err_t ret = ensure_logo_decoded(logo_index);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return switch_to_logo_internal(logo_index);
+}
+
+// 切换到已解码的Logo（可在定时器回调中调用，不读取TF卡）
 static esp_err_t switch_to_logo_internal(uint32_t logo_index) {
     if (logo_index >= s_controller.logo_count) {
         return ESP_ERR_INVALID_ARG;
     }
+    if (s_controller.logo_animations[logo_index] < 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
 
-    uint32_t animation_index = s_controller.logo_animations[logo_index];
+    uint32_t animation_index = (uint32_t)s_controller.logo_animations[logo_index];
     
     // 切换到指定动画
+    begin_transition();
     esp_err_t ret = led_animation_select(animation_index);
     if (ret != ESP_OK) {
+        s_controller.transition_active = false;
         ESP_LOGE(TAG, "切换到动画失败: %s (Logo索引: %lu, 动画索引: %lu)", 
                  esp_err_to_name(ret), logo_index, animation_index);
         return ret;
     }
 
     // 获取Logo名称
-    const char* logo_name = led_animation_get_name(animation_index);
+    char logo_name[sizeof(s_controller.status.current_logo_name)];
+    if (led_animation_get_name(animation_index, logo_name, sizeof(logo_name)) != ESP_OK) {
+        snprintf(logo_name, sizeof(logo_name), "Logo%lu", logo_index);
+    }
     
     // 更新状态
     if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
@@ -614,22 +1260,26 @@ static esp_err_t switch_to_logo_internal(uint32_t logo_index) {
         s_controller.status.total_switches++;
         s_controller.status.last_switch_time = get_time_ms();
         update_next_switch_time();
-        
-        if (logo_name) {
-            strncpy(s_controller.status.current_logo_name, logo_name, 
-                    sizeof(s_controller.status.current_logo_name) - 1);
-            s_controller.status.current_logo_name[sizeof(s_controller.status.current_logo_name) - 1] = '\0';
-        } else {
-            snprintf(s_controller.status.current_logo_name, 
-                     sizeof(s_controller.status.current_logo_name), "Logo%lu", logo_index);
-        }
-        
+        strcpy(s_controller.status.current_logo_name, logo_name);
         xSemaphoreGive(s_controller.status_mutex);
     }
 
     ESP_LOGI(TAG, "切换到Logo: %s (索引: %lu)", 
              s_controller.status.current_logo_name, logo_index);
 
+    // 新Logo需要立即渲染（上一个Logo可能已声明画面静止）
+    if (s_controller.status.is_running && !s_controller.is_paused && s_controller.config.enable_effects) {
+        schedule_animation_frame(0);
+    }
+
+    // 按新Logo的显示时长重新计时
+    if (s_controller.status.is_running && !s_controller.is_paused && is_auto_switch_mode()) {
+        start_switch_timer();
+    }
+
+    if (s_controller.lazy_decode) {
+        request_decode(-1);
+    }
     return ESP_OK;
 }
 
@@ -637,9 +1287,57 @@ static uint32_t get_next_logo_index(void) {
     if (s_controller.logo_count == 0) {
         return 0;
     }
+
+    // 跳过权重为0或不在时间窗口内的Logo
+    int next_index = led_playlist_next_in_order(&s_controller.playlist,
+                                                (uint8_t)s_controller.status.current_logo_index,
+                                                get_minute_of_day());
+    if (next_index >= 0) {
+        return (uint32_t)next_index;
+    }
     return (s_controller.status.current_logo_index + 1) % s_controller.logo_count;
 }
 
+static uint32_t get_first_logo_index(void) {
+    if (s_controller.logo_count == 0) {
+        return 0;
+    }
+
+    int first_index = led_playlist_next_in_order(&s_controller.playlist,
+                                                 (uint8_t)(s_controller.logo_count - 1),
+                                                 get_minute_of_day());
+    return first_index >= 0 ? (uint32_t)first_index : 0;
+}
+
+static bool is_auto_switch_mode(void) {
+    return s_controller.config.mode == LOGO_DISPLAY_MODE_SEQUENCE ||
+           s_controller.config.mode == LOGO_DISPLAY_MODE_TIMED_SWITCH ||
+           s_controller.config.mode == LOGO_DISPLAY_MODE_RANDOM;
+}
+
+// 切换定时器为单次触发，每次切换后按新Logo的显示时长重新启动
+static esp_err_t start_switch_timer(void) {
+    esp_timer_stop(s_controller.switch_timer);
+    uint32_t duration_ms = get_logo_duration(s_controller.status.current_logo_index);
+    return esp_timer_start_once(s_controller.switch_timer, (uint64_t)duration_ms * 1000);
+}
+
+static uint32_t get_logo_duration(uint32_t logo_index) {
+    return led_playlist_get_duration(&s_controller.playlist, (uint8_t)logo_index,
+                                     s_controller.config.switch_interval_ms);
+}
+
+// 当天第几分钟，系统时间尚未设置时返回LED_PLAYLIST_ANY_TIME（忽略时间窗口）
+static int get_minute_of_day(void) {
+    time_t now = time(NULL);
+    struct tm local;
+    localtime_r(&now, &local);
+    if (local.tm_year + 1900 < MIN_VALID_YEAR) {
+        return LED_PLAYLIST_ANY_TIME;
+    }
+    return local.tm_hour * 60 + local.tm_min;
+}
+
 static uint32_t get_previous_logo_index(void) {
     if (s_controller.logo_count == 0) {
         return 0;
@@ -652,10 +1350,8 @@ static uint32_t get_time_ms(void) {
 }
 
 static void update_next_switch_time(void) {
-    if (s_controller.config.mode == LOGO_DISPLAY_MODE_SEQUENCE ||
-        s_controller.config.mode == LOGO_DISPLAY_MODE_TIMED_SWITCH ||
-        s_controller.config.mode == LOGO_DISPLAY_MODE_RANDOM) {
-        s_controller.status.next_switch_time = get_time_ms() + s_controller.config.switch_interval_ms;
+    if (is_auto_switch_mode()) {
+        s_controller.status.next_switch_time = get_time_ms() + get_logo_duration(s_controller.status.current_logo_index);
     } else {
         s_controller.status.next_switch_time = 0;
     }
@@ -0,0 +1,168 @@
+/**
+ * @file led_playlist.c
+ * @brief Logo播放列表调度器实现
+ *
+ * 洗牌袋在袋取完或可播放条目集合（时间窗口）变化时重新装袋并洗牌，
+ * 装袋的开销均摊到一袋内的每次选择。为避免同一个Logo连续出现，
+ * 取出的条目与上一次相同时与袋中下一个位置交换一次。
+ */
+
+#include "led_playlist.h"
+#include <string.h>
+
+#define DEFAULT_RNG_SEED                0x9E3779B9u
+
+// ========== 静态函数声明 ==========
+static uint32_t next_random(led_playlist_t *playlist);
+static uint32_t random_below(led_playlist_t *playlist, uint32_t bound);
+static uint16_t eligible_mask(const led_playlist_t *playlist, int minute_of_day);
+static void refill_bag(led_playlist_t *playlist, uint16_t mask);
+
+// ========== 核心接口实现 ==========
+
+led_playlist_entry_t led_playlist_get_default_entry(void) {
+    led_playlist_entry_t entry = {
+        .weight = 1,
+        .duration_ms = 0,
+        .window_start = 0,
+        .window_end = 0
+    };
+    return entry;
+}
+
+void led_playlist_init(led_playlist_t *playlist, uint8_t count, uint32_t seed) {
+    memset(playlist, 0, sizeof(*playlist));
+    for (int i = 0; i < LED_PLAYLIST_MAX_ENTRIES; i++) {
+        playlist->entries[i] = led_playlist_get_default_entry();
+    }
+    playlist->rng_state = seed ? seed : DEFAULT_RNG_SEED;
+    led_playlist_set_count(playlist, count);
+}
+
+void led_playlist_set_count(led_playlist_t *playlist, uint8_t count) {
+    playlist->count = (count > LED_PLAYLIST_MAX_ENTRIES) ? LED_PLAYLIST_MAX_ENTRIES : count;
+    playlist->bag_size = 0;
+    playlist->bag_pos = 0;
+    playlist->bag_mask = 0;
+    playlist->last = -1;
+}
+
+bool led_playlist_set_entry(led_playlist_t *playlist, uint8_t index, const led_playlist_entry_t *entry) {
+    if (!entry || index >= LED_PLAYLIST_MAX_ENTRIES || entry->weight > LED_PLAYLIST_MAX_WEIGHT ||
+        entry->window_start >= LED_PLAYLIST_MINUTES_PER_DAY || entry->window_end >= LED_PLAYLIST_MINUTES_PER_DAY) {
+        return false;
+    }
+
+    playlist->entries[index] = *entry;
+    // 权重变化后按新设置重新装袋
+    playlist->bag_mask = 0;
+    return true;
+}
+
+bool led_playlist_is_eligible(const led_playlist_t *playlist, uint8_t index, int minute_of_day) {
+    if (index >= playlist->count) {
+        return false;
+    }
+
+    const led_playlist_entry_t *entry = &playlist->entries[index];
+    if (entry->weight == 0) {
+        return false;
+    }
+    if (minute_of_day < 0 || entry->window_start == entry->window_end) {
+        return true;
+    }
+    if (entry->window_start < entry->window_end) {
+        return minute_of_day >= entry->window_start && minute_of_day < entry->window_end;
+    }
+    // 跨越午夜的窗口，例如22:00-06:00
+    return minute_of_day >= entry->window_start || minute_of_day < entry->window_end;
+}
+
+int led_playlist_next_shuffled(led_playlist_t *playlist, int minute_of_day) {
+    uint16_t mask = eligible_mask(playlist, minute_of_day);
+    if (mask == 0) {
+        return -1;
+    }
+
+    if (mask != playlist->bag_mask || playlist->bag_pos >= playlist->bag_size) {
+        refill_bag(playlist, mask);
+    }
+
+    uint8_t pos = playlist->bag_pos;
+    if (playlist->bag[pos] == playlist->last && pos + 1 < playlist->bag_size) {
+        uint8_t swap = playlist->bag[pos + 1];
+        playlist->bag[pos + 1] = playlist->bag[pos];
+        playlist->bag[pos] = swap;
+    }
+
+    playlist->bag_pos++;
+    playlist->last = playlist->bag[pos];
+    return playlist->last;
+}
+
+int led_playlist_next_in_order(const led_playlist_t *playlist, uint8_t current, int minute_of_day) {
+    for (int step = 1; step <= playlist->count; step++) {
+        uint8_t index = (uint8_t)((current + step) % playlist->count);
+        if (led_playlist_is_eligible(playlist, index, minute_of_day)) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+uint32_t led_playlist_get_duration(const led_playlist_t *playlist, uint8_t index, uint32_t default_ms) {
+    if (index >= LED_PLAYLIST_MAX_ENTRIES || playlist->entries[index].duration_ms == 0) {
+        return default_ms;
+    }
+    return playlist->entries[index].duration_ms;
+}
+
+// ========== 静态函数实现 ==========
+
+static uint32_t next_random(led_playlist_t *playlist) {
+    uint32_t x = playlist->rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    playlist->rng_state = x;
+    return x;
+}
+
+// [0, bound)内的随机数，用乘法映射代替取模，不需要拒绝重试
+static uint32_t random_below(led_playlist_t *playlist, uint32_t bound) {
+    return (uint32_t)(((uint64_t)next_random(playlist) * bound) >> 32);
+}
+
+static uint16_t eligible_mask(const led_playlist_t *playlist, int minute_of_day) {
+    uint16_t mask = 0;
+    for (uint8_t i = 0; i < playlist->count; i++) {
+        if (led_playlist_is_eligible(playlist, i, minute_of_day)) {
+            mask |= (uint16_t)(1u << i);
+        }
+    }
+    return mask;
+}
+
+// 每个可播放的条目按权重放入袋中，然后Fisher-Yates洗牌
+static void refill_bag(led_playlist_t *playlist, uint16_t mask) {
+    uint8_t size = 0;
+    for (uint8_t i = 0; i < playlist->count; i++) {
+        if (!(mask & (1u << i))) {
+            continue;
+        }
+        for (uint8_t w = 0; w < playlist->entries[i].weight; w++) {
+            playlist->bag[size++] = i;
+        }
+    }
+
+    for (uint8_t i = size; i > 1; i--) {
+        uint8_t j = (uint8_t)random_below(playlist, i);
+        uint8_t tmp = playlist->bag[i - 1];
+        playlist->bag[i - 1] = playlist->bag[j];
+        playlist->bag[j] = tmp;
+    }
+
+    playlist->bag_size = size;
+    playlist->bag_pos = 0;
+    playlist->bag_mask = mask;
+}
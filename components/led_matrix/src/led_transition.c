@@ -0,0 +1,112 @@
+/**
+ * @file led_transition.c
+ * @brief Logo切换过渡效果实现
+ *
+ * 混合公式：out = (from * (256 - alpha) + to * alpha) >> 8，
+ * alpha为0时结果等于旧画面，为256时等于新画面。
+ */
+
+#include "led_transition.h"
+#include <string.h>
+
+// 溶解顺序使用的乘法散列常数（Knuth），高8位作为像素的切换阈值
+#define DISSOLVE_HASH_MULTIPLIER        2654435761u
+
+// ========== 静态函数声明 ==========
+static void blend_span(uint8_t *to, const uint8_t *from, int bytes, uint16_t alpha);
+static void blend_fade(const uint8_t *from, const led_blit_surface_t *dst, uint16_t alpha);
+static void blend_wipe(const uint8_t *from, const led_blit_surface_t *dst, uint16_t alpha);
+static void blend_dissolve(const uint8_t *from, const led_blit_surface_t *dst, uint16_t alpha);
+
+// ========== 核心接口实现 ==========
+
+uint16_t led_transition_alpha(int64_t elapsed_us, uint32_t duration_ms) {
+    int64_t duration_us = (int64_t)duration_ms * 1000;
+    if (elapsed_us >= duration_us) {
+        return LED_TRANSITION_ALPHA_MAX;
+    }
+    if (elapsed_us <= 0) {
+        return 0;
+    }
+    return (uint16_t)((elapsed_us * LED_TRANSITION_ALPHA_MAX) / duration_us);
+}
+
+void led_transition_blend(led_transition_type_t type, const uint8_t *from,
+                          const led_blit_surface_t *dst, uint16_t alpha) {
+    if (!from || !dst || !dst->pixels || alpha >= LED_TRANSITION_ALPHA_MAX) {
+        return;
+    }
+
+    switch (type) {
+        case LED_TRANSITION_FADE:
+            blend_fade(from, dst, alpha);
+            break;
+        case LED_TRANSITION_WIPE:
+            blend_wipe(from, dst, alpha);
+            break;
+        case LED_TRANSITION_DISSOLVE:
+            blend_dissolve(from, dst, alpha);
+            break;
+        default:
+            break;
+    }
+}
+
+const char* led_transition_get_name(led_transition_type_t type) {
+    switch (type) {
+        case LED_TRANSITION_NONE:     return "无";
+        case LED_TRANSITION_FADE:     return "淡入淡出";
+        case LED_TRANSITION_WIPE:     return "擦除";
+        case LED_TRANSITION_DISSOLVE: return "溶解";
+        default:                      return "未知";
+    }
+}
+
+// ========== 静态函数实现 ==========
+
+static void blend_span(uint8_t *to, const uint8_t *from, int bytes, uint16_t alpha) {
+    if (alpha == 0) {
+        memcpy(to, from, (size_t)bytes);
+        return;
+    }
+
+    uint16_t inverse = LED_TRANSITION_ALPHA_MAX - alpha;
+    for (int i = 0; i < bytes; i++) {
+        to[i] = (uint8_t)((from[i] * inverse + to[i] * alpha) >> 8);
+    }
+}
+
+static void blend_fade(const uint8_t *from, const led_blit_surface_t *dst, uint16_t alpha) {
+    blend_span(dst->pixels, from, dst->width * dst->height * 3, alpha);
+}
+
+// 擦除边缘位置以1/256像素为单位：左侧整列显示新画面，边缘列按小数部分混合，右侧为旧画面
+static void blend_wipe(const uint8_t *from, const led_blit_surface_t *dst, uint16_t alpha) {
+    int edge = (int)alpha * dst->width;
+    int full_columns = edge >> 8;
+    uint16_t edge_alpha = (uint16_t)(edge & 0xFF);
+    int row_bytes = dst->width * 3;
+
+    for (int y = 0; y < dst->height; y++) {
+        uint8_t *row = dst->pixels + y * row_bytes;
+        const uint8_t *from_row = from + y * row_bytes;
+        int x = full_columns;
+
+        blend_span(row + x * 3, from_row + x * 3, 3, edge_alpha);
+        x++;
+        if (x < dst->width) {
+            memcpy(row + x * 3, from_row + x * 3, (size_t)(dst->width - x) * 3);
+        }
+    }
+}
+
+// 每个像素有固定的0-255阈值，透明度超过阈值后显示新画面
+static void blend_dissolve(const uint8_t *from, const led_blit_surface_t *dst, uint16_t alpha) {
+    int pixels = dst->width * dst->height;
+    for (int i = 0; i < pixels; i++) {
+        uint32_t threshold = ((uint32_t)i * DISSOLVE_HASH_MULTIPLIER) >> 24;
+        if (threshold >= alpha) {
+            memcpy(dst->pixels + i * 3, from + i * 3, 3);
+        }
+    }
+}
@@ -5,6 +5,7 @@
  * 基于优先级的系统状态显示： * - N305/Jetson高温: 红色慢速呼吸 (高优先级)
  * - Jetson功率过高: 紫色快速呼吸 (中优先级)  
  * - Jetson内存高使用率(90%): 紫色慢速呼吸 (低优先级)
+ * - 无告警时: 遥测条形图（温度、输入功率、网络延迟分段显示）
  * 
  * 通过Prometheus API获取系统监控数据
  */
@@ -14,6 +15,7 @@
 
 #include "esp_err.h"
 #include "bsp_state_manager.h"
+#include "bsp_led_effect.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -31,6 +33,7 @@ typedef enum {
     BOARD_DISPLAY_MODE_HIGH_TEMP,           // 高温警告 - 红色慢速呼吸 (最高优先级)
     BOARD_DISPLAY_MODE_HIGH_POWER,          // 功率过高 - 紫色快速呼吸 (中优先级)
     BOARD_DISPLAY_MODE_MEMORY_HIGH_USAGE,   // 内存高使用率 - 紫色慢速呼吸 (低优先级)
+    BOARD_DISPLAY_MODE_BAR_GRAPH,           // 遥测条形图 - 无告警时显示
     BOARD_DISPLAY_MODE_COUNT                // 模式总数
 } board_display_mode_t;
 
@@ -62,6 +65,7 @@ typedef enum {
 #define BOARD_PROMETHEUS_API            "http://10.10.99.99:59100/api/v1/query"
 #define BOARD_METRICS_UPDATE_INTERVAL   10000   // 数据更新间隔 (ms)
 #define BOARD_HTTP_TIMEOUT_MS           5000    // HTTP请求超时时间 (ms)
+#define BOARD_METRICS_DEADLINE_MS       4000    // 每个主机单次数据获取的截止时间 (ms，小于更新间隔)
 
 // 查询参数定义 - 根据实际API响应格式更新
 #define N305_TEMP_QUERY                 "node_hwmon_temp_celsius{chip=\"platform_coretemp_0\",sensor=\"temp1\"}"
@@ -72,6 +76,36 @@ typedef enum {
 #define JETSON_MEMORY_USED_QUERY        "ram_kB{statistic=\"used\"}"
 #define JSON_BUFFER_SIZE                2048    // JSON解析缓冲区大小
 
+// ========== 遥测条形图定义 ==========
+
+#define BOARD_BAR_MAX_SEGMENTS          8       // 最大分段数
+#define BOARD_BAR_SAMPLE_INTERVAL_MS    1000    // 条形图指标采样间隔 (ms)
+
+/**
+ * @brief 条形图指标
+ */
+typedef enum {
+    BOARD_BAR_METRIC_N305_TEMP = 0,     // N305 CPU温度 (°C)
+    BOARD_BAR_METRIC_JETSON_TEMP,       // Jetson CPU/GPU温度中较高者 (°C)
+    BOARD_BAR_METRIC_INPUT_POWER,       // XSP16电源芯片输入功率 (W)
+    BOARD_BAR_METRIC_NETWORK_LATENCY,   // 互联网ping延迟 (ms)
+    BOARD_BAR_METRIC_COUNT
+} board_bar_metric_t;
+
+/**
+ * @brief 条形图分段配置
+ */
+typedef struct {
+    board_bar_metric_t metric;      // 显示的指标
+    uint8_t first_led;              // 起始LED序号 (0-27)
+    uint8_t led_count;              // LED数量
+    bool reverse;                   // 是否从末端向起始端增长
+    float min_value;                // 空条对应的数值（指标单位）
+    float max_value;                // 满条对应的数值（指标单位）
+    bsp_led_rgb_t low_color;        // 起始端颜色
+    bsp_led_rgb_t high_color;       // 末端颜色
+} board_bar_segment_t;
+
 // ========== 配置结构体 ==========
 
 /**
@@ -81,8 +115,9 @@ typedef struct {
     bool auto_mode_enabled;          // 是否启用自动模式
     bool debug_mode;                 // 调试模式
     uint8_t brightness;              // LED亮度 (0-255)
-    uint32_t update_interval_ms;     // 状态更新间隔 (ms)
+    uint32_t update_interval_ms;     // 动画帧间隔 (ms)，静止画面不周期刷新
     uint32_t metrics_interval_ms;    // 监控数据获取间隔 (ms)
+    bool bar_graph_enabled;          // 无告警时显示遥测条形图（否则关闭灯带）
 } board_display_config_t;
 
 /**
@@ -110,6 +145,26 @@ typedef struct {
     uint32_t last_update_time;      // 上次更新时间
 } system_metrics_t;
 
+/**
+ * @brief 监控数据来源主机（每个主机由独立的任务并行获取）
+ */
+typedef enum {
+    BOARD_METRICS_HOST_N305 = 0,        // N305应用模块
+    BOARD_METRICS_HOST_JETSON,          // Jetson算力模块
+    BOARD_METRICS_HOST_COUNT
+} board_metrics_host_t;
+
+/**
+ * @brief 单个主机的数据获取统计
+ */
+typedef struct {
+    uint32_t fetch_count;           // 获取次数
+    uint32_t failure_count;         // 失败次数
+    uint32_t deadline_misses;       // 超过截止时间的次数
+    uint32_t last_latency_ms;       // 最近一次从开始获取到数据发布的耗时 (ms)
+    uint32_t max_latency_ms;        // 最大耗时 (ms)
+} board_metrics_fetch_stats_t;
+
 /**
  * @brief Board WS2812 显示状态
  */
@@ -120,6 +175,7 @@ typedef struct {
     uint32_t time_in_current_mode;          // 在当前模式的时间 (ms)
     bool is_active;                         // 是否激活
     system_metrics_t metrics;               // 系统监控数据
+    board_metrics_fetch_stats_t fetch_stats[BOARD_METRICS_HOST_COUNT]; // 各主机数据获取统计
     uint32_t system_uptime_ms;              // 系统运行时间
 } board_display_status_t;
 
@@ -228,6 +284,18 @@ esp_err_t bsp_board_ws2812_display_set_color(uint8_t r, uint8_t g, uint8_t b);
  */
 esp_err_t bsp_board_ws2812_display_set_breath(uint8_t r, uint8_t g, uint8_t b, board_breath_speed_t speed);
 
+/**
+ * @brief 设置遥测条形图分段布局
+ * 
+ * 默认布局为4段各7颗LED：N305温度、Jetson温度、输入功率、网络延迟。
+ * 新布局在下一帧生效。
+ * 
+ * @param segments 分段配置数组
+ * @param count 分段数量 (1-BOARD_BAR_MAX_SEGMENTS)
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_board_ws2812_display_set_bar_segments(const board_bar_segment_t* segments, uint8_t count);
+
 /**
  * @brief 关闭Board WS2812显示
  * 
@@ -250,6 +318,9 @@ esp_err_t bsp_board_ws2812_display_get_metrics(system_metrics_t* metrics);
  *  * 手动触发从Prometheus API获取最新的监控数据
  * 包括N305和Jetson的温度、功率、内存使用率等
  * 
+ * 在调用者任务中依次获取两个主机的数据，每个主机各有BOARD_METRICS_DEADLINE_MS
+ * 的截止时间。启动后的后台监控由每个主机独立的任务并行获取，互不等待。
+ * 
  * @return ESP_OK 成功获取至少一组数据; ESP_FAIL 所有数据获取失败
  */
 esp_err_t bsp_board_ws2812_display_update_metrics(void);
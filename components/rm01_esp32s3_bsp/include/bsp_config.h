@@ -129,6 +129,23 @@ extern "C" {
 #define CONFIG_BSP_ANIMATION_TASK_PRIORITY 5
 #endif
 
+// ============ BSP LED渲染调速配置 ============
+
+// LED渲染全局CPU预算（单核百分比）
+#ifndef CONFIG_BSP_LED_CPU_BUDGET_PERCENT
+#define CONFIG_BSP_LED_CPU_BUDGET_PERCENT 10
+#endif
+
+// 呼吸等平滑动画的帧间隔（约30fps）
+#ifndef CONFIG_BSP_LED_ANIMATION_FRAME_INTERVAL_MS
+#define CONFIG_BSP_LED_ANIMATION_FRAME_INTERVAL_MS 33
+#endif
+
+// 静止画面时显示任务的模式轮询间隔
+#ifndef CONFIG_BSP_LED_STATIC_POLL_INTERVAL_MS
+#define CONFIG_BSP_LED_STATIC_POLL_INTERVAL_MS 1000
+#endif
+
 // ============ BSP网络配置 ============
 
 // 网络监控超时时间
@@ -141,6 +158,16 @@ extern "C" {
 #define CONFIG_BSP_NETWORK_MAX_RETRY_COUNT 3
 #endif
 
+// Prometheus查询连接池大小（保持的长连接数）
+#ifndef CONFIG_BSP_PROMETHEUS_POOL_SIZE
+#define CONFIG_BSP_PROMETHEUS_POOL_SIZE 2
+#endif
+
+// Prometheus长连接空闲关闭时间（需大于监控数据更新间隔，才能跨周期复用）
+#ifndef CONFIG_BSP_PROMETHEUS_IDLE_TIMEOUT_MS
+#define CONFIG_BSP_PROMETHEUS_IDLE_TIMEOUT_MS 30000
+#endif
+
 // ============ BSP错误恢复配置 ============
 
 // 启用自动错误恢复
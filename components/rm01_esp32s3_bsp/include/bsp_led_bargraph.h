@@ -0,0 +1,116 @@
+/**
+ * @file bsp_led_bargraph.h
+ * @brief 灯带条形图渲染器
+ *
+ * 把若干数值映射到灯带上可配置的分段：每段按数值点亮相应长度，
+ * 末端LED按小数部分调节亮度；显示长度平滑逼近目标值，并在最高点保留峰值标记，
+ * 停留一段时间后缓慢回落。长度使用Q8定点（LED数×256），每帧只做整数运算。
+ *
+ * 不依赖ESP-IDF，可在主机上运行。
+ */
+
+#ifndef BSP_LED_BARGRAPH_H
+#define BSP_LED_BARGRAPH_H
+
+#include "bsp_led_effect.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+#define BSP_LED_BAR_MAX_SEGMENTS        8       // 最大分段数
+#define BSP_LED_BAR_SMOOTHING_MS        250     // 平滑时间常数（毫秒）
+#define BSP_LED_BAR_PEAK_HOLD_MS        1500    // 峰值标记停留时间（毫秒）
+#define BSP_LED_BAR_PEAK_DECAY_LEDS     4       // 峰值标记回落速度（LED/秒）
+
+/**
+ * @brief 分段配置
+ */
+typedef struct {
+    uint8_t first_led;              // 起始LED序号
+    uint8_t led_count;              // LED数量
+    bool reverse;                   // 是否从末端向起始端增长
+    int32_t min_value;              // 对应空条的数值
+    int32_t max_value;              // 对应满条的数值
+    bsp_led_rgb_t low_color;        // 起始端颜色
+    bsp_led_rgb_t high_color;       // 末端颜色（中间按位置渐变）
+} bsp_led_bar_segment_config_t;
+
+/**
+ * @brief 分段运行状态
+ */
+typedef struct {
+    bsp_led_bar_segment_config_t config;
+    bool valid;                     // 数值是否有效（无效时只微亮起始LED）
+    int32_t value;                  // 最近一次输入的数值
+    int32_t target_q8;              // 目标长度（LED数×256）
+    int32_t level_q8;               // 当前显示长度
+    int32_t peak_q8;                // 峰值标记位置
+    uint32_t peak_time_ms;          // 峰值刷新时间
+} bsp_led_bar_segment_t;
+
+/**
+ * @brief 条形图实例
+ */
+typedef struct {
+    bsp_led_bar_segment_t segments[BSP_LED_BAR_MAX_SEGMENTS];
+    uint8_t segment_count;
+    uint32_t frame_interval_ms;     // 动画期间的刷新间隔
+    uint32_t last_render_ms;        // 上一帧时间
+    bool rendered;                  // 是否已渲染过
+} bsp_led_bargraph_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 初始化条形图（无分段）
+ *
+ * @param bar 条形图实例
+ * @param frame_interval_ms 动画期间的刷新间隔
+ */
+void bsp_led_bargraph_init(bsp_led_bargraph_t *bar, uint32_t frame_interval_ms);
+
+/**
+ * @brief 设置分段布局，已有数值和峰值被清除
+ *
+ * @param bar 条形图实例
+ * @param configs 分段配置数组
+ * @param count 分段数量（不超过BSP_LED_BAR_MAX_SEGMENTS）
+ * @return bool 配置有效时返回true（led_count为0或max_value不大于min_value视为无效）
+ */
+bool bsp_led_bargraph_configure(bsp_led_bargraph_t *bar, const bsp_led_bar_segment_config_t *configs,
+                                uint8_t count);
+
+/**
+ * @brief 更新分段数值
+ *
+ * @param bar 条形图实例
+ * @param index 分段序号
+ * @param value 数值（超出范围时截断）
+ * @param valid 数值是否有效
+ */
+void bsp_led_bargraph_set_value(bsp_led_bargraph_t *bar, uint8_t index, int32_t value, bool valid);
+
+/**
+ * @brief 推进动画并渲染到像素缓冲区
+ *
+ * 不属于任何分段的LED保持不变。
+ *
+ * @param bar 条形图实例
+ * @param now_ms 当前时间（毫秒）
+ * @param pixels 像素缓冲区
+ * @param pixel_count 像素数量
+ * @return uint32_t 下一次需要刷新的毫秒数，BSP_LED_EFFECT_STATIC表示画面已稳定
+ */
+uint32_t bsp_led_bargraph_render(bsp_led_bargraph_t *bar, uint32_t now_ms,
+                                 bsp_led_rgb_t *pixels, uint16_t pixel_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_LED_BARGRAPH_H
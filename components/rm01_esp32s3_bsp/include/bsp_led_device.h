@@ -0,0 +1,260 @@
+/**
+ * @file bsp_led_device.h
+ * @brief LED设备抽象
+ *
+ * 一个LED设备由帧缓冲区和一个输出后端组成。使用者只修改帧缓冲区，刷新时
+ * 依次应用亮度上限和电流上限，再交给后端输出；帧缓冲区没有变化时跳过输出。
+ * 后端写入失败时立即关闭并重新打开后端重试（通常几毫秒内恢复）；仍然失败或
+ * 单帧输出超时则进入故障状态：之后的刷新立即返回，不阻塞渲染任务，由后台
+ * 按有界指数退避调用bsp_led_device_recover()重建后端并补发最近一帧。
+ * 所有设备共用同一套统计。
+ *
+ * 后端是一组函数指针（RMT灯带、主机测试用的模拟后端等），返回0表示成功，
+ * 其他值为后端错误码（RMT后端直接返回esp_err_t）。
+ *
+ * 不依赖ESP-IDF，也不加锁；多任务访问由bsp_led_hub负责。
+ * 可在主机上测试（tests/test_led_device.c）。
+ */
+
+#ifndef BSP_LED_DEVICE_H
+#define BSP_LED_DEVICE_H
+
+#include "bsp_led_effect.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+#define BSP_LED_CHANNEL_FULL_UA         20000   // 单个颜色通道满亮度电流（微安）
+#define BSP_LED_IDLE_UA                 700     // 每颗LED静态电流（微安）
+#define BSP_LED_FRAME_US_PER_LED        30      // WS2812每颗LED的传输时间（微秒）
+
+// 设备未处于故障状态，不需要恢复
+#define BSP_LED_DEVICE_NO_RECOVERY      UINT32_MAX
+
+// 设备层自身的错误码（与后端错误码区分，取负值）
+#define BSP_LED_DEVICE_ERR_INVALID_ARG  (-1)    // 参数无效
+#define BSP_LED_DEVICE_ERR_NOT_OPEN     (-2)    // 后端未打开
+#define BSP_LED_DEVICE_ERR_FAULTED      (-3)    // 设备处于故障状态，等待后台恢复
+
+/**
+ * @brief 输出后端
+ */
+typedef struct {
+    const char *name;                                           // 后端名称
+    int (*open)(void *ctx, uint16_t led_count);                 // 打开（分配硬件资源）
+    int (*write)(void *ctx, const bsp_led_rgb_t *pixels, uint16_t count); // 输出一帧
+    void (*close)(void *ctx);                                   // 关闭（释放硬件资源）
+} bsp_led_backend_t;
+
+/**
+ * @brief 设备配置
+ */
+typedef struct {
+    const char *name;                   // 设备名称
+    uint16_t led_count;                 // LED数量
+    uint8_t max_brightness;             // 亮度上限（Q8，255表示不限制）
+    uint32_t power_limit_ma;            // 电流上限（毫安，0表示不限制）
+    uint8_t max_retries;                // 写入失败后立即重新打开后端并重试的次数
+    uint32_t write_timeout_us;          // 单帧输出超时（微秒，0表示不检测）
+    uint32_t backoff_min_ms;            // 故障恢复首次重试间隔（毫秒）
+    uint32_t backoff_max_ms;            // 故障恢复最大重试间隔（毫秒）
+} bsp_led_device_config_t;
+
+/**
+ * @brief 设备统计
+ */
+typedef struct {
+    uint32_t refreshes;                 // 刷新请求次数
+    uint32_t writes;                    // 实际输出到后端的帧数
+    uint32_t skipped;                   // 帧缓冲区未变化而跳过的次数
+    uint32_t write_errors;              // 后端写入失败次数（含重试）
+    uint32_t reopens;                   // 重新打开后端的次数
+    uint32_t failed_frames;             // 重试后仍失败的帧数
+    uint32_t faults;                    // 进入故障状态的次数
+    uint32_t timeouts;                  // 单帧输出超时次数
+    uint32_t faulted_drops;             // 故障期间直接返回的刷新次数
+    uint32_t recoveries;                // 后台恢复成功次数
+    uint32_t recovery_failures;         // 后台恢复失败次数
+    uint32_t last_recovery_ms;          // 最近一次从故障到恢复的耗时（毫秒）
+    uint32_t max_recovery_ms;           // 从故障到恢复的最大耗时（毫秒）
+    uint32_t limited_frames;            // 因电流上限被降低亮度的帧数
+    uint32_t current_ma;                // 最近一帧的估算电流（毫安）
+    uint32_t peak_current_ma;           // 估算电流峰值（毫安，限制后）
+    int last_error;                     // 最近一次后端错误码
+    uint64_t write_us_total;            // 输出累计耗时（微秒，由调用者记录）
+    uint32_t write_us_max;              // 单帧输出最大耗时（微秒）
+} bsp_led_device_stats_t;
+
+/**
+ * @brief 设备实例
+ */
+typedef struct {
+    bsp_led_device_config_t config;
+    const bsp_led_backend_t *backend;
+    void *backend_ctx;
+    bool is_open;                       // 后端是否已打开
+    bsp_led_rgb_t *pixels;              // 帧缓冲区（使用者写入）
+    bsp_led_rgb_t *output;              // 输出缓冲区（应用亮度和电流限制后）
+    bool dirty;                         // 帧缓冲区或限制参数自上次输出后是否变化
+    bool faulted;                       // 是否处于故障状态
+    uint32_t fault_since_ms;            // 进入故障状态的时间
+    uint32_t retry_at_ms;               // 下一次恢复尝试的时间
+    uint32_t backoff_ms;                // 当前恢复重试间隔
+    bsp_led_device_stats_t stats;
+} bsp_led_device_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 获取默认设备配置
+ *
+ * 不限制亮度和电流；写入失败后立即重试1次；输出超时为理论传输时间的4倍加5毫秒；
+ * 故障恢复间隔从10毫秒开始翻倍，最长2秒。
+ *
+ * @param name 设备名称
+ * @param led_count LED数量
+ * @return bsp_led_device_config_t 默认配置
+ */
+bsp_led_device_config_t bsp_led_device_get_default_config(const char *name, uint16_t led_count);
+
+/**
+ * @brief 初始化设备并打开后端
+ *
+ * 帧缓冲区和输出缓冲区由调用者提供，各需要led_count个像素。
+ * 打开失败时设备进入故障状态并立即可以恢复，由bsp_led_device_recover()重试。
+ *
+ * @param dev 设备实例
+ * @param config 设备配置
+ * @param backend 输出后端
+ * @param backend_ctx 后端上下文
+ * @param pixels 帧缓冲区
+ * @param output 输出缓冲区
+ * @param now_ms 当前时间（毫秒）
+ * @return int 0成功，其他值为后端或设备层错误码
+ */
+int bsp_led_device_init(bsp_led_device_t *dev, const bsp_led_device_config_t *config,
+                        const bsp_led_backend_t *backend, void *backend_ctx,
+                        bsp_led_rgb_t *pixels, bsp_led_rgb_t *output, uint32_t now_ms);
+
+/**
+ * @brief 关闭后端
+ *
+ * @param dev 设备实例
+ */
+void bsp_led_device_deinit(bsp_led_device_t *dev);
+
+/**
+ * @brief 设置帧缓冲区中的一个像素
+ *
+ * @param dev 设备实例
+ * @param index LED序号
+ * @param color 颜色
+ * @return bool 序号有效时返回true
+ */
+bool bsp_led_device_set_pixel(bsp_led_device_t *dev, uint16_t index, bsp_led_rgb_t color);
+
+/**
+ * @brief 用同一颜色填充帧缓冲区
+ *
+ * @param dev 设备实例
+ * @param color 颜色
+ */
+void bsp_led_device_fill(bsp_led_device_t *dev, bsp_led_rgb_t color);
+
+/**
+ * @brief 整帧写入帧缓冲区
+ *
+ * @param dev 设备实例
+ * @param pixels 像素数据
+ * @param count 像素数量（超过LED数量的部分忽略，不足的部分保持不变）
+ */
+void bsp_led_device_write_frame(bsp_led_device_t *dev, const bsp_led_rgb_t *pixels, uint16_t count);
+
+/**
+ * @brief 标记帧缓冲区已被直接修改
+ *
+ * @param dev 设备实例
+ */
+void bsp_led_device_mark_dirty(bsp_led_device_t *dev);
+
+/**
+ * @brief 把帧缓冲区输出到后端
+ *
+ * 故障状态下不访问后端，保留帧缓冲区等待恢复后补发。
+ *
+ * @param dev 设备实例
+ * @param force 帧缓冲区未变化时也输出
+ * @param now_ms 当前时间（毫秒）
+ * @return int 0成功（含跳过），BSP_LED_DEVICE_ERR_FAULTED处于故障状态，其他值为后端错误码
+ */
+int bsp_led_device_refresh(bsp_led_device_t *dev, bool force, uint32_t now_ms);
+
+// ========== 故障恢复 ==========
+
+/**
+ * @brief 距下一次恢复尝试的时间
+ *
+ * @param dev 设备实例
+ * @param now_ms 当前时间（毫秒）
+ * @return uint32_t 等待时间（毫秒，0表示现在可以恢复），未处于故障状态返回BSP_LED_DEVICE_NO_RECOVERY
+ */
+uint32_t bsp_led_device_recovery_delay_ms(const bsp_led_device_t *dev, uint32_t now_ms);
+
+/**
+ * @brief 尝试从故障状态恢复：重新打开后端并补发最近一帧
+ *
+ * 失败时重试间隔翻倍（不超过backoff_max_ms）。
+ *
+ * @param dev 设备实例
+ * @param now_ms 当前时间（毫秒）
+ * @return int 0成功或未处于故障状态，其他值为后端错误码
+ */
+int bsp_led_device_recover(bsp_led_device_t *dev, uint32_t now_ms);
+
+// ========== 限制与统计 ==========
+
+/**
+ * @brief 设置亮度上限
+ *
+ * @param dev 设备实例
+ * @param max_brightness 亮度上限（Q8）
+ */
+void bsp_led_device_set_max_brightness(bsp_led_device_t *dev, uint8_t max_brightness);
+
+/**
+ * @brief 设置电流上限
+ *
+ * @param dev 设备实例
+ * @param power_limit_ma 电流上限（毫安，0表示不限制）
+ */
+void bsp_led_device_set_power_limit(bsp_led_device_t *dev, uint32_t power_limit_ma);
+
+/**
+ * @brief 估算一帧的电流
+ *
+ * @param pixels 像素数据
+ * @param count 像素数量
+ * @return uint32_t 估算电流（微安，含静态电流）
+ */
+uint32_t bsp_led_device_estimate_current_ua(const bsp_led_rgb_t *pixels, uint16_t count);
+
+/**
+ * @brief 记录一次输出耗时（由加锁层测量），超过输出超时则进入故障状态
+ *
+ * @param dev 设备实例
+ * @param elapsed_us 耗时（微秒）
+ * @param now_ms 当前时间（毫秒）
+ * @return bool 输出超时返回true
+ */
+bool bsp_led_device_record_write_time(bsp_led_device_t *dev, uint32_t elapsed_us, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_LED_DEVICE_H
@@ -0,0 +1,155 @@
+/**
+ * @file bsp_led_effect.h
+ * @brief 状态灯整数效果引擎
+ *
+ * Touch WS2812和Board WS2812共用的灯效计算：常亮、闪烁、呼吸、脉冲、渐变和彩虹。
+ * 全部使用整数运算：正弦来自查表（四分之一周期65项，线性插值），
+ * 亮度为Q8（0-255，255表示原值）。每颗LED持有一个效果实例，
+ * 按当前时间计算颜色并返回下一次需要刷新的时间，可直接交给LED渲染调速器。
+ *
+ * 不依赖ESP-IDF，可在主机上测试（tests/test_led_effect.c）。
+ */
+
+#ifndef BSP_LED_EFFECT_H
+#define BSP_LED_EFFECT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 类型定义 ==========
+
+// 画面静止，与BSP_LED_DEADLINE_STATIC取值相同
+#define BSP_LED_EFFECT_STATIC           UINT32_MAX
+
+/**
+ * @brief 效果类型
+ */
+typedef enum {
+    BSP_LED_EFFECT_SOLID = 0,       // 常亮
+    BSP_LED_EFFECT_BLINK,           // 闪烁：亮、灭各持续period_ms
+    BSP_LED_EFFECT_BREATH,          // 呼吸：亮度按正弦变化，周期period_ms
+    BSP_LED_EFFECT_PULSE,           // 脉冲：呼吸亮度再平方，峰值更尖、暗段更长
+    BSP_LED_EFFECT_FADE,            // 渐变：period_ms内从color线性过渡到color2后保持
+    BSP_LED_EFFECT_RAINBOW,         // 彩虹：色相循环一周为period_ms
+    BSP_LED_EFFECT_COUNT
+} bsp_led_effect_type_t;
+
+/**
+ * @brief RGB颜色
+ */
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} bsp_led_rgb_t;
+
+/**
+ * @brief 效果实例（每颗LED一个）
+ */
+typedef struct {
+    bsp_led_effect_type_t type;     // 效果类型
+    bsp_led_rgb_t color;            // 主颜色（渐变起始颜色）
+    bsp_led_rgb_t color2;           // 渐变目标颜色
+    uint32_t period_ms;             // 周期/闪烁半周期/渐变时长
+    uint32_t start_ms;              // 效果开始时间
+    uint32_t frame_interval_ms;     // 连续变化的效果的刷新间隔
+} bsp_led_effect_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 初始化效果实例（常亮关闭）
+ *
+ * @param effect 效果实例
+ * @param frame_interval_ms 呼吸、脉冲、渐变、彩虹的刷新间隔
+ */
+void bsp_led_effect_init(bsp_led_effect_t *effect, uint32_t frame_interval_ms);
+
+/**
+ * @brief 设置效果
+ *
+ * 参数与当前效果相同时保持相位不变，可以在每一帧重复调用。
+ *
+ * @param effect 效果实例
+ * @param type 效果类型
+ * @param color 主颜色
+ * @param color2 渐变目标颜色（其他效果忽略）
+ * @param period_ms 周期（毫秒），0按常亮处理
+ * @param now_ms 当前时间（毫秒）
+ * @return bool 效果被重新开始时返回true
+ */
+bool bsp_led_effect_set(bsp_led_effect_t *effect, bsp_led_effect_type_t type,
+                        bsp_led_rgb_t color, bsp_led_rgb_t color2,
+                        uint32_t period_ms, uint32_t now_ms);
+
+/**
+ * @brief 从头重新开始当前效果
+ *
+ * @param effect 效果实例
+ * @param now_ms 当前时间（毫秒）
+ */
+void bsp_led_effect_restart(bsp_led_effect_t *effect, uint32_t now_ms);
+
+/**
+ * @brief 计算当前颜色
+ *
+ * @param effect 效果实例
+ * @param now_ms 当前时间（毫秒）
+ * @param out 输出颜色
+ * @return uint32_t 距离下一次颜色变化的毫秒数，BSP_LED_EFFECT_STATIC表示不再变化
+ */
+uint32_t bsp_led_effect_render(const bsp_led_effect_t *effect, uint32_t now_ms, bsp_led_rgb_t *out);
+
+// ========== 整数运算工具 ==========
+
+/**
+ * @brief 正弦查表
+ *
+ * @param phase 相位，65536为一整周
+ * @return int16_t sin值×255（-255到255）
+ */
+int16_t bsp_led_effect_sin(uint16_t phase);
+
+/**
+ * @brief 呼吸亮度曲线 (sin+1)/2
+ *
+ * @param phase 相位，65536为一整周；0对应中间亮度并开始变亮
+ * @return uint8_t Q8亮度
+ */
+uint8_t bsp_led_effect_breath_level(uint16_t phase);
+
+/**
+ * @brief Q8缩放 value×level/255（level为255时返回原值）
+ *
+ * @param value 原始值
+ * @param level Q8亮度
+ * @return uint8_t 缩放后的值
+ */
+uint8_t bsp_led_effect_scale8(uint8_t value, uint8_t level);
+
+/**
+ * @brief 按Q8亮度缩放颜色
+ *
+ * @param color 原始颜色
+ * @param level Q8亮度
+ * @return bsp_led_rgb_t 缩放后的颜色
+ */
+bsp_led_rgb_t bsp_led_effect_scale_rgb(bsp_led_rgb_t color, uint8_t level);
+
+/**
+ * @brief 色相转换为满饱和满亮度的颜色
+ *
+ * @param hue 色相，256为一整圈（0红、85绿、170蓝）
+ * @return bsp_led_rgb_t 颜色
+ */
+bsp_led_rgb_t bsp_led_effect_hue(uint8_t hue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_LED_EFFECT_H
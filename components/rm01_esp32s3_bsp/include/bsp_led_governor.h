@@ -0,0 +1,119 @@
+/**
+ * @file bsp_led_governor.h
+ * @brief LED渲染帧率调速器
+ *
+ * 统一管理LED Matrix、Touch WS2812、Board WS2812三路渲染的帧率：
+ * 每个渲染器在完成一帧后声明下一次需要刷新的时间（或声明画面静止），
+ * 调速器根据全局LED CPU预算决定实际等待时间，并统计请求帧率与实际帧率。
+ * 静止内容不再周期性刷新，空闲CPU让给网络和HTTP任务。
+ */
+
+#ifndef BSP_LED_GOVERNOR_H
+#define BSP_LED_GOVERNOR_H
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+// 渲染器标识
+typedef enum {
+    BSP_LED_RENDERER_MATRIX = 0,        // LED Matrix Logo动画
+    BSP_LED_RENDERER_TOUCH,             // Touch WS2812状态灯
+    BSP_LED_RENDERER_BOARD,             // Board WS2812状态灯带
+    BSP_LED_RENDERER_MAX
+} bsp_led_renderer_t;
+
+// 画面静止：在模式变化前不需要再次刷新
+#define BSP_LED_DEADLINE_STATIC         UINT32_MAX
+
+// 渲染器统计信息
+typedef struct {
+    uint32_t requested_interval_ms;     // 渲染器最近声明的帧间隔（BSP_LED_DEADLINE_STATIC表示静止）
+    uint32_t granted_interval_ms;       // 调速器最近批准的帧间隔
+    uint32_t requested_fps_x10;         // 请求帧率（x10）
+    uint32_t achieved_fps_x10;          // 最近统计窗口的实际帧率（x10）
+    uint32_t avg_frame_cost_us;         // 平均单帧耗时（微秒）
+    uint32_t max_frame_cost_us;         // 最大单帧耗时（微秒）
+    uint32_t total_frames;              // 累计渲染帧数
+    uint32_t throttled_frames;          // 因超出CPU预算被拉长间隔的帧数
+    uint32_t static_declarations;       // 声明画面静止的次数
+} bsp_led_governor_stats_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 初始化LED渲染调速器（可重复调用）
+ *
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_governor_init(void);
+
+/**
+ * @brief 标记一帧渲染开始
+ *
+ * @param renderer 渲染器标识
+ * @return int64_t 帧开始时间戳（微秒），传给bsp_led_governor_frame_end()
+ */
+int64_t bsp_led_governor_frame_begin(bsp_led_renderer_t renderer);
+
+/**
+ * @brief 标记一帧渲染结束并声明下一次刷新期限
+ *
+ * @param renderer 渲染器标识
+ * @param begin_us bsp_led_governor_frame_begin()返回的时间戳
+ * @param requested_interval_ms 距下一帧的期望间隔，BSP_LED_DEADLINE_STATIC表示画面静止
+ * @return uint32_t 批准的等待时间（毫秒），静止时返回BSP_LED_DEADLINE_STATIC
+ */
+uint32_t bsp_led_governor_frame_end(bsp_led_renderer_t renderer, int64_t begin_us,
+                                    uint32_t requested_interval_ms);
+
+// ========== 配置接口 ==========
+
+/**
+ * @brief 设置LED渲染全局CPU预算
+ *
+ * @param percent 单核CPU占用百分比上限 (1-100)
+ */
+void bsp_led_governor_set_budget(uint8_t percent);
+
+/**
+ * @brief 获取LED渲染全局CPU预算
+ *
+ * @return uint8_t 单核CPU占用百分比上限
+ */
+uint8_t bsp_led_governor_get_budget(void);
+
+// ========== 状态查询接口 ==========
+
+/**
+ * @brief 获取指定渲染器的统计信息
+ *
+ * @param renderer 渲染器标识
+ * @param stats 统计信息输出
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_governor_get_stats(bsp_led_renderer_t renderer, bsp_led_governor_stats_t* stats);
+
+/**
+ * @brief 获取LED渲染当前预估CPU负载
+ *
+ * @return uint32_t 负载（千分比，单核）
+ */
+uint32_t bsp_led_governor_get_load_permille(void);
+
+/**
+ * @brief 打印所有渲染器的帧率与CPU统计
+ */
+void bsp_led_governor_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_LED_GOVERNOR_H
@@ -0,0 +1,184 @@
+/**
+ * @file bsp_led_hub.h
+ * @brief LED设备注册中心
+ *
+ * 三路WS2812灯带（LED Matrix、Touch、Board）统一注册为bsp_led_device设备，
+ * 由注册中心分配帧缓冲区并为每个设备加锁。使用者通过设备标识修改帧缓冲区
+ * 并提交刷新；初始化重试、写入失败后的重建、亮度和电流上限、统计信息
+ * 都由设备层统一处理；输出失败或超时的设备由后台任务恢复，不阻塞使用者。
+ * 设备标识顺序与bsp_led_renderer_t一致。
+ */
+
+#ifndef BSP_LED_HUB_H
+#define BSP_LED_HUB_H
+
+#include "esp_err.h"
+#include "bsp_led_device.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+// 设备标识
+typedef enum {
+    BSP_LED_DEVICE_MATRIX = 0,          // LED Matrix (GPIO 9)
+    BSP_LED_DEVICE_TOUCH,               // Touch WS2812 (GPIO 45)
+    BSP_LED_DEVICE_ONBOARD,             // Board WS2812 (GPIO 42)
+    BSP_LED_DEVICE_MAX
+} bsp_led_device_id_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 注册LED设备并打开后端
+ *
+ * 帧缓冲区由注册中心分配。后端打开失败时不等待重试：设备以故障状态注册并
+ * 返回ESP_OK，由后台恢复任务按退避间隔重建，期间的刷新返回ESP_ERR_INVALID_STATE。
+ *
+ * @param id 设备标识
+ * @param config 设备配置
+ * @param backend 输出后端
+ * @param backend_ctx 后端上下文（注册期间必须保持有效）
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_hub_register(bsp_led_device_id_t id, const bsp_led_device_config_t *config,
+                               const bsp_led_backend_t *backend, void *backend_ctx);
+
+/**
+ * @brief 注销LED设备，关闭后端并释放帧缓冲区
+ *
+ * @param id 设备标识
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_hub_unregister(bsp_led_device_id_t id);
+
+/**
+ * @brief 查询设备是否已注册
+ *
+ * @param id 设备标识
+ * @return bool 已注册返回true
+ */
+bool bsp_led_hub_is_registered(bsp_led_device_id_t id);
+
+/**
+ * @brief 获取设备LED数量
+ *
+ * @param id 设备标识
+ * @return uint16_t LED数量，未注册返回0
+ */
+uint16_t bsp_led_hub_get_led_count(bsp_led_device_id_t id);
+
+/**
+ * @brief 设置帧缓冲区中的一个像素（不刷新）
+ *
+ * @param id 设备标识
+ * @param index LED序号
+ * @param color 颜色
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_hub_set_pixel(bsp_led_device_id_t id, uint16_t index, bsp_led_rgb_t color);
+
+/**
+ * @brief 用同一颜色填充帧缓冲区（不刷新）
+ *
+ * @param id 设备标识
+ * @param color 颜色
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_hub_fill(bsp_led_device_id_t id, bsp_led_rgb_t color);
+
+/**
+ * @brief 整帧写入帧缓冲区并刷新
+ *
+ * @param id 设备标识
+ * @param pixels 像素数据
+ * @param count 像素数量
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_hub_submit(bsp_led_device_id_t id, const bsp_led_rgb_t *pixels, uint16_t count);
+
+/**
+ * @brief 把帧缓冲区输出到灯带（帧缓冲区未变化时跳过）
+ *
+ * @param id 设备标识
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_hub_refresh(bsp_led_device_id_t id);
+
+/**
+ * @brief 熄灭全部LED并立即输出
+ *
+ * @param id 设备标识
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_hub_clear(bsp_led_device_id_t id);
+
+/**
+ * @brief 锁定设备并直接访问帧缓冲区
+ *
+ * 成功后必须调用bsp_led_hub_unlock()。适合整帧变换后原地写入的使用者，
+ * 可以省去一份中间帧。
+ *
+ * @param id 设备标识
+ * @param timeout_ms 等待锁的超时时间（毫秒）
+ * @param pixels 帧缓冲区输出
+ * @param count LED数量输出
+ * @return esp_err_t ESP_OK成功，ESP_ERR_TIMEOUT等待超时，其他值表示失败
+ */
+esp_err_t bsp_led_hub_lock(bsp_led_device_id_t id, uint32_t timeout_ms,
+                           bsp_led_rgb_t **pixels, uint16_t *count);
+
+/**
+ * @brief 刷新帧缓冲区并解锁设备
+ *
+ * @param id 设备标识
+ * @param modified 锁定期间是否修改了帧缓冲区（未修改且无其他变化时跳过输出）
+ * @return esp_err_t ESP_OK成功，其他值为刷新失败的错误码
+ */
+esp_err_t bsp_led_hub_unlock(bsp_led_device_id_t id, bool modified);
+
+// ========== 配置接口 ==========
+
+/**
+ * @brief 设置设备亮度上限
+ *
+ * @param id 设备标识
+ * @param max_brightness 亮度上限（Q8，255表示不限制）
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_hub_set_max_brightness(bsp_led_device_id_t id, uint8_t max_brightness);
+
+/**
+ * @brief 设置设备电流上限
+ *
+ * @param id 设备标识
+ * @param power_limit_ma 电流上限（毫安，0表示不限制）
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_hub_set_power_limit(bsp_led_device_id_t id, uint32_t power_limit_ma);
+
+// ========== 统计接口 ==========
+
+/**
+ * @brief 获取设备统计信息
+ *
+ * @param id 设备标识
+ * @param stats 统计信息输出
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_led_hub_get_stats(bsp_led_device_id_t id, bsp_led_device_stats_t *stats);
+
+/**
+ * @brief 打印所有已注册设备的统计信息
+ */
+void bsp_led_hub_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_LED_HUB_H
@@ -0,0 +1,51 @@
+/**
+ * @file bsp_led_mock.h
+ * @brief LED设备模拟后端
+ *
+ * 记录每次输出的帧并可以注入打开/写入失败，用于在主机单元测试中
+ * 验证LED使用者的输出，而不需要真实灯带。只由测试直接编译，不包含在固件中。
+ */
+
+#ifndef BSP_LED_MOCK_H
+#define BSP_LED_MOCK_H
+
+#include "bsp_led_device.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BSP_LED_MOCK_MAX_LEDS           1024    // 可记录的最大LED数量（与LED矩阵相同）
+#define BSP_LED_MOCK_ERR_INJECTED       0x103   // 注入失败时返回的错误码（与ESP_ERR_INVALID_STATE取值相同）
+
+/**
+ * @brief 模拟后端上下文
+ */
+typedef struct {
+    bsp_led_rgb_t frame[BSP_LED_MOCK_MAX_LEDS]; // 最近一次输出的帧
+    uint16_t led_count;                 // 打开时的LED数量
+    bool is_open;                       // 是否处于打开状态
+    uint32_t opens;                     // 打开次数
+    uint32_t closes;                    // 关闭次数
+    uint32_t writes;                    // 成功输出的帧数
+    uint32_t fail_opens;                // 接下来需要失败的打开次数
+    uint32_t fail_writes;               // 接下来需要失败的写入次数
+} bsp_led_mock_t;
+
+// 模拟后端
+extern const bsp_led_backend_t BSP_LED_MOCK_BACKEND;
+
+/**
+ * @brief 初始化模拟后端上下文
+ *
+ * @param mock 模拟后端上下文
+ */
+void bsp_led_mock_init(bsp_led_mock_t *mock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_LED_MOCK_H
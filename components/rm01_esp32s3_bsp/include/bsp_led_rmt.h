@@ -0,0 +1,38 @@
+/**
+ * @file bsp_led_rmt.h
+ * @brief LED设备RMT灯带后端
+ *
+ * 基于led_strip组件的RMT驱动，供bsp_led_hub注册WS2812灯带使用。
+ */
+
+#ifndef BSP_LED_RMT_H
+#define BSP_LED_RMT_H
+
+#include "bsp_led_device.h"
+#include "led_strip.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RMT后端上下文
+ */
+typedef struct {
+    int gpio_num;                       // 数据引脚
+    bool with_dma;                      // 是否使用DMA
+    uint32_t mem_block_symbols;         // RMT内存块大小，0使用驱动默认值
+    uint32_t settle_ms;                 // 创建后等待RMT驱动就绪的时间
+    led_strip_handle_t handle;          // 打开后的灯带句柄
+} bsp_led_rmt_ctx_t;
+
+// RMT灯带后端
+extern const bsp_led_backend_t BSP_LED_RMT_BACKEND;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_LED_RMT_H
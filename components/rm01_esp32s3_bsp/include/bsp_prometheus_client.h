@@ -0,0 +1,151 @@
+/**
+ * @file bsp_prometheus_client.h
+ * @brief Prometheus查询客户端（长连接池）
+ *
+ * 维护到Prometheus服务器的少量HTTP/1.1长连接，查询之间和监控周期之间复用
+ * TCP连接，避免每次查询都重新握手。空闲超过设定时间的连接主动关闭；启用
+ * TCP keep-alive探测发现失效的对端；复用的连接请求失败时重新建立连接并重试一次。
+ * 响应正文可以写入缓冲区，也可以边接收边交给调用者（配合bsp_prometheus_scanner
+ * 流式解析，不需要缓存整个响应）。
+ */
+
+#ifndef BSP_PROMETHEUS_CLIENT_H
+#define BSP_PROMETHEUS_CLIENT_H
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置结构体 ==========
+
+/**
+ * @brief 客户端配置
+ */
+typedef struct {
+    const char *base_url;               // 查询API地址，如 http://host:port/api/v1/query（必须设置）
+    uint8_t max_connections;            // 连接池大小 (默认CONFIG_BSP_PROMETHEUS_POOL_SIZE)
+    uint32_t timeout_ms;                // 单次请求超时 (默认5000ms)
+    uint32_t idle_timeout_ms;           // 空闲连接关闭时间 (默认CONFIG_BSP_PROMETHEUS_IDLE_TIMEOUT_MS)
+} bsp_prometheus_client_config_t;
+
+/**
+ * @brief 客户端统计
+ */
+typedef struct {
+    uint32_t queries;                   // 查询次数
+    uint32_t failures;                  // 失败次数
+    uint32_t handshakes;                // 新建TCP连接次数
+    uint32_t reused;                    // 复用已有连接完成的查询次数
+    uint32_t stale_retries;             // 复用连接失效后重连重试的次数
+    uint32_t idle_closes;               // 因空闲超时主动关闭的连接数
+    uint32_t truncated;                 // 响应超过缓冲区被截断的次数
+    uint32_t deadline_misses;           // 截止时间前未完成的次数
+    uint32_t bytes_received;            // 累计接收的响应正文字节数
+    uint32_t last_latency_us;           // 最近一次查询耗时（微秒）
+    uint32_t max_latency_us;            // 最大查询耗时（微秒）
+    uint64_t total_latency_us;          // 累计查询耗时（微秒）
+    uint8_t open_connections;           // 当前保持的连接数
+} bsp_prometheus_client_stats_t;
+
+/**
+ * @brief 响应正文回调
+ *
+ * 每收到一块正文调用一次。每次发送请求前（包括复用连接失效后的重试）先以
+ * data为NULL、len为0调用一次，接收方应丢弃之前收到的内容。
+ *
+ * @param ctx 调用者上下文
+ * @param data 正文数据
+ * @param len 数据长度
+ */
+typedef void (*bsp_prometheus_client_data_cb_t)(void *ctx, const char *data, size_t len);
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 初始化客户端（创建连接池，连接在首次查询时建立）
+ *
+ * @param config 配置参数，base_url必须设置
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_prometheus_client_init(const bsp_prometheus_client_config_t *config);
+
+/**
+ * @brief 关闭所有连接并释放连接池
+ */
+void bsp_prometheus_client_deinit(void);
+
+/**
+ * @brief 执行一次即时查询
+ *
+ * 从连接池取一个连接发送 GET base_url?query=...，响应正文写入response并以'\0'结尾。
+ * 多个任务可以并发查询，连接池用尽时等待至超时。
+ *
+ * @param query PromQL查询语句
+ * @param response 响应缓冲区
+ * @param response_size 缓冲区大小
+ * @return esp_err_t ESP_OK成功，ESP_ERR_TIMEOUT等待连接超时，其他值表示失败
+ */
+esp_err_t bsp_prometheus_client_query(const char *query, char *response, size_t response_size);
+
+/**
+ * @brief 执行一次即时查询，响应正文边接收边交给回调
+ *
+ * 回调在查询任务中同步调用；非200响应的正文同样交给回调，但返回错误。
+ *
+ * @param query PromQL查询语句
+ * @param on_data 正文回调
+ * @param ctx 回调上下文
+ * @return esp_err_t ESP_OK成功，ESP_ERR_TIMEOUT等待连接超时，其他值表示失败
+ */
+esp_err_t bsp_prometheus_client_query_stream(const char *query, bsp_prometheus_client_data_cb_t on_data, void *ctx);
+
+/**
+ * @brief 在截止时间前执行一次即时查询，响应正文边接收边交给回调
+ *
+ * 与bsp_prometheus_client_query_stream()相同，但等待空闲连接和每次发送请求的超时
+ * 都不超过截止时间的剩余部分，截止时间已过时不再重连重试。多个任务各自设置截止
+ * 时间并发查询，一个慢查询不影响其他任务。超时按套接字读写计算，服务器持续缓慢
+ * 发送正文时实际耗时可能略超过截止时间。
+ *
+ * @param query PromQL查询语句
+ * @param deadline_us 截止时间（esp_timer_get_time()时间，微秒），0表示只使用配置的请求超时
+ * @param on_data 正文回调
+ * @param ctx 回调上下文
+ * @return esp_err_t ESP_OK成功，ESP_ERR_TIMEOUT等待连接超时或截止时间前未完成，其他值表示失败
+ */
+esp_err_t bsp_prometheus_client_query_stream_until(const char *query, int64_t deadline_us,
+                                                   bsp_prometheus_client_data_cb_t on_data, void *ctx);
+
+// ========== 统计接口 ==========
+
+/**
+ * @brief 获取客户端统计
+ *
+ * @param stats 统计信息输出
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_prometheus_client_get_stats(bsp_prometheus_client_stats_t *stats);
+
+/**
+ * @brief 打印客户端统计信息
+ */
+void bsp_prometheus_client_print_stats(void);
+
+// ========== 配置接口 ==========
+
+/**
+ * @brief 获取默认配置（base_url为空，需要调用者设置）
+ *
+ * @return bsp_prometheus_client_config_t 默认配置
+ */
+bsp_prometheus_client_config_t bsp_prometheus_client_get_default_config(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_PROMETHEUS_CLIENT_H
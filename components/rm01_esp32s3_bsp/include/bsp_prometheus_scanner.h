@@ -0,0 +1,168 @@
+/**
+ * @file bsp_prometheus_scanner.h
+ * @brief Prometheus查询响应流式扫描器
+ *
+ * 边接收边扫描 /api/v1/query 返回的JSON，不缓存响应正文、不建树、不分配内存：
+ * 只提取 status、data.resultType、error，以及 data.result 中每个序列的一个指定
+ * 标签值和样本数值 value[1]。每个序列扫描完成时通过回调交给调用者。
+ *
+ * 正文可以按任意长度分块输入。提取的字符串长度有上限，超长时标记为无效而
+ * 不会越界；嵌套层数超过上限、语法错误或正文不完整时返回相应错误。
+ * 其余字段只做语法检查后跳过。
+ *
+ * 不依赖ESP-IDF，可在主机上测试（tests/test_prometheus_scanner.c）。
+ */
+
+#ifndef BSP_PROMETHEUS_SCANNER_H
+#define BSP_PROMETHEUS_SCANNER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+#define BSP_PROM_SCANNER_MAX_DEPTH      8       // 最大嵌套层数（即时查询响应为5层）
+#define BSP_PROM_SCANNER_KEY_LEN        24      // 字段名最大长度
+#define BSP_PROM_SCANNER_STATUS_LEN     16      // status、resultType最大长度
+#define BSP_PROM_SCANNER_LABEL_LEN      32      // 标签值最大长度
+#define BSP_PROM_SCANNER_VALUE_LEN      32      // 样本数值字符串最大长度
+#define BSP_PROM_SCANNER_ERROR_LEN      64      // error最大长度（超长时截断，仅用于日志）
+
+/**
+ * @brief 扫描结果
+ */
+typedef enum {
+    BSP_PROM_SCAN_OK = 0,               // 完整扫描一个JSON文档
+    BSP_PROM_SCAN_IN_PROGRESS,          // 文档尚未结束（扫描过程中）
+    BSP_PROM_SCAN_ERR_TRUNCATED,        // 正文在文档结束前中断
+    BSP_PROM_SCAN_ERR_SYNTAX,           // JSON语法错误
+    BSP_PROM_SCAN_ERR_DEPTH,            // 嵌套层数超过上限
+} bsp_prom_scan_result_t;
+
+/**
+ * @brief 序列回调
+ *
+ * 字符串不以0结尾。序列没有指定标签或标签值超长时label为NULL；
+ * 没有value[1]或数值字符串超长时value_len为0。
+ *
+ * @param ctx 调用者上下文
+ * @param label 标签值
+ * @param label_len 标签值长度
+ * @param value 样本数值字符串
+ * @param value_len 数值字符串长度
+ */
+typedef void (*bsp_prom_scanner_series_cb_t)(void *ctx, const char *label, size_t label_len,
+                                             const char *value, size_t value_len);
+
+/**
+ * @brief 扫描器实例（约250字节，可放在栈上）
+ */
+typedef struct {
+    // 配置
+    const char *label_name;             // 需要提取的标签名
+    bsp_prom_scanner_series_cb_t on_series;
+    void *ctx;
+
+    // 词法和结构状态
+    uint8_t state;                      // 词法状态
+    uint8_t escape;                     // 字符串转义状态
+    uint8_t capture;                    // 当前字符串的提取目标
+    uint8_t depth;                      // 当前嵌套层数
+    uint8_t roles[BSP_PROM_SCANNER_MAX_DEPTH]; // 每层容器的角色
+    uint8_t value_index;                // 当前value数组中的元素序号
+    uint8_t literal_word;               // 当前字面量：数字或true/false/null
+    uint8_t literal_len;                // 当前字面量已扫描的长度
+    bsp_prom_scan_result_t result;
+
+    // 当前字段名
+    char key[BSP_PROM_SCANNER_KEY_LEN];
+    uint8_t key_len;
+    bool key_overflow;
+
+    // 提取结果（以0结尾；超长的status/resultType/标签/数值视为无效，error截断）
+    char status[BSP_PROM_SCANNER_STATUS_LEN];           // "success" 或 "error"
+    char result_type[BSP_PROM_SCANNER_STATUS_LEN];      // "vector"、"matrix"等
+    char error[BSP_PROM_SCANNER_ERROR_LEN];             // 查询失败时的错误信息
+    char label[BSP_PROM_SCANNER_LABEL_LEN];             // 当前序列的标签值
+    char value[BSP_PROM_SCANNER_VALUE_LEN];             // 当前序列的样本数值
+    uint8_t status_len;
+    uint8_t result_type_len;
+    uint8_t error_len;
+    uint8_t label_len;
+    uint8_t value_len;
+    bool status_overflow;
+    bool result_type_overflow;
+    bool label_found;                   // 当前序列含有指定标签且未超长
+    bool value_found;                   // 当前序列含有value[1]且未超长
+
+    // 统计
+    uint16_t series;                    // 已扫描的序列数
+    uint32_t bytes;                     // 已输入的字节数
+} bsp_prom_scanner_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 初始化扫描器
+ *
+ * @param scanner 扫描器实例
+ * @param label_name 需要提取的标签名（NULL表示不提取标签）
+ * @param on_series 序列回调（可以为NULL）
+ * @param ctx 回调上下文
+ */
+void bsp_prom_scanner_init(bsp_prom_scanner_t *scanner, const char *label_name,
+                           bsp_prom_scanner_series_cb_t on_series, void *ctx);
+
+/**
+ * @brief 重置扫描状态和提取结果，准备扫描新的响应（保留配置）
+ *
+ * @param scanner 扫描器实例
+ */
+void bsp_prom_scanner_reset(bsp_prom_scanner_t *scanner);
+
+/**
+ * @brief 输入一块响应正文
+ *
+ * 出错后的输入被忽略。
+ *
+ * @param scanner 扫描器实例
+ * @param data 正文数据
+ * @param len 数据长度
+ * @return bsp_prom_scan_result_t 文档未结束返回BSP_PROM_SCAN_IN_PROGRESS，已结束返回BSP_PROM_SCAN_OK，出错返回错误
+ */
+bsp_prom_scan_result_t bsp_prom_scanner_feed(bsp_prom_scanner_t *scanner, const char *data, size_t len);
+
+/**
+ * @brief 正文接收完毕，获取最终结果
+ *
+ * @param scanner 扫描器实例
+ * @return bsp_prom_scan_result_t 完整扫描返回BSP_PROM_SCAN_OK，文档未结束返回BSP_PROM_SCAN_ERR_TRUNCATED
+ */
+bsp_prom_scan_result_t bsp_prom_scanner_finish(bsp_prom_scanner_t *scanner);
+
+/**
+ * @brief 响应的status是否为"success"
+ *
+ * @param scanner 扫描器实例
+ * @return bool 是否成功
+ */
+bool bsp_prom_scanner_is_success(const bsp_prom_scanner_t *scanner);
+
+/**
+ * @brief 获取扫描结果名称（用于日志）
+ *
+ * @param result 扫描结果
+ * @return const char* 名称
+ */
+const char *bsp_prom_scanner_result_name(bsp_prom_scan_result_t result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_PROMETHEUS_SCANNER_H
@@ -0,0 +1,110 @@
+/**
+ * @file bsp_promql_batch.h
+ * @brief PromQL批量查询
+ *
+ * 把多条即时查询合并成一条PromQL表达式，一次HTTP请求取回全部指标：
+ * 每条查询用label_replace()加上标签 rm01_query="<序号>"，再用 or 连接。
+ * 各条查询的序列带有不同的标签值，or 不会丢弃任何一条。
+ * 响应中的每个序列按该标签分拣回对应查询；同一查询返回多个序列时取第一个，
+ * 与单独查询时取result[0]的行为一致。
+ *
+ * 不依赖ESP-IDF，也不解析JSON：调用者遍历响应中的序列，把标签值和数值字符串
+ * 交给bsp_promql_batch_feed()。可在主机上测试（tests/test_promql_batch.c）。
+ */
+
+#ifndef BSP_PROMQL_BATCH_H
+#define BSP_PROMQL_BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置定义 ==========
+
+#define BSP_PROMQL_BATCH_MAX_QUERIES    8               // 单个批次最多合并的查询数
+#define BSP_PROMQL_BATCH_LABEL          "rm01_query"    // 标记查询序号的标签名
+
+/**
+ * @brief 批量查询实例
+ */
+typedef struct {
+    const char *queries[BSP_PROMQL_BATCH_MAX_QUERIES];  // 各条查询（调用者保证生命周期）
+    uint8_t count;                                      // 查询数量
+    float values[BSP_PROMQL_BATCH_MAX_QUERIES];         // 各查询的结果
+    bool valid[BSP_PROMQL_BATCH_MAX_QUERIES];           // 各查询是否有有效结果
+    uint8_t received;                                   // 有有效结果的查询数
+    uint16_t series;                                    // 本次响应的序列总数
+    uint16_t ignored;                                   // 无法分拣、重复或数值无效的序列数
+} bsp_promql_batch_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 初始化批量查询（清空查询和结果）
+ *
+ * @param batch 批量查询实例
+ */
+void bsp_promql_batch_init(bsp_promql_batch_t *batch);
+
+/**
+ * @brief 添加一条查询
+ *
+ * @param batch 批量查询实例
+ * @param query PromQL即时查询表达式
+ * @return int 查询序号（结果按此序号读取），批次已满或参数无效返回-1
+ */
+int bsp_promql_batch_add(bsp_promql_batch_t *batch, const char *query);
+
+/**
+ * @brief 生成合并后的PromQL表达式
+ *
+ * 格式: label_replace(<查询0>,"rm01_query","0","","") or label_replace(<查询1>,...) ...
+ *
+ * @param batch 批量查询实例
+ * @param out 输出缓冲区
+ * @param out_size 输出缓冲区大小
+ * @return int 表达式长度（不含结尾0），没有查询或缓冲区不足返回-1
+ */
+int bsp_promql_batch_build(const bsp_promql_batch_t *batch, char *out, size_t out_size);
+
+/**
+ * @brief 清空上一次的结果，准备分拣新的响应
+ *
+ * @param batch 批量查询实例
+ */
+void bsp_promql_batch_clear_results(bsp_promql_batch_t *batch);
+
+/**
+ * @brief 分拣响应中的一个序列
+ *
+ * 标签值不是本批次的序号、该查询已有结果、或数值不是有限数（NaN、±Inf）时忽略。
+ *
+ * @param batch 批量查询实例
+ * @param tag rm01_query标签值（不要求以0结尾，NULL表示序列没有该标签）
+ * @param tag_len 标签值长度
+ * @param value 样本数值字符串（不要求以0结尾）
+ * @param value_len 数值字符串长度
+ * @return bool 序列被采用时返回true
+ */
+bool bsp_promql_batch_feed(bsp_promql_batch_t *batch, const char *tag, size_t tag_len,
+                           const char *value, size_t value_len);
+
+/**
+ * @brief 读取一条查询的结果
+ *
+ * @param batch 批量查询实例
+ * @param index 查询序号
+ * @param value 结果输出
+ * @return bool 有有效结果时返回true
+ */
+bool bsp_promql_batch_get(const bsp_promql_batch_t *batch, int index, float *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_PROMQL_BATCH_H
@@ -10,6 +10,7 @@
 #define BSP_STATE_MANAGER_H
 
 #include "esp_err.h"
+#include "bsp_touch_gesture.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -62,6 +63,9 @@ typedef struct {
     bool application_module_connected;  // 应用模组连接状态
     bool user_host_connected;           // 用户主机连接状态
     bool high_compute_load;             // 高负荷计算状态
+    uint32_t touch_gesture_count;       // 触摸手势次数
+    bsp_touch_gesture_t last_touch_gesture; // 最近一次触摸手势
+    uint32_t last_touch_time;           // 最近一次触摸手势时间（秒）
 } system_state_info_t;
 
 // 状态变化回调函数类型
@@ -131,6 +135,16 @@ void bsp_state_manager_update_now(void);
  */
 void bsp_state_manager_print_status(void);
 
+/**
+ * @brief 上报触摸按键手势
+ * 
+ * 由触摸按键驱动在识别出手势后调用，记录为用户输入事件
+ * 
+ * @param gesture 手势类型
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_state_manager_report_touch_gesture(bsp_touch_gesture_t gesture);
+
 // ========== 回调管理接口 ==========
 
 /**
@@ -0,0 +1,157 @@
+/**
+ * @file bsp_touch_gesture.h
+ * @brief 触摸按键手势识别
+ *
+ * 输入触摸外设的原始读数，完成基线跟踪、带滞回的阈值判定和消抖，
+ * 输出单击、长按和双击手势。触摸使读数升高（ESP32-S3触摸外设的特性），
+ * 判定阈值按基线的百分比计算，基线只在未触摸且读数低于唤醒阈值时缓慢跟随环境漂移。
+ * 唤醒阈值（低于按下阈值）对应硬件触摸中断阈值：中断唤醒后识别器保持活动，
+ * 直到读数回落到唤醒阈值以下，缓慢或轻微的按下不会在到达按下阈值前被丢弃。
+ *
+ * 不依赖ESP-IDF，可在主机上测试（tests/test_touch_gesture.c）。
+ */
+
+#ifndef BSP_TOUCH_GESTURE_H
+#define BSP_TOUCH_GESTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 类型定义 ==========
+
+/**
+ * @brief 手势类型
+ */
+typedef enum {
+    BSP_TOUCH_GESTURE_NONE = 0,     // 无手势
+    BSP_TOUCH_GESTURE_TAP,          // 单击（双击等待窗口结束后确认）
+    BSP_TOUCH_GESTURE_DOUBLE_TAP,   // 双击（第二次松开时确认）
+    BSP_TOUCH_GESTURE_LONG_PRESS,   // 长按（按住达到时长时立即确认）
+    BSP_TOUCH_GESTURE_COUNT
+} bsp_touch_gesture_t;
+
+/**
+ * @brief 识别参数
+ */
+typedef struct {
+    uint8_t touch_percent;          // 按下阈值：读数高于基线的百分比
+    uint8_t release_percent;        // 松开阈值（小于按下阈值，形成滞回）
+    uint8_t wake_percent;           // 唤醒阈值（硬件中断阈值，不大于按下阈值）
+    uint8_t debounce_samples;       // 按下/松开需连续满足的采样数
+    uint8_t baseline_shift;         // 基线跟随系数，每次移动差值的1/2^shift
+    uint32_t long_press_ms;         // 长按时长
+    uint32_t double_tap_ms;         // 双击等待窗口（第一次松开到第二次按下）
+} bsp_touch_gesture_config_t;
+
+/**
+ * @brief 识别状态
+ */
+typedef enum {
+    BSP_TOUCH_STATE_IDLE = 0,       // 空闲
+    BSP_TOUCH_STATE_PRESSED,        // 第一次按下
+    BSP_TOUCH_STATE_WAIT_SECOND,    // 已松开，等待第二次按下
+    BSP_TOUCH_STATE_SECOND_PRESSED, // 第二次按下
+    BSP_TOUCH_STATE_HELD,           // 长按已确认，等待松开
+} bsp_touch_state_t;
+
+/**
+ * @brief 手势识别器实例
+ */
+typedef struct {
+    bsp_touch_gesture_config_t config;
+    bsp_touch_state_t state;
+    uint32_t baseline;              // 基线读数
+    bool baseline_valid;            // 是否已有基线
+    bool touched;                   // 消抖后的触摸状态
+    bool woken;                     // 中断唤醒后读数尚未回落到唤醒阈值以下
+    uint8_t debounce_count;         // 与当前状态相反的连续采样数
+    uint32_t press_ms;              // 最近一次按下时间
+    uint32_t release_ms;            // 最近一次松开时间
+} bsp_touch_gesture_detector_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 获取默认识别参数
+ *
+ * @return bsp_touch_gesture_config_t 默认参数
+ */
+bsp_touch_gesture_config_t bsp_touch_gesture_get_default_config(void);
+
+/**
+ * @brief 初始化识别器
+ *
+ * @param detector 识别器实例
+ * @param config 识别参数，NULL使用默认参数
+ */
+void bsp_touch_gesture_init(bsp_touch_gesture_detector_t *detector, const bsp_touch_gesture_config_t *config);
+
+/**
+ * @brief 输入一个原始读数
+ *
+ * 第一次输入作为初始基线。
+ *
+ * @param detector 识别器实例
+ * @param raw 原始读数
+ * @param now_ms 采样时间（毫秒）
+ * @return bsp_touch_gesture_t 本次采样确认的手势，没有时返回BSP_TOUCH_GESTURE_NONE
+ */
+bsp_touch_gesture_t bsp_touch_gesture_feed(bsp_touch_gesture_detector_t *detector, uint32_t raw, uint32_t now_ms);
+
+/**
+ * @brief 通知硬件触摸中断
+ *
+ * ACTIVE中断（读数越过唤醒阈值）后识别器保持活动，直到INACTIVE中断或
+ * 读数回落到唤醒阈值以下。在输入中断后的第一个读数之前调用。
+ *
+ * @param detector 识别器实例
+ * @param active true为ACTIVE中断，false为INACTIVE中断
+ */
+void bsp_touch_gesture_notify_wake(bsp_touch_gesture_detector_t *detector, bool active);
+
+/**
+ * @brief 是否正在识别手势
+ *
+ * 中断唤醒后读数未回落、非空闲或消抖未完成时返回true，调用者此时需要继续
+ * 周期采样；返回false时可以停止采样，等待下一次触摸中断。
+ *
+ * @param detector 识别器实例
+ * @return bool 是否需要继续采样
+ */
+bool bsp_touch_gesture_is_active(const bsp_touch_gesture_detector_t *detector);
+
+/**
+ * @brief 按当前基线计算按下阈值对应的读数增量
+ *
+ * @param detector 识别器实例
+ * @return uint32_t 读数增量，尚无基线时返回0
+ */
+uint32_t bsp_touch_gesture_get_touch_delta(const bsp_touch_gesture_detector_t *detector);
+
+/**
+ * @brief 按当前基线计算唤醒阈值对应的读数增量
+ *
+ * 供驱动设置硬件触摸中断阈值。
+ *
+ * @param detector 识别器实例
+ * @return uint32_t 读数增量，尚无基线时返回0
+ */
+uint32_t bsp_touch_gesture_get_wake_delta(const bsp_touch_gesture_detector_t *detector);
+
+/**
+ * @brief 获取手势名称
+ *
+ * @param gesture 手势类型
+ * @return const char* 手势名称字符串
+ */
+const char *bsp_touch_gesture_get_name(bsp_touch_gesture_t gesture);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_TOUCH_GESTURE_H
@@ -11,6 +11,7 @@
 
 #include "esp_err.h"
 #include "bsp_state_manager.h"
+#include "bsp_touch_gesture.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -55,6 +56,14 @@ typedef enum {
     BREATH_SPEED_FAST           // 快速呼吸 (1000ms周期)
 } breath_speed_t;
 
+// ========== 事件定义 ==========
+
+// 唤醒显示任务的事件位（可按位或组合）
+#define TOUCH_DISPLAY_EVENT_NETWORK     (1UL << 0)  // 网络适配器报告连接状态变化
+#define TOUCH_DISPLAY_EVENT_STATE       (1UL << 1)  // 系统状态管理器状态变化
+#define TOUCH_DISPLAY_EVENT_CONFIG      (1UL << 3)  // 显示模式或配置被修改
+#define TOUCH_DISPLAY_EVENT_GESTURE     (1UL << 4)  // 触摸按键识别到手势
+
 // ========== 配置结构体 ==========
 
 /**
@@ -85,6 +94,19 @@ typedef struct {
     uint32_t system_uptime_ms;            // 系统运行时间
 } touch_display_status_t;
 
+/**
+ * @brief 显示任务运行统计（任务启动以来）
+ */
+typedef struct {
+    uint32_t wakeups;                     // 总唤醒次数
+    uint32_t event_wakeups;               // 由事件唤醒的次数
+    uint32_t timer_wakeups;               // 由动画帧或模式阈值超时唤醒的次数
+    uint32_t run_time_ms;                 // 统计时长（毫秒）
+    uint64_t busy_us;                     // 唤醒后处理累计耗时（微秒）
+    uint32_t wakeups_per_sec_x100;        // 平均每秒唤醒次数（×100）
+    uint32_t busy_us_per_sec;             // 平均每秒CPU耗时（微秒）
+} touch_display_task_stats_t;
+
 // ========== 核心接口 ==========
 
 /**
@@ -137,6 +159,35 @@ void bsp_touch_ws2812_display_update(void);
  */
 esp_err_t bsp_touch_ws2812_display_get_status(touch_display_status_t* status);
 
+/**
+ * @brief 通知显示任务重新评估显示模式
+ *
+ * 显示任务启动后通过网络适配器和状态管理器的回调接收变化，其他模块无需调用；
+ * 配置接口和触摸按键手势也通过它唤醒任务。任务未运行时忽略。
+ * 只能在任务上下文中调用。
+ *
+ * @param events TOUCH_DISPLAY_EVENT_* 事件位
+ */
+void bsp_touch_ws2812_display_notify(uint32_t events);
+
+/**
+ * @brief 显示触摸手势反馈
+ *
+ * 在当前显示模式之上短暂叠加反馈灯效（单击短亮、双击两次闪烁、长按渐暗），
+ * 结束后恢复当前模式。由触摸按键驱动调用；任务未运行时忽略。
+ *
+ * @param gesture 手势类型
+ */
+void bsp_touch_ws2812_display_show_gesture(bsp_touch_gesture_t gesture);
+
+/**
+ * @brief 获取显示任务运行统计
+ *
+ * @param stats 统计信息输出
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_touch_ws2812_display_get_task_stats(touch_display_task_stats_t* stats);
+
 /**
  * @brief 打印显示状态信息
  */
@@ -0,0 +1,99 @@
+/**
+ * @file bsp_touchpad.h
+ * @brief 电容触摸按键驱动
+ *
+ * 使用ESP32-S3触摸外设读取BSP_TOUCHPAD_PIN上的触摸按键。触摸外设在硬件定时器
+ * 模式下自行测量，读数越过阈值时触发中断唤醒驱动任务；任务只在识别手势期间
+ * 周期采样，空闲时阻塞等待中断，仅按较长间隔刷新基线和中断阈值。
+ * 识别出的单击、双击、长按手势发布给状态管理器和Touch WS2812显示控制器。
+ */
+
+#ifndef BSP_TOUCHPAD_H
+#define BSP_TOUCHPAD_H
+
+#include "esp_err.h"
+#include "bsp_touch_gesture.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========== 配置结构体 ==========
+
+/**
+ * @brief 触摸按键驱动配置
+ */
+typedef struct {
+    bsp_touch_gesture_config_t gesture;     // 手势识别参数
+    uint32_t sample_interval_ms;            // 识别手势期间的采样间隔 (默认20ms)
+    uint32_t baseline_interval_ms;          // 空闲时刷新基线和中断阈值的间隔 (默认10秒)
+} bsp_touchpad_config_t;
+
+/**
+ * @brief 触摸按键运行状态
+ */
+typedef struct {
+    bool is_running;                        // 驱动任务是否运行
+    bool touched;                           // 当前是否按下（消抖后）
+    uint32_t baseline;                      // 当前基线读数
+    uint32_t last_raw;                      // 最近一次读数
+    uint32_t interrupt_threshold;           // 当前硬件中断阈值（相对基线的增量）
+    uint32_t interrupts;                    // 触摸中断次数
+    uint32_t samples;                       // 采样次数
+    uint32_t gesture_counts[BSP_TOUCH_GESTURE_COUNT]; // 各手势识别次数
+    bsp_touch_gesture_t last_gesture;       // 最近一次手势
+} bsp_touchpad_status_t;
+
+// ========== 核心接口 ==========
+
+/**
+ * @brief 初始化触摸按键
+ *
+ * 配置触摸外设通道、滤波和中断，建立初始基线。
+ *
+ * @param config 配置参数，NULL使用默认配置
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_touchpad_init(const bsp_touchpad_config_t *config);
+
+/**
+ * @brief 启动触摸按键驱动任务并使能触摸中断
+ *
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_touchpad_start(void);
+
+/**
+ * @brief 停止触摸按键驱动任务并关闭触摸中断
+ */
+void bsp_touchpad_stop(void);
+
+/**
+ * @brief 获取触摸按键运行状态
+ *
+ * @param status 状态信息输出
+ * @return esp_err_t ESP_OK成功，其他值表示失败
+ */
+esp_err_t bsp_touchpad_get_status(bsp_touchpad_status_t *status);
+
+/**
+ * @brief 打印触摸按键状态信息
+ */
+void bsp_touchpad_print_status(void);
+
+// ========== 配置接口 ==========
+
+/**
+ * @brief 获取默认配置
+ *
+ * @return bsp_touchpad_config_t 默认配置
+ */
+bsp_touchpad_config_t bsp_touchpad_get_default_config(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_TOUCHPAD_H
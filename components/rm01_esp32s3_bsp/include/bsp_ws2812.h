@@ -1,7 +1,7 @@
 #pragma once
 
 #include "esp_err.h"
-#include "led_strip.h"
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -15,7 +15,7 @@ extern "C" {
 #define BSP_WS2812_Touch_LED_PIN    45
 #define BSP_WS2812_Touch_LED_COUNT  1
 
-// 注意：GPIO 9 的LED矩阵由led_matrix模块独立管理，不在此处定义
+// 注意：GPIO 9 的LED矩阵由led_matrix模块注册到LED设备注册中心（bsp_led_hub），不在此处定义
 
 /**
  * @brief WS2812 LED句柄类型定义
@@ -102,12 +102,14 @@ esp_err_t bsp_ws2812_refresh(bsp_ws2812_type_t type);
 esp_err_t bsp_ws2812_clear(bsp_ws2812_type_t type);
 
 /**
- * @brief 获取WS2812句柄
- * 
+ * @brief 查询WS2812是否已初始化
+ *
+ * 灯带暂时故障（等待后台恢复）时仍视为已初始化。
+ *
  * @param type WS2812类型
- * @return LED strip句柄，如果未初始化则返回NULL
+ * @return true已初始化，false未初始化
  */
-led_strip_handle_t bsp_ws2812_get_handle(bsp_ws2812_type_t type);
+bool bsp_ws2812_is_initialized(bsp_ws2812_type_t type);
 
 /**
  * @brief 板载LED测试函数
@@ -19,6 +19,9 @@
 #include "bsp_state_manager.h"      // 状态管理器
 #include "bsp_display_controller.h" // 显示控制器
 #include "bsp_touch_ws2812_display.h" // Touch WS2812显示控制器
+#include "bsp_led_governor.h"         // LED渲染调速器
+#include "bsp_led_hub.h"              // LED设备注册中心
+#include "bsp_touchpad.h"             // 电容触摸按键
 
 static const char *TAG = "BSP";
 
@@ -173,7 +176,8 @@ esp_err_t bsp_board_init(void) {
     ESP_LOGI(TAG, "Touch WS2812上电指示灯已启动（白色常亮表示系统正常上电）");    // ============ 第二阶段：LED矩阵和基础硬件初始化 ============
     ESP_LOGI(TAG, "第二阶段：LED矩阵和基础硬件初始化");
     
-    // 直接初始化LED Matrix Logo Display Controller（内部会处理基础硬件初始化）
+    // 初始化LED Matrix Logo Display Controller：启动时立即返回，LED矩阵硬件初始化、
+    // TF卡挂载和动画加载在后台任务中进行，不阻塞电源、网络和Web服务器的初始化
     ESP_LOGI(TAG, "初始化LED Matrix Logo Display Controller");
     ret = led_matrix_logo_display_init(NULL);
     if (ret != ESP_OK) {
@@ -186,7 +190,7 @@ esp_err_t bsp_board_init(void) {
         if (ret != ESP_OK) {
             ESP_LOGW(TAG, "LED Matrix Logo Display服务启动失败: %s", esp_err_to_name(ret));
         } else {
-            ESP_LOGI(TAG, "LED Matrix Logo Display服务已启动，开始显示Logo");
+            ESP_LOGI(TAG, "LED Matrix Logo Display服务已在后台启动");
         }
     }
 
@@ -270,7 +274,18 @@ esp_err_t bsp_board_init(void) {
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "网络适配器初始化失败: %s", esp_err_to_name(ret));
         return ret;
-    }      
+    }
+    
+    // 初始化触摸按键（手势发布给状态管理器和Touch WS2812显示控制器）
+    ESP_LOGI(TAG, "初始化触摸按键");
+    ret = bsp_touchpad_init(NULL);
+    if (ret == ESP_OK) {
+        ret = bsp_touchpad_start();
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "触摸按键启动失败，但继续运行: %s", esp_err_to_name(ret));
+    }
+    
     // 设置启动状态指示（使用LED Matrix Logo Display Controller）
     esp_err_t led_ret = led_matrix_logo_display_set_mode(LOGO_DISPLAY_MODE_SINGLE);
     if (led_ret == ESP_OK) {
@@ -506,6 +521,12 @@ void bsp_board_print_performance_stats(void) {
     ESP_LOGI(TAG, "电源波动计数: %" PRIu32, bsp_stats.power_fluctuations);
     ESP_LOGI(TAG, "动画帧渲染: %" PRIu32, bsp_stats.animation_frames_rendered);
     ESP_LOGI(TAG, "================");
+    
+    // LED渲染请求帧率与实际帧率
+    bsp_led_governor_print_stats();
+    
+    // LED设备输出、重建和电流统计
+    bsp_led_hub_print_stats();
 }
 
 void bsp_board_reset_performance_stats(void) {
@@ -5,6 +5,7 @@
  * 基于优先级的系统状态监控显示： * - 高温: 红色慢速呼吸 (高优先级) 
  * - 功率过高: 紫色快速呼吸 (中优先级)
  * - 内存高使用率: 紫色慢速呼吸 (低优先级)
+ * - 无告警: 遥测条形图
  *  * 通过Prometheus API获取N305和Jetson监控数据
  * 支持温度、功率、内存使用率监控
  */
@@ -12,33 +13,31 @@
 #include "bsp_board_ws2812_display.h"
 #include "bsp_ws2812.h"
 #include "network_monitor.h"
+#include "bsp_led_governor.h"
+#include "bsp_led_effect.h"
+#include "bsp_led_bargraph.h"
+#include "bsp_power.h"
+#include "bsp_config.h"
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_timer.h"
-#include "esp_http_client.h"
+#include "bsp_prometheus_client.h"
+#include "bsp_promql_batch.h"
+#include "bsp_prometheus_scanner.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "sdkconfig.h"
-#include "cJSON.h"
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 static const char *TAG = "BOARD_WS2812_DISP";
 
 // ========== 颜色定义 ==========
 
-typedef struct {
-    uint8_t r;
-    uint8_t g;
-    uint8_t b;
-} rgb_color_t;
+typedef bsp_led_rgb_t rgb_color_t;
 
 // 预定义颜色 - Board WS2812专用于系统状态监控
 static const rgb_color_t COLOR_RED = {255, 0, 0};      // 红色 - 高温警告
@@ -46,6 +45,54 @@ static const rgb_color_t COLOR_PURPLE = {128, 0, 128}; // 紫色 - 功率警告
 static const rgb_color_t COLOR_WHITE = {255, 255, 255}; // 白色 - 内存警告
 static const rgb_color_t COLOR_OFF = {0, 0, 0};        // 关闭
 
+// 条形图数值按指标单位×1000转为整数
+#define BAR_VALUE_SCALE         1000.0f
+
+// 停止时等待任务退出的时间：进行中的查询最迟在截止时间后结束
+#define TASK_STOP_TIMEOUT_MS    (BOARD_METRICS_DEADLINE_MS + 1000)
+
+// 连接诊断查询的截止时间（较短，用于快速测试）
+#define CONNECTIVITY_TEST_TIMEOUT_MS    2000
+
+// 默认条形图布局：4段各7颗LED
+static const board_bar_segment_t DEFAULT_BAR_SEGMENTS[] = {
+    {BOARD_BAR_METRIC_N305_TEMP,       0,  7, false, 30.0f, 100.0f, {0, 255, 0}, {255, 0, 0}},
+    {BOARD_BAR_METRIC_JETSON_TEMP,     7,  7, false, 30.0f, 90.0f,  {0, 255, 0}, {255, 0, 0}},
+    {BOARD_BAR_METRIC_INPUT_POWER,     14, 7, false, 0.0f,  150.0f, {0, 0, 255}, {255, 0, 255}},
+    {BOARD_BAR_METRIC_NETWORK_LATENCY, 21, 7, false, 0.0f,  200.0f, {0, 255, 255}, {255, 255, 0}},
+};
+
+// ========== Prometheus查询定义 ==========
+
+#define PROMQL_BATCH_MAX_LENGTH 768     // 合并后PromQL表达式的最大长度
+
+// N305温度候选查询，按优先级排列，取第一个有合理数值的结果。
+// 最后一项不带过滤条件会匹配全部传感器，取最大值只返回一个序列，避免撑满共用的响应缓冲区
+static const char* N305_TEMP_QUERIES[] = {
+    N305_TEMP_QUERY,
+    "node_hwmon_temp_celsius{chip=\"coretemp-isa-0000\",sensor=\"temp1\"}",
+    "node_thermal_zone_temp{zone=\"thermal_zone0\"}",
+    "max(node_hwmon_temp_celsius)"
+};
+
+// Jetson批量查询中各指标的序号
+typedef enum {
+    JETSON_METRIC_CPU_TEMP = 0,
+    JETSON_METRIC_GPU_TEMP,
+    JETSON_METRIC_POWER,
+    JETSON_METRIC_MEMORY_TOTAL,
+    JETSON_METRIC_MEMORY_USED,
+    JETSON_METRIC_COUNT
+} jetson_metric_t;
+
+static const char* JETSON_QUERIES[JETSON_METRIC_COUNT] = {
+    [JETSON_METRIC_CPU_TEMP]     = JETSON_CPU_TEMP_QUERY,
+    [JETSON_METRIC_GPU_TEMP]     = JETSON_GPU_TEMP_QUERY,
+    [JETSON_METRIC_POWER]        = JETSON_POWER_QUERY,
+    [JETSON_METRIC_MEMORY_TOTAL] = JETSON_MEMORY_TOTAL_QUERY,
+    [JETSON_METRIC_MEMORY_USED]  = JETSON_MEMORY_USED_QUERY,
+};
+
 // ========== 显示控制器状态结构 ==========
 
 typedef struct {
@@ -55,19 +102,32 @@ typedef struct {
     bool manual_mode;
     SemaphoreHandle_t status_mutex;
     TaskHandle_t display_task_handle;
-    TaskHandle_t metrics_task_handle;
-    bool task_running;
+    TaskHandle_t metrics_task_handles[BOARD_METRICS_HOST_COUNT];   // 每个主机一个数据获取任务
+    volatile bool task_running;
+    SemaphoreHandle_t task_exit_sem;    // 任务结束循环时释放，停止时等待任务自行结束
+    int tasks_alive;                    // 已创建但尚未结束循环的任务数
     
     // 动画状态
     uint32_t animation_start_time;
-    uint32_t last_update_time;
-    uint8_t breath_brightness;          // 呼吸灯亮度
-    bool breath_increasing;             // 呼吸灯方向
-    
-    // HTTP客户端状态
-    char* n305_response_buffer;
-    char* jetson_response_buffer;
-    size_t buffer_size;
+    bsp_led_effect_t effects[BSP_WS2812_ONBOARD_COUNT];     // 每颗LED的灯效
+    
+    // 遥测条形图
+    bsp_led_bargraph_t bar_graph;
+    board_bar_segment_t bar_segments[BOARD_BAR_MAX_SEGMENTS];
+    uint8_t bar_segment_count;
+    bool bar_layout_dirty;              // 布局已修改，由显示任务在下一帧应用
+    bool bar_sampled;
+    uint32_t bar_last_sample_ms;
+    
+    // 最近一次写入灯带的颜色，用于跳过重复刷新
+    rgb_color_t last_colors[BSP_WS2812_ONBOARD_COUNT];
+    bool last_color_valid;
+    
+    // PromQL批量查询：N305温度候选查询和Jetson各项指标各合并为一次请求
+    bsp_promql_batch_t n305_batch;
+    bsp_promql_batch_t jetson_batch;
+    char n305_batch_query[PROMQL_BATCH_MAX_LENGTH];
+    char jetson_batch_query[PROMQL_BATCH_MAX_LENGTH];
 } board_display_controller_t;
 
 // 全局控制器实例
@@ -78,26 +138,57 @@ static const char* MODE_NAMES[] = {
     "关闭状态",
     "高温警告",
     "功率过高",
-    "内存高使用率"
+    "内存高使用率",
+    "遥测条形图"
 };
 
 // ========== 静态函数声明 ==========
 
 static bool is_board_display_initialized(void);
+static bool stop_tasks(void);
+static void park_exited_task(void);
 static void board_display_task(void *pvParameters);
-static void metrics_collection_task(void *pvParameters);
+static void metrics_host_task(void *pvParameters);
+static esp_err_t update_host_metrics(board_metrics_host_t host);
 static board_display_mode_t determine_display_mode(void);
-static void execute_display_mode(board_display_mode_t mode);
+static uint32_t execute_display_mode(board_display_mode_t mode);
 static void set_board_led_color_all(uint8_t r, uint8_t g, uint8_t b);
-static void handle_breath_animation(const rgb_color_t* color, board_breath_speed_t speed);
+static uint32_t handle_breath_animation(const rgb_color_t* color, board_breath_speed_t speed);
+static uint32_t run_effect_all(bsp_led_effect_type_t type, const rgb_color_t* color, uint32_t period_ms);
+static uint32_t render_effects(uint32_t now_ms);
+static void write_strip(const rgb_color_t* colors);
+static uint32_t handle_bar_graph(void);
+static void apply_bar_layout(void);
+static void sample_bar_metrics(void);
+static void wake_display_task(void);
 static uint32_t get_time_ms(void);
-static uint8_t apply_brightness(uint8_t color_value, uint8_t brightness);
 
 // Prometheus数据解析相关
-static esp_err_t fetch_n305_temperature(system_metrics_t* metrics);
-static esp_err_t fetch_jetson_metrics(system_metrics_t* metrics);
-static esp_err_t query_prometheus_api(const char* base_url, const char* query, char* response_buffer, size_t buffer_size);
-static esp_err_t parse_prometheus_query_response(const char* response, float* value);
+static esp_err_t fetch_n305_temperature(system_metrics_t* metrics, int64_t deadline_us);
+static esp_err_t fetch_jetson_metrics(system_metrics_t* metrics, int64_t deadline_us);
+static void publish_n305_metrics(system_metrics_t* dst, const system_metrics_t* src);
+static void publish_jetson_metrics(system_metrics_t* dst, const system_metrics_t* src);
+static esp_err_t init_metric_batches(void);
+static esp_err_t query_metric_batch(bsp_promql_batch_t* batch, const char* query, int64_t deadline_us);
+static void on_batch_data(void* ctx, const char* data, size_t len);
+static void on_batch_series(void* ctx, const char* label, size_t label_len, const char* value, size_t value_len);
+static void on_probe_data(void* ctx, const char* data, size_t len);
+static void on_probe_series(void* ctx, const char* label, size_t label_len, const char* value, size_t value_len);
+
+// ========== 监控主机定义 ==========
+
+// 每个主机的数据获取和发布：获取写入临时数据，发布时只覆盖该主机的字段
+typedef struct {
+    const char* name;
+    const char* task_name;
+    esp_err_t (*fetch)(system_metrics_t* metrics, int64_t deadline_us);
+    void (*publish)(system_metrics_t* dst, const system_metrics_t* src);
+} metrics_host_desc_t;
+
+static const metrics_host_desc_t METRICS_HOSTS[BOARD_METRICS_HOST_COUNT] = {
+    [BOARD_METRICS_HOST_N305]   = {"N305", "board_metrics_n305", fetch_n305_temperature, publish_n305_metrics},
+    [BOARD_METRICS_HOST_JETSON] = {"Jetson", "board_metrics_jetson", fetch_jetson_metrics, publish_jetson_metrics},
+};
 
 // ========== 核心接口实现 ==========
 
@@ -110,11 +201,17 @@ esp_err_t bsp_board_ws2812_display_init(const board_display_config_t* config) {
     }
     
     // 检查Board WS2812是否已初始化
-    if (bsp_ws2812_get_handle(BSP_WS2812_ONBOARD) == NULL) {
+    if (!bsp_ws2812_is_initialized(BSP_WS2812_ONBOARD)) {
         ESP_LOGE(TAG, "Board WS2812未初始化，请先调用bsp_ws2812_init()");
         return ESP_ERR_INVALID_STATE;
     }
     
+    // 构造合并后的PromQL表达式（查询固定，只需构造一次）
+    esp_err_t batch_ret = init_metric_batches();
+    if (batch_ret != ESP_OK) {
+        return batch_ret;
+    }
+    
     // 创建互斥锁
     s_controller.status_mutex = xSemaphoreCreateMutex();
     if (s_controller.status_mutex == NULL) {
@@ -122,23 +219,31 @@ esp_err_t bsp_board_ws2812_display_init(const board_display_config_t* config) {
         return ESP_ERR_NO_MEM;
     }
     
+    // 显示任务和每个监控任务退出时各释放一次
+    s_controller.task_exit_sem = xSemaphoreCreateCounting(BOARD_METRICS_HOST_COUNT + 1, 0);
+    if (s_controller.task_exit_sem == NULL) {
+        ESP_LOGE(TAG, "创建任务退出信号量失败");
+        vSemaphoreDelete(s_controller.status_mutex);
+        return ESP_ERR_NO_MEM;
+    }
+    
     // 设置配置
     if (config != NULL) {
         s_controller.config = *config;
     } else {
         s_controller.config = bsp_board_ws2812_display_get_default_config();
     }
-      // 分配HTTP响应缓冲区 - 优化内存使用
-    s_controller.buffer_size = 4096;  // 4KB缓冲区，适合ESP32S3内存限制
-    s_controller.n305_response_buffer = malloc(s_controller.buffer_size);
-    s_controller.jetson_response_buffer = malloc(s_controller.buffer_size);
     
-    if (!s_controller.n305_response_buffer || !s_controller.jetson_response_buffer) {
-        ESP_LOGE(TAG, "分配HTTP响应缓冲区失败");
-        if (s_controller.n305_response_buffer) free(s_controller.n305_response_buffer);
-        if (s_controller.jetson_response_buffer) free(s_controller.jetson_response_buffer);
+    // Prometheus长连接池：查询之间和监控周期之间复用TCP连接
+    bsp_prometheus_client_config_t prom_config = bsp_prometheus_client_get_default_config();
+    prom_config.base_url = BOARD_PROMETHEUS_API;
+    prom_config.timeout_ms = BOARD_HTTP_TIMEOUT_MS;
+    esp_err_t prom_ret = bsp_prometheus_client_init(&prom_config);
+    if (prom_ret != ESP_OK) {
+        ESP_LOGE(TAG, "初始化Prometheus客户端失败: %s", esp_err_to_name(prom_ret));
+        vSemaphoreDelete(s_controller.task_exit_sem);
         vSemaphoreDelete(s_controller.status_mutex);
-        return ESP_ERR_NO_MEM;
+        return prom_ret;
     }
     
     // 初始化状态
@@ -149,9 +254,18 @@ esp_err_t bsp_board_ws2812_display_init(const board_display_config_t* config) {
     
     // 初始化动画状态
     s_controller.animation_start_time = get_time_ms();
-    s_controller.last_update_time = s_controller.animation_start_time;
-    s_controller.breath_brightness = 0;
-    s_controller.breath_increasing = true;
+    for (int i = 0; i < BSP_WS2812_ONBOARD_COUNT; i++) {
+        bsp_led_effect_init(&s_controller.effects[i], s_controller.config.update_interval_ms);
+    }
+    bsp_led_bargraph_init(&s_controller.bar_graph, s_controller.config.update_interval_ms);
+    memcpy(s_controller.bar_segments, DEFAULT_BAR_SEGMENTS, sizeof(DEFAULT_BAR_SEGMENTS));
+    s_controller.bar_segment_count = sizeof(DEFAULT_BAR_SEGMENTS) / sizeof(DEFAULT_BAR_SEGMENTS[0]);
+    s_controller.bar_layout_dirty = true;
+    s_controller.bar_sampled = false;
+    s_controller.last_color_valid = false;
+    
+    // 初始化LED渲染调速器
+    bsp_led_governor_init();
     
     // 初始化监控数据
     s_controller.status.metrics.n305_data_valid = false;
@@ -184,6 +298,12 @@ esp_err_t bsp_board_ws2812_display_start(void) {
         return ESP_OK;
     }
     
+    // 上次停止时未按时退出的任务仍持有连接池槽位，等它们结束后再启动
+    if (!stop_tasks()) {
+        ESP_LOGE(TAG, "上次停止的Board WS2812任务尚未退出");
+        return ESP_ERR_INVALID_STATE;
+    }
+    
     ESP_LOGI(TAG, "启动Board WS2812显示控制器");
     
     // 先设置标志位，确保任务不会立即退出
@@ -201,26 +321,30 @@ esp_err_t bsp_board_ws2812_display_start(void) {
     
     if (ret != pdPASS) {
         s_controller.task_running = false;
+        s_controller.display_task_handle = NULL;
         ESP_LOGE(TAG, "创建Board WS2812显示任务失败");
         return ESP_FAIL;
     }
-    
-    // 创建监控数据收集任务
-    ret = xTaskCreate(
-        metrics_collection_task,
-        "board_metrics_collection",
-        8192,  // 更大的堆栈用于HTTP请求
-        NULL,
-        3,  // 中等优先级
-        &s_controller.metrics_task_handle
-    );
-    
-    if (ret != pdPASS) {
-        s_controller.task_running = false;
-        vTaskDelete(s_controller.display_task_handle);
-        s_controller.display_task_handle = NULL;
-        ESP_LOGE(TAG, "创建监控数据收集任务失败");
-        return ESP_FAIL;
+    s_controller.tasks_alive++;
+    
+    // 每个主机创建一个监控数据收集任务，并行获取，一个主机无响应不影响另一个
+    for (int host = 0; host < BOARD_METRICS_HOST_COUNT; host++) {
+        ret = xTaskCreate(
+            metrics_host_task,
+            METRICS_HOSTS[host].task_name,
+            8192,  // 更大的堆栈用于HTTP请求
+            (void*)(uintptr_t)host,
+            3,  // 中等优先级
+            &s_controller.metrics_task_handles[host]
+        );
+        
+        if (ret != pdPASS) {
+            s_controller.metrics_task_handles[host] = NULL;
+            ESP_LOGE(TAG, "创建%s监控数据收集任务失败", METRICS_HOSTS[host].name);
+            stop_tasks();
+            return ESP_FAIL;
+        }
+        s_controller.tasks_alive++;
     }
     
     // 更新状态
@@ -241,17 +365,9 @@ void bsp_board_ws2812_display_stop(void) {
     
     ESP_LOGI(TAG, "停止Board WS2812显示控制器");
     
-    // 停止任务
-    s_controller.task_running = false;
-    
-    if (s_controller.display_task_handle != NULL) {
-        vTaskDelete(s_controller.display_task_handle);
-        s_controller.display_task_handle = NULL;
-    }
-    
-    if (s_controller.metrics_task_handle != NULL) {
-        vTaskDelete(s_controller.metrics_task_handle);
-        s_controller.metrics_task_handle = NULL;
+    // 停止任务：等待任务自行退出，不在查询中途删除（否则连接池槽位和互斥锁无法释放）
+    if (!stop_tasks()) {
+        ESP_LOGW(TAG, "部分任务未在 %d ms 内退出，下次启动前继续等待", TASK_STOP_TIMEOUT_MS);
     }
     
     // 关闭LED
@@ -290,10 +406,6 @@ esp_err_t bsp_board_ws2812_display_set_mode(board_display_mode_t mode) {
             s_controller.status.mode_change_count++;
             s_controller.animation_start_time = get_time_ms();
             
-            // 重置动画状态
-            s_controller.breath_brightness = 0;
-            s_controller.breath_increasing = true;
-            
             xSemaphoreGive(s_controller.status_mutex);
         }
         
@@ -302,12 +414,14 @@ esp_err_t bsp_board_ws2812_display_set_mode(board_display_mode_t mode) {
                  bsp_board_ws2812_display_get_mode_name(mode));
     }
     
+    wake_display_task();
     return ESP_OK;
 }
 
 void bsp_board_ws2812_display_resume_auto(void) {
     ESP_LOGI(TAG, "恢复Board WS2812自动模式");
     s_controller.manual_mode = false;
+    wake_display_task();
 }
 
 esp_err_t bsp_board_ws2812_display_get_status(board_display_status_t* status) {
@@ -362,7 +476,31 @@ void bsp_board_ws2812_display_print_status(void) {
         ESP_LOGI(TAG, "  Jetson功率: %.1f mW (%.2f W)", status.metrics.jetson_power_mw, status.metrics.jetson_power_mw/1000.0f);
         ESP_LOGI(TAG, "  Jetson内存使用率: %.1f%%", status.metrics.jetson_memory_usage);
     }
+    for (int host = 0; host < BOARD_METRICS_HOST_COUNT; host++) {
+        const board_metrics_fetch_stats_t* stats = &status.fetch_stats[host];
+        ESP_LOGI(TAG, "  %s获取: %lu 次, 失败 %lu 次, 超过截止时间 %lu 次, 耗时 最近 %lu ms / 最大 %lu ms",
+                 METRICS_HOSTS[host].name, stats->fetch_count, stats->failure_count, stats->deadline_misses,
+                 stats->last_latency_ms, stats->max_latency_ms);
+    }
+    
+    static const char* BAR_METRIC_NAMES[] = {"N305温度", "Jetson温度", "输入功率", "网络延迟"};
+    ESP_LOGI(TAG, "遥测条形图: %s", s_controller.config.bar_graph_enabled ? "启用" : "禁用");
+    for (uint8_t i = 0; i < s_controller.bar_graph.segment_count; i++) {
+        const board_bar_segment_t* seg = &s_controller.bar_segments[i];
+        const bsp_led_bar_segment_t* bar = &s_controller.bar_graph.segments[i];
+        if (bar->valid) {
+            ESP_LOGI(TAG, "  [%d-%d] %s: %.1f (范围 %.0f-%.0f, 点亮 %.1f 颗)",
+                     seg->first_led, seg->first_led + seg->led_count - 1, BAR_METRIC_NAMES[seg->metric],
+                     bar->value / BAR_VALUE_SCALE, seg->min_value, seg->max_value, bar->level_q8 / 256.0f);
+        } else {
+            ESP_LOGI(TAG, "  [%d-%d] %s: 无数据",
+                     seg->first_led, seg->first_led + seg->led_count - 1, BAR_METRIC_NAMES[seg->metric]);
+        }
+    }
     ESP_LOGI(TAG, "========================================");
+    
+    // 查询耗时与TCP握手/连接复用统计
+    bsp_prometheus_client_print_stats();
 }
 
 // ========== 配置接口实现 ==========
@@ -372,8 +510,9 @@ board_display_config_t bsp_board_ws2812_display_get_default_config(void) {
         .auto_mode_enabled = true,
         .debug_mode = true,             // 暂时启用调试模式以便排查问题
         .brightness = 255,              // 设置为最大亮度以便观察
-        .update_interval_ms = 200,      // 200ms显示更新间隔
-        .metrics_interval_ms = BOARD_METRICS_UPDATE_INTERVAL  // 10秒监控数据更新间隔
+        .update_interval_ms = CONFIG_BSP_LED_ANIMATION_FRAME_INTERVAL_MS,  // 呼吸动画帧间隔（约30fps）
+        .metrics_interval_ms = BOARD_METRICS_UPDATE_INTERVAL,  // 10秒监控数据更新间隔
+        .bar_graph_enabled = true       // 无告警时显示遥测条形图
     };
     return config;
 }
@@ -381,6 +520,7 @@ board_display_config_t bsp_board_ws2812_display_get_default_config(void) {
 void bsp_board_ws2812_display_set_auto_mode(bool enabled) {
     s_controller.config.auto_mode_enabled = enabled;
     ESP_LOGI(TAG, "Board WS2812自动模式设置为: %s", enabled ? "启用" : "禁用");
+    wake_display_task();
 }
 
 void bsp_board_ws2812_display_set_brightness(uint8_t brightness) {
@@ -412,7 +552,39 @@ esp_err_t bsp_board_ws2812_display_set_breath(uint8_t r, uint8_t g, uint8_t b, b
     }
     
     rgb_color_t color = {r, g, b};
-    handle_breath_animation(&color, speed);
+    (void)handle_breath_animation(&color, speed);
+    return ESP_OK;
+}
+
+esp_err_t bsp_board_ws2812_display_set_bar_segments(const board_bar_segment_t* segments, uint8_t count) {
+    if (!is_board_display_initialized()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (segments == NULL || count == 0 || count > BOARD_BAR_MAX_SEGMENTS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    for (uint8_t i = 0; i < count; i++) {
+        const board_bar_segment_t* seg = &segments[i];
+        if (seg->metric >= BOARD_BAR_METRIC_COUNT || seg->led_count == 0 ||
+            seg->first_led + seg->led_count > BSP_WS2812_ONBOARD_COUNT ||
+            !(seg->max_value > seg->min_value)) {
+            ESP_LOGE(TAG, "条形图分段%d配置无效", i);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    
+    if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    memcpy(s_controller.bar_segments, segments, count * sizeof(board_bar_segment_t));
+    s_controller.bar_segment_count = count;
+    s_controller.bar_layout_dirty = true;
+    xSemaphoreGive(s_controller.status_mutex);
+    
+    ESP_LOGI(TAG, "条形图布局已更新: %d 段", count);
+    wake_display_task();
     return ESP_OK;
 }
 
@@ -421,6 +593,7 @@ esp_err_t bsp_board_ws2812_display_off(void) {
         return ESP_ERR_INVALID_STATE;
     }
     
+    s_controller.last_color_valid = false;
     return bsp_ws2812_clear(BSP_WS2812_ONBOARD);
 }
 
@@ -447,53 +620,9 @@ esp_err_t bsp_board_ws2812_display_get_metrics(system_metrics_t* metrics) {
 esp_err_t bsp_board_ws2812_display_update_metrics(void) {
     ESP_LOGI(TAG, "手动更新监控数据");
     
-    system_metrics_t new_metrics = {0};
-    esp_err_t n305_result = ESP_FAIL;
-    esp_err_t jetson_result = ESP_FAIL;
-    
-    // 获取N305数据 - 使用Prometheus查询API
-    ESP_LOGI(TAG, "正在获取N305监控数据...");
-    n305_result = fetch_n305_temperature(&new_metrics);
-    
-    if (n305_result == ESP_OK) {
-        ESP_LOGI(TAG, "N305监控数据获取成功: CPU温度=%.1f°C", new_metrics.n305_cpu_temp);
-    } else {
-        ESP_LOGW(TAG, "N305数据获取失败");
-    }
-    
-    // 获取Jetson数据 - 同样使用Prometheus查询API
-    ESP_LOGI(TAG, "正在获取Jetson监控数据...");
-    jetson_result = fetch_jetson_metrics(&new_metrics);
-      if (jetson_result == ESP_OK) {
-        ESP_LOGI(TAG, "Jetson监控数据获取成功: CPU=%.1f°C, GPU=%.1f°C, 功率=%.1fmW(%.2fW), 内存=%.1f%%", 
-                 new_metrics.jetson_cpu_temp, new_metrics.jetson_gpu_temp, 
-                 new_metrics.jetson_power_mw, new_metrics.jetson_power_mw/1000.0f, new_metrics.jetson_memory_usage);
-    } else {
-        ESP_LOGW(TAG, "Jetson数据获取失败");
-    }
-    
-    // 更新时间戳
-    new_metrics.last_update_time = get_time_ms();
-    
-    // 更新缓存的监控数据
-    if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        // 保留之前有效的数据，只更新成功获取的数据
-        if (new_metrics.n305_data_valid) {
-            s_controller.status.metrics.n305_cpu_temp = new_metrics.n305_cpu_temp;
-            s_controller.status.metrics.n305_data_valid = true;
-        }
-        if (new_metrics.jetson_data_valid) {
-            s_controller.status.metrics.jetson_cpu_temp = new_metrics.jetson_cpu_temp;
-            s_controller.status.metrics.jetson_gpu_temp = new_metrics.jetson_gpu_temp;
-            s_controller.status.metrics.jetson_power_mw = new_metrics.jetson_power_mw;
-            s_controller.status.metrics.jetson_memory_total = new_metrics.jetson_memory_total;
-            s_controller.status.metrics.jetson_memory_used = new_metrics.jetson_memory_used;
-            s_controller.status.metrics.jetson_memory_usage = new_metrics.jetson_memory_usage;
-            s_controller.status.metrics.jetson_data_valid = true;
-        }
-        s_controller.status.metrics.last_update_time = new_metrics.last_update_time;
-        xSemaphoreGive(s_controller.status_mutex);
-    }
+    // 每个主机获取成功后立即发布，各有独立的截止时间
+    esp_err_t n305_result = update_host_metrics(BOARD_METRICS_HOST_N305);
+    esp_err_t jetson_result = update_host_metrics(BOARD_METRICS_HOST_JETSON);
     
     // 返回综合结果
     if (n305_result == ESP_OK || jetson_result == ESP_OK) {
@@ -522,6 +651,52 @@ static bool is_board_display_initialized(void) {
     return s_controller.is_initialized;
 }
 
+// 通知所有任务退出并等待它们结束循环，全部结束后再删除。
+// 任务只在循环之外被删除，进行中的查询在截止时间内完成并释放连接池槽位和互斥锁
+static bool stop_tasks(void) {
+    s_controller.task_running = false;
+    
+    TaskHandle_t* handles[BOARD_METRICS_HOST_COUNT + 1];
+    int count = 0;
+    handles[count++] = &s_controller.display_task_handle;
+    for (int host = 0; host < BOARD_METRICS_HOST_COUNT; host++) {
+        handles[count++] = &s_controller.metrics_task_handles[host];
+    }
+    
+    // 唤醒正在等待下一周期的任务；任务结束循环后挂起等待删除，句柄始终有效
+    for (int i = 0; i < count; i++) {
+        if (*handles[i] != NULL) {
+            xTaskNotifyGive(*handles[i]);
+        }
+    }
+    
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(TASK_STOP_TIMEOUT_MS);
+    while (s_controller.tasks_alive > 0) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= timeout || xSemaphoreTake(s_controller.task_exit_sem, timeout - elapsed) != pdTRUE) {
+            return false;
+        }
+        s_controller.tasks_alive--;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        if (*handles[i] != NULL) {
+            vTaskDelete(*handles[i]);
+            *handles[i] = NULL;
+        }
+    }
+    return true;
+}
+
+// 任务结束循环：通知停止者后挂起，由stop_tasks()删除
+static void park_exited_task(void) {
+    xSemaphoreGive(s_controller.task_exit_sem);
+    while (true) {
+        vTaskSuspend(NULL);
+    }
+}
+
 static void board_display_task(void *pvParameters) {
     ESP_LOGI(TAG, "Board WS2812显示任务开始运行");
     
@@ -538,9 +713,8 @@ static void board_display_task(void *pvParameters) {
                     s_controller.status.mode_change_count++;
                     s_controller.animation_start_time = get_time_ms();
                     
-                    // 重置动画状态
-                    s_controller.breath_brightness = 0;
-                    s_controller.breath_increasing = true;
+                    // 重新写入整条灯带
+                    s_controller.last_color_valid = false;
                     
                     if (s_controller.config.debug_mode) {
                         ESP_LOGI(TAG, "Board WS2812显示模式变化: [%s] -> [%s]", 
@@ -552,37 +726,100 @@ static void board_display_task(void *pvParameters) {
             }
         }
         
-        // 执行当前显示模式
+        // 执行当前显示模式，并由调速器决定下一帧的等待时间
+        uint32_t wait_ms = CONFIG_BSP_LED_STATIC_POLL_INTERVAL_MS;
         if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
             board_display_mode_t current_mode = s_controller.status.current_mode;
             s_controller.status.system_uptime_ms = get_time_ms();
             xSemaphoreGive(s_controller.status_mutex);
             
-            execute_display_mode(current_mode);
+            int64_t frame_begin = bsp_led_governor_frame_begin(BSP_LED_RENDERER_BOARD);
+            uint32_t next_frame_ms = execute_display_mode(current_mode);
+            wait_ms = bsp_led_governor_frame_end(BSP_LED_RENDERER_BOARD, frame_begin, next_frame_ms);
         }
         
-        vTaskDelay(pdMS_TO_TICKS(s_controller.config.update_interval_ms));
+        // 静止画面挂起到监控数据更新或模式变化通知，超时后兜底重新评估
+        if (wait_ms > CONFIG_BSP_LED_STATIC_POLL_INTERVAL_MS) {
+            wait_ms = CONFIG_BSP_LED_STATIC_POLL_INTERVAL_MS;
+        }
+        TickType_t wait_ticks = pdMS_TO_TICKS(wait_ms);
+        ulTaskNotifyTake(pdTRUE, wait_ticks > 0 ? wait_ticks : 1);
     }
     
     ESP_LOGI(TAG, "Board WS2812显示任务结束");
-    vTaskDelete(NULL);
+    park_exited_task();
 }
 
-static void metrics_collection_task(void *pvParameters) {
-    ESP_LOGI(TAG, "监控数据收集任务开始运行");
+static void metrics_host_task(void *pvParameters) {
+    board_metrics_host_t host = (board_metrics_host_t)(uintptr_t)pvParameters;
+    ESP_LOGI(TAG, "%s监控数据收集任务开始运行", METRICS_HOSTS[host].name);
     
     while (s_controller.task_running) {
-        esp_err_t ret = bsp_board_ws2812_display_update_metrics();
+        uint32_t cycle_start = get_time_ms();
+        esp_err_t ret = update_host_metrics(host);
+        
+        // 监控数据变化可能导致显示模式变化，立即唤醒显示任务
+        wake_display_task();
         
         if (ret != ESP_OK && s_controller.config.debug_mode) {
-            ESP_LOGW(TAG, "监控数据更新失败");
+            ESP_LOGW(TAG, "%s监控数据更新失败", METRICS_HOSTS[host].name);
+        }
+        
+        // 周期从本次获取开始时计算，获取耗时不推迟下一次获取；停止时被通知提前唤醒
+        uint32_t elapsed = get_time_ms() - cycle_start;
+        uint32_t interval = s_controller.config.metrics_interval_ms;
+        if (elapsed < interval && s_controller.task_running) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(interval - elapsed));
+        }
+    }
+    
+    ESP_LOGI(TAG, "%s监控数据收集任务结束", METRICS_HOSTS[host].name);
+    park_exited_task();
+}
+
+// 在截止时间内获取一个主机的监控数据，获取完成立即发布，不等待其他主机
+static esp_err_t update_host_metrics(board_metrics_host_t host) {
+    const metrics_host_desc_t* desc = &METRICS_HOSTS[host];
+    system_metrics_t new_metrics = {0};
+    
+    int64_t start_us = esp_timer_get_time();
+    int64_t deadline_us = start_us + (int64_t)BOARD_METRICS_DEADLINE_MS * 1000;
+    ESP_LOGI(TAG, "正在获取%s监控数据...", desc->name);
+    esp_err_t ret = desc->fetch(&new_metrics, deadline_us);
+    
+    int64_t end_us = esp_timer_get_time();
+    uint32_t latency_ms = (uint32_t)((end_us - start_us) / 1000);
+    bool deadline_missed = (ret == ESP_ERR_TIMEOUT || end_us > deadline_us);
+    
+    if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        // 保留之前有效的数据，只更新成功获取的数据
+        if (ret == ESP_OK) {
+            desc->publish(&s_controller.status.metrics, &new_metrics);
         }
+        s_controller.status.metrics.last_update_time = get_time_ms();
         
-        vTaskDelay(pdMS_TO_TICKS(s_controller.config.metrics_interval_ms));
+        board_metrics_fetch_stats_t* stats = &s_controller.status.fetch_stats[host];
+        stats->fetch_count++;
+        if (ret != ESP_OK) {
+            stats->failure_count++;
+        }
+        if (deadline_missed) {
+            stats->deadline_misses++;
+        }
+        stats->last_latency_ms = latency_ms;
+        if (latency_ms > stats->max_latency_ms) {
+            stats->max_latency_ms = latency_ms;
+        }
+        xSemaphoreGive(s_controller.status_mutex);
     }
     
-    ESP_LOGI(TAG, "监控数据收集任务结束");
-    vTaskDelete(NULL);
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "%s监控数据获取成功 (耗时 %lu ms)", desc->name, (unsigned long)latency_ms);
+    } else {
+        ESP_LOGW(TAG, "%s数据获取失败: %s (耗时 %lu ms%s)", desc->name, esp_err_to_name(ret),
+                 (unsigned long)latency_ms, deadline_missed ? ", 超过截止时间" : "");
+    }
+    return ret;
 }
 
 static board_display_mode_t determine_display_mode(void) {
@@ -627,47 +864,118 @@ static board_display_mode_t determine_display_mode(void) {
         return BOARD_DISPLAY_MODE_MEMORY_HIGH_USAGE;
     }
     
+    // 无告警：显示遥测条形图
+    if (s_controller.config.bar_graph_enabled) {
+        return BOARD_DISPLAY_MODE_BAR_GRAPH;
+    }
+    
     return BOARD_DISPLAY_MODE_OFF;
 }
 
-static void execute_display_mode(board_display_mode_t mode) {
+static uint32_t execute_display_mode(board_display_mode_t mode) {
     switch (mode) {
         case BOARD_DISPLAY_MODE_HIGH_TEMP:
             // 高温警告 - 红色慢速呼吸
-            handle_breath_animation(&COLOR_RED, BOARD_BREATH_SPEED_SLOW);
-            break;
+            return handle_breath_animation(&COLOR_RED, BOARD_BREATH_SPEED_SLOW);
               case BOARD_DISPLAY_MODE_HIGH_POWER:
             // 功率过高 - 紫色快速呼吸
-            handle_breath_animation(&COLOR_PURPLE, BOARD_BREATH_SPEED_FAST);
-            break;
+            return handle_breath_animation(&COLOR_PURPLE, BOARD_BREATH_SPEED_FAST);
               case BOARD_DISPLAY_MODE_MEMORY_HIGH_USAGE:
             // 内存高使用率 - 白色慢速呼吸
-            handle_breath_animation(&COLOR_WHITE, BOARD_BREATH_SPEED_SLOW);
-            break;
+            return handle_breath_animation(&COLOR_WHITE, BOARD_BREATH_SPEED_SLOW);
+            
+        case BOARD_DISPLAY_MODE_BAR_GRAPH:
+            // 遥测条形图
+            return handle_bar_graph();
             
         case BOARD_DISPLAY_MODE_OFF:
         default:
-            // 默认关闭
+            // 默认关闭，画面静止直到模式变化
             set_board_led_color_all(COLOR_OFF.r, COLOR_OFF.g, COLOR_OFF.b);
-            break;
+            return BSP_LED_DEADLINE_STATIC;
     }
 }
 
 static void set_board_led_color_all(uint8_t r, uint8_t g, uint8_t b) {
-    // 应用亮度调整
-    uint8_t adj_r = apply_brightness(r, s_controller.config.brightness);
-    uint8_t adj_g = apply_brightness(g, s_controller.config.brightness);
-    uint8_t adj_b = apply_brightness(b, s_controller.config.brightness);
+    rgb_color_t color = {r, g, b};
+    (void)run_effect_all(BSP_LED_EFFECT_SOLID, &color, 0);
+}
+
+static uint32_t handle_breath_animation(const rgb_color_t* color, board_breath_speed_t speed) {
+    uint32_t period_ms;
+    
+    // 根据速度设置周期
+    switch (speed) {
+        case BOARD_BREATH_SPEED_FAST:
+            period_ms = 1000;
+            break;
+        case BOARD_BREATH_SPEED_NORMAL:
+            period_ms = 2000;
+            break;
+        case BOARD_BREATH_SPEED_SLOW:
+        default:
+            period_ms = 3000;
+            break;
+    }
+    
+    // 呼吸需要连续刷新
+    return run_effect_all(BSP_LED_EFFECT_BREATH, color, period_ms);
+}
+
+// 所有LED设置为同一效果（参数未变化时保持相位）并刷新
+static uint32_t run_effect_all(bsp_led_effect_type_t type, const rgb_color_t* color, uint32_t period_ms) {
+    uint32_t now = get_time_ms();
+    for (int i = 0; i < BSP_WS2812_ONBOARD_COUNT; i++) {
+        bsp_led_effect_set(&s_controller.effects[i], type, *color, COLOR_OFF, period_ms, now);
+    }
+    return render_effects(now);
+}
+
+// 计算每颗LED的颜色并写入灯带，返回最近的下一次刷新期限
+static uint32_t render_effects(uint32_t now_ms) {
+    rgb_color_t colors[BSP_WS2812_ONBOARD_COUNT];
+    uint32_t next_ms = BSP_LED_DEADLINE_STATIC;
+    
+    for (int i = 0; i < BSP_WS2812_ONBOARD_COUNT; i++) {
+        uint32_t led_next_ms = bsp_led_effect_render(&s_controller.effects[i], now_ms, &colors[i]);
+        if (led_next_ms < next_ms) {
+            next_ms = led_next_ms;
+        }
+    }
+    
+    write_strip(colors);
+    return next_ms;
+}
+
+// 应用亮度后只写入变化的像素，有变化时刷新灯带
+static void write_strip(const rgb_color_t* colors) {
+    bool changed = false;
     
-    // 设置所有28个LED为相同颜色
     for (int i = 0; i < BSP_WS2812_ONBOARD_COUNT; i++) {
-        esp_err_t ret = bsp_ws2812_set_pixel(BSP_WS2812_ONBOARD, i, adj_r, adj_g, adj_b);
+        rgb_color_t color = bsp_led_effect_scale_rgb(colors[i], s_controller.config.brightness);
+        
+        // 颜色未变化时跳过该像素
+        if (s_controller.last_color_valid &&
+            s_controller.last_colors[i].r == color.r &&
+            s_controller.last_colors[i].g == color.g &&
+            s_controller.last_colors[i].b == color.b) {
+            continue;
+        }
+        
+        esp_err_t ret = bsp_ws2812_set_pixel(BSP_WS2812_ONBOARD, i, color.r, color.g, color.b);
         if (ret != ESP_OK) {
             if (s_controller.config.debug_mode) {
                 ESP_LOGE(TAG, "设置Board WS2812像素%d失败: %s", i, esp_err_to_name(ret));
             }
+            s_controller.last_color_valid = false;
             return;
         }
+        s_controller.last_colors[i] = color;
+        changed = true;
+    }
+    
+    if (!changed) {
+        return;
     }
     
     esp_err_t ret = bsp_ws2812_refresh(BSP_WS2812_ONBOARD);
@@ -675,177 +983,209 @@ static void set_board_led_color_all(uint8_t r, uint8_t g, uint8_t b) {
         if (s_controller.config.debug_mode) {
             ESP_LOGE(TAG, "刷新Board WS2812失败: %s", esp_err_to_name(ret));
         }
+        s_controller.last_color_valid = false;
+        return;
     }
+    
+    s_controller.last_color_valid = true;
 }
 
-static void handle_breath_animation(const rgb_color_t* color, board_breath_speed_t speed) {
-    uint32_t current_time = get_time_ms();
-    uint32_t period_ms;
+// 条形图：按采样间隔读取指标，每帧只做整数插值，画面稳定后只等待下一次采样
+static uint32_t handle_bar_graph(void) {
+    if (s_controller.bar_layout_dirty) {
+        apply_bar_layout();
+    }
     
-    // 根据速度设置周期
-    switch (speed) {
-        case BOARD_BREATH_SPEED_FAST:
-            period_ms = 1000;
-            break;
-        case BOARD_BREATH_SPEED_NORMAL:
-            period_ms = 2000;
-            break;
-        case BOARD_BREATH_SPEED_SLOW:
-        default:
-            period_ms = 3000;
-            break;
+    uint32_t now = get_time_ms();
+    if (!s_controller.bar_sampled || now - s_controller.bar_last_sample_ms >= BOARD_BAR_SAMPLE_INTERVAL_MS) {
+        sample_bar_metrics();
+        s_controller.bar_last_sample_ms = now;
+        s_controller.bar_sampled = true;
     }
     
-    // 计算呼吸亮度 (使用正弦波实现平滑呼吸效果)
-    uint32_t elapsed = (current_time - s_controller.animation_start_time) % period_ms;
-    float phase = (float)elapsed / period_ms * 2.0f * M_PI;
-    float brightness_factor = (sin(phase) + 1.0f) / 2.0f;  // 0.0 到 1.0
+    rgb_color_t colors[BSP_WS2812_ONBOARD_COUNT] = {0};
+    uint32_t next_ms = bsp_led_bargraph_render(&s_controller.bar_graph, now, colors, BSP_WS2812_ONBOARD_COUNT);
+    write_strip(colors);
     
-    uint8_t breath_r = (uint8_t)(color->r * brightness_factor);
-    uint8_t breath_g = (uint8_t)(color->g * brightness_factor);
-    uint8_t breath_b = (uint8_t)(color->b * brightness_factor);
+    uint32_t sample_ms = BOARD_BAR_SAMPLE_INTERVAL_MS - (now - s_controller.bar_last_sample_ms);
+    return next_ms < sample_ms ? next_ms : sample_ms;
+}
+
+static void apply_bar_layout(void) {
+    board_bar_segment_t segments[BOARD_BAR_MAX_SEGMENTS];
+    uint8_t count = 0;
     
-    set_board_led_color_all(breath_r, breath_g, breath_b);
+    if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(10)) != pdTRUE) {
+        return;
+    }
+    count = s_controller.bar_segment_count;
+    memcpy(segments, s_controller.bar_segments, sizeof(segments));
+    s_controller.bar_layout_dirty = false;
+    xSemaphoreGive(s_controller.status_mutex);
+    
+    bsp_led_bar_segment_config_t configs[BOARD_BAR_MAX_SEGMENTS];
+    for (uint8_t i = 0; i < count; i++) {
+        configs[i].first_led = segments[i].first_led;
+        configs[i].led_count = segments[i].led_count;
+        configs[i].reverse = segments[i].reverse;
+        configs[i].min_value = (int32_t)(segments[i].min_value * BAR_VALUE_SCALE);
+        configs[i].max_value = (int32_t)(segments[i].max_value * BAR_VALUE_SCALE);
+        configs[i].low_color = segments[i].low_color;
+        configs[i].high_color = segments[i].high_color;
+    }
+    
+    bsp_led_bargraph_configure(&s_controller.bar_graph, configs, count);
+    s_controller.bar_sampled = false;
+    s_controller.last_color_valid = false;
 }
 
-static uint32_t get_time_ms(void) {
-    return esp_timer_get_time() / 1000;
+// 读取各指标的最新值（浮点换算只在采样时进行）
+static void sample_bar_metrics(void) {
+    system_metrics_t metrics;
+    bool metrics_ok = (bsp_board_ws2812_display_get_metrics(&metrics) == ESP_OK);
+    
+    const bsp_power_chip_data_t* power = bsp_get_latest_power_chip_data();
+    bool internet_up = (nm_get_status(NM_INTERNET_IP) == NM_STATUS_UP);
+    uint32_t latency_ms = internet_up ? nm_perf_get_current_latency(NM_INTERNET_IP) : 0;
+    
+    for (uint8_t i = 0; i < s_controller.bar_graph.segment_count; i++) {
+        float value = 0;
+        bool valid = false;
+        
+        switch (s_controller.bar_segments[i].metric) {
+            case BOARD_BAR_METRIC_N305_TEMP:
+                valid = metrics_ok && metrics.n305_data_valid;
+                value = metrics.n305_cpu_temp;
+                break;
+            case BOARD_BAR_METRIC_JETSON_TEMP:
+                valid = metrics_ok && metrics.jetson_data_valid;
+                value = fmaxf(metrics.jetson_cpu_temp, metrics.jetson_gpu_temp);
+                break;
+            case BOARD_BAR_METRIC_INPUT_POWER:
+                valid = (power != NULL && power->valid);
+                value = valid ? power->power : 0;
+                break;
+            case BOARD_BAR_METRIC_NETWORK_LATENCY:
+                valid = internet_up;
+                value = (float)latency_ms;
+                break;
+            default:
+                break;
+        }
+        
+        bsp_led_bargraph_set_value(&s_controller.bar_graph, i, (int32_t)(value * BAR_VALUE_SCALE), valid);
+    }
+}
+
+static void wake_display_task(void) {
+    if (s_controller.display_task_handle != NULL) {
+        xTaskNotifyGive(s_controller.display_task_handle);
+    }
 }
 
-static uint8_t apply_brightness(uint8_t color_value, uint8_t brightness) {
-    return (color_value * brightness) / 255;
+static uint32_t get_time_ms(void) {
+    return esp_timer_get_time() / 1000;
 }
 
 // ========== Prometheus数据处理实现 ==========
 
-static esp_err_t fetch_n305_temperature(system_metrics_t* metrics) {
-    ESP_LOGI(TAG, "使用Prometheus查询API获取N305温度数据");
+static esp_err_t fetch_n305_temperature(system_metrics_t* metrics, int64_t deadline_us) {
+    ESP_LOGI(TAG, "使用Prometheus批量查询获取N305温度数据 (%d个候选查询)", s_controller.n305_batch.count);
     
-    // 尝试多个可能的温度指标查询
-    const char* temp_queries[] = {
-        N305_TEMP_QUERY,  // 使用预定义的查询
-        "node_hwmon_temp_celsius{chip=\"coretemp-isa-0000\",sensor=\"temp1\"}",
-        "node_thermal_zone_temp{zone=\"thermal_zone0\"}",
-        "node_hwmon_temp_celsius"
-    };
-    
-    size_t num_queries = sizeof(temp_queries) / sizeof(temp_queries[0]);
+    // 结果写入副本，手动更新与后台任务同时查询时互不干扰
+    bsp_promql_batch_t results = s_controller.n305_batch;
+    bsp_promql_batch_t* batch = &results;
+    esp_err_t ret = query_metric_batch(batch, s_controller.n305_batch_query, deadline_us);
+    if (ret != ESP_OK) {
+        return ret;
+    }
     
-    for (size_t i = 0; i < num_queries; i++) {
-        ESP_LOGI(TAG, "尝试N305温度查询 %d/%d: %s", (int)(i+1), (int)num_queries, temp_queries[i]);
-        
-        esp_err_t ret = query_prometheus_api(BOARD_PROMETHEUS_API, temp_queries[i], 
-                                           s_controller.n305_response_buffer, 
-                                           s_controller.buffer_size);
-          if (ret == ESP_OK) {
-            float temperature;
-            ret = parse_prometheus_query_response(s_controller.n305_response_buffer, &temperature);
-              if (ret == ESP_OK && temperature > -50 && temperature < 150) {  // 温度合理范围
-                metrics->n305_cpu_temp = temperature;
-                metrics->n305_data_valid = true;
-                ESP_LOGI(TAG, "N305温度查询成功: %.1f°C (查询: %s)", temperature, temp_queries[i]);
-                return ESP_OK;
-            } else if (ret == ESP_OK) {
-                ESP_LOGW(TAG, "N305温度值不合理: %.1f°C (合理范围: -50°C到150°C)", temperature);
-                if (s_controller.config.debug_mode) {
-                    ESP_LOGW(TAG, "响应内容: %.200s", s_controller.n305_response_buffer);
-                }
-            }
+    // 按优先级取第一个温度合理的候选结果
+    for (int i = 0; i < batch->count; i++) {
+        float temperature;
+        if (!bsp_promql_batch_get(batch, i, &temperature)) {
+            continue;
         }
-        
-        // 短暂延迟再尝试下一个查询
-        vTaskDelay(pdMS_TO_TICKS(100));
+        if (temperature > -50 && temperature < 150) {  // 温度合理范围
+            metrics->n305_cpu_temp = temperature;
+            metrics->n305_data_valid = true;
+            ESP_LOGI(TAG, "N305温度查询成功: %.1f°C (查询: %s)", temperature, N305_TEMP_QUERIES[i]);
+            return ESP_OK;
+        }
+        ESP_LOGW(TAG, "N305温度值不合理: %.1f°C (合理范围: -50°C到150°C, 查询: %s)", 
+                 temperature, N305_TEMP_QUERIES[i]);
     }
-      ESP_LOGW(TAG, "所有N305温度查询都失败");
+    
+    ESP_LOGW(TAG, "所有N305温度查询都失败");
     return ESP_FAIL;
 }
 
-static esp_err_t fetch_jetson_metrics(system_metrics_t* metrics) {
-    ESP_LOGI(TAG, "使用Prometheus查询API获取Jetson监控数据");
+static esp_err_t fetch_jetson_metrics(system_metrics_t* metrics, int64_t deadline_us) {
+    ESP_LOGI(TAG, "使用Prometheus批量查询获取Jetson监控数据 (%d项指标)", JETSON_METRIC_COUNT);
+    
+    // 结果写入副本，手动更新与后台任务同时查询时互不干扰
+    bsp_promql_batch_t results = s_controller.jetson_batch;
+    bsp_promql_batch_t* batch = &results;
+    esp_err_t ret = query_metric_batch(batch, s_controller.jetson_batch_query, deadline_us);
+    if (ret != ESP_OK) {
+        return ret;
+    }
     
     bool success = false;
     
-    // 1. 查询Jetson CPU温度
-    ESP_LOGI(TAG, "查询Jetson CPU温度...");
-    esp_err_t ret = query_prometheus_api(BOARD_PROMETHEUS_API, JETSON_CPU_TEMP_QUERY, 
-                                       s_controller.jetson_response_buffer, 
-                                       s_controller.buffer_size);
-    if (ret == ESP_OK) {
-        float cpu_temp;        if (parse_prometheus_query_response(s_controller.jetson_response_buffer, &cpu_temp) == ESP_OK) {
-            if (cpu_temp >= -50 && cpu_temp < 150) {  // 温度合理范围
-                metrics->jetson_cpu_temp = cpu_temp;
-                success = true;
-                ESP_LOGI(TAG, "Jetson CPU温度: %.1f°C", cpu_temp);
-            } else {
-                ESP_LOGW(TAG, "Jetson CPU温度值不合理: %.1f°C (合理范围: -50°C到150°C)", cpu_temp);
-            }
+    // 1. Jetson CPU温度
+    float cpu_temp;
+    if (bsp_promql_batch_get(batch, JETSON_METRIC_CPU_TEMP, &cpu_temp)) {
+        if (cpu_temp >= -50 && cpu_temp < 150) {  // 温度合理范围
+            metrics->jetson_cpu_temp = cpu_temp;
+            success = true;
+            ESP_LOGI(TAG, "Jetson CPU温度: %.1f°C", cpu_temp);
+        } else {
+            ESP_LOGW(TAG, "Jetson CPU温度值不合理: %.1f°C (合理范围: -50°C到150°C)", cpu_temp);
         }
     }
     
-    // 2. 查询Jetson GPU温度
-    ESP_LOGI(TAG, "查询Jetson GPU温度...");
-    ret = query_prometheus_api(BOARD_PROMETHEUS_API, JETSON_GPU_TEMP_QUERY, 
-                             s_controller.jetson_response_buffer, 
-                             s_controller.buffer_size);
-    if (ret == ESP_OK) {
-        float gpu_temp;        if (parse_prometheus_query_response(s_controller.jetson_response_buffer, &gpu_temp) == ESP_OK) {
-            if (gpu_temp >= -50 && gpu_temp < 150 && gpu_temp != -256.0f) {  // 温度合理范围，-256.0表示传感器无效
-                metrics->jetson_gpu_temp = gpu_temp;
-                success = true;
-                ESP_LOGI(TAG, "Jetson GPU温度: %.1f°C", gpu_temp);
-            } else {
-                ESP_LOGW(TAG, "Jetson GPU温度值不合理: %.1f°C (合理范围: -50°C到150°C)", gpu_temp);
-            }
+    // 2. Jetson GPU温度
+    float gpu_temp;
+    if (bsp_promql_batch_get(batch, JETSON_METRIC_GPU_TEMP, &gpu_temp)) {
+        if (gpu_temp >= -50 && gpu_temp < 150 && gpu_temp != -256.0f) {  // 温度合理范围，-256.0表示传感器无效
+            metrics->jetson_gpu_temp = gpu_temp;
+            success = true;
+            ESP_LOGI(TAG, "Jetson GPU温度: %.1f°C", gpu_temp);
+        } else {
+            ESP_LOGW(TAG, "Jetson GPU温度值不合理: %.1f°C (合理范围: -50°C到150°C)", gpu_temp);
         }
     }
-      // 3. 查询Jetson功率
-    ESP_LOGI(TAG, "查询Jetson功率...");
-    float power_mw = -1;
-    
-    ret = query_prometheus_api(BOARD_PROMETHEUS_API, JETSON_POWER_QUERY, 
-                             s_controller.jetson_response_buffer, 
-                             s_controller.buffer_size);    if (ret == ESP_OK) {
-        if (parse_prometheus_query_response(s_controller.jetson_response_buffer, &power_mw) == ESP_OK) {
-            if (power_mw >= 0 && power_mw < 1000000) {  // 功率合理范围：0到1000W
-                metrics->jetson_power_mw = power_mw;
-                success = true;
-                ESP_LOGI(TAG, "Jetson功率: %.1f mW (%.2f W)", power_mw, power_mw/1000.0f);
-            } else {
-                ESP_LOGW(TAG, "Jetson功率值不合理: %.1f mW (合理范围: 0到1000000mW)", power_mw);
-            }
+    
+    // 3. Jetson功率
+    float power_mw;
+    if (bsp_promql_batch_get(batch, JETSON_METRIC_POWER, &power_mw)) {
+        if (power_mw >= 0 && power_mw < 1000000) {  // 功率合理范围：0到1000W
+            metrics->jetson_power_mw = power_mw;
+            success = true;
+            ESP_LOGI(TAG, "Jetson功率: %.1f mW (%.2f W)", power_mw, power_mw/1000.0f);
+        } else {
+            ESP_LOGW(TAG, "Jetson功率值不合理: %.1f mW (合理范围: 0到1000000mW)", power_mw);
         }
     }
     
-    // 4. 查询内存使用情况
-    ESP_LOGI(TAG, "查询Jetson内存使用情况...");
+    // 4. 内存使用情况
     float memory_total = -1, memory_used = -1;
-      // 获取总内存
-    ret = query_prometheus_api(BOARD_PROMETHEUS_API, JETSON_MEMORY_TOTAL_QUERY, 
-                             s_controller.jetson_response_buffer, 
-                             s_controller.buffer_size);
-    if (ret == ESP_OK) {
-        if (parse_prometheus_query_response(s_controller.jetson_response_buffer, &memory_total) == ESP_OK) {
-            if (memory_total > 0 && memory_total < 1000000000) {  // 内存合理范围：0到1TB(kB)
-                ESP_LOGI(TAG, "Jetson总内存: %.1f kB (%.1f GB)", memory_total, memory_total/1024.0f/1024.0f);
-            } else {
-                ESP_LOGW(TAG, "Jetson总内存值不合理: %.1f kB", memory_total);
-                memory_total = -1;  // 标记为无效
-            }
+    if (bsp_promql_batch_get(batch, JETSON_METRIC_MEMORY_TOTAL, &memory_total)) {
+        if (memory_total > 0 && memory_total < 1000000000) {  // 内存合理范围：0到1TB(kB)
+            ESP_LOGI(TAG, "Jetson总内存: %.1f kB (%.1f GB)", memory_total, memory_total/1024.0f/1024.0f);
+        } else {
+            ESP_LOGW(TAG, "Jetson总内存值不合理: %.1f kB", memory_total);
+            memory_total = -1;  // 标记为无效
         }
     }
     
-    // 获取已用内存
-    ret = query_prometheus_api(BOARD_PROMETHEUS_API, JETSON_MEMORY_USED_QUERY, 
-                             s_controller.jetson_response_buffer, 
-                             s_controller.buffer_size);
-    if (ret == ESP_OK) {
-        if (parse_prometheus_query_response(s_controller.jetson_response_buffer, &memory_used) == ESP_OK) {
-            if (memory_used >= 0 && memory_used < 1000000000) {  // 内存合理范围
-                ESP_LOGI(TAG, "Jetson已用内存: %.1f kB (%.1f GB)", memory_used, memory_used/1024.0f/1024.0f);
-            } else {
-                ESP_LOGW(TAG, "Jetson已用内存值不合理: %.1f kB", memory_used);
-                memory_used = -1;  // 标记为无效
-            }
+    if (bsp_promql_batch_get(batch, JETSON_METRIC_MEMORY_USED, &memory_used)) {
+        if (memory_used >= 0 && memory_used < 1000000000) {  // 内存合理范围
+            ESP_LOGI(TAG, "Jetson已用内存: %.1f kB (%.1f GB)", memory_used, memory_used/1024.0f/1024.0f);
+        } else {
+            ESP_LOGW(TAG, "Jetson已用内存值不合理: %.1f kB", memory_used);
+            memory_used = -1;  // 标记为无效
         }
     }
     
@@ -869,201 +1209,108 @@ static esp_err_t fetch_jetson_metrics(system_metrics_t* metrics) {
     }
 }
 
-static esp_err_t query_prometheus_api(const char* base_url, const char* query, char* response_buffer, size_t buffer_size) {
-    // 构建完整的查询URL
-    char full_url[512];
-    int url_len = snprintf(full_url, sizeof(full_url), "%s?query=%s", base_url, query);
-    
-    if (url_len >= sizeof(full_url)) {
-        ESP_LOGE(TAG, "查询URL太长");
-        return ESP_ERR_INVALID_ARG;
-    }
-    
-    // URL编码处理（简单替换空格为%20）
-    for (int i = 0; i < url_len && i < sizeof(full_url) - 3; i++) {
-        if (full_url[i] == ' ') {
-            memmove(&full_url[i+3], &full_url[i+1], strlen(&full_url[i+1]) + 1);
-            full_url[i] = '%';
-            full_url[i+1] = '2';
-            full_url[i+2] = '0';
-            url_len += 2;
-        }
-    }
-    
-    if (s_controller.config.debug_mode) {
-        ESP_LOGI(TAG, "查询URL: %s", full_url);
-    }
-    
-    esp_http_client_config_t config = {
-        .url = full_url,
-        .timeout_ms = BOARD_HTTP_TIMEOUT_MS,
-        .buffer_size = 1024,
-        .buffer_size_tx = 512,
-        .disable_auto_redirect = true,
-        .max_redirection_count = 0,
-        .keep_alive_enable = false,
-    };
-    
-    esp_http_client_handle_t client = esp_http_client_init(&config);
-    if (client == NULL) {
-        ESP_LOGE(TAG, "创建HTTP客户端失败");
-        return ESP_FAIL;
-    }
-    
-    // 设置请求头
-    esp_http_client_set_header(client, "Accept", "application/json");
-    
-    // 清空响应缓冲区
-    memset(response_buffer, 0, buffer_size);
-    
-    esp_err_t err = esp_http_client_open(client, 0);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "HTTP客户端打开失败: %s", esp_err_to_name(err));
-        esp_http_client_cleanup(client);
-        return err;
-    }
-    
-    int content_length = esp_http_client_fetch_headers(client);
-    int status_code = esp_http_client_get_status_code(client);
-    
-    if (status_code != 200) {
-        ESP_LOGE(TAG, "HTTP请求失败，状态码: %d, URL: %s", status_code, full_url);
-        esp_http_client_close(client);
-        esp_http_client_cleanup(client);
-        return ESP_FAIL;
-    }
-    
-    if (s_controller.config.debug_mode) {
-        ESP_LOGI(TAG, "HTTP请求成功，内容长度: %d字节", content_length);
+static void publish_n305_metrics(system_metrics_t* dst, const system_metrics_t* src) {
+    dst->n305_cpu_temp = src->n305_cpu_temp;
+    dst->n305_data_valid = true;
+}
+
+static void publish_jetson_metrics(system_metrics_t* dst, const system_metrics_t* src) {
+    dst->jetson_cpu_temp = src->jetson_cpu_temp;
+    dst->jetson_gpu_temp = src->jetson_gpu_temp;
+    dst->jetson_power_mw = src->jetson_power_mw;
+    dst->jetson_memory_total = src->jetson_memory_total;
+    dst->jetson_memory_used = src->jetson_memory_used;
+    dst->jetson_memory_usage = src->jetson_memory_usage;
+    dst->jetson_data_valid = true;
+}
+
+static esp_err_t init_metric_batches(void) {
+    bsp_promql_batch_init(&s_controller.n305_batch);
+    for (size_t i = 0; i < sizeof(N305_TEMP_QUERIES) / sizeof(N305_TEMP_QUERIES[0]); i++) {
+        bsp_promql_batch_add(&s_controller.n305_batch, N305_TEMP_QUERIES[i]);
     }
     
-    // 读取响应数据
-    int total_read = 0;
-    int chunk_size = 512;
-    
-    while (total_read < buffer_size - 1) {
-        int remaining = buffer_size - 1 - total_read;
-        int to_read = (remaining > chunk_size) ? chunk_size : remaining;
-        
-        int data_read = esp_http_client_read_response(client, 
-                                                      response_buffer + total_read, 
-                                                      to_read);
-        if (data_read <= 0) {
-            break;
-        }
-        
-        total_read += data_read;
+    bsp_promql_batch_init(&s_controller.jetson_batch);
+    for (int i = 0; i < JETSON_METRIC_COUNT; i++) {
+        bsp_promql_batch_add(&s_controller.jetson_batch, JETSON_QUERIES[i]);
     }
     
-    response_buffer[total_read] = '\0';
-    
-    if (s_controller.config.debug_mode) {
-        ESP_LOGI(TAG, "读取响应完成，总计: %d字节", total_read);
-        ESP_LOGI(TAG, "响应内容: %.500s", response_buffer);  // 打印前500字符
+    int n305_len = bsp_promql_batch_build(&s_controller.n305_batch, s_controller.n305_batch_query,
+                                          sizeof(s_controller.n305_batch_query));
+    int jetson_len = bsp_promql_batch_build(&s_controller.jetson_batch, s_controller.jetson_batch_query,
+                                            sizeof(s_controller.jetson_batch_query));
+    if (n305_len < 0 || jetson_len < 0) {
+        ESP_LOGE(TAG, "合并PromQL表达式超过%d字节", PROMQL_BATCH_MAX_LENGTH);
+        return ESP_ERR_INVALID_SIZE;
     }
     
-    esp_http_client_close(client);
-    esp_http_client_cleanup(client);
-    
+    ESP_LOGI(TAG, "PromQL批量查询: N305 %d条合并为%d字节, Jetson %d条合并为%d字节",
+             s_controller.n305_batch.count, n305_len, s_controller.jetson_batch.count, jetson_len);
     return ESP_OK;
 }
 
-static esp_err_t parse_prometheus_query_response(const char* response, float* value) {
-    // 使用cJSON解析Prometheus查询API返回的JSON格式
-    // 格式示例: {"status":"success","data":{"resultType":"vector","result":[{"metric":{},"value":[timestamp,"42"]}]}}
-    
-    if (response == NULL || value == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    
-    cJSON *json = cJSON_Parse(response);
-    if (json == NULL) {
-        ESP_LOGE(TAG, "JSON解析失败");
-        return ESP_FAIL;
-    }
-    
-    // 检查状态
-    cJSON *status = cJSON_GetObjectItem(json, "status");
-    if (!cJSON_IsString(status) || strcmp(status->valuestring, "success") != 0) {
-        ESP_LOGE(TAG, "查询失败，状态: %s", status ? status->valuestring : "未知");
-        cJSON_Delete(json);
-        return ESP_FAIL;
-    }
-    
-    // 获取数据部分
-    cJSON *data = cJSON_GetObjectItem(json, "data");
-    if (!cJSON_IsObject(data)) {
-        ESP_LOGE(TAG, "响应中没有data字段");
-        cJSON_Delete(json);
-        return ESP_FAIL;
-    }
-    
-    // 获取result数组
-    cJSON *result = cJSON_GetObjectItem(data, "result");
-    if (!cJSON_IsArray(result) || cJSON_GetArraySize(result) == 0) {
-        ESP_LOGW(TAG, "没有找到查询结果数据");
-        cJSON_Delete(json);
-        return ESP_FAIL;
-    }
-    
-    // 获取第一个结果项
-    cJSON *first_result = cJSON_GetArrayItem(result, 0);
-    if (!cJSON_IsObject(first_result)) {
-        ESP_LOGE(TAG, "结果格式错误");
-        cJSON_Delete(json);
-        return ESP_FAIL;
-    }
+// 批量查询的流式接收上下文：响应正文边接收边扫描，按标签分拣到批次中
+typedef struct {
+    bsp_prom_scanner_t scanner;
+    bsp_promql_batch_t* batch;
+} batch_stream_t;
+
+static esp_err_t query_metric_batch(bsp_promql_batch_t* batch, const char* query, int64_t deadline_us) {
+    batch_stream_t stream = { .batch = batch };
+    bsp_prom_scanner_init(&stream.scanner, BSP_PROMQL_BATCH_LABEL, on_batch_series, batch);
+    bsp_promql_batch_clear_results(batch);
     
-    // 获取value数组 [timestamp, "temperature_value"]
-    cJSON *value_array = cJSON_GetObjectItem(first_result, "value");
-    if (!cJSON_IsArray(value_array) || cJSON_GetArraySize(value_array) < 2) {
-        ESP_LOGE(TAG, "value字段格式错误");
-        cJSON_Delete(json);
-        return ESP_FAIL;
-    }
+    esp_err_t ret = bsp_prometheus_client_query_stream_until(query, deadline_us, on_batch_data, &stream);
+    bsp_prom_scan_result_t scan = bsp_prom_scanner_finish(&stream.scanner);
     
-    // 获取温度值（第二个元素，字符串格式）
-    cJSON *temp_value = cJSON_GetArrayItem(value_array, 1);
-    if (!cJSON_IsString(temp_value)) {
-        ESP_LOGE(TAG, "温度值不是字符串格式");
-        cJSON_Delete(json);
-        return ESP_FAIL;
-    }
-      // 转换温度值
-    char *endptr;
-    float parsed_value = strtof(temp_value->valuestring, &endptr);
-      if (endptr == temp_value->valuestring) {
-        ESP_LOGE(TAG, "数值解析失败: %s", temp_value->valuestring);
-        cJSON_Delete(json);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Prometheus批量查询失败: %s%s%s", esp_err_to_name(ret),
+                 stream.scanner.error_len > 0 ? ", " : "", stream.scanner.error);
+        bsp_promql_batch_clear_results(batch);
+        return ret;
+    }
+    if (scan != BSP_PROM_SCAN_OK) {
+        ESP_LOGE(TAG, "响应解析失败: %s (已接收 %lu 字节)", 
+                 bsp_prom_scanner_result_name(scan), (unsigned long)stream.scanner.bytes);
+        bsp_promql_batch_clear_results(batch);
         return ESP_FAIL;
     }
-    
-    // 检查是否是有效的数值（不是NaN或无穷大）
-    if (!isfinite(parsed_value)) {
-        ESP_LOGW(TAG, "解析出的数值无效: %.2f (原始字符串: %s)", parsed_value, temp_value->valuestring);
-        cJSON_Delete(json);
+    if (!bsp_prom_scanner_is_success(&stream.scanner)) {
+        ESP_LOGE(TAG, "查询失败，状态: %s %s", 
+                 stream.scanner.status_len > 0 ? stream.scanner.status : "未知", stream.scanner.error);
+        bsp_promql_batch_clear_results(batch);
         return ESP_FAIL;
     }
     
-    *value = parsed_value;
-    
     if (s_controller.config.debug_mode) {
-        ESP_LOGI(TAG, "JSON解析成功，数值: %.2f (原始字符串: %s)", parsed_value, temp_value->valuestring);
-        
-        // 打印metric信息
-        cJSON *metric = cJSON_GetObjectItem(first_result, "metric");
-        if (cJSON_IsObject(metric)) {
-            cJSON *chip = cJSON_GetObjectItem(metric, "chip");
-            cJSON *sensor = cJSON_GetObjectItem(metric, "sensor");
-            if (cJSON_IsString(chip) && cJSON_IsString(sensor)) {
-                ESP_LOGI(TAG, "温度传感器: chip=%s, sensor=%s", chip->valuestring, sensor->valuestring);
-            }
-        }
+        ESP_LOGI(TAG, "批量查询结果: %d/%d项有效, 序列%d个, 忽略%d个, 响应%lu字节",
+                 batch->received, batch->count, batch->series, batch->ignored,
+                 (unsigned long)stream.scanner.bytes);
     }
-      cJSON_Delete(json);
     return ESP_OK;
 }
 
+static void on_batch_data(void* ctx, const char* data, size_t len) {
+    batch_stream_t* stream = (batch_stream_t*)ctx;
+    if (data == NULL) {
+        // 客户端重新发送请求：丢弃之前扫描的内容
+        bsp_prom_scanner_reset(&stream->scanner);
+        bsp_promql_batch_clear_results(stream->batch);
+        return;
+    }
+    bsp_prom_scanner_feed(&stream->scanner, data, len);
+}
+
+static void on_batch_series(void* ctx, const char* label, size_t label_len, const char* value, size_t value_len) {
+    bsp_promql_batch_feed((bsp_promql_batch_t*)ctx, label, label_len, value, value_len);
+}
+
+// 连接诊断查询的流式接收上下文：统计返回的up序列数
+typedef struct {
+    bsp_prom_scanner_t scanner;
+    int series;
+} probe_stream_t;
+
 /**
  * @brief 网络连接诊断测试
  * 
@@ -1110,30 +1357,41 @@ void bsp_board_ws2812_display_test_network_connectivity(void) {
         ESP_LOGW(TAG, "  2. 检查以太网连接");
         ESP_LOGW(TAG, "  3. 重启网络监控");
     }
-      // 测试HTTP连接能力
-    ESP_LOGI(TAG, "测试HTTP连接能力...");
-      esp_http_client_config_t test_config = {
-        .url = BOARD_PROMETHEUS_API,
-        .timeout_ms = 2000,  // 较短超时用于快速测试
-        .method = HTTP_METHOD_HEAD,  // 只请求头部，减少数据传输
-    };
+    // 通过Prometheus客户端查询up，复用指标查询的连接池
+    ESP_LOGI(TAG, "测试Prometheus查询能力...");
+    probe_stream_t stream = { .series = 0 };
+    bsp_prom_scanner_init(&stream.scanner, "job", on_probe_series, &stream.series);
     
-    esp_http_client_handle_t test_client = esp_http_client_init(&test_config);
-    if (test_client) {
-        esp_err_t err = esp_http_client_perform(test_client);
-        int status_code = esp_http_client_get_status_code(test_client);
-        
-        if (err == ESP_OK && status_code == 200) {
-            ESP_LOGI(TAG, "N305 HTTP连接测试: 成功 (状态码: %d)", status_code);
-        } else {
-            ESP_LOGW(TAG, "N305 HTTP连接测试: 失败 (错误: %s, 状态码: %d)", 
-                     esp_err_to_name(err), status_code);
-        }
-        
-        esp_http_client_cleanup(test_client);
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t err = bsp_prometheus_client_query_stream_until("up", start_us + CONNECTIVITY_TEST_TIMEOUT_MS * 1000LL,
+                                                             on_probe_data, &stream);
+    int64_t elapsed_ms = (esp_timer_get_time() - start_us) / 1000;
+    bsp_prom_scan_result_t scan = bsp_prom_scanner_finish(&stream.scanner);
+    
+    if (err == ESP_OK && scan == BSP_PROM_SCAN_OK && bsp_prom_scanner_is_success(&stream.scanner)) {
+        ESP_LOGI(TAG, "N305 Prometheus连接测试: 成功 (%d个目标, %lu字节, %lld ms)",
+                 stream.series, (unsigned long)stream.scanner.bytes, (long long)elapsed_ms);
+    } else {
+        ESP_LOGW(TAG, "N305 Prometheus连接测试: 失败 (错误: %s, 解析: %s, %lld ms)",
+                 esp_err_to_name(err), bsp_prom_scanner_result_name(scan), (long long)elapsed_ms);
     }
     
     ESP_LOGI(TAG, "===========================================");
 }
 
+static void on_probe_data(void* ctx, const char* data, size_t len) {
+    probe_stream_t* stream = (probe_stream_t*)ctx;
+    if (data == NULL) {
+        // 客户端重新发送请求：丢弃之前扫描的内容
+        bsp_prom_scanner_reset(&stream->scanner);
+        stream->series = 0;
+        return;
+    }
+    bsp_prom_scanner_feed(&stream->scanner, data, len);
+}
+
+static void on_probe_series(void* ctx, const char* label, size_t label_len, const char* value, size_t value_len) {
+    (*(int*)ctx)++;
+}
+
 // ========== 缺失的函数实现 ==========
@@ -0,0 +1,191 @@
+/**
+ * @file bsp_led_bargraph.c
+ * @brief 灯带条形图渲染器实现
+ *
+ * 平滑采用一阶逼近：每帧移动剩余距离的 dt/BSP_LED_BAR_SMOOTHING_MS（远离零取整），
+ * 剩余不足1/32颗LED时直接到位，稳定后返回静止，不再占用刷新。
+ */
+
+#include "bsp_led_bargraph.h"
+#include <string.h>
+
+#define LEVEL_ONE               256     // 一颗LED的Q8长度
+#define LEVEL_SNAP              8       // 剩余距离小于该值时直接到位
+#define INVALID_LEVEL           16      // 数值无效时起始LED的亮度（Q8）
+
+// 峰值标记颜色
+static const bsp_led_rgb_t PEAK_COLOR = {255, 255, 255};
+
+// ========== 静态函数声明 ==========
+static uint32_t advance_segment(bsp_led_bar_segment_t *seg, uint32_t now_ms, uint32_t dt_ms,
+                                uint32_t frame_interval_ms);
+static void draw_segment(const bsp_led_bar_segment_t *seg, bsp_led_rgb_t *pixels, uint16_t pixel_count);
+static bsp_led_rgb_t gradient_color(const bsp_led_bar_segment_config_t *config, int index);
+static uint8_t lerp_channel(uint8_t from, uint8_t to, int32_t alpha);
+
+// ========== 核心接口实现 ==========
+
+void bsp_led_bargraph_init(bsp_led_bargraph_t *bar, uint32_t frame_interval_ms) {
+    if (bar == NULL) {
+        return;
+    }
+    memset(bar, 0, sizeof(*bar));
+    bar->frame_interval_ms = frame_interval_ms > 0 ? frame_interval_ms : 1;
+}
+
+bool bsp_led_bargraph_configure(bsp_led_bargraph_t *bar, const bsp_led_bar_segment_config_t *configs,
+                                uint8_t count) {
+    if (bar == NULL || (configs == NULL && count > 0) || count > BSP_LED_BAR_MAX_SEGMENTS) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (configs[i].led_count == 0 || configs[i].max_value <= configs[i].min_value) {
+            return false;
+        }
+    }
+
+    memset(bar->segments, 0, sizeof(bar->segments));
+    for (uint8_t i = 0; i < count; i++) {
+        bar->segments[i].config = configs[i];
+    }
+    bar->segment_count = count;
+    bar->rendered = false;
+    return true;
+}
+
+void bsp_led_bargraph_set_value(bsp_led_bargraph_t *bar, uint8_t index, int32_t value, bool valid) {
+    if (bar == NULL || index >= bar->segment_count) {
+        return;
+    }
+
+    bsp_led_bar_segment_t *seg = &bar->segments[index];
+    seg->valid = valid;
+    seg->value = value;
+    if (!valid) {
+        seg->target_q8 = 0;
+        seg->level_q8 = 0;
+        seg->peak_q8 = 0;
+        return;
+    }
+
+    const bsp_led_bar_segment_config_t *config = &seg->config;
+    if (value < config->min_value) {
+        value = config->min_value;
+    } else if (value > config->max_value) {
+        value = config->max_value;
+    }
+    int64_t span = (int64_t)config->max_value - config->min_value;
+    seg->target_q8 = (int32_t)(((int64_t)value - config->min_value) * config->led_count * LEVEL_ONE / span);
+}
+
+uint32_t bsp_led_bargraph_render(bsp_led_bargraph_t *bar, uint32_t now_ms,
+                                 bsp_led_rgb_t *pixels, uint16_t pixel_count) {
+    if (bar == NULL || pixels == NULL) {
+        return BSP_LED_EFFECT_STATIC;
+    }
+
+    uint32_t dt_ms = bar->rendered ? now_ms - bar->last_render_ms : 0;
+    bar->last_render_ms = now_ms;
+    bar->rendered = true;
+
+    uint32_t next_ms = BSP_LED_EFFECT_STATIC;
+    for (uint8_t i = 0; i < bar->segment_count; i++) {
+        uint32_t seg_next_ms = advance_segment(&bar->segments[i], now_ms, dt_ms, bar->frame_interval_ms);
+        if (seg_next_ms < next_ms) {
+            next_ms = seg_next_ms;
+        }
+        draw_segment(&bar->segments[i], pixels, pixel_count);
+    }
+    return next_ms;
+}
+
+// ========== 静态函数实现 ==========
+
+// 推进平滑和峰值，返回该分段下一次需要刷新的时间
+static uint32_t advance_segment(bsp_led_bar_segment_t *seg, uint32_t now_ms, uint32_t dt_ms,
+                                uint32_t frame_interval_ms) {
+    int32_t diff = seg->target_q8 - seg->level_q8;
+    if (diff > -LEVEL_SNAP && diff < LEVEL_SNAP) {
+        seg->level_q8 = seg->target_q8;
+    } else if (dt_ms > 0) {
+        // 远离零取整：刷新间隔很短时每帧至少移动1，不会停在目标附近
+        int32_t step_ms = (int32_t)(dt_ms < BSP_LED_BAR_SMOOTHING_MS ? dt_ms : BSP_LED_BAR_SMOOTHING_MS);
+        int32_t round = diff > 0 ? BSP_LED_BAR_SMOOTHING_MS - 1 : -(BSP_LED_BAR_SMOOTHING_MS - 1);
+        seg->level_q8 += (diff * step_ms + round) / BSP_LED_BAR_SMOOTHING_MS;
+    }
+
+    if (seg->level_q8 >= seg->peak_q8) {
+        seg->peak_q8 = seg->level_q8;
+        seg->peak_time_ms = now_ms;
+    } else {
+        uint32_t held_ms = now_ms - seg->peak_time_ms;
+        if (held_ms > BSP_LED_BAR_PEAK_HOLD_MS) {
+            // 只对超过停留时间的部分回落
+            uint32_t decay_ms = held_ms - BSP_LED_BAR_PEAK_HOLD_MS;
+            if (decay_ms > dt_ms) {
+                decay_ms = dt_ms;
+            }
+            int32_t drop = (int32_t)(decay_ms * BSP_LED_BAR_PEAK_DECAY_LEDS * LEVEL_ONE / 1000);
+            seg->peak_q8 -= drop > 0 ? drop : 1;
+            if (seg->peak_q8 < seg->level_q8) {
+                seg->peak_q8 = seg->level_q8;
+            }
+        }
+    }
+
+    if (seg->level_q8 != seg->target_q8) {
+        return frame_interval_ms;
+    }
+    if (seg->peak_q8 > seg->level_q8) {
+        // 停留期间画面不变，到期后再逐帧回落
+        uint32_t held_ms = now_ms - seg->peak_time_ms;
+        return held_ms < BSP_LED_BAR_PEAK_HOLD_MS ? BSP_LED_BAR_PEAK_HOLD_MS - held_ms : frame_interval_ms;
+    }
+    return BSP_LED_EFFECT_STATIC;
+}
+
+static void draw_segment(const bsp_led_bar_segment_t *seg, bsp_led_rgb_t *pixels, uint16_t pixel_count) {
+    const bsp_led_bar_segment_config_t *config = &seg->config;
+    int count = config->led_count;
+    int top_lit = seg->level_q8 > 0 ? (seg->level_q8 - 1) / LEVEL_ONE : -1;
+    int peak_index = seg->peak_q8 > 0 ? (seg->peak_q8 - 1) / LEVEL_ONE : -1;
+
+    for (int i = 0; i < count; i++) {
+        int physical = config->first_led + (config->reverse ? count - 1 - i : i);
+        if (physical >= pixel_count) {
+            continue;
+        }
+
+        bsp_led_rgb_t color;
+        if (!seg->valid) {
+            // 没有数据：只微亮起始LED
+            color = (i == 0) ? bsp_led_effect_scale_rgb(config->low_color, INVALID_LEVEL)
+                             : (bsp_led_rgb_t){0, 0, 0};
+        } else if (i == peak_index && peak_index > top_lit) {
+            color = PEAK_COLOR;
+        } else {
+            int32_t fill = seg->level_q8 - i * LEVEL_ONE;
+            if (fill <= 0) {
+                color = (bsp_led_rgb_t){0, 0, 0};
+            } else {
+                uint8_t level = fill >= LEVEL_ONE ? 255 : (uint8_t)fill;
+                color = bsp_led_effect_scale_rgb(gradient_color(config, i), level);
+            }
+        }
+        pixels[physical] = color;
+    }
+}
+
+static bsp_led_rgb_t gradient_color(const bsp_led_bar_segment_config_t *config, int index) {
+    int32_t alpha = config->led_count > 1 ? index * LEVEL_ONE / (config->led_count - 1) : 0;
+    bsp_led_rgb_t color = {
+        lerp_channel(config->low_color.r, config->high_color.r, alpha),
+        lerp_channel(config->low_color.g, config->high_color.g, alpha),
+        lerp_channel(config->low_color.b, config->high_color.b, alpha),
+    };
+    return color;
+}
+
+static uint8_t lerp_channel(uint8_t from, uint8_t to, int32_t alpha) {
+    return (uint8_t)(from + ((int32_t)to - from) * alpha / LEVEL_ONE);
+}
@@ -0,0 +1,333 @@
+/**
+ * @file bsp_led_device.c
+ * @brief LED设备抽象实现
+ *
+ * 电流按通道亮度线性估算：每个通道满亮度BSP_LED_CHANNEL_FULL_UA，另加每颗
+ * BSP_LED_IDLE_UA静态电流。超过上限时整帧按同一比例降低亮度，保持颜色不变。
+ *
+ * 故障状态只在bsp_led_device_recover()中退出，刷新路径不做任何等待。
+ */
+
+#include "bsp_led_device.h"
+#include <stddef.h>
+#include <string.h>
+
+#define DEFAULT_MAX_RETRIES     1       // 默认立即重试次数
+#define DEFAULT_BACKOFF_MIN_MS  10      // 默认首次恢复间隔
+#define DEFAULT_BACKOFF_MAX_MS  2000    // 默认最大恢复间隔
+#define TIMEOUT_MARGIN_FACTOR   4       // 输出超时相对理论传输时间的倍数
+#define TIMEOUT_MARGIN_US       5000    // 输出超时的固定余量（任务抢占等）
+
+// ========== 静态函数声明 ==========
+static void build_output(bsp_led_device_t *dev);
+static int open_backend(bsp_led_device_t *dev);
+static void close_backend(bsp_led_device_t *dev);
+static void enter_fault(bsp_led_device_t *dev, uint32_t now_ms);
+
+// ========== 核心接口实现 ==========
+
+bsp_led_device_config_t bsp_led_device_get_default_config(const char *name, uint16_t led_count) {
+    bsp_led_device_config_t config = {
+        .name = name,
+        .led_count = led_count,
+        .max_brightness = 255,
+        .power_limit_ma = 0,
+        .max_retries = DEFAULT_MAX_RETRIES,
+        .write_timeout_us = (uint32_t)led_count * BSP_LED_FRAME_US_PER_LED * TIMEOUT_MARGIN_FACTOR + TIMEOUT_MARGIN_US,
+        .backoff_min_ms = DEFAULT_BACKOFF_MIN_MS,
+        .backoff_max_ms = DEFAULT_BACKOFF_MAX_MS,
+    };
+    return config;
+}
+
+int bsp_led_device_init(bsp_led_device_t *dev, const bsp_led_device_config_t *config,
+                        const bsp_led_backend_t *backend, void *backend_ctx,
+                        bsp_led_rgb_t *pixels, bsp_led_rgb_t *output, uint32_t now_ms) {
+    if (dev == NULL || config == NULL || backend == NULL || backend->write == NULL ||
+        pixels == NULL || output == NULL || config->led_count == 0) {
+        return BSP_LED_DEVICE_ERR_INVALID_ARG;
+    }
+
+    memset(dev, 0, sizeof(*dev));
+    dev->config = *config;
+    dev->backend = backend;
+    dev->backend_ctx = backend_ctx;
+    dev->pixels = pixels;
+    dev->output = output;
+    memset(pixels, 0, sizeof(bsp_led_rgb_t) * config->led_count);
+    dev->dirty = true;
+
+    int ret = open_backend(dev);
+    if (ret != 0) {
+        // 不等待首次退避间隔，后台可以立即开始恢复
+        enter_fault(dev, now_ms);
+        dev->retry_at_ms = now_ms;
+    }
+    return ret;
+}
+
+void bsp_led_device_deinit(bsp_led_device_t *dev) {
+    if (dev != NULL && dev->backend != NULL) {
+        close_backend(dev);
+    }
+}
+
+bool bsp_led_device_set_pixel(bsp_led_device_t *dev, uint16_t index, bsp_led_rgb_t color) {
+    if (dev == NULL || index >= dev->config.led_count) {
+        return false;
+    }
+    bsp_led_rgb_t *p = &dev->pixels[index];
+    if (p->r != color.r || p->g != color.g || p->b != color.b) {
+        *p = color;
+        dev->dirty = true;
+    }
+    return true;
+}
+
+void bsp_led_device_fill(bsp_led_device_t *dev, bsp_led_rgb_t color) {
+    if (dev == NULL) {
+        return;
+    }
+    for (uint16_t i = 0; i < dev->config.led_count; i++) {
+        bsp_led_device_set_pixel(dev, i, color);
+    }
+}
+
+void bsp_led_device_write_frame(bsp_led_device_t *dev, const bsp_led_rgb_t *pixels, uint16_t count) {
+    if (dev == NULL || pixels == NULL) {
+        return;
+    }
+    if (count > dev->config.led_count) {
+        count = dev->config.led_count;
+    }
+    size_t bytes = sizeof(bsp_led_rgb_t) * count;
+    if (memcmp(dev->pixels, pixels, bytes) != 0) {
+        memcpy(dev->pixels, pixels, bytes);
+        dev->dirty = true;
+    }
+}
+
+void bsp_led_device_mark_dirty(bsp_led_device_t *dev) {
+    if (dev != NULL) {
+        dev->dirty = true;
+    }
+}
+
+int bsp_led_device_refresh(bsp_led_device_t *dev, bool force, uint32_t now_ms) {
+    if (dev == NULL || dev->backend == NULL) {
+        return BSP_LED_DEVICE_ERR_INVALID_ARG;
+    }
+
+    dev->stats.refreshes++;
+    if (!dev->dirty && !force) {
+        dev->stats.skipped++;
+        return 0;
+    }
+
+    // 故障期间不访问后端，帧缓冲区保持dirty，恢复后补发
+    if (dev->faulted) {
+        dev->stats.faulted_drops++;
+        return BSP_LED_DEVICE_ERR_FAULTED;
+    }
+
+    build_output(dev);
+
+    int ret = 0;
+    for (uint8_t attempt = 0; ; attempt++) {
+        ret = dev->backend->write(dev->backend_ctx, dev->output, dev->config.led_count);
+        if (ret == 0) {
+            break;
+        }
+        dev->stats.write_errors++;
+        dev->stats.last_error = ret;
+        if (attempt >= dev->config.max_retries) {
+            break;
+        }
+
+        // 立即重新打开后端后重试（RMT通道状态异常时需要重建）
+        close_backend(dev);
+        dev->stats.reopens++;
+        int open_ret = open_backend(dev);
+        if (open_ret != 0) {
+            ret = open_ret;
+            break;
+        }
+    }
+
+    if (ret != 0) {
+        // 保持dirty，交给后台恢复
+        dev->stats.failed_frames++;
+        enter_fault(dev, now_ms);
+        return ret;
+    }
+
+    dev->stats.writes++;
+    dev->dirty = false;
+    return 0;
+}
+
+// ========== 故障恢复实现 ==========
+
+uint32_t bsp_led_device_recovery_delay_ms(const bsp_led_device_t *dev, uint32_t now_ms) {
+    if (dev == NULL || !dev->faulted) {
+        return BSP_LED_DEVICE_NO_RECOVERY;
+    }
+    int32_t remaining = (int32_t)(dev->retry_at_ms - now_ms);
+    return remaining > 0 ? (uint32_t)remaining : 0;
+}
+
+int bsp_led_device_recover(bsp_led_device_t *dev, uint32_t now_ms) {
+    if (dev == NULL || dev->backend == NULL) {
+        return BSP_LED_DEVICE_ERR_INVALID_ARG;
+    }
+    if (!dev->faulted) {
+        return 0;
+    }
+
+    close_backend(dev);
+    dev->stats.reopens++;
+    int ret = open_backend(dev);
+    if (ret == 0) {
+        // 补发故障期间最后一帧，验证通道确实可用
+        build_output(dev);
+        ret = dev->backend->write(dev->backend_ctx, dev->output, dev->config.led_count);
+        if (ret != 0) {
+            dev->stats.write_errors++;
+            dev->stats.last_error = ret;
+            close_backend(dev);
+        }
+    }
+
+    if (ret != 0) {
+        dev->stats.recovery_failures++;
+        uint32_t next = dev->backoff_ms * 2;
+        if (next < dev->config.backoff_min_ms) {
+            next = dev->config.backoff_min_ms;
+        }
+        dev->backoff_ms = next > dev->config.backoff_max_ms ? dev->config.backoff_max_ms : next;
+        dev->retry_at_ms = now_ms + dev->backoff_ms;
+        return ret;
+    }
+
+    dev->faulted = false;
+    dev->dirty = false;
+    dev->stats.writes++;
+    dev->stats.recoveries++;
+    dev->stats.last_recovery_ms = now_ms - dev->fault_since_ms;
+    if (dev->stats.last_recovery_ms > dev->stats.max_recovery_ms) {
+        dev->stats.max_recovery_ms = dev->stats.last_recovery_ms;
+    }
+    return 0;
+}
+
+// ========== 限制与统计实现 ==========
+
+void bsp_led_device_set_max_brightness(bsp_led_device_t *dev, uint8_t max_brightness) {
+    if (dev != NULL && dev->config.max_brightness != max_brightness) {
+        dev->config.max_brightness = max_brightness;
+        dev->dirty = true;
+    }
+}
+
+void bsp_led_device_set_power_limit(bsp_led_device_t *dev, uint32_t power_limit_ma) {
+    if (dev != NULL && dev->config.power_limit_ma != power_limit_ma) {
+        dev->config.power_limit_ma = power_limit_ma;
+        dev->dirty = true;
+    }
+}
+
+uint32_t bsp_led_device_estimate_current_ua(const bsp_led_rgb_t *pixels, uint16_t count) {
+    if (pixels == NULL) {
+        return 0;
+    }
+    uint64_t channel_sum = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        channel_sum += (uint32_t)pixels[i].r + pixels[i].g + pixels[i].b;
+    }
+    return (uint32_t)(channel_sum * BSP_LED_CHANNEL_FULL_UA / 255) + (uint32_t)count * BSP_LED_IDLE_UA;
+}
+
+bool bsp_led_device_record_write_time(bsp_led_device_t *dev, uint32_t elapsed_us, uint32_t now_ms) {
+    if (dev == NULL) {
+        return false;
+    }
+    dev->stats.write_us_total += elapsed_us;
+    if (elapsed_us > dev->stats.write_us_max) {
+        dev->stats.write_us_max = elapsed_us;
+    }
+
+    // 输出已完成但远超理论传输时间：通道状态异常，重建后端
+    if (dev->config.write_timeout_us > 0 && elapsed_us > dev->config.write_timeout_us && !dev->faulted) {
+        dev->stats.timeouts++;
+        enter_fault(dev, now_ms);
+        return true;
+    }
+    return false;
+}
+
+// ========== 静态函数实现 ==========
+
+// 帧缓冲区 -> 亮度上限 -> 电流上限 -> 输出缓冲区
+static void build_output(bsp_led_device_t *dev) {
+    uint16_t count = dev->config.led_count;
+    uint8_t level = dev->config.max_brightness;
+
+    if (level == 255) {
+        memcpy(dev->output, dev->pixels, sizeof(bsp_led_rgb_t) * count);
+    } else {
+        for (uint16_t i = 0; i < count; i++) {
+            dev->output[i] = bsp_led_effect_scale_rgb(dev->pixels[i], level);
+        }
+    }
+
+    uint32_t current_ua = bsp_led_device_estimate_current_ua(dev->output, count);
+    uint64_t limit_ua = (uint64_t)dev->config.power_limit_ma * 1000;
+    if (limit_ua > 0 && current_ua > limit_ua) {
+        // 静态电流不随亮度变化，只按动态部分计算缩放比例
+        uint32_t idle_ua = (uint32_t)count * BSP_LED_IDLE_UA;
+        uint64_t budget_ua = limit_ua > idle_ua ? limit_ua - idle_ua : 0;
+        uint64_t active_ua = current_ua - idle_ua;
+        uint8_t scale = (uint8_t)(budget_ua * 255 / active_ua);
+
+        for (uint16_t i = 0; i < count; i++) {
+            dev->output[i] = bsp_led_effect_scale_rgb(dev->output[i], scale);
+        }
+        current_ua = bsp_led_device_estimate_current_ua(dev->output, count);
+        dev->stats.limited_frames++;
+    }
+
+    dev->stats.current_ma = current_ua / 1000;
+    if (dev->stats.current_ma > dev->stats.peak_current_ma) {
+        dev->stats.peak_current_ma = dev->stats.current_ma;
+    }
+}
+
+static int open_backend(bsp_led_device_t *dev) {
+    if (dev->backend->open == NULL) {
+        dev->is_open = true;
+        return 0;
+    }
+    int ret = dev->backend->open(dev->backend_ctx, dev->config.led_count);
+    dev->is_open = (ret == 0);
+    if (ret != 0) {
+        dev->stats.last_error = ret;
+    }
+    return ret;
+}
+
+static void close_backend(bsp_led_device_t *dev) {
+    if (dev->is_open && dev->backend->close != NULL) {
+        dev->backend->close(dev->backend_ctx);
+    }
+    dev->is_open = false;
+}
+
+static void enter_fault(bsp_led_device_t *dev, uint32_t now_ms) {
+    close_backend(dev);
+    dev->faulted = true;
+    dev->fault_since_ms = now_ms;
+    dev->backoff_ms = dev->config.backoff_min_ms;
+    dev->retry_at_ms = now_ms + dev->backoff_ms;
+    dev->dirty = true;
+    dev->stats.faults++;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file bsp_led_effect.c
+ * @brief 状态灯整数效果引擎实现
+ *
+ * 相位统一换算为16位（65536为一整周），正弦取自四分之一周期表并在相邻项之间
+ * 线性插值，误差不超过1/255。亮度缩放与原先的 value*brightness/255 结果一致，
+ * 但用移位代替除法。
+ */
+
+#include "bsp_led_effect.h"
+#include <stddef.h>
+
+// 四分之一周期正弦表：round(255 * sin(i * pi / 128))，i = 0..64
+static const uint8_t SIN_QUARTER_TABLE[65] = {
+      0,   6,  13,  19,  25,  31,  37,  44,  50,  56,  62,  68,  74,
+     80,  86,  92,  98, 103, 109, 115, 120, 126, 131, 136, 142, 147,
+    152, 157, 162, 167, 171, 176, 180, 185, 189, 193, 197, 201, 205,
+    208, 212, 215, 219, 222, 225, 228, 231, 233, 236, 238, 240, 242,
+    244, 246, 247, 249, 250, 251, 252, 253, 254, 254, 255, 255, 255,
+};
+
+// ========== 静态函数声明 ==========
+static int16_t sin_table_lookup(uint8_t index);
+static uint16_t get_phase(uint32_t elapsed_ms, uint32_t period_ms);
+static uint8_t lerp8(uint8_t from, uint8_t to, uint8_t alpha);
+
+// ========== 核心接口实现 ==========
+
+void bsp_led_effect_init(bsp_led_effect_t *effect, uint32_t frame_interval_ms) {
+    if (effect == NULL) {
+        return;
+    }
+    effect->type = BSP_LED_EFFECT_SOLID;
+    effect->color = (bsp_led_rgb_t){0, 0, 0};
+    effect->color2 = (bsp_led_rgb_t){0, 0, 0};
+    effect->period_ms = 0;
+    effect->start_ms = 0;
+    effect->frame_interval_ms = frame_interval_ms > 0 ? frame_interval_ms : 1;
+}
+
+bool bsp_led_effect_set(bsp_led_effect_t *effect, bsp_led_effect_type_t type,
+                        bsp_led_rgb_t color, bsp_led_rgb_t color2,
+                        uint32_t period_ms, uint32_t now_ms) {
+    if (effect == NULL) {
+        return false;
+    }
+
+    if (effect->type == type && effect->period_ms == period_ms &&
+        effect->color.r == color.r && effect->color.g == color.g && effect->color.b == color.b &&
+        effect->color2.r == color2.r && effect->color2.g == color2.g && effect->color2.b == color2.b) {
+        return false;
+    }
+
+    effect->type = type;
+    effect->color = color;
+    effect->color2 = color2;
+    effect->period_ms = period_ms;
+    effect->start_ms = now_ms;
+    return true;
+}
+
+void bsp_led_effect_restart(bsp_led_effect_t *effect, uint32_t now_ms) {
+    if (effect != NULL) {
+        effect->start_ms = now_ms;
+    }
+}
+
+uint32_t bsp_led_effect_render(const bsp_led_effect_t *effect, uint32_t now_ms, bsp_led_rgb_t *out) {
+    if (effect == NULL || out == NULL) {
+        return BSP_LED_EFFECT_STATIC;
+    }
+
+    uint32_t period = effect->period_ms;
+    uint32_t elapsed = now_ms - effect->start_ms;
+
+    if (period == 0 || effect->type == BSP_LED_EFFECT_SOLID || effect->type >= BSP_LED_EFFECT_COUNT) {
+        *out = effect->color;
+        return BSP_LED_EFFECT_STATIC;
+    }
+
+    switch (effect->type) {
+        case BSP_LED_EFFECT_BLINK: {
+            // 先亮后灭，下一次刷新为下一次切换时刻
+            bool on = ((elapsed / period) & 1) == 0;
+            *out = on ? effect->color : (bsp_led_rgb_t){0, 0, 0};
+            return period - (elapsed % period);
+        }
+
+        case BSP_LED_EFFECT_BREATH: {
+            uint8_t level = bsp_led_effect_breath_level(get_phase(elapsed, period));
+            *out = bsp_led_effect_scale_rgb(effect->color, level);
+            return effect->frame_interval_ms;
+        }
+
+        case BSP_LED_EFFECT_PULSE: {
+            uint8_t level = bsp_led_effect_breath_level(get_phase(elapsed, period));
+            *out = bsp_led_effect_scale_rgb(effect->color, bsp_led_effect_scale8(level, level));
+            return effect->frame_interval_ms;
+        }
+
+        case BSP_LED_EFFECT_FADE: {
+            if (elapsed >= period) {
+                *out = effect->color2;
+                return BSP_LED_EFFECT_STATIC;
+            }
+            uint8_t alpha = (uint8_t)(((uint64_t)elapsed << 8) / period);
+            out->r = lerp8(effect->color.r, effect->color2.r, alpha);
+            out->g = lerp8(effect->color.g, effect->color2.g, alpha);
+            out->b = lerp8(effect->color.b, effect->color2.b, alpha);
+            uint32_t remaining = period - elapsed;
+            return remaining < effect->frame_interval_ms ? remaining : effect->frame_interval_ms;
+        }
+
+        case BSP_LED_EFFECT_RAINBOW:
+            *out = bsp_led_effect_hue((uint8_t)(get_phase(elapsed, period) >> 8));
+            return effect->frame_interval_ms;
+
+        default:
+            *out = effect->color;
+            return BSP_LED_EFFECT_STATIC;
+    }
+}
+
+// ========== 整数运算工具实现 ==========
+
+int16_t bsp_led_effect_sin(uint16_t phase) {
+    uint8_t index = (uint8_t)(phase >> 8);
+    int32_t frac = phase & 0xFF;
+    int32_t a = sin_table_lookup(index);
+    int32_t b = sin_table_lookup((uint8_t)(index + 1));
+    return (int16_t)(a + ((b - a) * frac) / 256);
+}
+
+uint8_t bsp_led_effect_breath_level(uint16_t phase) {
+    return (uint8_t)((bsp_led_effect_sin(phase) + 255) >> 1);
+}
+
+uint8_t bsp_led_effect_scale8(uint8_t value, uint8_t level) {
+    // floor(x / 255)，x < 65536时精确
+    uint32_t x = (uint32_t)value * level;
+    return (uint8_t)((x + 1 + (x >> 8)) >> 8);
+}
+
+bsp_led_rgb_t bsp_led_effect_scale_rgb(bsp_led_rgb_t color, uint8_t level) {
+    bsp_led_rgb_t scaled = {
+        bsp_led_effect_scale8(color.r, level),
+        bsp_led_effect_scale8(color.g, level),
+        bsp_led_effect_scale8(color.b, level),
+    };
+    return scaled;
+}
+
+bsp_led_rgb_t bsp_led_effect_hue(uint8_t hue) {
+    bsp_led_rgb_t color;
+    if (hue < 85) {
+        color = (bsp_led_rgb_t){(uint8_t)(255 - hue * 3), (uint8_t)(hue * 3), 0};
+    } else if (hue < 170) {
+        hue -= 85;
+        color = (bsp_led_rgb_t){0, (uint8_t)(255 - hue * 3), (uint8_t)(hue * 3)};
+    } else {
+        hue -= 170;
+        color = (bsp_led_rgb_t){(uint8_t)(hue * 3), 0, (uint8_t)(255 - hue * 3)};
+    }
+    return color;
+}
+
+// ========== 静态函数实现 ==========
+
+// 整周256个采样点，由四分之一周期表按对称性得到
+static int16_t sin_table_lookup(uint8_t index) {
+    uint8_t offset = index & 63;
+    switch (index >> 6) {
+        case 0:
+            return SIN_QUARTER_TABLE[offset];
+        case 1:
+            return SIN_QUARTER_TABLE[64 - offset];
+        case 2:
+            return -(int16_t)SIN_QUARTER_TABLE[offset];
+        default:
+            return -(int16_t)SIN_QUARTER_TABLE[64 - offset];
+    }
+}
+
+static uint16_t get_phase(uint32_t elapsed_ms, uint32_t period_ms) {
+    return (uint16_t)(((uint64_t)(elapsed_ms % period_ms) << 16) / period_ms);
+}
+
+static uint8_t lerp8(uint8_t from, uint8_t to, uint8_t alpha) {
+    return (uint8_t)(from + (((int32_t)to - from) * alpha) / 256);
+}
@@ -0,0 +1,254 @@
+/**
+ * @file bsp_led_governor.c
+ * @brief LED渲染帧率调速器实现
+ *
+ * 每个渲染器在帧结束时声明下一次刷新期限，调速器按平均单帧耗时估算
+ * 各渲染器的CPU负载，总负载超过预算时按比例拉长帧间隔。
+ * 声明静止的渲染器不计入负载，由渲染器自行阻塞直到模式变化。
+ */
+
+#include "bsp_led_governor.h"
+#include "bsp_config.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <string.h>
+#include <inttypes.h>
+
+static const char *TAG = "BSP_LED_GOV";
+
+#define FPS_WINDOW_US                   1000000     // 实际帧率统计窗口（1秒）
+#define COST_EWMA_SHIFT                 3           // 单帧耗时指数平均系数 1/8
+
+// 单个渲染器状态
+typedef struct {
+    bsp_led_governor_stats_t stats;
+    int64_t window_start_us;            // 帧率统计窗口起点
+    uint32_t window_frames;             // 窗口内帧数
+    uint32_t load_permille;             // 预估CPU负载（千分比）
+} renderer_state_t;
+
+// 调速器状态
+typedef struct {
+    bool is_initialized;
+    SemaphoreHandle_t mutex;
+    uint32_t budget_permille;           // 全局CPU预算（千分比）
+    renderer_state_t renderers[BSP_LED_RENDERER_MAX];
+} bsp_led_governor_t;
+
+static bsp_led_governor_t s_governor = {0};
+
+static const char* RENDERER_NAMES[BSP_LED_RENDERER_MAX] = {
+    "LED Matrix",
+    "Touch WS2812",
+    "Board WS2812"
+};
+
+// ========== 静态函数声明 ==========
+static uint32_t get_total_load_permille(void);
+static uint32_t calc_fps_x10(uint32_t frames, int64_t elapsed_us);
+
+// ========== 核心接口实现 ==========
+
+esp_err_t bsp_led_governor_init(void) {
+    if (s_governor.is_initialized) {
+        return ESP_OK;
+    }
+
+    s_governor.mutex = xSemaphoreCreateMutex();
+    if (!s_governor.mutex) {
+        ESP_LOGE(TAG, "创建调速器互斥锁失败");
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(s_governor.renderers, 0, sizeof(s_governor.renderers));
+    int64_t now = esp_timer_get_time();
+    for (int i = 0; i < BSP_LED_RENDERER_MAX; i++) {
+        s_governor.renderers[i].window_start_us = now;
+        s_governor.renderers[i].stats.requested_interval_ms = BSP_LED_DEADLINE_STATIC;
+        s_governor.renderers[i].stats.granted_interval_ms = BSP_LED_DEADLINE_STATIC;
+    }
+    s_governor.budget_permille = CONFIG_BSP_LED_CPU_BUDGET_PERCENT * 10;
+    s_governor.is_initialized = true;
+
+    ESP_LOGI(TAG, "LED渲染调速器初始化完成，CPU预算: %d%%", CONFIG_BSP_LED_CPU_BUDGET_PERCENT);
+    return ESP_OK;
+}
+
+int64_t bsp_led_governor_frame_begin(bsp_led_renderer_t renderer) {
+    (void)renderer;
+    return esp_timer_get_time();
+}
+
+uint32_t bsp_led_governor_frame_end(bsp_led_renderer_t renderer, int64_t begin_us,
+                                    uint32_t requested_interval_ms) {
+    if (!s_governor.is_initialized || renderer >= BSP_LED_RENDERER_MAX) {
+        return requested_interval_ms;
+    }
+
+    int64_t now = esp_timer_get_time();
+    uint32_t cost_us = (uint32_t)(now - begin_us);
+    uint32_t granted = requested_interval_ms;
+
+    if (xSemaphoreTake(s_governor.mutex, pdMS_TO_TICKS(10)) != pdTRUE) {
+        return requested_interval_ms;
+    }
+
+    renderer_state_t* r = &s_governor.renderers[renderer];
+    bsp_led_governor_stats_t* st = &r->stats;
+
+    // 单帧耗时统计
+    if (st->total_frames == 0) {
+        st->avg_frame_cost_us = cost_us;
+    } else {
+        st->avg_frame_cost_us += ((int32_t)cost_us - (int32_t)st->avg_frame_cost_us) >> COST_EWMA_SHIFT;
+    }
+    if (cost_us > st->max_frame_cost_us) {
+        st->max_frame_cost_us = cost_us;
+    }
+    st->total_frames++;
+
+    // 实际帧率统计
+    r->window_frames++;
+    int64_t elapsed_us = now - r->window_start_us;
+    if (elapsed_us >= FPS_WINDOW_US) {
+        st->achieved_fps_x10 = calc_fps_x10(r->window_frames, elapsed_us);
+        r->window_start_us = now;
+        r->window_frames = 0;
+    }
+
+    st->requested_interval_ms = requested_interval_ms;
+    if (requested_interval_ms == BSP_LED_DEADLINE_STATIC) {
+        // 静止画面不占用CPU预算
+        r->load_permille = 0;
+        st->requested_fps_x10 = 0;
+        st->static_declarations++;
+    } else {
+        if (requested_interval_ms == 0) {
+            requested_interval_ms = 1;
+        }
+        r->load_permille = st->avg_frame_cost_us / requested_interval_ms;
+        st->requested_fps_x10 = 10000 / requested_interval_ms;
+
+        // 总负载超出预算时按比例拉长帧间隔
+        uint32_t total = get_total_load_permille();
+        if (total > s_governor.budget_permille && s_governor.budget_permille > 0) {
+            granted = (uint32_t)(((uint64_t)requested_interval_ms * total) / s_governor.budget_permille);
+            st->throttled_frames++;
+        } else {
+            granted = requested_interval_ms;
+        }
+    }
+    st->granted_interval_ms = granted;
+
+    xSemaphoreGive(s_governor.mutex);
+    return granted;
+}
+
+// ========== 配置接口实现 ==========
+
+void bsp_led_governor_set_budget(uint8_t percent) {
+    if (percent == 0) {
+        percent = 1;
+    } else if (percent > 100) {
+        percent = 100;
+    }
+    s_governor.budget_permille = (uint32_t)percent * 10;
+    ESP_LOGI(TAG, "设置LED渲染CPU预算: %d%%", percent);
+}
+
+uint8_t bsp_led_governor_get_budget(void) {
+    return (uint8_t)(s_governor.budget_permille / 10);
+}
+
+// ========== 状态查询接口实现 ==========
+
+esp_err_t bsp_led_governor_get_stats(bsp_led_renderer_t renderer, bsp_led_governor_stats_t* stats) {
+    if (!stats || renderer >= BSP_LED_RENDERER_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!s_governor.is_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (xSemaphoreTake(s_governor.mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    renderer_state_t* r = &s_governor.renderers[renderer];
+    *stats = r->stats;
+
+    // 渲染器长时间没有出帧（静止）时，用当前窗口刷新实际帧率
+    int64_t elapsed_us = esp_timer_get_time() - r->window_start_us;
+    if (elapsed_us >= FPS_WINDOW_US) {
+        stats->achieved_fps_x10 = calc_fps_x10(r->window_frames, elapsed_us);
+    }
+
+    xSemaphoreGive(s_governor.mutex);
+    return ESP_OK;
+}
+
+uint32_t bsp_led_governor_get_load_permille(void) {
+    if (!s_governor.is_initialized) {
+        return 0;
+    }
+
+    uint32_t total = 0;
+    if (xSemaphoreTake(s_governor.mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        total = get_total_load_permille();
+        xSemaphoreGive(s_governor.mutex);
+    }
+    return total;
+}
+
+void bsp_led_governor_print_stats(void) {
+    if (!s_governor.is_initialized) {
+        ESP_LOGW(TAG, "LED渲染调速器未初始化");
+        return;
+    }
+
+    ESP_LOGI(TAG, "========== LED渲染调速器统计 ==========");
+    ESP_LOGI(TAG, "CPU预算: %" PRIu32 ".%" PRIu32 "%%, 当前预估负载: %" PRIu32 ".%" PRIu32 "%%",
+             s_governor.budget_permille / 10, s_governor.budget_permille % 10,
+             bsp_led_governor_get_load_permille() / 10, bsp_led_governor_get_load_permille() % 10);
+
+    for (int i = 0; i < BSP_LED_RENDERER_MAX; i++) {
+        bsp_led_governor_stats_t stats;
+        if (bsp_led_governor_get_stats((bsp_led_renderer_t)i, &stats) != ESP_OK) {
+            continue;
+        }
+
+        if (stats.requested_interval_ms == BSP_LED_DEADLINE_STATIC) {
+            ESP_LOGI(TAG, "[%s] 静止, 实际 %" PRIu32 ".%" PRIu32 " fps",
+                     RENDERER_NAMES[i], stats.achieved_fps_x10 / 10, stats.achieved_fps_x10 % 10);
+        } else {
+            ESP_LOGI(TAG, "[%s] 请求 %" PRIu32 ".%" PRIu32 " fps (%" PRIu32 " ms), 批准 %" PRIu32 " ms, 实际 %" PRIu32 ".%" PRIu32 " fps",
+                     RENDERER_NAMES[i], stats.requested_fps_x10 / 10, stats.requested_fps_x10 % 10,
+                     stats.requested_interval_ms, stats.granted_interval_ms,
+                     stats.achieved_fps_x10 / 10, stats.achieved_fps_x10 % 10);
+        }
+        ESP_LOGI(TAG, "  帧数: %" PRIu32 ", 平均耗时: %" PRIu32 " us, 最大耗时: %" PRIu32 " us, 限速帧: %" PRIu32 ", 静止声明: %" PRIu32,
+                 stats.total_frames, stats.avg_frame_cost_us, stats.max_frame_cost_us,
+                 stats.throttled_frames, stats.static_declarations);
+    }
+    ESP_LOGI(TAG, "========================================");
+}
+
+// ========== 静态函数实现 ==========
+
+static uint32_t get_total_load_permille(void) {
+    uint32_t total = 0;
+    for (int i = 0; i < BSP_LED_RENDERER_MAX; i++) {
+        total += s_governor.renderers[i].load_permille;
+    }
+    return total;
+}
+
+static uint32_t calc_fps_x10(uint32_t frames, int64_t elapsed_us) {
+    if (elapsed_us <= 0) {
+        return 0;
+    }
+    return (uint32_t)(((int64_t)frames * 10000000LL) / elapsed_us);
+}
@@ -0,0 +1,450 @@
+/**
+ * @file bsp_led_hub.c
+ * @brief LED设备注册中心实现
+ *
+ * 每个设备一把互斥锁，保护帧缓冲区和设备状态；后端输出在锁内完成，
+ * 输出耗时用esp_timer测量后记入设备统计。
+ *
+ * 设备进入故障状态后，渲染任务的刷新立即返回；后台恢复任务在最早的
+ * 重试时间醒来，重建后端并补发最近一帧，没有故障设备时一直阻塞。
+ */
+
+#include "bsp_led_hub.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+static const char *TAG = "BSP_LED_HUB";
+
+#define HUB_LOCK_TIMEOUT_MS             100     // 普通操作等待设备锁的超时时间
+#define RECOVERY_LOCK_RETRY_MS          10      // 恢复任务拿不到设备锁时的重试间隔
+#define RECOVERY_TASK_STACK_SIZE        3072
+#define RECOVERY_TASK_PRIORITY          3       // 低于LED渲染任务
+
+// 单个设备的注册信息
+typedef struct {
+    bool registered;
+    bsp_led_device_t dev;
+    SemaphoreHandle_t mutex;
+    bsp_led_rgb_t *buffers;             // 帧缓冲区和输出缓冲区（一次分配）
+    uint32_t lock_timeouts;             // 等待设备锁超时次数
+} hub_entry_t;
+
+// 注册中心状态
+typedef struct {
+    hub_entry_t entries[BSP_LED_DEVICE_MAX];
+    TaskHandle_t recovery_task;         // 后台故障恢复任务
+} bsp_led_hub_t;
+
+static bsp_led_hub_t s_hub = {0};
+
+static const char* DEVICE_NAMES[BSP_LED_DEVICE_MAX] = {
+    "LED Matrix",
+    "Touch WS2812",
+    "Board WS2812"
+};
+
+// ========== 静态函数声明 ==========
+static hub_entry_t* acquire_entry(bsp_led_device_id_t id, uint32_t timeout_ms, esp_err_t *err);
+static void release_entry(hub_entry_t *entry);
+static esp_err_t refresh_locked(hub_entry_t *entry, bool force);
+static esp_err_t to_esp_err(int ret);
+static uint32_t get_time_ms(void);
+static esp_err_t ensure_recovery_task(void);
+static void wake_recovery_task(void);
+static uint32_t run_recovery(void);
+static void recovery_task(void *arg);
+
+// ========== 核心接口实现 ==========
+
+esp_err_t bsp_led_hub_register(bsp_led_device_id_t id, const bsp_led_device_config_t *config,
+                               const bsp_led_backend_t *backend, void *backend_ctx) {
+    if (id >= BSP_LED_DEVICE_MAX || config == NULL || backend == NULL || config->led_count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    hub_entry_t *entry = &s_hub.entries[id];
+    if (entry->registered) {
+        ESP_LOGW(TAG, "[%s] 已注册", DEVICE_NAMES[id]);
+        return ESP_OK;
+    }
+
+    esp_err_t err = ensure_recovery_task();
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    if (entry->mutex == NULL) {
+        entry->mutex = xSemaphoreCreateMutex();
+        if (entry->mutex == NULL) {
+            ESP_LOGE(TAG, "[%s] 创建设备互斥锁失败", DEVICE_NAMES[id]);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    entry->buffers = calloc(2 * (size_t)config->led_count, sizeof(bsp_led_rgb_t));
+    if (entry->buffers == NULL) {
+        ESP_LOGE(TAG, "[%s] 分配帧缓冲区失败 (%u LEDs)", DEVICE_NAMES[id], config->led_count);
+        return ESP_ERR_NO_MEM;
+    }
+
+    int ret = bsp_led_device_init(&entry->dev, config, backend, backend_ctx,
+                                  entry->buffers, entry->buffers + config->led_count, get_time_ms());
+    if (ret == BSP_LED_DEVICE_ERR_INVALID_ARG) {
+        free(entry->buffers);
+        entry->buffers = NULL;
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    entry->lock_timeouts = 0;
+    entry->registered = true;
+
+    if (ret != 0) {
+        // 不阻塞启动流程：设备以故障状态注册，由后台任务重建
+        ESP_LOGW(TAG, "[%s] 打开%s后端失败: %s，转入后台恢复", DEVICE_NAMES[id], backend->name,
+                 esp_err_to_name(to_esp_err(ret)));
+        wake_recovery_task();
+        return ESP_OK;
+    }
+    ESP_LOGI(TAG, "[%s] 注册成功 (后端: %s, LEDs: %u)", DEVICE_NAMES[id], backend->name, config->led_count);
+    return ESP_OK;
+}
+
+esp_err_t bsp_led_hub_unregister(bsp_led_device_id_t id) {
+    if (id >= BSP_LED_DEVICE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    hub_entry_t *entry = &s_hub.entries[id];
+    if (!entry->registered) {
+        return ESP_OK;
+    }
+
+    // 先撤销注册，新的调用者不再进入；再等待当前持锁者完成
+    entry->registered = false;
+    xSemaphoreTake(entry->mutex, portMAX_DELAY);
+    bsp_led_device_deinit(&entry->dev);
+    free(entry->buffers);
+    entry->buffers = NULL;
+    xSemaphoreGive(entry->mutex);
+
+    ESP_LOGI(TAG, "[%s] 已注销", DEVICE_NAMES[id]);
+    return ESP_OK;
+}
+
+bool bsp_led_hub_is_registered(bsp_led_device_id_t id) {
+    return id < BSP_LED_DEVICE_MAX && s_hub.entries[id].registered;
+}
+
+uint16_t bsp_led_hub_get_led_count(bsp_led_device_id_t id) {
+    if (!bsp_led_hub_is_registered(id)) {
+        return 0;
+    }
+    return s_hub.entries[id].dev.config.led_count;
+}
+
+esp_err_t bsp_led_hub_set_pixel(bsp_led_device_id_t id, uint16_t index, bsp_led_rgb_t color) {
+    esp_err_t err;
+    hub_entry_t *entry = acquire_entry(id, HUB_LOCK_TIMEOUT_MS, &err);
+    if (entry == NULL) {
+        return err;
+    }
+    bool ok = bsp_led_device_set_pixel(&entry->dev, index, color);
+    release_entry(entry);
+    return ok ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t bsp_led_hub_fill(bsp_led_device_id_t id, bsp_led_rgb_t color) {
+    esp_err_t err;
+    hub_entry_t *entry = acquire_entry(id, HUB_LOCK_TIMEOUT_MS, &err);
+    if (entry == NULL) {
+        return err;
+    }
+    bsp_led_device_fill(&entry->dev, color);
+    release_entry(entry);
+    return ESP_OK;
+}
+
+esp_err_t bsp_led_hub_submit(bsp_led_device_id_t id, const bsp_led_rgb_t *pixels, uint16_t count) {
+    if (pixels == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err;
+    hub_entry_t *entry = acquire_entry(id, HUB_LOCK_TIMEOUT_MS, &err);
+    if (entry == NULL) {
+        return err;
+    }
+    bsp_led_device_write_frame(&entry->dev, pixels, count);
+    err = refresh_locked(entry, false);
+    release_entry(entry);
+    return err;
+}
+
+esp_err_t bsp_led_hub_refresh(bsp_led_device_id_t id) {
+    esp_err_t err;
+    hub_entry_t *entry = acquire_entry(id, HUB_LOCK_TIMEOUT_MS, &err);
+    if (entry == NULL) {
+        return err;
+    }
+    err = refresh_locked(entry, false);
+    release_entry(entry);
+    return err;
+}
+
+esp_err_t bsp_led_hub_clear(bsp_led_device_id_t id) {
+    esp_err_t err;
+    hub_entry_t *entry = acquire_entry(id, HUB_LOCK_TIMEOUT_MS, &err);
+    if (entry == NULL) {
+        return err;
+    }
+    bsp_led_device_fill(&entry->dev, (bsp_led_rgb_t){0, 0, 0});
+    err = refresh_locked(entry, true);
+    release_entry(entry);
+    return err;
+}
+
+esp_err_t bsp_led_hub_lock(bsp_led_device_id_t id, uint32_t timeout_ms,
+                           bsp_led_rgb_t **pixels, uint16_t *count) {
+    if (pixels == NULL || count == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err;
+    hub_entry_t *entry = acquire_entry(id, timeout_ms, &err);
+    if (entry == NULL) {
+        return err;
+    }
+    *pixels = entry->dev.pixels;
+    *count = entry->dev.config.led_count;
+    return ESP_OK;
+}
+
+esp_err_t bsp_led_hub_unlock(bsp_led_device_id_t id, bool modified) {
+    if (id >= BSP_LED_DEVICE_MAX || s_hub.entries[id].mutex == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    hub_entry_t *entry = &s_hub.entries[id];
+
+    if (modified) {
+        bsp_led_device_mark_dirty(&entry->dev);
+    }
+    esp_err_t err = refresh_locked(entry, false);
+    release_entry(entry);
+    return err;
+}
+
+// ========== 配置接口实现 ==========
+
+esp_err_t bsp_led_hub_set_max_brightness(bsp_led_device_id_t id, uint8_t max_brightness) {
+    esp_err_t err;
+    hub_entry_t *entry = acquire_entry(id, HUB_LOCK_TIMEOUT_MS, &err);
+    if (entry == NULL) {
+        return err;
+    }
+    bsp_led_device_set_max_brightness(&entry->dev, max_brightness);
+    release_entry(entry);
+    return ESP_OK;
+}
+
+esp_err_t bsp_led_hub_set_power_limit(bsp_led_device_id_t id, uint32_t power_limit_ma) {
+    esp_err_t err;
+    hub_entry_t *entry = acquire_entry(id, HUB_LOCK_TIMEOUT_MS, &err);
+    if (entry == NULL) {
+        return err;
+    }
+    bsp_led_device_set_power_limit(&entry->dev, power_limit_ma);
+    release_entry(entry);
+    return ESP_OK;
+}
+
+// ========== 统计接口实现 ==========
+
+esp_err_t bsp_led_hub_get_stats(bsp_led_device_id_t id, bsp_led_device_stats_t *stats) {
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err;
+    hub_entry_t *entry = acquire_entry(id, HUB_LOCK_TIMEOUT_MS, &err);
+    if (entry == NULL) {
+        return err;
+    }
+    *stats = entry->dev.stats;
+    release_entry(entry);
+    return ESP_OK;
+}
+
+void bsp_led_hub_print_stats(void) {
+    ESP_LOGI(TAG, "========== LED设备统计 ==========");
+    for (int i = 0; i < BSP_LED_DEVICE_MAX; i++) {
+        if (!bsp_led_hub_is_registered((bsp_led_device_id_t)i)) {
+            ESP_LOGI(TAG, "[%s] 未注册", DEVICE_NAMES[i]);
+            continue;
+        }
+
+        bsp_led_device_stats_t stats;
+        if (bsp_led_hub_get_stats((bsp_led_device_id_t)i, &stats) != ESP_OK) {
+            continue;
+        }
+        const bsp_led_device_config_t *config = &s_hub.entries[i].dev.config;
+        uint32_t avg_write_us = stats.writes > 0 ? (uint32_t)(stats.write_us_total / stats.writes) : 0;
+
+        ESP_LOGI(TAG, "[%s] 刷新: %" PRIu32 ", 输出: %" PRIu32 ", 跳过: %" PRIu32 ", 平均输出耗时: %" PRIu32 " us, 最大: %" PRIu32 " us",
+                 DEVICE_NAMES[i], stats.refreshes, stats.writes, stats.skipped, avg_write_us, stats.write_us_max);
+        ESP_LOGI(TAG, "  写入错误: %" PRIu32 ", 重建: %" PRIu32 ", 失败帧: %" PRIu32 ", 最近错误: %s, 锁超时: %" PRIu32,
+                 stats.write_errors, stats.reopens, stats.failed_frames,
+                 stats.last_error != 0 ? esp_err_to_name(to_esp_err(stats.last_error)) : "无",
+                 s_hub.entries[i].lock_timeouts);
+        ESP_LOGI(TAG, "  状态: %s, 故障: %" PRIu32 ", 超时: %" PRIu32 ", 故障丢帧: %" PRIu32 ", 恢复: %" PRIu32 " (失败 %" PRIu32 "), 恢复耗时: 最近 %" PRIu32 " ms, 最大 %" PRIu32 " ms",
+                 s_hub.entries[i].dev.faulted ? "故障" : "正常", stats.faults, stats.timeouts,
+                 stats.faulted_drops, stats.recoveries, stats.recovery_failures,
+                 stats.last_recovery_ms, stats.max_recovery_ms);
+        ESP_LOGI(TAG, "  亮度上限: %u, 电流上限: %" PRIu32 " mA, 估算电流: %" PRIu32 " mA (峰值 %" PRIu32 " mA), 限流帧: %" PRIu32,
+                 config->max_brightness, config->power_limit_ma, stats.current_ma, stats.peak_current_ma,
+                 stats.limited_frames);
+    }
+    ESP_LOGI(TAG, "=================================");
+}
+
+// ========== 静态函数实现 ==========
+
+static hub_entry_t* acquire_entry(bsp_led_device_id_t id, uint32_t timeout_ms, esp_err_t *err) {
+    if (id >= BSP_LED_DEVICE_MAX) {
+        *err = ESP_ERR_INVALID_ARG;
+        return NULL;
+    }
+    hub_entry_t *entry = &s_hub.entries[id];
+    if (!entry->registered) {
+        *err = ESP_ERR_INVALID_STATE;
+        return NULL;
+    }
+    if (xSemaphoreTake(entry->mutex, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        entry->lock_timeouts++;
+        *err = ESP_ERR_TIMEOUT;
+        return NULL;
+    }
+    // 等待期间可能已被注销
+    if (!entry->registered) {
+        xSemaphoreGive(entry->mutex);
+        *err = ESP_ERR_INVALID_STATE;
+        return NULL;
+    }
+    *err = ESP_OK;
+    return entry;
+}
+
+static void release_entry(hub_entry_t *entry) {
+    xSemaphoreGive(entry->mutex);
+}
+
+static esp_err_t refresh_locked(hub_entry_t *entry, bool force) {
+    int64_t start_us = esp_timer_get_time();
+    uint32_t now_ms = (uint32_t)(start_us / 1000);
+    bool will_write = (entry->dev.dirty || force) && !entry->dev.faulted;
+
+    int ret = bsp_led_device_refresh(&entry->dev, force, now_ms);
+    if (ret == 0 && will_write) {
+        // 跳过的刷新不计入输出耗时
+        uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start_us);
+        if (bsp_led_device_record_write_time(&entry->dev, elapsed_us, now_ms)) {
+            ESP_LOGW(TAG, "[%s] 输出超时 (%" PRIu32 " us)，转入后台恢复",
+                     entry->dev.config.name, elapsed_us);
+            wake_recovery_task();
+        }
+    } else if (ret != 0 && ret != BSP_LED_DEVICE_ERR_FAULTED && entry->dev.faulted) {
+        ESP_LOGW(TAG, "[%s] 输出失败: %s，转入后台恢复",
+                 entry->dev.config.name, esp_err_to_name(to_esp_err(ret)));
+        wake_recovery_task();
+    }
+    return to_esp_err(ret);
+}
+
+static esp_err_t to_esp_err(int ret) {
+    switch (ret) {
+        case 0:
+            return ESP_OK;
+        case BSP_LED_DEVICE_ERR_INVALID_ARG:
+            return ESP_ERR_INVALID_ARG;
+        case BSP_LED_DEVICE_ERR_NOT_OPEN:
+        case BSP_LED_DEVICE_ERR_FAULTED:
+            return ESP_ERR_INVALID_STATE;
+        default:
+            return (esp_err_t)ret;
+    }
+}
+
+static uint32_t get_time_ms(void) {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+static esp_err_t ensure_recovery_task(void) {
+    if (s_hub.recovery_task != NULL) {
+        return ESP_OK;
+    }
+    BaseType_t ret = xTaskCreate(recovery_task, "led_recovery", RECOVERY_TASK_STACK_SIZE, NULL,
+                                 RECOVERY_TASK_PRIORITY, &s_hub.recovery_task);
+    if (ret != pdPASS) {
+        s_hub.recovery_task = NULL;
+        ESP_LOGE(TAG, "创建LED故障恢复任务失败");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+static void wake_recovery_task(void) {
+    if (s_hub.recovery_task != NULL) {
+        xTaskNotifyGive(s_hub.recovery_task);
+    }
+}
+
+// 处理所有到期的故障设备，返回距下一次需要处理的时间
+static uint32_t run_recovery(void) {
+    uint32_t next_ms = BSP_LED_DEVICE_NO_RECOVERY;
+
+    for (int i = 0; i < BSP_LED_DEVICE_MAX; i++) {
+        hub_entry_t *entry = &s_hub.entries[i];
+        if (!entry->registered || !entry->dev.faulted) {
+            continue;
+        }
+        // 不与渲染任务抢锁：拿不到就稍后再试
+        if (xSemaphoreTake(entry->mutex, 0) != pdTRUE) {
+            next_ms = next_ms < RECOVERY_LOCK_RETRY_MS ? next_ms : RECOVERY_LOCK_RETRY_MS;
+            continue;
+        }
+
+        uint32_t now_ms = get_time_ms();
+        if (entry->registered && bsp_led_device_recovery_delay_ms(&entry->dev, now_ms) == 0) {
+            int ret = bsp_led_device_recover(&entry->dev, now_ms);
+            if (ret == 0) {
+                ESP_LOGI(TAG, "[%s] 已恢复，故障持续 %" PRIu32 " ms", DEVICE_NAMES[i],
+                         entry->dev.stats.last_recovery_ms);
+            } else {
+                ESP_LOGW(TAG, "[%s] 恢复失败: %s，%" PRIu32 " ms后重试", DEVICE_NAMES[i],
+                         esp_err_to_name(to_esp_err(ret)), entry->dev.backoff_ms);
+            }
+        }
+        uint32_t delay_ms = entry->registered ? bsp_led_device_recovery_delay_ms(&entry->dev, get_time_ms())
+                                              : BSP_LED_DEVICE_NO_RECOVERY;
+        xSemaphoreGive(entry->mutex);
+
+        if (delay_ms < next_ms) {
+            next_ms = delay_ms;
+        }
+    }
+    return next_ms;
+}
+
+static void recovery_task(void *arg) {
+    (void)arg;
+    while (1) {
+        uint32_t wait_ms = run_recovery();
+        TickType_t wait_ticks = wait_ms == BSP_LED_DEVICE_NO_RECOVERY ? portMAX_DELAY : pdMS_TO_TICKS(wait_ms);
+        if (wait_ms != BSP_LED_DEVICE_NO_RECOVERY && wait_ticks == 0) {
+            wait_ticks = 1;
+        }
+        ulTaskNotifyTake(pdTRUE, wait_ticks);
+    }
+}
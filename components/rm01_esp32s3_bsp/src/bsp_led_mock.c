@@ -0,0 +1,64 @@
+/**
+ * @file bsp_led_mock.c
+ * @brief LED设备模拟后端实现
+ */
+
+#include "bsp_led_mock.h"
+#include <string.h>
+
+// ========== 静态函数声明 ==========
+static int mock_open(void *ctx, uint16_t led_count);
+static int mock_write(void *ctx, const bsp_led_rgb_t *pixels, uint16_t count);
+static void mock_close(void *ctx);
+
+const bsp_led_backend_t BSP_LED_MOCK_BACKEND = {
+    .name = "mock",
+    .open = mock_open,
+    .write = mock_write,
+    .close = mock_close,
+};
+
+// ========== 核心接口实现 ==========
+
+void bsp_led_mock_init(bsp_led_mock_t *mock) {
+    if (mock != NULL) {
+        memset(mock, 0, sizeof(*mock));
+    }
+}
+
+// ========== 静态函数实现 ==========
+
+static int mock_open(void *ctx, uint16_t led_count) {
+    bsp_led_mock_t *mock = (bsp_led_mock_t *)ctx;
+    if (mock->fail_opens > 0) {
+        mock->fail_opens--;
+        return BSP_LED_MOCK_ERR_INJECTED;
+    }
+    mock->led_count = led_count > BSP_LED_MOCK_MAX_LEDS ? BSP_LED_MOCK_MAX_LEDS : led_count;
+    mock->is_open = true;
+    mock->opens++;
+    return 0;
+}
+
+static int mock_write(void *ctx, const bsp_led_rgb_t *pixels, uint16_t count) {
+    bsp_led_mock_t *mock = (bsp_led_mock_t *)ctx;
+    if (!mock->is_open) {
+        return BSP_LED_MOCK_ERR_INJECTED;
+    }
+    if (mock->fail_writes > 0) {
+        mock->fail_writes--;
+        return BSP_LED_MOCK_ERR_INJECTED;
+    }
+    if (count > mock->led_count) {
+        count = mock->led_count;
+    }
+    memcpy(mock->frame, pixels, sizeof(bsp_led_rgb_t) * count);
+    mock->writes++;
+    return 0;
+}
+
+static void mock_close(void *ctx) {
+    bsp_led_mock_t *mock = (bsp_led_mock_t *)ctx;
+    mock->is_open = false;
+    mock->closes++;
+}
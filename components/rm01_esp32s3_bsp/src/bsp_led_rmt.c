@@ -0,0 +1,92 @@
+/**
+ * @file bsp_led_rmt.c
+ * @brief LED设备RMT灯带后端实现
+ */
+
+#include "bsp_led_rmt.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "BSP_LED_RMT";
+
+#define RMT_RESOLUTION_HZ       (10 * 1000 * 1000)  // 10MHz
+
+// ========== 静态函数声明 ==========
+static int rmt_open(void *ctx, uint16_t led_count);
+static int rmt_write(void *ctx, const bsp_led_rgb_t *pixels, uint16_t count);
+static void rmt_close(void *ctx);
+
+const bsp_led_backend_t BSP_LED_RMT_BACKEND = {
+    .name = "rmt",
+    .open = rmt_open,
+    .write = rmt_write,
+    .close = rmt_close,
+};
+
+// ========== 静态函数实现 ==========
+
+static int rmt_open(void *ctx, uint16_t led_count) {
+    bsp_led_rmt_ctx_t *rmt = (bsp_led_rmt_ctx_t *)ctx;
+
+    led_strip_config_t strip_config = {
+        .strip_gpio_num = rmt->gpio_num,
+        .max_leds = led_count,
+        .led_model = LED_MODEL_WS2812,
+    };
+
+    led_strip_rmt_config_t rmt_config = {
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = RMT_RESOLUTION_HZ,
+        .flags.with_dma = rmt->with_dma,
+        .mem_block_symbols = rmt->mem_block_symbols,
+    };
+
+    esp_err_t ret = led_strip_new_rmt_device(&strip_config, &rmt_config, &rmt->handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "创建RMT灯带失败 (GPIO:%d): %s", rmt->gpio_num, esp_err_to_name(ret));
+        rmt->handle = NULL;
+        return ret;
+    }
+
+    if (rmt->settle_ms > 0) {
+        vTaskDelay(pdMS_TO_TICKS(rmt->settle_ms));
+    }
+
+    // 清除一次，同时验证通道可用
+    ret = led_strip_clear(rmt->handle);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "RMT灯带清除测试失败 (GPIO:%d): %s", rmt->gpio_num, esp_err_to_name(ret));
+        led_strip_del(rmt->handle);
+        rmt->handle = NULL;
+        return ret;
+    }
+    return ESP_OK;
+}
+
+static int rmt_write(void *ctx, const bsp_led_rgb_t *pixels, uint16_t count) {
+    bsp_led_rmt_ctx_t *rmt = (bsp_led_rmt_ctx_t *)ctx;
+    if (rmt->handle == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        esp_err_t ret = led_strip_set_pixel(rmt->handle, i, pixels[i].r, pixels[i].g, pixels[i].b);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return led_strip_refresh(rmt->handle);
+}
+
+static void rmt_close(void *ctx) {
+    bsp_led_rmt_ctx_t *rmt = (bsp_led_rmt_ctx_t *)ctx;
+    if (rmt->handle != NULL) {
+        esp_err_t ret = led_strip_del(rmt->handle);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "删除RMT灯带失败 (GPIO:%d): %s", rmt->gpio_num, esp_err_to_name(ret));
+        }
+        rmt->handle = NULL;
+    }
+}
@@ -0,0 +1,454 @@
+/**
+ * @file bsp_prometheus_client.c
+ * @brief Prometheus查询客户端（长连接池）实现
+ *
+ * 每个连接槽位持有一个esp_http_client句柄。esp_http_client_perform()在服务器
+ * 允许keep-alive时保留连接，下次set_url()到同一主机直接复用套接字；新建连接
+ * 通过HTTP_EVENT_ON_CONNECTED事件计数。响应正文在HTTP_EVENT_ON_DATA中直接转交
+ * 调用者的回调；写入缓冲区的查询接口也通过同一回调实现。
+ */
+
+#include "bsp_prometheus_client.h"
+#include "bsp_config.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_http_client.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+static const char *TAG = "BSP_PROM_CLIENT";
+
+#define DEFAULT_TIMEOUT_MS          5000    // 默认请求超时
+#define MAX_URL_LENGTH              1024    // 查询URL最大长度（可容纳合并后的批量查询）
+#define HTTP_RX_BUFFER_SIZE         1024
+#define HTTP_TX_BUFFER_SIZE         512
+#define TCP_KEEPALIVE_IDLE_S        5       // TCP keep-alive探测：空闲5秒后开始
+#define TCP_KEEPALIVE_INTERVAL_S    5       // 探测间隔
+#define TCP_KEEPALIVE_COUNT         3       // 连续失败次数
+
+// 连接槽位
+typedef struct {
+    esp_http_client_handle_t client;
+    bool in_use;
+    bool connected;                     // 由HTTP事件维护
+    bool new_connection;                // 本次请求期间新建了TCP连接
+    uint32_t last_used_ms;              // 最近一次请求完成时间
+    // 当前请求的正文回调
+    bsp_prometheus_client_data_cb_t on_data;
+    void *ctx;
+    uint32_t bytes_received;
+} pool_slot_t;
+
+// 写入缓冲区的正文接收方
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t len;
+    bool truncated;
+} buffer_sink_t;
+
+// 客户端状态
+typedef struct {
+    bool is_initialized;
+    bsp_prometheus_client_config_t config;
+    pool_slot_t *slots;
+    SemaphoreHandle_t mutex;            // 保护槽位分配和统计
+    SemaphoreHandle_t available;        // 空闲槽位计数
+    bsp_prometheus_client_stats_t stats;
+} bsp_prometheus_client_t;
+
+static bsp_prometheus_client_t s_client = {0};
+
+// ========== 静态函数声明 ==========
+static esp_err_t http_event_handler(esp_http_client_event_t *evt);
+static void buffer_sink_write(void *ctx, const char *data, size_t len);
+static esp_err_t build_query_url(const char *query, char *url, size_t url_size);
+static pool_slot_t* acquire_slot(uint32_t now_ms);
+static esp_err_t perform_on_slot(pool_slot_t *slot, const char *url, uint32_t timeout_ms);
+static uint32_t remaining_timeout_ms(int64_t deadline_us);
+static uint32_t get_time_ms(void);
+
+// ========== 核心接口实现 ==========
+
+esp_err_t bsp_prometheus_client_init(const bsp_prometheus_client_config_t *config) {
+    if (s_client.is_initialized) {
+        return ESP_OK;
+    }
+    if (config == NULL || config->base_url == NULL || config->max_connections == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    s_client.config = *config;
+    s_client.slots = calloc(config->max_connections, sizeof(pool_slot_t));
+    s_client.mutex = xSemaphoreCreateMutex();
+    s_client.available = xSemaphoreCreateCounting(config->max_connections, config->max_connections);
+    if (s_client.slots == NULL || s_client.mutex == NULL || s_client.available == NULL) {
+        ESP_LOGE(TAG, "创建连接池失败");
+        free(s_client.slots);
+        s_client.slots = NULL;
+        if (s_client.mutex) vSemaphoreDelete(s_client.mutex);
+        if (s_client.available) vSemaphoreDelete(s_client.available);
+        s_client.mutex = NULL;
+        s_client.available = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(&s_client.stats, 0, sizeof(s_client.stats));
+    s_client.is_initialized = true;
+    ESP_LOGI(TAG, "Prometheus客户端初始化完成: %s (连接池 %u, 空闲关闭 %" PRIu32 " ms)",
+             config->base_url, config->max_connections, config->idle_timeout_ms);
+    return ESP_OK;
+}
+
+void bsp_prometheus_client_deinit(void) {
+    if (!s_client.is_initialized) {
+        return;
+    }
+
+    xSemaphoreTake(s_client.mutex, portMAX_DELAY);
+    s_client.is_initialized = false;
+    for (uint8_t i = 0; i < s_client.config.max_connections; i++) {
+        if (s_client.slots[i].client != NULL) {
+            esp_http_client_cleanup(s_client.slots[i].client);
+        }
+    }
+    free(s_client.slots);
+    s_client.slots = NULL;
+    xSemaphoreGive(s_client.mutex);
+
+    vSemaphoreDelete(s_client.available);
+    vSemaphoreDelete(s_client.mutex);
+    s_client.available = NULL;
+    s_client.mutex = NULL;
+    ESP_LOGI(TAG, "Prometheus客户端已关闭");
+}
+
+esp_err_t bsp_prometheus_client_query(const char *query, char *response, size_t response_size) {
+    if (query == NULL || response == NULL || response_size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    buffer_sink_t sink = {
+        .buf = response,
+        .size = response_size,
+    };
+    response[0] = '\0';
+    esp_err_t err = bsp_prometheus_client_query_stream(query, buffer_sink_write, &sink);
+
+    if (sink.truncated && s_client.is_initialized) {
+        xSemaphoreTake(s_client.mutex, portMAX_DELAY);
+        s_client.stats.truncated++;
+        xSemaphoreGive(s_client.mutex);
+    }
+    return err;
+}
+
+esp_err_t bsp_prometheus_client_query_stream(const char *query, bsp_prometheus_client_data_cb_t on_data, void *ctx) {
+    return bsp_prometheus_client_query_stream_until(query, 0, on_data, ctx);
+}
+
+esp_err_t bsp_prometheus_client_query_stream_until(const char *query, int64_t deadline_us,
+                                                   bsp_prometheus_client_data_cb_t on_data, void *ctx) {
+    if (query == NULL || on_data == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_client.is_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    char url[MAX_URL_LENGTH];
+    esp_err_t err = build_query_url(query, url, sizeof(url));
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "查询URL太长");
+        return err;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    uint32_t timeout_ms = remaining_timeout_ms(deadline_us);
+    if (timeout_ms == 0 || xSemaphoreTake(s_client.available, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        ESP_LOGW(TAG, "等待空闲连接超时");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    pool_slot_t *slot = acquire_slot((uint32_t)(start_us / 1000));
+    slot->on_data = on_data;
+    slot->ctx = ctx;
+    slot->bytes_received = 0;
+
+    bool reused = slot->connected;
+    slot->new_connection = false;
+    err = perform_on_slot(slot, url, remaining_timeout_ms(deadline_us));
+    bool stale_retry = false;
+    if (err != ESP_OK && reused && err != ESP_ERR_INVALID_RESPONSE && remaining_timeout_ms(deadline_us) > 0) {
+        // 复用的连接可能已被服务器关闭：重新建立连接后重试一次
+        ESP_LOGD(TAG, "复用连接失败 (%s)，重新连接", esp_err_to_name(err));
+        esp_http_client_close(slot->client);
+        slot->connected = false;
+        stale_retry = true;
+        err = perform_on_slot(slot, url, remaining_timeout_ms(deadline_us));
+    }
+    if (err != ESP_OK && err != ESP_ERR_INVALID_RESPONSE && slot->client != NULL) {
+        // 传输失败后连接状态未知，下次重新连接（非200响应已完整读取，连接仍可复用）
+        esp_http_client_close(slot->client);
+        slot->connected = false;
+    }
+
+    int64_t end_us = esp_timer_get_time();
+    uint32_t latency_us = (uint32_t)(end_us - start_us);
+    bool deadline_missed = (err != ESP_OK && deadline_us != 0 && end_us >= deadline_us);
+    if (deadline_missed) {
+        err = ESP_ERR_TIMEOUT;
+    }
+
+    xSemaphoreTake(s_client.mutex, portMAX_DELAY);
+    s_client.stats.queries++;
+    if (slot->new_connection) {
+        s_client.stats.handshakes++;
+    } else if (err == ESP_OK) {
+        s_client.stats.reused++;
+    }
+    if (stale_retry) {
+        s_client.stats.stale_retries++;
+    }
+    if (err != ESP_OK) {
+        s_client.stats.failures++;
+    }
+    if (deadline_missed) {
+        s_client.stats.deadline_misses++;
+    }
+    s_client.stats.bytes_received += slot->bytes_received;
+    s_client.stats.last_latency_us = latency_us;
+    s_client.stats.total_latency_us += latency_us;
+    if (latency_us > s_client.stats.max_latency_us) {
+        s_client.stats.max_latency_us = latency_us;
+    }
+    slot->on_data = NULL;
+    slot->ctx = NULL;
+    slot->last_used_ms = get_time_ms();
+    slot->in_use = false;
+    xSemaphoreGive(s_client.mutex);
+    xSemaphoreGive(s_client.available);
+
+    return err;
+}
+
+// ========== 统计接口实现 ==========
+
+esp_err_t bsp_prometheus_client_get_stats(bsp_prometheus_client_stats_t *stats) {
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_client.is_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(s_client.mutex, portMAX_DELAY);
+    *stats = s_client.stats;
+    stats->open_connections = 0;
+    for (uint8_t i = 0; i < s_client.config.max_connections; i++) {
+        if (s_client.slots[i].connected) {
+            stats->open_connections++;
+        }
+    }
+    xSemaphoreGive(s_client.mutex);
+    return ESP_OK;
+}
+
+void bsp_prometheus_client_print_stats(void) {
+    bsp_prometheus_client_stats_t stats;
+    if (bsp_prometheus_client_get_stats(&stats) != ESP_OK) {
+        ESP_LOGW(TAG, "Prometheus客户端未初始化");
+        return;
+    }
+
+    uint32_t avg_us = stats.queries > 0 ? (uint32_t)(stats.total_latency_us / stats.queries) : 0;
+    ESP_LOGI(TAG, "========== Prometheus客户端统计 ==========");
+    ESP_LOGI(TAG, "查询: %" PRIu32 ", 失败: %" PRIu32 ", 超过截止时间: %" PRIu32 ", 截断: %" PRIu32 ", 接收正文: %" PRIu32 " 字节",
+             stats.queries, stats.failures, stats.deadline_misses, stats.truncated, stats.bytes_received);
+    ESP_LOGI(TAG, "TCP握手: %" PRIu32 ", 复用连接: %" PRIu32 ", 失效重连: %" PRIu32 ", 空闲关闭: %" PRIu32 ", 当前连接: %u/%u",
+             stats.handshakes, stats.reused, stats.stale_retries, stats.idle_closes,
+             stats.open_connections, s_client.config.max_connections);
+    ESP_LOGI(TAG, "查询耗时: 平均 %" PRIu32 " us, 最近 %" PRIu32 " us, 最大 %" PRIu32 " us",
+             avg_us, stats.last_latency_us, stats.max_latency_us);
+    ESP_LOGI(TAG, "==========================================");
+}
+
+// ========== 配置接口实现 ==========
+
+bsp_prometheus_client_config_t bsp_prometheus_client_get_default_config(void) {
+    bsp_prometheus_client_config_t config = {
+        .base_url = NULL,
+        .max_connections = CONFIG_BSP_PROMETHEUS_POOL_SIZE,
+        .timeout_ms = DEFAULT_TIMEOUT_MS,
+        .idle_timeout_ms = CONFIG_BSP_PROMETHEUS_IDLE_TIMEOUT_MS,
+    };
+    return config;
+}
+
+// ========== 静态函数实现 ==========
+
+static esp_err_t http_event_handler(esp_http_client_event_t *evt) {
+    pool_slot_t *slot = (pool_slot_t *)evt->user_data;
+    if (slot == NULL) {
+        return ESP_OK;
+    }
+
+    switch (evt->event_id) {
+        case HTTP_EVENT_ON_CONNECTED:
+            slot->connected = true;
+            slot->new_connection = true;
+            break;
+        case HTTP_EVENT_DISCONNECTED:
+            slot->connected = false;
+            break;
+        case HTTP_EVENT_ON_DATA:
+            if (slot->on_data != NULL && evt->data_len > 0) {
+                slot->on_data(slot->ctx, (const char *)evt->data, (size_t)evt->data_len);
+                slot->bytes_received += (uint32_t)evt->data_len;
+            }
+            break;
+        default:
+            break;
+    }
+    return ESP_OK;
+}
+
+static void buffer_sink_write(void *ctx, const char *data, size_t len) {
+    buffer_sink_t *sink = (buffer_sink_t *)ctx;
+    if (data == NULL) {
+        sink->len = 0;
+        sink->truncated = false;
+        sink->buf[0] = '\0';
+        return;
+    }
+
+    size_t space = sink->size - 1 - sink->len;
+    if (len > space) {
+        len = space;
+        sink->truncated = true;
+    }
+    memcpy(sink->buf + sink->len, data, len);
+    sink->len += len;
+    sink->buf[sink->len] = '\0';
+}
+
+// base_url?query=...，空格替换为%20
+static esp_err_t build_query_url(const char *query, char *url, size_t url_size) {
+    int len = snprintf(url, url_size, "%s?query=", s_client.config.base_url);
+    if (len < 0 || (size_t)len >= url_size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t pos = (size_t)len;
+    for (const char *p = query; *p != '\0'; p++) {
+        size_t need = (*p == ' ') ? 3 : 1;
+        if (pos + need >= url_size) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (*p == ' ') {
+            memcpy(&url[pos], "%20", 3);
+        } else {
+            url[pos] = *p;
+        }
+        pos += need;
+    }
+    url[pos] = '\0';
+    return ESP_OK;
+}
+
+// 关闭空闲过久的连接，优先分配仍保持连接的槽位（调用前已占用一个空闲计数）
+static pool_slot_t* acquire_slot(uint32_t now_ms) {
+    xSemaphoreTake(s_client.mutex, portMAX_DELAY);
+
+    pool_slot_t *chosen = NULL;
+    for (uint8_t i = 0; i < s_client.config.max_connections; i++) {
+        pool_slot_t *slot = &s_client.slots[i];
+        if (slot->in_use) {
+            continue;
+        }
+        if (slot->connected && s_client.config.idle_timeout_ms > 0 &&
+            now_ms - slot->last_used_ms > s_client.config.idle_timeout_ms) {
+            esp_http_client_close(slot->client);
+            slot->connected = false;
+            s_client.stats.idle_closes++;
+        }
+        if (chosen == NULL || (slot->connected && !chosen->connected)) {
+            chosen = slot;
+        }
+    }
+    chosen->in_use = true;
+
+    xSemaphoreGive(s_client.mutex);
+    return chosen;
+}
+
+static esp_err_t perform_on_slot(pool_slot_t *slot, const char *url, uint32_t timeout_ms) {
+    if (timeout_ms == 0) {
+        return ESP_ERR_TIMEOUT;
+    }
+    if (slot->client == NULL) {
+        esp_http_client_config_t config = {
+            .url = url,
+            .timeout_ms = (int)timeout_ms,
+            .buffer_size = HTTP_RX_BUFFER_SIZE,
+            .buffer_size_tx = HTTP_TX_BUFFER_SIZE,
+            .disable_auto_redirect = true,
+            .max_redirection_count = 0,
+            .event_handler = http_event_handler,
+            .user_data = slot,
+            // TCP keep-alive探测，及时发现已失效的长连接
+            .keep_alive_enable = true,
+            .keep_alive_idle = TCP_KEEPALIVE_IDLE_S,
+            .keep_alive_interval = TCP_KEEPALIVE_INTERVAL_S,
+            .keep_alive_count = TCP_KEEPALIVE_COUNT,
+        };
+        slot->client = esp_http_client_init(&config);
+        if (slot->client == NULL) {
+            ESP_LOGE(TAG, "创建HTTP客户端失败");
+            return ESP_FAIL;
+        }
+        esp_http_client_set_header(slot->client, "Accept", "application/json");
+    } else {
+        esp_err_t err = esp_http_client_set_url(slot->client, url);
+        if (err != ESP_OK) {
+            return err;
+        }
+        esp_http_client_set_timeout_ms(slot->client, (int)timeout_ms);
+    }
+
+    // 通知接收方丢弃上一次尝试收到的内容
+    slot->on_data(slot->ctx, NULL, 0);
+
+    esp_err_t err = esp_http_client_perform(slot->client);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    int status_code = esp_http_client_get_status_code(slot->client);
+    if (status_code != 200) {
+        ESP_LOGE(TAG, "HTTP请求失败，状态码: %d, URL: %s", status_code, url);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    return ESP_OK;
+}
+
+// 本次请求可用的超时：不超过配置的请求超时和截止时间的剩余部分，截止时间已过返回0
+static uint32_t remaining_timeout_ms(int64_t deadline_us) {
+    if (deadline_us == 0) {
+        return s_client.config.timeout_ms;
+    }
+    int64_t remaining_us = deadline_us - esp_timer_get_time();
+    if (remaining_us <= 0) {
+        return 0;
+    }
+    uint32_t remaining_ms = (uint32_t)((remaining_us + 999) / 1000);
+    return remaining_ms < s_client.config.timeout_ms ? remaining_ms : s_client.config.timeout_ms;
+}
+
+static uint32_t get_time_ms(void) {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
@@ -0,0 +1,545 @@
+/**
+ * @file bsp_prometheus_scanner.c
+ * @brief Prometheus查询响应流式扫描器实现
+ *
+ * 逐字符的JSON状态机。每层容器记录一个角色（根对象、data、result数组、序列、
+ * metric、value数组或其他），打开新容器时由父容器角色和当前字段名决定子容器
+ * 角色；字符串值按同样的方式决定写入哪个提取字段。状态全部保存在扫描器实例中，
+ * 因此输入可以在任意位置分块。
+ */
+
+#include "bsp_prometheus_scanner.h"
+#include <string.h>
+
+// 词法状态
+enum {
+    STATE_VALUE = 0,            // 等待一个值
+    STATE_ARRAY_FIRST,          // '['之后：值或']'
+    STATE_OBJECT_FIRST,         // '{'之后：字段名或'}'
+    STATE_KEY,                  // ','之后：字段名
+    STATE_COLON,                // 字段名之后：':'
+    STATE_AFTER_VALUE,          // 值之后：','或容器结束
+    STATE_STRING,               // 字符串中
+    STATE_KEY_STRING,           // 字段名字符串中
+    STATE_LITERAL,              // 数字或true/false/null中
+    STATE_DONE,                 // 文档已结束，只允许空白
+    STATE_ERROR,
+};
+
+// 容器角色（最高位表示数组）
+enum {
+    ROLE_OTHER = 0,
+    ROLE_ROOT,
+    ROLE_DATA,
+    ROLE_RESULT,
+    ROLE_SERIES,
+    ROLE_METRIC,
+    ROLE_VALUE,
+};
+#define ROLE_ARRAY_FLAG         0x80
+#define ROLE_MASK               0x7F
+
+// 字符串的提取目标
+enum {
+    CAPTURE_NONE = 0,
+    CAPTURE_KEY,
+    CAPTURE_STATUS,
+    CAPTURE_RESULT_TYPE,
+    CAPTURE_ERROR,
+    CAPTURE_LABEL,
+    CAPTURE_VALUE,
+};
+
+// 字面量种类
+enum {
+    LITERAL_NUMBER = 0,
+    LITERAL_TRUE,
+    LITERAL_FALSE,
+    LITERAL_NULL,
+};
+static const char *const LITERAL_WORDS[] = {NULL, "true", "false", "null"};
+
+#define ESCAPE_NONE             0
+#define ESCAPE_PENDING          1       // '\'之后
+#define ESCAPE_UNICODE_DONE     6       // \uXXXX：2..5依次为第1..4位十六进制数
+
+// ========== 静态函数声明 ==========
+static bool process_char(bsp_prom_scanner_t *scanner, char c);
+static void fail(bsp_prom_scanner_t *scanner, bsp_prom_scan_result_t result);
+static bool begin_value(bsp_prom_scanner_t *scanner, char c);
+static void open_container(bsp_prom_scanner_t *scanner, bool is_array);
+static void close_container(bsp_prom_scanner_t *scanner);
+static void end_value(bsp_prom_scanner_t *scanner);
+static void begin_string(bsp_prom_scanner_t *scanner, bool is_key);
+static void string_char(bsp_prom_scanner_t *scanner, char c);
+static void end_string(bsp_prom_scanner_t *scanner);
+static bool literal_char(bsp_prom_scanner_t *scanner, char c);
+static bool literal_complete(const bsp_prom_scanner_t *scanner);
+static void capture_char(bsp_prom_scanner_t *scanner, char c);
+static uint8_t parent_role(const bsp_prom_scanner_t *scanner);
+static bool key_is(const bsp_prom_scanner_t *scanner, const char *name);
+static bool is_space(char c);
+static bool is_hex(char c);
+
+// ========== 核心接口实现 ==========
+
+void bsp_prom_scanner_init(bsp_prom_scanner_t *scanner, const char *label_name,
+                           bsp_prom_scanner_series_cb_t on_series, void *ctx) {
+    if (scanner == NULL) {
+        return;
+    }
+    memset(scanner, 0, sizeof(*scanner));
+    scanner->label_name = label_name;
+    scanner->on_series = on_series;
+    scanner->ctx = ctx;
+    bsp_prom_scanner_reset(scanner);
+}
+
+void bsp_prom_scanner_reset(bsp_prom_scanner_t *scanner) {
+    if (scanner == NULL) {
+        return;
+    }
+    const char *label_name = scanner->label_name;
+    bsp_prom_scanner_series_cb_t on_series = scanner->on_series;
+    void *ctx = scanner->ctx;
+
+    memset(scanner, 0, sizeof(*scanner));
+    scanner->label_name = label_name;
+    scanner->on_series = on_series;
+    scanner->ctx = ctx;
+    scanner->state = STATE_VALUE;
+    scanner->result = BSP_PROM_SCAN_IN_PROGRESS;
+}
+
+bsp_prom_scan_result_t bsp_prom_scanner_feed(bsp_prom_scanner_t *scanner, const char *data, size_t len) {
+    if (scanner == NULL) {
+        return BSP_PROM_SCAN_ERR_SYNTAX;
+    }
+    if (data == NULL) {
+        len = 0;
+    }
+
+    for (size_t i = 0; i < len && scanner->state != STATE_ERROR; ) {
+        // 字面量在分隔符处结束，分隔符需要在新状态下重新处理
+        if (process_char(scanner, data[i])) {
+            i++;
+        }
+    }
+    scanner->bytes += (uint32_t)len;
+    return scanner->result;
+}
+
+bsp_prom_scan_result_t bsp_prom_scanner_finish(bsp_prom_scanner_t *scanner) {
+    if (scanner == NULL) {
+        return BSP_PROM_SCAN_ERR_SYNTAX;
+    }
+    // 顶层是数字等字面量时，文档在正文结束处结束
+    if (scanner->state == STATE_LITERAL && scanner->depth == 0 && literal_complete(scanner)) {
+        end_value(scanner);
+    }
+    if (scanner->result == BSP_PROM_SCAN_IN_PROGRESS) {
+        fail(scanner, BSP_PROM_SCAN_ERR_TRUNCATED);
+    }
+    return scanner->result;
+}
+
+bool bsp_prom_scanner_is_success(const bsp_prom_scanner_t *scanner) {
+    return scanner != NULL && !scanner->status_overflow && strcmp(scanner->status, "success") == 0;
+}
+
+const char *bsp_prom_scanner_result_name(bsp_prom_scan_result_t result) {
+    switch (result) {
+        case BSP_PROM_SCAN_OK:              return "完成";
+        case BSP_PROM_SCAN_IN_PROGRESS:     return "未结束";
+        case BSP_PROM_SCAN_ERR_TRUNCATED:   return "正文不完整";
+        case BSP_PROM_SCAN_ERR_SYNTAX:      return "语法错误";
+        case BSP_PROM_SCAN_ERR_DEPTH:       return "嵌套过深";
+        default:                            return "未知";
+    }
+}
+
+// ========== 静态函数实现 ==========
+
+// 返回false表示字符未被消耗，需要在新状态下重新处理
+static bool process_char(bsp_prom_scanner_t *scanner, char c) {
+    switch (scanner->state) {
+        case STATE_STRING:
+        case STATE_KEY_STRING:
+            string_char(scanner, c);
+            return true;
+
+        case STATE_LITERAL:
+            if (literal_char(scanner, c)) {
+                return true;
+            }
+            if (!is_space(c) && c != ',' && c != ']' && c != '}') {
+                fail(scanner, BSP_PROM_SCAN_ERR_SYNTAX);
+                return true;
+            }
+            if (!literal_complete(scanner)) {
+                fail(scanner, BSP_PROM_SCAN_ERR_SYNTAX);
+                return true;
+            }
+            end_value(scanner);
+            return false;
+
+        default:
+            break;
+    }
+
+    if (is_space(c)) {
+        return true;
+    }
+
+    switch (scanner->state) {
+        case STATE_ARRAY_FIRST:
+            if (c == ']') {
+                close_container(scanner);
+                return true;
+            }
+            // fall through
+        case STATE_VALUE:
+            if (!begin_value(scanner, c)) {
+                fail(scanner, BSP_PROM_SCAN_ERR_SYNTAX);
+            }
+            return true;
+
+        case STATE_OBJECT_FIRST:
+            if (c == '}') {
+                close_container(scanner);
+                return true;
+            }
+            // fall through
+        case STATE_KEY:
+            if (c == '"') {
+                begin_string(scanner, true);
+            } else {
+                fail(scanner, BSP_PROM_SCAN_ERR_SYNTAX);
+            }
+            return true;
+
+        case STATE_COLON:
+            if (c == ':') {
+                scanner->state = STATE_VALUE;
+            } else {
+                fail(scanner, BSP_PROM_SCAN_ERR_SYNTAX);
+            }
+            return true;
+
+        case STATE_AFTER_VALUE: {
+            bool in_array = (scanner->roles[scanner->depth - 1] & ROLE_ARRAY_FLAG) != 0;
+            if (c == ',') {
+                if (in_array) {
+                    if ((scanner->roles[scanner->depth - 1] & ROLE_MASK) == ROLE_VALUE &&
+                        scanner->value_index < UINT8_MAX) {
+                        scanner->value_index++;
+                    }
+                    scanner->state = STATE_VALUE;
+                } else {
+                    scanner->state = STATE_KEY;
+                }
+            } else if (c == ']' && in_array) {
+                close_container(scanner);
+            } else if (c == '}' && !in_array) {
+                close_container(scanner);
+            } else {
+                fail(scanner, BSP_PROM_SCAN_ERR_SYNTAX);
+            }
+            return true;
+        }
+
+        default:
+            // 文档结束后出现非空白字符
+            fail(scanner, BSP_PROM_SCAN_ERR_SYNTAX);
+            return true;
+    }
+}
+
+static void fail(bsp_prom_scanner_t *scanner, bsp_prom_scan_result_t result) {
+    scanner->state = STATE_ERROR;
+    scanner->result = result;
+}
+
+static bool begin_value(bsp_prom_scanner_t *scanner, char c) {
+    if (c == '{' || c == '[') {
+        open_container(scanner, c == '[');
+        return true;
+    }
+    if (c == '"') {
+        begin_string(scanner, false);
+        return true;
+    }
+
+    scanner->literal_len = 0;
+    switch (c) {
+        case 't': scanner->literal_word = LITERAL_TRUE;  break;
+        case 'f': scanner->literal_word = LITERAL_FALSE; break;
+        case 'n': scanner->literal_word = LITERAL_NULL;  break;
+        default:  scanner->literal_word = LITERAL_NUMBER; break;
+    }
+    scanner->state = STATE_LITERAL;
+    return literal_char(scanner, c);
+}
+
+static void open_container(bsp_prom_scanner_t *scanner, bool is_array) {
+    if (scanner->depth >= BSP_PROM_SCANNER_MAX_DEPTH) {
+        fail(scanner, BSP_PROM_SCAN_ERR_DEPTH);
+        return;
+    }
+
+    uint8_t parent = parent_role(scanner);
+    uint8_t role = ROLE_OTHER;
+    if (scanner->depth == 0) {
+        role = is_array ? ROLE_OTHER : ROLE_ROOT;
+    } else if (parent == ROLE_ROOT && !is_array && key_is(scanner, "data")) {
+        role = ROLE_DATA;
+    } else if (parent == ROLE_DATA && is_array && key_is(scanner, "result")) {
+        role = ROLE_RESULT;
+    } else if (parent == ROLE_RESULT && !is_array) {
+        role = ROLE_SERIES;
+        scanner->label_found = false;
+        scanner->value_found = false;
+        scanner->label_len = 0;
+        scanner->value_len = 0;
+    } else if (parent == ROLE_SERIES && !is_array && key_is(scanner, "metric")) {
+        role = ROLE_METRIC;
+    } else if (parent == ROLE_SERIES && is_array && key_is(scanner, "value")) {
+        role = ROLE_VALUE;
+        scanner->value_index = 0;
+    }
+
+    scanner->roles[scanner->depth++] = role | (is_array ? ROLE_ARRAY_FLAG : 0);
+    scanner->state = is_array ? STATE_ARRAY_FIRST : STATE_OBJECT_FIRST;
+}
+
+static void close_container(bsp_prom_scanner_t *scanner) {
+    uint8_t role = scanner->roles[--scanner->depth];
+
+    if ((role & ROLE_MASK) == ROLE_SERIES) {
+        scanner->series++;
+        if (scanner->on_series != NULL) {
+            scanner->on_series(scanner->ctx,
+                               scanner->label_found ? scanner->label : NULL,
+                               scanner->label_found ? scanner->label_len : 0,
+                               scanner->value,
+                               scanner->value_found ? scanner->value_len : 0);
+        }
+    }
+    end_value(scanner);
+}
+
+static void end_value(bsp_prom_scanner_t *scanner) {
+    if (scanner->depth == 0) {
+        scanner->state = STATE_DONE;
+        scanner->result = BSP_PROM_SCAN_OK;
+    } else {
+        scanner->state = STATE_AFTER_VALUE;
+    }
+}
+
+static void begin_string(bsp_prom_scanner_t *scanner, bool is_key) {
+    scanner->escape = ESCAPE_NONE;
+    if (is_key) {
+        scanner->state = STATE_KEY_STRING;
+        scanner->capture = CAPTURE_KEY;
+        scanner->key_len = 0;
+        scanner->key_overflow = false;
+        scanner->key[0] = '\0';
+        return;
+    }
+
+    scanner->state = STATE_STRING;
+    scanner->capture = CAPTURE_NONE;
+    switch (parent_role(scanner)) {
+        case ROLE_ROOT:
+            if (key_is(scanner, "status")) {
+                scanner->capture = CAPTURE_STATUS;
+                scanner->status_len = 0;
+                scanner->status_overflow = false;
+                scanner->status[0] = '\0';
+            } else if (key_is(scanner, "error")) {
+                scanner->capture = CAPTURE_ERROR;
+                scanner->error_len = 0;
+                scanner->error[0] = '\0';
+            }
+            break;
+        case ROLE_DATA:
+            if (key_is(scanner, "resultType")) {
+                scanner->capture = CAPTURE_RESULT_TYPE;
+                scanner->result_type_len = 0;
+                scanner->result_type_overflow = false;
+                scanner->result_type[0] = '\0';
+            }
+            break;
+        case ROLE_METRIC:
+            if (scanner->label_name != NULL && key_is(scanner, scanner->label_name)) {
+                scanner->capture = CAPTURE_LABEL;
+                scanner->label_len = 0;
+                scanner->label_found = true;    // 超长时在capture_char中清除
+                scanner->label[0] = '\0';
+            }
+            break;
+        case ROLE_VALUE:
+            if (scanner->value_index == 1) {
+                scanner->capture = CAPTURE_VALUE;
+                scanner->value_len = 0;
+                scanner->value_found = true;
+                scanner->value[0] = '\0';
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void string_char(bsp_prom_scanner_t *scanner, char c) {
+    uint8_t escape = scanner->escape;
+
+    if (escape == ESCAPE_PENDING) {
+        char decoded;
+        switch (c) {
+            case '"':  decoded = '"';  break;
+            case '\\': decoded = '\\'; break;
+            case '/':  decoded = '/';  break;
+            case 'b':  decoded = '\b'; break;
+            case 'f':  decoded = '\f'; break;
+            case 'n':  decoded = '\n'; break;
+            case 'r':  decoded = '\r'; break;
+            case 't':  decoded = '\t'; break;
+            case 'u':
+                scanner->escape = ESCAPE_PENDING + 1;
+                return;
+            default:
+                fail(scanner, BSP_PROM_SCAN_ERR_SYNTAX);
+                return;
+        }
+        scanner->escape = ESCAPE_NONE;
+        capture_char(scanner, decoded);
+        return;
+    }
+
+    if (escape > ESCAPE_PENDING) {
+        // \uXXXX：只关心ASCII的提取字段，统一记为'?'
+        if (!is_hex(c)) {
+            fail(scanner, BSP_PROM_SCAN_ERR_SYNTAX);
+            return;
+        }
+        scanner->escape = escape + 1;
+        if (scanner->escape == ESCAPE_UNICODE_DONE) {
+            scanner->escape = ESCAPE_NONE;
+            capture_char(scanner, '?');
+        }
+        return;
+    }
+
+    if (c == '\\') {
+        scanner->escape = ESCAPE_PENDING;
+    } else if (c == '"') {
+        end_string(scanner);
+    } else if ((unsigned char)c < 0x20) {
+        fail(scanner, BSP_PROM_SCAN_ERR_SYNTAX);
+    } else {
+        capture_char(scanner, c);
+    }
+}
+
+static void end_string(bsp_prom_scanner_t *scanner) {
+    bool is_key = scanner->state == STATE_KEY_STRING;
+    scanner->capture = CAPTURE_NONE;
+    if (is_key) {
+        scanner->state = STATE_COLON;
+    } else {
+        end_value(scanner);
+    }
+}
+
+static bool literal_char(bsp_prom_scanner_t *scanner, char c) {
+    if (scanner->literal_word == LITERAL_NUMBER) {
+        // 数字只检查字符集
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+            if (scanner->literal_len < UINT8_MAX) {
+                scanner->literal_len++;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    const char *word = LITERAL_WORDS[scanner->literal_word];
+    if (scanner->literal_len < strlen(word) && word[scanner->literal_len] == c) {
+        scanner->literal_len++;
+        return true;
+    }
+    return false;
+}
+
+static bool literal_complete(const bsp_prom_scanner_t *scanner) {
+    if (scanner->literal_word == LITERAL_NUMBER) {
+        return scanner->literal_len > 0;
+    }
+    return scanner->literal_len == strlen(LITERAL_WORDS[scanner->literal_word]);
+}
+
+static void capture_char(bsp_prom_scanner_t *scanner, char c) {
+    char *buf;
+    uint8_t *len;
+    size_t size;
+
+    switch (scanner->capture) {
+        case CAPTURE_KEY:
+            buf = scanner->key; len = &scanner->key_len; size = sizeof(scanner->key);
+            break;
+        case CAPTURE_STATUS:
+            buf = scanner->status; len = &scanner->status_len; size = sizeof(scanner->status);
+            break;
+        case CAPTURE_RESULT_TYPE:
+            buf = scanner->result_type; len = &scanner->result_type_len; size = sizeof(scanner->result_type);
+            break;
+        case CAPTURE_ERROR:
+            buf = scanner->error; len = &scanner->error_len; size = sizeof(scanner->error);
+            break;
+        case CAPTURE_LABEL:
+            buf = scanner->label; len = &scanner->label_len; size = sizeof(scanner->label);
+            break;
+        case CAPTURE_VALUE:
+            buf = scanner->value; len = &scanner->value_len; size = sizeof(scanner->value);
+            break;
+        default:
+            return;
+    }
+
+    if ((size_t)*len + 1 >= size) {
+        // 超长：error截断，其他字段标记为无效
+        switch (scanner->capture) {
+            case CAPTURE_KEY:           scanner->key_overflow = true;           break;
+            case CAPTURE_STATUS:        scanner->status_overflow = true;        break;
+            case CAPTURE_RESULT_TYPE:   scanner->result_type_overflow = true;   break;
+            case CAPTURE_LABEL:         scanner->label_found = false;           break;
+            case CAPTURE_VALUE:         scanner->value_found = false;           break;
+            default:                                                            break;
+        }
+        return;
+    }
+    buf[(*len)++] = c;
+    buf[*len] = '\0';
+}
+
+static uint8_t parent_role(const bsp_prom_scanner_t *scanner) {
+    if (scanner->depth == 0) {
+        return ROLE_OTHER;
+    }
+    return scanner->roles[scanner->depth - 1] & ROLE_MASK;
+}
+
+// 最近一个字段名（超长的字段名不匹配任何名称）
+static bool key_is(const bsp_prom_scanner_t *scanner, const char *name) {
+    return !scanner->key_overflow && strcmp(scanner->key, name) == 0;
+}
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool is_hex(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
@@ -0,0 +1,150 @@
+/**
+ * @file bsp_promql_batch.c
+ * @brief PromQL批量查询实现
+ *
+ * label_replace()的源标签和正则都为空：空正则匹配不存在的源标签（空字符串），
+ * 因此每个序列都会被加上目标标签，查询本身的标签和数值保持不变。
+ */
+
+#include "bsp_promql_batch.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#define JOIN_SEPARATOR          " or "
+#define MAX_VALUE_LENGTH        32      // 样本数值字符串最大长度
+
+// ========== 静态函数声明 ==========
+static bool append(char *out, size_t out_size, size_t *pos, const char *text);
+static int parse_index(const char *tag, size_t tag_len);
+static bool parse_value(const char *value, size_t value_len, float *result);
+
+// ========== 核心接口实现 ==========
+
+void bsp_promql_batch_init(bsp_promql_batch_t *batch) {
+    if (batch == NULL) {
+        return;
+    }
+    memset(batch, 0, sizeof(*batch));
+}
+
+int bsp_promql_batch_add(bsp_promql_batch_t *batch, const char *query) {
+    if (batch == NULL || query == NULL || query[0] == '\0' ||
+        batch->count >= BSP_PROMQL_BATCH_MAX_QUERIES) {
+        return -1;
+    }
+    batch->queries[batch->count] = query;
+    batch->valid[batch->count] = false;
+    return batch->count++;
+}
+
+int bsp_promql_batch_build(const bsp_promql_batch_t *batch, char *out, size_t out_size) {
+    if (batch == NULL || out == NULL || out_size == 0 || batch->count == 0) {
+        return -1;
+    }
+
+    size_t pos = 0;
+    out[0] = '\0';
+    for (uint8_t i = 0; i < batch->count; i++) {
+        char index[4];
+        snprintf(index, sizeof(index), "%u", (unsigned)i);
+        if ((i > 0 && !append(out, out_size, &pos, JOIN_SEPARATOR)) ||
+            !append(out, out_size, &pos, "label_replace(") ||
+            !append(out, out_size, &pos, batch->queries[i]) ||
+            !append(out, out_size, &pos, ",\"" BSP_PROMQL_BATCH_LABEL "\",\"") ||
+            !append(out, out_size, &pos, index) ||
+            !append(out, out_size, &pos, "\",\"\",\"\")")) {
+            out[0] = '\0';
+            return -1;
+        }
+    }
+    return (int)pos;
+}
+
+void bsp_promql_batch_clear_results(bsp_promql_batch_t *batch) {
+    if (batch == NULL) {
+        return;
+    }
+    memset(batch->values, 0, sizeof(batch->values));
+    memset(batch->valid, 0, sizeof(batch->valid));
+    batch->received = 0;
+    batch->series = 0;
+    batch->ignored = 0;
+}
+
+bool bsp_promql_batch_feed(bsp_promql_batch_t *batch, const char *tag, size_t tag_len,
+                           const char *value, size_t value_len) {
+    if (batch == NULL) {
+        return false;
+    }
+    batch->series++;
+
+    float parsed;
+    int index = parse_index(tag, tag_len);
+    if (index < 0 || index >= batch->count || batch->valid[index] ||
+        !parse_value(value, value_len, &parsed)) {
+        batch->ignored++;
+        return false;
+    }
+
+    batch->values[index] = parsed;
+    batch->valid[index] = true;
+    batch->received++;
+    return true;
+}
+
+bool bsp_promql_batch_get(const bsp_promql_batch_t *batch, int index, float *value) {
+    if (batch == NULL || index < 0 || index >= batch->count || !batch->valid[index]) {
+        return false;
+    }
+    if (value != NULL) {
+        *value = batch->values[index];
+    }
+    return true;
+}
+
+// ========== 静态函数实现 ==========
+
+static bool append(char *out, size_t out_size, size_t *pos, const char *text) {
+    size_t len = strlen(text);
+    if (*pos + len >= out_size) {
+        return false;
+    }
+    memcpy(&out[*pos], text, len + 1);
+    *pos += len;
+    return true;
+}
+
+// 标签值必须是纯十进制序号（最多3位）
+static int parse_index(const char *tag, size_t tag_len) {
+    if (tag == NULL || tag_len == 0 || tag_len > 3) {
+        return -1;
+    }
+    int index = 0;
+    for (size_t i = 0; i < tag_len; i++) {
+        if (tag[i] < '0' || tag[i] > '9') {
+            return -1;
+        }
+        index = index * 10 + (tag[i] - '0');
+    }
+    return index;
+}
+
+// 整个字符串都必须是数值，且为有限数
+static bool parse_value(const char *value, size_t value_len, float *result) {
+    if (value == NULL || value_len == 0 || value_len >= MAX_VALUE_LENGTH) {
+        return false;
+    }
+    char text[MAX_VALUE_LENGTH];
+    memcpy(text, value, value_len);
+    text[value_len] = '\0';
+
+    char *end;
+    float parsed = strtof(text, &end);
+    if (end != &text[value_len] || !isfinite(parsed)) {
+        return false;
+    }
+    *result = parsed;
+    return true;
+}
@@ -38,6 +38,11 @@ typedef struct {
     TaskHandle_t monitor_task_handle;
     SemaphoreHandle_t state_mutex;
     callback_entry_t callbacks[MAX_CALLBACKS];
+    
+    // 触摸输入事件
+    uint32_t touch_gesture_count;
+    bsp_touch_gesture_t last_touch_gesture;
+    uint32_t last_touch_time;
 } bsp_state_manager_t;
 
 // 全局状态管理器实例
@@ -178,6 +183,9 @@ esp_err_t bsp_state_manager_get_info(system_state_info_t* info) {
         info->previous_state = s_manager.previous_state;
         info->state_change_count = s_manager.state_change_count;
         info->time_in_current_state = get_time_seconds() - s_manager.state_start_time;
+        info->touch_gesture_count = s_manager.touch_gesture_count;
+        info->last_touch_gesture = s_manager.last_touch_gesture;
+        info->last_touch_time = s_manager.last_touch_time;
         xSemaphoreGive(s_manager.state_mutex);
     }
     
@@ -237,10 +245,34 @@ void bsp_state_manager_print_status(void) {
     ESP_LOGI(TAG, "应用模组连接: %s", info.application_module_connected ? "是" : "否");
     ESP_LOGI(TAG, "用户主机连接: %s", info.user_host_connected ? "是" : "否");
     ESP_LOGI(TAG, "高负荷计算: %s", info.high_compute_load ? "是" : "否");
+    ESP_LOGI(TAG, "触摸手势: %" PRIu32 " 次, 最近: %s", info.touch_gesture_count,
+             bsp_touch_gesture_get_name(info.last_touch_gesture));
     ESP_LOGI(TAG, "监控状态: %s", s_manager.monitoring_active ? "运行中" : "已停止");
     ESP_LOGI(TAG, "=======================================");
 }
 
+esp_err_t bsp_state_manager_report_touch_gesture(bsp_touch_gesture_t gesture) {
+    if (gesture == BSP_TOUCH_GESTURE_NONE || gesture >= BSP_TOUCH_GESTURE_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (s_manager.state_mutex == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (xSemaphoreTake(s_manager.state_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    s_manager.touch_gesture_count++;
+    s_manager.last_touch_gesture = gesture;
+    s_manager.last_touch_time = get_time_seconds();
+    xSemaphoreGive(s_manager.state_mutex);
+    
+    ESP_LOGI(TAG, "触摸输入事件: %s (当前状态: %s)", bsp_touch_gesture_get_name(gesture),
+             bsp_state_manager_get_state_name(s_manager.current_state));
+    return ESP_OK;
+}
+
 // ========== 回调管理接口实现 ==========
 
 esp_err_t bsp_state_manager_register_callback(state_change_callback_t callback, void* user_data) {
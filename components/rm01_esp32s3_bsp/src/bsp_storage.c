@@ -2,6 +2,8 @@
 #include "bsp_board.h"
 #include "esp_log.h"
 #include "esp_vfs_fat.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include <sys/stat.h>
 #include <dirent.h>
 #include <errno.h>
@@ -11,7 +13,14 @@ static const char *TAG = "BSP_STORAGE";
 
 // SDMMC 相关静态变量
 static sdmmc_card_t *s_card = NULL;
-static bool s_sdmmc_mounted = false;
+static volatile bool s_sdmmc_mounted = false;
+
+// 挂载互斥锁：Logo后台加载任务和Web服务器任务可能同时挂载
+static SemaphoreHandle_t s_mount_mutex = NULL;
+static StaticSemaphore_t s_mount_mutex_buffer;
+static portMUX_TYPE s_mount_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static esp_err_t sdcard_mount_locked(const char *mount_point);
 
 esp_err_t bsp_storage_sdcard_mount(const char *mount_point)
 {
@@ -20,6 +29,21 @@ esp_err_t bsp_storage_sdcard_mount(const char *mount_point)
         return ESP_OK;
     }
 
+    portENTER_CRITICAL(&s_mount_lock);
+    if (s_mount_mutex == NULL) {
+        s_mount_mutex = xSemaphoreCreateMutexStatic(&s_mount_mutex_buffer);
+    }
+    portEXIT_CRITICAL(&s_mount_lock);
+
+    // 等待其他任务完成挂载后直接使用其结果
+    xSemaphoreTake(s_mount_mutex, portMAX_DELAY);
+    esp_err_t ret = s_sdmmc_mounted ? ESP_OK : sdcard_mount_locked(mount_point);
+    xSemaphoreGive(s_mount_mutex);
+    return ret;
+}
+
+static esp_err_t sdcard_mount_locked(const char *mount_point)
+{
     ESP_LOGI(TAG, "挂载FAT文件系统到 %s", mount_point);
 
     // 挂载配置
@@ -0,0 +1,217 @@
+/**
+ * @file bsp_touch_gesture.c
+ * @brief 触摸按键手势识别实现
+ *
+ * 每次采样先检查超时（长按、双击窗口），再处理消抖后的按下/松开边沿，
+ * 因此一次采样最多确认一个手势。基线使用一阶滤波，只在未按下、读数低于
+ * 唤醒阈值且没有待确认的边沿时更新，手指按住或正在缓慢按下时不会被基线“吸收”。
+ */
+
+#include "bsp_touch_gesture.h"
+#include <stddef.h>
+#include <string.h>
+
+// 默认识别参数
+#define DEFAULT_TOUCH_PERCENT       20      // 读数比基线高20%判定为按下
+#define DEFAULT_RELEASE_PERCENT     10      // 回落到基线10%以内判定为松开
+#define DEFAULT_WAKE_PERCENT        10      // 读数比基线高10%产生硬件中断
+#define DEFAULT_DEBOUNCE_SAMPLES    2       // 连续2次采样确认
+#define DEFAULT_BASELINE_SHIFT      4       // 基线每次移动差值的1/16
+#define DEFAULT_LONG_PRESS_MS       800     // 长按时长
+#define DEFAULT_DOUBLE_TAP_MS       300     // 双击等待窗口
+
+// 手势名称映射
+static const char *GESTURE_NAMES[] = {
+    "无",
+    "单击",
+    "双击",
+    "长按",
+};
+
+// ========== 静态函数声明 ==========
+static bool is_raw_touched(const bsp_touch_gesture_detector_t *detector, uint32_t raw);
+static bool is_above_percent(const bsp_touch_gesture_detector_t *detector, uint32_t raw, uint8_t percent);
+static void update_baseline(bsp_touch_gesture_detector_t *detector, uint32_t raw);
+static bsp_touch_gesture_t check_timeouts(bsp_touch_gesture_detector_t *detector, uint32_t now_ms);
+static bsp_touch_gesture_t handle_edge(bsp_touch_gesture_detector_t *detector, uint32_t now_ms);
+
+// ========== 核心接口实现 ==========
+
+bsp_touch_gesture_config_t bsp_touch_gesture_get_default_config(void) {
+    bsp_touch_gesture_config_t config = {
+        .touch_percent = DEFAULT_TOUCH_PERCENT,
+        .release_percent = DEFAULT_RELEASE_PERCENT,
+        .wake_percent = DEFAULT_WAKE_PERCENT,
+        .debounce_samples = DEFAULT_DEBOUNCE_SAMPLES,
+        .baseline_shift = DEFAULT_BASELINE_SHIFT,
+        .long_press_ms = DEFAULT_LONG_PRESS_MS,
+        .double_tap_ms = DEFAULT_DOUBLE_TAP_MS,
+    };
+    return config;
+}
+
+void bsp_touch_gesture_init(bsp_touch_gesture_detector_t *detector, const bsp_touch_gesture_config_t *config) {
+    if (detector == NULL) {
+        return;
+    }
+    memset(detector, 0, sizeof(*detector));
+    detector->config = config != NULL ? *config : bsp_touch_gesture_get_default_config();
+    detector->state = BSP_TOUCH_STATE_IDLE;
+
+    // 松开阈值不能高于按下阈值，否则没有滞回
+    if (detector->config.release_percent > detector->config.touch_percent) {
+        detector->config.release_percent = detector->config.touch_percent;
+    }
+    // 唤醒阈值必须在按下阈值之前到达，否则中断唤醒时已错过按下
+    if (detector->config.wake_percent == 0 || detector->config.wake_percent > detector->config.touch_percent) {
+        detector->config.wake_percent = detector->config.touch_percent / 2;
+    }
+    if (detector->config.debounce_samples == 0) {
+        detector->config.debounce_samples = 1;
+    }
+}
+
+bsp_touch_gesture_t bsp_touch_gesture_feed(bsp_touch_gesture_detector_t *detector, uint32_t raw, uint32_t now_ms) {
+    if (detector == NULL) {
+        return BSP_TOUCH_GESTURE_NONE;
+    }
+
+    if (!detector->baseline_valid) {
+        detector->baseline = raw;
+        detector->baseline_valid = true;
+        return BSP_TOUCH_GESTURE_NONE;
+    }
+
+    bsp_touch_gesture_t gesture = check_timeouts(detector, now_ms);
+    bool above_wake = is_above_percent(detector, raw, detector->config.wake_percent);
+
+    // 消抖：与当前状态相反的读数需连续出现debounce_samples次
+    bool raw_touched = is_raw_touched(detector, raw);
+    if (raw_touched != detector->touched) {
+        if (++detector->debounce_count >= detector->config.debounce_samples) {
+            detector->touched = raw_touched;
+            detector->debounce_count = 0;
+            bsp_touch_gesture_t edge_gesture = handle_edge(detector, now_ms);
+            if (edge_gesture != BSP_TOUCH_GESTURE_NONE) {
+                gesture = edge_gesture;
+            }
+        }
+    } else {
+        detector->debounce_count = 0;
+        if (!detector->touched && !above_wake) {
+            update_baseline(detector, raw);
+        }
+    }
+
+    // 读数回落到唤醒阈值以下：本次唤醒结束
+    if (!detector->touched && !above_wake) {
+        detector->woken = false;
+    }
+
+    return gesture;
+}
+
+void bsp_touch_gesture_notify_wake(bsp_touch_gesture_detector_t *detector, bool active) {
+    if (detector == NULL) {
+        return;
+    }
+    detector->woken = active;
+}
+
+bool bsp_touch_gesture_is_active(const bsp_touch_gesture_detector_t *detector) {
+    if (detector == NULL) {
+        return false;
+    }
+    return detector->state != BSP_TOUCH_STATE_IDLE || detector->touched || detector->woken ||
+           detector->debounce_count > 0;
+}
+
+uint32_t bsp_touch_gesture_get_touch_delta(const bsp_touch_gesture_detector_t *detector) {
+    if (detector == NULL || !detector->baseline_valid) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)detector->baseline * detector->config.touch_percent / 100);
+}
+
+uint32_t bsp_touch_gesture_get_wake_delta(const bsp_touch_gesture_detector_t *detector) {
+    if (detector == NULL || !detector->baseline_valid) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)detector->baseline * detector->config.wake_percent / 100);
+}
+
+const char *bsp_touch_gesture_get_name(bsp_touch_gesture_t gesture) {
+    if (gesture >= BSP_TOUCH_GESTURE_COUNT) {
+        return "未知";
+    }
+    return GESTURE_NAMES[gesture];
+}
+
+// ========== 静态函数实现 ==========
+
+// 按下时使用较低的松开阈值判定，形成滞回
+static bool is_raw_touched(const bsp_touch_gesture_detector_t *detector, uint32_t raw) {
+    uint8_t percent = detector->touched ? detector->config.release_percent : detector->config.touch_percent;
+    return is_above_percent(detector, raw, percent);
+}
+
+static bool is_above_percent(const bsp_touch_gesture_detector_t *detector, uint32_t raw, uint8_t percent) {
+    uint64_t threshold = (uint64_t)detector->baseline * (100 + percent) / 100;
+    return raw > threshold;
+}
+
+static void update_baseline(bsp_touch_gesture_detector_t *detector, uint32_t raw) {
+    int64_t diff = (int64_t)raw - detector->baseline;
+    detector->baseline = (uint32_t)(detector->baseline + diff / (1 << detector->config.baseline_shift));
+}
+
+static bsp_touch_gesture_t check_timeouts(bsp_touch_gesture_detector_t *detector, uint32_t now_ms) {
+    switch (detector->state) {
+        case BSP_TOUCH_STATE_PRESSED:
+        case BSP_TOUCH_STATE_SECOND_PRESSED:
+            if (now_ms - detector->press_ms >= detector->config.long_press_ms) {
+                detector->state = BSP_TOUCH_STATE_HELD;
+                return BSP_TOUCH_GESTURE_LONG_PRESS;
+            }
+            break;
+
+        case BSP_TOUCH_STATE_WAIT_SECOND:
+            if (now_ms - detector->release_ms >= detector->config.double_tap_ms) {
+                detector->state = BSP_TOUCH_STATE_IDLE;
+                return BSP_TOUCH_GESTURE_TAP;
+            }
+            break;
+
+        default:
+            break;
+    }
+    return BSP_TOUCH_GESTURE_NONE;
+}
+
+static bsp_touch_gesture_t handle_edge(bsp_touch_gesture_detector_t *detector, uint32_t now_ms) {
+    if (detector->touched) {
+        if (detector->state == BSP_TOUCH_STATE_IDLE) {
+            detector->state = BSP_TOUCH_STATE_PRESSED;
+            detector->press_ms = now_ms;
+        } else if (detector->state == BSP_TOUCH_STATE_WAIT_SECOND) {
+            detector->state = BSP_TOUCH_STATE_SECOND_PRESSED;
+            detector->press_ms = now_ms;
+        }
+        return BSP_TOUCH_GESTURE_NONE;
+    }
+
+    detector->release_ms = now_ms;
+    switch (detector->state) {
+        case BSP_TOUCH_STATE_PRESSED:
+            detector->state = BSP_TOUCH_STATE_WAIT_SECOND;
+            return BSP_TOUCH_GESTURE_NONE;
+
+        case BSP_TOUCH_STATE_SECOND_PRESSED:
+            detector->state = BSP_TOUCH_STATE_IDLE;
+            return BSP_TOUCH_GESTURE_DOUBLE_TAP;
+
+        default:
+            detector->state = BSP_TOUCH_STATE_IDLE;
+            return BSP_TOUCH_GESTURE_NONE;
+    }
+}
@@ -14,6 +14,10 @@
     - 如果网络状态出现多个未连接，则多种颜色闪烁切换
     * @note 该模块依赖于bsp_ws2812.h和network_monitor.h
  * @note 该模块使用FreeRTOS任务和信号量进行状态管理
+ * @note 显示任务阻塞等待任务通知（网络、状态、配置变化），只有闪烁/呼吸动画期间
+ *       和启动时间阈值到达时才定时唤醒；网络和状态变化通过网络适配器和状态管理器
+ *       的回调接收，两者都不依赖本模块
+ * @note 触摸按键手势以反馈灯效短暂叠加在当前模式之上
  * @note 该模块使用ESP-IDF的日志系统进行调试输出
  * @note 该模块使用ESP-IDF的时间函数进行延时和计时
  * @note 该模块使用ESP-IDF的错误处理机制进行错误返回
@@ -22,6 +26,11 @@
 #include "bsp_touch_ws2812_display.h"
 #include "bsp_ws2812.h"
 #include "network_monitor.h"
+#include "bsp_network_adapter.h"
+#include "bsp_state_manager.h"
+#include "bsp_led_governor.h"
+#include "bsp_led_effect.h"
+#include "bsp_config.h"
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_timer.h"
@@ -30,21 +39,12 @@
 #include "freertos/semphr.h"
 #include "sdkconfig.h"
 #include <string.h>
-#include <math.h>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
 
 static const char *TAG = "TOUCH_WS2812_DISP";
 
 // ========== 颜色定义 ==========
 
-typedef struct {
-    uint8_t r;
-    uint8_t g;
-    uint8_t b;
-} rgb_color_t;
+typedef bsp_led_rgb_t rgb_color_t;
 
 // 预定义颜色 - Touch WS2812专用于网络状态显示
 static const rgb_color_t COLOR_WHITE = {255, 255, 255}; // 白色 - 初始化/启动/待机
@@ -54,6 +54,12 @@ static const rgb_color_t COLOR_GREEN = {255, 0, 255}; // 紫色 - 用户主机
 static const rgb_color_t COLOR_ORANGE = {243, 112, 34}; // 浅橙色 - 有互联网待机
 static const rgb_color_t COLOR_OFF = {0, 0, 0}; // 关闭
 
+// 触摸手势反馈时长
+#define GESTURE_FEEDBACK_TAP_MS         150     // 单击：白色短亮
+#define GESTURE_FEEDBACK_DOUBLE_TAP_MS  400     // 双击：白色闪烁两次（亮灭各100ms）
+#define GESTURE_FEEDBACK_LONG_PRESS_MS  600     // 长按：白色渐暗
+#define MULTI_ERROR_SWITCH_MS           500     // 多重错误颜色切换间隔
+
 // 注意：红色用于高温警告，但应该由Board WS2812显示，不在Touch WS2812中使用
 
 // ========== 显示控制器状态结构 ==========
@@ -69,25 +75,37 @@ typedef struct {
     
     // 动画状态
     uint32_t animation_start_time;
-    uint32_t last_update_time;
-    bool animation_state;  // 用于闪烁状态切换
-    uint8_t breath_brightness;  // 呼吸灯亮度
-    bool breath_increasing;     // 呼吸灯方向
+    bool animation_state;  // 用于多重错误闪烁状态切换
+    bsp_led_effect_t effect;    // 闪烁/呼吸/常亮效果
+    
+    // 触摸手势反馈
+    volatile bsp_touch_gesture_t pending_gesture;  // 待显示的手势，由触摸按键任务写入
+    bsp_led_effect_t feedback_effect;
+    uint32_t feedback_start;
+    uint32_t feedback_duration_ms;  // 0表示没有反馈在显示
     
     // 多重错误状态
     uint8_t multi_error_index;
     uint32_t multi_error_last_switch;
     
+    // 最近一次写入LED的颜色，用于跳过重复刷新
+    rgb_color_t last_color;
+    bool last_color_valid;
+    
     // 网络状态缓存
     bool cached_n305_status;
     bool cached_jetson_status;
     bool cached_user_host_status;
     bool cached_internet_status;
-    uint32_t last_network_check;
+    
+    // 显示任务运行统计
+    touch_display_task_stats_t task_stats;
+    int64_t task_start_us;
 } touch_display_controller_t;
 
 // 全局控制器实例
 static touch_display_controller_t s_controller = {0};
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
 
 // 显示模式名称映射
 static const char* MODE_NAMES[] = {
@@ -109,15 +127,22 @@ static const char* MODE_NAMES[] = {
 
 static bool is_touch_display_initialized(void);
 static void touch_display_task(void *pvParameters);
+static void network_change_callback(const char* ip, nm_status_t old_status, nm_status_t new_status);
+static void state_change_callback(system_state_t old_state, system_state_t new_state, void* user_data);
 static touch_display_mode_t determine_display_mode(void);
+static void evaluate_display_mode(void);
+static uint32_t get_next_mode_deadline_ms(void);
 static void update_network_status_cache(void);
-static void execute_display_mode(touch_display_mode_t mode);
+static void record_task_wakeup(bool by_event, int64_t busy_us);
+static uint32_t execute_display_mode(touch_display_mode_t mode);
+static void start_gesture_feedback(bsp_touch_gesture_t gesture);
+static uint32_t render_frame(void);
 static void set_touch_led_color(uint8_t r, uint8_t g, uint8_t b);
-static void handle_blink_animation(const rgb_color_t* color, blink_speed_t speed);
-static void handle_breath_animation(const rgb_color_t* color, breath_speed_t speed);
-static void handle_multi_error_animation(void);
+static uint32_t handle_blink_animation(const rgb_color_t* color, blink_speed_t speed);
+static uint32_t handle_breath_animation(const rgb_color_t* color, breath_speed_t speed);
+static uint32_t handle_multi_error_animation(void);
+static uint32_t run_effect(bsp_led_effect_type_t type, const rgb_color_t* color, uint32_t period_ms);
 static uint32_t get_time_ms(void);
-static uint8_t apply_brightness(uint8_t color_value, uint8_t brightness);
 
 // ========== 核心接口实现 ==========
 
@@ -130,7 +155,7 @@ esp_err_t bsp_touch_ws2812_display_init(const touch_display_config_t* config) {
     }
     
     // 检查Touch WS2812是否已初始化
-    if (bsp_ws2812_get_handle(BSP_WS2812_TOUCH) == NULL) {
+    if (!bsp_ws2812_is_initialized(BSP_WS2812_TOUCH)) {
         ESP_LOGE(TAG, "Touch WS2812未初始化，请先调用bsp_ws2812_init()");
         return ESP_ERR_INVALID_STATE;
     }
@@ -157,12 +182,17 @@ esp_err_t bsp_touch_ws2812_display_init(const touch_display_config_t* config) {
     
     // 初始化动画状态
     s_controller.animation_start_time = get_time_ms();
-    s_controller.last_update_time = s_controller.animation_start_time;
     s_controller.animation_state = false;
-    s_controller.breath_brightness = 0;
-    s_controller.breath_increasing = true;
+    bsp_led_effect_init(&s_controller.effect, CONFIG_BSP_LED_ANIMATION_FRAME_INTERVAL_MS);
+    bsp_led_effect_init(&s_controller.feedback_effect, CONFIG_BSP_LED_ANIMATION_FRAME_INTERVAL_MS);
+    s_controller.pending_gesture = BSP_TOUCH_GESTURE_NONE;
+    s_controller.feedback_duration_ms = 0;
     s_controller.multi_error_index = 0;
     s_controller.multi_error_last_switch = s_controller.animation_start_time;
+    s_controller.last_color_valid = false;
+    
+    // 初始化LED渲染调速器
+    bsp_led_governor_init();
     
     // 初始化网络状态缓存
     update_network_status_cache();
@@ -194,6 +224,12 @@ esp_err_t bsp_touch_ws2812_display_start(void) {
     
     ESP_LOGI(TAG, "启动Touch WS2812显示控制器");
     
+    // 重置任务统计
+    portENTER_CRITICAL(&s_stats_lock);
+    memset(&s_controller.task_stats, 0, sizeof(s_controller.task_stats));
+    s_controller.task_start_us = esp_timer_get_time();
+    portEXIT_CRITICAL(&s_stats_lock);
+    
     // 创建显示任务
     s_controller.task_running = true;
     BaseType_t ret = xTaskCreate(
@@ -210,6 +246,13 @@ esp_err_t bsp_touch_ws2812_display_start(void) {
         ESP_LOGE(TAG, "创建Touch WS2812显示任务失败");
         return ESP_ERR_NO_MEM;
     }
+    
+    // 订阅网络和系统状态变化，唤醒显示任务重新评估显示模式
+    bsp_network_adapter_register_callback(network_change_callback);
+    esp_err_t err = bsp_state_manager_register_callback(state_change_callback, NULL);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "注册状态变化回调失败: %s", esp_err_to_name(err));
+    }
       // 更新状态
     if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
         s_controller.status.is_active = true;
@@ -229,6 +272,10 @@ void bsp_touch_ws2812_display_stop(void) {
     
     ESP_LOGI(TAG, "停止Touch WS2812显示控制器");
     
+    // 取消订阅网络和系统状态变化
+    bsp_network_adapter_register_callback(NULL);
+    bsp_state_manager_unregister_callback(state_change_callback);
+    
     // 停止任务
     s_controller.task_running = false;
     
@@ -275,8 +322,12 @@ esp_err_t bsp_touch_ws2812_display_set_mode(touch_display_mode_t mode) {
     }
     
     // 立即执行新模式
+    s_controller.last_color_valid = false;
     execute_display_mode(mode);
     
+    // 唤醒显示任务按新模式重新计算唤醒时间
+    bsp_touch_ws2812_display_notify(TOUCH_DISPLAY_EVENT_CONFIG);
+    
     return ESP_OK;
 }
 
@@ -305,39 +356,14 @@ void bsp_touch_ws2812_display_update(void) {
         return;
     }
     
-    // 更新网络状态缓存
-    update_network_status_cache();
-    
-    // 确定当前应该的显示模式
-    touch_display_mode_t new_mode = determine_display_mode();
-    
-    if (s_controller.config.debug_mode) {
-        ESP_LOGI(TAG, "更新显示: 当前模式=%s, 新模式=%s", 
-                 bsp_touch_ws2812_display_get_mode_name(s_controller.status.current_mode),
-                 bsp_touch_ws2812_display_get_mode_name(new_mode));
+    // 显示任务运行时交给任务处理，避免与任务并发修改动画状态
+    if (s_controller.task_running && s_controller.display_task_handle != NULL) {
+        bsp_touch_ws2812_display_notify(TOUCH_DISPLAY_EVENT_NETWORK | TOUCH_DISPLAY_EVENT_CONFIG);
+        return;
     }
     
-    // 如果模式发生变化，更新状态
-    if (new_mode != s_controller.status.current_mode) {
-        if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-            s_controller.status.previous_mode = s_controller.status.current_mode;
-            s_controller.status.current_mode = new_mode;
-            s_controller.status.mode_change_count++;
-            s_controller.animation_start_time = get_time_ms();
-            
-            // 重置动画状态
-            s_controller.animation_state = false;
-            s_controller.breath_brightness = 0;
-            s_controller.breath_increasing = true;
-            s_controller.multi_error_index = 0;
-            
-            xSemaphoreGive(s_controller.status_mutex);
-        }
-        
-        ESP_LOGI(TAG, "Touch WS2812显示模式变化: [%s] -> [%s]", 
-                 bsp_touch_ws2812_display_get_mode_name(s_controller.status.previous_mode),
-                 bsp_touch_ws2812_display_get_mode_name(new_mode));
-    }
+    update_network_status_cache();
+    evaluate_display_mode();
 }
 
 esp_err_t bsp_touch_ws2812_display_get_status(touch_display_status_t* status) {
@@ -360,6 +386,46 @@ esp_err_t bsp_touch_ws2812_display_get_status(touch_display_status_t* status) {
     return ESP_ERR_TIMEOUT;
 }
 
+void bsp_touch_ws2812_display_notify(uint32_t events) {
+    TaskHandle_t task = s_controller.display_task_handle;
+    if (!s_controller.task_running || task == NULL) {
+        return;
+    }
+    xTaskNotify(task, events, eSetBits);
+}
+
+void bsp_touch_ws2812_display_show_gesture(bsp_touch_gesture_t gesture) {
+    if (gesture == BSP_TOUCH_GESTURE_NONE || gesture >= BSP_TOUCH_GESTURE_COUNT) {
+        return;
+    }
+    s_controller.pending_gesture = gesture;
+    bsp_touch_ws2812_display_notify(TOUCH_DISPLAY_EVENT_GESTURE);
+}
+
+esp_err_t bsp_touch_ws2812_display_get_task_stats(touch_display_task_stats_t* stats) {
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!is_touch_display_initialized()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_controller.task_stats;
+    int64_t start_us = s_controller.task_start_us;
+    portEXIT_CRITICAL(&s_stats_lock);
+    
+    // 按统计时长换算平均值
+    int64_t run_us = (start_us > 0) ? esp_timer_get_time() - start_us : 0;
+    stats->run_time_ms = (uint32_t)(run_us / 1000);
+    if (run_us > 0) {
+        stats->wakeups_per_sec_x100 = (uint32_t)(((uint64_t)stats->wakeups * 100000000ULL) / (uint64_t)run_us);
+        stats->busy_us_per_sec = (uint32_t)((stats->busy_us * 1000000ULL) / (uint64_t)run_us);
+    }
+    return ESP_OK;
+}
+
 void bsp_touch_ws2812_display_print_status(void) {
     touch_display_status_t status;
     esp_err_t ret = bsp_touch_ws2812_display_get_status(&status);
@@ -384,6 +450,18 @@ void bsp_touch_ws2812_display_print_status(void) {
     ESP_LOGI(TAG, "  Jetson: %s", status.jetson_connected ? "连接" : "断开");
     ESP_LOGI(TAG, "  用户主机: %s", status.user_host_connected ? "连接" : "断开");
     ESP_LOGI(TAG, "  互联网: %s", status.internet_connected ? "连接" : "断开");
+    
+    touch_display_task_stats_t stats;
+    if (bsp_touch_ws2812_display_get_task_stats(&stats) == ESP_OK) {
+        ESP_LOGI(TAG, "显示任务统计 (%lu 秒):", (unsigned long)(stats.run_time_ms / 1000));
+        ESP_LOGI(TAG, "  唤醒: %lu 次 (事件 %lu, 定时 %lu), 平均 %lu.%02lu 次/秒",
+                 (unsigned long)stats.wakeups, (unsigned long)stats.event_wakeups,
+                 (unsigned long)stats.timer_wakeups,
+                 (unsigned long)(stats.wakeups_per_sec_x100 / 100),
+                 (unsigned long)(stats.wakeups_per_sec_x100 % 100));
+        ESP_LOGI(TAG, "  CPU耗时: 累计 %llu us, 平均 %lu us/秒",
+                 (unsigned long long)stats.busy_us, (unsigned long)stats.busy_us_per_sec);
+    }
     ESP_LOGI(TAG, "========================================");
 }
 
@@ -404,11 +482,16 @@ touch_display_config_t bsp_touch_ws2812_display_get_default_config(void) {
 void bsp_touch_ws2812_display_set_auto_mode(bool enabled) {
     s_controller.config.auto_mode_enabled = enabled;
     ESP_LOGI(TAG, "Touch WS2812自动模式设置为: %s", enabled ? "启用" : "禁用");
+    bsp_touch_ws2812_display_notify(TOUCH_DISPLAY_EVENT_CONFIG);
 }
 
 void bsp_touch_ws2812_display_set_brightness(uint8_t brightness) {
     s_controller.config.brightness = brightness;
     ESP_LOGI(TAG, "Touch WS2812亮度设置为: %d", brightness);
+    
+    // 静止画面不会定时刷新，需要唤醒任务按新亮度重绘
+    s_controller.last_color_valid = false;
+    bsp_touch_ws2812_display_notify(TOUCH_DISPLAY_EVENT_CONFIG);
 }
 
 void bsp_touch_ws2812_display_set_debug_mode(bool debug_mode) {
@@ -442,7 +525,7 @@ esp_err_t bsp_touch_ws2812_display_set_blink(uint8_t r, uint8_t g, uint8_t b, bl
     }
     
     rgb_color_t color = {r, g, b};
-    handle_blink_animation(&color, speed);
+    (void)handle_blink_animation(&color, speed);
     return ESP_OK;
 }
 
@@ -452,7 +535,7 @@ esp_err_t bsp_touch_ws2812_display_set_breath(uint8_t r, uint8_t g, uint8_t b, b
     }
     
     rgb_color_t color = {r, g, b};
-    handle_breath_animation(&color, speed);
+    (void)handle_breath_animation(&color, speed);
     return ESP_OK;
 }
 
@@ -461,6 +544,7 @@ esp_err_t bsp_touch_ws2812_display_off(void) {
         return ESP_ERR_INVALID_STATE;
     }
     
+    s_controller.last_color_valid = false;
     return bsp_ws2812_clear(BSP_WS2812_TOUCH);
 }
 
@@ -482,29 +566,72 @@ static bool is_touch_display_initialized(void) {
 static void touch_display_task(void *pvParameters) {
     ESP_LOGI(TAG, "Touch WS2812显示任务开始运行");
     
+    // 首次运行时读取一次网络状态，之后只在网络监控通知状态变化时刷新
+    uint32_t events = TOUCH_DISPLAY_EVENT_NETWORK;
+    
     while (s_controller.task_running) {
+        int64_t wake_us = esp_timer_get_time();
+        
+        if (events & TOUCH_DISPLAY_EVENT_NETWORK) {
+            update_network_status_cache();
+        }
+        
         // 如果是自动模式，更新显示状态
         if (!s_controller.manual_mode && s_controller.config.auto_mode_enabled) {
-            bsp_touch_ws2812_display_update();
+            evaluate_display_mode();
+        }
+        
+        if (events & TOUCH_DISPLAY_EVENT_GESTURE) {
+            start_gesture_feedback(s_controller.pending_gesture);
         }
         
-        // 执行当前模式的动画
-        execute_display_mode(s_controller.status.current_mode);
-          // 更新时间信息
+        // 执行当前模式的动画（或手势反馈），并由调速器决定下一帧的等待时间
+        int64_t frame_begin = bsp_led_governor_frame_begin(BSP_LED_RENDERER_TOUCH);
+        uint32_t next_frame_ms = render_frame();
+        uint32_t wait_ms = bsp_led_governor_frame_end(BSP_LED_RENDERER_TOUCH, frame_begin, next_frame_ms);
+        
+        // 更新时间信息
         if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
             s_controller.status.time_in_current_mode = get_time_ms() - s_controller.animation_start_time;
             // 注意：system_uptime_ms 不应该在这里更新，它应该保持启动时的时间戳
             xSemaphoreGive(s_controller.status_mutex);
         }
         
-        // 50ms更新间隔，确保动画流畅
-        vTaskDelay(pdMS_TO_TICKS(50));
+        // 网络等状态变化由通知唤醒，静止画面只需在下一个启动时间阈值处重新评估模式
+        uint32_t mode_deadline_ms = get_next_mode_deadline_ms();
+        if (mode_deadline_ms < wait_ms) {
+            wait_ms = mode_deadline_ms;
+        }
+        
+        TickType_t wait_ticks = portMAX_DELAY;
+        if (wait_ms != BSP_LED_DEADLINE_STATIC) {
+            wait_ticks = pdMS_TO_TICKS(wait_ms);
+            if (wait_ticks == 0) {
+                wait_ticks = 1;
+            }
+        }
+        int64_t busy_us = esp_timer_get_time() - wake_us;
+        
+        events = 0;
+        bool by_event = (xTaskNotifyWait(0, UINT32_MAX, &events, wait_ticks) == pdTRUE);
+        record_task_wakeup(by_event, busy_us);
     }
     
     ESP_LOGI(TAG, "Touch WS2812显示任务结束");
     vTaskDelete(NULL);
 }
 
+// 网络适配器回调（网络监控任务上下文）：刷新网络状态缓存
+static void network_change_callback(const char* ip, nm_status_t old_status, nm_status_t new_status) {
+    bsp_touch_ws2812_display_notify(TOUCH_DISPLAY_EVENT_NETWORK);
+}
+
+// 状态管理器回调：系统状态由网络连接决定，同时刷新网络状态缓存，
+// 覆盖网络适配器启动之前发生的变化
+static void state_change_callback(system_state_t old_state, system_state_t new_state, void* user_data) {
+    bsp_touch_ws2812_display_notify(TOUCH_DISPLAY_EVENT_NETWORK | TOUCH_DISPLAY_EVENT_STATE);
+}
+
 static touch_display_mode_t determine_display_mode(void) {    // 直接使用系统启动后的时间，get_time_ms()返回的就是从系统启动开始的毫秒数
     uint32_t system_uptime = get_time_ms();
       // 模式判断的调试信息
@@ -658,14 +785,62 @@ static touch_display_mode_t determine_display_mode(void) {    // 直接使用系
     return TOUCH_DISPLAY_MODE_STARTUP;
 }
 
-static void update_network_status_cache(void) {
-    uint32_t current_time = get_time_ms();
+// 根据当前状态确定显示模式，模式变化时重置动画状态
+static void evaluate_display_mode(void) {
+    // 确定当前应该的显示模式
+    touch_display_mode_t new_mode = determine_display_mode();
     
-    // 每1秒更新一次网络状态缓存
-    if (current_time - s_controller.last_network_check < 1000) {
-        return;
+    if (s_controller.config.debug_mode) {
+        ESP_LOGI(TAG, "更新显示: 当前模式=%s, 新模式=%s", 
+                 bsp_touch_ws2812_display_get_mode_name(s_controller.status.current_mode),
+                 bsp_touch_ws2812_display_get_mode_name(new_mode));
+    }
+    
+    // 如果模式发生变化，更新状态
+    if (new_mode != s_controller.status.current_mode) {
+        if (xSemaphoreTake(s_controller.status_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+            s_controller.status.previous_mode = s_controller.status.current_mode;
+            s_controller.status.current_mode = new_mode;
+            s_controller.status.mode_change_count++;
+            s_controller.animation_start_time = get_time_ms();
+            
+            // 重置动画状态
+            s_controller.animation_state = false;
+            s_controller.multi_error_index = 0;
+            s_controller.last_color_valid = false;
+            
+            xSemaphoreGive(s_controller.status_mutex);
+        }
+        
+        ESP_LOGI(TAG, "Touch WS2812显示模式变化: [%s] -> [%s]", 
+                 bsp_touch_ws2812_display_get_mode_name(s_controller.status.previous_mode),
+                 bsp_touch_ws2812_display_get_mode_name(new_mode));
+    }
+}
+
+// 距离下一个启动时间阈值的毫秒数，模式可能因此变化；没有待到达的阈值时返回BSP_LED_DEADLINE_STATIC
+static uint32_t get_next_mode_deadline_ms(void) {
+    if (s_controller.manual_mode || !s_controller.config.auto_mode_enabled) {
+        return BSP_LED_DEADLINE_STATIC;
     }
     
+    uint32_t now = get_time_ms();
+    const uint32_t thresholds[] = {
+        s_controller.config.init_duration_ms,
+        s_controller.config.error_timeout_ms,
+        s_controller.config.standby_delay_ms,
+    };
+    
+    uint32_t deadline = BSP_LED_DEADLINE_STATIC;
+    for (size_t i = 0; i < sizeof(thresholds) / sizeof(thresholds[0]); i++) {
+        if (now < thresholds[i] && thresholds[i] - now < deadline) {
+            deadline = thresholds[i] - now;
+        }
+    }
+    return deadline;
+}
+
+static void update_network_status_cache(void) {
     // 获取网络状态
     if (s_controller.config.debug_mode) {
         ESP_LOGI(TAG, "开始更新网络状态缓存...");
@@ -692,8 +867,6 @@ static void update_network_status_cache(void) {
     s_controller.cached_user_host_status = (user_host_status == NM_STATUS_UP);
     s_controller.cached_internet_status = (internet_status == NM_STATUS_UP);
     
-    s_controller.last_network_check = current_time;
-    
     if (s_controller.config.debug_mode) {
         ESP_LOGI(TAG, "网络状态更新: N305=%s, Jetson=%s, 用户主机=%s, 互联网=%s",
                  s_controller.cached_n305_status ? "连接" : "断开",
@@ -712,68 +885,116 @@ static void update_network_status_cache(void) {
     }
 }
 
-static void execute_display_mode(touch_display_mode_t mode) {
+static uint32_t execute_display_mode(touch_display_mode_t mode) {
     switch (mode) {
         case TOUCH_DISPLAY_MODE_INIT:
             // 白色常亮
-            set_touch_led_color(COLOR_WHITE.r, COLOR_WHITE.g, COLOR_WHITE.b);
-            break;
+            return run_effect(BSP_LED_EFFECT_SOLID, &COLOR_WHITE, 0);
             
         case TOUCH_DISPLAY_MODE_N305_ERROR:
             // 蓝色闪烁
-            handle_blink_animation(&COLOR_BLUE, BLINK_SPEED_NORMAL);
-            break;
+            return handle_blink_animation(&COLOR_BLUE, BLINK_SPEED_NORMAL);
             
         case TOUCH_DISPLAY_MODE_JETSON_ERROR:
             // 黄色闪烁
-            handle_blink_animation(&COLOR_YELLOW, BLINK_SPEED_NORMAL);
-            break;
+            return handle_blink_animation(&COLOR_YELLOW, BLINK_SPEED_NORMAL);
             
         case TOUCH_DISPLAY_MODE_USER_HOST_WARNING:
             // 绿色闪烁
-            handle_blink_animation(&COLOR_GREEN, BLINK_SPEED_NORMAL);
-            break;
+            return handle_blink_animation(&COLOR_GREEN, BLINK_SPEED_NORMAL);
               case TOUCH_DISPLAY_MODE_STARTUP:
             // 启动中状态：如果有互联网连接显示橙色快速呼吸，否则显示白色快速呼吸
             if (s_controller.cached_internet_status) {
-                handle_breath_animation(&COLOR_ORANGE, BREATH_SPEED_FAST);
+                return handle_breath_animation(&COLOR_ORANGE, BREATH_SPEED_FAST);
             } else {
-                handle_breath_animation(&COLOR_WHITE, BREATH_SPEED_FAST);
+                return handle_breath_animation(&COLOR_WHITE, BREATH_SPEED_FAST);
             }
-            break;
             
         case TOUCH_DISPLAY_MODE_STANDBY_NO_INTERNET:
             // 白色慢速呼吸
-            handle_breath_animation(&COLOR_WHITE, BREATH_SPEED_SLOW);
-            break;
+            return handle_breath_animation(&COLOR_WHITE, BREATH_SPEED_SLOW);
             
         case TOUCH_DISPLAY_MODE_STANDBY_WITH_INTERNET:
             // 橙色慢速呼吸
-            handle_breath_animation(&COLOR_ORANGE, BREATH_SPEED_SLOW);
-            break;
+            return handle_breath_animation(&COLOR_ORANGE, BREATH_SPEED_SLOW);
             
         case TOUCH_DISPLAY_MODE_MULTI_ERROR:
             // 多种颜色闪烁切换
-            handle_multi_error_animation();
-            break;
+            return handle_multi_error_animation();
             
         case TOUCH_DISPLAY_MODE_INTERNET_ONLY:
             // 仅互联网连接 - 橙色闪烁
-            handle_blink_animation(&COLOR_ORANGE, BLINK_SPEED_NORMAL);
-            break;
+            return handle_blink_animation(&COLOR_ORANGE, BLINK_SPEED_NORMAL);
             
         default:
             // 默认关闭
-            set_touch_led_color(COLOR_OFF.r, COLOR_OFF.g, COLOR_OFF.b);
+            return run_effect(BSP_LED_EFFECT_SOLID, &COLOR_OFF, 0);
+    }
+}
+
+static void start_gesture_feedback(bsp_touch_gesture_t gesture) {
+    uint32_t now = get_time_ms();
+    
+    switch (gesture) {
+        case BSP_TOUCH_GESTURE_TAP:
+            bsp_led_effect_set(&s_controller.feedback_effect, BSP_LED_EFFECT_SOLID, COLOR_WHITE, COLOR_OFF, 0, now);
+            s_controller.feedback_duration_ms = GESTURE_FEEDBACK_TAP_MS;
+            break;
+        case BSP_TOUCH_GESTURE_DOUBLE_TAP:
+            bsp_led_effect_set(&s_controller.feedback_effect, BSP_LED_EFFECT_BLINK, COLOR_WHITE, COLOR_OFF,
+                               GESTURE_FEEDBACK_DOUBLE_TAP_MS / 4, now);
+            s_controller.feedback_duration_ms = GESTURE_FEEDBACK_DOUBLE_TAP_MS;
+            break;
+        case BSP_TOUCH_GESTURE_LONG_PRESS:
+            bsp_led_effect_set(&s_controller.feedback_effect, BSP_LED_EFFECT_FADE, COLOR_WHITE, COLOR_OFF,
+                               GESTURE_FEEDBACK_LONG_PRESS_MS, now);
+            s_controller.feedback_duration_ms = GESTURE_FEEDBACK_LONG_PRESS_MS;
             break;
+        default:
+            return;
     }
+    
+    // 连续相同手势也从头显示
+    bsp_led_effect_restart(&s_controller.feedback_effect, now);
+    s_controller.feedback_start = now;
+}
+
+// 手势反馈期间显示反馈灯效，结束后回到当前模式
+static uint32_t render_frame(void) {
+    if (s_controller.feedback_duration_ms > 0) {
+        uint32_t now = get_time_ms();
+        uint32_t elapsed = now - s_controller.feedback_start;
+        
+        if (elapsed < s_controller.feedback_duration_ms) {
+            rgb_color_t out;
+            uint32_t next_ms = bsp_led_effect_render(&s_controller.feedback_effect, now, &out);
+            set_touch_led_color(out.r, out.g, out.b);
+            
+            uint32_t remaining = s_controller.feedback_duration_ms - elapsed;
+            return (next_ms < remaining) ? next_ms : remaining;
+        }
+        
+        // 反馈结束：多重错误只在切换时刻写LED，让它立即输出当前颜色
+        s_controller.feedback_duration_ms = 0;
+        s_controller.multi_error_last_switch = now - MULTI_ERROR_SWITCH_MS;
+    }
+    
+    return execute_display_mode(s_controller.status.current_mode);
 }
 
 static void set_touch_led_color(uint8_t r, uint8_t g, uint8_t b) {
     // 应用亮度调整
-    uint8_t adj_r = apply_brightness(r, s_controller.config.brightness);
-    uint8_t adj_g = apply_brightness(g, s_controller.config.brightness);
-    uint8_t adj_b = apply_brightness(b, s_controller.config.brightness);
+    uint8_t adj_r = bsp_led_effect_scale8(r, s_controller.config.brightness);
+    uint8_t adj_g = bsp_led_effect_scale8(g, s_controller.config.brightness);
+    uint8_t adj_b = bsp_led_effect_scale8(b, s_controller.config.brightness);
+    
+    // 颜色未变化时跳过RMT刷新
+    if (s_controller.last_color_valid &&
+        s_controller.last_color.r == adj_r &&
+        s_controller.last_color.g == adj_g &&
+        s_controller.last_color.b == adj_b) {
+        return;
+    }
     
     // 注释掉高频debug信息，避免影响其他调试信息
     if (s_controller.config.debug_mode) {
@@ -784,6 +1005,10 @@ static void set_touch_led_color(uint8_t r, uint8_t g, uint8_t b) {
     esp_err_t ret = bsp_ws2812_set_pixel(BSP_WS2812_TOUCH, 0, adj_r, adj_g, adj_b);
     if (ret == ESP_OK) {
         bsp_ws2812_refresh(BSP_WS2812_TOUCH);
+        s_controller.last_color.r = adj_r;
+        s_controller.last_color.g = adj_g;
+        s_controller.last_color.b = adj_b;
+        s_controller.last_color_valid = true;
         // 注释掉高频debug信息，避免影响其他调试信息
         if (s_controller.config.debug_mode) {
             ESP_LOGI(TAG, "Touch WS2812刷新成功");
@@ -793,8 +1018,7 @@ static void set_touch_led_color(uint8_t r, uint8_t g, uint8_t b) {
     }
 }
 
-static void handle_blink_animation(const rgb_color_t* color, blink_speed_t speed) {
-    uint32_t current_time = get_time_ms();
+static uint32_t handle_blink_animation(const rgb_color_t* color, blink_speed_t speed) {
     uint32_t blink_interval;
     
     // 根据速度设置闪烁间隔
@@ -816,21 +1040,11 @@ static void handle_blink_animation(const rgb_color_t* color, blink_speed_t speed
             break;
     }
     
-    // 检查是否需要切换状态
-    if (current_time - s_controller.last_update_time >= blink_interval) {
-        s_controller.animation_state = !s_controller.animation_state;
-        s_controller.last_update_time = current_time;
-        
-        if (s_controller.animation_state) {
-            set_touch_led_color(color->r, color->g, color->b);
-        } else {
-            set_touch_led_color(COLOR_OFF.r, COLOR_OFF.g, COLOR_OFF.b);
-        }
-    }
+    // 下一次刷新期限为下一次闪烁切换时刻
+    return run_effect(BSP_LED_EFFECT_BLINK, color, blink_interval);
 }
 
-static void handle_breath_animation(const rgb_color_t* color, breath_speed_t speed) {
-    uint32_t current_time = get_time_ms();
+static uint32_t handle_breath_animation(const rgb_color_t* color, breath_speed_t speed) {
     uint32_t breath_period;
     
     // 根据速度设置呼吸周期
@@ -849,27 +1063,15 @@ static void handle_breath_animation(const rgb_color_t* color, breath_speed_t spe
             break;
     }
     
-    // 计算呼吸亮度
-    uint32_t time_in_cycle = (current_time - s_controller.animation_start_time) % breath_period;
-    float progress = (float)time_in_cycle / breath_period;
-    
-    // 使用正弦波生成平滑的呼吸效果
-    float brightness_factor = (sinf(progress * 2 * M_PI) + 1.0f) / 2.0f;
-    uint8_t brightness = (uint8_t)(brightness_factor * 255);
-    
-    // 计算调整后的颜色
-    uint8_t adj_r = (color->r * brightness) / 255;
-    uint8_t adj_g = (color->g * brightness) / 255;
-    uint8_t adj_b = (color->b * brightness) / 255;
-    
-    set_touch_led_color(adj_r, adj_g, adj_b);
+    // 呼吸需要连续刷新
+    return run_effect(BSP_LED_EFFECT_BREATH, color, breath_period);
 }
 
-static void handle_multi_error_animation(void) {
+static uint32_t handle_multi_error_animation(void) {
     uint32_t current_time = get_time_ms();
     
     // 每500ms切换一种颜色
-    if (current_time - s_controller.multi_error_last_switch >= 500) {
+    if (current_time - s_controller.multi_error_last_switch >= MULTI_ERROR_SWITCH_MS) {
         s_controller.multi_error_last_switch = current_time;
         
         // 构建需要显示的颜色列表
@@ -912,12 +1114,35 @@ static void handle_multi_error_animation(void) {
         
         s_controller.animation_state = !s_controller.animation_state;
     }
+    
+    // 下一次刷新期限为下一次颜色切换时刻
+    uint32_t elapsed = current_time - s_controller.multi_error_last_switch;
+    return (elapsed < MULTI_ERROR_SWITCH_MS) ? (MULTI_ERROR_SWITCH_MS - elapsed) : 0;
 }
 
-static uint32_t get_time_ms(void) {
-    return esp_timer_get_time() / 1000;
+static void record_task_wakeup(bool by_event, int64_t busy_us) {
+    portENTER_CRITICAL(&s_stats_lock);
+    s_controller.task_stats.wakeups++;
+    if (by_event) {
+        s_controller.task_stats.event_wakeups++;
+    } else {
+        s_controller.task_stats.timer_wakeups++;
+    }
+    s_controller.task_stats.busy_us += (uint64_t)busy_us;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+// 设置效果（参数未变化时保持相位）并输出当前颜色，返回下一次刷新期限
+static uint32_t run_effect(bsp_led_effect_type_t type, const rgb_color_t* color, uint32_t period_ms) {
+    uint32_t now = get_time_ms();
+    bsp_led_effect_set(&s_controller.effect, type, *color, COLOR_OFF, period_ms, now);
+    
+    rgb_color_t out;
+    uint32_t next_ms = bsp_led_effect_render(&s_controller.effect, now, &out);
+    set_touch_led_color(out.r, out.g, out.b);
+    return next_ms;
 }
 
-static uint8_t apply_brightness(uint8_t color_value, uint8_t brightness) {
-    return (color_value * brightness) / 255;
+static uint32_t get_time_ms(void) {
+    return esp_timer_get_time() / 1000;
 }
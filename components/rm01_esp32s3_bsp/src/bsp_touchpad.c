@@ -0,0 +1,320 @@
+/**
+ * @file bsp_touchpad.c
+ * @brief 电容触摸按键驱动实现
+ *
+ * 触摸外设以硬件定时器模式持续测量，平滑值与硬件基准之差超过阈值（或回落）时
+ * 产生ACTIVE/INACTIVE中断。中断只负责通知驱动任务；任务被唤醒后按
+ * sample_interval_ms连续采样，交给手势识别器完成消抖和单击/双击/长按判定，
+ * 识别结束后回到阻塞等待。硬件阈值取识别器的唤醒阈值（低于软件按下阈值），
+ * ACTIVE中断后持续采样直到INACTIVE中断或读数回落到唤醒阈值以下，
+ * 读数缓慢越过按下阈值的轻按也不会漏掉。
+ */
+
+#include "bsp_touchpad.h"
+#include "bsp_board.h"
+#include "bsp_state_manager.h"
+#include "bsp_touch_ws2812_display.h"
+#include "driver/touch_pad.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "BSP_TOUCHPAD";
+
+// ESP32-S3的触摸通道号与GPIO号相同（TOUCH1-14对应GPIO1-14）
+#define TOUCHPAD_CHANNEL                ((touch_pad_t)BSP_TOUCHPAD_PIN)
+
+#define TOUCHPAD_SETTLE_MS              50      // 启动测量后等待首个有效读数的时间
+#define TOUCHPAD_INTR_MASK              (TOUCH_PAD_INTR_MASK_ACTIVE | TOUCH_PAD_INTR_MASK_INACTIVE)
+
+// ========== 驱动状态结构 ==========
+
+typedef struct {
+    bsp_touchpad_config_t config;
+    bsp_touch_gesture_detector_t detector;  // 只在驱动任务中访问
+    bsp_touchpad_status_t status;           // 对外状态，受s_status_lock保护
+    bool is_initialized;
+    bool task_running;
+    TaskHandle_t task_handle;
+} bsp_touchpad_controller_t;
+
+// 全局驱动实例
+static bsp_touchpad_controller_t s_controller = {0};
+static portMUX_TYPE s_status_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// ========== 静态函数声明 ==========
+
+static void touchpad_isr(void *arg);
+static void touchpad_task(void *pvParameters);
+static void sync_interrupt_threshold(void);
+static void publish_gesture(bsp_touch_gesture_t gesture);
+static uint32_t get_time_ms(void);
+
+// ========== 核心接口实现 ==========
+
+esp_err_t bsp_touchpad_init(const bsp_touchpad_config_t *config) {
+    ESP_LOGI(TAG, "初始化触摸按键 (GPIO%d)", BSP_TOUCHPAD_PIN);
+
+    if (s_controller.is_initialized) {
+        ESP_LOGW(TAG, "触摸按键已初始化");
+        return ESP_OK;
+    }
+
+    s_controller.config = (config != NULL) ? *config : bsp_touchpad_get_default_config();
+    if (s_controller.config.sample_interval_ms == 0) {
+        s_controller.config.sample_interval_ms = 1;
+    }
+    bsp_touch_gesture_init(&s_controller.detector, &s_controller.config.gesture);
+    memset(&s_controller.status, 0, sizeof(s_controller.status));
+
+    esp_err_t ret = touch_pad_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "触摸外设初始化失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ret = touch_pad_config(TOUCHPAD_CHANNEL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "配置触摸通道失败: %s", esp_err_to_name(ret));
+        touch_pad_deinit();
+        return ret;
+    }
+
+    // 硬件滤波：平滑值用于阈值比较和软件采样，基准值跟随环境缓慢变化
+    touch_filter_config_t filter_info = {
+        .mode = TOUCH_PAD_FILTER_IIR_16,
+        .debounce_cnt = 1,
+        .noise_thr = 0,
+        .jitter_step = 4,
+        .smh_lvl = TOUCH_PAD_SMOOTH_IIR_2,
+    };
+    touch_pad_filter_set_config(&filter_info);
+    touch_pad_filter_enable();
+
+    ret = touch_pad_isr_register(touchpad_isr, NULL, TOUCHPAD_INTR_MASK);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "注册触摸中断失败: %s", esp_err_to_name(ret));
+        touch_pad_deinit();
+        return ret;
+    }
+
+    touch_pad_set_fsm_mode(TOUCH_FSM_MODE_TIMER);
+    touch_pad_fsm_start();
+
+    s_controller.is_initialized = true;
+    ESP_LOGI(TAG, "触摸按键初始化完成");
+    ESP_LOGI(TAG, "  按下/松开/唤醒阈值: 基线+%d%% / +%d%% / +%d%%", s_controller.detector.config.touch_percent,
+             s_controller.detector.config.release_percent, s_controller.detector.config.wake_percent);
+    ESP_LOGI(TAG, "  长按: %lu ms, 双击窗口: %lu ms", (unsigned long)s_controller.config.gesture.long_press_ms,
+             (unsigned long)s_controller.config.gesture.double_tap_ms);
+    return ESP_OK;
+}
+
+esp_err_t bsp_touchpad_start(void) {
+    if (!s_controller.is_initialized) {
+        ESP_LOGE(TAG, "触摸按键未初始化");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (s_controller.task_running) {
+        ESP_LOGW(TAG, "触摸按键任务已在运行");
+        return ESP_OK;
+    }
+
+    s_controller.task_running = true;
+    BaseType_t ret = xTaskCreate(
+        touchpad_task,
+        "bsp_touchpad",
+        3072,
+        NULL,
+        5,  // 略高于显示任务，保证采样时序
+        &s_controller.task_handle
+    );
+
+    if (ret != pdPASS) {
+        s_controller.task_running = false;
+        ESP_LOGE(TAG, "创建触摸按键任务失败");
+        return ESP_ERR_NO_MEM;
+    }
+
+    portENTER_CRITICAL(&s_status_lock);
+    s_controller.status.is_running = true;
+    portEXIT_CRITICAL(&s_status_lock);
+
+    ESP_LOGI(TAG, "触摸按键任务已启动");
+    return ESP_OK;
+}
+
+void bsp_touchpad_stop(void) {
+    if (!s_controller.task_running) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "停止触摸按键");
+    touch_pad_intr_disable(TOUCHPAD_INTR_MASK);
+
+    s_controller.task_running = false;
+    if (s_controller.task_handle != NULL) {
+        vTaskDelete(s_controller.task_handle);
+        s_controller.task_handle = NULL;
+    }
+
+    portENTER_CRITICAL(&s_status_lock);
+    s_controller.status.is_running = false;
+    portEXIT_CRITICAL(&s_status_lock);
+}
+
+esp_err_t bsp_touchpad_get_status(bsp_touchpad_status_t *status) {
+    if (status == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!s_controller.is_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    portENTER_CRITICAL(&s_status_lock);
+    *status = s_controller.status;
+    portEXIT_CRITICAL(&s_status_lock);
+    return ESP_OK;
+}
+
+void bsp_touchpad_print_status(void) {
+    bsp_touchpad_status_t status;
+    if (bsp_touchpad_get_status(&status) != ESP_OK) {
+        ESP_LOGE(TAG, "获取触摸按键状态失败");
+        return;
+    }
+
+    ESP_LOGI(TAG, "========== 触摸按键状态 ==========");
+    ESP_LOGI(TAG, "任务运行: %s", status.is_running ? "是" : "否");
+    ESP_LOGI(TAG, "当前按下: %s", status.touched ? "是" : "否");
+    ESP_LOGI(TAG, "基线/最近读数: %lu / %lu", (unsigned long)status.baseline, (unsigned long)status.last_raw);
+    ESP_LOGI(TAG, "硬件中断阈值: +%lu", (unsigned long)status.interrupt_threshold);
+    ESP_LOGI(TAG, "中断: %lu 次, 采样: %lu 次", (unsigned long)status.interrupts, (unsigned long)status.samples);
+    ESP_LOGI(TAG, "手势: 单击 %lu, 双击 %lu, 长按 %lu",
+             (unsigned long)status.gesture_counts[BSP_TOUCH_GESTURE_TAP],
+             (unsigned long)status.gesture_counts[BSP_TOUCH_GESTURE_DOUBLE_TAP],
+             (unsigned long)status.gesture_counts[BSP_TOUCH_GESTURE_LONG_PRESS]);
+    ESP_LOGI(TAG, "最近手势: %s", bsp_touch_gesture_get_name(status.last_gesture));
+    ESP_LOGI(TAG, "==================================");
+}
+
+// ========== 配置接口实现 ==========
+
+bsp_touchpad_config_t bsp_touchpad_get_default_config(void) {
+    bsp_touchpad_config_t config = {
+        .gesture = bsp_touch_gesture_get_default_config(),
+        .sample_interval_ms = 20,
+        .baseline_interval_ms = 10000,
+    };
+    return config;
+}
+
+// ========== 静态函数实现 ==========
+
+// 中断上下文：读取并清除中断状态，把中断类型转交给驱动任务
+static void IRAM_ATTR touchpad_isr(void *arg) {
+    uint32_t intr_mask = touch_pad_read_intr_status_mask();
+    TaskHandle_t task = s_controller.task_handle;
+    if (task == NULL) {
+        return;
+    }
+
+    BaseType_t higher_priority_woken = pdFALSE;
+    xTaskNotifyFromISR(task, intr_mask, eSetBits, &higher_priority_woken);
+    portYIELD_FROM_ISR(higher_priority_woken);
+}
+
+static void touchpad_task(void *pvParameters) {
+    ESP_LOGI(TAG, "触摸按键任务开始运行");
+
+    // 等待首个有效读数后建立基线，再打开中断
+    vTaskDelay(pdMS_TO_TICKS(TOUCHPAD_SETTLE_MS));
+    uint32_t raw = 0;
+    if (touch_pad_read_smooth(TOUCHPAD_CHANNEL, &raw) == ESP_OK) {
+        bsp_touch_gesture_feed(&s_controller.detector, raw, get_time_ms());
+    }
+    sync_interrupt_threshold();
+    touch_pad_intr_enable(TOUCHPAD_INTR_MASK);
+
+    while (s_controller.task_running) {
+        // 识别手势期间周期采样；空闲时阻塞等待触摸中断，只按基线刷新间隔超时
+        bool active = bsp_touch_gesture_is_active(&s_controller.detector);
+        uint32_t wait_ms = active ? s_controller.config.sample_interval_ms : s_controller.config.baseline_interval_ms;
+        TickType_t wait_ticks = (wait_ms == 0) ? portMAX_DELAY : pdMS_TO_TICKS(wait_ms);
+        if (wait_ticks == 0) {
+            wait_ticks = 1;
+        }
+
+        uint32_t intr_mask = 0;
+        bool by_interrupt = (xTaskNotifyWait(0, UINT32_MAX, &intr_mask, wait_ticks) == pdTRUE);
+
+        // ACTIVE中断后保持采样，直到INACTIVE中断或读数回落到唤醒阈值以下
+        if (by_interrupt && (intr_mask & TOUCH_PAD_INTR_MASK_ACTIVE)) {
+            bsp_touch_gesture_notify_wake(&s_controller.detector, true);
+        } else if (by_interrupt && (intr_mask & TOUCH_PAD_INTR_MASK_INACTIVE)) {
+            bsp_touch_gesture_notify_wake(&s_controller.detector, false);
+        }
+
+        if (touch_pad_read_smooth(TOUCHPAD_CHANNEL, &raw) != ESP_OK) {
+            continue;
+        }
+        bsp_touch_gesture_t gesture = bsp_touch_gesture_feed(&s_controller.detector, raw, get_time_ms());
+
+        portENTER_CRITICAL(&s_status_lock);
+        if (by_interrupt) {
+            s_controller.status.interrupts++;
+        }
+        s_controller.status.samples++;
+        s_controller.status.last_raw = raw;
+        s_controller.status.touched = s_controller.detector.touched;
+        s_controller.status.baseline = s_controller.detector.baseline;
+        if (gesture != BSP_TOUCH_GESTURE_NONE) {
+            s_controller.status.gesture_counts[gesture]++;
+            s_controller.status.last_gesture = gesture;
+        }
+        portEXIT_CRITICAL(&s_status_lock);
+
+        if (gesture != BSP_TOUCH_GESTURE_NONE) {
+            publish_gesture(gesture);
+        }
+
+        // 空闲时基线可能已变化，按新基线更新硬件中断阈值
+        if (!bsp_touch_gesture_is_active(&s_controller.detector)) {
+            sync_interrupt_threshold();
+        }
+    }
+
+    ESP_LOGI(TAG, "触摸按键任务结束");
+    vTaskDelete(NULL);
+}
+
+static void sync_interrupt_threshold(void) {
+    uint32_t threshold = bsp_touch_gesture_get_wake_delta(&s_controller.detector);
+    if (threshold == 0 || threshold == s_controller.status.interrupt_threshold) {
+        return;
+    }
+
+    if (touch_pad_set_thresh(TOUCHPAD_CHANNEL, threshold) != ESP_OK) {
+        ESP_LOGW(TAG, "设置触摸中断阈值失败: %lu", (unsigned long)threshold);
+        return;
+    }
+
+    portENTER_CRITICAL(&s_status_lock);
+    s_controller.status.interrupt_threshold = threshold;
+    portEXIT_CRITICAL(&s_status_lock);
+}
+
+static void publish_gesture(bsp_touch_gesture_t gesture) {
+    ESP_LOGI(TAG, "识别到触摸手势: %s", bsp_touch_gesture_get_name(gesture));
+    bsp_state_manager_report_touch_gesture(gesture);
+    bsp_touch_ws2812_display_show_gesture(gesture);
+}
+
+static uint32_t get_time_ms(void) {
+    return esp_timer_get_time() / 1000;
+}
@@ -1,22 +1,29 @@
 #include "bsp_ws2812.h"
+#include "bsp_led_hub.h"
+#include "bsp_led_rmt.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
 static const char *TAG = "BSP_WS2812";
 
-// WS2812全局句柄数组
-static led_strip_handle_t ws2812_handles[BSP_WS2812_MAX] = {NULL};
-
 // WS2812配置信息
 typedef struct {
     uint8_t gpio_num;
     uint32_t max_leds;
+    bsp_led_device_id_t device_id;
+    const char *name;
 } ws2812_config_t;
 
 static const ws2812_config_t ws2812_configs[BSP_WS2812_MAX] = {
-    [BSP_WS2812_ONBOARD] = {BSP_WS2812_ONBOARD_PIN, BSP_WS2812_ONBOARD_COUNT},
-    [BSP_WS2812_TOUCH]   = {BSP_WS2812_Touch_LED_PIN, BSP_WS2812_Touch_LED_COUNT},
+    [BSP_WS2812_ONBOARD] = {BSP_WS2812_ONBOARD_PIN, BSP_WS2812_ONBOARD_COUNT, BSP_LED_DEVICE_ONBOARD, "onboard"},
+    [BSP_WS2812_TOUCH]   = {BSP_WS2812_Touch_LED_PIN, BSP_WS2812_Touch_LED_COUNT, BSP_LED_DEVICE_TOUCH, "touch"},
+};
+
+// RMT后端上下文，灯带句柄由LED设备层打开和重建
+static bsp_led_rmt_ctx_t ws2812_rmt_ctx[BSP_WS2812_MAX] = {
+    [BSP_WS2812_ONBOARD] = {.gpio_num = BSP_WS2812_ONBOARD_PIN},
+    [BSP_WS2812_TOUCH]   = {.gpio_num = BSP_WS2812_Touch_LED_PIN},
 };
 
 esp_err_t bsp_ws2812_init(bsp_ws2812_type_t type)
@@ -26,31 +33,21 @@ esp_err_t bsp_ws2812_init(bsp_ws2812_type_t type)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (ws2812_handles[type] != NULL) {
+    if (bsp_led_hub_is_registered(ws2812_configs[type].device_id)) {
         ESP_LOGW(TAG, "WS2812 type %d already initialized", type);
         return ESP_OK;
     }
 
-    led_strip_config_t strip_config = {
-        .strip_gpio_num = ws2812_configs[type].gpio_num,
-        .max_leds = ws2812_configs[type].max_leds,
-        .led_model = LED_MODEL_WS2812,
-    };
-    
-    led_strip_rmt_config_t rmt_config = {
-        .clk_src = RMT_CLK_SRC_DEFAULT,
-        .resolution_hz = 10 * 1000 * 1000,
-    };
-    
-    esp_err_t ret = led_strip_new_rmt_device(&strip_config, &rmt_config, &ws2812_handles[type]);
+    bsp_led_device_config_t config = bsp_led_device_get_default_config(
+        ws2812_configs[type].name, ws2812_configs[type].max_leds);
+
+    esp_err_t ret = bsp_led_hub_register(ws2812_configs[type].device_id, &config,
+                                         &BSP_LED_RMT_BACKEND, &ws2812_rmt_ctx[type]);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "WS2812 type %d init failed: %s", type, esp_err_to_name(ret));
         return ret;
     }
 
-    // 初始化后清除所有LED
-    led_strip_clear(ws2812_handles[type]);
-    
     ESP_LOGI(TAG, "WS2812 type %d initialized successfully (GPIO:%d, LEDs:%ld)", 
              type, ws2812_configs[type].gpio_num, ws2812_configs[type].max_leds);
     
@@ -79,14 +76,13 @@ esp_err_t bsp_ws2812_deinit(bsp_ws2812_type_t type)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (ws2812_handles[type] == NULL) {
+    if (!bsp_led_hub_is_registered(ws2812_configs[type].device_id)) {
         ESP_LOGW(TAG, "WS2812 type %d not initialized", type);
         return ESP_OK;
     }
 
-    esp_err_t ret = led_strip_del(ws2812_handles[type]);
+    esp_err_t ret = bsp_led_hub_unregister(ws2812_configs[type].device_id);
     if (ret == ESP_OK) {
-        ws2812_handles[type] = NULL;
         ESP_LOGI(TAG, "WS2812 type %d deinitialized", type);
     } else {
         ESP_LOGE(TAG, "Failed to deinitialize WS2812 type %d: %s", type, esp_err_to_name(ret));
@@ -116,7 +112,7 @@ esp_err_t bsp_ws2812_set_pixel(bsp_ws2812_type_t type, uint32_t index, uint8_t r
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (ws2812_handles[type] == NULL) {
+    if (!bsp_led_hub_is_registered(ws2812_configs[type].device_id)) {
         ESP_LOGE(TAG, "WS2812 type %d not initialized", type);
         return ESP_ERR_INVALID_STATE;
     }
@@ -127,7 +123,8 @@ esp_err_t bsp_ws2812_set_pixel(bsp_ws2812_type_t type, uint32_t index, uint8_t r
         return ESP_ERR_INVALID_ARG;
     }
 
-    return led_strip_set_pixel(ws2812_handles[type], index, red, green, blue);
+    bsp_led_rgb_t color = {red, green, blue};
+    return bsp_led_hub_set_pixel(ws2812_configs[type].device_id, (uint16_t)index, color);
 }
 
 esp_err_t bsp_ws2812_refresh(bsp_ws2812_type_t type)
@@ -137,12 +134,12 @@ esp_err_t bsp_ws2812_refresh(bsp_ws2812_type_t type)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (ws2812_handles[type] == NULL) {
+    if (!bsp_led_hub_is_registered(ws2812_configs[type].device_id)) {
         ESP_LOGE(TAG, "WS2812 type %d not initialized", type);
         return ESP_ERR_INVALID_STATE;
     }
 
-    return led_strip_refresh(ws2812_handles[type]);
+    return bsp_led_hub_refresh(ws2812_configs[type].device_id);
 }
 
 esp_err_t bsp_ws2812_clear(bsp_ws2812_type_t type)
@@ -152,27 +149,26 @@ esp_err_t bsp_ws2812_clear(bsp_ws2812_type_t type)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (ws2812_handles[type] == NULL) {
+    if (!bsp_led_hub_is_registered(ws2812_configs[type].device_id)) {
         ESP_LOGE(TAG, "WS2812 type %d not initialized", type);
         return ESP_ERR_INVALID_STATE;
     }
 
-    return led_strip_clear(ws2812_handles[type]);
+    return bsp_led_hub_clear(ws2812_configs[type].device_id);
 }
 
-led_strip_handle_t bsp_ws2812_get_handle(bsp_ws2812_type_t type)
+bool bsp_ws2812_is_initialized(bsp_ws2812_type_t type)
 {
     if (type >= BSP_WS2812_MAX) {
-        ESP_LOGE(TAG, "Invalid WS2812 type: %d", type);
-        return NULL;
+        return false;
     }
 
-    return ws2812_handles[type];
+    return bsp_led_hub_is_registered(ws2812_configs[type].device_id);
 }
 
 void bsp_ws2812_onboard_test(void)
 {
-    if (ws2812_handles[BSP_WS2812_ONBOARD] == NULL) {
+    if (!bsp_led_hub_is_registered(BSP_LED_DEVICE_ONBOARD)) {
         ESP_LOGE(TAG, "Onboard WS2812 not initialized");
         return;
     }
@@ -193,7 +189,7 @@ void bsp_ws2812_onboard_test(void)
 
 void bsp_ws2812_touch_test(void)
 {
-    if (ws2812_handles[BSP_WS2812_TOUCH] == NULL) {
+    if (!bsp_led_hub_is_registered(BSP_LED_DEVICE_TOUCH)) {
         ESP_LOGE(TAG, "Touch WS2812 not initialized");
         return;
     }
@@ -0,0 +1,553 @@
+// 动画文件变化检测测试（主机运行）
+// 用模拟文件系统检查复制中途文件持续增长、只修改时间、防抖重新计时、
+// .anim文件出现、TF卡拔出/插回和读取失败重试，并确认防抖期间不读取文件内容。
+// 检测任务用pthread模拟，检查停止后立即重新启动、停止超时后拒绝启动。
+//
+// 编译运行:
+//   gcc -I components/led_matrix/include -o test_led_animation_watcher
+//       tests/test_led_animation_watcher.c components/led_matrix/src/led_file_watch.c -lpthread
+//   ./test_led_animation_watcher
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#include "led_file_watch.h"
+
+#define JSON_PATH           "/sdcard/matrix.json"
+#define ANIM_PATH           "/sdcard/matrix.anim"
+#define DEBOUNCE_MS         3000
+#define POLL_US             (2000 * 1000LL)    // 默认轮询间隔
+
+// 模拟文件
+typedef struct {
+    const char *path;
+    bool exists;
+    uint32_t size;
+    uint32_t mtime;
+    uint32_t crc;               // 文件内容的校验和
+    int fail_reads;             // 接下来需要失败的读取次数
+} fake_file_t;
+
+// 模拟文件系统
+typedef struct {
+    bool mounted;
+    fake_file_t files[2];
+    uint32_t checksum_calls;
+} fake_fs_t;
+
+static fake_fs_t s_fs;
+static led_file_watch_t s_watch;
+static int64_t s_now_us;
+
+static int check(bool cond, const char *name) {
+    printf("%s %s\n", cond ? "✓" : "✗", name);
+    return cond ? 0 : 1;
+}
+
+static fake_file_t *find_file(fake_fs_t *fs, const char *path) {
+    for (size_t i = 0; i < sizeof(fs->files) / sizeof(fs->files[0]); i++) {
+        if (strcmp(fs->files[i].path, path) == 0) {
+            return &fs->files[i];
+        }
+    }
+    return NULL;
+}
+
+static bool fake_is_mounted(void *ctx) {
+    return ((fake_fs_t *)ctx)->mounted;
+}
+
+static bool fake_stat(void *ctx, const char *path, uint32_t *size, uint32_t *mtime) {
+    fake_fs_t *fs = ctx;
+    fake_file_t *file = find_file(fs, path);
+    if (!fs->mounted || !file || !file->exists) {
+        return false;
+    }
+    *size = file->size;
+    *mtime = file->mtime;
+    return true;
+}
+
+static bool fake_checksum(void *ctx, const char *path, uint32_t *crc, uint32_t *bytes_read) {
+    fake_fs_t *fs = ctx;
+    fake_file_t *file = find_file(fs, path);
+    fs->checksum_calls++;
+    *bytes_read = 0;
+    if (!fs->mounted || !file || !file->exists) {
+        return false;
+    }
+    if (file->fail_reads > 0) {
+        file->fail_reads--;
+        return false;
+    }
+    *bytes_read = file->size;
+    *crc = file->crc;
+    return true;
+}
+
+// JSON存在、.anim不存在，记录基准
+static void setup(void) {
+    memset(&s_fs, 0, sizeof(s_fs));
+    s_fs.mounted = true;
+    s_fs.files[0] = (fake_file_t){JSON_PATH, true, 4096, 1000, 0x11111111, 0};
+    s_fs.files[1] = (fake_file_t){ANIM_PATH, false, 0, 0, 0, 0};
+
+    static const led_file_watch_fs_t fs = {
+        .is_mounted = fake_is_mounted,
+        .stat = fake_stat,
+        .checksum = fake_checksum,
+        .ctx = &s_fs,
+    };
+    const char *paths[] = {JSON_PATH, ANIM_PATH};
+    led_file_watch_init(&s_watch, paths, 2, DEBOUNCE_MS, &fs);
+    s_now_us = 0;
+    led_file_watch_baseline(&s_watch);
+    s_fs.checksum_calls = 0;
+}
+
+// 推进一个轮询间隔并轮询
+static led_file_watch_result_t poll(void) {
+    s_now_us += POLL_US;
+    return led_file_watch_poll(&s_watch, s_now_us);
+}
+
+// 连续轮询直到防抖结束，返回最后的结果并统计CHANGED次数
+static led_file_watch_result_t poll_until_settled(int max_polls, int *changed_count) {
+    led_file_watch_result_t result = LED_FILE_WATCH_IDLE;
+    for (int i = 0; i < max_polls; i++) {
+        result = poll();
+        if (result == LED_FILE_WATCH_CHANGED) {
+            (*changed_count)++;
+        }
+    }
+    return result;
+}
+
+static int test_init(void) {
+    int failures = 0;
+    led_file_watch_t watch;
+    static const led_file_watch_fs_t fs = {fake_is_mounted, fake_stat, fake_checksum, &s_fs};
+    static const led_file_watch_fs_t no_hooks = {0};
+    const char *paths[] = {JSON_PATH, ANIM_PATH, "/sdcard/extra"};
+    char long_path[LED_FILE_WATCH_PATH_MAX + 8];
+    memset(long_path, 'a', sizeof(long_path) - 1);
+    long_path[sizeof(long_path) - 1] = '\0';
+    const char *long_paths[] = {long_path};
+
+    failures += check(led_file_watch_init(&watch, paths, 2, DEBOUNCE_MS, &fs), "初始化两个文件");
+    failures += check(!led_file_watch_init(&watch, paths, 3, DEBOUNCE_MS, &fs), "文件过多时拒绝");
+    failures += check(!led_file_watch_init(&watch, long_paths, 1, DEBOUNCE_MS, &fs), "路径过长时拒绝");
+    failures += check(!led_file_watch_init(&watch, paths, 2, DEBOUNCE_MS, &no_hooks), "缺少钩子时拒绝");
+    return failures;
+}
+
+static int test_baseline(void) {
+    int failures = 0;
+    setup();
+
+    int changed = 0;
+    led_file_watch_result_t result = poll_until_settled(5, &changed);
+    failures += check(result == LED_FILE_WATCH_IDLE && changed == 0, "文件未变化时不报告");
+    failures += check(s_fs.checksum_calls == 0, "未变化时只stat不读取内容");
+    failures += check(s_watch.stats.polls == 5, "轮询次数统计");
+    return failures;
+}
+
+static int test_copy_in_progress(void) {
+    int failures = 0;
+    setup();
+
+    // 复制期间每次轮询文件都在变大
+    bool settled_early = false;
+    int changed = 0;
+    for (int i = 1; i <= 6; i++) {
+        s_fs.files[0].size = 4096 + i * 8192;
+        s_fs.files[0].mtime = 1000 + i;
+        led_file_watch_result_t result = poll();
+        settled_early |= (result != LED_FILE_WATCH_SETTLING);
+        changed += (result == LED_FILE_WATCH_CHANGED);
+    }
+    failures += check(!settled_early && changed == 0, "复制中途（文件持续增长）保持防抖，不重新加载");
+    failures += check(s_fs.checksum_calls == 0, "防抖期间不读取文件内容");
+    failures += check(s_watch.stats.changes_detected == 1 && s_watch.stats.debounced == 5,
+                      "首次变化计入changes_detected，后续计入debounced");
+
+    // 复制完成后保持不变，防抖结束后报告一次
+    s_fs.files[0].crc = 0x22222222;
+    led_file_watch_result_t result = poll();
+    failures += check(result == LED_FILE_WATCH_SETTLING, "停止增长后的第一次轮询仍在防抖");
+    result = poll();
+    failures += check(result == LED_FILE_WATCH_CHANGED, "防抖结束后报告内容变化");
+    failures += check(s_fs.checksum_calls == 1, "只对变化的文件计算一次校验和");
+
+    changed = 0;
+    result = poll_until_settled(5, &changed);
+    failures += check(result == LED_FILE_WATCH_IDLE && changed == 0, "报告后不重复触发");
+    failures += check(s_watch.stats.reloads_triggered == 1, "重新加载统计");
+    return failures;
+}
+
+static int test_touch_only(void) {
+    int failures = 0;
+    setup();
+
+    // 只修改时间（例如重新保存相同内容）
+    s_fs.files[0].mtime = 2000;
+    int changed = 0;
+    led_file_watch_result_t result = LED_FILE_WATCH_IDLE;
+    for (int i = 0; i < 4 && result != LED_FILE_WATCH_UNCHANGED; i++) {
+        result = poll();
+        changed += (result == LED_FILE_WATCH_CHANGED);
+    }
+    failures += check(result == LED_FILE_WATCH_UNCHANGED && changed == 0, "只修改时间时不重新加载");
+    failures += check(s_fs.checksum_calls == 1 && s_watch.stats.unchanged_content == 1,
+                      "计算校验和确认内容未变");
+
+    result = poll_until_settled(3, &changed);
+    failures += check(result == LED_FILE_WATCH_IDLE && s_fs.checksum_calls == 1,
+                      "新时间被确认，之后不再读取");
+    return failures;
+}
+
+static int test_debounce_restart(void) {
+    int failures = 0;
+    setup();
+
+    // 第一次修改
+    s_fs.files[0].mtime = 3000;
+    s_fs.files[0].crc = 0x33333333;
+    s_now_us = 0;
+    failures += check(led_file_watch_poll(&s_watch, s_now_us) == LED_FILE_WATCH_SETTLING, "修改后开始防抖");
+
+    // 防抖即将结束时再次修改，重新计时
+    s_now_us = (DEBOUNCE_MS - 1) * 1000LL;
+    s_fs.files[0].mtime = 3001;
+    s_fs.files[0].size = 5000;
+    failures += check(led_file_watch_poll(&s_watch, s_now_us) == LED_FILE_WATCH_SETTLING, "防抖期间再次修改");
+    int64_t second_change_us = s_now_us;
+
+    s_now_us = DEBOUNCE_MS * 1000LL + 1000;
+    failures += check(led_file_watch_poll(&s_watch, s_now_us) == LED_FILE_WATCH_SETTLING,
+                      "从第一次修改算已过防抖时间，但从第二次修改算未到");
+
+    s_now_us = second_change_us + DEBOUNCE_MS * 1000LL;
+    failures += check(led_file_watch_poll(&s_watch, s_now_us) == LED_FILE_WATCH_CHANGED,
+                      "从最后一次修改起满防抖时间后报告");
+    failures += check(s_watch.stats.debounced == 1, "防抖重新计时统计");
+    return failures;
+}
+
+static int test_anim_appears(void) {
+    int failures = 0;
+    setup();
+
+    // 编译工具在JSON旁生成.anim
+    s_fs.files[1] = (fake_file_t){ANIM_PATH, true, 1200, 4000, 0x44444444, 0};
+    int changed = 0;
+    led_file_watch_result_t result = poll_until_settled(4, &changed);
+    failures += check(changed == 1, ".anim出现时报告变化");
+    failures += check(result == LED_FILE_WATCH_IDLE, "报告后恢复空闲");
+    failures += check(s_fs.checksum_calls == 1, "只读取新出现的.anim");
+
+    // .anim被删除同样是变化
+    s_fs.files[1].exists = false;
+    changed = 0;
+    poll_until_settled(3, &changed);
+    failures += check(changed == 1, ".anim删除时报告变化");
+    return failures;
+}
+
+static int test_unmounted_card(void) {
+    int failures = 0;
+    setup();
+
+    // 拔出TF卡：文件都“消失”，但不应当作变化
+    s_fs.mounted = false;
+    int changed = 0;
+    led_file_watch_result_t result = poll_until_settled(5, &changed);
+    failures += check(result == LED_FILE_WATCH_IDLE && changed == 0, "TF卡拔出期间不报告变化");
+    failures += check(s_fs.checksum_calls == 0, "TF卡拔出期间不读取");
+
+    // 插回相同内容
+    s_fs.mounted = true;
+    result = poll_until_settled(3, &changed);
+    failures += check(result == LED_FILE_WATCH_IDLE && changed == 0, "插回相同文件不重新加载");
+
+    // 拔出期间在电脑上修改了文件
+    s_fs.mounted = false;
+    poll();
+    s_fs.files[0].size = 8192;
+    s_fs.files[0].mtime = 5000;
+    s_fs.files[0].crc = 0x55555555;
+    s_fs.mounted = true;
+    result = poll_until_settled(3, &changed);
+    failures += check(changed == 1, "插回修改过的文件时报告变化");
+
+    // 启动时TF卡未挂载：没有基准，挂载后看到的文件视为变化
+    setup();
+    s_fs.mounted = false;
+    const char *paths[] = {JSON_PATH, ANIM_PATH};
+    led_file_watch_fs_t fs = s_watch.fs;
+    led_file_watch_init(&s_watch, paths, 2, DEBOUNCE_MS, &fs);
+    led_file_watch_baseline(&s_watch);
+    s_fs.mounted = true;
+    changed = 0;
+    poll_until_settled(3, &changed);
+    failures += check(changed == 1, "启动时未挂载，挂载后加载文件");
+    return failures;
+}
+
+static int test_read_failure(void) {
+    int failures = 0;
+    setup();
+
+    s_fs.files[0].mtime = 6000;
+    s_fs.files[0].crc = 0x66666666;
+    s_fs.files[0].fail_reads = 1;
+
+    int changed = 0;
+    led_file_watch_result_t result = LED_FILE_WATCH_IDLE;
+    for (int i = 0; i < 3; i++) {
+        result = poll();
+        changed += (result == LED_FILE_WATCH_CHANGED);
+    }
+    failures += check(changed == 0 && result == LED_FILE_WATCH_SETTLING, "读取失败时不报告，继续防抖");
+
+    poll_until_settled(3, &changed);
+    failures += check(changed == 1, "重试读取成功后报告变化");
+    return failures;
+}
+
+// ========== 检测任务模拟 ==========
+
+// pthread实现的任务钩子
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool woken;
+    bool exited;
+    bool thread_valid;
+    pthread_t thread;
+    void (*entry)(void *arg);
+    void *arg;
+} host_task_t;
+
+// 轮询回调记录，block为true时回调阻塞（模拟检测任务卡在处理中）
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int polls;
+    bool block;
+} poll_log_t;
+
+static host_task_t s_task = {.lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER};
+static poll_log_t s_log = {.lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER};
+
+static struct timespec deadline_after(uint32_t timeout_ms) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout_ms / 1000;
+    ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+static void *host_trampoline(void *arg) {
+    host_task_t *task = arg;
+    task->entry(task->arg);
+    return NULL;
+}
+
+static bool host_spawn(void *ctx, void (*entry)(void *arg), void *arg) {
+    host_task_t *task = ctx;
+    task->woken = false;
+    task->exited = false;
+    task->entry = entry;
+    task->arg = arg;
+    task->thread_valid = (pthread_create(&task->thread, NULL, host_trampoline, task) == 0);
+    return task->thread_valid;
+}
+
+static bool host_wait(void *ctx, uint32_t timeout_ms) {
+    host_task_t *task = ctx;
+    struct timespec deadline = deadline_after(timeout_ms);
+    int rc = 0;
+    pthread_mutex_lock(&task->lock);
+    while (!task->woken && rc != ETIMEDOUT) {
+        rc = pthread_cond_timedwait(&task->cond, &task->lock, &deadline);
+    }
+    bool woken = task->woken;
+    task->woken = false;
+    pthread_mutex_unlock(&task->lock);
+    return woken;
+}
+
+static void host_wake(void *ctx) {
+    host_task_t *task = ctx;
+    pthread_mutex_lock(&task->lock);
+    task->woken = true;
+    pthread_cond_broadcast(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+}
+
+static void host_exited(void *ctx) {
+    host_task_t *task = ctx;
+    pthread_mutex_lock(&task->lock);
+    task->exited = true;
+    pthread_cond_broadcast(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+}
+
+static bool host_join(void *ctx, uint32_t timeout_ms) {
+    host_task_t *task = ctx;
+    struct timespec deadline = deadline_after(timeout_ms);
+    int rc = 0;
+    pthread_mutex_lock(&task->lock);
+    while (!task->exited && rc != ETIMEDOUT) {
+        rc = pthread_cond_timedwait(&task->cond, &task->lock, &deadline);
+    }
+    bool exited = task->exited;
+    pthread_mutex_unlock(&task->lock);
+    if (exited && task->thread_valid) {
+        pthread_join(task->thread, NULL);
+        task->thread_valid = false;
+    }
+    return exited;
+}
+
+static int64_t host_now_us(void *ctx) {
+    (void)ctx;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+static const led_file_watch_task_ops_t HOST_TASK_OPS = {
+    .spawn = host_spawn,
+    .wait = host_wait,
+    .wake = host_wake,
+    .exited = host_exited,
+    .join = host_join,
+    .now_us = host_now_us,
+    .ctx = &s_task,
+};
+
+static void record_poll(led_file_watch_result_t result, void *user_ctx) {
+    (void)result;
+    poll_log_t *log = user_ctx;
+    pthread_mutex_lock(&log->lock);
+    log->polls++;
+    pthread_cond_broadcast(&log->cond);
+    while (log->block) {
+        pthread_cond_wait(&log->cond, &log->lock);
+    }
+    pthread_mutex_unlock(&log->lock);
+}
+
+// 等待回调次数达到target，超时返回false
+static bool wait_polls(int target, uint32_t timeout_ms) {
+    struct timespec deadline = deadline_after(timeout_ms);
+    int rc = 0;
+    pthread_mutex_lock(&s_log.lock);
+    while (s_log.polls < target && rc != ETIMEDOUT) {
+        rc = pthread_cond_timedwait(&s_log.cond, &s_log.lock, &deadline);
+    }
+    bool reached = s_log.polls >= target;
+    pthread_mutex_unlock(&s_log.lock);
+    return reached;
+}
+
+static int read_polls(void) {
+    pthread_mutex_lock(&s_log.lock);
+    int polls = s_log.polls;
+    pthread_mutex_unlock(&s_log.lock);
+    return polls;
+}
+
+static void set_block(bool block) {
+    pthread_mutex_lock(&s_log.lock);
+    s_log.block = block;
+    pthread_cond_broadcast(&s_log.cond);
+    pthread_mutex_unlock(&s_log.lock);
+}
+
+static int test_runner_restart(void) {
+    int failures = 0;
+    setup();
+    led_file_watch_runner_t runner = {0};
+    runner.watch = s_watch;
+    s_log.polls = 0;
+
+    failures += check(led_file_watch_runner_start(&runner, &HOST_TASK_OPS, 5, record_poll, &s_log),
+                      "启动检测任务");
+    failures += check(wait_polls(3, 1000), "检测任务按间隔轮询");
+
+    // 切换显示模式时停止后立即启动
+    failures += check(led_file_watch_runner_stop(&runner, 1000), "停止时等待任务确认退出");
+    failures += check(!runner.alive && !runner.running, "停止后运行器空闲");
+    int polls_after_stop = read_polls();
+    failures += check(led_file_watch_runner_start(&runner, &HOST_TASK_OPS, 5, record_poll, &s_log),
+                      "停止后立即重新启动成功");
+    failures += check(wait_polls(polls_after_stop + 3, 1000), "重新启动后继续轮询");
+    failures += check(led_file_watch_runner_start(&runner, &HOST_TASK_OPS, 5, record_poll, &s_log) == false,
+                      "任务运行中拒绝重复启动");
+
+    // 轮询间隔很长时停止请求也会立即唤醒任务
+    failures += check(led_file_watch_runner_stop(&runner, 1000), "停止");
+    failures += check(led_file_watch_runner_start(&runner, &HOST_TASK_OPS, 60 * 1000, record_poll, &s_log),
+                      "以长轮询间隔启动");
+    int64_t stop_start_us = host_now_us(NULL);
+    failures += check(led_file_watch_runner_stop(&runner, 1000) &&
+                      host_now_us(NULL) - stop_start_us < 500 * 1000LL,
+                      "停止请求唤醒等待中的任务");
+    failures += check(led_file_watch_runner_stop(&runner, 1000), "没有任务时停止直接成功");
+    return failures;
+}
+
+static int test_runner_stop_timeout(void) {
+    int failures = 0;
+    setup();
+    led_file_watch_runner_t runner = {0};
+    runner.watch = s_watch;
+    s_log.polls = 0;
+
+    // 回调阻塞，任务无法在超时内退出
+    set_block(true);
+    failures += check(led_file_watch_runner_start(&runner, &HOST_TASK_OPS, 5, record_poll, &s_log),
+                      "启动检测任务");
+    failures += check(wait_polls(1, 1000), "任务阻塞在回调中");
+    failures += check(!led_file_watch_runner_stop(&runner, 20), "等待退出超时返回失败");
+    failures += check(runner.alive, "超时后任务仍视为存活");
+    failures += check(!led_file_watch_runner_start(&runner, &HOST_TASK_OPS, 5, record_poll, &s_log),
+                      "旧任务未退出时拒绝启动");
+
+    // 回调返回后任务退出，再次停止成功
+    set_block(false);
+    failures += check(led_file_watch_runner_stop(&runner, 1000), "任务退出后再次停止成功");
+    failures += check(led_file_watch_runner_start(&runner, &HOST_TASK_OPS, 5, record_poll, &s_log),
+                      "之后可以重新启动");
+    failures += check(led_file_watch_runner_stop(&runner, 1000), "停止");
+    return failures;
+}
+
+int main(void) {
+    printf("========== 动画文件变化检测测试 ==========\n");
+    int failures = 0;
+    failures += test_init();
+    failures += test_baseline();
+    failures += test_copy_in_progress();
+    failures += test_touch_only();
+    failures += test_debounce_restart();
+    failures += test_anim_appears();
+    failures += test_unmounted_card();
+    failures += test_read_failure();
+    failures += test_runner_restart();
+    failures += test_runner_stop_timeout();
+    printf("========== %s (%d 项失败) ==========\n", failures == 0 ? "通过" : "失败", failures);
+    return failures == 0 ? 0 : 1;
+}
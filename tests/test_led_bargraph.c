@@ -0,0 +1,205 @@
+// 灯带条形图渲染器测试（主机运行）
+// 检查短刷新间隔下平滑能稳定到静止、峰值标记的停留和回落时间、无效数值的显示，
+// 以及分段以外的LED保持不变。
+//
+// 编译运行:
+//   gcc -I components/rm01_esp32s3_bsp/include -o test_led_bargraph
+//       tests/test_led_bargraph.c components/rm01_esp32s3_bsp/src/bsp_led_bargraph.c
+//       components/rm01_esp32s3_bsp/src/bsp_led_effect.c -lm
+//   ./test_led_bargraph
+
+#include <stdio.h>
+#include <string.h>
+#include "bsp_led_bargraph.h"
+
+#define PIXEL_COUNT         12
+#define SEGMENT_FIRST       2
+#define SEGMENT_LEDS        8
+#define LEVEL_ONE           256
+#define MAX_RUN_MS          20000   // 稳定所需时间的上限（平滑+峰值停留+回落）
+
+static const bsp_led_rgb_t LOW_COLOR = {0, 255, 0};
+static const bsp_led_rgb_t HIGH_COLOR = {255, 0, 0};
+static const bsp_led_rgb_t PEAK = {255, 255, 255};
+static const bsp_led_rgb_t BLACK = {0, 0, 0};
+static const bsp_led_rgb_t MARKER = {1, 2, 3};     // 分段以外的LED
+
+static bsp_led_bargraph_t s_bar;
+static bsp_led_rgb_t s_pixels[PIXEL_COUNT];
+static uint32_t s_now_ms;
+
+static int check(bool cond, const char *name) {
+    printf("%s %s\n", cond ? "✓" : "✗", name);
+    return cond ? 0 : 1;
+}
+
+static bool rgb_equal(bsp_led_rgb_t a, bsp_led_rgb_t b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+// 一个分段：LED 2..9，数值0..100
+static void setup(uint32_t frame_interval_ms) {
+    bsp_led_bar_segment_config_t config = {
+        .first_led = SEGMENT_FIRST,
+        .led_count = SEGMENT_LEDS,
+        .reverse = false,
+        .min_value = 0,
+        .max_value = 100,
+        .low_color = LOW_COLOR,
+        .high_color = HIGH_COLOR,
+    };
+    bsp_led_bargraph_init(&s_bar, frame_interval_ms);
+    bsp_led_bargraph_configure(&s_bar, &config, 1);
+    for (int i = 0; i < PIXEL_COUNT; i++) {
+        s_pixels[i] = MARKER;
+    }
+    s_now_ms = 1000;
+}
+
+static uint32_t render(void) {
+    return bsp_led_bargraph_render(&s_bar, s_now_ms, s_pixels, PIXEL_COUNT);
+}
+
+// 按渲染器要求的间隔刷新直到画面静止，返回所用时间，超时返回-1
+static int32_t run_until_static(void) {
+    uint32_t start_ms = s_now_ms;
+    uint32_t next_ms = render();
+    while (next_ms != BSP_LED_EFFECT_STATIC) {
+        if (s_now_ms - start_ms > MAX_RUN_MS) {
+            return -1;
+        }
+        s_now_ms += next_ms;
+        next_ms = render();
+    }
+    return (int32_t)(s_now_ms - start_ms);
+}
+
+static int test_configure(void) {
+    int failures = 0;
+    bsp_led_bargraph_t bar;
+    bsp_led_bargraph_init(&bar, 10);
+    bsp_led_bar_segment_config_t config = {0, 4, false, 0, 100, LOW_COLOR, HIGH_COLOR};
+    bsp_led_bar_segment_config_t empty = {0, 0, false, 0, 100, LOW_COLOR, HIGH_COLOR};
+    bsp_led_bar_segment_config_t flat = {0, 4, false, 50, 50, LOW_COLOR, HIGH_COLOR};
+
+    failures += check(bsp_led_bargraph_configure(&bar, &config, 1), "有效分段");
+    failures += check(!bsp_led_bargraph_configure(&bar, &empty, 1), "LED数量为0时拒绝");
+    failures += check(!bsp_led_bargraph_configure(&bar, &flat, 1), "数值范围为空时拒绝");
+    failures += check(!bsp_led_bargraph_configure(&bar, &config, BSP_LED_BAR_MAX_SEGMENTS + 1), "分段过多时拒绝");
+    return failures;
+}
+
+static int test_settle_short_interval(void) {
+    int failures = 0;
+    static const uint32_t intervals[] = {5, 10, 16, 33};
+
+    for (size_t i = 0; i < sizeof(intervals) / sizeof(intervals[0]); i++) {
+        char name[96];
+
+        // 上升到满条：峰值跟随显示长度，到位后静止
+        setup(intervals[i]);
+        bsp_led_bargraph_set_value(&s_bar, 0, 100, true);
+        int32_t elapsed = run_until_static();
+        snprintf(name, sizeof(name), "%lu ms刷新间隔下上升后稳定为静止", (unsigned long)intervals[i]);
+        failures += check(elapsed >= 0 && s_bar.segments[0].level_q8 == SEGMENT_LEDS * LEVEL_ONE, name);
+
+        // 小幅变化（剩余距离很小，截断取整时每帧移动0）
+        bsp_led_bargraph_set_value(&s_bar, 0, 97, true);
+        int32_t target = s_bar.segments[0].target_q8;
+        elapsed = run_until_static();
+        snprintf(name, sizeof(name), "%lu ms刷新间隔下小幅回落后稳定为静止", (unsigned long)intervals[i]);
+        failures += check(elapsed >= 0 && s_bar.segments[0].level_q8 == target, name);
+    }
+    return failures;
+}
+
+static int test_peak_hold_decay(void) {
+    int failures = 0;
+    setup(10);
+
+    bsp_led_bargraph_set_value(&s_bar, 0, 100, true);
+    run_until_static();
+    failures += check(rgb_equal(s_pixels[SEGMENT_FIRST + SEGMENT_LEDS - 1], HIGH_COLOR), "满条时末端为高端颜色");
+
+    // 数值降到一半：显示长度逼近4颗LED，峰值标记留在最高点
+    bsp_led_bargraph_set_value(&s_bar, 0, 50, true);
+    uint32_t drop_ms = s_now_ms;
+    uint32_t next_ms = render();
+    uint32_t peak_time_ms = s_bar.segments[0].peak_time_ms;
+    while (s_bar.segments[0].level_q8 != s_bar.segments[0].target_q8 && next_ms == 10 &&
+           s_now_ms - drop_ms < BSP_LED_BAR_PEAK_HOLD_MS) {
+        s_now_ms += next_ms;
+        next_ms = render();
+    }
+    failures += check(s_bar.segments[0].peak_time_ms == peak_time_ms, "回落期间峰值时间不再刷新");
+    failures += check(s_bar.segments[0].level_q8 == 4 * LEVEL_ONE, "显示长度到位");
+    failures += check(s_bar.segments[0].peak_q8 == SEGMENT_LEDS * LEVEL_ONE, "停留期间峰值不回落");
+    failures += check(rgb_equal(s_pixels[SEGMENT_FIRST + SEGMENT_LEDS - 1], PEAK), "峰值标记显示在最高LED");
+    failures += check(rgb_equal(s_pixels[SEGMENT_FIRST + 5], BLACK), "显示长度与峰值之间熄灭");
+
+    // 停留期间画面不变，下一次刷新在停留结束时
+    uint32_t hold_end_ms = peak_time_ms + BSP_LED_BAR_PEAK_HOLD_MS;
+    failures += check(next_ms == hold_end_ms - s_now_ms, "停留期间等待到停留结束");
+
+    // 停留结束后按BSP_LED_BAR_PEAK_DECAY_LEDS回落，0.5秒回落2颗LED
+    s_now_ms = hold_end_ms;
+    next_ms = render();
+    failures += check(next_ms == 10, "停留结束后逐帧回落");
+    while (s_now_ms < hold_end_ms + 500 && next_ms == 10) {
+        s_now_ms += next_ms;
+        next_ms = render();
+    }
+    int32_t expected = SEGMENT_LEDS * LEVEL_ONE - BSP_LED_BAR_PEAK_DECAY_LEDS * LEVEL_ONE / 2;
+    int32_t peak = s_bar.segments[0].peak_q8;
+    failures += check(peak >= expected - LEVEL_ONE / 8 && peak <= expected + LEVEL_ONE / 8, "回落速度符合配置");
+
+    // 回落到显示长度后静止
+    int32_t elapsed = run_until_static();
+    failures += check(elapsed >= 0 && s_bar.segments[0].peak_q8 == s_bar.segments[0].level_q8, "回落到显示长度后静止");
+    return failures;
+}
+
+static int test_invalid_segment(void) {
+    int failures = 0;
+    setup(10);
+
+    bsp_led_bargraph_set_value(&s_bar, 0, 100, true);
+    run_until_static();
+
+    // 数据失效：立即清空，只微亮起始LED
+    bsp_led_bargraph_set_value(&s_bar, 0, 100, false);
+    s_now_ms += 10;
+    uint32_t next_ms = render();
+    failures += check(next_ms == BSP_LED_EFFECT_STATIC, "无效数值时画面静止");
+    bsp_led_rgb_t first = s_pixels[SEGMENT_FIRST];
+    failures += check(!rgb_equal(first, BLACK) && first.g < LOW_COLOR.g / 8 && first.r == 0,
+                      "起始LED以低端颜色微亮");
+    bool rest_black = true;
+    for (int i = 1; i < SEGMENT_LEDS; i++) {
+        rest_black &= rgb_equal(s_pixels[SEGMENT_FIRST + i], BLACK);
+    }
+    failures += check(rest_black, "其余LED熄灭（包括峰值标记）");
+
+    bool outside_kept = rgb_equal(s_pixels[0], MARKER) && rgb_equal(s_pixels[1], MARKER) &&
+                        rgb_equal(s_pixels[SEGMENT_FIRST + SEGMENT_LEDS], MARKER) &&
+                        rgb_equal(s_pixels[PIXEL_COUNT - 1], MARKER);
+    failures += check(outside_kept, "分段以外的LED保持不变");
+
+    // 恢复有效后从空条重新增长
+    bsp_led_bargraph_set_value(&s_bar, 0, 100, true);
+    s_now_ms += 10;
+    failures += check(render() == 10 && s_bar.segments[0].level_q8 < SEGMENT_LEDS * LEVEL_ONE,
+                      "恢复有效后重新平滑增长");
+    return failures;
+}
+
+int main(void) {
+    printf("========== 灯带条形图渲染器测试 ==========\n");
+    int failures = 0;
+    failures += test_configure();
+    failures += test_settle_short_interval();
+    failures += test_peak_hold_decay();
+    failures += test_invalid_segment();
+    printf("========== %s (%d 项失败) ==========\n", failures == 0 ? "通过" : "失败", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+// LED设备抽象测试（主机运行）
+// 用模拟后端检查跳过未变化的帧、亮度上限、电流上限、写入失败重建、
+// 输出超时、故障状态下的非阻塞刷新、有界退避恢复和统计。
+//
+// 编译运行:
+//   gcc -I components/rm01_esp32s3_bsp/include -o test_led_device
+//       tests/test_led_device.c components/rm01_esp32s3_bsp/src/bsp_led_device.c
+//       components/rm01_esp32s3_bsp/src/bsp_led_mock.c components/rm01_esp32s3_bsp/src/bsp_led_effect.c
+//   ./test_led_device
+
+#include <stdio.h>
+#include "bsp_led_device.h"
+#include "bsp_led_mock.h"
+
+#define TEST_LED_COUNT      28      // 与板载灯带相同
+
+static bsp_led_mock_t s_mock;
+static bsp_led_device_t s_dev;
+static bsp_led_rgb_t s_pixels[TEST_LED_COUNT];
+static bsp_led_rgb_t s_output[TEST_LED_COUNT];
+static uint32_t s_now_ms;
+
+static int check(bool cond, const char *name) {
+    printf("%s %s\n", cond ? "✓" : "✗", name);
+    return cond ? 0 : 1;
+}
+
+static int setup(const bsp_led_device_config_t *config) {
+    bsp_led_mock_init(&s_mock);
+    s_now_ms = 1000;
+    bsp_led_device_config_t defaults = bsp_led_device_get_default_config("test", TEST_LED_COUNT);
+    return bsp_led_device_init(&s_dev, config ? config : &defaults, &BSP_LED_MOCK_BACKEND, &s_mock,
+                               s_pixels, s_output, s_now_ms);
+}
+
+static int test_dirty_skip(void) {
+    int failures = 0;
+    setup(NULL);
+    failures += check(s_mock.opens == 1 && s_dev.is_open, "初始化时打开后端");
+
+    bsp_led_device_fill(&s_dev, (bsp_led_rgb_t){10, 20, 30});
+    bsp_led_device_refresh(&s_dev, false, s_now_ms);
+    failures += check(s_mock.writes == 1 && s_mock.frame[27].b == 30, "修改后输出一帧");
+
+    // 写入相同颜色不算修改
+    bsp_led_device_set_pixel(&s_dev, 3, (bsp_led_rgb_t){10, 20, 30});
+    bsp_led_device_refresh(&s_dev, false, s_now_ms);
+    bsp_led_device_refresh(&s_dev, false, s_now_ms);
+    failures += check(s_mock.writes == 1 && s_dev.stats.skipped == 2, "未变化的帧跳过输出");
+
+    bsp_led_device_refresh(&s_dev, true, s_now_ms);
+    failures += check(s_mock.writes == 2, "强制刷新总是输出");
+
+    failures += check(!bsp_led_device_set_pixel(&s_dev, TEST_LED_COUNT, (bsp_led_rgb_t){1, 1, 1}),
+                      "越界像素被拒绝");
+    return failures;
+}
+
+static int test_brightness_limit(void) {
+    int failures = 0;
+    setup(NULL);
+    bsp_led_device_fill(&s_dev, (bsp_led_rgb_t){255, 128, 0});
+    bsp_led_device_set_max_brightness(&s_dev, 128);
+    bsp_led_device_refresh(&s_dev, false, s_now_ms);
+
+    bsp_led_rgb_t out = s_mock.frame[0];
+    failures += check(out.r == 128 && out.g <= 65 && out.g >= 63 && out.b == 0, "亮度上限按比例缩放输出");
+    failures += check(s_pixels[0].r == 255, "帧缓冲区保持原值");
+
+    // 只改上限也需要重新输出
+    bsp_led_device_set_max_brightness(&s_dev, 255);
+    bsp_led_device_refresh(&s_dev, false, s_now_ms);
+    failures += check(s_mock.writes == 2 && s_mock.frame[0].r == 255, "修改上限后重新输出");
+    return failures;
+}
+
+static int test_power_limit(void) {
+    int failures = 0;
+    bsp_led_device_config_t config = bsp_led_device_get_default_config("test", TEST_LED_COUNT);
+    config.power_limit_ma = 500;
+    setup(&config);
+
+    // 全白约 28 * 60mA = 1680mA
+    bsp_led_device_fill(&s_dev, (bsp_led_rgb_t){255, 255, 255});
+    bsp_led_device_refresh(&s_dev, false, s_now_ms);
+
+    uint32_t current_ua = bsp_led_device_estimate_current_ua(s_mock.frame, TEST_LED_COUNT);
+    failures += check(current_ua <= 500 * 1000, "全白输出被限制在电流上限内");
+    failures += check(current_ua >= 450 * 1000, "限流后尽量接近上限");
+    failures += check(s_mock.frame[0].r == s_mock.frame[0].g && s_mock.frame[0].g == s_mock.frame[0].b,
+                      "限流保持颜色比例");
+    failures += check(s_dev.stats.limited_frames == 1 && s_dev.stats.current_ma <= 500, "限流帧和估算电流统计");
+
+    // 低于上限的帧不受影响
+    bsp_led_device_fill(&s_dev, (bsp_led_rgb_t){0, 0, 20});
+    bsp_led_device_refresh(&s_dev, false, s_now_ms);
+    failures += check(s_mock.frame[5].b == 20 && s_dev.stats.limited_frames == 1, "低于上限不降低亮度");
+    return failures;
+}
+
+static int test_write_retry(void) {
+    int failures = 0;
+    setup(NULL);
+    bsp_led_device_fill(&s_dev, (bsp_led_rgb_t){1, 2, 3});
+
+    // 一次写入失败：立即重建后成功，不进入故障状态
+    s_mock.fail_writes = 1;
+    int ret = bsp_led_device_refresh(&s_dev, false, s_now_ms);
+    failures += check(ret == 0 && s_mock.writes == 1 && !s_dev.faulted, "写入失败后立即重建并重试成功");
+    failures += check(s_dev.stats.write_errors == 1 && s_dev.stats.reopens == 1 && s_mock.opens == 2,
+                      "写入错误和重建次数统计");
+
+    // 重试后仍失败：进入故障状态，帧保持待输出
+    bsp_led_device_set_pixel(&s_dev, 0, (bsp_led_rgb_t){9, 9, 9});
+    s_mock.fail_writes = 2;
+    ret = bsp_led_device_refresh(&s_dev, false, s_now_ms);
+    failures += check(ret == BSP_LED_MOCK_ERR_INJECTED && s_dev.faulted && s_dev.stats.failed_frames == 1,
+                      "超过重试次数进入故障状态");
+    failures += check(s_dev.dirty && !s_mock.is_open && s_dev.stats.faults == 1, "故障时关闭后端并保持待输出");
+
+    // 故障期间刷新立即返回，不访问后端
+    uint32_t opens = s_mock.opens;
+    bsp_led_device_set_pixel(&s_dev, 1, (bsp_led_rgb_t){8, 8, 8});
+    ret = bsp_led_device_refresh(&s_dev, false, s_now_ms + 1);
+    failures += check(ret == BSP_LED_DEVICE_ERR_FAULTED && s_mock.opens == opens && s_dev.stats.faulted_drops == 1,
+                      "故障期间刷新不阻塞也不访问后端");
+
+    // 到期前不恢复，到期后重建并补发最近一帧
+    failures += check(bsp_led_device_recovery_delay_ms(&s_dev, s_now_ms + 4) == 6, "距下一次恢复的时间");
+    ret = bsp_led_device_recover(&s_dev, s_now_ms + 10);
+    failures += check(ret == 0 && !s_dev.faulted && !s_dev.dirty, "到期后恢复成功");
+    failures += check(s_mock.frame[0].r == 9 && s_mock.frame[1].r == 8, "恢复后补发故障期间的最后一帧");
+    failures += check(s_dev.stats.recoveries == 1 && s_dev.stats.last_recovery_ms == 10,
+                      "恢复次数和恢复耗时统计");
+    failures += check(bsp_led_device_recovery_delay_ms(&s_dev, s_now_ms) == BSP_LED_DEVICE_NO_RECOVERY,
+                      "正常状态不需要恢复");
+    return failures;
+}
+
+static int test_backoff(void) {
+    int failures = 0;
+    setup(NULL);
+    bsp_led_device_fill(&s_dev, (bsp_led_rgb_t){5, 5, 5});
+    s_mock.fail_writes = 2;
+    bsp_led_device_refresh(&s_dev, false, s_now_ms);
+
+    // 后端持续不可用：重试间隔 10 -> 20 -> 40 ... 封顶2000ms
+    s_mock.fail_opens = 100;
+    uint32_t now = s_now_ms;
+    uint32_t expected = 10;
+    bool doubling_ok = true;
+    for (int i = 0; i < 12; i++) {
+        now += bsp_led_device_recovery_delay_ms(&s_dev, now);
+        bsp_led_device_recover(&s_dev, now);
+        expected = expected * 2 > 2000 ? 2000 : expected * 2;
+        if (s_dev.backoff_ms != expected) {
+            doubling_ok = false;
+        }
+    }
+    failures += check(doubling_ok && s_dev.backoff_ms == 2000, "恢复失败时间隔翻倍并封顶");
+    failures += check(s_dev.stats.recovery_failures == 12 && s_dev.faulted, "恢复失败次数统计");
+
+    // 后端恢复可用后下一次尝试成功
+    s_mock.fail_opens = 0;
+    now += bsp_led_device_recovery_delay_ms(&s_dev, now);
+    int ret = bsp_led_device_recover(&s_dev, now);
+    failures += check(ret == 0 && s_mock.frame[0].r == 5, "后端可用后恢复并补发");
+
+    // 再次故障从最小间隔重新开始
+    s_mock.fail_writes = 2;
+    bsp_led_device_set_pixel(&s_dev, 0, (bsp_led_rgb_t){6, 6, 6});
+    bsp_led_device_refresh(&s_dev, false, now);
+    failures += check(s_dev.backoff_ms == 10, "新的故障从最小间隔开始");
+    return failures;
+}
+
+static int test_write_timeout(void) {
+    int failures = 0;
+    setup(NULL);
+    uint32_t timeout_us = s_dev.config.write_timeout_us;
+    failures += check(timeout_us == TEST_LED_COUNT * BSP_LED_FRAME_US_PER_LED * 4 + 5000, "默认输出超时");
+
+    bsp_led_device_fill(&s_dev, (bsp_led_rgb_t){3, 3, 3});
+    bsp_led_device_refresh(&s_dev, false, s_now_ms);
+    failures += check(!bsp_led_device_record_write_time(&s_dev, timeout_us, s_now_ms), "正常耗时不算超时");
+    failures += check(bsp_led_device_record_write_time(&s_dev, timeout_us + 1, s_now_ms),
+                      "超过输出超时");
+    failures += check(s_dev.faulted && s_dev.dirty && s_dev.stats.timeouts == 1, "超时后进入故障状态并重发当前帧");
+
+    int ret = bsp_led_device_recover(&s_dev, s_now_ms + 10);
+    failures += check(ret == 0 && s_mock.opens == 2, "超时后重建后端");
+    return failures;
+}
+
+static int test_open_failure(void) {
+    int failures = 0;
+    bsp_led_mock_init(&s_mock);
+    s_mock.fail_opens = 1;
+    s_now_ms = 500;
+    bsp_led_device_config_t config = bsp_led_device_get_default_config("test", TEST_LED_COUNT);
+    int ret = bsp_led_device_init(&s_dev, &config, &BSP_LED_MOCK_BACKEND, &s_mock, s_pixels, s_output, s_now_ms);
+    failures += check(ret == BSP_LED_MOCK_ERR_INJECTED && !s_dev.is_open && s_dev.faulted,
+                      "打开失败时设备进入故障状态");
+    failures += check(bsp_led_device_recovery_delay_ms(&s_dev, s_now_ms) == 0, "打开失败后立即可以恢复");
+
+    bsp_led_device_fill(&s_dev, (bsp_led_rgb_t){7, 0, 0});
+    ret = bsp_led_device_refresh(&s_dev, false, s_now_ms);
+    failures += check(ret == BSP_LED_DEVICE_ERR_FAULTED, "恢复前刷新立即返回");
+    ret = bsp_led_device_recover(&s_dev, s_now_ms + 2);
+    failures += check(ret == 0 && s_dev.is_open && s_mock.frame[0].r == 7, "后台恢复后输出");
+
+    bsp_led_device_deinit(&s_dev);
+    failures += check(!s_dev.is_open && s_mock.closes == 1, "反初始化关闭后端");
+    return failures;
+}
+
+int main(void) {
+    printf("========== LED设备抽象测试 ==========\n");
+    int failures = test_dirty_skip() + test_brightness_limit() + test_power_limit() +
+                   test_write_retry() + test_backoff() + test_write_timeout() + test_open_failure();
+    printf("========== %s (%d 项失败) ==========\n", failures == 0 ? "通过" : "失败", failures);
+    return failures == 0 ? 0 : 1;
+}
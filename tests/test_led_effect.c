@@ -0,0 +1,255 @@
+// 状态灯整数效果引擎测试（主机运行）
+// 逐毫秒对比整数效果引擎与原先Touch/Board显示中的浮点实现，并检查闪烁、渐变、彩虹的关键点。
+//
+// 编译运行:
+//   gcc -I components/rm01_esp32s3_bsp/include -o test_led_effect
+//       tests/test_led_effect.c components/rm01_esp32s3_bsp/src/bsp_led_effect.c -lm
+//   ./test_led_effect
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bsp_led_effect.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define BREATH_MAX_ERROR    2       // 呼吸曲线允许的最大通道误差
+#define FRAME_INTERVAL_MS   33
+
+static const bsp_led_rgb_t TEST_COLORS[] = {
+    {255, 255, 255}, {243, 112, 34}, {128, 0, 128}, {255, 0, 0}, {1, 7, 200},
+};
+static const uint32_t TEST_PERIODS[] = {1000, 2000, 3000};
+static const bsp_led_rgb_t BLACK = {0, 0, 0};
+
+// 原Touch显示的呼吸实现（sinf，先算亮度再缩放）
+static bsp_led_rgb_t reference_touch_breath(bsp_led_rgb_t color, uint32_t elapsed, uint32_t period) {
+    float progress = (float)(elapsed % period) / period;
+    float brightness_factor = (sinf(progress * 2 * M_PI) + 1.0f) / 2.0f;
+    uint8_t brightness = (uint8_t)(brightness_factor * 255);
+    bsp_led_rgb_t out = {
+        (uint8_t)((color.r * brightness) / 255),
+        (uint8_t)((color.g * brightness) / 255),
+        (uint8_t)((color.b * brightness) / 255),
+    };
+    return out;
+}
+
+// 原Board显示的呼吸实现（sin，直接按系数缩放）
+static bsp_led_rgb_t reference_board_breath(bsp_led_rgb_t color, uint32_t elapsed, uint32_t period) {
+    float phase = (float)(elapsed % period) / period * 2.0f * M_PI;
+    float brightness_factor = (sin(phase) + 1.0f) / 2.0f;
+    bsp_led_rgb_t out = {
+        (uint8_t)(color.r * brightness_factor),
+        (uint8_t)(color.g * brightness_factor),
+        (uint8_t)(color.b * brightness_factor),
+    };
+    return out;
+}
+
+static int channel_error(bsp_led_rgb_t a, bsp_led_rgb_t b) {
+    int err = abs(a.r - b.r);
+    if (abs(a.g - b.g) > err) err = abs(a.g - b.g);
+    if (abs(a.b - b.b) > err) err = abs(a.b - b.b);
+    return err;
+}
+
+static int test_breath_curves(void) {
+    int failures = 0;
+
+    for (size_t c = 0; c < sizeof(TEST_COLORS) / sizeof(TEST_COLORS[0]); c++) {
+        for (size_t p = 0; p < sizeof(TEST_PERIODS) / sizeof(TEST_PERIODS[0]); p++) {
+            bsp_led_effect_t effect;
+            bsp_led_effect_init(&effect, FRAME_INTERVAL_MS);
+            bsp_led_effect_set(&effect, BSP_LED_EFFECT_BREATH, TEST_COLORS[c], BLACK, TEST_PERIODS[p], 1000);
+
+            int touch_max = 0, board_max = 0;
+            for (uint32_t t = 0; t < TEST_PERIODS[p] * 2; t++) {
+                bsp_led_rgb_t out;
+                uint32_t next = bsp_led_effect_render(&effect, 1000 + t, &out);
+                if (next != FRAME_INTERVAL_MS) {
+                    printf("✗ 呼吸刷新间隔: 期望 %d, 实际 %lu\n", FRAME_INTERVAL_MS, (unsigned long)next);
+                    failures++;
+                    break;
+                }
+                int touch_err = channel_error(out, reference_touch_breath(TEST_COLORS[c], t, TEST_PERIODS[p]));
+                int board_err = channel_error(out, reference_board_breath(TEST_COLORS[c], t, TEST_PERIODS[p]));
+                if (touch_err > touch_max) touch_max = touch_err;
+                if (board_err > board_max) board_max = board_err;
+            }
+
+            if (touch_max > BREATH_MAX_ERROR || board_max > BREATH_MAX_ERROR) {
+                printf("✗ 呼吸曲线: RGB(%d,%d,%d) 周期 %lu ms, 最大误差 Touch %d, Board %d\n",
+                       TEST_COLORS[c].r, TEST_COLORS[c].g, TEST_COLORS[c].b,
+                       (unsigned long)TEST_PERIODS[p], touch_max, board_max);
+                failures++;
+            }
+        }
+    }
+
+    // 正弦表整周误差
+    int sin_max = 0;
+    for (uint32_t phase = 0; phase < 65536; phase++) {
+        int expected = (int)lround(255.0 * sin(phase * 2.0 * M_PI / 65536.0));
+        int err = abs(bsp_led_effect_sin((uint16_t)phase) - expected);
+        if (err > sin_max) sin_max = err;
+    }
+    if (sin_max > 1) {
+        printf("✗ 正弦表: 最大误差 %d\n", sin_max);
+        failures++;
+    }
+
+    if (failures == 0) {
+        printf("✓ 呼吸曲线（与浮点实现误差不超过%d，正弦表误差不超过%d）\n", BREATH_MAX_ERROR, sin_max);
+    }
+    return failures;
+}
+
+static int test_scale8(void) {
+    int failures = 0;
+
+    // 与原先的 value * brightness / 255 完全一致
+    for (int v = 0; v < 256; v++) {
+        for (int l = 0; l < 256; l++) {
+            if (bsp_led_effect_scale8((uint8_t)v, (uint8_t)l) != (v * l) / 255) {
+                failures++;
+            }
+        }
+    }
+    if (failures == 0) {
+        printf("✓ Q8亮度缩放\n");
+    } else {
+        printf("✗ Q8亮度缩放: %d 项不一致\n", failures);
+    }
+    return failures;
+}
+
+static int test_blink(void) {
+    int failures = 0;
+    bsp_led_rgb_t blue = {0, 0, 255};
+
+    bsp_led_effect_t effect;
+    bsp_led_effect_init(&effect, FRAME_INTERVAL_MS);
+    bsp_led_effect_set(&effect, BSP_LED_EFFECT_BLINK, blue, BLACK, 500, 100);
+
+    const struct {
+        uint32_t now;
+        bool on;
+        uint32_t next;
+    } cases[] = {
+        {100, true, 500},
+        {599, true, 1},
+        {600, false, 500},
+        {1099, false, 1},
+        {1100, true, 500},
+        {1350, true, 250},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        bsp_led_rgb_t out;
+        uint32_t next = bsp_led_effect_render(&effect, cases[i].now, &out);
+        bool on = out.b == 255;
+        if (on != cases[i].on || next != cases[i].next) {
+            printf("✗ 闪烁: t=%lu 期望 %s/%lu, 实际 %s/%lu\n", (unsigned long)cases[i].now,
+                   cases[i].on ? "亮" : "灭", (unsigned long)cases[i].next,
+                   on ? "亮" : "灭", (unsigned long)next);
+            failures++;
+        }
+    }
+
+    // 参数相同时保持相位
+    if (bsp_led_effect_set(&effect, BSP_LED_EFFECT_BLINK, blue, BLACK, 500, 5000) ||
+        effect.start_ms != 100) {
+        printf("✗ 闪烁: 重复设置相同参数不应重新开始\n");
+        failures++;
+    }
+
+    if (failures == 0) {
+        printf("✓ 闪烁时序\n");
+    }
+    return failures;
+}
+
+static int test_fade_and_rainbow(void) {
+    int failures = 0;
+    bsp_led_rgb_t from = {0, 100, 255};
+    bsp_led_rgb_t to = {255, 100, 0};
+
+    bsp_led_effect_t effect;
+    bsp_led_effect_init(&effect, FRAME_INTERVAL_MS);
+    bsp_led_effect_set(&effect, BSP_LED_EFFECT_FADE, from, to, 1000, 0);
+
+    bsp_led_rgb_t out;
+    bsp_led_effect_render(&effect, 0, &out);
+    if (channel_error(out, from) != 0) {
+        printf("✗ 渐变起点: RGB(%d,%d,%d)\n", out.r, out.g, out.b);
+        failures++;
+    }
+    bsp_led_effect_render(&effect, 500, &out);
+    if (out.r != 127 || out.g != 100 || out.b != 128) {
+        printf("✗ 渐变中点: RGB(%d,%d,%d)\n", out.r, out.g, out.b);
+        failures++;
+    }
+    if (bsp_led_effect_render(&effect, 990, &out) != 10) {
+        printf("✗ 渐变末帧刷新间隔\n");
+        failures++;
+    }
+    if (bsp_led_effect_render(&effect, 1000, &out) != BSP_LED_EFFECT_STATIC || channel_error(out, to) != 0) {
+        printf("✗ 渐变终点: RGB(%d,%d,%d)\n", out.r, out.g, out.b);
+        failures++;
+    }
+
+    // 彩虹：三原色位于三等分点，且任意时刻三通道之和为255
+    bsp_led_effect_set(&effect, BSP_LED_EFFECT_RAINBOW, BLACK, BLACK, 3000, 0);
+    const bsp_led_rgb_t primaries[] = {{255, 0, 0}, {0, 255, 0}, {0, 0, 255}};
+    for (int i = 0; i < 3; i++) {
+        bsp_led_effect_render(&effect, (uint32_t)i * 1000, &out);
+        if (channel_error(out, primaries[i]) > 3) {
+            printf("✗ 彩虹: t=%d ms RGB(%d,%d,%d)\n", i * 1000, out.r, out.g, out.b);
+            failures++;
+        }
+    }
+    for (int hue = 0; hue < 256; hue++) {
+        bsp_led_rgb_t c = bsp_led_effect_hue((uint8_t)hue);
+        if (c.r + c.g + c.b != 255) {
+            printf("✗ 色相 %d: RGB(%d,%d,%d)\n", hue, c.r, c.g, c.b);
+            failures++;
+        }
+    }
+
+    // 脉冲：峰值与呼吸一致，其余时刻不亮于呼吸
+    bsp_led_rgb_t white = {255, 255, 255};
+    bsp_led_effect_t breath;
+    bsp_led_effect_init(&breath, FRAME_INTERVAL_MS);
+    bsp_led_effect_set(&breath, BSP_LED_EFFECT_BREATH, white, BLACK, 2000, 0);
+    bsp_led_effect_set(&effect, BSP_LED_EFFECT_PULSE, white, BLACK, 2000, 0);
+    for (uint32_t t = 0; t < 2000; t += 10) {
+        bsp_led_rgb_t p, b;
+        bsp_led_effect_render(&effect, t, &p);
+        bsp_led_effect_render(&breath, t, &b);
+        if (p.r > b.r) {
+            printf("✗ 脉冲: t=%lu ms 亮于呼吸 (%d > %d)\n", (unsigned long)t, p.r, b.r);
+            failures++;
+            break;
+        }
+    }
+    bsp_led_effect_render(&effect, 500, &out);
+    if (out.r != 255) {
+        printf("✗ 脉冲峰值: %d\n", out.r);
+        failures++;
+    }
+
+    if (failures == 0) {
+        printf("✓ 渐变、彩虹、脉冲\n");
+    }
+    return failures;
+}
+
+int main(void) {
+    printf("========== 状态灯效果引擎测试 ==========\n");
+    int failures = test_breath_curves() + test_scale8() + test_blink() + test_fade_and_rainbow();
+    printf("========== %s (%d 项失败) ==========\n", failures == 0 ? "通过" : "失败", failures);
+    return failures == 0 ? 0 : 1;
+}
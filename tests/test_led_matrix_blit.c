@@ -0,0 +1,304 @@
+// LED Matrix 块传输引擎测试与性能对比（主机运行）
+// 每种绘制都与逐像素参考实现（与led_matrix_set_pixel相同的逐像素边界检查）
+// 逐字节比较像素和掩码平面，覆盖全屏填充、16x16精灵和四边裁剪；
+// 最后测量全屏填充和16x16精灵的逐像素/块传输耗时并输出加速比。
+//
+// 编译运行:
+//   gcc -O2 -I components/led_matrix/include -o test_led_matrix_blit
+//       tests/test_led_matrix_blit.c components/led_matrix/src/led_matrix_blit.c
+//   ./test_led_matrix_blit
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "led_matrix_blit.h"
+
+#define TEST_WIDTH          32      // 与LED_MATRIX_WIDTH一致
+#define TEST_HEIGHT         32      // 与LED_MATRIX_HEIGHT一致
+#define TEST_PIXELS         (TEST_WIDTH * TEST_HEIGHT)
+#define SPRITE_SIZE         16
+#define BACKGROUND          0xA5    // 初始背景，用于发现越界写入
+#define BENCH_ITERATIONS    20000
+
+// 块传输引擎与参考实现各自的绘制目标
+static uint8_t s_blit_pixels[TEST_PIXELS * 3];
+static uint8_t s_blit_mask[TEST_PIXELS];
+static uint8_t s_ref_pixels[TEST_PIXELS * 3];
+static uint8_t s_ref_mask[TEST_PIXELS];
+
+static const led_blit_surface_t s_blit = {s_blit_pixels, s_blit_mask, TEST_WIDTH, TEST_HEIGHT};
+static const led_blit_surface_t s_ref = {s_ref_pixels, s_ref_mask, TEST_WIDTH, TEST_HEIGHT};
+
+static uint8_t s_sprite_rgb[SPRITE_SIZE * SPRITE_SIZE * 3];
+static uint8_t s_sprite_bits[SPRITE_SIZE * ((SPRITE_SIZE + 7) / 8)];
+
+static int failures = 0;
+
+// ========== 逐像素参考实现 ==========
+
+// 与led_matrix_set_pixel相同：每个像素一次调用和一次边界检查
+__attribute__((noinline))
+static void ref_pixel(const led_blit_surface_t *dst, int x, int y, uint8_t r, uint8_t g, uint8_t b) {
+    if (x < 0 || x >= dst->width || y < 0 || y >= dst->height) {
+        return;
+    }
+    int index = y * dst->width + x;
+    dst->pixels[index * 3] = r;
+    dst->pixels[index * 3 + 1] = g;
+    dst->pixels[index * 3 + 2] = b;
+    if (dst->mask) {
+        dst->mask[index] = 1;
+    }
+}
+
+static void ref_fill_rect(const led_blit_surface_t *dst, int x, int y, int w, int h,
+                          uint8_t r, uint8_t g, uint8_t b) {
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            ref_pixel(dst, x + col, y + row, r, g, b);
+        }
+    }
+}
+
+static void ref_rgb_sprite(const led_blit_surface_t *dst, int x, int y,
+                           const uint8_t *rgb, int w, int h, const rgb_t *color_key) {
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            const uint8_t *p = rgb + (row * w + col) * 3;
+            if (color_key && p[0] == color_key->r && p[1] == color_key->g && p[2] == color_key->b) {
+                continue;
+            }
+            ref_pixel(dst, x + col, y + row, p[0], p[1], p[2]);
+        }
+    }
+}
+
+static void ref_mask_sprite(const led_blit_surface_t *dst, int x, int y,
+                            const uint8_t *bits, int w, int h, uint8_t r, uint8_t g, uint8_t b) {
+    int stride = (w + 7) / 8;
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            if (bits[row * stride + col / 8] & (0x80 >> (col % 8))) {
+                ref_pixel(dst, x + col, y + row, r, g, b);
+            }
+        }
+    }
+}
+
+// ========== 测试辅助 ==========
+
+static void reset_surfaces(void) {
+    memset(s_blit_pixels, BACKGROUND, sizeof(s_blit_pixels));
+    memset(s_ref_pixels, BACKGROUND, sizeof(s_ref_pixels));
+    memset(s_blit_mask, 0, sizeof(s_blit_mask));
+    memset(s_ref_mask, 0, sizeof(s_ref_mask));
+}
+
+static void check_surfaces(const char *name) {
+    if (memcmp(s_blit_pixels, s_ref_pixels, sizeof(s_blit_pixels)) != 0) {
+        printf("✗ %s: 像素与逐像素参考不一致\n", name);
+        failures++;
+    } else if (memcmp(s_blit_mask, s_ref_mask, sizeof(s_blit_mask)) != 0) {
+        printf("✗ %s: 掩码平面与逐像素参考不一致\n", name);
+        failures++;
+    } else {
+        printf("✓ %s\n", name);
+    }
+}
+
+static void init_sprites(void) {
+    // RGB精灵：渐变色，对角线上为透明色(0,0,0)
+    for (int y = 0; y < SPRITE_SIZE; y++) {
+        for (int x = 0; x < SPRITE_SIZE; x++) {
+            uint8_t *p = &s_sprite_rgb[(y * SPRITE_SIZE + x) * 3];
+            if (x == y || x + y == SPRITE_SIZE - 1) {
+                p[0] = p[1] = p[2] = 0;
+            } else {
+                p[0] = (uint8_t)(x * 16 + 1);
+                p[1] = (uint8_t)(y * 16 + 1);
+                p[2] = (uint8_t)(x ^ y);
+            }
+        }
+    }
+
+    // 掩码精灵：整字节空白、单像素和跨字节连续区段混合
+    for (int y = 0; y < SPRITE_SIZE; y++) {
+        uint8_t *row = &s_sprite_bits[y * ((SPRITE_SIZE + 7) / 8)];
+        row[0] = (y % 4 == 0) ? 0x00 : (uint8_t)(0x0F << (y % 4));
+        row[1] = (y % 3 == 0) ? 0xFF : (uint8_t)(0xA5 >> (y % 3));
+    }
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// ========== 正确性测试 ==========
+
+static void test_fill_rect(void) {
+    static const struct {
+        const char *name;
+        int x, y, w, h;
+        uint8_t r, g, b;
+    } cases[] = {
+        {"全屏填充（彩色）", 0, 0, TEST_WIDTH, TEST_HEIGHT, 200, 32, 64},
+        {"全屏填充（灰度）", 0, 0, TEST_WIDTH, TEST_HEIGHT, 77, 77, 77},
+        {"内部矩形", 5, 7, 11, 3, 1, 2, 3},
+        {"单像素矩形", 31, 31, 1, 1, 9, 8, 7},
+        {"左边裁剪", -4, 3, 10, 5, 10, 20, 30},
+        {"上边裁剪", 3, -6, 5, 10, 40, 50, 60},
+        {"右边裁剪", TEST_WIDTH - 3, 2, 9, 4, 70, 80, 90},
+        {"下边裁剪", 2, TEST_HEIGHT - 2, 6, 8, 15, 25, 35},
+        {"四边同时裁剪", -5, -5, TEST_WIDTH + 10, TEST_HEIGHT + 10, 250, 1, 128},
+        {"完全在左上外", -10, -10, 10, 10, 255, 0, 0},
+        {"完全在右下外", TEST_WIDTH, TEST_HEIGHT, 4, 4, 0, 255, 0},
+        {"零宽度", 4, 4, 0, 5, 0, 0, 255},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        reset_surfaces();
+        led_blit_fill_rect(&s_blit, cases[i].x, cases[i].y, cases[i].w, cases[i].h,
+                           cases[i].r, cases[i].g, cases[i].b);
+        ref_fill_rect(&s_ref, cases[i].x, cases[i].y, cases[i].w, cases[i].h,
+                      cases[i].r, cases[i].g, cases[i].b);
+
+        char name[64];
+        snprintf(name, sizeof(name), "fill_rect %s", cases[i].name);
+        check_surfaces(name);
+    }
+}
+
+static void test_spans(void) {
+    static const int positions[][3] = {
+        // x, y, len
+        {0, 0, TEST_WIDTH},
+        {-7, 4, 12},
+        {TEST_WIDTH - 5, 9, 20},
+        {-3, 12, TEST_WIDTH + 6},
+        {3, -1, 5},
+        {3, TEST_HEIGHT, 5},
+        {-8, 6, 8},
+    };
+
+    uint8_t line[(TEST_WIDTH + 6) * 3];
+    for (size_t i = 0; i < sizeof(line); i++) {
+        line[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    reset_surfaces();
+    for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+        int x = positions[i][0], y = positions[i][1], len = positions[i][2];
+        led_blit_hspan(&s_blit, x, y + 16, len, 12, 34, 56);
+        ref_fill_rect(&s_ref, x, y + 16, len, 1, 12, 34, 56);
+
+        led_blit_rgb_span(&s_blit, x, y, line, len);
+        for (int col = 0; col < len; col++) {
+            ref_pixel(&s_ref, x + col, y, line[col * 3], line[col * 3 + 1], line[col * 3 + 2]);
+        }
+    }
+    check_surfaces("hspan/rgb_span 裁剪");
+}
+
+static void test_sprites(void) {
+    static const struct {
+        const char *name;
+        int x, y;
+    } positions[] = {
+        {"居中", 8, 8},
+        {"左上角裁剪", -5, -9},
+        {"右上角裁剪", TEST_WIDTH - 4, -3},
+        {"左下角裁剪", -12, TEST_HEIGHT - 6},
+        {"右下角裁剪", TEST_WIDTH - 11, TEST_HEIGHT - 1},
+        {"完全在外", TEST_WIDTH + 1, 0},
+    };
+    const rgb_t key = {0, 0, 0};
+
+    for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+        int x = positions[i].x, y = positions[i].y;
+        char name[64];
+
+        reset_surfaces();
+        led_blit_rgb_sprite(&s_blit, x, y, s_sprite_rgb, SPRITE_SIZE, SPRITE_SIZE, NULL);
+        ref_rgb_sprite(&s_ref, x, y, s_sprite_rgb, SPRITE_SIZE, SPRITE_SIZE, NULL);
+        snprintf(name, sizeof(name), "16x16 RGB精灵 %s", positions[i].name);
+        check_surfaces(name);
+
+        reset_surfaces();
+        led_blit_rgb_sprite(&s_blit, x, y, s_sprite_rgb, SPRITE_SIZE, SPRITE_SIZE, &key);
+        ref_rgb_sprite(&s_ref, x, y, s_sprite_rgb, SPRITE_SIZE, SPRITE_SIZE, &key);
+        snprintf(name, sizeof(name), "16x16 透明色精灵 %s", positions[i].name);
+        check_surfaces(name);
+
+        reset_surfaces();
+        led_blit_mask_sprite(&s_blit, x, y, s_sprite_bits, SPRITE_SIZE, SPRITE_SIZE, 255, 128, 0);
+        ref_mask_sprite(&s_ref, x, y, s_sprite_bits, SPRITE_SIZE, SPRITE_SIZE, 255, 128, 0);
+        snprintf(name, sizeof(name), "16x16 掩码精灵 %s", positions[i].name);
+        check_surfaces(name);
+    }
+
+    // 宽度不是8的倍数的掩码精灵
+    static const uint8_t odd_bits[] = {0xFF, 0x80, 0x00, 0x00, 0xAA, 0x80};
+    reset_surfaces();
+    led_blit_mask_sprite(&s_blit, TEST_WIDTH - 6, 1, odd_bits, 9, 3, 1, 2, 3);
+    ref_mask_sprite(&s_ref, TEST_WIDTH - 6, 1, odd_bits, 9, 3, 1, 2, 3);
+    check_surfaces("9x3 掩码精灵 右边裁剪");
+}
+
+// ========== 性能对比 ==========
+
+static void report(const char *name, double pixel_us, double blit_us) {
+    printf("  %s: 逐像素 %.3f us, 块传输 %.3f us (每次), 加速 %.1fx\n",
+           name, pixel_us / BENCH_ITERATIONS, blit_us / BENCH_ITERATIONS, pixel_us / blit_us);
+}
+
+static void benchmark(void) {
+    printf("性能对比 (%d次迭代, 无掩码平面, 与目标板led_matrix_blit_benchmark()相同):\n", BENCH_ITERATIONS);
+    const led_blit_surface_t blit = {s_blit_pixels, NULL, TEST_WIDTH, TEST_HEIGHT};
+    const led_blit_surface_t ref = {s_ref_pixels, NULL, TEST_WIDTH, TEST_HEIGHT};
+
+    double start = now_us();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        ref_fill_rect(&ref, 0, 0, TEST_WIDTH, TEST_HEIGHT, (uint8_t)i, 32, 64);
+    }
+    double pixel_fill = now_us() - start;
+
+    start = now_us();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        led_blit_fill_rect(&blit, 0, 0, TEST_WIDTH, TEST_HEIGHT, (uint8_t)i, 32, 64);
+    }
+    double blit_fill = now_us() - start;
+
+    start = now_us();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        ref_rgb_sprite(&ref, 8, 8, s_sprite_rgb, SPRITE_SIZE, SPRITE_SIZE, NULL);
+    }
+    double pixel_sprite = now_us() - start;
+
+    start = now_us();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        led_blit_rgb_sprite(&blit, 8, 8, s_sprite_rgb, SPRITE_SIZE, SPRITE_SIZE, NULL);
+    }
+    double blit_sprite = now_us() - start;
+
+    report("全屏填充", pixel_fill, blit_fill);
+    report("16x16精灵", pixel_sprite, blit_sprite);
+
+    // 计时循环的结果也必须一致
+    if (memcmp(s_blit_pixels, s_ref_pixels, sizeof(s_blit_pixels)) != 0) {
+        printf("✗ 性能测试后画面不一致\n");
+        failures++;
+    }
+}
+
+int main(void) {
+    printf("========== LED Matrix 块传输引擎测试 ==========\n");
+    init_sprites();
+    test_fill_rect();
+    test_spans();
+    test_sprites();
+    benchmark();
+    printf("========== %s (%d 项失败) ==========\n", failures == 0 ? "通过" : "失败", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+// Logo播放列表调度器测试（主机运行）
+// 检查洗牌袋的权重分布、最大间隔、时间窗口和顺序播放。
+//
+// 编译运行:
+//   gcc -I components/led_matrix/include -o test_led_playlist
+//       tests/test_led_playlist.c components/led_matrix/src/led_playlist.c
+//   ./test_led_playlist
+
+#include <stdio.h>
+#include <string.h>
+#include "led_playlist.h"
+
+#define PICK_COUNT      100000
+
+static int check(bool ok, const char *name) {
+    printf("%s %s\n", ok ? "✓" : "✗", name);
+    return ok ? 0 : 1;
+}
+
+static void set_weight(led_playlist_t *playlist, uint8_t index, uint8_t weight) {
+    led_playlist_entry_t entry = led_playlist_get_default_entry();
+    entry.weight = weight;
+    led_playlist_set_entry(playlist, index, &entry);
+}
+
+// 每个条目的出现次数与权重成正比，两次出现的间隔不超过两袋的长度
+static int test_weighted_distribution(void) {
+    static const uint8_t weights[] = {1, 2, 3, 4, 0, 8};
+    const int count = sizeof(weights) / sizeof(weights[0]);
+    int total_weight = 0;
+
+    led_playlist_t playlist;
+    led_playlist_init(&playlist, (uint8_t)count, 12345);
+    for (int i = 0; i < count; i++) {
+        set_weight(&playlist, (uint8_t)i, weights[i]);
+        total_weight += weights[i];
+    }
+
+    int hits[LED_PLAYLIST_MAX_ENTRIES] = {0};
+    int last_seen[LED_PLAYLIST_MAX_ENTRIES];
+    int max_gap[LED_PLAYLIST_MAX_ENTRIES] = {0};
+    for (int i = 0; i < count; i++) {
+        last_seen[i] = -1;
+    }
+
+    for (int n = 0; n < PICK_COUNT; n++) {
+        int index = led_playlist_next_shuffled(&playlist, LED_PLAYLIST_ANY_TIME);
+        if (index < 0 || index >= count) {
+            return check(false, "权重分布: 选择结果无效");
+        }
+        hits[index]++;
+        int gap = n - last_seen[index];
+        if (gap > max_gap[index]) {
+            max_gap[index] = gap;
+        }
+        last_seen[index] = n;
+    }
+
+    int failures = 0;
+    for (int i = 0; i < count; i++) {
+        // 每袋内的次数严格等于权重，整体误差不超过一袋
+        int expected = PICK_COUNT / total_weight * weights[i];
+        int error = hits[i] - expected;
+        printf("  条目%d 权重%d: %d 次 (期望 %d), 最大间隔 %d\n", i, weights[i], hits[i], expected, max_gap[i]);
+        if (error < -weights[i] || error > weights[i]) {
+            failures++;
+        }
+        if (weights[i] > 0 && max_gap[i] > 2 * total_weight) {
+            failures++;
+        }
+    }
+    return failures + check(failures == 0, "权重分布与最大间隔");
+}
+
+// 权重相同时不会连续选择同一个条目
+static int test_no_immediate_repeat(void) {
+    led_playlist_t playlist;
+    led_playlist_init(&playlist, 4, 777);
+
+    int previous = -1;
+    int repeats = 0;
+    for (int n = 0; n < PICK_COUNT; n++) {
+        int index = led_playlist_next_shuffled(&playlist, LED_PLAYLIST_ANY_TIME);
+        if (index == previous) {
+            repeats++;
+        }
+        previous = index;
+    }
+    return check(repeats == 0, "等权重时无连续重复");
+}
+
+static int test_time_windows(void) {
+    led_playlist_t playlist;
+    led_playlist_init(&playlist, 3, 42);
+
+    // 条目1只在08:00-12:00播放，条目2只在22:00-06:00播放
+    led_playlist_entry_t morning = led_playlist_get_default_entry();
+    morning.window_start = 8 * 60;
+    morning.window_end = 12 * 60;
+    led_playlist_entry_t night = led_playlist_get_default_entry();
+    night.window_start = 22 * 60;
+    night.window_end = 6 * 60;
+    led_playlist_set_entry(&playlist, 1, &morning);
+    led_playlist_set_entry(&playlist, 2, &night);
+
+    int failures = 0;
+    static const struct {
+        int minute;
+        bool eligible[3];
+    } cases[] = {
+        {7 * 60 + 59, {true, false, false}},
+        {8 * 60, {true, true, false}},
+        {11 * 60 + 59, {true, true, false}},
+        {12 * 60, {true, false, false}},
+        {23 * 60, {true, false, true}},
+        {3 * 60, {true, false, true}},
+        {6 * 60, {true, false, false}},
+        {LED_PLAYLIST_ANY_TIME, {true, true, true}},
+    };
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        int hits[3] = {0};
+        for (int n = 0; n < 300; n++) {
+            int index = led_playlist_next_shuffled(&playlist, cases[c].minute);
+            if (index >= 0) {
+                hits[index]++;
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            if ((hits[i] > 0) != cases[c].eligible[i]) {
+                printf("  分钟 %d 条目%d 出现 %d 次\n", cases[c].minute, i, hits[i]);
+                failures++;
+            }
+        }
+    }
+
+    // 所有条目都不在窗口内时没有可选条目
+    set_weight(&playlist, 0, 0);
+    failures += led_playlist_next_shuffled(&playlist, 13 * 60) == -1 ? 0 : 1;
+
+    return failures + check(failures == 0, "时间窗口");
+}
+
+static int test_in_order(void) {
+    led_playlist_t playlist;
+    led_playlist_init(&playlist, 5, 1);
+    set_weight(&playlist, 2, 0);
+
+    static const int expected[] = {1, 3, 4, 0, 1, 3};
+    int current = 0;
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        current = led_playlist_next_in_order(&playlist, (uint8_t)current, LED_PLAYLIST_ANY_TIME);
+        failures += (current == expected[i]) ? 0 : 1;
+    }
+
+    // 只有一个可播放条目时返回自身
+    led_playlist_init(&playlist, 3, 1);
+    set_weight(&playlist, 0, 0);
+    set_weight(&playlist, 2, 0);
+    failures += (led_playlist_next_in_order(&playlist, 1, LED_PLAYLIST_ANY_TIME) == 1) ? 0 : 1;
+
+    return failures + check(failures == 0, "顺序播放");
+}
+
+static int test_duration(void) {
+    led_playlist_t playlist;
+    led_playlist_init(&playlist, 2, 1);
+    led_playlist_entry_t entry = led_playlist_get_default_entry();
+    entry.duration_ms = 12000;
+    led_playlist_set_entry(&playlist, 1, &entry);
+
+    bool ok = led_playlist_get_duration(&playlist, 0, 5000) == 5000 &&
+              led_playlist_get_duration(&playlist, 1, 5000) == 12000;
+
+    // 无效设置被拒绝
+    entry.weight = LED_PLAYLIST_MAX_WEIGHT + 1;
+    ok = ok && !led_playlist_set_entry(&playlist, 0, &entry);
+    entry.weight = 1;
+    entry.window_end = LED_PLAYLIST_MINUTES_PER_DAY;
+    ok = ok && !led_playlist_set_entry(&playlist, 0, &entry);
+
+    return check(ok, "显示时长与参数校验");
+}
+
+int main(void) {
+    printf("========== Logo播放列表调度器测试 ==========\n");
+    int failures = test_weighted_distribution() + test_no_immediate_repeat() +
+                   test_time_windows() + test_in_order() + test_duration();
+    printf("========== %s (%d 项失败) ==========\n", failures == 0 ? "通过" : "失败", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// LED Matrix 切换过渡黄金帧测试（主机运行）
+// 在4x2的画面上按固定透明度混合，结果与预先计算的黄金帧逐字节比较。
+//
+// 编译运行:
+//   gcc -I components/led_matrix/include -o test_led_transition
+//       tests/test_led_transition.c components/led_matrix/src/led_transition.c
+//   ./test_led_transition
+
+#include <stdio.h>
+#include <string.h>
+#include "led_transition.h"
+
+#define TEST_WIDTH      4
+#define TEST_HEIGHT     2
+#define TEST_BYTES      (TEST_WIDTH * TEST_HEIGHT * 3)
+
+// 旧画面与新画面
+static const uint8_t FROM_FRAME[TEST_BYTES] = {
+    11, 48, 85, 122, 159, 196, 233, 14, 51, 88, 125, 162,
+    199, 236, 17, 54, 91, 128, 165, 202, 239, 20, 57, 94
+};
+static const uint8_t TO_FRAME[TEST_BYTES] = {
+    255, 202, 149, 96, 43, 246, 193, 140, 87, 34, 237, 184,
+    131, 78, 25, 228, 175, 122, 69, 16, 219, 166, 113, 60
+};
+
+typedef struct {
+    led_transition_type_t type;
+    uint16_t alpha;
+    uint8_t expected[TEST_BYTES];
+} golden_frame_t;
+
+static const golden_frame_t GOLDEN_FRAMES[] = {
+    {LED_TRANSITION_FADE, 0, {11, 48, 85, 122, 159, 196, 233, 14, 51, 88, 125, 162, 199, 236, 17, 54, 91, 128, 165, 202, 239, 20, 57, 94}},
+    {LED_TRANSITION_FADE, 64, {72, 86, 101, 115, 130, 208, 223, 45, 60, 74, 153, 167, 182, 196, 19, 97, 112, 126, 141, 155, 234, 56, 71, 85}},
+    {LED_TRANSITION_FADE, 100, {106, 108, 110, 111, 113, 215, 217, 63, 65, 66, 168, 170, 172, 174, 20, 121, 123, 125, 127, 129, 231, 77, 78, 80}},
+    {LED_TRANSITION_FADE, 192, {194, 163, 133, 102, 72, 233, 203, 108, 78, 47, 209, 178, 148, 117, 23, 184, 154, 123, 93, 62, 224, 129, 99, 68}},
+    {LED_TRANSITION_FADE, 256, {255, 202, 149, 96, 43, 246, 193, 140, 87, 34, 237, 184, 131, 78, 25, 228, 175, 122, 69, 16, 219, 166, 113, 60}},
+
+    {LED_TRANSITION_WIPE, 0, {11, 48, 85, 122, 159, 196, 233, 14, 51, 88, 125, 162, 199, 236, 17, 54, 91, 128, 165, 202, 239, 20, 57, 94}},
+    {LED_TRANSITION_WIPE, 64, {255, 202, 149, 122, 159, 196, 233, 14, 51, 88, 125, 162, 131, 78, 25, 54, 91, 128, 165, 202, 239, 20, 57, 94}},
+    {LED_TRANSITION_WIPE, 100, {255, 202, 149, 107, 93, 224, 233, 14, 51, 88, 125, 162, 131, 78, 25, 151, 138, 124, 165, 202, 239, 20, 57, 94}},
+    {LED_TRANSITION_WIPE, 192, {255, 202, 149, 96, 43, 246, 193, 140, 87, 88, 125, 162, 131, 78, 25, 228, 175, 122, 69, 16, 219, 20, 57, 94}},
+    {LED_TRANSITION_WIPE, 256, {255, 202, 149, 96, 43, 246, 193, 140, 87, 34, 237, 184, 131, 78, 25, 228, 175, 122, 69, 16, 219, 166, 113, 60}},
+
+    {LED_TRANSITION_DISSOLVE, 0, {11, 48, 85, 122, 159, 196, 233, 14, 51, 88, 125, 162, 199, 236, 17, 54, 91, 128, 165, 202, 239, 20, 57, 94}},
+    {LED_TRANSITION_DISSOLVE, 64, {255, 202, 149, 122, 159, 196, 193, 140, 87, 88, 125, 162, 199, 236, 17, 228, 175, 122, 165, 202, 239, 20, 57, 94}},
+    {LED_TRANSITION_DISSOLVE, 100, {255, 202, 149, 122, 159, 196, 193, 140, 87, 88, 125, 162, 199, 236, 17, 228, 175, 122, 165, 202, 239, 166, 113, 60}},
+    {LED_TRANSITION_DISSOLVE, 192, {255, 202, 149, 96, 43, 246, 193, 140, 87, 88, 125, 162, 131, 78, 25, 228, 175, 122, 69, 16, 219, 166, 113, 60}},
+    {LED_TRANSITION_DISSOLVE, 256, {255, 202, 149, 96, 43, 246, 193, 140, 87, 34, 237, 184, 131, 78, 25, 228, 175, 122, 69, 16, 219, 166, 113, 60}},
+
+    // 直接切换时始终显示新画面
+    {LED_TRANSITION_NONE, 100, {255, 202, 149, 96, 43, 246, 193, 140, 87, 34, 237, 184, 131, 78, 25, 228, 175, 122, 69, 16, 219, 166, 113, 60}},
+};
+
+static int test_golden_frames(void) {
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof(GOLDEN_FRAMES) / sizeof(GOLDEN_FRAMES[0]); i++) {
+        const golden_frame_t *golden = &GOLDEN_FRAMES[i];
+        uint8_t pixels[TEST_BYTES];
+        memcpy(pixels, TO_FRAME, sizeof(pixels));
+
+        led_blit_surface_t surface = {
+            .pixels = pixels,
+            .mask = NULL,
+            .width = TEST_WIDTH,
+            .height = TEST_HEIGHT
+        };
+        led_transition_blend(golden->type, FROM_FRAME, &surface, golden->alpha);
+
+        if (memcmp(pixels, golden->expected, sizeof(pixels)) != 0) {
+            printf("✗ %s alpha=%u 与黄金帧不一致\n", led_transition_get_name(golden->type), golden->alpha);
+            failures++;
+        } else {
+            printf("✓ %s alpha=%u\n", led_transition_get_name(golden->type), golden->alpha);
+        }
+    }
+    return failures;
+}
+
+static int test_alpha(void) {
+    static const struct {
+        int64_t elapsed_us;
+        uint32_t duration_ms;
+        uint16_t expected;
+    } cases[] = {
+        {-1000, 400, 0},
+        {0, 400, 0},
+        {100000, 400, 64},
+        {200000, 400, 128},
+        {399999, 400, 255},
+        {400000, 400, 256},
+        {900000, 400, 256},
+        {0, 0, 256},
+    };
+
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        uint16_t alpha = led_transition_alpha(cases[i].elapsed_us, cases[i].duration_ms);
+        if (alpha != cases[i].expected) {
+            printf("✗ 透明度: elapsed=%lld us, duration=%lu ms, 期望 %u, 实际 %u\n",
+                   (long long)cases[i].elapsed_us, (unsigned long)cases[i].duration_ms,
+                   cases[i].expected, alpha);
+            failures++;
+        }
+    }
+    if (failures == 0) {
+        printf("✓ 透明度计算\n");
+    }
+    return failures;
+}
+
+int main(void) {
+    printf("========== LED切换过渡黄金帧测试 ==========\n");
+    int failures = test_golden_frames() + test_alpha();
+    printf("========== %s (%d 项失败) ==========\n", failures == 0 ? "通过" : "失败", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,516 @@
+// Prometheus响应流式扫描器测试（主机运行）
+// 检查成功/失败响应的字段提取、任意分块输入、截断、嵌套过深、超长字段和语法错误，
+// 再用随机生成的响应做模糊测试（与生成时的真值比较），用随机变异的响应检查
+// 扫描器不会越界或崩溃，最后测量扫描速度。
+//
+// 编译运行（建议带AddressSanitizer；测量速度时去掉-fsanitize）:
+//   gcc -O2 -fsanitize=address,undefined -I components/rm01_esp32s3_bsp/include -o test_prometheus_scanner
+//       tests/test_prometheus_scanner.c components/rm01_esp32s3_bsp/src/bsp_prometheus_scanner.c
+//   ./test_prometheus_scanner
+//
+// 与cJSON对比解析速度（使用ESP-IDF自带的cJSON源码）:
+//   gcc -O2 -DTEST_WITH_CJSON -I components/rm01_esp32s3_bsp/include -I $IDF_PATH/components/json/cJSON
+//       -o test_prometheus_scanner tests/test_prometheus_scanner.c
+//       components/rm01_esp32s3_bsp/src/bsp_prometheus_scanner.c $IDF_PATH/components/json/cJSON/cJSON.c -lm
+//   ./test_prometheus_scanner
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bsp_prometheus_scanner.h"
+#ifdef TEST_WITH_CJSON
+#include "cJSON.h"
+#endif
+
+#define LABEL               "rm01_query"
+#define MAX_SERIES          16
+#define DOC_BUFFER_SIZE     8192
+#define FUZZ_DOCS           3000
+#define MUTATION_ROUNDS     20000
+#define BENCH_ITERATIONS    20000
+
+// 批量查询的典型响应（与Prometheus实际输出格式一致）
+static const char *SAMPLE_RESPONSE =
+    "{\"status\":\"success\",\"data\":{\"resultType\":\"vector\",\"result\":["
+    "{\"metric\":{\"__name__\":\"temperature_C\",\"instance\":\"10.10.99.98:9100\",\"job\":\"jetson\","
+    "\"rm01_query\":\"0\",\"statistic\":\"cpu\"},\"value\":[1760776496.123,\"48.5\"]},"
+    "{\"metric\":{\"__name__\":\"temperature_C\",\"instance\":\"10.10.99.98:9100\",\"job\":\"jetson\","
+    "\"rm01_query\":\"1\",\"statistic\":\"gpu\"},\"value\":[1760776496.123,\"46\"]},"
+    "{\"metric\":{\"__name__\":\"integrated_power_mW\",\"instance\":\"10.10.99.98:9100\",\"job\":\"jetson\","
+    "\"rm01_query\":\"2\",\"statistic\":\"power\"},\"value\":[1760776496.123,\"23500\"]},"
+    "{\"metric\":{\"__name__\":\"ram_kB\",\"instance\":\"10.10.99.98:9100\",\"job\":\"jetson\","
+    "\"rm01_query\":\"3\",\"statistic\":\"total\"},\"value\":[1760776496.123,\"16252928\"]},"
+    "{\"metric\":{\"__name__\":\"ram_kB\",\"instance\":\"10.10.99.98:9100\",\"job\":\"jetson\","
+    "\"rm01_query\":\"4\",\"statistic\":\"used\"},\"value\":[1760776496.123,\"6021120\"]}"
+    "]}}";
+
+// 回调收集到的序列
+typedef struct {
+    int count;
+    char labels[MAX_SERIES][40];
+    bool has_label[MAX_SERIES];
+    char values[MAX_SERIES][40];
+} collected_t;
+
+static void collect(void *ctx, const char *label, size_t label_len, const char *value, size_t value_len) {
+    collected_t *c = (collected_t *)ctx;
+    if (c->count >= MAX_SERIES) {
+        c->count++;
+        return;
+    }
+    c->has_label[c->count] = label != NULL;
+    snprintf(c->labels[c->count], sizeof(c->labels[0]), "%.*s", (int)label_len, label ? label : "");
+    snprintf(c->values[c->count], sizeof(c->values[0]), "%.*s", (int)value_len, value);
+    c->count++;
+}
+
+static bool collected_equal(const collected_t *a, const collected_t *b) {
+    if (a->count != b->count) {
+        return false;
+    }
+    for (int i = 0; i < a->count && i < MAX_SERIES; i++) {
+        if (a->has_label[i] != b->has_label[i] || strcmp(a->labels[i], b->labels[i]) != 0 ||
+            strcmp(a->values[i], b->values[i]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 按固定块长扫描整个文档（chunk为0表示一次输入）
+static bsp_prom_scan_result_t scan(bsp_prom_scanner_t *scanner, collected_t *out, const char *doc,
+                                   size_t len, size_t chunk) {
+    memset(out, 0, sizeof(*out));
+    bsp_prom_scanner_init(scanner, LABEL, collect, out);
+    if (chunk == 0) {
+        chunk = len;
+    }
+    for (size_t pos = 0; pos < len; pos += chunk) {
+        size_t n = len - pos < chunk ? len - pos : chunk;
+        bsp_prom_scanner_feed(scanner, doc + pos, n);
+    }
+    return bsp_prom_scanner_finish(scanner);
+}
+
+static int check(bool ok, const char *name) {
+    printf("%s %s\n", ok ? "✓" : "✗", name);
+    return ok ? 0 : 1;
+}
+
+// ========== 基本功能 ==========
+
+static int test_success_response(void) {
+    int failures = 0;
+    bsp_prom_scanner_t scanner;
+    collected_t got;
+
+    bsp_prom_scan_result_t result = scan(&scanner, &got, SAMPLE_RESPONSE, strlen(SAMPLE_RESPONSE), 0);
+    failures += check(result == BSP_PROM_SCAN_OK, "完整扫描批量查询响应");
+    failures += check(bsp_prom_scanner_is_success(&scanner), "status为success");
+    failures += check(strcmp(scanner.result_type, "vector") == 0, "resultType为vector");
+    failures += check(got.count == 5 && scanner.series == 5, "5个序列");
+
+    static const char *expected_values[] = {"48.5", "46", "23500", "16252928", "6021120"};
+    bool all_match = got.count == 5;
+    for (int i = 0; i < 5 && all_match; i++) {
+        char tag[4];
+        snprintf(tag, sizeof(tag), "%d", i);
+        all_match = got.has_label[i] && strcmp(got.labels[i], tag) == 0 &&
+                    strcmp(got.values[i], expected_values[i]) == 0;
+    }
+    failures += check(all_match, "各序列的标签值和数值");
+
+    // 逐字节和各种块长输入结果相同
+    bool chunks_match = true;
+    for (size_t chunk = 1; chunk <= 64 && chunks_match; chunk++) {
+        collected_t chunked;
+        chunks_match = scan(&scanner, &chunked, SAMPLE_RESPONSE, strlen(SAMPLE_RESPONSE), chunk) == BSP_PROM_SCAN_OK &&
+                       collected_equal(&got, &chunked);
+    }
+    failures += check(chunks_match, "1~64字节分块输入结果相同");
+
+    // 空结果、不带标签的序列、字段顺序不同
+    const char *reordered =
+        " {\"data\" : {\"result\" : [ {\"value\" : [ 1.5e9 , \"NaN\" ] , \"metric\" : { } } ] ,"
+        " \"resultType\" : \"vector\" } , \"status\" : \"success\" } \r\n";
+    result = scan(&scanner, &got, reordered, strlen(reordered), 0);
+    failures += check(result == BSP_PROM_SCAN_OK && bsp_prom_scanner_is_success(&scanner) &&
+                      got.count == 1 && !got.has_label[0] && strcmp(got.values[0], "NaN") == 0,
+                      "空白、字段顺序不同、序列不带标签");
+
+    const char *empty = "{\"status\":\"success\",\"data\":{\"resultType\":\"vector\",\"result\":[]}}";
+    result = scan(&scanner, &got, empty, strlen(empty), 0);
+    failures += check(result == BSP_PROM_SCAN_OK && got.count == 0, "空结果");
+    return failures;
+}
+
+static int test_error_response(void) {
+    int failures = 0;
+    bsp_prom_scanner_t scanner;
+    collected_t got;
+
+    const char *error = "{\"status\":\"error\",\"errorType\":\"bad_data\","
+                        "\"error\":\"invalid parameter \\\"query\\\": 1:15: parse error: unexpected \\u003c in label matching, "
+                        "expected identifier or \\u007d\"}";
+    bsp_prom_scan_result_t result = scan(&scanner, &got, error, strlen(error), 7);
+    failures += check(result == BSP_PROM_SCAN_OK && !bsp_prom_scanner_is_success(&scanner), "错误响应: status为error");
+    failures += check(strncmp(scanner.error, "invalid parameter \"query\": 1:15", 31) == 0 &&
+                      strlen(scanner.error) == BSP_PROM_SCANNER_ERROR_LEN - 1, "错误信息（转义还原、超长截断）");
+
+    // 嵌套在其他字段里的同名字段不会被当作status或序列
+    const char *nested = "{\"status\":\"success\",\"warnings\":[{\"status\":\"error\"}],"
+                         "\"stats\":{\"result\":[{\"metric\":{\"rm01_query\":\"9\"},\"value\":[0,\"1\"]}]},"
+                         "\"data\":{\"resultType\":\"matrix\",\"result\":[]}}";
+    result = scan(&scanner, &got, nested, strlen(nested), 0);
+    failures += check(result == BSP_PROM_SCAN_OK && bsp_prom_scanner_is_success(&scanner) && got.count == 0 &&
+                      strcmp(scanner.result_type, "matrix") == 0, "只识别约定路径上的字段");
+    return failures;
+}
+
+static int test_truncation(void) {
+    bsp_prom_scanner_t scanner;
+    collected_t got;
+    size_t len = strlen(SAMPLE_RESPONSE);
+    int bad = 0;
+
+    // 每个前缀都不能被当作完整文档
+    for (size_t cut = 0; cut < len; cut++) {
+        bsp_prom_scan_result_t result = scan(&scanner, &got, SAMPLE_RESPONSE, cut, 3);
+        if (result != BSP_PROM_SCAN_ERR_TRUNCATED) {
+            printf("  截断于 %zu 字节: %s\n", cut, bsp_prom_scanner_result_name(result));
+            bad++;
+        }
+    }
+    return check(bad == 0, "任意位置截断都返回正文不完整");
+}
+
+static int test_limits(void) {
+    int failures = 0;
+    bsp_prom_scanner_t scanner;
+    collected_t got;
+    char doc[DOC_BUFFER_SIZE];
+
+    // 嵌套过深
+    const char *deep = "{\"data\":{\"x\":[[[[[[[1]]]]]]]}}";
+    failures += check(scan(&scanner, &got, deep, strlen(deep), 0) == BSP_PROM_SCAN_ERR_DEPTH, "嵌套超过8层");
+
+    // 超长标签值、超长数值、超长字段名
+    snprintf(doc, sizeof(doc),
+             "{\"status\":\"success\",\"data\":{\"result\":["
+             "{\"metric\":{\"rm01_query\":\"%040d\"},\"value\":[0,\"1\"]},"
+             "{\"metric\":{\"rm01_query\":\"1\"},\"value\":[0,\"%040d\"]},"
+             "{\"metric\":{\"rm01_query_with_a_very_long_suffix\":\"2\",\"rm01_query\":\"3\"},\"value\":[0,\"3\"]}"
+             "]}}", 7, 7);
+    bsp_prom_scan_result_t result = scan(&scanner, &got, doc, strlen(doc), 5);
+    failures += check(result == BSP_PROM_SCAN_OK && got.count == 3, "超长字段不影响扫描");
+    failures += check(!got.has_label[0] && strcmp(got.values[0], "1") == 0, "超长标签值视为缺失");
+    failures += check(got.has_label[1] && got.values[1][0] == '\0', "超长数值视为缺失");
+    failures += check(got.has_label[2] && strcmp(got.labels[2], "3") == 0, "超长字段名不误匹配");
+
+    // 超大响应：无关字段中的长字符串只占用固定内存
+    size_t pos = (size_t)snprintf(doc, sizeof(doc), "{\"status\":\"success\",\"padding\":\"");
+    memset(doc + pos, 'x', sizeof(doc) - pos - 200);
+    pos = sizeof(doc) - 200;
+    snprintf(doc + pos, sizeof(doc) - pos,
+             "\",\"data\":{\"result\":[{\"metric\":{\"rm01_query\":\"0\"},\"value\":[0,\"42\"]}]}}");
+    size_t total = 0;
+    bsp_prom_scanner_init(&scanner, LABEL, collect, &got);
+    memset(&got, 0, sizeof(got));
+    for (int round = 0; round < 64; round++) {
+        // 同一段填充重复输入，模拟约512KB的响应
+        bsp_prom_scanner_feed(&scanner, round == 0 ? doc : doc + 32, round == 0 ? sizeof(doc) - 200 : sizeof(doc) - 232);
+        total += round == 0 ? sizeof(doc) - 200 : sizeof(doc) - 232;
+    }
+    bsp_prom_scanner_feed(&scanner, doc + pos, strlen(doc + pos));
+    result = bsp_prom_scanner_finish(&scanner);
+    printf("  超大响应 %zu 字节，扫描器 %zu 字节\n", total + strlen(doc + pos), sizeof(scanner));
+    failures += check(result == BSP_PROM_SCAN_OK && got.count == 1 && strcmp(got.values[0], "42") == 0,
+                      "超大响应流式扫描");
+    return failures;
+}
+
+static int test_syntax_errors(void) {
+    static const char *bad_docs[] = {
+        "{\"status\":\"success\",}",
+        "{\"status\" \"success\"}",
+        "{\"status\":\"success\"} x",
+        "{\"status\":\"succ\x01ess\"}",
+        "{\"status\":\"\\x\"}",
+        "{\"status\":\"\\u12g4\"}",
+        "{\"status\":tru}",
+        "{\"status\":nulls}",
+        "{\"a\":[1,]}",
+        "{\"a\":[1}",
+        "{\"a\":{\"b\":1]}",
+        "]",
+        "{status:1}",
+        "{\"a\":1}}",
+    };
+    bsp_prom_scanner_t scanner;
+    collected_t got;
+    int bad = 0;
+    for (size_t i = 0; i < sizeof(bad_docs) / sizeof(bad_docs[0]); i++) {
+        bsp_prom_scan_result_t result = scan(&scanner, &got, bad_docs[i], strlen(bad_docs[i]), 0);
+        if (result != BSP_PROM_SCAN_ERR_SYNTAX) {
+            printf("  未识别的语法错误: %s (%s)\n", bad_docs[i], bsp_prom_scanner_result_name(result));
+            bad++;
+        }
+    }
+    int failures = check(bad == 0, "语法错误");
+
+    const char *good = "{\"a\":[true,false,null,-1.5e+3,{},[]],\"b\":\"\\\"\\\\\\/\\b\\f\\n\\r\\t\\u00e9\"}";
+    failures += check(scan(&scanner, &got, good, strlen(good), 1) == BSP_PROM_SCAN_OK, "合法的各类JSON值");
+    return failures;
+}
+
+// ========== 模糊测试 ==========
+
+static uint32_t s_seed = 12345;
+
+static uint32_t rnd(uint32_t n) {
+    s_seed = s_seed * 1103515245u + 12345u;
+    return (s_seed >> 8) % n;
+}
+
+// 随机空白
+static size_t put_ws(char *doc, size_t pos) {
+    static const char ws[] = " \t\r\n";
+    int n = rnd(4) == 0 ? (int)rnd(3) : 0;
+    for (int i = 0; i < n; i++) {
+        doc[pos++] = ws[rnd(4)];
+    }
+    return pos;
+}
+
+static size_t put(char *doc, size_t pos, const char *text) {
+    size_t len = strlen(text);
+    memcpy(doc + pos, text, len);
+    return pos + len;
+}
+
+// 随机内容的无关标签值（含转义）
+static size_t put_noise_string(char *doc, size_t pos) {
+    static const char *pieces[] = {"abc", "10.10.99.98:9100", "\\\"", "\\\\", "\\u4e2d", "\\n", "{[,:]}", ""};
+    doc[pos++] = '"';
+    int n = (int)rnd(4);
+    for (int i = 0; i < n; i++) {
+        pos = put(doc, pos, pieces[rnd(sizeof(pieces) / sizeof(pieces[0]))]);
+    }
+    doc[pos++] = '"';
+    return pos;
+}
+
+// 生成一个随机响应，真值写入expected
+static size_t generate(char *doc, collected_t *expected) {
+    memset(expected, 0, sizeof(*expected));
+    size_t pos = 0;
+    int series = (int)rnd(MAX_SERIES);
+    bool status_first = rnd(2) == 0;
+
+    pos = put(doc, pos, "{");
+    pos = put_ws(doc, pos);
+    if (status_first) {
+        pos = put(doc, pos, "\"status\":\"success\",");
+    }
+    pos = put(doc, pos, "\"data\":");
+    pos = put_ws(doc, pos);
+    pos = put(doc, pos, "{\"resultType\":\"vector\",\"result\":[");
+    for (int s = 0; s < series; s++) {
+        if (s > 0) {
+            pos = put(doc, pos, ",");
+        }
+        pos = put_ws(doc, pos);
+        pos = put(doc, pos, "{\"metric\":{");
+        int labels = (int)rnd(5);
+        int tag_at = rnd(3) == 0 ? -1 : (int)rnd((uint32_t)labels + 1);
+        expected->has_label[s] = tag_at >= 0;
+        for (int l = 0; l <= labels; l++) {
+            if (l > 0) {
+                pos = put(doc, pos, ",");
+            }
+            if (l == tag_at) {
+                snprintf(expected->labels[s], sizeof(expected->labels[0]), "%u", rnd(100));
+                pos += (size_t)sprintf(doc + pos, "\"rm01_query\":\"%s\"", expected->labels[s]);
+            } else {
+                pos += (size_t)sprintf(doc + pos, "\"l%u\":", rnd(10));
+                pos = put_noise_string(doc, pos);
+            }
+        }
+        if (tag_at < 0 && labels >= 0) {
+            // 最后一个位置上也没有标签：补一个无关标签，保证逗号完整
+            pos = put(doc, pos, ",\"job\":\"x\"");
+        }
+        pos = put(doc, pos, "}");
+        pos = put_ws(doc, pos);
+        pos = put(doc, pos, ",\"value\":[");
+        pos = put_ws(doc, pos);
+        pos += (size_t)sprintf(doc + pos, "%u.%03u", 1700000000u + rnd(1000000), rnd(1000));
+        pos = put(doc, pos, ",");
+        pos = put_ws(doc, pos);
+        switch (rnd(4)) {
+            case 0:  snprintf(expected->values[s], sizeof(expected->values[0]), "%d", (int)rnd(100000) - 50000); break;
+            case 1:  snprintf(expected->values[s], sizeof(expected->values[0]), "%u.%u", rnd(200), rnd(1000)); break;
+            case 2:  snprintf(expected->values[s], sizeof(expected->values[0]), "%ue+%02u", rnd(10), rnd(20)); break;
+            default: snprintf(expected->values[s], sizeof(expected->values[0]), "NaN"); break;
+        }
+        pos += (size_t)sprintf(doc + pos, "\"%s\"]}", expected->values[s]);
+    }
+    expected->count = series;
+    pos = put(doc, pos, "]}");
+    if (!status_first) {
+        pos = put(doc, pos, ",\"status\":\"success\"");
+    }
+    pos = put_ws(doc, pos);
+    pos = put(doc, pos, "}");
+    doc[pos] = '\0';
+    return pos;
+}
+
+static int test_fuzz_generated(void) {
+    char doc[DOC_BUFFER_SIZE];
+    bsp_prom_scanner_t scanner;
+    int bad = 0;
+
+    for (int i = 0; i < FUZZ_DOCS && bad < 5; i++) {
+        collected_t expected;
+        collected_t got;
+        size_t len = generate(doc, &expected);
+        size_t chunk = 1 + rnd(200);
+        bsp_prom_scan_result_t result = scan(&scanner, &got, doc, len, chunk);
+        if (result != BSP_PROM_SCAN_OK || !bsp_prom_scanner_is_success(&scanner) ||
+            !collected_equal(&expected, &got)) {
+            printf("  第%d个文档不一致 (%s, 块长%zu): %.300s\n", i, bsp_prom_scanner_result_name(result), chunk, doc);
+            bad++;
+        }
+    }
+    return check(bad == 0, "随机生成的响应与真值一致（3000个，随机分块）");
+}
+
+static int test_fuzz_mutated(void) {
+    char doc[DOC_BUFFER_SIZE];
+    bsp_prom_scanner_t scanner;
+    int inconsistent = 0;
+    int accepted = 0;
+
+    for (int i = 0; i < MUTATION_ROUNDS; i++) {
+        collected_t expected;
+        size_t len = generate(doc, &expected);
+        // 随机改写、删除或插入若干字节（包括非ASCII和控制字符）
+        int edits = 1 + (int)rnd(4);
+        for (int e = 0; e < edits && len > 1; e++) {
+            size_t at = rnd((uint32_t)len);
+            switch (rnd(3)) {
+                case 0:
+                    doc[at] = (char)rnd(256);
+                    break;
+                case 1:
+                    memmove(doc + at, doc + at + 1, len - at);
+                    len--;
+                    break;
+                default:
+                    if (len + 1 < sizeof(doc)) {
+                        memmove(doc + at + 1, doc + at, len - at + 1);
+                        doc[at] = "{}[]\",:\\ 0e"[rnd(11)];
+                        len++;
+                    }
+                    break;
+            }
+        }
+
+        // 分块方式不影响结果
+        collected_t whole;
+        collected_t chunked;
+        bsp_prom_scan_result_t r1 = scan(&scanner, &whole, doc, len, 0);
+        bsp_prom_scan_result_t r2 = scan(&scanner, &chunked, doc, len, 1 + rnd(16));
+        if (r1 != r2 || !collected_equal(&whole, &chunked)) {
+            inconsistent++;
+        }
+        if (r1 == BSP_PROM_SCAN_OK) {
+            accepted++;
+        }
+    }
+    printf("  %d个变异文档中 %d 个仍为合法JSON\n", MUTATION_ROUNDS, accepted);
+    return check(inconsistent == 0, "随机变异的响应：无越界，分块方式不影响结果");
+}
+
+// ========== 扫描速度 ==========
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void noop_series(void *ctx, const char *label, size_t label_len, const char *value, size_t value_len) {
+    (void)label;
+    (void)label_len;
+    (void)value;
+    (*(size_t *)ctx) += value_len;
+}
+
+#ifdef TEST_WITH_CJSON
+// 与显示控制器原先的cJSON解析相同的提取过程
+static size_t cjson_extract(const char *doc) {
+    size_t total = 0;
+    cJSON *json = cJSON_Parse(doc);
+    cJSON *data = cJSON_GetObjectItem(json, "data");
+    cJSON *result = cJSON_GetObjectItem(data, "result");
+    cJSON *item;
+    cJSON_ArrayForEach(item, result) {
+        cJSON *value = cJSON_GetArrayItem(cJSON_GetObjectItem(item, "value"), 1);
+        cJSON *tag = cJSON_GetObjectItem(cJSON_GetObjectItem(item, "metric"), LABEL);
+        if (cJSON_IsString(value) && cJSON_IsString(tag)) {
+            total += strlen(value->valuestring);
+        }
+    }
+    cJSON_Delete(json);
+    return total;
+}
+#endif
+
+static int test_benchmark(void) {
+    size_t len = strlen(SAMPLE_RESPONSE);
+    size_t sink = 0;
+    bsp_prom_scanner_t scanner;
+    int failures = 0;
+
+    bsp_prom_scanner_init(&scanner, LABEL, noop_series, &sink);
+    double start = now_us();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        bsp_prom_scanner_reset(&scanner);
+        // 按HTTP接收块大小输入
+        for (size_t pos = 0; pos < len; pos += 512) {
+            bsp_prom_scanner_feed(&scanner, SAMPLE_RESPONSE + pos, len - pos < 512 ? len - pos : 512);
+        }
+        bsp_prom_scanner_finish(&scanner);
+    }
+    double scanner_us = (now_us() - start) / BENCH_ITERATIONS;
+    printf("  流式扫描: %.2f us/响应 (%zu 字节, %.1f MB/s), 状态 %zu 字节, 无堆分配\n",
+           scanner_us, len, len / scanner_us, sizeof(scanner));
+    failures += check(sink == (size_t)BENCH_ITERATIONS * 26, "扫描结果正确");
+
+#ifdef TEST_WITH_CJSON
+    size_t cjson_sink = 0;
+    start = now_us();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        cjson_sink += cjson_extract(SAMPLE_RESPONSE);
+    }
+    double cjson_us = (now_us() - start) / BENCH_ITERATIONS;
+    printf("  cJSON:    %.2f us/响应 (%.1f MB/s)，另需完整缓存响应正文\n", cjson_us, len / cjson_us);
+    printf("  流式扫描相对cJSON: %.1fx\n", cjson_us / scanner_us);
+    failures += check(cjson_sink == sink, "cJSON提取结果一致");
+#else
+    printf("  （未编译cJSON对比，见文件头部说明）\n");
+#endif
+    return failures;
+}
+
+int main(void) {
+    printf("========== Prometheus响应流式扫描器测试 ==========\n");
+    int failures = test_success_response() + test_error_response() + test_truncation() +
+                   test_limits() + test_syntax_errors() + test_fuzz_generated() + test_fuzz_mutated() +
+                   test_benchmark();
+    printf("========== %s (%d 项失败) ==========\n", failures == 0 ? "通过" : "失败", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+// PromQL批量查询测试（主机运行）
+// 检查合并表达式的构造、缓冲区不足和批次已满的处理，以及响应序列按标签分拣、
+// 多序列取第一个、未知标签和无效数值的忽略。
+//
+// 编译运行:
+//   gcc -I components/rm01_esp32s3_bsp/include -o test_promql_batch
+//       tests/test_promql_batch.c components/rm01_esp32s3_bsp/src/bsp_promql_batch.c -lm
+//   ./test_promql_batch
+
+#include <stdio.h>
+#include <string.h>
+#include "bsp_promql_batch.h"
+
+// 与 bsp_board_ws2812_display.h 中的Jetson查询一致
+static const char *JETSON_QUERIES[] = {
+    "temperature_C{statistic=\"cpu\"}",
+    "temperature_C{statistic=\"gpu\"}",
+    "integrated_power_mW{statistic=\"power\"}",
+    "ram_kB{statistic=\"total\"}",
+    "ram_kB{statistic=\"used\"}",
+};
+
+// 与 bsp_board_ws2812_display.c 中的N305温度候选查询一致
+static const char *N305_QUERIES[] = {
+    "node_hwmon_temp_celsius{chip=\"platform_coretemp_0\",sensor=\"temp1\"}",
+    "node_hwmon_temp_celsius{chip=\"coretemp-isa-0000\",sensor=\"temp1\"}",
+    "node_thermal_zone_temp{zone=\"thermal_zone0\"}",
+    "max(node_hwmon_temp_celsius)",
+};
+
+#define EXPR_BUFFER_SIZE    768     // 与显示控制器的表达式缓冲区一致
+
+static int check(bool ok, const char *name) {
+    printf("%s %s\n", ok ? "✓" : "✗", name);
+    return ok ? 0 : 1;
+}
+
+static int feed(bsp_promql_batch_t *batch, const char *tag, const char *value) {
+    return bsp_promql_batch_feed(batch, tag, tag ? strlen(tag) : 0, value, strlen(value));
+}
+
+static int test_build(void) {
+    int failures = 0;
+    bsp_promql_batch_t batch;
+    bsp_promql_batch_init(&batch);
+
+    char expr[EXPR_BUFFER_SIZE];
+    failures += check(bsp_promql_batch_build(&batch, expr, sizeof(expr)) == -1, "空批次不生成表达式");
+
+    failures += check(bsp_promql_batch_add(&batch, "up") == 0, "第一条查询序号为0");
+    failures += check(bsp_promql_batch_add(&batch, "ram_kB{statistic=\"used\"}") == 1, "第二条查询序号为1");
+    failures += check(bsp_promql_batch_add(&batch, "") == -1, "拒绝空查询");
+
+    const char *expected = "label_replace(up,\"rm01_query\",\"0\",\"\",\"\") or "
+                           "label_replace(ram_kB{statistic=\"used\"},\"rm01_query\",\"1\",\"\",\"\")";
+    int len = bsp_promql_batch_build(&batch, expr, sizeof(expr));
+    if (len != (int)strlen(expected) || strcmp(expr, expected) != 0) {
+        printf("✗ 合并表达式: %s\n", expr);
+        failures++;
+    } else {
+        printf("✓ 合并表达式\n");
+    }
+
+    // 缓冲区恰好容纳与少一个字节
+    char exact[256];
+    failures += check(bsp_promql_batch_build(&batch, exact, (size_t)len + 1) == len, "缓冲区恰好容纳");
+    failures += check(bsp_promql_batch_build(&batch, exact, (size_t)len) == -1 && exact[0] == '\0',
+                      "缓冲区不足返回-1并清空输出");
+
+    // 批次已满
+    bsp_promql_batch_init(&batch);
+    for (int i = 0; i < BSP_PROMQL_BATCH_MAX_QUERIES; i++) {
+        bsp_promql_batch_add(&batch, "up");
+    }
+    failures += check(bsp_promql_batch_add(&batch, "up") == -1, "批次已满拒绝添加");
+    return failures;
+}
+
+static int test_display_batches_fit(void) {
+    int failures = 0;
+    bsp_promql_batch_t batch;
+    char expr[EXPR_BUFFER_SIZE];
+
+    bsp_promql_batch_init(&batch);
+    for (size_t i = 0; i < sizeof(JETSON_QUERIES) / sizeof(JETSON_QUERIES[0]); i++) {
+        bsp_promql_batch_add(&batch, JETSON_QUERIES[i]);
+    }
+    int jetson_len = bsp_promql_batch_build(&batch, expr, sizeof(expr));
+
+    bsp_promql_batch_init(&batch);
+    for (size_t i = 0; i < sizeof(N305_QUERIES) / sizeof(N305_QUERIES[0]); i++) {
+        bsp_promql_batch_add(&batch, N305_QUERIES[i]);
+    }
+    int n305_len = bsp_promql_batch_build(&batch, expr, sizeof(expr));
+
+    printf("  Jetson表达式 %d 字节, N305表达式 %d 字节\n", jetson_len, n305_len);
+    failures += check(jetson_len > 0 && n305_len > 0, "显示控制器的两个批次放得下表达式缓冲区");
+    return failures;
+}
+
+static int test_demux(void) {
+    int failures = 0;
+    bsp_promql_batch_t batch;
+    bsp_promql_batch_init(&batch);
+    for (size_t i = 0; i < sizeof(JETSON_QUERIES) / sizeof(JETSON_QUERIES[0]); i++) {
+        bsp_promql_batch_add(&batch, JETSON_QUERIES[i]);
+    }
+
+    // 响应顺序与查询顺序无关；功率(2)缺失
+    bsp_promql_batch_clear_results(&batch);
+    failures += check(feed(&batch, "4", "6021120"), "分拣已用内存");
+    failures += check(feed(&batch, "0", "48.5"), "分拣CPU温度");
+    failures += check(feed(&batch, "3", "16252928"), "分拣总内存");
+    failures += check(feed(&batch, "1", "-256"), "分拣GPU温度（范围检查由调用者负责）");
+
+    float value = 0;
+    failures += check(bsp_promql_batch_get(&batch, 0, &value) && value == 48.5f, "读取CPU温度");
+    failures += check(bsp_promql_batch_get(&batch, 1, &value) && value == -256.0f, "读取GPU温度");
+    failures += check(!bsp_promql_batch_get(&batch, 2, &value), "缺失的功率无结果");
+    failures += check(bsp_promql_batch_get(&batch, 3, &value) && value == 16252928.0f, "读取总内存");
+    failures += check(bsp_promql_batch_get(&batch, 4, &value) && value == 6021120.0f, "读取已用内存");
+    failures += check(!bsp_promql_batch_get(&batch, 5, &value) && !bsp_promql_batch_get(&batch, -1, &value),
+                      "越界序号无结果");
+    failures += check(batch.received == 4 && batch.series == 4 && batch.ignored == 0, "统计: 4个序列全部采用");
+
+    // 同一查询多个序列取第一个；无效序列被忽略
+    failures += check(!feed(&batch, "0", "99"), "重复序列不覆盖第一个");
+    failures += check(!feed(&batch, "2", "NaN"), "NaN被忽略");
+    failures += check(!feed(&batch, "2", "+Inf"), "+Inf被忽略");
+    failures += check(!feed(&batch, "2", "12abc"), "非数值被忽略");
+    failures += check(!feed(&batch, "2", ""), "空数值被忽略");
+    failures += check(!feed(&batch, "5", "1"), "超出批次的序号被忽略");
+    failures += check(!feed(&batch, "x", "1"), "非数字标签被忽略");
+    failures += check(!feed(&batch, NULL, "1"), "缺少标签被忽略");
+    failures += check(bsp_promql_batch_get(&batch, 0, &value) && value == 48.5f, "CPU温度保持第一个序列的值");
+    failures += check(!bsp_promql_batch_get(&batch, 2, NULL), "功率仍无结果");
+    failures += check(batch.series == 12 && batch.ignored == 8, "统计: 忽略8个序列");
+
+    // 科学计数法（Prometheus对大数值的格式）
+    failures += check(feed(&batch, "2", "2.35e+04") && bsp_promql_batch_get(&batch, 2, &value) &&
+                      value == 23500.0f, "科学计数法数值");
+
+    // 新一轮分拣前清空结果
+    bsp_promql_batch_clear_results(&batch);
+    failures += check(!bsp_promql_batch_get(&batch, 0, NULL) && batch.received == 0 && batch.series == 0,
+                      "清空结果");
+    failures += check(batch.count == 5, "清空结果保留查询");
+    return failures;
+}
+
+int main(void) {
+    printf("========== PromQL批量查询测试 ==========\n");
+    int failures = test_build() + test_display_batches_fit() + test_demux();
+    printf("========== %s (%d 项失败) ==========\n", failures == 0 ? "通过" : "失败", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,304 @@
+// 触摸按键手势识别测试（主机运行）
+// 用合成的原始读数序列驱动识别器，检查基线跟踪、消抖、单击、双击和长按，
+// 以及硬件中断唤醒后读数缓慢越过按下阈值的轻按。
+//
+// 编译运行:
+//   gcc -I components/rm01_esp32s3_bsp/include -o test_touch_gesture
+//       tests/test_touch_gesture.c components/rm01_esp32s3_bsp/src/bsp_touch_gesture.c
+//   ./test_touch_gesture
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bsp_touch_gesture.h"
+
+#define SAMPLE_INTERVAL_MS  20      // 与驱动识别期间的采样间隔一致
+#define BASELINE_RAW        20000   // 未触摸时的读数
+#define TOUCH_RAW           26000   // 手指按下时的读数（高出基线30%）
+#define NOISE_AMPLITUDE     300     // 未触摸时的噪声幅度（1.5%）
+#define WAKE_RAW            23000   // 越过唤醒阈值但未到按下阈值的读数（高出基线15%）
+
+// 模拟时钟与识别结果
+typedef struct {
+    bsp_touch_gesture_detector_t detector;
+    uint32_t now_ms;
+    uint32_t counts[BSP_TOUCH_GESTURE_COUNT];
+    bsp_touch_gesture_t last;
+    uint32_t last_ms;
+} sim_t;
+
+static void sim_init(sim_t *sim) {
+    bsp_touch_gesture_init(&sim->detector, NULL);
+    sim->now_ms = 1000;
+    for (int i = 0; i < BSP_TOUCH_GESTURE_COUNT; i++) {
+        sim->counts[i] = 0;
+    }
+    sim->last = BSP_TOUCH_GESTURE_NONE;
+    sim->last_ms = 0;
+    // 建立基线
+    bsp_touch_gesture_feed(&sim->detector, BASELINE_RAW, sim->now_ms);
+}
+
+static void sim_feed(sim_t *sim, uint32_t raw) {
+    sim->now_ms += SAMPLE_INTERVAL_MS;
+    bsp_touch_gesture_t g = bsp_touch_gesture_feed(&sim->detector, raw, sim->now_ms);
+    if (g != BSP_TOUCH_GESTURE_NONE) {
+        sim->counts[g]++;
+        sim->last = g;
+        sim->last_ms = sim->now_ms;
+    }
+}
+
+// 以固定读数持续duration_ms
+static void sim_hold(sim_t *sim, uint32_t raw, uint32_t duration_ms) {
+    for (uint32_t t = 0; t < duration_ms; t += SAMPLE_INTERVAL_MS) {
+        sim_feed(sim, raw);
+    }
+}
+
+// 带噪声的未触摸读数（确定性伪随机）
+static uint32_t noisy_idle(uint32_t base, uint32_t *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    int32_t noise = (int32_t)((*seed >> 16) % (2 * NOISE_AMPLITUDE + 1)) - NOISE_AMPLITUDE;
+    return (uint32_t)((int32_t)base + noise);
+}
+
+static int expect_counts(const sim_t *sim, const char *name, uint32_t tap, uint32_t double_tap, uint32_t long_press) {
+    if (sim->counts[BSP_TOUCH_GESTURE_TAP] != tap ||
+        sim->counts[BSP_TOUCH_GESTURE_DOUBLE_TAP] != double_tap ||
+        sim->counts[BSP_TOUCH_GESTURE_LONG_PRESS] != long_press) {
+        printf("✗ %s: 期望 单击%lu/双击%lu/长按%lu, 实际 单击%lu/双击%lu/长按%lu\n", name,
+               (unsigned long)tap, (unsigned long)double_tap, (unsigned long)long_press,
+               (unsigned long)sim->counts[BSP_TOUCH_GESTURE_TAP],
+               (unsigned long)sim->counts[BSP_TOUCH_GESTURE_DOUBLE_TAP],
+               (unsigned long)sim->counts[BSP_TOUCH_GESTURE_LONG_PRESS]);
+        return 1;
+    }
+    printf("✓ %s\n", name);
+    return 0;
+}
+
+static int test_tap(void) {
+    sim_t sim;
+    sim_init(&sim);
+    sim_hold(&sim, BASELINE_RAW, 200);
+    sim_hold(&sim, TOUCH_RAW, 120);
+    uint32_t release_ms = sim.now_ms;
+    sim_hold(&sim, BASELINE_RAW, 600);
+
+    int failures = expect_counts(&sim, "单击", 1, 0, 0);
+    // 单击在双击窗口结束后确认（松开消抖2次采样 + 300ms窗口）
+    uint32_t latency = sim.last_ms - release_ms;
+    if (latency < 300 || latency > 300 + 3 * SAMPLE_INTERVAL_MS) {
+        printf("✗ 单击确认延迟: %lu ms\n", (unsigned long)latency);
+        failures++;
+    }
+    if (bsp_touch_gesture_is_active(&sim.detector)) {
+        printf("✗ 单击后识别器应回到空闲\n");
+        failures++;
+    }
+    return failures;
+}
+
+static int test_double_tap(void) {
+    sim_t sim;
+    sim_init(&sim);
+    sim_hold(&sim, TOUCH_RAW, 100);
+    sim_hold(&sim, BASELINE_RAW, 120);
+    sim_hold(&sim, TOUCH_RAW, 100);
+    sim_hold(&sim, BASELINE_RAW, 40);
+    int failures = 0;
+    if (sim.last != BSP_TOUCH_GESTURE_DOUBLE_TAP) {
+        printf("✗ 双击应在第二次松开时立即确认\n");
+        failures++;
+    }
+    sim_hold(&sim, BASELINE_RAW, 600);
+    failures += expect_counts(&sim, "双击", 0, 1, 0);
+
+    // 两次单击间隔超过窗口：两个单击
+    sim_init(&sim);
+    sim_hold(&sim, TOUCH_RAW, 100);
+    sim_hold(&sim, BASELINE_RAW, 500);
+    sim_hold(&sim, TOUCH_RAW, 100);
+    sim_hold(&sim, BASELINE_RAW, 500);
+    failures += expect_counts(&sim, "间隔超过窗口的两次单击", 2, 0, 0);
+    return failures;
+}
+
+static int test_long_press(void) {
+    sim_t sim;
+    sim_init(&sim);
+    sim_hold(&sim, TOUCH_RAW, 20);
+    uint32_t press_ms = sim.now_ms + SAMPLE_INTERVAL_MS;   // 第2次采样确认按下
+    sim_hold(&sim, TOUCH_RAW, 3000);
+    sim_hold(&sim, BASELINE_RAW, 600);
+
+    int failures = expect_counts(&sim, "长按（按住3秒只报告一次）", 0, 0, 1);
+    uint32_t latency = sim.last_ms - press_ms;
+    if (latency < 800 || latency > 800 + SAMPLE_INTERVAL_MS) {
+        printf("✗ 长按确认时间: %lu ms\n", (unsigned long)latency);
+        failures++;
+    }
+
+    // 单击后紧接长按：不报告单击或双击
+    sim_init(&sim);
+    sim_hold(&sim, TOUCH_RAW, 100);
+    sim_hold(&sim, BASELINE_RAW, 100);
+    sim_hold(&sim, TOUCH_RAW, 1500);
+    sim_hold(&sim, BASELINE_RAW, 600);
+    failures += expect_counts(&sim, "单击后接长按", 0, 0, 1);
+    return failures;
+}
+
+static int test_debounce_and_noise(void) {
+    sim_t sim;
+    sim_init(&sim);
+    uint32_t seed = 1;
+
+    // 噪声和单次尖峰不应触发
+    for (int i = 0; i < 500; i++) {
+        sim_feed(&sim, noisy_idle(BASELINE_RAW, &seed));
+        if (i % 50 == 25) {
+            sim_feed(&sim, TOUCH_RAW + 5000);
+        }
+    }
+    int failures = expect_counts(&sim, "噪声与单次尖峰", 0, 0, 0);
+
+    // 读数在松开阈值和按下阈值之间抖动：滞回保持按下，不会拆成多次单击
+    sim_init(&sim);
+    sim_hold(&sim, TOUCH_RAW, 60);
+    for (int i = 0; i < 10; i++) {
+        sim_feed(&sim, BASELINE_RAW * 115 / 100);
+        sim_feed(&sim, BASELINE_RAW * 125 / 100);
+    }
+    sim_hold(&sim, BASELINE_RAW, 600);
+    // 按住约460ms，不到长按时长：一次单击
+    failures += expect_counts(&sim, "阈值之间抖动（滞回）", 1, 0, 0);
+    return failures;
+}
+
+static int test_baseline_drift(void) {
+    sim_t sim;
+    sim_init(&sim);
+    uint32_t seed = 7;
+    int failures = 0;
+
+    // 环境变化使读数在60秒内缓慢上升25%（超过按下阈值的幅度），不应误触发
+    uint32_t base = BASELINE_RAW;
+    for (int i = 0; i < 3000; i++) {
+        base = BASELINE_RAW + (uint32_t)((uint64_t)BASELINE_RAW * 25 / 100 * i / 3000);
+        sim_feed(&sim, noisy_idle(base, &seed));
+    }
+    failures += expect_counts(&sim, "基线缓慢漂移", 0, 0, 0);
+
+    uint32_t baseline = sim.detector.baseline;
+    if (abs((int)baseline - (int)base) > (int)base / 50) {
+        printf("✗ 基线跟踪: 期望约 %lu, 实际 %lu\n", (unsigned long)base, (unsigned long)baseline);
+        failures++;
+    }
+
+    // 漂移后按当前基线识别：原先的按下读数已不足以触发，高出新基线30%则触发
+    sim_hold(&sim, TOUCH_RAW, 100);
+    sim_hold(&sim, base, 600);
+    failures += expect_counts(&sim, "漂移后旧按下读数不触发", 0, 0, 0);
+    sim_hold(&sim, base * 130 / 100, 100);
+    sim_hold(&sim, base, 600);
+    failures += expect_counts(&sim, "漂移后按新基线识别单击", 1, 0, 0);
+
+    // 按住期间基线不变
+    uint32_t before = sim.detector.baseline;
+    sim_hold(&sim, base * 130 / 100, 2000);
+    if (sim.detector.baseline != before) {
+        printf("✗ 按住期间基线被改变: %lu -> %lu\n", (unsigned long)before, (unsigned long)sim.detector.baseline);
+        failures++;
+    }
+
+    // 按下阈值增量按当前基线计算
+    uint32_t delta = bsp_touch_gesture_get_touch_delta(&sim.detector);
+    if (delta != sim.detector.baseline * 20 / 100) {
+        printf("✗ 按下阈值: %lu\n", (unsigned long)delta);
+        failures++;
+    }
+    return failures;
+}
+
+// 模拟驱动的唤醒流程：中断后先通知识别器，再在识别器活动期间按间隔采样，
+// 返回识别器停止活动前实际采样的读数个数
+static int sim_wake(sim_t *sim, const uint32_t *readings, int count) {
+    bsp_touch_gesture_notify_wake(&sim->detector, true);
+    for (int i = 0; i < count; i++) {
+        sim_feed(sim, readings[i]);
+        if (!bsp_touch_gesture_is_active(&sim->detector)) {
+            return i + 1;
+        }
+    }
+    return count;
+}
+
+static int test_slow_press_wake(void) {
+    sim_t sim;
+    int failures = 0;
+
+    // 中断唤醒时读数只越过唤醒阈值，之后才缓慢越过按下阈值：继续采样直到识别出单击
+    sim_init(&sim);
+    uint32_t readings[64];
+    int n = 0;
+    for (int i = 0; i < 10; i++) {
+        readings[n++] = WAKE_RAW;                   // 200ms停留在两个阈值之间
+    }
+    for (int i = 0; i < 5; i++) {
+        readings[n++] = TOUCH_RAW;                  // 越过按下阈值
+    }
+    for (int i = 0; i < 25; i++) {
+        readings[n++] = BASELINE_RAW;               // 松开后等待双击窗口结束
+    }
+    int sampled = sim_wake(&sim, readings, n);
+    failures += expect_counts(&sim, "唤醒后缓慢越过按下阈值的轻按", 1, 0, 0);
+    if (sampled < 15) {
+        printf("✗ 唤醒后只采样了 %d 次就停止\n", sampled);
+        failures++;
+    }
+    if (sim.detector.baseline != BASELINE_RAW) {
+        printf("✗ 阈值之间的读数被计入基线: %lu\n", (unsigned long)sim.detector.baseline);
+        failures++;
+    }
+
+    // 读数回落到唤醒阈值以下：停止采样
+    sim_init(&sim);
+    const uint32_t brush[] = {WAKE_RAW, WAKE_RAW, BASELINE_RAW, WAKE_RAW};
+    sampled = sim_wake(&sim, brush, 4);
+    failures += expect_counts(&sim, "轻触后回落", 0, 0, 0);
+    if (sampled != 3) {
+        printf("✗ 回落后应停止采样: 采样 %d 次\n", sampled);
+        failures++;
+    }
+
+    // INACTIVE中断结束唤醒；没有中断时阈值之间的读数不保持活动
+    sim_init(&sim);
+    bsp_touch_gesture_notify_wake(&sim.detector, true);
+    sim_feed(&sim, WAKE_RAW);
+    bsp_touch_gesture_notify_wake(&sim.detector, false);
+    bool after_inactive = bsp_touch_gesture_is_active(&sim.detector);
+    sim_feed(&sim, WAKE_RAW);
+    if (after_inactive || bsp_touch_gesture_is_active(&sim.detector) || sim.detector.baseline != BASELINE_RAW) {
+        printf("✗ INACTIVE中断后应停止采样且基线不变\n");
+        failures++;
+    } else {
+        printf("✓ INACTIVE中断结束唤醒\n");
+    }
+
+    // 硬件中断阈值取唤醒阈值
+    uint32_t delta = bsp_touch_gesture_get_wake_delta(&sim.detector);
+    if (delta != BASELINE_RAW * 10 / 100) {
+        printf("✗ 唤醒阈值: %lu\n", (unsigned long)delta);
+        failures++;
+    }
+    return failures;
+}
+
+int main(void) {
+    printf("========== 触摸按键手势识别测试 ==========\n");
+    int failures = test_tap() + test_double_tap() + test_long_press() +
+                   test_debounce_and_noise() + test_baseline_drift() + test_slow_press_wake();
+    printf("========== %s (%d 项失败) ==========\n", failures == 0 ? "通过" : "失败", failures);
+    return failures == 0 ? 0 : 1;
+}
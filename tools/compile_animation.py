@@ -0,0 +1,319 @@
+#!/usr/bin/env python3
+"""
+动画编译工具
+将 matrix.json 编译为固件直接加载的二进制 .anim 文件（格式见 led_animation_binary.h）
+光栅化规则与固件的 JSON 加载器一致：最多10个动画、超出矩阵的像素被裁剪
+支持 point、line、rect、circle、polyline、row 图元
+
+用法: python compile_animation.py [matrix.json] [matrix.anim]
+"""
+
+import json
+import os
+import struct
+import sys
+import zlib
+from typing import Any, Dict, List, Optional, Tuple
+
+# 与固件保持一致的参数
+MATRIX_WIDTH = 32
+MATRIX_HEIGHT = 32
+MAX_ANIMATIONS = 10
+MAX_ARRAY_VALUES = 4096
+COORD_LIMIT = 1024
+MAX_NAME_BYTES = 63
+DEFAULT_ANIMATION_NAME = "未命名动画"
+
+# 文件格式
+MAGIC = b"RMAN"
+VERSION = 1
+HEADER_FORMAT = "<4sHHHHBBBBIIII"
+ENTRY_FORMAT = "<IHBB"
+FLAG_WIDE_INDEX = 0x01
+BITMAP_SIZE = (MATRIX_WIDTH * MATRIX_HEIGHT + 7) // 8
+
+Color = Tuple[int, int, int]
+
+
+def is_number(value: Any) -> bool:
+    """与cJSON_IsNumber一致（布尔值不是数字）"""
+    return isinstance(value, (int, float)) and not isinstance(value, bool)
+
+
+def to_int(value: Any) -> int:
+    """与cJSON的valueint一致：截断并饱和到int32"""
+    if value >= 2147483647:
+        return 2147483647
+    if value <= -2147483648:
+        return -2147483648
+    return int(value)
+
+
+def draw_line(pixels: Dict[int, Color], x1: int, y1: int, x2: int, y2: int, color: Color) -> None:
+    """Bresenham直线算法，与固件draw_line结果一致"""
+    dx = abs(x2 - x1)
+    dy = abs(y2 - y1)
+    sx = 1 if x1 < x2 else -1
+    sy = 1 if y1 < y2 else -1
+    err = dx - dy
+    x, y = x1, y1
+
+    while True:
+        set_pixel(pixels, x, y, color)
+        if x == x2 and y == y2:
+            break
+        e2 = 2 * err
+        if e2 > -dy:
+            err -= dy
+            x += sx
+        if e2 < dx:
+            err += dx
+            y += sy
+
+
+def clamp_coord(value: int) -> int:
+    """与固件clamp_coord一致"""
+    return max(-COORD_LIMIT, min(COORD_LIMIT, value))
+
+
+def hspan(pixels: Dict[int, Color], x: int, y: int, length: int, color: Color) -> None:
+    for i in range(max(length, 0)):
+        set_pixel(pixels, x + i, y, color)
+
+
+def draw_rect(pixels: Dict[int, Color], x: int, y: int, w: int, h: int, fill: bool, color: Color) -> None:
+    if w <= 0 or h <= 0:
+        return
+    for j in range(h):
+        if fill or j == 0 or j == h - 1:
+            hspan(pixels, x, y + j, w, color)
+        else:
+            set_pixel(pixels, x, y + j, color)
+            set_pixel(pixels, x + w - 1, y + j, color)
+
+
+def draw_circle(pixels: Dict[int, Color], cx: int, cy: int, radius: int, fill: bool, color: Color) -> None:
+    """中点画圆算法，与固件draw_circle结果一致"""
+    if radius < 0:
+        return
+    x, y, err = radius, 0, 1 - radius
+    while x >= y:
+        if fill:
+            hspan(pixels, cx - x, cy + y, 2 * x + 1, color)
+            hspan(pixels, cx - x, cy - y, 2 * x + 1, color)
+            hspan(pixels, cx - y, cy + x, 2 * y + 1, color)
+            hspan(pixels, cx - y, cy - x, 2 * y + 1, color)
+        else:
+            for px, py in ((x, y), (-x, y), (x, -y), (-x, -y), (y, x), (-y, x), (y, -x), (-y, -x)):
+                set_pixel(pixels, cx + px, cy + py, color)
+        y += 1
+        if err < 0:
+            err += 2 * y + 1
+        else:
+            x -= 1
+            err += 2 * (y - x) + 1
+
+
+def flatten_numbers(value: Any) -> List[int]:
+    """展开数组中的数值（包括嵌套的[x, y]），与固件一样最多保留MAX_ARRAY_VALUES个"""
+    result: List[int] = []
+    stack = [iter(value)]
+    while stack and len(result) < MAX_ARRAY_VALUES:
+        item = next(stack[-1], stack)
+        if item is stack:
+            stack.pop()
+        elif isinstance(item, list):
+            stack.append(iter(item))
+        elif is_number(item):
+            result.append(clamp_coord(to_int(item)))
+    return result
+
+
+def flag(point: Dict[str, Any], key: str, default: bool) -> bool:
+    value = point.get(key)
+    if isinstance(value, bool):
+        return value
+    if is_number(value):
+        return value != 0
+    return default
+
+
+def set_pixel(pixels: Dict[int, Color], x: int, y: int, color: Color) -> None:
+    if 0 <= x < MATRIX_WIDTH and 0 <= y < MATRIX_HEIGHT:
+        pixels[y * MATRIX_WIDTH + x] = color
+
+
+def rasterize_animation(animation: Any) -> Optional[Tuple[str, Dict[int, Color]]]:
+    """把一个动画光栅化为 {像素位置: 颜色}"""
+    if not isinstance(animation, dict):
+        print("警告: 动画不是有效的JSON对象，已跳过")
+        return None
+
+    name = animation.get("name")
+    if not isinstance(name, str):
+        name = DEFAULT_ANIMATION_NAME
+
+    points = animation.get("points")
+    if not isinstance(points, list):
+        # 固件JSON加载器同样保留该动画槽位，保证动画索引一致
+        print(f"警告: 动画 '{name}' 的points不是有效的数组，编译为空动画")
+        return name, {}
+
+    pixels: Dict[int, Color] = {}
+    for point in points:
+        if not isinstance(point, dict):
+            continue
+
+        rgb = [point.get(k) for k in ("r", "g", "b")]
+        if not all(is_number(v) for v in rgb):
+            continue
+        color = tuple(to_int(v) & 0xFF for v in rgb)
+
+        point_type = point.get("type")
+        if not isinstance(point_type, str):
+            point_type = "point"
+
+        if point_type == "point":
+            if is_number(point.get("x")) and is_number(point.get("y")):
+                set_pixel(pixels, to_int(point["x"]), to_int(point["y"]), color)
+        elif point_type == "line":
+            coords = [point.get(k) for k in ("x1", "y1", "x2", "y2")]
+            if all(is_number(v) for v in coords):
+                draw_line(pixels, *[to_int(v) for v in coords], color)
+        elif point_type == "rect":
+            params = [point.get(k) for k in ("x", "y", "w", "h")]
+            if all(is_number(v) for v in params):
+                draw_rect(pixels, *[clamp_coord(to_int(v)) for v in params], flag(point, "fill", True), color)
+        elif point_type == "circle":
+            params = [point.get(k) for k in ("x", "y", "radius")]
+            if all(is_number(v) for v in params):
+                draw_circle(pixels, *[clamp_coord(to_int(v)) for v in params], flag(point, "fill", True), color)
+        elif point_type == "polyline":
+            vertices = point.get("points")
+            coords = flatten_numbers(vertices) if isinstance(vertices, list) else []
+            count = len(coords) // 2
+            if count == 1:
+                set_pixel(pixels, coords[0], coords[1], color)
+            for i in range(1, count):
+                draw_line(pixels, *coords[2 * i - 2:2 * i + 2], color)
+            if flag(point, "closed", False) and count >= 3:
+                draw_line(pixels, coords[2 * count - 2], coords[2 * count - 1], coords[0], coords[1], color)
+        elif point_type == "row":
+            runs = point.get("runs")
+            if is_number(point.get("x")) and is_number(point.get("y")) and isinstance(runs, list):
+                x = clamp_coord(to_int(point["x"]))
+                y = to_int(point["y"])
+                for i, length in enumerate(flatten_numbers(runs)):
+                    if x >= MATRIX_WIDTH:
+                        break
+                    length = max(length, 0)
+                    if i % 2 == 0:
+                        hspan(pixels, x, y, length, color)
+                    x += length
+        else:
+            print(f"警告: 未知的点类型: {point_type}")
+
+    return name, pixels
+
+
+def truncate_name(name: str) -> bytes:
+    """按固件名称缓冲区截断（63字节，不拆开UTF-8字符）"""
+    data = name.encode("utf-8")
+    if len(data) <= MAX_NAME_BYTES:
+        return data
+    return data[:MAX_NAME_BYTES].decode("utf-8", errors="ignore").encode("utf-8")
+
+
+def build_image(animations: List[Tuple[str, Dict[int, Color]]], source_size: int, source_mtime: int) -> bytes:
+    """生成.anim文件内容"""
+    palette: Dict[Color, int] = {}
+    for _, pixels in animations:
+        for pos in sorted(pixels):
+            palette.setdefault(pixels[pos], len(palette))
+
+    wide = len(palette) > 256
+    if len(palette) > 65535:
+        raise ValueError(f"颜色数过多: {len(palette)}")
+    index_format = "<H" if wide else "<B"
+
+    palette_bytes = b"".join(bytes(color) for color in palette)
+    header_size = struct.calcsize(HEADER_FORMAT)
+    table_offset = header_size + len(palette_bytes)
+    offset = table_offset + struct.calcsize(ENTRY_FORMAT) * len(animations)
+
+    table = b""
+    payload = b""
+    for name, pixels in animations:
+        name_bytes = truncate_name(name)
+
+        bitmap = bytearray(BITMAP_SIZE)
+        indices = b""
+        for pos in sorted(pixels):
+            bitmap[pos // 8] |= 0x80 >> (pos % 8)
+            indices += struct.pack(index_format, palette[pixels[pos]])
+
+        table += struct.pack(ENTRY_FORMAT, offset, len(pixels), len(name_bytes), 0)
+        data = name_bytes + bytes(bitmap) + indices
+        payload += data
+        offset += len(data)
+
+    body = palette_bytes + table + payload
+    header = struct.pack(HEADER_FORMAT, MAGIC, VERSION, header_size, len(animations), len(palette),
+                         MATRIX_WIDTH, MATRIX_HEIGHT, FLAG_WIDE_INDEX if wide else 0, 0,
+                         source_size, source_mtime & 0xFFFFFFFF, len(body), zlib.crc32(body) & 0xFFFFFFFF)
+    return header + body
+
+
+def main():
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    default_json = os.path.join(script_dir, "..", "components", "led_matrix", "examples", "example_animation.json")
+
+    json_file = sys.argv[1] if len(sys.argv) > 1 else default_json
+    anim_file = sys.argv[2] if len(sys.argv) > 2 else os.path.splitext(json_file)[0] + ".anim"
+
+    print(f"源文件: {json_file}")
+    print(f"输出文件: {anim_file}")
+
+    try:
+        with open(json_file, "r", encoding="utf-8") as f:
+            data = json.load(f)
+    except Exception as e:
+        print(f"加载JSON文件失败: {e}")
+        return 1
+
+    source = data.get("animations") if isinstance(data, dict) else None
+    if not isinstance(source, list) or not source:
+        print("错误: 根对象中没有有效的animations数组")
+        return 1
+
+    if len(source) > MAX_ANIMATIONS:
+        print(f"警告: 动画数量 ({len(source)}) 超过限制，只编译前 {MAX_ANIMATIONS} 个")
+
+    animations = []
+    for animation in source[:MAX_ANIMATIONS]:
+        result = rasterize_animation(animation)
+        if result:
+            animations.append(result)
+            print(f"  {result[0]}: {len(result[1])} 个像素")
+
+    if not animations:
+        print("错误: 没有可编译的动画")
+        return 1
+
+    stat = os.stat(json_file)
+    image = build_image(animations, stat.st_size, int(stat.st_mtime))
+
+    try:
+        with open(anim_file, "wb") as f:
+            f.write(image)
+    except Exception as e:
+        print(f"写入.anim文件失败: {e}")
+        return 1
+
+    print(f"编译完成: {len(animations)} 个动画, {len(image)} 字节 (JSON {stat.st_size} 字节)")
+    print("请将.anim文件与JSON文件一起复制到TF卡根目录")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""
+动画图元转换工具
+把逐点描述的 matrix.json 改写为 row（行程编码）图元，并报告文件大小和解析耗时的对比。
+转换前后光栅化结果逐像素一致（使用 compile_animation.py 的光栅化规则校验）。
+
+用法: python convert_animation_primitives.py [matrix.json] [matrix_rows.json]
+"""
+
+import json
+import os
+import sys
+import time
+from typing import Any, Dict, List
+
+from compile_animation import MATRIX_WIDTH, MATRIX_HEIGHT, Color, rasterize_animation
+
+PARSE_REPEAT = 20
+
+
+def encode_pixels(pixels: Dict[int, Color]) -> List[Dict[str, Any]]:
+    """按行、按颜色生成图元：只出现一次的颜色用point，其余用row"""
+    primitives: List[Dict[str, Any]] = []
+    for y in range(MATRIX_HEIGHT):
+        columns: Dict[Color, List[int]] = {}
+        for x in range(MATRIX_WIDTH):
+            color = pixels.get(y * MATRIX_WIDTH + x)
+            if color is not None:
+                columns.setdefault(color, []).append(x)
+
+        for color, xs in columns.items():
+            r, g, b = color
+            if len(xs) == 1:
+                primitives.append({"x": xs[0], "y": y, "r": r, "g": g, "b": b})
+                continue
+
+            # 依次为点亮、跳过的长度，从第一个像素开始
+            runs: List[int] = []
+            start = prev = xs[0]
+            for x in xs[1:]:
+                if x != prev + 1:
+                    runs += [prev - start + 1, x - prev - 1]
+                    start = x
+                prev = x
+            runs.append(prev - start + 1)
+            primitives.append({"type": "row", "x": xs[0], "y": y, "runs": runs, "r": r, "g": g, "b": b})
+    return primitives
+
+
+def count_elements(data: Any) -> int:
+    """统计JSON值的个数（流式解析器产生的事件数量与之成正比）"""
+    if isinstance(data, dict):
+        return 1 + sum(1 + count_elements(v) for v in data.values())
+    if isinstance(data, list):
+        return 1 + sum(count_elements(v) for v in data)
+    return 1
+
+
+def measure_parse(text: str) -> float:
+    """解析耗时（毫秒，取多次平均）"""
+    start = time.perf_counter()
+    for _ in range(PARSE_REPEAT):
+        json.loads(text)
+    return (time.perf_counter() - start) * 1000 / PARSE_REPEAT
+
+
+def main():
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    project_root = os.path.dirname(script_dir)
+    default_source = os.path.join(project_root, "components", "led_matrix", "examples", "matrix_template.json")
+
+    source_file = sys.argv[1] if len(sys.argv) > 1 else default_source
+    target_file = sys.argv[2] if len(sys.argv) > 2 else os.path.splitext(source_file)[0] + "_rows.json"
+
+    with open(source_file, "r", encoding="utf-8") as f:
+        source_text = f.read()
+    data = json.loads(source_text)
+
+    animations = data.get("animations") if isinstance(data, dict) else None
+    if not isinstance(animations, list):
+        print("错误: 根对象中没有animations数组")
+        return 1
+
+    converted = []
+    for animation in animations:
+        result = rasterize_animation(animation)
+        if result is None or not isinstance(animation.get("points"), list):
+            converted.append(animation)
+            continue
+        name, pixels = result
+
+        new_animation = dict(animation)
+        new_animation["points"] = encode_pixels(pixels)
+        if rasterize_animation(new_animation)[1] != pixels:
+            print(f"错误: 动画 '{name}' 转换后像素不一致")
+            return 1
+        converted.append(new_animation)
+        print(f"{name}: {len(animation['points'])} 个图元 -> {len(new_animation['points'])} 个图元")
+
+    output = dict(data)
+    output["animations"] = converted
+    target_text = json.dumps(output, ensure_ascii=False, separators=(",", ":"))
+    with open(target_file, "w", encoding="utf-8") as f:
+        f.write(target_text)
+
+    compact_source = json.dumps(data, ensure_ascii=False, separators=(",", ":"))
+    rows = [
+        ("原文件", source_text),
+        ("原文件(紧凑)", compact_source),
+        ("图元文件", target_text),
+    ]
+    print(f"\n{'':<14}{'大小(字节)':>12}{'JSON值':>10}{'解析(ms)':>10}")
+    for label, text in rows:
+        print(f"{label:<14}{len(text.encode('utf-8')):>12}{count_elements(json.loads(text)):>10}"
+              f"{measure_parse(text):>10.2f}")
+
+    print(f"\n已写入: {target_file}")
+    print("设备上的实际解析耗时见加载日志中的“流式解析”一行")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""
+内置动画生成工具（构建时由 components/led_matrix/CMakeLists.txt 调用）
+把 example_animation.json 生成为 C 源文件：每个动画的掩码和颜色帧都是 const 数组，
+链接到 flash 的只读数据段，渲染时直接读取，不复制到 RAM；同时保留源定义中的
+point/line 元素，供导出 matrix.json 使用。
+
+用法: python gen_builtin_animations.py [example_animation.json] [led_animation_builtin_data.c]
+"""
+
+import json
+import os
+import sys
+from typing import Any, Dict, List, Tuple
+
+from compile_animation import MATRIX_WIDTH, MATRIX_HEIGHT, MAX_ANIMATIONS, Color, is_number, rasterize_animation
+
+# 元素类型与坐标字段，顺序与导出的JSON一致
+ELEMENT_FIELDS = {
+    "point": ("LED_ANIMATION_BUILTIN_POINT", ("x", "y")),
+    "line": ("LED_ANIMATION_BUILTIN_LINE", ("x1", "y1", "x2", "y2")),
+}
+COORD_MIN = -32768
+COORD_MAX = 32767
+
+
+def c_string(text: str) -> str:
+    """C字符串字面量（源文件为UTF-8，只转义引号、反斜杠和控制字符）"""
+    out = '"'
+    for ch in text:
+        if ch in '"\\':
+            out += "\\" + ch
+        elif ord(ch) < 32:
+            out += f"\\{ord(ch):03o}"
+        else:
+            out += ch
+    return out + '"'
+
+
+def parse_elements(animation: Dict[str, Any]) -> List[str]:
+    """把源定义中的元素转换为C初始化器"""
+    name = animation["name"]
+    elements = []
+    for point in animation["points"]:
+        point_type = point.get("type", "point")
+        if point_type not in ELEMENT_FIELDS:
+            raise ValueError(f"动画 '{name}' 包含不支持的内置元素类型: {point_type}")
+
+        enum_name, fields = ELEMENT_FIELDS[point_type]
+        values = [point.get(k) for k in fields + ("r", "g", "b")]
+        if not all(is_number(v) and int(v) == v for v in values):
+            raise ValueError(f"动画 '{name}' 的元素数值无效: {point}")
+
+        coords = [int(v) for v in values[:len(fields)]]
+        if not all(COORD_MIN <= v <= COORD_MAX for v in coords):
+            raise ValueError(f"动画 '{name}' 的坐标超出范围: {point}")
+        rgb = [int(v) for v in values[len(fields):]]
+        if not all(0 <= v <= 255 for v in rgb):
+            raise ValueError(f"动画 '{name}' 的颜色超出范围: {point}")
+
+        coords += [0] * (4 - len(coords))
+        elements.append(f"    {{{enum_name}, {{{', '.join(map(str, coords))}}}, {{{', '.join(map(str, rgb))}}}}},")
+    return elements
+
+
+def frame_rows(pixels: Dict[int, Color]) -> Tuple[List[str], List[str]]:
+    """掩码和颜色帧，每行一个矩阵行"""
+    mask_rows = []
+    color_rows = []
+    for y in range(MATRIX_HEIGHT):
+        mask = []
+        colors = []
+        for x in range(MATRIX_WIDTH):
+            color = pixels.get(y * MATRIX_WIDTH + x)
+            mask.append("0" if color is None else "1")
+            colors.extend(str(c) for c in (color or (0, 0, 0)))
+        mask_rows.append("    " + ",".join(mask) + ",")
+        color_rows.append("    " + ",".join(colors) + ",")
+    return mask_rows, color_rows
+
+
+def generate(source_file: str) -> str:
+    with open(source_file, "r", encoding="utf-8") as f:
+        data = json.load(f)
+
+    animations = data.get("animations") if isinstance(data, dict) else None
+    if not isinstance(animations, list) or not animations:
+        raise ValueError("根对象中没有有效的animations数组")
+    if len(animations) > MAX_ANIMATIONS:
+        raise ValueError(f"内置动画数量 ({len(animations)}) 超过限制 {MAX_ANIMATIONS}")
+
+    lines = [
+        "/**",
+        " * @file led_animation_builtin_data.c",
+        f" * @brief 内置动画数据（由 tools/gen_builtin_animations.py 根据 {os.path.basename(source_file)} 生成，请勿手动修改）",
+        " */",
+        "",
+        '#include "led_animation_builtin.h"',
+        '#include "led_matrix.h"',
+        "",
+        f"_Static_assert(LED_MATRIX_WIDTH == {MATRIX_WIDTH} && LED_MATRIX_HEIGHT == {MATRIX_HEIGHT}, "
+        '"内置动画帧尺寸与LED矩阵不一致");',
+        "",
+    ]
+
+    table = []
+    for index, animation in enumerate(animations):
+        if not isinstance(animation, dict) or not isinstance(animation.get("name"), str) or \
+                not isinstance(animation.get("points"), list):
+            raise ValueError(f"第 {index} 个动画缺少name或points")
+
+        elements = parse_elements(animation)
+        name, pixels = rasterize_animation(animation)
+        mask_rows, color_rows = frame_rows(pixels)
+
+        lines.append(f"// {name}: {len(elements)} 个元素, {len(pixels)} 个像素")
+        lines.append(f"static const led_animation_builtin_element_t ELEMENTS_{index}[] = {{")
+        lines += elements
+        lines.append("};")
+        lines.append("")
+        lines.append(f"static const uint8_t MASK_{index}[LED_MATRIX_HEIGHT * LED_MATRIX_WIDTH] = {{")
+        lines += mask_rows
+        lines.append("};")
+        lines.append("")
+        lines.append(f"static const uint8_t COLORS_{index}[LED_MATRIX_HEIGHT * LED_MATRIX_WIDTH * 3] = {{")
+        lines += color_rows
+        lines.append("};")
+        lines.append("")
+
+        table.append(f"    {{{c_string(name)}, ELEMENTS_{index}, {len(elements)}, MASK_{index}, COLORS_{index}}},")
+
+    lines.append("static const led_animation_builtin_t BUILTIN_ANIMATIONS[] = {")
+    lines += table
+    lines.append("};")
+    lines.append("")
+    lines += [
+        "int led_animation_builtin_count(void) {",
+        "    return sizeof(BUILTIN_ANIMATIONS) / sizeof(BUILTIN_ANIMATIONS[0]);",
+        "}",
+        "",
+        "const led_animation_builtin_t* led_animation_builtin_get(int index) {",
+        "    if (index < 0 || index >= led_animation_builtin_count()) {",
+        "        return NULL;",
+        "    }",
+        "    return &BUILTIN_ANIMATIONS[index];",
+        "}",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    default_json = os.path.join(script_dir, "..", "components", "led_matrix", "examples", "example_animation.json")
+
+    source_file = sys.argv[1] if len(sys.argv) > 1 else default_json
+    output_file = sys.argv[2] if len(sys.argv) > 2 else "led_animation_builtin_data.c"
+
+    try:
+        content = generate(source_file)
+    except (OSError, ValueError) as e:
+        print(f"生成内置动画失败: {e}", file=sys.stderr)
+        return 1
+
+    with open(output_file, "w", encoding="utf-8") as f:
+        f.write(content)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
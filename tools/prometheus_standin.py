@@ -0,0 +1,337 @@
+#!/usr/bin/env python3
+"""
+Prometheus查询API替身服务器
+
+在本地模拟 /api/v1/query，返回板载显示控制器查询的各项指标，并统计TCP连接数
+（即握手次数）和每个连接上的请求数，用于验证Prometheus客户端连接池的复用效果。
+也能解析显示控制器的批量查询（label_replace(...) or ...），按 rm01_query 标签返回各序列。
+可以按查询内容注入延迟，模拟某个主机的指标查询缓慢或无响应，对比两个主机依次获取
+与各自带截止时间并行获取时每个主机数据的发布耗时。
+
+用法:
+  # 启动替身服务器，把 BOARD_PROMETHEUS_API 指向 http://<本机IP>:59100/api/v1/query
+  python3 tools/prometheus_standin.py --port 59100
+
+  # 本地对比：每次查询新建连接、长连接复用、批量查询（模拟一个监控周期的查询序列）
+  python3 tools/prometheus_standin.py --bench --cycles 20 --latency-ms 2
+
+  # N305的指标查询30秒无响应（含node_hwmon的查询延迟30000ms），对比依次获取与并行获取
+  python3 tools/prometheus_standin.py --bench --host-cycles 3 --delay node_hwmon=30000
+"""
+
+import argparse
+import http.client
+import json
+import re
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+# 与 bsp_board_ws2812_display.h 中的查询对应的模拟值
+METRIC_VALUES = {
+    'node_hwmon_temp_celsius': '52.0',
+    'temperature_C{statistic="cpu"}': '48.5',
+    'temperature_C{statistic="gpu"}': '46.0',
+    'integrated_power_mW{statistic="power"}': '23500',
+    'ram_kB{statistic="total"}': '16252928',
+    'ram_kB{statistic="used"}': '6021120',
+}
+
+# 一个监控周期的查询序列（N305温度 + Jetson 5项）
+N305_QUERIES = [
+    'node_hwmon_temp_celsius{chip="platform_coretemp_0",sensor="temp1"}',
+    'node_hwmon_temp_celsius{chip="coretemp-isa-0000",sensor="temp1"}',
+    'node_thermal_zone_temp{zone="thermal_zone0"}',
+    'max(node_hwmon_temp_celsius)',
+]
+JETSON_QUERIES = [
+    'temperature_C{statistic="cpu"}',
+    'temperature_C{statistic="gpu"}',
+    'integrated_power_mW{statistic="power"}',
+    'ram_kB{statistic="total"}',
+    'ram_kB{statistic="used"}',
+]
+CYCLE_QUERIES = N305_QUERIES[:1] + JETSON_QUERIES
+
+# 批量查询的标签，与 bsp_promql_batch.h 中的 BSP_PROMQL_BATCH_LABEL 一致
+BATCH_LABEL = 'rm01_query'
+BATCH_PART = re.compile(r'^label_replace\((.*),"%s","(\d+)","",""\)$' % BATCH_LABEL)
+
+
+def build_batch(queries):
+    """与 bsp_promql_batch_build() 相同的合并表达式"""
+    return ' or '.join('label_replace(%s,"%s","%d","","")' % (q, BATCH_LABEL, i)
+                       for i, q in enumerate(queries))
+
+
+BATCHED_CYCLE_QUERIES = [build_batch(N305_QUERIES), build_batch(JETSON_QUERIES)]
+
+# 显示控制器每个周期获取的两个主机及其批量查询
+HOST_QUERIES = [('N305', BATCHED_CYCLE_QUERIES[0]), ('Jetson', BATCHED_CYCLE_QUERIES[1])]
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.connections = 0
+        self.requests = 0
+
+    def snapshot(self):
+        with self.lock:
+            return self.connections, self.requests
+
+
+STATS = Stats()
+
+
+def lookup_value(query):
+    if query.startswith('max(') and query.endswith(')'):
+        query = query[4:-1]
+    if query in METRIC_VALUES:
+        return METRIC_VALUES[query]
+    name = query.split('{', 1)[0]
+    return METRIC_VALUES.get(name)
+
+
+def evaluate(query):
+    """返回查询结果的序列列表，批量查询按各部分的标签返回"""
+    series = []
+    for part in query.split(' or '):
+        labels = {}
+        match = BATCH_PART.match(part)
+        if match:
+            part, labels[BATCH_LABEL] = match.group(1), match.group(2)
+        value = lookup_value(part)
+        if value is not None:
+            labels['__name__'] = part.split('{', 1)[0]
+            series.append({'metric': labels, 'value': [time.time(), value]})
+    return series
+
+
+class QueryHandler(BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'   # 默认保持连接
+    disable_nagle_algorithm = True  # 与Prometheus(Go)一致，避免头部和正文分段触发延迟确认
+    latency_s = 0.0
+    delays = []                     # [(查询中包含的字符串, 延迟秒数)]
+
+    def setup(self):
+        super().setup()
+        with STATS.lock:
+            STATS.connections += 1
+
+    def do_GET(self):
+        with STATS.lock:
+            STATS.requests += 1
+        url = urlparse(self.path)
+        if url.path != '/api/v1/query':
+            self.send_error(404)
+            return
+        query = parse_qs(url.query).get('query', [''])[0]
+        result = evaluate(query)
+        body = json.dumps({'status': 'success',
+                           'data': {'resultType': 'vector', 'result': result}}).encode()
+        delay_s = self.latency_s + sum(s for pattern, s in self.delays if pattern in query)
+        if delay_s > 0:
+            time.sleep(delay_s)
+        self.send_response(200)
+        self.send_header('Content-Type', 'application/json')
+        self.send_header('Content-Length', str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def log_message(self, fmt, *args):
+        pass
+
+
+class QuietServer(ThreadingHTTPServer):
+    def handle_error(self, request, client_address):
+        pass    # 客户端超时后关闭连接，延迟的响应写入失败属于预期
+
+
+def parse_delays(items):
+    """解析 --delay PATTERN=MS"""
+    delays = []
+    for item in items or []:
+        pattern, _, ms = item.rpartition('=')
+        if not pattern:
+            raise SystemExit('--delay 格式应为 PATTERN=MS: %s' % item)
+        delays.append((pattern, float(ms) / 1000.0))
+    return delays
+
+
+def start_server(port, latency_ms, delays=()):
+    QueryHandler.latency_s = latency_ms / 1000.0
+    QueryHandler.delays = list(delays)
+    server = QuietServer(('0.0.0.0', port), QueryHandler)
+    server.daemon_threads = True
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+    return server
+
+
+def run_cycles(port, cycles, keep_alive, queries):
+    """按监控周期发送查询，返回每个周期的耗时（毫秒）"""
+    latencies = []
+    conn = None
+    for _ in range(cycles):
+        start = time.perf_counter()
+        for query in queries:
+            if conn is None:
+                conn = http.client.HTTPConnection('127.0.0.1', port, timeout=5)
+            path = '/api/v1/query?query=' + query.replace(' ', '%20')
+            headers = {'Accept': 'application/json'}
+            if not keep_alive:
+                headers['Connection'] = 'close'
+            conn.request('GET', path, headers=headers)
+            resp = conn.getresponse()
+            resp.read()
+            if not keep_alive:
+                conn.close()
+                conn = None
+        latencies.append((time.perf_counter() - start) * 1000.0)
+    if conn is not None:
+        conn.close()
+    return latencies
+
+
+def fetch_host(state, port, query, timeout_s):
+    """发送一次查询，返回是否成功；失败后关闭连接，下次重新建立（与设备端客户端一致）"""
+    try:
+        if state.get('conn') is None:
+            state['conn'] = http.client.HTTPConnection('127.0.0.1', port, timeout=timeout_s)
+        conn = state['conn']
+        conn.timeout = timeout_s
+        if conn.sock is not None:
+            conn.sock.settimeout(timeout_s)
+        conn.request('GET', '/api/v1/query?query=' + query.replace(' ', '%20'),
+                     headers={'Accept': 'application/json'})
+        resp = conn.getresponse()
+        resp.read()
+        return resp.status == 200
+    except (OSError, http.client.HTTPException):
+        state['conn'].close()
+        state['conn'] = None
+        return False
+
+
+def run_host_cycles(port, cycles, parallel, timeout_s):
+    """
+    模拟显示控制器的监控周期，返回每个主机的发布耗时列表、失败次数和每周期耗时（毫秒）。
+    依次获取时两个主机的数据在周期结束时一起发布；并行获取时各自获取完成即发布。
+    """
+    states = [{} for _ in HOST_QUERIES]
+    publish_ms = [[] for _ in HOST_QUERIES]
+    failures = [0] * len(HOST_QUERIES)
+    cycle_ms = []
+    for _ in range(cycles):
+        start = time.perf_counter()
+        done = [None] * len(HOST_QUERIES)
+
+        def run(i):
+            ok = fetch_host(states[i], port, HOST_QUERIES[i][1], timeout_s)
+            done[i] = (ok, (time.perf_counter() - start) * 1000.0)
+
+        if parallel:
+            threads = [threading.Thread(target=run, args=(i,)) for i in range(len(HOST_QUERIES))]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+        else:
+            for i in range(len(HOST_QUERIES)):
+                run(i)
+        total = (time.perf_counter() - start) * 1000.0
+        cycle_ms.append(total)
+        for i, (ok, finished) in enumerate(done):
+            publish_ms[i].append(finished if parallel else total)
+            if not ok:
+                failures[i] += 1
+    for state in states:
+        if state.get('conn') is not None:
+            state['conn'].close()
+    return publish_ms, failures, cycle_ms
+
+
+def bench_hosts(args):
+    print('---------- 两个主机的获取方式 (%d 个周期) ----------' % args.host_cycles)
+    for pattern, delay_s in QueryHandler.delays:
+        print('注入延迟: 包含 "%s" 的查询 +%.0f ms' % (pattern, delay_s * 1000.0))
+    modes = [
+        ('依次获取 (请求超时 %.0f ms)' % args.timeout_ms, False, args.timeout_ms),
+        ('并行获取 (截止时间 %.0f ms)' % args.deadline_ms, True, args.deadline_ms),
+    ]
+    for name, parallel, timeout_ms in modes:
+        publish_ms, failures, cycle_ms = run_host_cycles(args.port, args.host_cycles, parallel,
+                                                         timeout_ms / 1000.0)
+        print('%s: 最坏周期耗时 %.1f ms' % (name, max(cycle_ms)))
+        for (host, _), latencies, failed in zip(HOST_QUERIES, publish_ms, failures):
+            print('  %s: 发布耗时 平均 %.1f ms, 最大 %.1f ms, 失败 %d/%d' % (
+                host, sum(latencies) / len(latencies), max(latencies), failed, len(latencies)))
+
+
+def bench(args):
+    server = start_server(args.port, args.latency_ms)
+    print('========== Prometheus替身服务器对比测试 ==========')
+    print('%d 个周期, 服务器处理延迟 %.1f ms' % (args.cycles, args.latency_ms))
+    modes = [
+        ('每次新建连接', False, CYCLE_QUERIES),
+        ('长连接复用', True, CYCLE_QUERIES),
+        ('批量查询+长连接', True, BATCHED_CYCLE_QUERIES),
+    ]
+    for name, keep_alive, queries in modes:
+        conn_before, req_before = STATS.snapshot()
+        latencies = run_cycles(args.port, args.cycles, keep_alive, queries)
+        conn_after, req_after = STATS.snapshot()
+        latencies.sort()
+        print('%s: 握手 %d 次 / 请求 %d 次, 每周期 平均 %.2f ms, P50 %.2f ms, P95 %.2f ms' % (
+            name, conn_after - conn_before, req_after - req_before,
+            sum(latencies) / len(latencies),
+            latencies[len(latencies) // 2],
+            latencies[int(len(latencies) * 0.95)]))
+    # 注入的延迟只用于主机获取方式对比
+    QueryHandler.delays = parse_delays(args.delay)
+    bench_hosts(args)
+    server.shutdown()
+
+
+def serve(args):
+    start_server(args.port, args.latency_ms, parse_delays(args.delay))
+    print('Prometheus替身服务器已启动: http://0.0.0.0:%d/api/v1/query' % args.port)
+    last = (0, 0)
+    try:
+        while True:
+            time.sleep(args.report_interval)
+            now = STATS.snapshot()
+            if now != last:
+                conns, reqs = now
+                print('TCP连接(握手): %d, 请求: %d, 每连接平均请求: %.1f' %
+                      (conns, reqs, reqs / conns if conns else 0.0))
+                last = now
+    except KeyboardInterrupt:
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Prometheus查询API替身服务器')
+    parser.add_argument('--port', type=int, default=59100, help='监听端口')
+    parser.add_argument('--latency-ms', type=float, default=0.0, help='模拟的服务器处理延迟')
+    parser.add_argument('--report-interval', type=float, default=10.0, help='统计打印间隔（秒）')
+    parser.add_argument('--bench', action='store_true', help='运行本地对比测试后退出')
+    parser.add_argument('--cycles', type=int, default=20, help='对比测试的监控周期数')
+    parser.add_argument('--delay', action='append', metavar='PATTERN=MS',
+                        help='包含PATTERN的查询额外延迟MS毫秒（可重复）')
+    parser.add_argument('--host-cycles', type=int, default=5, help='主机获取方式对比的周期数')
+    parser.add_argument('--timeout-ms', type=float, default=5000.0,
+                        help='依次获取的请求超时 (BOARD_HTTP_TIMEOUT_MS)')
+    parser.add_argument('--deadline-ms', type=float, default=4000.0,
+                        help='并行获取的截止时间 (BOARD_METRICS_DEADLINE_MS)')
+    args = parser.parse_args()
+    if args.bench:
+        bench(args)
+    else:
+        serve(args)
+
+
+if __name__ == '__main__':
+    main()